@@ -48,6 +48,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_trace.h>
 
 /**
  * constant definitions
@@ -83,6 +84,7 @@
 #define AHTXX_CMD_DELAY_MS          UINT16_C(5)     /*!< ahtxx delay before attempting command transactions after a command is issued */
 #define AHTXX_MEAS_PROC_DELAY_MS    UINT16_C(80)    /*!< ahtxx delay before attempting read transaction after a measurement trigger command is issued */
 #define AHTXX_TX_RX_DELAY_MS        UINT16_C(10)    /*!< ahtxx delay after attempting a transmit transaction and attempting a receive transaction */
+#define AHTXX_MEAS_READY_TIME_US    UINT32_C(80000) /*!< ahtxx measurement conversion time in microseconds after a measurement trigger command is issued */
 
 #define I2C_XFR_TIMEOUT_MS          (500)          //!< I2C transaction timeout in milliseconds
 
@@ -199,13 +201,13 @@ static inline esp_err_t ahtxx_i2c_read_from(ahtxx_device_t *const device, const
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c read from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c read from failed" );
 
     /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_TX_RX_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_TX_RX_DELAY_MS));
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_receive(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_RECEIVE(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read from failed" );
 
     return ESP_OK;
 }
@@ -223,7 +225,7 @@ static inline esp_err_t ahtxx_i2c_read(ahtxx_device_t *const device, uint8_t *bu
     ESP_ARG_CHECK( device );
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_receive(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_RECEIVE(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read failed" );
 
     return ESP_OK;
 }
@@ -241,7 +243,7 @@ static inline esp_err_t ahtxx_i2c_write(ahtxx_device_t *const device, const uint
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -274,14 +276,14 @@ static inline esp_err_t ahtxx_i2c_reset_init_register(ahtxx_device_t *device, co
     ESP_RETURN_ON_ERROR( ahtxx_i2c_write(device, tx, BIT24_UINT8_BUFFER_SIZE ), TAG, "write command to register 0x%02x for reset initialization register failed", reg_addr );
     
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
 
     /* attempt i2c read transaction */
     ESP_RETURN_ON_ERROR( ahtxx_i2c_read(device, rx, BIT24_UINT8_BUFFER_SIZE ), TAG, "read from register 0x%02x for reset initialization register failed", reg_addr );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
 
     /* set tx data packet */
     tx[0] = 0xb0 | reg_addr;
@@ -309,7 +311,7 @@ static inline esp_err_t ahtxx_i2c_get_status_register(ahtxx_device_t *device, ah
     ESP_RETURN_ON_ERROR( ahtxx_i2c_read_from(device, AHTXX_CMD_STATUS, &reg->reg, BIT8_UINT8_BUFFER_SIZE), TAG, "read status register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -330,7 +332,7 @@ static inline esp_err_t ahtxx_i2c_set_reset_register(ahtxx_device_t *device) {
     ESP_RETURN_ON_ERROR( ahtxx_i2c_write(device, tx, BIT8_UINT8_BUFFER_SIZE), TAG, "write reset register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_RESET_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_RESET_DELAY_MS));
 
     return ESP_OK;
 }
@@ -371,7 +373,7 @@ static inline esp_err_t ahtxx_i2c_setup(ahtxx_device_t *device) {
     }
 
     /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_SETUP_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_SETUP_DELAY_MS));
 
     return ESP_OK;
 }
@@ -445,10 +447,11 @@ esp_err_t ahtxx_init(const i2c_master_bus_handle_t master_handle, const ahtxx_co
     /* validate device handle */
     if (device->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &device->i2c_handle), err_handle, TAG, "i2c new bus for init failed");
+        I2C_TRACE_ADD_DEVICE(device->i2c_handle, "ahtxx", i2c_dev_conf.device_address);
     }
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
 
     /* attempt i2c write transaction */
     ESP_RETURN_ON_ERROR( ahtxx_i2c_set_reset_register(device), TAG, "write reset register for init failed" );
@@ -460,13 +463,14 @@ esp_err_t ahtxx_init(const i2c_master_bus_handle_t master_handle, const ahtxx_co
     *ahtxx_handle = (ahtxx_handle_t)device;
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_APPSTART_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_APPSTART_DELAY_MS));
 
     return ESP_OK;
 
     err_handle:
         /* clean up handle instance */
         if (device && device->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
             i2c_master_bus_rm_device(device->i2c_handle);
         }
         free(device);
@@ -489,7 +493,7 @@ esp_err_t ahtxx_get_measurement(ahtxx_handle_t handle, float *const temperature,
     ESP_RETURN_ON_ERROR( ahtxx_i2c_write(device, tx, BIT24_UINT8_BUFFER_SIZE ), TAG, "write measurement trigger command for get measurement failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_MEAS_PROC_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_MEAS_PROC_DELAY_MS));
 
     /* attempt to poll status until data is available or timeout occurs  */
     do {
@@ -502,7 +506,7 @@ esp_err_t ahtxx_get_measurement(ahtxx_handle_t handle, float *const temperature,
         data_is_ready = !status_reg.bits.busy;
 
         /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(AHTXX_DATA_READY_DELAY_MS));
+        I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_DATA_READY_DELAY_MS));
 
         /* validate timeout condition */
         if (ESP_TIMEOUT_CHECK(start_time, (AHTXX_DATA_POLL_TIMEOUT_MS * 1000)))
@@ -537,7 +541,7 @@ esp_err_t ahtxx_get_measurement(ahtxx_handle_t handle, float *const temperature,
     *humidity = ahtxx_convert_humidity_signal(humidity_sig);
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
     
     return ESP_OK;
 
@@ -558,6 +562,63 @@ esp_err_t ahtxx_get_measurements(ahtxx_handle_t handle, float *const temperature
     return ESP_OK;
 }
 
+esp_err_t ahtxx_start_measurement(ahtxx_handle_t handle) {
+    const bit24_uint8_buffer_t tx = { AHTXX_CMD_TRIGGER_MEAS, AHTXX_CTRL_MEAS, AHTXX_CTRL_NOP };
+    ahtxx_device_t* device = (ahtxx_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( ahtxx_i2c_write(device, tx, BIT24_UINT8_BUFFER_SIZE ), TAG, "write measurement trigger command for start measurement failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t ahtxx_get_measurement_ready_time(ahtxx_handle_t handle, uint32_t *const ready_time_us) {
+    ahtxx_device_t* device = (ahtxx_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && ready_time_us );
+
+    /* conversion time is fixed for all sensor types */
+    *ready_time_us = AHTXX_MEAS_READY_TIME_US;
+
+    return ESP_OK;
+}
+
+esp_err_t ahtxx_collect_measurement(ahtxx_handle_t handle, float *const temperature, float *const humidity) {
+    ahtxx_status_register_t status_reg = { 0 };
+    bit56_uint8_buffer_t    rx         = { 0 };
+    ahtxx_device_t* device = (ahtxx_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && temperature && humidity );
+
+    /* attempt i2c read transaction, aht10 returns 6 bytes, aht20, aht21, aht25, and aht30 return 7 bytes */
+    ESP_RETURN_ON_ERROR( ahtxx_i2c_read(device, rx, device->config.sensor_type == AHTXX_AHT10 ? BIT48_UINT8_BUFFER_SIZE : BIT56_UINT8_BUFFER_SIZE), TAG, "read measurement data for collect measurement failed" );
+
+    /* first byte of the measurement frame is the status register */
+    status_reg.reg = rx[0];
+
+    /* validate conversion completed */
+    if(status_reg.bits.busy == true) return ESP_ERR_NOT_FINISHED;
+
+    /* concat humidity signal */
+    const uint32_t humidity_sig = ((uint32_t)rx[1] << 12) | ((uint32_t)rx[2] << 4) | (rx[3] >> 4);
+
+    /* concat temperature signal */
+    const uint32_t temperature_sig = ((uint32_t)(rx[3] & 0x0f) << 16) | ((uint32_t)rx[4] << 8) | rx[5];
+
+    /* compute and set temperature */
+    *temperature = ahtxx_convert_temperature_signal(temperature_sig);
+
+    /* compute and set humidity */
+    *humidity = ahtxx_convert_humidity_signal(humidity_sig);
+
+    return ESP_OK;
+}
+
 esp_err_t ahtxx_get_busy_status(ahtxx_handle_t handle, bool *const busy) {
     ahtxx_status_register_t status_reg = { 0 };
     ahtxx_device_t* device = (ahtxx_device_t*)handle;
@@ -622,7 +683,7 @@ esp_err_t ahtxx_reset(ahtxx_handle_t handle) {
     ESP_RETURN_ON_ERROR( ahtxx_i2c_calibrate(device), TAG, "calibration for reset failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -639,7 +700,7 @@ esp_err_t ahtxx_reset__(ahtxx_handle_t handle) {
     ESP_RETURN_ON_ERROR( ahtxx_i2c_write(device, tx, BIT8_UINT8_BUFFER_SIZE), TAG, "write reset command for reset failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_RESET_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_RESET_DELAY_MS));
 
     /* attempt to read status register */
     ESP_RETURN_ON_ERROR( ahtxx_i2c_get_status_register(device, &status_reg), TAG, "read status register for reset failed" );
@@ -668,7 +729,7 @@ esp_err_t ahtxx_reset__(ahtxx_handle_t handle) {
     }
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(AHTXX_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -680,6 +741,7 @@ esp_err_t ahtxx_remove(ahtxx_handle_t handle) {
     ESP_ARG_CHECK( device );
 
     /* remove device from i2c master bus */
+    I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
     return i2c_master_bus_rm_device(device->i2c_handle);
 }
 
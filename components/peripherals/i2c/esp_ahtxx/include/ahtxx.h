@@ -173,6 +173,35 @@ esp_err_t ahtxx_get_measurement(ahtxx_handle_t handle, float *const temperature,
  */
 esp_err_t ahtxx_get_measurements(ahtxx_handle_t handle, float *const temperature, float *const humidity, float *const dewpoint);
 
+/**
+ * @brief Issues a measurement trigger command to AHTXX without waiting for the conversion to complete.
+ * 
+ * @note Use `ahtxx_get_measurement_ready_time` to schedule the `ahtxx_collect_measurement` call.
+ *
+ * @param[in] handle AHTXX device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahtxx_start_measurement(ahtxx_handle_t handle);
+
+/**
+ * @brief Gets the AHTXX conversion time, in microseconds, from measurement start until the results can be collected.
+ *
+ * @param[in] handle AHTXX device handle.
+ * @param[out] ready_time_us Measurement conversion time in microseconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahtxx_get_measurement_ready_time(ahtxx_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads temperature and relative humidity from AHTXX after `ahtxx_start_measurement`.  This is a non-blocking function.
+ *
+ * @param[in] handle AHTXX device handle.
+ * @param[out] temperature Temperature in degree Celsius.
+ * @param[out] humidity Relative humidity in percentage.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FINISHED when the conversion is still in progress.
+ */
+esp_err_t ahtxx_collect_measurement(ahtxx_handle_t handle, float *const temperature, float *const humidity);
+
 /**
  * @brief Reads busy status flag from AHTXX.
  *
@@ -41,6 +41,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_regcache.h>
 
 /*
  * AS7341 definitions
@@ -125,6 +126,9 @@
 #define AS7341_CONTROL              UINT8_C(0xfa)  //!< as7341 (see i2c_as7341_control_register_t)
 
 
+#define AS7341_SMUX_CONFIG_SIZE     UINT8_C(20)    //!< as7341 SMUX configuration RAM size (0x00 to 0x13)
+#define AS7341_REGCACHE_SIZE        UINT8_C(2)     //!< as7341 register cache window size (ENABLE and ATIME)
+
 #define AS7341_DATA_POLL_TIMEOUT_MS UINT16_C(1000)
 #define AS7341_DATA_READY_DELAY_MS  UINT16_C(1)
 #define AS7341_POWERUP_DELAY_MS     UINT16_C(200)
@@ -148,8 +152,11 @@
 typedef struct as7341_device_s {
     as7341_config_t             config;         /*!< as7341 device configuration */
     i2c_master_dev_handle_t     i2c_handle;     /*!< as7341 i2c device handle */
+    i2c_regcache_t              regcache;       /*!< as7341 enable and atime register cache */
     uint8_t                     part_id;
     uint8_t                     revision_id;
+    bool                        measurement_hi_channels; /*!< as7341 non-blocking measurement is integrating the high channels when true */
+    as7341_channels_spectral_data_t measurement_data;    /*!< as7341 non-blocking measurement low channels data */
 } as7341_device_t;
 
 /*
@@ -179,6 +186,26 @@ static inline esp_err_t as7341_i2c_write_byte_to(as7341_device_t *const device,
     return ESP_OK;
 }
 
+/**
+ * @brief AS7341 I2C HAL write to consecutive register addresses transaction.  The register 
+ * address auto-increments, the buffer is written in a single transaction.
+ * 
+ * @param device AS7341 device descriptor.
+ * @param reg_addr AS7341 register address to start writing to.
+ * @param buffer Buffer to write.
+ * @param size Length of buffer to write.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t as7341_i2c_write_to(as7341_device_t *const device, const uint8_t reg_addr, const uint8_t *buffer, const uint8_t size) {
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write transaction, cached registers in the range are updated */
+    ESP_RETURN_ON_ERROR( i2c_regcache_write(&device->regcache, reg_addr, buffer, size), TAG, "as7341_i2c_write_to failed" );
+
+    return ESP_OK;
+}
+
 /**
  * @brief AS7341 I2C HAL read from register address transaction.  This is a write and then read process.
  * 
@@ -312,30 +339,35 @@ static inline esp_err_t as7341_get_integration_time(as7341_handle_t handle, floa
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t as7341_setup_smux_lo_channels(as7341_device_t *const device) {
+    /* SMUX configuration RAM (0x00 to 0x13) */
+    static const uint8_t smux_config[AS7341_SMUX_CONFIG_SIZE] = {
+        0x30, /* 0x00: F3 left set to ADC2 */
+        0x01, /* 0x01: F1 left set to ADC0 */
+        0x00, /* 0x02: reserved or disabled */
+        0x00, /* 0x03: F8 left disabled */
+        0x00, /* 0x04: F6 left disabled */
+        0x42, /* 0x05: F4 left connected to ADC3/F2 connected to ADC1 */
+        0x00, /* 0x06: F5 left disabled */
+        0x00, /* 0x07: F7 left disabled */
+        0x50, /* 0x08: CLEAR connected ADC4 */
+        0x00, /* 0x09: F5 right disabled */
+        0x00, /* 0x0a: F7 right disabled */
+        0x00, /* 0x0b: reserved or disabled */
+        0x20, /* 0x0c: F2 right connected to ADC1 */
+        0x04, /* 0x0d: F4 right connected to ADC3 */
+        0x00, /* 0x0e: F6/F8 right disabled */
+        0x30, /* 0x0f: F3 right connected to ADC2 */
+        0x01, /* 0x10: F1 right connected to ADC0 */
+        0x50, /* 0x11: CLEAR right connected to ADC4 */
+        0x00, /* 0x12: reserved or disabled */
+        0x06, /* 0x13: NIR connected to ADC5 */
+    };
+
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* attempt i2c write config transactions (F1, F2, F3, F4, NIR, CLEAR) */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x00, 0x30), TAG, "write F3 left set to ADC2 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x01, 0x01), TAG, "write F1 left set to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x02, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x03, 0x00), TAG, "write F8 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x04, 0x00), TAG, "write F6 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x05, 0x42), TAG, "write F4 left connected to ADC3/F2 connected to ADC1 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x06, 0x00), TAG, "write F5 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x07, 0x00), TAG, "write F7 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x08, 0x50), TAG, "write CLEAR connected ADC4 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x09, 0x00), TAG, "write F5 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0a, 0x00), TAG, "write F7 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0b, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0c, 0x20), TAG, "write F2 right connected to ADC1 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0d, 0x04), TAG, "write F4 right connected to ADC3 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0e, 0x00), TAG, "write F6/F8 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0f, 0x30), TAG, "write F3 right connected to ADC2 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x10, 0x01), TAG, "write F1 right connected to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x11, 0x50), TAG, "write CLEAR right connected to ADC4 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x12, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x13, 0x06), TAG, "write NIR connected to ADC5 register failed" );
+    /* attempt i2c write config transaction (F1, F2, F3, F4, NIR, CLEAR) */
+    ESP_RETURN_ON_ERROR( as7341_i2c_write_to(device, 0x00, smux_config, AS7341_SMUX_CONFIG_SIZE), TAG, "write SMUX low channels configuration failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -350,30 +382,35 @@ static inline esp_err_t as7341_setup_smux_lo_channels(as7341_device_t *const dev
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t as7341_setup_smux_hi_channels(as7341_device_t *const device) {
+    /* SMUX configuration RAM (0x00 to 0x13) */
+    static const uint8_t smux_config[AS7341_SMUX_CONFIG_SIZE] = {
+        0x00, /* 0x00: F3 left disabled */
+        0x00, /* 0x01: F1 left disabled */
+        0x00, /* 0x02: reserved or disabled */
+        0x40, /* 0x03: F8 left connected to ADC3 */
+        0x02, /* 0x04: F6 left connected to ADC1 */
+        0x00, /* 0x05: F4/F2 disabled */
+        0x10, /* 0x06: F5 left connected to ADC0 */
+        0x03, /* 0x07: F7 left connected to ADC0 */
+        0x50, /* 0x08: CLEAR connected to ADC4 */
+        0x10, /* 0x09: F5 right connected to ADC0 */
+        0x03, /* 0x0a: F7 right connected to ADC0 */
+        0x00, /* 0x0b: reserved or disabled */
+        0x00, /* 0x0c: F2 right disabled */
+        0x00, /* 0x0d: F4 right disabled */
+        0x24, /* 0x0e: F8 right connected to ADC2/F6 right connected to ADC1 */
+        0x00, /* 0x0f: F3 right disabled */
+        0x00, /* 0x10: F1 right disabled */
+        0x50, /* 0x11: CLEAR right connected to ADC4 */
+        0x00, /* 0x12: reserved or disabled */
+        0x06, /* 0x13: NIR connected to ADC5 */
+    };
+
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* attempt i2c write config transactions (F5, F6, F7, F8, NIR, CLEAR) */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x00, 0x00), TAG, "write F3 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x01, 0x00), TAG, "write F1 left disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x02, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x03, 0x40), TAG, "write F8 left connected to ADC3 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x04, 0x02), TAG, "write F6 left connected to ADC1 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x05, 0x00), TAG, "write F4/F2 disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x06, 0x10), TAG, "write F5 left connected to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x07, 0x03), TAG, "write F7 left connected to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x08, 0x50), TAG, "write CLEAR connected to ADC4 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x09, 0x10), TAG, "write F5 right connected to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0a, 0x03), TAG, "write F7 right connected to ADC0 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0b, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0c, 0x00), TAG, "write F2 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0d, 0x00), TAG, "write F4 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0e, 0x24), TAG, "write F8 right connected to ADC2/F6 right connected to ADC1 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0f, 0x00), TAG, "write F3 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x10, 0x00), TAG, "write F1 right disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x11, 0x50), TAG, "write CLEAR right connected to ADC4 register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x12, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x13, 0x06), TAG, "write NIR connected to ADC5 register failed" );
+    /* attempt i2c write config transaction (F5, F6, F7, F8, NIR, CLEAR) */
+    ESP_RETURN_ON_ERROR( as7341_i2c_write_to(device, 0x00, smux_config, AS7341_SMUX_CONFIG_SIZE), TAG, "write SMUX high channels configuration failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -434,30 +471,35 @@ static inline esp_err_t as7341_set_smux_hi_channels(as7341_handle_t handle) {
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t as7341_setup_smux_flicker_detection(as7341_device_t *const device) {
+    /* SMUX configuration RAM (0x00 to 0x13) */
+    static const uint8_t smux_config[AS7341_SMUX_CONFIG_SIZE] = {
+        0x00, /* 0x00: reserved or disabled */
+        0x00, /* 0x01: reserved or disabled */
+        0x00, /* 0x02: reserved or disabled */
+        0x00, /* 0x03: reserved or disabled */
+        0x00, /* 0x04: reserved or disabled */
+        0x00, /* 0x05: reserved or disabled */
+        0x00, /* 0x06: reserved or disabled */
+        0x00, /* 0x07: reserved or disabled */
+        0x00, /* 0x08: reserved or disabled */
+        0x00, /* 0x09: reserved or disabled */
+        0x00, /* 0x0a: reserved or disabled */
+        0x00, /* 0x0b: reserved or disabled */
+        0x00, /* 0x0c: reserved or disabled */
+        0x00, /* 0x0d: reserved or disabled */
+        0x00, /* 0x0e: reserved or disabled */
+        0x00, /* 0x0f: reserved or disabled */
+        0x00, /* 0x10: reserved or disabled */
+        0x00, /* 0x11: reserved or disabled */
+        0x00, /* 0x12: reserved or disabled */
+        0x60, /* 0x13: flicker connected to ADC5 to left of 0x13 */
+    };
+
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* attempt i2c write config transactions */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x00, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x01, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x02, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x03, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x04, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x05, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x06, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x07, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x08, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x09, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0a, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0b, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0c, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0d, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0e, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x0f, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x10, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x11, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x12, 0x00), TAG, "write reserved or disabled register failed" );
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(device, 0x13, 0x60), TAG, "write flicker connected to ADC5 to left of 0x13 register failed" );
+    /* attempt i2c write config transaction (flicker detection) */
+    ESP_RETURN_ON_ERROR( as7341_i2c_write_to(device, 0x00, smux_config, AS7341_SMUX_CONFIG_SIZE), TAG, "write SMUX flicker detection configuration failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -555,11 +597,8 @@ esp_err_t as7341_get_enable_register(as7341_handle_t handle, as7341_enable_regis
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( as7341_i2c_read_byte_from(dev, AS7341_ENABLE, &reg->reg), TAG, "read enable register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
+    /* attempt i2c read transaction, served from the register cache when valid */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, AS7341_ENABLE, &reg->reg), TAG, "read enable register failed" );
 
     return ESP_OK;
 }
@@ -579,7 +618,7 @@ esp_err_t as7341_set_enable_register(as7341_handle_t handle, const as7341_enable
     enable.bits.reserved3 = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(dev, AS7341_ENABLE, enable.reg), TAG, "write enable register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, AS7341_ENABLE, enable.reg), TAG, "write enable register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -786,11 +825,8 @@ esp_err_t as7341_get_atime_register(as7341_handle_t handle, uint8_t *const reg)
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( as7341_i2c_read_byte_from(dev, AS7341_ATIME, reg), TAG, "read atime register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
+    /* attempt i2c read transaction, served from the register cache when valid */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, AS7341_ATIME, reg), TAG, "read atime register failed" );
 
     return ESP_OK;
 }
@@ -802,7 +838,7 @@ esp_err_t as7341_set_atime_register(as7341_handle_t handle, const uint8_t reg) {
     ESP_ARG_CHECK( dev );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(dev, AS7341_ATIME, reg), TAG, "write atime register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, AS7341_ATIME, reg), TAG, "write atime register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -831,8 +867,11 @@ esp_err_t as7341_set_astep_register(as7341_handle_t handle, const uint16_t reg)
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
+    /* set astep low and high bytes */
+    const bit16_uint8_buffer_t tx = { (uint8_t)(reg & 0xff), (uint8_t)(reg >> 8) };
+
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( as7341_i2c_write_byte_to(dev, AS7341_ASTEP_L, reg), TAG, "write astep register failed" );
+    ESP_RETURN_ON_ERROR( as7341_i2c_write_to(dev, AS7341_ASTEP_L, tx, BIT16_UINT8_BUFFER_SIZE), TAG, "write astep register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
@@ -978,6 +1017,16 @@ esp_err_t as7341_init(i2c_master_bus_handle_t master_handle, const as7341_config
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &dev->i2c_handle), err_handle, TAG, "i2c new bus for init failed");
     }
 
+    /* attempt to initialize enable and atime register cache */
+    const i2c_regcache_config_t regcache_cfg = {
+        .first_register = AS7341_ENABLE,
+        .size           = AS7341_REGCACHE_SIZE,
+        .volatile_mask  = 0,
+        .pair_writes    = false,
+        .timeout_ms     = I2C_XFR_TIMEOUT_MS,
+    };
+    ESP_GOTO_ON_ERROR(i2c_regcache_init(&dev->regcache, dev->i2c_handle, &regcache_cfg), err_handle, TAG, "register cache for init failed");
+
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
 
@@ -1113,6 +1162,97 @@ esp_err_t as7341_get_spectral_measurements(as7341_handle_t handle, as7341_channe
         return ret;
 }
 
+esp_err_t as7341_start_measurement(as7341_handle_t handle) {
+    esp_err_t ret = ESP_OK;
+    as7341_device_t* dev = (as7341_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev );
+
+    /* attempt to setup low channels */
+    ESP_GOTO_ON_ERROR( as7341_set_smux_lo_channels(handle), err, TAG, "setup of SMUX low channels for start measurement failed." );
+
+    /* attempt to enable spectral measurement for low channels */
+    ESP_GOTO_ON_ERROR( as7341_enable_spectral_measurement(handle), err, TAG, "enable spectral measurement, low channels, for start measurement failed." );
+
+    /* low channels are integrating */
+    dev->measurement_hi_channels = false;
+
+    return ESP_OK;
+
+    err:
+        return ret;
+}
+
+esp_err_t as7341_get_measurement_ready_time(as7341_handle_t handle, uint32_t *const ready_time_us) {
+    as7341_device_t* dev = (as7341_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && ready_time_us );
+
+    /* integration time of one SMUX phase (𝑡𝑖𝑛𝑡 = (𝐴𝑇𝐼𝑀𝐸 + 1) × (𝐴𝑆𝑇𝐸𝑃 + 1) × 2.78μ𝑠) */
+    *ready_time_us = (uint32_t)(((uint64_t)dev->config.atime + 1) * ((uint64_t)dev->config.astep + 1) * 278 / 100);
+
+    return ESP_OK;
+}
+
+esp_err_t as7341_collect_measurement(as7341_handle_t handle, as7341_channels_spectral_data_t *const spectral_data) {
+    esp_err_t                 ret     = ESP_OK;
+    as7341_status2_register_t status2 = { 0 };
+    uint8_t                   rx[12]  = { 0 };
+    as7341_device_t* dev = (as7341_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && spectral_data );
+
+    /* attempt to check if data is ready */
+    ESP_GOTO_ON_ERROR( as7341_i2c_read_byte_from(dev, AS7341_STATUS2, &status2.reg), err, TAG, "data ready read for collect measurement failed." );
+
+    /* validate integration completed */
+    if (status2.bits.spectral_valid == false) return ESP_ERR_NOT_FINISHED;
+
+    /* attempt to read spectral adc data */
+    ESP_GOTO_ON_ERROR( as7341_i2c_read_from(dev, AS7341_CH0_ADC_DATA_L, rx, sizeof(rx)), err, TAG, "read channel measurements for collect measurement failed" );
+
+    if (dev->measurement_hi_channels == false) {
+        /* set adc data for low channels */
+        dev->measurement_data.f1 = (uint16_t)rx[0]  | (uint16_t)(rx[1] << 8);
+        dev->measurement_data.f2 = (uint16_t)rx[2]  | (uint16_t)(rx[3] << 8);
+        dev->measurement_data.f3 = (uint16_t)rx[4]  | (uint16_t)(rx[5] << 8);
+        dev->measurement_data.f4 = (uint16_t)rx[6]  | (uint16_t)(rx[7] << 8);
+
+        /* attempt to setup high channels */
+        ESP_GOTO_ON_ERROR( as7341_set_smux_hi_channels(handle), err, TAG, "setup of SMUX high channels for collect measurement failed." );
+
+        /* attempt to enable spectral measurement for high channels */
+        ESP_GOTO_ON_ERROR( as7341_enable_spectral_measurement(handle), err, TAG, "enable spectral measurement, high channels, for collect measurement failed." );
+
+        /* high channels are integrating, collect again after the ready time */
+        dev->measurement_hi_channels = true;
+
+        return ESP_ERR_NOT_FINISHED;
+    }
+
+    /* set adc data for high channels */
+    dev->measurement_data.f5    = (uint16_t)rx[0]  | (uint16_t)(rx[1] << 8);
+    dev->measurement_data.f6    = (uint16_t)rx[2]  | (uint16_t)(rx[3] << 8);
+    dev->measurement_data.f7    = (uint16_t)rx[4]  | (uint16_t)(rx[5] << 8);
+    dev->measurement_data.f8    = (uint16_t)rx[6]  | (uint16_t)(rx[7] << 8);
+    dev->measurement_data.clear = (uint16_t)rx[8]  | (uint16_t)(rx[9] << 8);
+    dev->measurement_data.nir   = (uint16_t)rx[10] | (uint16_t)(rx[11] << 8);
+
+    /* set output parameter */
+    *spectral_data = dev->measurement_data;
+
+    /* next collect requires a new start */
+    dev->measurement_hi_channels = false;
+
+    return ESP_OK;
+
+    err:
+        return ret;
+}
+
 esp_err_t as7341_get_basic_counts(as7341_handle_t handle, const as7341_channels_spectral_data_t spectral_data, as7341_channels_basic_counts_data_t *const basic_counts_data) {
     /* validate arguments */
     ESP_ARG_CHECK( handle );
@@ -1252,12 +1392,17 @@ esp_err_t as7341_get_atime(as7341_handle_t handle, uint8_t *const atime) {
 }
 
 esp_err_t as7341_set_atime(as7341_handle_t handle, const uint8_t atime) {
+    as7341_device_t* dev = (as7341_device_t*)handle;
+
     /* validate arguments */
-    ESP_ARG_CHECK( handle );
+    ESP_ARG_CHECK( dev );
 
     /* attempt to set register */
     ESP_RETURN_ON_ERROR( as7341_set_atime_register(handle, atime), TAG, "write atime register for set atime failed" );
 
+    /* set configuration */
+    dev->config.atime = atime;
+
     return ESP_OK;
 }
 
@@ -1272,12 +1417,17 @@ esp_err_t as7341_get_astep(as7341_handle_t handle, uint16_t *const astep) {
 }
 
 esp_err_t as7341_set_astep(as7341_handle_t handle, const uint16_t astep) {
+    as7341_device_t* dev = (as7341_device_t*)handle;
+
     /* validate arguments */
-    ESP_ARG_CHECK( handle );
+    ESP_ARG_CHECK( dev );
 
     /* attempt to set register */
     ESP_RETURN_ON_ERROR( as7341_set_astep_register(handle, astep), TAG, "write astep register for set astep failed" );
 
+    /* set configuration */
+    dev->config.astep = astep;
+
     return ESP_OK;
 }
 
@@ -1396,10 +1546,11 @@ esp_err_t as7341_disable_flicker_detection(as7341_handle_t handle) {
 }
 
 esp_err_t as7341_enable_smux(as7341_handle_t handle) {
+    as7341_device_t* dev = (as7341_device_t*)handle;
     as7341_enable_register_t enable;
 
     /* validate arguments */
-    ESP_ARG_CHECK( handle );
+    ESP_ARG_CHECK( dev );
 
     /* attempt to read */
     ESP_RETURN_ON_ERROR( as7341_get_enable_register(handle, &enable), TAG, "read enable register for enable SMUX failed" );
@@ -1413,17 +1564,21 @@ esp_err_t as7341_enable_smux(as7341_handle_t handle) {
     /* validate SMUX operation completed */
     uint16_t timeout = 1000;
     for (uint16_t time = 0; time < timeout; time++) {
-        // The SMUXEN bit is cleared once the SMUX operation is finished
-        ESP_RETURN_ON_ERROR( as7341_get_enable_register(handle, &enable), TAG, "read enable register for enable SMUX failed" );
+        // The SMUXEN bit is cleared once the SMUX operation is finished, read from the device
+        ESP_RETURN_ON_ERROR( as7341_i2c_read_byte_from(dev, AS7341_ENABLE, &enable.reg), TAG, "read enable register for enable SMUX failed" );
 
         if (!enable.bits.smux_enabled) {
-            return ESP_OK;
+            /* update register cache with the cleared bit */
+            return i2c_regcache_store(&dev->regcache, AS7341_ENABLE, enable.reg);
         }
 
         /* delay before next i2c transaction */
         vTaskDelay(pdMS_TO_TICKS(AS7341_CMD_DELAY_MS));
     }
 
+    /* cached enable register is stale */
+    i2c_regcache_invalidate_range(&dev->regcache, AS7341_ENABLE, 1);
+
     return ESP_ERR_INVALID_STATE;
 }
 
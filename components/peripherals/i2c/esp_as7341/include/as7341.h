@@ -794,6 +794,36 @@ esp_err_t as7341_get_basic_counts(as7341_handle_t handle, const as7341_channels_
  */
 esp_err_t as7341_get_flicker_detection_status(as7341_handle_t handle, as7341_flicker_detection_states_t *const state);
 
+/**
+ * @brief Starts an AS7341 spectral measurement, low channels F1 to F4 first, without waiting for the integration to complete.
+ *
+ * @note Use `as7341_get_measurement_ready_time` to schedule the `as7341_collect_measurement` calls.
+ * 
+ * @param[in] handle AS7341 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t as7341_start_measurement(as7341_handle_t handle);
+
+/**
+ * @brief Gets the AS7341 integration time of one SMUX phase, in microseconds, computed from the configured ATIME and ASTEP.
+ * 
+ * @param[in] handle AS7341 device handle.
+ * @param[out] ready_time_us Integration time of one SMUX phase in microseconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t as7341_get_measurement_ready_time(as7341_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads spectral sensors measurements, F1 to F8, Clear and NIR, from AS7341 after `as7341_start_measurement`.  This 
+ * is a non-blocking function.  A full measurement takes two SMUX phases: the first successful read stores the low channels,
+ * starts the high channels integration and returns ESP_ERR_NOT_FINISHED, call again after another ready time to get the results.
+ * 
+ * @param[in] handle AS7341 device handle.
+ * @param[out] spectral_data Spectral sensors data from AS7341.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FINISHED when the integration is still in progress or the high channels were started.
+ */
+esp_err_t as7341_collect_measurement(as7341_handle_t handle, as7341_channels_spectral_data_t *const spectral_data);
+
 /**
  * @brief Reads data status from AS7341.
  * 
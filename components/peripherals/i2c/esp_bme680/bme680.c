@@ -47,6 +47,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_regcache.h>
 
 /**
  * possible BME680 registers
@@ -103,6 +104,13 @@
                                                 // http://bmcnoldy.rsmas.miami.edu/Humidity.html
 
 
+#define BME680_CALIB_DATA1_SIZE     UINT8_C(23)    //!< bme680 calibration data area 1 (0x8A to 0xA0) burst read size
+#define BME680_CALIB_DATA2_SIZE     UINT8_C(14)    //!< bme680 calibration data area 2 (0xE1 to 0xEE) burst read size
+#define BME680_CALIB_DATA3_SIZE     UINT8_C(5)     //!< bme680 calibration data area 3 (0x00 to 0x04) burst read size
+#define BME680_STATUS_DATA_SIZE     UINT8_C(15)    //!< bme680 status 0 (0x1D) through gas lsb (0x2B) burst read size
+#define BME680_REGCACHE_SIZE        UINT8_C(6)     //!< bme680 cached control gas 0 (0x70) through configuration (0x75) registers
+#define BME680_REGCACHE_VOLATILE    UINT32_C(0x08) //!< bme680 spi memory page (0x73) is not cached
+
 #define BME680_DATA_POLL_TIMEOUT_MS UINT16_C(1500) // ? see datasheet tables 13 and 14, standby-time could be 2-seconds (2000ms)
 #define BME680_DATA_READY_DELAY_MS  UINT16_C(1)
 #define BME680_POWERUP_DELAY_MS     UINT16_C(25)
@@ -129,6 +137,7 @@ typedef struct bme680_device_s {
     uint8_t                                 chip_id;            /*!< bme680 chip identification register */
     uint16_t                                ambient_temperature;
     uint8_t                                 variant_id;
+    i2c_regcache_t                          regcache;           /*!< bme680 control and configuration register cache */
 } bme680_device_t;
 
 /*
@@ -427,6 +436,86 @@ static inline uint32_t bme680_get_measurement_duration(bme680_device_t *const de
     return meas_dur;
 }
 
+/**
+ * @brief Gets the heater duration of a heater profile setpoint in milliseconds.
+ * 
+ * @param device BME680 device descriptor.
+ * @param setpoint Heater profile setpoint.
+ * @return uint16_t Heater duration in milliseconds.
+ */
+static inline uint16_t bme680_get_heater_duration(bme680_device_t *const device, const uint8_t setpoint) {
+    /* a single setpoint uses the forced mode heater duration, see setup heater profiles */
+    if (device->config.heater_profile_size <= 1 || setpoint >= device->config.heater_profile_size) {
+        return device->config.heater_duration;
+    }
+
+    return device->config.heater_duration_profile[setpoint];
+}
+
+/**
+ * @brief Reads the BME680 adc signals.  In forced mode the estimated measurement and heater duration 
+ * is waited before the first poll, then status 0 and the adc data are read in one sequence per poll 
+ * until new data is available.
+ * 
+ * @param device BME680 device descriptor.
+ * @param heater_duration Heater duration of the measurement in milliseconds.
+ * @param data BME680 adc data.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t bme680_i2c_get_adc_signals(bme680_device_t *const device, const uint16_t heater_duration, bme680_adc_data_t *const data) {
+    uint8_t                   rx[BME680_STATUS_DATA_SIZE] = { 0 };
+    bme680_status0_register_t status0_reg = { 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && data );
+
+    /* wait for the estimated measurement duration */
+    if (device->config.power_mode == BME680_POWER_MODE_FORCED) {
+        uint32_t wait_ms = (bme680_get_measurement_duration(device) + 999) / 1000;
+        if (device->config.gas_enabled == true) wait_ms += heater_duration;
+        vTaskDelay(pdMS_TO_TICKS(wait_ms));
+    }
+
+    /* set start time for timeout monitoring */
+    const uint64_t start_time = esp_timer_get_time();
+
+    /* attempt to poll until data is available or timeout, status and data are read in one sequence to ensure they match */
+    for (;;) {
+        ESP_RETURN_ON_ERROR( bme680_i2c_read_from(device, BME680_REG_STATUS0, rx, sizeof(rx)), TAG, "read status 0 and adc data failed" );
+
+        status0_reg.reg = rx[0];
+        if (status0_reg.bits.new_data == true) break;
+
+        /* validate timeout condition */
+        if (ESP_TIMEOUT_CHECK(start_time, BME680_DATA_POLL_TIMEOUT_MS * 1000))
+            return ESP_ERR_TIMEOUT;
+
+        /* delay task before next i2c transaction */
+        vTaskDelay(pdMS_TO_TICKS(BME680_DATA_READY_DELAY_MS));
+    }
+
+    /* instantiate gas lsb register, data starts at 0x1F */
+    bme680_gas_lsb_register_t gas_lsb_reg = { .reg = rx[14] };
+
+    /* initialize data structure */
+    data->pressure       = ((uint32_t)rx[2] << 12) | ((uint32_t)rx[3] << 4) | ((uint32_t)rx[4] >> 4);
+    data->temperature    = ((uint32_t)rx[5] << 12) | ((uint32_t)rx[6] << 4) | ((uint32_t)rx[7] >> 4);
+    data->humidity       = ((uint16_t)rx[8] << 8) | (uint16_t)rx[9];
+    data->gas            = ((uint16_t)rx[13] << 2) | ((uint16_t)rx[14] >> 6);
+    data->gas_index      = status0_reg.bits.gas_measurement_index;
+    data->gas_range      = gas_lsb_reg.bits.gas_range;
+    data->heater_stable  = gas_lsb_reg.bits.heater_stable;
+    data->gas_valid      = gas_lsb_reg.bits.gas_valid;
+
+    ESP_LOGD(TAG, "ADC humidity:    %u", data->humidity);
+    ESP_LOGD(TAG, "ADC temperature: %lu", data->temperature);
+    ESP_LOGD(TAG, "ADC pressure:    %lu", data->pressure);
+    ESP_LOGD(TAG, "ADC gas:         %u", data->gas);
+    ESP_LOGD(TAG, "ADC gas index:   %u", data->gas_index);
+
+    return ESP_OK;
+}
+
 /**
  * @brief Gets the calibration factors onboard the bme680.  see datasheet for details.
  *
@@ -434,46 +523,49 @@ static inline uint32_t bme680_get_measurement_duration(bme680_device_t *const de
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t bme680_get_cal_factors(bme680_device_t *const device) {
-    bit16_uint8_buffer_t rx;
+    uint8_t rx1[BME680_CALIB_DATA1_SIZE] = { 0 };
+    uint8_t rx2[BME680_CALIB_DATA2_SIZE] = { 0 };
+    uint8_t rx3[BME680_CALIB_DATA3_SIZE] = { 0 };
 
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* bme680 attempt to request T1-T3 calibration values from device */
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0xe9, &device->cal_factors->par_T1) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x8a, (uint16_t *)&device->cal_factors->par_T2) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x8c, (uint8_t *)&device->cal_factors->par_T3) );
-    /* bme680 attempt to request H1-H7 calibration values from device */
-    ESP_ERROR_CHECK( bme680_i2c_read_from(device, 0xe2, rx, BIT16_UINT8_BUFFER_SIZE) );
-    device->cal_factors->par_H1 = (uint16_t)(((uint16_t)rx[1] << 4) | (rx[0] & 0x0F));
-    ESP_ERROR_CHECK( bme680_i2c_read_from(device, 0xe1, rx, BIT16_UINT8_BUFFER_SIZE) );
-    device->cal_factors->par_H2 = (uint16_t)(((uint16_t)rx[0] << 4) | (rx[1] >> 4));
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xe4, (uint8_t *)&device->cal_factors->par_H3) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xe5, (uint8_t *)&device->cal_factors->par_H4) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xe6, (uint8_t *)&device->cal_factors->par_H5) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xe7, &device->cal_factors->par_H6) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xe8, (uint8_t *)&device->cal_factors->par_H7) );
-    /* bme680 attempt to request P1-P10 calibration values from device */
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x8e, &device->cal_factors->par_P1) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x90, (uint16_t *)&device->cal_factors->par_P2) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x92, (uint8_t *)&device->cal_factors->par_P3) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x94, (uint16_t *)&device->cal_factors->par_P4) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x96, (uint16_t *)&device->cal_factors->par_P5) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x99, (uint8_t *)&device->cal_factors->par_P6) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x98, (uint8_t *)&device->cal_factors->par_P7) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x9c, (uint16_t *)&device->cal_factors->par_P8) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0x9e, (uint16_t *)&device->cal_factors->par_P9) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xa0, &device->cal_factors->par_P10) );
-    /* bme680 attempt to request G1-G3 calibration values from device */
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xed, (uint8_t *)&device->cal_factors->par_G1) );
-    ESP_ERROR_CHECK( bme680_i2c_read_word_from(device, 0xeb, (uint16_t *)&device->cal_factors->par_G2) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0xee, (uint8_t *)&device->cal_factors->par_G3) );
-    /* bme680 attempt to request gas range and switching error values from device */
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x02, &device->cal_factors->res_heat_range) );
-    device->cal_factors->res_heat_range = (device->cal_factors->res_heat_range & 0x30) / 16;
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x00, (uint8_t *)&device->cal_factors->res_heat_val) );
-    ESP_ERROR_CHECK( bme680_i2c_read_byte_from(device, 0x04, (uint8_t *)&device->cal_factors->range_switching_error) );
-    device->cal_factors->range_switching_error = (device->cal_factors->range_switching_error & 0xf0) / 16;
+    /* bme680 attempt to request calibration areas from device in one sequence each */
+    ESP_RETURN_ON_ERROR( bme680_i2c_read_from(device, 0x8a, rx1, sizeof(rx1)), TAG, "read calibration data area 1 failed" );
+    ESP_RETURN_ON_ERROR( bme680_i2c_read_from(device, 0xe1, rx2, sizeof(rx2)), TAG, "read calibration data area 2 failed" );
+    ESP_RETURN_ON_ERROR( bme680_i2c_read_from(device, 0x00, rx3, sizeof(rx3)), TAG, "read calibration data area 3 failed" );
+
+    /* bme680 T1-T3 calibration values, words are little-endian */
+    device->cal_factors->par_T1 = (uint16_t)rx2[8] | (uint16_t)rx2[9] << 8;
+    device->cal_factors->par_T2 = (int16_t)((uint16_t)rx1[0] | (uint16_t)rx1[1] << 8);
+    device->cal_factors->par_T3 = (int8_t)rx1[2];
+    /* bme680 H1-H7 calibration values */
+    device->cal_factors->par_H1 = (uint16_t)(((uint16_t)rx2[2] << 4) | (rx2[1] & 0x0F));
+    device->cal_factors->par_H2 = (uint16_t)(((uint16_t)rx2[0] << 4) | (rx2[1] >> 4));
+    device->cal_factors->par_H3 = (int8_t)rx2[3];
+    device->cal_factors->par_H4 = (int8_t)rx2[4];
+    device->cal_factors->par_H5 = (int8_t)rx2[5];
+    device->cal_factors->par_H6 = rx2[6];
+    device->cal_factors->par_H7 = (int8_t)rx2[7];
+    /* bme680 P1-P10 calibration values */
+    device->cal_factors->par_P1 = (uint16_t)rx1[4] | (uint16_t)rx1[5] << 8;
+    device->cal_factors->par_P2 = (int16_t)((uint16_t)rx1[6] | (uint16_t)rx1[7] << 8);
+    device->cal_factors->par_P3 = (int8_t)rx1[8];
+    device->cal_factors->par_P4 = (int16_t)((uint16_t)rx1[10] | (uint16_t)rx1[11] << 8);
+    device->cal_factors->par_P5 = (int16_t)((uint16_t)rx1[12] | (uint16_t)rx1[13] << 8);
+    device->cal_factors->par_P6 = (int8_t)rx1[15];
+    device->cal_factors->par_P7 = (int8_t)rx1[14];
+    device->cal_factors->par_P8 = (int16_t)((uint16_t)rx1[18] | (uint16_t)rx1[19] << 8);
+    device->cal_factors->par_P9 = (int16_t)((uint16_t)rx1[20] | (uint16_t)rx1[21] << 8);
+    device->cal_factors->par_P10 = rx1[22];
+    /* bme680 G1-G3 calibration values */
+    device->cal_factors->par_G1 = (int8_t)rx2[12];
+    device->cal_factors->par_G2 = (int16_t)((uint16_t)rx2[10] | (uint16_t)rx2[11] << 8);
+    device->cal_factors->par_G3 = (int8_t)rx2[13];
+    /* bme680 gas range and switching error values */
+    device->cal_factors->res_heat_range = (rx3[2] & 0x30) / 16;
+    device->cal_factors->res_heat_val = (int8_t)rx3[0];
+    device->cal_factors->range_switching_error = (int8_t)((rx3[4] & 0xf0) / 16);
 
     /*
     ESP_LOGD(TAG, "Calibration data received:");
@@ -663,6 +755,9 @@ static inline esp_err_t bme680_setup(bme680_device_t *const device) {
     /* attempt to read variant identifier register from device */
     ESP_RETURN_ON_ERROR(bme680_get_variant_id_register((bme680_handle_t)device, &device->variant_id), TAG, "read variant identifier register for setup failed" );
 
+    /* attempt to read control and configuration registers in one sequence */
+    ESP_RETURN_ON_ERROR(i2c_regcache_refresh(&device->regcache), TAG, "read control and configuration registers for setup failed");
+
     /* attempt to read control humidity register */
     ESP_RETURN_ON_ERROR(bme680_get_control_humidity_register((bme680_handle_t)device, &ctrl_humi_reg), TAG, "read control humidity register for setup failed");
 
@@ -829,11 +924,8 @@ esp_err_t bme680_get_control_measurement_register(bme680_handle_t handle, bme680
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_read_byte_from(dev, BME680_REG_CTRL_MEAS, &reg->reg), TAG, "read control measurement register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, BME680_REG_CTRL_MEAS, &reg->reg), TAG, "read control measurement register failed" );
 
     return ESP_OK;
 }
@@ -845,7 +937,7 @@ esp_err_t bme680_set_control_measurement_register(bme680_handle_t handle, const
     ESP_ARG_CHECK( dev );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_CTRL_MEAS, reg.reg), TAG, "write control measurement register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, BME680_REG_CTRL_MEAS, reg.reg), TAG, "write control measurement register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
@@ -859,11 +951,8 @@ esp_err_t bme680_get_control_humidity_register(bme680_handle_t handle, bme680_co
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_read_byte_from(dev, BME680_REG_CTRL_HUMI, &reg->reg), TAG, "read control humidity register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, BME680_REG_CTRL_HUMI, &reg->reg), TAG, "read control humidity register failed" );
 
     return ESP_OK;
 }
@@ -879,7 +968,7 @@ esp_err_t bme680_set_control_humidity_register(bme680_handle_t handle, const bme
     ctrl_hum.bits.reserved2 = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_CTRL_HUMI, ctrl_hum.reg), TAG, "write control humidity register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, BME680_REG_CTRL_HUMI, ctrl_hum.reg), TAG, "write control humidity register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
@@ -893,11 +982,8 @@ esp_err_t bme680_get_control_gas0_register(bme680_handle_t handle, bme680_contro
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_read_byte_from(dev, BME680_REG_CTRL_GAS0, &reg->reg), TAG, "read control gas 0 register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, BME680_REG_CTRL_GAS0, &reg->reg), TAG, "read control gas 0 register failed" );
 
     return ESP_OK;
 }
@@ -913,7 +999,7 @@ esp_err_t bme680_set_control_gas0_register(bme680_handle_t handle, const bme680_
     gas0.bits.reserved2 = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_CTRL_GAS0, gas0.reg), TAG, "write control gas 0 register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, BME680_REG_CTRL_GAS0, gas0.reg), TAG, "write control gas 0 register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
@@ -927,11 +1013,8 @@ esp_err_t bme680_get_control_gas1_register(bme680_handle_t handle, bme680_contro
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_read_byte_from(dev, BME680_REG_CTRL_GAS1, &reg->reg), TAG, "read control gas 1 register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, BME680_REG_CTRL_GAS1, &reg->reg), TAG, "read control gas 1 register failed" );
 
     return ESP_OK;
 }
@@ -946,7 +1029,7 @@ esp_err_t bme680_set_control_gas1_register(bme680_handle_t handle, const bme680_
     gas1.bits.reserved = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_CTRL_GAS1, gas1.reg), TAG, "write control gas 1 register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, BME680_REG_CTRL_GAS1, gas1.reg), TAG, "write control gas 1 register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
@@ -960,11 +1043,8 @@ esp_err_t bme680_get_configuration_register(bme680_handle_t handle, bme680_confi
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_read_byte_from(dev, BME680_REG_CONFIG, &reg->reg), TAG, "read configuration register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&dev->regcache, BME680_REG_CONFIG, &reg->reg), TAG, "read configuration register failed" );
 
     return ESP_OK;
 }
@@ -982,7 +1062,7 @@ esp_err_t bme680_set_configuration_register(bme680_handle_t handle, const bme680
     config.bits.reserved1 = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&dev->regcache, BME680_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
@@ -1024,6 +1104,16 @@ esp_err_t bme680_init(i2c_master_bus_handle_t master_handle, const bme680_config
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &dev->i2c_handle), err_handle, TAG, "i2c0 new bus failed for init");
     }
 
+    /* attempt to initialize control and configuration register cache */
+    const i2c_regcache_config_t regcache_cfg = {
+        .first_register = BME680_REG_CTRL_GAS0,
+        .size           = BME680_REGCACHE_SIZE,
+        .volatile_mask  = BME680_REGCACHE_VOLATILE,
+        .pair_writes    = true,
+        .timeout_ms     = I2C_XFR_TIMEOUT_MS,
+    };
+    ESP_GOTO_ON_ERROR(i2c_regcache_init(&dev->regcache, dev->i2c_handle, &regcache_cfg), err_handle, TAG, "register cache for init failed");
+
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
 
@@ -1063,15 +1153,6 @@ char *bme680_air_quality_to_string(float iaq_score) {
 }
 
 esp_err_t bme680_get_adc_signals(bme680_handle_t handle, bme680_adc_data_t *const data) {
-    esp_err_t       ret             = ESP_OK;
-    bool            data_is_ready   = false;
-    uint8_t         gas_index       = 0;
-    uint16_t        adc_gas_r;
-    uint32_t        adc_press;
-    uint16_t        adc_humi;
-    uint32_t        adc_temp;
-    bit104_uint8_buffer_t rx;
-    bme680_status0_register_t status0_reg;
     bme680_device_t* dev = (bme680_device_t*)handle;
 
     /* validate arguments */
@@ -1079,76 +1160,19 @@ esp_err_t bme680_get_adc_signals(bme680_handle_t handle, bme680_adc_data_t *cons
 
     /* trigger measurement when in forced mode */
     if(dev->config.power_mode == BME680_POWER_MODE_FORCED) {
-        bme680_set_power_mode(handle, dev->config.power_mode);
+        ESP_RETURN_ON_ERROR( bme680_set_power_mode(handle, dev->config.power_mode), TAG, "trigger measurement for get adc signals failed" );
     }
 
-    /* set start time for timeout monitoring */
-    uint64_t start_time = esp_timer_get_time();
-
-    /* attempt to poll until data is available or timeout */
-    do {
-        /* attempt to check if data is ready */
-        //ESP_GOTO_ON_ERROR( bme680_get_data_status(handle, &data_is_ready), err, TAG, "data ready for get adc signals failed." );
-        ESP_GOTO_ON_ERROR( bme680_get_status0_register(handle, &status0_reg), err, TAG, "status 0 register for get adc signals failed." );
-
-        data_is_ready = status0_reg.bits.new_data;
-        gas_index = status0_reg.bits.gas_measurement_index;
-
-        /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(BME680_DATA_READY_DELAY_MS));
-
-        /* validate timeout condition */
-        if (ESP_TIMEOUT_CHECK(start_time, BME680_DATA_POLL_TIMEOUT_MS * 1000))
-            return ESP_ERR_TIMEOUT;
-    } while (data_is_ready == false);
-
-    // need to read in one sequence to ensure they match.
-    ESP_GOTO_ON_ERROR( bme680_i2c_read_from(dev, BME680_REG_PRESS, rx, BIT104_UINT8_BUFFER_SIZE), err, TAG, "read adc data failed" );
-
-    /* instantiate gas lsb register */
-    bme680_gas_lsb_register_t gas_lsb_reg = { .reg = rx[12] };
-
-    /* concat parameters */
-    adc_press = ((uint32_t)rx[0] << 12) | ((uint32_t)rx[1] << 4) | ((uint32_t)rx[2] >> 4);
-    adc_temp  = ((uint32_t)rx[3] << 12) | ((uint32_t)rx[4] << 4) | ((uint32_t)rx[5] >> 4);
-    adc_humi  = ((uint16_t)rx[6] << 8) | (uint16_t)rx[7];
-    adc_gas_r = ((uint16_t)rx[11] << 2) | ((uint16_t)rx[12] >> 6);
-
-    ESP_LOGD(TAG, "ADC humidity:    %u", adc_humi);
-    ESP_LOGD(TAG, "ADC temperature: %lu", adc_temp);
-    ESP_LOGD(TAG, "ADC pressure:    %lu", adc_press);
-    ESP_LOGD(TAG, "ADC gas:         %u", adc_gas_r);
-    ESP_LOGD(TAG, "ADC gas index:  %u", gas_index);
-
-    /* initialize data structure */
-    data->temperature    = adc_temp;
-    data->humidity       = adc_humi;
-    data->pressure       = adc_press;
-    data->gas            = adc_gas_r;
-    data->gas_index      = gas_index;
-    data->gas_range      = gas_lsb_reg.bits.gas_range;
-    data->heater_stable  = gas_lsb_reg.bits.heater_stable;
-    data->gas_valid      = gas_lsb_reg.bits.gas_valid;
+    /* attempt to read adc signals, the heater uses the last setpoint of the profile */
+    ESP_RETURN_ON_ERROR( bme680_i2c_get_adc_signals(dev, bme680_get_heater_duration(dev, dev->config.heater_profile_size - 1), data), TAG, "read adc signals failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
 
     return ESP_OK;
-
-    err:
-        return ret;
 }
 
 esp_err_t bme680_get_adc_signals_by_heater_profile(bme680_handle_t handle, uint8_t profile_index, bme680_adc_data_t *const data) {
-    esp_err_t       ret             = ESP_OK;
-    bool            data_is_ready   = false;
-    uint8_t         gas_index       = 0;
-    uint16_t        adc_gas_r;
-    uint32_t        adc_press;
-    uint16_t        adc_humi;
-    uint32_t        adc_temp;
-    bit104_uint8_buffer_t rx;
-    bme680_status0_register_t status0_reg;
     bme680_control_gas1_register_t ctrl_gas1_reg;
     bme680_device_t* dev = (bme680_device_t*)handle;
 
@@ -1159,74 +1183,26 @@ esp_err_t bme680_get_adc_signals_by_heater_profile(bme680_handle_t handle, uint8
         ESP_RETURN_ON_FALSE( false, ESP_ERR_INVALID_ARG, TAG, "heater duration or temperature profile are empty and cannot be larger than 10, get adc signals by heater profile failed");
     }
 
-    /* trigger measurement when in forced mode */
-    if(dev->config.power_mode == BME680_POWER_MODE_FORCED) {
-        bme680_set_power_mode(handle, dev->config.power_mode);
-    }
-
     /* attempt to read control gas 1 register */
     ESP_RETURN_ON_ERROR(bme680_get_control_gas1_register(handle, &ctrl_gas1_reg), TAG, "read control gas 1 register for setup heater failed");
 
     ctrl_gas1_reg.bits.heater_setpoint = (bme680_heater_setpoints_t)profile_index;
 
-    /* attempt to write control gas 1 register */
+    /* attempt to write control gas 1 register, the setpoint is selected before the measurement is triggered */
     ESP_RETURN_ON_ERROR(bme680_set_control_gas1_register(handle, ctrl_gas1_reg), TAG, "write control gas 1 register for setup heater failed");
 
-    /* set start time for timeout monitoring */
-    uint64_t start_time = esp_timer_get_time();
-
-    /* attempt to poll until data is available or timeout */
-    do {
-        /* attempt to check if data is ready */
-        //ESP_GOTO_ON_ERROR( bme680_get_data_status(handle, &data_is_ready), err, TAG, "data ready for get adc signals failed." );
-        ESP_GOTO_ON_ERROR( bme680_get_status0_register(handle, &status0_reg), err, TAG, "status 0 register for get adc signals failed." );
-
-        data_is_ready = status0_reg.bits.new_data;
-        gas_index = status0_reg.bits.gas_measurement_index;
-
-        /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(BME680_DATA_READY_DELAY_MS));
-
-        /* validate timeout condition */
-        if (ESP_TIMEOUT_CHECK(start_time, BME680_DATA_POLL_TIMEOUT_MS * 1000))
-            return ESP_ERR_TIMEOUT;
-    } while (data_is_ready == false);
-
-    // need to read in one sequence to ensure they match.
-    ESP_GOTO_ON_ERROR( bme680_i2c_read_from(dev, BME680_REG_PRESS, rx, BIT104_UINT8_BUFFER_SIZE), err, TAG, "read adc data failed" );
-
-    /* instantiate gas lsb register */
-    bme680_gas_lsb_register_t gas_lsb_reg = { .reg = rx[12] };
-
-    /* concat parameters */
-    adc_press = ((uint32_t)rx[0] << 12) | ((uint32_t)rx[1] << 4) | ((uint32_t)rx[2] >> 4);
-    adc_temp  = ((uint32_t)rx[3] << 12) | ((uint32_t)rx[4] << 4) | ((uint32_t)rx[5] >> 4);
-    adc_humi  = ((uint16_t)rx[6] << 8) | (uint16_t)rx[7];
-    adc_gas_r = ((uint16_t)rx[11] << 2) | ((uint16_t)rx[12] >> 6);
-
-    ESP_LOGD(TAG, "ADC humidity:    %u", adc_humi);
-    ESP_LOGD(TAG, "ADC temperature: %lu", adc_temp);
-    ESP_LOGD(TAG, "ADC pressure:    %lu", adc_press);
-    ESP_LOGD(TAG, "ADC gas:         %u", adc_gas_r);
-    ESP_LOGD(TAG, "ADC gas index:   %u", gas_index);
+    /* trigger measurement when in forced mode */
+    if(dev->config.power_mode == BME680_POWER_MODE_FORCED) {
+        ESP_RETURN_ON_ERROR( bme680_set_power_mode(handle, dev->config.power_mode), TAG, "trigger measurement for get adc signals by heater profile failed" );
+    }
 
-    /* initialize data structure */
-    data->temperature    = adc_temp;
-    data->humidity       = adc_humi;
-    data->pressure       = adc_press;
-    data->gas            = adc_gas_r;
-    data->gas_index      = gas_index;
-    data->gas_range      = gas_lsb_reg.bits.gas_range;
-    data->heater_stable  = gas_lsb_reg.bits.heater_stable;
-    data->gas_valid      = gas_lsb_reg.bits.gas_valid;
+    /* attempt to read adc signals */
+    ESP_RETURN_ON_ERROR( bme680_i2c_get_adc_signals(dev, bme680_get_heater_duration(dev, profile_index), data), TAG, "read adc signals failed" );
 
     /* delay before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(BME680_CMD_DELAY_MS));
 
     return ESP_OK;
-
-    err:
-        return ret;
 }
 
 
@@ -1341,9 +1317,10 @@ esp_err_t bme680_get_power_mode(bme680_handle_t handle, bme680_power_modes_t *co
 
 esp_err_t bme680_set_power_mode(bme680_handle_t handle, const bme680_power_modes_t power_mode) {
     bme680_control_measurement_register_t   ctrl_meas_reg;
+    bme680_device_t* dev = (bme680_device_t*)handle;
 
     /* validate arguments */
-    ESP_ARG_CHECK( handle );
+    ESP_ARG_CHECK( dev );
 
     /* attempt to read control measurement register */
     ESP_RETURN_ON_ERROR( bme680_get_control_measurement_register(handle, &ctrl_meas_reg), TAG, "read control measurement register for get power mode failed" );
@@ -1354,6 +1331,12 @@ esp_err_t bme680_set_power_mode(bme680_handle_t handle, const bme680_power_modes
     /* attempt to write control measurement register */
     ESP_RETURN_ON_ERROR( bme680_set_control_measurement_register(handle, ctrl_meas_reg), TAG, "write control measurement register for set power mode failed" );
 
+    /* forced mode returns to sleep once the measurement completes, a later read-modify-write must not trigger another measurement */
+    if (power_mode == BME680_POWER_MODE_FORCED) {
+        ctrl_meas_reg.bits.power_mode = BME680_POWER_MODE_SLEEP;
+        ESP_RETURN_ON_ERROR( i2c_regcache_store(&dev->regcache, BME680_REG_CTRL_MEAS, ctrl_meas_reg.reg), TAG, "store control measurement register for set power mode failed" );
+    }
+
     return ESP_OK;
 }
 
@@ -1543,6 +1526,9 @@ esp_err_t bme680_reset(bme680_handle_t handle) {
     /* attempt i2c transaction */
     ESP_RETURN_ON_ERROR( bme680_i2c_write_byte_to(dev, BME680_REG_RESET, BME680_RESET_VALUE), TAG, "write reset register for reset failed" );
 
+    /* registers are back to their reset state */
+    ESP_RETURN_ON_ERROR( i2c_regcache_invalidate(&dev->regcache), TAG, "invalidate register cache for reset failed" );
+
     /* wait until finished copying NVP data */
     // forced delay before next transaction - see datasheet for details
     vTaskDelay(pdMS_TO_TICKS(BME680_RESET_DELAY_MS)); // check is busy in timeout loop...
@@ -42,6 +42,8 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_trace.h>
+#include <i2c_regcache.h>
 
 /**
  * possible BMP280 registers
@@ -76,6 +78,15 @@
 #define BMP280_CMD_DELAY_MS             UINT16_C(5)
 #define BMP280_TX_RX_DELAY_MS           UINT16_C(10)
 
+#define BMP280_STARTUP_TIME_MS          UINT16_C(2)    //!< bmp280 start-up time after power-on or soft-reset, see datasheet section 1
+#define BMP280_STATUS_POLL_DELAY_MS     UINT16_C(1)    //!< bmp280 backoff between status register polls
+#define BMP280_MEAS_TIME_BASE_US        UINT32_C(1250) //!< bmp280 maximum measurement time base, see datasheet section 9.1
+#define BMP280_MEAS_TIME_SAMPLE_US      UINT32_C(2300) //!< bmp280 maximum measurement time per temperature or pressure sample
+#define BMP280_MEAS_TIME_PRESS_US       UINT32_C(575)  //!< bmp280 maximum measurement time pressure overhead when pressure is enabled
+#define BMP280_STATUS_DATA_SIZE         UINT8_C(10)    //!< bmp280 status (0xF3) through temperature xlsb (0xFC) burst read size
+#define BMP280_CALIB_DATA_SIZE          UINT8_C(24)    //!< bmp280 calibration data (0x88 to 0x9F) burst read size
+#define BMP280_REGCACHE_SIZE            UINT8_C(2)     //!< bmp280 cached control measurement (0xF4) and configuration (0xF5) registers
+
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
 /*
@@ -151,6 +162,7 @@ typedef struct bmp280_device_s {
     i2c_master_dev_handle_t                 i2c_handle;         /*!< bmp280 i2c device handle */
     bmp280_cal_factors_t                   *cal_factors;        /*!< bmp280 device calibration factors */
     uint8_t                                 sensor_type;        /*!< sensor type, should be bmp280 */
+    i2c_regcache_t                          regcache;           /*!< bmp280 control measurement and configuration register cache */
 } bmp280_device_t;
 
 /*
@@ -160,6 +172,29 @@ typedef struct bmp280_device_s {
 static const char *TAG = "bmp280";
 
 
+/**
+ * @brief Delays the calling task for at least the requested time, rounded up to the next tick.
+ * 
+ * @param device BMP280 device descriptor.
+ * @param time_us Delay time in microseconds.
+ */
+static inline void bmp280_delay_us(bmp280_device_t *const device, const uint32_t time_us) {
+    const uint32_t tick_us = portTICK_PERIOD_MS * 1000;
+    I2C_TRACE_DELAY(device->i2c_handle, (time_us + tick_us - 1) / tick_us);
+}
+
+/**
+ * @brief Applies the fixed delay after a register access when conservative timing is configured.  Register
+ * accesses need no settling time per the datasheet, so the delay is skipped otherwise.
+ * 
+ * @param device BMP280 device descriptor.
+ */
+static inline void bmp280_cmd_delay(bmp280_device_t *const device) {
+    if (device->config.conservative_timing == true) {
+        I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    }
+}
+
 /**
  * @brief BMP280 I2C HAL read from register address transaction.  This is a write and then read process.
  * 
@@ -176,7 +211,7 @@ static inline esp_err_t bmp280_i2c_read_from(bmp280_device_t *const device, cons
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write/read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_from failed" );
 
     return ESP_OK;
 }
@@ -197,7 +232,7 @@ static inline esp_err_t bmp280_i2c_read_word_from(bmp280_device_t *const device,
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write/read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_word_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_word_from failed" );
 
     /* set output parameter */
     *word = (uint16_t)rx[0] | ((uint16_t)rx[1] << 8);
@@ -221,7 +256,7 @@ static inline esp_err_t bmp280_i2c_read_byte_from(bmp280_device_t *const device,
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write/read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_byte_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp280_i2c_read_byte_from failed" );
 
     /* set output parameter */
     *byte = rx[0];
@@ -244,7 +279,7 @@ static inline esp_err_t bmp280_i2c_write_byte_to(bmp280_device_t *const device,
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -306,23 +341,27 @@ static inline float bmp280_compensate_pressure(bmp280_device_t *const device, co
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t bmp280_i2c_get_cal_factor_registers(bmp280_device_t *const device) {
+    uint8_t rx[BMP280_CALIB_DATA_SIZE] = { 0 };
+
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* bmp280 attempt to request T1-T3 calibration values from device */
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x88, &device->cal_factors->dig_T1) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x8a, (uint16_t *)&device->cal_factors->dig_T2) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x8c, (uint16_t *)&device->cal_factors->dig_T3) );
-    /* bmp280 attempt to request P1-P9 calibration values from device */
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x8e, &device->cal_factors->dig_P1) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x90, (uint16_t *)&device->cal_factors->dig_P2) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x92, (uint16_t *)&device->cal_factors->dig_P3) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x94, (uint16_t *)&device->cal_factors->dig_P4) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x96, (uint16_t *)&device->cal_factors->dig_P5) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x98, (uint16_t *)&device->cal_factors->dig_P6) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x9a, (uint16_t *)&device->cal_factors->dig_P7) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x9c, (uint16_t *)&device->cal_factors->dig_P8) );
-    ESP_ERROR_CHECK( bmp280_i2c_read_word_from(device, 0x9e, (uint16_t *)&device->cal_factors->dig_P9) );
+    /* bmp280 attempt to request T1-T3 and P1-P9 calibration values from device in one sequence */
+    ESP_RETURN_ON_ERROR( bmp280_i2c_read_from(device, BMP280_REG_CALIB, rx, sizeof(rx)), TAG, "read calibration data failed" );
+
+    /* calibration values are little-endian words */
+    device->cal_factors->dig_T1 = (uint16_t)rx[0]  | (uint16_t)rx[1] << 8;
+    device->cal_factors->dig_T2 = (int16_t)((uint16_t)rx[2]  | (uint16_t)rx[3] << 8);
+    device->cal_factors->dig_T3 = (int16_t)((uint16_t)rx[4]  | (uint16_t)rx[5] << 8);
+    device->cal_factors->dig_P1 = (uint16_t)rx[6]  | (uint16_t)rx[7] << 8;
+    device->cal_factors->dig_P2 = (int16_t)((uint16_t)rx[8]  | (uint16_t)rx[9] << 8);
+    device->cal_factors->dig_P3 = (int16_t)((uint16_t)rx[10] | (uint16_t)rx[11] << 8);
+    device->cal_factors->dig_P4 = (int16_t)((uint16_t)rx[12] | (uint16_t)rx[13] << 8);
+    device->cal_factors->dig_P5 = (int16_t)((uint16_t)rx[14] | (uint16_t)rx[15] << 8);
+    device->cal_factors->dig_P6 = (int16_t)((uint16_t)rx[16] | (uint16_t)rx[17] << 8);
+    device->cal_factors->dig_P7 = (int16_t)((uint16_t)rx[18] | (uint16_t)rx[19] << 8);
+    device->cal_factors->dig_P8 = (int16_t)((uint16_t)rx[20] | (uint16_t)rx[21] << 8);
+    device->cal_factors->dig_P9 = (int16_t)((uint16_t)rx[22] | (uint16_t)rx[23] << 8);
 
     /*
     ESP_LOGD(TAG, "Calibration data received:");
@@ -341,7 +380,7 @@ static inline esp_err_t bmp280_i2c_get_cal_factor_registers(bmp280_device_t *con
     */
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
     
     return ESP_OK;
 }
@@ -361,7 +400,7 @@ static inline esp_err_t bmp280_i2c_get_chip_id_register(bmp280_device_t *const d
     ESP_RETURN_ON_ERROR( bmp280_i2c_read_byte_from(device, BMP280_REG_ID, reg), TAG, "read chip identifier register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -381,7 +420,7 @@ static inline esp_err_t bmp280_i2c_get_status_register(bmp280_device_t *const de
     ESP_RETURN_ON_ERROR( bmp280_i2c_read_byte_from(device, BMP280_REG_STATUS, &reg->reg), TAG, "read status register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -397,11 +436,11 @@ static inline esp_err_t bmp280_i2c_get_control_measurement_register(bmp280_devic
     /* validate arguments */
     ESP_ARG_CHECK( device && reg );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_read_byte_from(device, BMP280_REG_CTRL, &reg->reg), TAG, "read control measurement register failed" );
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&device->regcache, BMP280_REG_CTRL, &reg->reg), TAG, "read control measurement register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -418,10 +457,10 @@ static inline esp_err_t bmp280_i2c_set_control_measurement_register(bmp280_devic
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_write_byte_to(device, BMP280_REG_CTRL, reg.reg), TAG, "write control measurement register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&device->regcache, BMP280_REG_CTRL, reg.reg), TAG, "write control measurement register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -437,11 +476,11 @@ static inline esp_err_t bmp280_i2c_get_config_register(bmp280_device_t *const de
     /* validate arguments */
     ESP_ARG_CHECK( device && reg );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_read_byte_from(device, BMP280_REG_CONFIG, &reg->reg), TAG, "read configuration register failed" );
+    /* attempt to read register, served from the register cache */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(&device->regcache, BMP280_REG_CONFIG, &reg->reg), TAG, "read configuration register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -463,10 +502,10 @@ static inline esp_err_t bmp280_i2c_set_config_register(bmp280_device_t *const de
     config.bits.reserved = 0;
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_write_byte_to(device, BMP280_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&device->regcache, BMP280_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -484,58 +523,47 @@ static inline esp_err_t bmp280_i2c_set_reset_register(bmp280_device_t *device) {
     /* attempt i2c write transaction */
     ESP_RETURN_ON_ERROR( bmp280_i2c_write_byte_to(device, BMP280_REG_RESET, BMP280_RESET_VALUE), TAG, "write reset register failed" );
 
-    /* wait until finished copying NVP data */
-    // forced delay before next transaction - see datasheet for details
-    vTaskDelay(pdMS_TO_TICKS(BMP280_RESET_DELAY_MS)); // check is busy in timeout loop...
-
-    return ESP_OK;
-}
+    /* registers are back to their reset state */
+    ESP_RETURN_ON_ERROR( i2c_regcache_invalidate(&device->regcache), TAG, "invalidate register cache failed" );
 
-static inline esp_err_t bmp280_i2c_get_adc_signals(bmp280_device_t *device, int32_t *const temperature, int32_t *const pressure) {
-    esp_err_t        ret            = ESP_OK;
-    uint64_t         start_time     = esp_timer_get_time();
-    bool             data_is_ready  = false;
-    bit48_uint8_buffer_t rx;
+    /* conservative timing keeps the fixed reset delay */
+    if (device->config.conservative_timing == true) {
+        I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP280_RESET_DELAY_MS));
+        return ESP_OK;
+    }
 
-    /* validate arguments */
-    ESP_ARG_CHECK( device && temperature && pressure );
+    /* wait for the datasheet start-up time */
+    bmp280_delay_us(device, BMP280_STARTUP_TIME_MS * 1000);
 
-    /* attempt to poll until data is available or timeout */
+    /* wait until finished copying NVM data */
+    const int64_t start_time = esp_timer_get_time();
+    bmp280_status_register_t status_reg = { 0 };
     do {
-        bmp280_status_register_t status_reg = { 0 };
-
         /* attempt to read device status register */
-        ESP_GOTO_ON_ERROR( bmp280_i2c_get_status_register(device, &status_reg), err, TAG, "read status register for get fixed measurement failed" );
-
-        /* set data is ready flag */
-        data_is_ready = !status_reg.bits.measuring;
-
-        /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(BMP280_DATA_READY_DELAY_MS));
+        ESP_RETURN_ON_ERROR( bmp280_i2c_read_byte_from(device, BMP280_REG_STATUS, &status_reg.reg), TAG, "read status register for reset failed" );
 
         /* validate timeout condition */
-        if (ESP_TIMEOUT_CHECK(start_time, BMP280_DATA_POLL_TIMEOUT_MS * 1000))
+        if (status_reg.bits.image_update == true && ESP_TIMEOUT_CHECK(start_time, BMP280_RESET_DELAY_MS * 1000))
             return ESP_ERR_TIMEOUT;
-    } while (data_is_ready == false);
-
-    // need to read in one sequence to ensure they match.
-    ESP_GOTO_ON_ERROR( bmp280_i2c_read_from(device, BMP280_REG_PRESSURE, rx, BIT48_UINT8_BUFFER_SIZE), err, TAG, "read temperature and pressure data failed" );
 
-    /* concat adc pressure & temperature bytes */
-    const int32_t adc_press = rx[0] << 12 | rx[1] << 4 | rx[2] >> 4;
-    const int32_t adc_temp  = rx[3] << 12 | rx[4] << 4 | rx[5] >> 4;
-
-    /* set output parameters */
-    *temperature = adc_temp;
-    *pressure    = adc_press;
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+        /* back off before next status poll */
+        if (status_reg.bits.image_update == true)
+            bmp280_delay_us(device, BMP280_STATUS_POLL_DELAY_MS * 1000);
+    } while (status_reg.bits.image_update == true);
 
     return ESP_OK;
+}
 
-    err:
-        return ret;
+/**
+ * @brief Gets BMP280 number of samples from oversampling setting.
+ * 
+ * @param oversampling BMP280 oversampling setting, pressure and temperature share the same encoding.
+ * @return uint8_t Number of samples, 0 when the measurement is skipped.
+ */
+static inline uint8_t bmp280_get_oversampling_samples(const uint8_t oversampling) {
+    if (oversampling == 0) return 0;
+    if (oversampling >= 5) return 16;
+    return (uint8_t)(1 << (oversampling - 1));
 }
 
 /**
@@ -554,6 +582,9 @@ static inline esp_err_t bmp280_i2c_setup_registers(bmp280_device_t *const device
     /* attempt to read calibration factors from device */
     ESP_RETURN_ON_ERROR( bmp280_i2c_get_cal_factor_registers(device), TAG, "read calibration factors for get registers failed" );
 
+    /* attempt to read control measurement and configuration registers in one sequence */
+    ESP_RETURN_ON_ERROR( i2c_regcache_refresh(&device->regcache), TAG, "read control measurement and configuration registers for setup failed");
+
     /* attempt to read configuration register */
     ESP_RETURN_ON_ERROR( bmp280_i2c_get_config_register(device, &config_reg), TAG, "read configuration register for setup failed");
 
@@ -585,6 +616,45 @@ static inline esp_err_t bmp280_i2c_setup_registers(bmp280_device_t *const device
     return ESP_OK;
 }
 
+/**
+ * @brief Waits for the first normal mode conversion after setup.  The task is delayed for the datasheet
+ * conversion time of the configured oversampling and the measuring bit of the status register is then
+ * polled until the results are transferred to the data registers.
+ * 
+ * @param device BMP280 device descriptor.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when the conversion is not completed within the application start delay.
+ */
+static inline esp_err_t bmp280_i2c_wait_for_first_conversion(bmp280_device_t *const device) {
+    uint32_t ready_time_us = 0;
+    bmp280_status_register_t status_reg = { 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt to read measurement ready time */
+    ESP_RETURN_ON_ERROR( bmp280_get_measurement_ready_time((bmp280_handle_t)device, &ready_time_us), TAG, "read measurement ready time for first conversion failed" );
+
+    /* wait for the datasheet conversion time */
+    const int64_t start_time = esp_timer_get_time();
+    bmp280_delay_us(device, ready_time_us);
+
+    /* wait until the conversion results are transferred */
+    do {
+        /* attempt to read device status register */
+        ESP_RETURN_ON_ERROR( bmp280_i2c_get_status_register(device, &status_reg), TAG, "read status register for first conversion failed" );
+
+        /* validate timeout condition */
+        if (status_reg.bits.measuring == true && ESP_TIMEOUT_CHECK(start_time, BMP280_APPSTART_DELAY_MS * 1000))
+            return ESP_ERR_TIMEOUT;
+
+        /* back off before next status poll */
+        if (status_reg.bits.measuring == true)
+            bmp280_delay_us(device, BMP280_STATUS_POLL_DELAY_MS * 1000);
+    } while (status_reg.bits.measuring == true);
+
+    return ESP_OK;
+}
+
 esp_err_t bmp280_init(i2c_master_bus_handle_t master_handle, const bmp280_config_t *bmp280_config, bmp280_handle_t *bmp280_handle) {
     /* validate arguments */
     ESP_ARG_CHECK( master_handle && bmp280_config );
@@ -617,10 +687,21 @@ esp_err_t bmp280_init(i2c_master_bus_handle_t master_handle, const bmp280_config
     /* validate device handle */
     if (device->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &device->i2c_handle), err_handle, TAG, "i2c0 new bus failed for init");
+        I2C_TRACE_ADD_DEVICE(device->i2c_handle, "bmp280", i2c_dev_conf.device_address);
     }
 
+    /* attempt to initialize control measurement and configuration register cache */
+    const i2c_regcache_config_t regcache_cfg = {
+        .first_register = BMP280_REG_CTRL,
+        .size           = BMP280_REGCACHE_SIZE,
+        .volatile_mask  = 0,
+        .pair_writes    = true,
+        .timeout_ms     = I2C_XFR_TIMEOUT_MS,
+    };
+    ESP_GOTO_ON_ERROR(i2c_regcache_init(&device->regcache, device->i2c_handle, &regcache_cfg), err_handle, TAG, "register cache for init failed");
+
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
+    bmp280_cmd_delay(device);
 
     /* read and validate device type */
     ESP_GOTO_ON_ERROR(bmp280_i2c_get_chip_id_register(device, &device->sensor_type), err_handle, TAG, "read chip identifier for init failed");
@@ -629,21 +710,27 @@ esp_err_t bmp280_init(i2c_master_bus_handle_t master_handle, const bmp280_config
     }
 
     /* attempt to reset device */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_set_reset_register(device), TAG, "write reset register for init failed" );
+    ESP_GOTO_ON_ERROR(bmp280_i2c_set_reset_register(device), err_handle, TAG, "write reset register for init failed");
 
     /* attempt to setup device */
-    ESP_RETURN_ON_ERROR( bmp280_i2c_setup_registers(device), TAG, "unable to setup device, init failed" );
+    ESP_GOTO_ON_ERROR(bmp280_i2c_setup_registers(device), err_handle, TAG, "unable to setup device, init failed");
+
+    /* delay task before i2c transaction */
+    if (device->config.conservative_timing == true) {
+        I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP280_APPSTART_DELAY_MS));
+    } else if (device->config.power_mode == BMP280_POWER_MODE_NORMAL) {
+        /* normal mode data registers hold reset values until the first conversion completes */
+        ESP_GOTO_ON_ERROR(bmp280_i2c_wait_for_first_conversion(device), err_handle, TAG, "wait for first conversion for init failed");
+    }
 
     /* set output parameter */
     *bmp280_handle = (bmp280_handle_t)device;
 
-    /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_APPSTART_DELAY_MS));
-
     return ESP_OK;
 
     err_handle:
         if (device && device->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
             i2c_master_bus_rm_device(device->i2c_handle);
         }
         free(device);
@@ -652,22 +739,107 @@ esp_err_t bmp280_init(i2c_master_bus_handle_t master_handle, const bmp280_config
 }
 
 esp_err_t bmp280_get_measurements(bmp280_handle_t handle, float *const temperature, float *const pressure) {
-    int32_t adc_press, adc_temp;
-     bmp280_device_t* device = (bmp280_device_t*)handle;
+    esp_err_t        ret            = ESP_OK;
+    uint32_t         ready_time_us  = 0;
+    bmp280_device_t* device = (bmp280_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && temperature && pressure );
+
+    /* forced mode triggers a conversion and waits the datasheet conversion time for the configured oversampling */
+    if (device->config.power_mode == BMP280_POWER_MODE_FORCED) {
+        ESP_RETURN_ON_ERROR( bmp280_start_measurement(handle), TAG, "start measurement for get measurements failed" );
+        ESP_RETURN_ON_ERROR( bmp280_get_measurement_ready_time(handle, &ready_time_us), TAG, "read measurement ready time for get measurements failed" );
+        bmp280_delay_us(device, ready_time_us);
+    }
+
+    /* attempt to collect until data is available or timeout */
+    const int64_t start_time = esp_timer_get_time();
+    while ((ret = bmp280_collect_measurement(handle, temperature, pressure)) == ESP_ERR_NOT_FINISHED) {
+        /* validate timeout condition */
+        if (ESP_TIMEOUT_CHECK(start_time, BMP280_DATA_POLL_TIMEOUT_MS * 1000))
+            return ESP_ERR_TIMEOUT;
+
+        /* delay task before next i2c transaction */
+        bmp280_delay_us(device, BMP280_DATA_READY_DELAY_MS * 1000);
+    }
+
+    /* validate collected measurement */
+    ESP_RETURN_ON_ERROR( ret, TAG, "read temperature and pressure adc signals failed" );
+
+    /* delay before next i2c transaction */
+    bmp280_cmd_delay(device);
+
+    return ESP_OK;
+}
+
+esp_err_t bmp280_start_measurement(bmp280_handle_t handle) {
+    bmp280_control_measurement_register_t ctrl_meas_reg = { 0 };
+    bmp280_device_t* device = (bmp280_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* normal mode converts continuously and sleep mode never converts */
+    if (device->config.power_mode == BMP280_POWER_MODE_NORMAL) return ESP_OK;
+    ESP_RETURN_ON_FALSE( device->config.power_mode == BMP280_POWER_MODE_FORCED, ESP_ERR_INVALID_STATE, TAG, "device is in sleep mode, start measurement failed" );
+
+    /* initialize control measurement register, forced mode returns to sleep once the conversion completes */
+    ctrl_meas_reg.bits.power_mode               = BMP280_POWER_MODE_FORCED;
+    ctrl_meas_reg.bits.temperature_oversampling = device->config.temperature_oversampling;
+    ctrl_meas_reg.bits.pressure_oversampling    = device->config.pressure_oversampling;
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(&device->regcache, BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "write control measurement register for start measurement failed" );
+
+    /* the device returns to sleep mode on its own, a later read-modify-write must not trigger another conversion */
+    ctrl_meas_reg.bits.power_mode = BMP280_POWER_MODE_SLEEP;
+    ESP_RETURN_ON_ERROR( i2c_regcache_store(&device->regcache, BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "store control measurement register for start measurement failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t bmp280_get_measurement_ready_time(bmp280_handle_t handle, uint32_t *const ready_time_us) {
+    bmp280_device_t* device = (bmp280_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && ready_time_us );
+
+    const uint8_t temperature_samples = bmp280_get_oversampling_samples(device->config.temperature_oversampling);
+    const uint8_t pressure_samples    = bmp280_get_oversampling_samples(device->config.pressure_oversampling);
+
+    /* maximum measurement time, see datasheet appendix b */
+    *ready_time_us = BMP280_MEAS_TIME_BASE_US + BMP280_MEAS_TIME_SAMPLE_US * temperature_samples;
+    if (pressure_samples) {
+        *ready_time_us += BMP280_MEAS_TIME_SAMPLE_US * pressure_samples + BMP280_MEAS_TIME_PRESS_US;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t bmp280_collect_measurement(bmp280_handle_t handle, float *const temperature, float *const pressure) {
+    bmp280_status_register_t status_reg = { 0 };
+    uint8_t rx[BMP280_STATUS_DATA_SIZE] = { 0 };
+    bmp280_device_t* device = (bmp280_device_t*)handle;
 
     /* validate arguments */
     ESP_ARG_CHECK( device && temperature && pressure );
 
-    // need to read in one sequence to ensure they match.
-    ESP_RETURN_ON_ERROR( bmp280_i2c_get_adc_signals(device, &adc_temp, &adc_press), TAG, "read temperature and pressure adc signals failed" );
+    /* attempt to read status through data registers in one sequence */
+    ESP_RETURN_ON_ERROR( bmp280_i2c_read_from(device, BMP280_REG_STATUS, rx, sizeof(rx)), TAG, "read status, temperature and pressure data for collect measurement failed" );
+
+    /* validate conversion completed */
+    status_reg.reg = rx[0];
+    if (status_reg.bits.measuring == true) return ESP_ERR_NOT_FINISHED;
+
+    /* concat adc pressure & temperature bytes, data starts at 0xF7 */
+    const int32_t adc_press = rx[4] << 12 | rx[5] << 4 | rx[6] >> 4;
+    const int32_t adc_temp  = rx[7] << 12 | rx[8] << 4 | rx[9] >> 4;
 
     /* compensate adc temperature & pressure and set output parameters */
     *temperature = bmp280_compensate_temperature(device, adc_temp);
     *pressure    = bmp280_compensate_pressure(device, adc_press);
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP280_CMD_DELAY_MS));
-
     return ESP_OK;
 }
 
@@ -719,6 +891,9 @@ esp_err_t bmp280_set_power_mode(bmp280_handle_t handle, const bmp280_power_modes
     /* attempt to write control measurement register */
     ESP_RETURN_ON_ERROR( bmp280_i2c_set_control_measurement_register(device, ctrl_meas_reg), TAG, "write control measurement register for set power mode failed" );
 
+    /* set configuration */
+    device->config.power_mode = power_mode;
+
     return ESP_OK;
 }
 
@@ -754,6 +929,9 @@ esp_err_t bmp280_set_pressure_oversampling(bmp280_handle_t handle, const bmp280_
     /* attempt to write control measurement register */
     ESP_RETURN_ON_ERROR( bmp280_i2c_set_control_measurement_register(device, ctrl_meas_reg), TAG, "write control measurement register for set pressure oversampling failed" );
 
+    /* set configuration */
+    device->config.pressure_oversampling = oversampling;
+
     return ESP_OK;
 }
 
@@ -789,6 +967,9 @@ esp_err_t bmp280_set_temperature_oversampling(bmp280_handle_t handle, const bmp2
     /* attempt to write control measurement register */
     ESP_RETURN_ON_ERROR( bmp280_i2c_set_control_measurement_register(device, ctrl_meas_reg), TAG, "write control measurement register for set temperature oversampling failed" );
 
+    /* set configuration */
+    device->config.temperature_oversampling = oversampling;
+
     return ESP_OK;
 }
 
@@ -883,6 +1064,7 @@ esp_err_t bmp280_remove(bmp280_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
+    I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
     return i2c_master_bus_rm_device(device->i2c_handle);
 }
 
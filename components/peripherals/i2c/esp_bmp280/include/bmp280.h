@@ -74,7 +74,8 @@ extern "C" {
         .iir_filter                 = BMP280_IIR_FILTER_OFF,                 \
         .pressure_oversampling      = BMP280_PRESSURE_OVERSAMPLING_4X,       \
         .temperature_oversampling   = BMP280_TEMPERATURE_OVERSAMPLING_4X,    \
-        .standby_time               = BMP280_STANDBY_TIME_250MS }
+        .standby_time               = BMP280_STANDBY_TIME_250MS,             \
+        .conservative_timing        = false }
 
 
 /**
@@ -150,6 +151,7 @@ typedef struct bmp280_config_s {
     bmp280_pressure_oversampling_t          pressure_oversampling;      /*!< bmp280 pressure oversampling setting */
     bmp280_temperature_oversampling_t       temperature_oversampling;   /*!< bmp280 temperature oversampling setting */
     bmp280_standby_times_t                  standby_time;               /*!< bmp280 stand-by time setting */
+    bool                                    conservative_timing;        /*!< bmp280 applies the legacy fixed delays after every register access when true, otherwise waits are derived from the datasheet timing */
 } bmp280_config_t;
 
 
@@ -182,6 +184,37 @@ esp_err_t bmp280_init(i2c_master_bus_handle_t master_handle, const bmp280_config
  */
 esp_err_t bmp280_get_measurements(bmp280_handle_t handle, float *const temperature, float *const pressure);
 
+/**
+ * @brief Starts a BMP280 measurement without waiting for the conversion to complete.  A forced mode conversion
+ * is triggered with the configured oversampling, normal mode is already converting and returns immediately.
+ *
+ * @note Use `bmp280_get_measurement_ready_time` to schedule the `bmp280_collect_measurement` call.
+ *
+ * @param[in] handle BMP280 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the device is configured for sleep mode.
+ */
+esp_err_t bmp280_start_measurement(bmp280_handle_t handle);
+
+/**
+ * @brief Gets the BMP280 maximum conversion time, in microseconds, computed from the configured temperature
+ * and pressure oversampling.
+ *
+ * @param[in] handle BMP280 device handle.
+ * @param[out] ready_time_us Measurement conversion time in microseconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t bmp280_get_measurement_ready_time(bmp280_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads temperature and pressure from BMP280 after `bmp280_start_measurement`.  This is a non-blocking function.
+ *
+ * @param[in] handle BMP280 device handle.
+ * @param[out] temperature Temperature in degree Celsius.
+ * @param[out] pressure Pressure in pascal.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FINISHED when the conversion is still in progress.
+ */
+esp_err_t bmp280_collect_measurement(bmp280_handle_t handle, float *const temperature, float *const pressure);
+
 /**
  * @brief Reads data status from BMP280.
  * 
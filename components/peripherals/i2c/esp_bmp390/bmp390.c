@@ -43,6 +43,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_trace.h>
 
 /**
  * possible BMP390 registers
@@ -69,8 +70,34 @@
 #define BMP390_REG_INT_CNTRL            UINT8_C(0x19)
 #define BMP390_REG_CHIP_ID              UINT8_C(0x00)
 #define BMP390_REG_ERR                  UINT8_C(0x02)
+#define BMP390_REG_FIFO_LENGTH_0        UINT8_C(0x12)
+#define BMP390_REG_FIFO_LENGTH_1        UINT8_C(0x13)
+#define BMP390_REG_FIFO_LENGTH          (BMP390_REG_FIFO_LENGTH_0)
+#define BMP390_REG_FIFO_DATA            UINT8_C(0x14)
+#define BMP390_REG_FIFO_WTM_0           UINT8_C(0x15)
+#define BMP390_REG_FIFO_WTM_1           UINT8_C(0x16)
+#define BMP390_REG_FIFO_WTM             (BMP390_REG_FIFO_WTM_0)
+#define BMP390_REG_FIFO_CONFIG_1        UINT8_C(0x17)
+#define BMP390_REG_FIFO_CONFIG_2        UINT8_C(0x18)
 #define BMP390_REG_CMD                  UINT8_C(0x7E)
 #define BMP390_SFTRESET_CMD             UINT8_C(0xB6)
+#define BMP390_FIFO_FLUSH_CMD           UINT8_C(0xB0)
+
+/**
+ * BMP390 FIFO frame headers and sizes (datasheet section 3.6.2)
+ */
+#define BMP390_FIFO_HEADER_PRESS_TEMP   UINT8_C(0x94)   //!< sensor frame, temperature then pressure
+#define BMP390_FIFO_HEADER_TEMP         UINT8_C(0x90)   //!< sensor frame, temperature
+#define BMP390_FIFO_HEADER_PRESS        UINT8_C(0x84)   //!< sensor frame, pressure
+#define BMP390_FIFO_HEADER_TIME         UINT8_C(0xA0)   //!< sensor time frame
+#define BMP390_FIFO_HEADER_EMPTY        UINT8_C(0x80)   //!< empty frame, returned when reading beyond the fill level
+#define BMP390_FIFO_HEADER_CONFIG_CHG   UINT8_C(0x48)   //!< control frame, configuration change
+#define BMP390_FIFO_HEADER_CONFIG_ERR   UINT8_C(0x44)   //!< control frame, configuration error
+#define BMP390_FIFO_HEADER_SIZE         UINT8_C(1)
+#define BMP390_FIFO_CHANNEL_SIZE        UINT8_C(3)
+#define BMP390_FIFO_TIME_FRAME_SIZE     (BMP390_FIFO_HEADER_SIZE + BMP390_FIFO_CHANNEL_SIZE)
+#define BMP390_FIFO_CONTROL_FRAME_SIZE  (BMP390_FIFO_HEADER_SIZE + 1)
+#define BMP390_FIFO_WATERMARK_MAX       UINT16_C(511)   //!< watermark register is 9-bits in bytes
 
 #define BMP390_CHIP_ID_DFLT             UINT8_C(0x60)  //!< BMP390 default
 
@@ -185,6 +212,33 @@ typedef union __attribute__((packed)) bmp390_config_register_u {
 } bmp390_config_register_t;
 
 
+/**
+ * @brief BMP390 FIFO configuration 1 register (0x17) structure.  The reset state is 0x02 for this register.
+ */
+typedef union __attribute__((packed)) bmp390_fifo_config1_register_u {
+    struct {
+        bool    fifo_enabled:1;         /*!< bmp390 FIFO enabled when true                                  (bit:0) */
+        bool    stop_on_full:1;         /*!< bmp390 FIFO stops writing when full when true                  (bit:1) */
+        bool    time_enabled:1;         /*!< bmp390 FIFO returns sensor time frame after last frame when true (bit:2) */
+        bool    pressure_enabled:1;     /*!< bmp390 FIFO stores pressure data when true                     (bit:3) */
+        bool    temperature_enabled:1;  /*!< bmp390 FIFO stores temperature data when true                  (bit:4) */
+        uint8_t reserved:3;             /*!< bmp390 reserved                                                (bit:5-7) */
+    } bits;
+    uint8_t reg;
+} bmp390_fifo_config1_register_t;
+
+/**
+ * @brief BMP390 FIFO configuration 2 register (0x18) structure.  The reset state is 0x02 for this register.
+ */
+typedef union __attribute__((packed)) bmp390_fifo_config2_register_u {
+    struct {
+        bmp390_fifo_subsampling_t   subsampling:3;  /*!< bmp390 FIFO subsampling, 2^subsampling     (bit:0-2) */
+        bmp390_fifo_data_select_t   data_select:2;  /*!< bmp390 FIFO data source                    (bit:3-4) */
+        uint8_t                     reserved:3;     /*!< bmp390 reserved                            (bit:5-7) */
+    } bits;
+    uint8_t reg;
+} bmp390_fifo_config2_register_t;
+
 /**
  * @brief BMP390 temperature and pressure calibration factors structure.
  */
@@ -236,6 +290,9 @@ typedef struct bmp390_device_s {
     i2c_master_dev_handle_t                 i2c_handle;             /*!< bmp380 i2c device handle */
     bmp390_conv_cal_factors_t              *cal_factors;            /*!< bmp390 device calibration factors converted to floating point numbers (section 8.4)*/
     uint8_t                                 type;                   /*!< device type, should be bmp390 */
+    bmp390_fifo_config_t                    fifo_config;            /*!< bmp390 FIFO configuration, valid when the FIFO is enabled */
+    bool                                    fifo_enabled;           /*!< bmp390 FIFO is enabled when true */
+    uint8_t                                 fifo_buffer[BMP390_FIFO_SIZE + BMP390_FIFO_TIME_FRAME_SIZE]; /*!< bmp390 FIFO burst read buffer */
 } bmp390_device_t;
 
 /*
@@ -253,13 +310,13 @@ static const char *TAG = "bmp390";
  * @param size Length of buffer to store results from read transaction.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t bmp390_i2c_read_from(bmp390_device_t *const device, const uint8_t reg_addr, uint8_t *buffer, const uint8_t size) {
+static inline esp_err_t bmp390_i2c_read_from(bmp390_device_t *const device, const uint8_t reg_addr, uint8_t *buffer, const uint16_t size) {
     const bit8_uint8_buffer_t tx = { reg_addr };
 
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_from failed" );
 
     return ESP_OK;
 }
@@ -279,7 +336,7 @@ static inline esp_err_t bmp390_i2c_read_word_from(bmp390_device_t *const device,
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_word_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_word_from failed" );
 
     /* set output parameter */
     *word = (uint16_t)rx[0] | ((uint16_t)rx[1] << 8);
@@ -302,7 +359,7 @@ static inline esp_err_t bmp390_i2c_read_byte_from(bmp390_device_t *const device,
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_byte_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "bmp390_i2c_read_byte_from failed" );
 
     /* set output parameter */
     *byte = rx[0];
@@ -325,7 +382,27 @@ static inline esp_err_t bmp390_i2c_write_byte_to(bmp390_device_t *const device,
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+                        
+    return ESP_OK;
+}
+
+/**
+ * @brief BMP390 I2C HAL write word to register address transaction.  The low byte is written first.
+ * 
+ * @param device BMP390 device descriptor.
+ * @param reg_addr BMP390 register address to write to.
+ * @param word BMP390 write transaction input halfword.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t bmp390_i2c_write_word_to(bmp390_device_t *const device, const uint8_t reg_addr, const uint16_t word) {
+    const bit24_uint8_buffer_t tx = { reg_addr, (uint8_t)(word & 0xff), (uint8_t)(word >> 8) };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, tx, BIT24_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -706,7 +783,7 @@ static inline esp_err_t bmp390_i2c_set_reset_register(bmp390_device_t *const dev
 
     /* wait until finished copying NVP data */
     // forced delay before next transaction - see datasheet for details
-    vTaskDelay(pdMS_TO_TICKS(BMP390_RESET_DELAY_MS)); // check is busy in timeout loop...
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP390_RESET_DELAY_MS)); // check is busy in timeout loop...
 
     return ESP_OK;
 }
@@ -747,7 +824,7 @@ static inline esp_err_t bmp390_i2c_get_adc_signals(bmp390_device_t *const device
         temperature_is_ready = sts.bits.temperature_data_ready;
         
         /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(BMP390_DATA_READY_DELAY_MS));
+        I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP390_DATA_READY_DELAY_MS));
 
         /* validate timeout condition */
         if (ESP_TIMEOUT_CHECK(start_time, BMP390_DATA_POLL_TIMEOUT_MS * 1000))
@@ -779,6 +856,93 @@ static inline esp_err_t bmp390_i2c_get_adc_signals(bmp390_device_t *const device
         return ret;
 }
 
+/**
+ * @brief BMP390 I2C HAL write FIFO configuration 1 register.
+ * 
+ * @param device BMP390 device descriptor.
+ * @param reg BMP390 FIFO configuration 1 register.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t bmp390_i2c_set_fifo_config1_register(bmp390_device_t *const device, const bmp390_fifo_config1_register_t reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* copy register */
+    bmp390_fifo_config1_register_t fifo_config1 = { .reg = reg.reg };
+
+    /* set register reserved settings */
+    fifo_config1.bits.reserved = 0;
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_write_byte_to(device, BMP390_REG_FIFO_CONFIG_1, fifo_config1.reg), TAG, "write fifo configuration 1 register failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief BMP390 I2C HAL write FIFO configuration 2 register.
+ * 
+ * @param device BMP390 device descriptor.
+ * @param reg BMP390 FIFO configuration 2 register.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t bmp390_i2c_set_fifo_config2_register(bmp390_device_t *const device, const bmp390_fifo_config2_register_t reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* copy register */
+    bmp390_fifo_config2_register_t fifo_config2 = { .reg = reg.reg };
+
+    /* set register reserved settings */
+    fifo_config2.bits.reserved = 0;
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_write_byte_to(device, BMP390_REG_FIFO_CONFIG_2, fifo_config2.reg), TAG, "write fifo configuration 2 register failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief BMP390 I2C HAL issue FIFO flush command, all frames are cleared from the FIFO.
+ * 
+ * @param device BMP390 device descriptor.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t bmp390_i2c_set_fifo_flush_register(bmp390_device_t *const device) {
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_write_byte_to(device, BMP390_REG_CMD, BMP390_FIFO_FLUSH_CMD), TAG, "write fifo flush command failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Gets the size of a BMP390 FIFO sensor frame in bytes for the FIFO configuration.
+ * 
+ * @param config BMP390 FIFO configuration.
+ * @return uint8_t Sensor frame size in bytes.
+ */
+static inline uint8_t bmp390_get_fifo_frame_size(const bmp390_fifo_config_t *const config) {
+    uint8_t size = BMP390_FIFO_HEADER_SIZE;
+
+    if(config->pressure_enabled) size += BMP390_FIFO_CHANNEL_SIZE;
+    if(config->temperature_enabled) size += BMP390_FIFO_CHANNEL_SIZE;
+
+    return size;
+}
+
+/**
+ * @brief Concatenates a 24-bit little-endian BMP390 FIFO channel into an adc value.
+ * 
+ * @param buffer FIFO buffer positioned at the channel.
+ * @return uint32_t Raw adc value.
+ */
+static inline uint32_t bmp390_get_fifo_channel(const uint8_t *const buffer) {
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | ((uint32_t)buffer[2] << 16);
+}
+
 /**
  * @brief BMP390 I2C HAL setup and configuration of registers.
  * 
@@ -874,10 +1038,11 @@ esp_err_t bmp390_init(i2c_master_bus_handle_t master_handle, const bmp390_config
     /* validate device handle */
     if (device->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &device->i2c_handle), err_handle, TAG, "i2c0 new bus failed for init");
+        I2C_TRACE_ADD_DEVICE(device->i2c_handle, "bmp390", i2c_dev_conf.device_address);
     }
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP390_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP390_CMD_DELAY_MS));
 
     /* read and validate device type */
     ESP_GOTO_ON_ERROR(bmp390_i2c_get_chip_id_register(device, &device->type), err_handle, TAG, "read chip identifier for init failed");
@@ -895,12 +1060,13 @@ esp_err_t bmp390_init(i2c_master_bus_handle_t master_handle, const bmp390_config
     *bmp390_handle = (bmp390_handle_t)device;
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(BMP390_APPSTART_DELAY_MS));
+    I2C_TRACE_DELAY(device->i2c_handle, pdMS_TO_TICKS(BMP390_APPSTART_DELAY_MS));
 
     return ESP_OK;
 
     err_handle:
         if (device && device->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
             i2c_master_bus_rm_device(device->i2c_handle);
         }
         free(device);
@@ -1074,7 +1240,7 @@ esp_err_t bmp390_set_temperature_oversampling(bmp390_handle_t handle, const bmp3
     return ESP_OK;
 }
 
-esp_err_t bmp280_get_output_data_rate(bmp390_handle_t handle, bmp390_output_data_rates_t *const output_data_rate) {
+esp_err_t bmp390_get_output_data_rate(bmp390_handle_t handle, bmp390_output_data_rates_t *const output_data_rate) {
     bmp390_output_data_rate_register_t odr = { 0 };
     bmp390_device_t* device = (bmp390_device_t*)handle;
 
@@ -1082,7 +1248,7 @@ esp_err_t bmp280_get_output_data_rate(bmp390_handle_t handle, bmp390_output_data
     ESP_ARG_CHECK( device );
 
     /* attempt to read configuration register */
-    ESP_RETURN_ON_ERROR( bmp390_i2c_get_output_data_rate_register(device, &odr), TAG, "read output data rate register for get standby time failed" );
+    ESP_RETURN_ON_ERROR( bmp390_i2c_get_output_data_rate_register(device, &odr), TAG, "read output data rate register for get output data rate failed" );
 
     /* set output parameter */
     *output_data_rate = odr.bits.output_data_rate;
@@ -1090,7 +1256,7 @@ esp_err_t bmp280_get_output_data_rate(bmp390_handle_t handle, bmp390_output_data
     return ESP_OK;
 }
 
-esp_err_t bmp280_set_output_data_rate(bmp390_handle_t handle, const bmp390_output_data_rates_t output_data_rate) {
+esp_err_t bmp390_set_output_data_rate(bmp390_handle_t handle, const bmp390_output_data_rates_t output_data_rate) {
     bmp390_output_data_rate_register_t odr = { 0 };
     bmp390_device_t* device = (bmp390_device_t*)handle;
 
@@ -1098,13 +1264,13 @@ esp_err_t bmp280_set_output_data_rate(bmp390_handle_t handle, const bmp390_outpu
     ESP_ARG_CHECK( device );
 
     /* attempt to read configuration register */
-    ESP_RETURN_ON_ERROR( bmp390_i2c_get_output_data_rate_register(device, &odr), TAG, "read output data rate register for get standby time failed" );
+    ESP_RETURN_ON_ERROR( bmp390_i2c_get_output_data_rate_register(device, &odr), TAG, "read output data rate register for set output data rate failed" );
 
     /* set register setting */
     odr.bits.output_data_rate  = output_data_rate;
 
     /* attempt to write configuration register */
-    ESP_RETURN_ON_ERROR( bmp390_i2c_set_output_data_rate_register(device, odr), TAG, "write output data rate register for set stanby time failed" );
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_output_data_rate_register(device, odr), TAG, "write output data rate register for set output data rate failed" );
 
     /* set config parameter */
     device->config.output_data_rate = output_data_rate;
@@ -1150,6 +1316,220 @@ esp_err_t bmp390_set_iir_filter(bmp390_handle_t handle, const bmp390_iir_filters
     return ESP_OK;
 }
 
+esp_err_t bmp390_enable_fifo(bmp390_handle_t handle, const bmp390_fifo_config_t *const config) {
+    bmp390_fifo_config1_register_t      fifo_config1 = { 0 };
+    bmp390_fifo_config2_register_t      fifo_config2 = { 0 };
+    bmp390_interrupt_control_register_t int_ctrl     = { 0 };
+    bmp390_device_t* device = (bmp390_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && config );
+
+    /* validate fifo configuration */
+    const uint8_t frame_size = bmp390_get_fifo_frame_size(config);
+    ESP_RETURN_ON_FALSE( config->pressure_enabled || config->temperature_enabled, ESP_ERR_INVALID_ARG, TAG, "pressure and/or temperature must be enabled for enable fifo" );
+    ESP_RETURN_ON_FALSE( config->watermark > 0 && config->watermark * frame_size <= BMP390_FIFO_WATERMARK_MAX, ESP_ERR_INVALID_ARG, TAG, "fifo watermark of %u frames is out of range for enable fifo", config->watermark );
+
+    /* attempt to disable fifo while it is reconfigured */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_config1_register(device, fifo_config1), TAG, "write fifo configuration 1 register for enable fifo failed" );
+
+    /* set register settings */
+    fifo_config2.bits.subsampling = config->subsampling;
+    fifo_config2.bits.data_select = config->data_select;
+
+    /* attempt to write fifo configuration 2 register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_config2_register(device, fifo_config2), TAG, "write fifo configuration 2 register for enable fifo failed" );
+
+    /* attempt to write fifo watermark, the watermark register is in bytes */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_write_word_to(device, BMP390_REG_FIFO_WTM, config->watermark * frame_size), TAG, "write fifo watermark register for enable fifo failed" );
+
+    /* attempt to flush fifo */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_flush_register(device), TAG, "flush fifo for enable fifo failed" );
+
+    /* set register settings */
+    fifo_config1.bits.fifo_enabled        = true;
+    fifo_config1.bits.stop_on_full        = config->stop_on_full;
+    fifo_config1.bits.time_enabled        = config->time_enabled;
+    fifo_config1.bits.pressure_enabled    = config->pressure_enabled;
+    fifo_config1.bits.temperature_enabled = config->temperature_enabled;
+
+    /* attempt to write fifo configuration 1 register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_config1_register(device, fifo_config1), TAG, "write fifo configuration 1 register for enable fifo failed" );
+
+    /* attempt to read interrupt control register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_get_interrupt_control_register(device, &int_ctrl), TAG, "read interrupt control register for enable fifo failed" );
+
+    /* set register settings, the data ready interrupt would otherwise wake the host every sample */
+    int_ctrl.bits.irq_fifo_watermark_enabled = config->irq_watermark_enabled;
+    int_ctrl.bits.irq_fifo_full_enabled      = config->irq_full_enabled;
+    if(config->irq_watermark_enabled || config->irq_full_enabled) {
+        int_ctrl.bits.irq_data_ready_enabled = false;
+    }
+
+    /* attempt to write interrupt control register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_interrupt_control_register(device, int_ctrl), TAG, "write interrupt control register for enable fifo failed" );
+
+    /* set config parameters */
+    device->fifo_config  = *config;
+    device->fifo_enabled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t bmp390_disable_fifo(bmp390_handle_t handle) {
+    bmp390_fifo_config1_register_t      fifo_config1 = { 0 };
+    bmp390_interrupt_control_register_t int_ctrl     = { 0 };
+    bmp390_device_t* device = (bmp390_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt to write fifo configuration 1 register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_config1_register(device, fifo_config1), TAG, "write fifo configuration 1 register for disable fifo failed" );
+
+    /* attempt to flush fifo */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_flush_register(device), TAG, "flush fifo for disable fifo failed" );
+
+    /* attempt to read interrupt control register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_get_interrupt_control_register(device, &int_ctrl), TAG, "read interrupt control register for disable fifo failed" );
+
+    /* set register settings */
+    int_ctrl.bits.irq_fifo_watermark_enabled = false;
+    int_ctrl.bits.irq_fifo_full_enabled      = false;
+    int_ctrl.bits.irq_data_ready_enabled     = true;
+
+    /* attempt to write interrupt control register */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_interrupt_control_register(device, int_ctrl), TAG, "write interrupt control register for disable fifo failed" );
+
+    /* set config parameter */
+    device->fifo_enabled = false;
+
+    return ESP_OK;
+}
+
+esp_err_t bmp390_flush_fifo(bmp390_handle_t handle) {
+    bmp390_device_t* device = (bmp390_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt to flush fifo */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_flush_register(device), TAG, "flush fifo failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t bmp390_get_fifo_length(bmp390_handle_t handle, uint16_t *const length) {
+    uint16_t fifo_length = 0;
+    bmp390_device_t* device = (bmp390_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && length );
+
+    /* attempt to read fifo length registers */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_read_word_from(device, BMP390_REG_FIFO_LENGTH, &fifo_length), TAG, "read fifo length registers failed" );
+
+    /* set output parameter, the byte counter is 9-bits */
+    *length = fifo_length & 0x01ff;
+
+    return ESP_OK;
+}
+
+esp_err_t bmp390_read_fifo(bmp390_handle_t handle, bmp390_fifo_data_t *const data) {
+    bit24_uint8_buffer_t rx = { 0 };
+    bmp390_interrupt_status_register_t int_sts = { 0 };
+    bmp390_device_t* device = (bmp390_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && data );
+
+    /* validate fifo state */
+    ESP_RETURN_ON_FALSE( device->fifo_enabled, ESP_ERR_INVALID_STATE, TAG, "fifo is not enabled for read fifo" );
+
+    /* initialize output parameter */
+    data->sample_count        = 0;
+    data->sensor_time         = 0;
+    data->sensor_time_valid   = false;
+    data->config_change_count = 0;
+    data->config_error_count  = 0;
+
+    /* attempt to read interrupt status (cleared on read) and fifo length registers in one transaction */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_read_from(device, BMP390_REG_INT_STATUS, rx, BIT24_UINT8_BUFFER_SIZE), TAG, "read interrupt status and fifo length registers for read fifo failed" );
+
+    int_sts.reg = rx[0];
+    data->full  = int_sts.bits.fifo_full_irq;
+
+    uint16_t length = ((uint16_t)rx[1] | ((uint16_t)rx[2] << 8)) & 0x01ff;
+    if(length == 0) return ESP_OK;
+
+    /* the sensor time frame is appended after the last frame and is not included in the fifo length */
+    if(device->fifo_config.time_enabled) length += BMP390_FIFO_TIME_FRAME_SIZE;
+    if(length > sizeof(device->fifo_buffer)) length = sizeof(device->fifo_buffer);
+
+    /* attempt to drain the fifo in one burst read */
+    ESP_RETURN_ON_ERROR( bmp390_i2c_read_from(device, BMP390_REG_FIFO_DATA, device->fifo_buffer, length), TAG, "read fifo data register for read fifo failed" );
+
+    /* parse frames, the fifo only holds whole frames so a truncated frame ends the stream */
+    uint16_t index = 0;
+    while(index < length) {
+        const uint8_t  header  = device->fifo_buffer[index++];
+        const uint8_t *payload = &device->fifo_buffer[index];
+        const uint16_t remain  = length - index;
+
+        switch(header) {
+            case BMP390_FIFO_HEADER_PRESS_TEMP:
+            case BMP390_FIFO_HEADER_TEMP:
+            case BMP390_FIFO_HEADER_PRESS: {
+                const bool    has_temperature = (header != BMP390_FIFO_HEADER_PRESS);
+                const bool    has_pressure    = (header != BMP390_FIFO_HEADER_TEMP);
+                const uint8_t size            = (has_temperature + has_pressure) * BMP390_FIFO_CHANNEL_SIZE;
+
+                if(remain < size || data->sample_count >= BMP390_FIFO_SAMPLES_MAX) {
+                    index = length;
+                    break;
+                }
+
+                /* temperature precedes pressure and must be compensated first (t_lin) */
+                bmp390_fifo_sample_t *sample = &data->samples[data->sample_count++];
+                sample->temperature = has_temperature ? bmp390_compensate_temperature(device, bmp390_get_fifo_channel(payload)) : NAN;
+                sample->pressure    = has_pressure ? bmp390_compensate_pressure(device, bmp390_get_fifo_channel(payload + (has_temperature ? BMP390_FIFO_CHANNEL_SIZE : 0))) : NAN;
+
+                index += size;
+                break;
+            }
+            case BMP390_FIFO_HEADER_TIME:
+                if(remain < BMP390_FIFO_CHANNEL_SIZE) {
+                    index = length;
+                    break;
+                }
+
+                data->sensor_time       = bmp390_get_fifo_channel(payload);
+                data->sensor_time_valid = true;
+
+                index += BMP390_FIFO_CHANNEL_SIZE;
+                break;
+            case BMP390_FIFO_HEADER_CONFIG_CHG:
+                data->config_change_count++;
+                index += BMP390_FIFO_CONTROL_FRAME_SIZE - BMP390_FIFO_HEADER_SIZE;
+                break;
+            case BMP390_FIFO_HEADER_CONFIG_ERR:
+                data->config_error_count++;
+                index += BMP390_FIFO_CONTROL_FRAME_SIZE - BMP390_FIFO_HEADER_SIZE;
+                break;
+            case BMP390_FIFO_HEADER_EMPTY:
+                index = length;
+                break;
+            default:
+                /* stream is out of sync, flush so the next drain starts on a frame boundary */
+                ESP_LOGW(TAG, "unknown fifo frame header 0x%02x at byte %u, flushing fifo", header, (unsigned)(index - 1));
+                ESP_RETURN_ON_ERROR( bmp390_i2c_set_fifo_flush_register(device), TAG, "flush fifo for read fifo failed" );
+                return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+
+    return ESP_OK;
+}
+
 esp_err_t bmp390_reset(bmp390_handle_t handle) {
     bmp390_device_t* device = (bmp390_device_t*)handle;
 
@@ -1159,6 +1539,9 @@ esp_err_t bmp390_reset(bmp390_handle_t handle) {
     /* attempt i2c transaction */
     ESP_RETURN_ON_ERROR( bmp390_i2c_set_reset_register(device), TAG, "write reset register for reset failed" );
 
+    /* soft-reset restores the fifo configuration defaults */
+    device->fifo_enabled = false;
+
     /* attempt to setup device  */
     ESP_RETURN_ON_ERROR( bmp390_i2c_setup_registers(device), TAG, "setup for reset failed" );
 
@@ -1171,6 +1554,7 @@ esp_err_t bmp390_remove(bmp390_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
+    I2C_TRACE_REMOVE_DEVICE(device->i2c_handle);
     return i2c_master_bus_rm_device(device->i2c_handle);
 }
 
@@ -57,6 +57,12 @@ extern "C" {
 #define I2C_BMP390_DEV_ADDR_LO      UINT8_C(0x76) //!< bmp390 I2C address when ADDR pin low
 #define I2C_BMP390_DEV_ADDR_HI      UINT8_C(0x77) //!< bmp390 I2C address when ADDR pin high
 
+/*
+ * FIFO definitions
+*/
+#define BMP390_FIFO_SIZE            UINT16_C(512)  //!< bmp390 FIFO size in bytes
+#define BMP390_FIFO_SAMPLES_MAX     UINT16_C(128)  //!< bmp390 maximum number of sensor frames the FIFO can hold (4-byte single channel frames)
+
 /*
  * BMP390 macros
 */
@@ -69,6 +75,17 @@ extern "C" {
         .temperature_oversampling   = BMP390_TEMPERATURE_OVERSAMPLING_8X,    \
         .output_data_rate           = BMP390_ODR_40MS }
 
+#define BMP390_FIFO_CONFIG_DEFAULT {                                     \
+        .pressure_enabled           = true,                                  \
+        .temperature_enabled        = true,                                  \
+        .time_enabled               = true,                                  \
+        .stop_on_full               = false,                                 \
+        .subsampling                = BMP390_FIFO_SUBSAMPLING_1,             \
+        .data_select                = BMP390_FIFO_DATA_FILTERED,             \
+        .watermark                  = 64,                                    \
+        .irq_watermark_enabled      = true,                                  \
+        .irq_full_enabled           = false }
+
 /*
  * BMP390 enumerator and structure declarations
 */
@@ -136,6 +153,27 @@ typedef enum bmp390_temperature_oversampling_e {
     BMP390_TEMPERATURE_OVERSAMPLING_32X         = (0b101),  //!< ultra high resolution
 } bmp390_temperature_oversampling_t;
 
+/**
+ * @brief BMP390 FIFO subsampling enumerator.  Only every 2^n-th measurement is written to the FIFO.
+ */
+typedef enum bmp390_fifo_subsampling_e {
+    BMP390_FIFO_SUBSAMPLING_1       = (0b000),  //!< every measurement is stored
+    BMP390_FIFO_SUBSAMPLING_2       = (0b001),  //!< every 2nd measurement is stored
+    BMP390_FIFO_SUBSAMPLING_4       = (0b010),  //!< every 4th measurement is stored
+    BMP390_FIFO_SUBSAMPLING_8       = (0b011),  //!< every 8th measurement is stored
+    BMP390_FIFO_SUBSAMPLING_16      = (0b100),  //!< every 16th measurement is stored
+    BMP390_FIFO_SUBSAMPLING_32      = (0b101),  //!< every 32nd measurement is stored
+    BMP390_FIFO_SUBSAMPLING_64      = (0b110),  //!< every 64th measurement is stored
+    BMP390_FIFO_SUBSAMPLING_128     = (0b111)   //!< every 128th measurement is stored
+} bmp390_fifo_subsampling_t;
+
+/**
+ * @brief BMP390 FIFO data source enumerator.
+ */
+typedef enum bmp390_fifo_data_select_e {
+    BMP390_FIFO_DATA_UNFILTERED     = (0b00),   //!< unfiltered measurements are stored
+    BMP390_FIFO_DATA_FILTERED       = (0b01)    //!< IIR filtered measurements are stored
+} bmp390_fifo_data_select_t;
 
 /**
  * @brief BMP390 configuration structure.
@@ -150,6 +188,42 @@ typedef struct bmp390_config_s {
     bmp390_power_modes_t	                power_mode;                 /*!< bmp390 power mode setting */
 } bmp390_config_t;
 
+/**
+ * @brief BMP390 FIFO configuration structure.
+ */
+typedef struct bmp390_fifo_config_s {
+    bool                                    pressure_enabled;           /*!< bmp390 pressure is stored in the FIFO when true */
+    bool                                    temperature_enabled;        /*!< bmp390 temperature is stored in the FIFO when true */
+    bool                                    time_enabled;               /*!< bmp390 sensor time frame is returned after the last frame when true */
+    bool                                    stop_on_full;               /*!< bmp390 FIFO stops writing when full (true) or overwrites the oldest frames (false) */
+    bmp390_fifo_subsampling_t               subsampling;                /*!< bmp390 FIFO subsampling of the output data rate */
+    bmp390_fifo_data_select_t               data_select;                /*!< bmp390 FIFO data source, filtered or unfiltered */
+    uint16_t                                watermark;                  /*!< bmp390 FIFO watermark in sensor frames */
+    bool                                    irq_watermark_enabled;      /*!< bmp390 FIFO watermark interrupt enabled when true */
+    bool                                    irq_full_enabled;           /*!< bmp390 FIFO full interrupt enabled when true */
+} bmp390_fifo_config_t;
+
+/**
+ * @brief BMP390 FIFO sample structure.  A channel that is not stored in the FIFO is set to NAN.
+ */
+typedef struct bmp390_fifo_sample_s {
+    float                                   temperature;                /*!< bmp390 compensated temperature in degree Celsius */
+    float                                   pressure;                   /*!< bmp390 compensated pressure in pascal */
+} bmp390_fifo_sample_t;
+
+/**
+ * @brief BMP390 FIFO data structure, samples are ordered from oldest to newest.
+ */
+typedef struct bmp390_fifo_data_s {
+    bmp390_fifo_sample_t                    samples[BMP390_FIFO_SAMPLES_MAX]; /*!< bmp390 compensated samples */
+    uint16_t                                sample_count;               /*!< bmp390 number of samples */
+    uint32_t                                sensor_time;                /*!< bmp390 24-bit sensor time of the newest sample */
+    bool                                    sensor_time_valid;          /*!< bmp390 sensor time frame was received when true */
+    uint8_t                                 config_change_count;        /*!< bmp390 number of configuration change frames */
+    uint8_t                                 config_error_count;         /*!< bmp390 number of configuration error frames */
+    bool                                    full;                       /*!< bmp390 FIFO was full, frames may have been lost when true */
+} bmp390_fifo_data_t;
+
 /**
  * @brief BMP390 opaque handle structure definition.
  */
@@ -288,6 +362,52 @@ esp_err_t bmp390_get_iir_filter(bmp390_handle_t handle, bmp390_iir_filters_t *co
  */
 esp_err_t bmp390_set_iir_filter(bmp390_handle_t handle, const bmp390_iir_filters_t iir_filter);
 
+/**
+ * @brief Enables and configures the BMP390 FIFO, the FIFO is flushed and fills while the device is in normal power mode.
+ * The data ready interrupt is disabled when a FIFO interrupt is enabled.  See datasheet, section 3.6.
+ *
+ * @param[in] handle BMP390 device handle.
+ * @param[in] config BMP390 FIFO configuration, the watermark is 1 to 73 frames (pressure and temperature) or 1 to 127 frames (single channel).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t bmp390_enable_fifo(bmp390_handle_t handle, const bmp390_fifo_config_t *const config);
+
+/**
+ * @brief Disables the BMP390 FIFO and FIFO interrupts, and re-enables the data ready interrupt.
+ *
+ * @param[in] handle BMP390 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t bmp390_disable_fifo(bmp390_handle_t handle);
+
+/**
+ * @brief Flushes all frames from the BMP390 FIFO.
+ *
+ * @param[in] handle BMP390 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t bmp390_flush_fifo(bmp390_handle_t handle);
+
+/**
+ * @brief Reads the BMP390 FIFO fill level.
+ *
+ * @param[in] handle BMP390 device handle.
+ * @param[out] length Number of bytes in the FIFO.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t bmp390_get_fifo_length(bmp390_handle_t handle, uint16_t *const length);
+
+/**
+ * @brief Drains the BMP390 FIFO in one burst read and parses sensor, sensor time, configuration change and
+ * empty frames into compensated samples.  The FIFO interrupt status is read and cleared in the same pass.
+ * Pressure only frames are compensated with the most recent temperature.
+ *
+ * @param[in] handle BMP390 device handle.
+ * @param[out] data BMP390 FIFO data.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when an unknown frame is found and the FIFO is flushed.
+ */
+esp_err_t bmp390_read_fifo(bmp390_handle_t handle, bmp390_fifo_data_t *const data);
+
 /**
  * @brief Issues soft-reset sensor and initializes registers for BMP390.
  *
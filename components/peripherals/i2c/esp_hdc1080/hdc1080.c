@@ -167,7 +167,7 @@ static inline esp_err_t hdc1080_i2c_write_command(hdc1080_device_t *const device
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t hdc1080_i2c_write_word_to(hdc1080_device_t *const device, const uint8_t reg_addr, const uint16_t word) {
-    const bit24_uint8_buffer_t tx = { reg_addr, (uint8_t)(word & 0xff), (uint8_t)((word >> 8) & 0xff) };
+    const bit24_uint8_buffer_t tx = { reg_addr, (uint8_t)((word >> 8) & 0xff), (uint8_t)(word & 0xff) }; // register, msb, lsb
 
     /* validate arguments */
     ESP_ARG_CHECK( device );
@@ -205,8 +205,8 @@ static inline esp_err_t hdc1080_i2c_read_word_from(hdc1080_device_t *const devic
     ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "hdc1080_i2c_read_word_from failed" );
 
 
-    /* set output parameter */
-    *word = (uint16_t)rx[0] | ((uint16_t)rx[1] << 8);
+    /* set output parameter, registers are transferred msb first */
+    *word = ((uint16_t)rx[0] << 8) | (uint16_t)rx[1];
 
     return ESP_OK;
 }
@@ -639,6 +639,54 @@ esp_err_t hdc1080_get_measurements(hdc1080_handle_t handle, float *const tempera
     return ESP_OK;
 }
 
+esp_err_t hdc1080_start_measurement(hdc1080_handle_t handle) {
+    hdc1080_device_t* device = (hdc1080_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write transaction, sequenced acquisition mode converts temperature followed by humidity */
+    ESP_RETURN_ON_ERROR( hdc1080_i2c_write_command(device, HDC1080_REG_TEMPERATURE), TAG, "unable to write to i2c device handle, write to trigger measurement failed");
+
+    return ESP_OK;
+}
+
+esp_err_t hdc1080_get_measurement_ready_time(hdc1080_handle_t handle, uint32_t *const ready_time_us) {
+    hdc1080_device_t* device = (hdc1080_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && ready_time_us );
+
+    /* temperature and humidity conversions run back-to-back in sequenced acquisition mode */
+    *ready_time_us = (uint32_t)(hdc1080_get_temperature_duration(device->config.temperature_resolution) + 
+                                hdc1080_get_humidity_duration(device->config.humidity_resolution)) * 1000;
+
+    return ESP_OK;
+}
+
+esp_err_t hdc1080_collect_measurement(hdc1080_handle_t handle, float *const temperature, float *const humidity) {
+    bit32_uint8_buffer_t rx  = { 0 };
+    hdc1080_device_t* device = (hdc1080_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && temperature && humidity );
+
+    /* attempt i2c read transaction - a nack indicates that the sensor is still busy, bus errors are passed through */
+    const esp_err_t ret = i2c_master_receive(device->i2c_handle, rx, BIT32_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS);
+    if (ret == ESP_ERR_INVALID_STATE) return ESP_ERR_NOT_FINISHED;
+    ESP_RETURN_ON_ERROR( ret, TAG, "read measurement for collect measurement failed" );
+
+    /* concat temperature and humidity bytes */
+    const uint16_t t_raw = ((uint16_t)rx[0] << 8) | rx[1];
+    const uint16_t h_raw = ((uint16_t)rx[2] << 8) | rx[3];
+
+    /* convert temperature and humidity and set output parameters */
+    *temperature = hdc1080_convert_temperature_signal(t_raw);
+    *humidity    = hdc1080_convert_humidity_signal(h_raw);
+
+    return ESP_OK;
+}
+
 esp_err_t hdc1080_enable_heater(hdc1080_handle_t handle) {
     hdc1080_config_register_t config_reg = { 0 };
     hdc1080_device_t* device = (hdc1080_device_t*)handle;
@@ -709,6 +757,9 @@ esp_err_t hdc1080_set_temperature_resolution(hdc1080_handle_t handle, const hdc1
     /* attempt to write configuration register */
     ESP_RETURN_ON_ERROR( hdc1080_i2c_set_config_register(device, config_reg), TAG, "unable to write configuration register, set temperature resolution failed" );
 
+    /* set configuration */
+    device->config.temperature_resolution = resolution;
+
     return ESP_OK;
 }
 
@@ -744,6 +795,9 @@ esp_err_t hdc1080_set_humidity_resolution(hdc1080_handle_t handle, const hdc1080
     /* attempt to write configuration register */
     ESP_RETURN_ON_ERROR( hdc1080_i2c_set_config_register(device, config_reg), TAG, "unable to write configuration register, set humidity resolution failed" );
 
+    /* set configuration */
+    device->config.humidity_resolution = resolution;
+
     return ESP_OK;
 }
 
@@ -144,6 +144,35 @@ esp_err_t hdc1080_init(i2c_master_bus_handle_t master_handle, const hdc1080_conf
  */
 esp_err_t hdc1080_get_measurement(hdc1080_handle_t handle, float *const temperature, float *const humidity);
 
+/**
+ * @brief Triggers a sequenced temperature and humidity conversion on HDC1080 without waiting for it to complete.
+ *
+ * @note Use `hdc1080_get_measurement_ready_time` to schedule the `hdc1080_collect_measurement` call.
+ * 
+ * @param[in] handle HDC1080 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t hdc1080_start_measurement(hdc1080_handle_t handle);
+
+/**
+ * @brief Gets the HDC1080 conversion time, in microseconds, computed from the configured temperature and humidity resolutions.
+ * 
+ * @param[in] handle HDC1080 device handle.
+ * @param[out] ready_time_us Measurement conversion time in microseconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t hdc1080_get_measurement_ready_time(hdc1080_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads temperature and relative humidity from HDC1080 after `hdc1080_start_measurement`.  This is a non-blocking function.
+ * 
+ * @param[in] handle HDC1080 device handle.
+ * @param[out] temperature Temperature measurement in degrees Celsius.
+ * @param[out] humidity Relative humidity measurement in percentage.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FINISHED when the sensor is still converting (read is not acknowledged), other bus errors (i.e. ESP_ERR_TIMEOUT) are returned.
+ */
+esp_err_t hdc1080_collect_measurement(hdc1080_handle_t handle, float *const temperature, float *const humidity);
+
 /**
  * @brief Reads temperature, relative humidity, and dew-point from HDC1080.
  * 
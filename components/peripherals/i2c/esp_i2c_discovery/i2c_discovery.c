@@ -0,0 +1,403 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_discovery.c
+ *
+ * ESP-IDF I2C master bus discovery
+ * 
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_discovery.h"
+#include <stdio.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <esp_timer.h>
+
+/*
+ * I2C discovery definitions
+*/
+#define I2C_DISCOVERY_ADDRESS_COUNT     (128)   //!< i2c discovery, number of 7-bit addresses
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/**
+ * @brief I2C discovery fingerprint structure, the addresses and chip identifier register of a device type.
+ */
+typedef struct i2c_discovery_fingerprint_s {
+    i2c_discovery_device_types_t    type;           /*!< device type */
+    uint8_t                         address_first;  /*!< first 7-bit address of the device type */
+    uint8_t                         address_last;   /*!< last 7-bit address of the device type */
+    uint8_t                         id_register;    /*!< chip identifier register */
+    uint8_t                         id_size;        /*!< chip identifier size in bytes, 0 when the device is matched by address only */
+    bool                            id_lsb_first;   /*!< chip identifier byte order, true when the least significant byte is read first */
+    uint16_t                        id_mask;        /*!< chip identifier mask */
+    uint16_t                        id_value;       /*!< chip identifier value after the mask */
+} i2c_discovery_fingerprint_t;
+
+/**
+ * @brief I2C discovery probe state structure.
+ */
+typedef struct i2c_discovery_probe_state_s {
+    uint8_t                         probed[I2C_DISCOVERY_ADDRESS_BITMAP_SIZE]; /*!< bitmap of the probed addresses */
+    uint16_t                        timeout_ms;             /*!< adapted probe timeout in milliseconds */
+    uint32_t                        latency_max_us;         /*!< slowest completed probe in microseconds, 0 before the first completed probe */
+    uint8_t                         consecutive_timeouts;   /*!< probes timed out since the last completed probe */
+} i2c_discovery_probe_state_t;
+
+/*
+ * static constant declarations
+ */
+static const char *TAG = "i2c_discovery";
+
+/**
+ * @brief Fingerprints of the I2C drivers of this repository.  Devices with a chip identifier 
+ * register are listed first, a device type listed without an identifier is matched by address 
+ * when no identifier of the address matched.  Identifier reads are register reads, a device 
+ * that does not acknowledge the register is not matched by it.
+ */
+static const i2c_discovery_fingerprint_t i2c_discovery_fingerprints[] = {
+    { I2C_DISCOVERY_DEVICE_AK8975,   0x0c, 0x0f, 0x00, 1, false, 0x00ff, 0x0048 },  /* WIA */
+    { I2C_DISCOVERY_DEVICE_AS7341,   0x39, 0x39, 0x92, 1, false, 0x00fc, 0x0024 },  /* ID, part identifier 0x09 in bits 7:2 */
+    { I2C_DISCOVERY_DEVICE_BME680,   0x76, 0x77, 0xd0, 1, false, 0x00ff, 0x0061 },  /* chip_id */
+    { I2C_DISCOVERY_DEVICE_BMP280,   0x76, 0x77, 0xd0, 1, false, 0x00ff, 0x0058 },  /* id */
+    { I2C_DISCOVERY_DEVICE_BMP390,   0x76, 0x77, 0x00, 1, false, 0x00ff, 0x0060 },  /* CHIP_ID */
+    { I2C_DISCOVERY_DEVICE_CCS811,   0x5a, 0x5b, 0x20, 1, false, 0x00ff, 0x0081 },  /* HW_ID */
+    { I2C_DISCOVERY_DEVICE_ENS160,   0x52, 0x53, 0x00, 2, true,  0xffff, 0x0160 },  /* PART_ID */
+    { I2C_DISCOVERY_DEVICE_HDC1080,  0x40, 0x43, 0xff, 2, false, 0xffff, 0x1050 },  /* Device ID */
+    { I2C_DISCOVERY_DEVICE_HMC5883L, 0x1e, 0x1e, 0x0a, 1, false, 0x00ff, 0x0048 },  /* Identification A, 'H' */
+    { I2C_DISCOVERY_DEVICE_INA226,   0x40, 0x4f, 0xff, 2, false, 0xfff0, 0x2260 },  /* Die ID, device 0x226 */
+    { I2C_DISCOVERY_DEVICE_INA228,   0x40, 0x4f, 0x3f, 2, false, 0xfff0, 0x2280 },  /* DEVICE_ID, device 0x228 */
+    { I2C_DISCOVERY_DEVICE_LTR390UV, 0x53, 0x53, 0x06, 1, false, 0x00f0, 0x00b0 },  /* PART_ID, part number 0xb in bits 7:4 */
+    { I2C_DISCOVERY_DEVICE_MAX30105, 0x57, 0x57, 0xff, 1, false, 0x00ff, 0x0015 },  /* Part ID */
+    { I2C_DISCOVERY_DEVICE_MMC56X3,  0x30, 0x30, 0x39, 1, false, 0x00ff, 0x0010 },  /* Product ID */
+    { I2C_DISCOVERY_DEVICE_MPU6050,  0x68, 0x69, 0x75, 1, false, 0x007e, 0x0068 },  /* WHO_AM_I, bits 6:1 */
+    { I2C_DISCOVERY_DEVICE_TCS3472,  0x29, 0x29, 0x92, 1, false, 0x00ff, 0x0044 },  /* ID with command bit, tcs34721 and tcs34725 */
+    { I2C_DISCOVERY_DEVICE_TCS3472,  0x29, 0x29, 0x92, 1, false, 0x00ff, 0x004d },  /* ID with command bit, tcs34723 and tcs34727 */
+    { I2C_DISCOVERY_DEVICE_VEML7700, 0x10, 0x10, 0x07, 2, true,  0x00ff, 0x0081 },  /* ID, device identifier in the low byte */
+    { I2C_DISCOVERY_DEVICE_AHTXX,    0x38, 0x38, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_AS3935,   0x01, 0x03, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_AT24CXXX, 0x50, 0x57, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_BH1750,   0x23, 0x23, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_BH1750,   0x5c, 0x5c, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_MLX90614, 0x5a, 0x5a, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_PCT2075,  0x37, 0x37, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_SGP4X,    0x59, 0x59, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_SHT4X,    0x44, 0x45, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_SSD1306,  0x3c, 0x3d, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_TBI2CXXX, 0x3a, 0x3a, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_TLV493D,  0x1f, 0x1f, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_TLV493D,  0x5e, 0x5e, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_VEML6040, 0x10, 0x10, 0x00, 0, false, 0x0000, 0x0000 },
+    { I2C_DISCOVERY_DEVICE_VL53L4CX, 0x29, 0x29, 0x00, 0, false, 0x0000, 0x0000 },
+};
+
+/**
+ * @brief Device type names in device type order.
+ */
+static const char *const i2c_discovery_device_names[] = {
+    "unknown", "ahtxx", "ak8975", "as3935", "as7341", "at24cxxx", "bh1750", "bme680", "bmp280", "bmp390", 
+    "ccs811", "ens160", "hdc1080", "hmc5883l", "ina226", "ina228", "ltr390uv", "max30105", "mlx90614", 
+    "mmc56x3", "mpu6050", "pct2075", "sgp4x", "sht4x", "ssd1306", "tbi2cxxx", "tcs3472", "tlv493d", 
+    "veml6040", "veml7700", "vl53l4cx",
+};
+
+_Static_assert(sizeof(i2c_discovery_device_names) / sizeof(i2c_discovery_device_names[0]) == I2C_DISCOVERY_DEVICE_VL53L4CX + 1,
+               "i2c discovery device names do not match the device types");
+
+static inline void i2c_discovery_set_bit(uint8_t *const bitmap, const uint8_t address) {
+    bitmap[address >> 3] |= (uint8_t)(1U << (address & 7));
+}
+
+static inline bool i2c_discovery_get_bit(const uint8_t *const bitmap, const uint8_t address) {
+    return (bitmap[address >> 3] & (1U << (address & 7))) != 0;
+}
+
+/**
+ * @brief Probes an address and adapts the probe timeout to the slowest completed probe.
+ * 
+ * @param bus_handle I2C master bus handle.
+ * @param config I2C discovery configuration.
+ * @param state I2C discovery probe state.
+ * @param address 7-bit address.
+ * @param result I2C discovery result.
+ * @return esp_err_t ESP_OK when the probe completed, acknowledged or not, ESP_ERR_TIMEOUT on a bus fault.
+ */
+static inline esp_err_t i2c_discovery_probe(i2c_master_bus_handle_t bus_handle, const i2c_discovery_config_t *const config, i2c_discovery_probe_state_t *const state, 
+                                            const uint8_t address, i2c_discovery_result_t *const result) {
+    if (i2c_discovery_get_bit(state->probed, address)) return ESP_OK;
+    i2c_discovery_set_bit(state->probed, address);
+
+    const int64_t start_us = esp_timer_get_time();
+    const esp_err_t ret = i2c_master_probe(bus_handle, address, state->timeout_ms);
+    const uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    result->probes++;
+
+    if (ret == ESP_OK || ret == ESP_ERR_NOT_FOUND) {
+        if (ret == ESP_OK) i2c_discovery_set_bit(result->present, address);
+
+        /* a completed probe bounds the timeout of the next probes */
+        state->consecutive_timeouts = 0;
+        if (latency_us > state->latency_max_us) {
+            state->latency_max_us = latency_us;
+
+            const uint32_t timeout_ms = (latency_us * config->probe_timeout_margin + 999) / 1000;
+            state->timeout_ms = (timeout_ms < config->probe_timeout_min_ms) ? config->probe_timeout_min_ms : 
+                                (timeout_ms > config->probe_timeout_ms) ? config->probe_timeout_ms : (uint16_t)timeout_ms;
+        }
+        return ESP_OK;
+    }
+
+    if (ret != ESP_ERR_TIMEOUT) return ret;
+
+    i2c_discovery_set_bit(result->timed_out, address);
+    result->timeouts++;
+    state->consecutive_timeouts++;
+
+    /* no probe completed yet, do not wait the full timeout on every address */
+    if (state->latency_max_us == 0) state->timeout_ms = config->probe_timeout_min_ms;
+
+    if (config->bus_fault_timeouts > 0 && state->consecutive_timeouts >= config->bus_fault_timeouts) {
+        result->bus_fault = true;
+        ESP_LOGE(TAG, "%u consecutive probe timeouts at address 0x%02x, check the bus pull-ups", state->consecutive_timeouts, address);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Identifies the device type of an address that acknowledged.
+ * 
+ * @param bus_handle I2C master bus handle.
+ * @param config I2C discovery configuration.
+ * @param device Discovered device, the address is set and the type is set on return.
+ */
+static inline void i2c_discovery_fingerprint(i2c_master_bus_handle_t bus_handle, const i2c_discovery_config_t *const config, i2c_discovery_device_t *const device) {
+    const i2c_discovery_fingerprint_t *candidate = NULL;
+    i2c_master_dev_handle_t dev_handle = NULL;
+    uint16_t cached_key = 0;    /* register + 1 and size of the cached identifier read, 0 when empty */
+    esp_err_t cached_ret = ESP_FAIL;
+    uint8_t cached_id[2] = { 0 };
+
+    device->type = I2C_DISCOVERY_DEVICE_UNKNOWN;
+
+    if (config->fingerprint_enabled) {
+        const i2c_device_config_t dev_config = {
+            .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+            .device_address  = device->address,
+            .scl_speed_hz    = config->scl_speed_hz,
+        };
+        if (i2c_master_bus_add_device(bus_handle, &dev_config, &dev_handle) != ESP_OK) {
+            ESP_LOGW(TAG, "unable to add device 0x%02x to fingerprint it", device->address);
+            dev_handle = NULL;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(i2c_discovery_fingerprints) / sizeof(i2c_discovery_fingerprints[0]); i++) {
+        const i2c_discovery_fingerprint_t *fingerprint = &i2c_discovery_fingerprints[i];
+
+        if (device->address < fingerprint->address_first || device->address > fingerprint->address_last) continue;
+
+        /* without an identifier read the first device type of the address is the best guess */
+        if (fingerprint->id_size == 0 || dev_handle == NULL) {
+            if (candidate == NULL) candidate = fingerprint;
+            continue;
+        }
+
+        /* device types that share an identifier register are read once */
+        const uint16_t key = (uint16_t)(((fingerprint->id_register + 1) << 2) | fingerprint->id_size);
+        if (key != cached_key) {
+            cached_key = key;
+            cached_ret = i2c_master_transmit_receive(dev_handle, &fingerprint->id_register, 1, cached_id, fingerprint->id_size, config->probe_timeout_ms);
+        }
+        if (cached_ret != ESP_OK) continue;
+
+        const uint16_t id = (fingerprint->id_size == 1) ? cached_id[0] : 
+                            fingerprint->id_lsb_first ? (uint16_t)(cached_id[0] | (cached_id[1] << 8)) : (uint16_t)((cached_id[0] << 8) | cached_id[1]);
+        if ((id & fingerprint->id_mask) == fingerprint->id_value) {
+            device->type          = fingerprint->type;
+            device->fingerprinted = true;
+            device->chip_id       = id;
+            break;
+        }
+    }
+
+    if (device->fingerprinted == false && candidate != NULL) device->type = candidate->type;
+
+    if (dev_handle != NULL) i2c_master_bus_rm_device(dev_handle);
+}
+
+esp_err_t i2c_discovery_scan(i2c_master_bus_handle_t bus_handle, const i2c_discovery_config_t *const config, i2c_discovery_result_t *const result) {
+    uint8_t known[I2C_DISCOVERY_ADDRESS_BITMAP_SIZE] = { 0 };
+    i2c_discovery_probe_state_t state = { 0 };
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle && config && result );
+    ESP_ARG_CHECK( config->probe_timeout_ms > 0 && config->probe_timeout_min_ms > 0 && config->probe_timeout_min_ms <= config->probe_timeout_ms );
+    ESP_ARG_CHECK( config->probe_timeout_margin > 0 );
+
+    memset(result, 0, sizeof(i2c_discovery_result_t));
+    state.timeout_ms = config->probe_timeout_ms;
+
+    const int64_t start_us = esp_timer_get_time();
+
+    /* addresses of the drivers of this repository first */
+    for (size_t i = 0; i < sizeof(i2c_discovery_fingerprints) / sizeof(i2c_discovery_fingerprints[0]); i++) {
+        for (uint8_t address = i2c_discovery_fingerprints[i].address_first; address <= i2c_discovery_fingerprints[i].address_last; address++) {
+            i2c_discovery_set_bit(known, address);
+        }
+    }
+    for (uint8_t address = 0; address < I2C_DISCOVERY_ADDRESS_COUNT && ret == ESP_OK; address++) {
+        if (i2c_discovery_get_bit(known, address)) ret = i2c_discovery_probe(bus_handle, config, &state, address, result);
+    }
+
+    /* rest of the valid 7-bit address range */
+    for (uint8_t address = I2C_DISCOVERY_ADDRESS_MIN; address <= I2C_DISCOVERY_ADDRESS_MAX && ret == ESP_OK && !config->known_addresses_only; address++) {
+        ret = i2c_discovery_probe(bus_handle, config, &state, address, result);
+    }
+
+    result->probe_timeout_ms = state.timeout_ms;
+
+    /* fingerprint the devices found in address order */
+    for (uint8_t address = 0; address < I2C_DISCOVERY_ADDRESS_COUNT; address++) {
+        if (!i2c_discovery_get_bit(result->present, address)) continue;
+        if (result->device_count == I2C_DISCOVERY_DEVICES_MAX) {
+            ESP_LOGW(TAG, "more than %d devices found, devices from address 0x%02x are not listed", I2C_DISCOVERY_DEVICES_MAX, address);
+            break;
+        }
+
+        i2c_discovery_device_t *device = &result->devices[result->device_count++];
+        device->address = address;
+        i2c_discovery_fingerprint(bus_handle, config, device);
+    }
+
+    result->elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    return ret;
+}
+
+esp_err_t i2c_discovery_instantiate(i2c_master_bus_handle_t bus_handle, i2c_discovery_result_t *const result, const i2c_discovery_driver_t *const drivers, const size_t driver_count) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle && result && (drivers || driver_count == 0) );
+
+    for (uint8_t i = 0; i < result->device_count; i++) {
+        i2c_discovery_device_t *device = &result->devices[i];
+
+        if (device->handle != NULL || device->type == I2C_DISCOVERY_DEVICE_UNKNOWN) continue;
+
+        for (size_t j = 0; j < driver_count; j++) {
+            if (drivers[j].type != device->type || drivers[j].init_handler == NULL) continue;
+
+            const esp_err_t init_ret = drivers[j].init_handler(bus_handle, device, &device->handle);
+            if (init_ret != ESP_OK) {
+                ESP_LOGE(TAG, "%s (0x%02x) init handler failed (%s)", i2c_discovery_get_device_name(device->type), device->address, esp_err_to_name(init_ret));
+                device->handle = NULL;
+                if (ret == ESP_OK) ret = init_ret;
+            }
+            break;
+        }
+    }
+
+    return ret;
+}
+
+esp_err_t i2c_discovery_find_device(const i2c_discovery_result_t *const result, const i2c_discovery_device_types_t type, const i2c_discovery_device_t **const device) {
+    /* validate arguments */
+    ESP_ARG_CHECK( result && device );
+
+    for (uint8_t i = 0; i < result->device_count; i++) {
+        if (result->devices[i].type == type) {
+            *device = &result->devices[i];
+            return ESP_OK;
+        }
+    }
+
+    *device = NULL;
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool i2c_discovery_is_present(const i2c_discovery_result_t *const result, const uint8_t address) {
+    if (!result || address >= I2C_DISCOVERY_ADDRESS_COUNT) return false;
+
+    return i2c_discovery_get_bit(result->present, address);
+}
+
+const char *i2c_discovery_get_device_name(const i2c_discovery_device_types_t type) {
+    if ((unsigned)type > I2C_DISCOVERY_DEVICE_VL53L4CX) return i2c_discovery_device_names[I2C_DISCOVERY_DEVICE_UNKNOWN];
+
+    return i2c_discovery_device_names[type];
+}
+
+esp_err_t i2c_discovery_print(const i2c_discovery_result_t *const result) {
+    /* validate arguments */
+    ESP_ARG_CHECK( result );
+
+    printf("     0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f\r\n");
+
+    for (uint8_t i = 0; i < I2C_DISCOVERY_ADDRESS_COUNT; i += 16) {
+        printf("%02x: ", i);
+
+        for (uint8_t j = 0; j < 16; j++) {
+            const uint8_t address = i + j;
+
+            if (i2c_discovery_get_bit(result->present, address)) {
+                printf("%02x ", address);
+            } else if (i2c_discovery_get_bit(result->timed_out, address)) {
+                printf("UU ");
+            } else {
+                printf("-- ");
+            }
+        }
+        printf("\r\n");
+    }
+    fflush(stdout);
+
+    ESP_LOGI(TAG, "%u probes, %u timeouts%s, probe timeout %u ms, %lu us", 
+             result->probes, result->timeouts, result->bus_fault ? " (bus fault)" : "", result->probe_timeout_ms, result->elapsed_us);
+
+    for (uint8_t i = 0; i < result->device_count; i++) {
+        const i2c_discovery_device_t *device = &result->devices[i];
+
+        if (device->fingerprinted) {
+            ESP_LOGI(TAG, "0x%02x: %s, chip id 0x%02x", device->address, i2c_discovery_get_device_name(device->type), device->chip_id);
+        } else if (device->type != I2C_DISCOVERY_DEVICE_UNKNOWN) {
+            ESP_LOGI(TAG, "0x%02x: %s (by address)", device->address, i2c_discovery_get_device_name(device->type));
+        } else {
+            ESP_LOGI(TAG, "0x%02x: unknown", device->address);
+        }
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,240 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_discovery.h
+ * @defgroup drivers i2c_discovery
+ * @{
+ *
+ * ESP-IDF I2C master bus discovery
+ *
+ * Probes the addresses used by the I2C drivers of this repository first and 
+ * then the rest of the valid 7-bit address range (0x08 to 0x77).  The probe 
+ * timeout adapts to the observed probe time and the scan stops when several 
+ * consecutive probes time out, i.e. missing pull-ups or a held bus, instead 
+ * of waiting for a timeout on every address.  Devices found are fingerprinted 
+ * by reading their chip identifier registers, devices without an identifier 
+ * register are matched by address, and the resulting device table can 
+ * instantiate driver handles through application init handlers.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_DISCOVERY_H__
+#define __I2C_DISCOVERY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include <driver/i2c_master.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C discovery definitions
+*/
+#define I2C_DISCOVERY_ADDRESS_MIN           UINT8_C(0x08)   //!< i2c discovery, first address of the valid 7-bit address range
+#define I2C_DISCOVERY_ADDRESS_MAX           UINT8_C(0x77)   //!< i2c discovery, last address of the valid 7-bit address range
+#define I2C_DISCOVERY_ADDRESS_BITMAP_SIZE   (16)            //!< i2c discovery, size of an address bitmap in bytes, one bit per 7-bit address
+#define I2C_DISCOVERY_DEVICES_MAX           (32)            //!< i2c discovery, maximum number of devices in a result
+
+/*
+ * I2C discovery configuration declarations
+*/
+#define I2C_DISCOVERY_CONFIG_DEFAULT {                  \
+    .probe_timeout_ms           = 10,                   \
+    .probe_timeout_min_ms       = 1,                    \
+    .probe_timeout_margin       = 4,                    \
+    .bus_fault_timeouts         = 3,                    \
+    .scl_speed_hz               = 100000,               \
+    .known_addresses_only       = false,                \
+    .fingerprint_enabled        = true, }
+
+/*
+ * I2C discovery enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C discovery device types enumerator, a device type per I2C driver of this repository.
+ */
+typedef enum i2c_discovery_device_types_e {
+    I2C_DISCOVERY_DEVICE_UNKNOWN = 0,   /*!< i2c discovery, device acknowledged but not identified */
+    I2C_DISCOVERY_DEVICE_AHTXX,
+    I2C_DISCOVERY_DEVICE_AK8975,
+    I2C_DISCOVERY_DEVICE_AS3935,
+    I2C_DISCOVERY_DEVICE_AS7341,
+    I2C_DISCOVERY_DEVICE_AT24CXXX,
+    I2C_DISCOVERY_DEVICE_BH1750,
+    I2C_DISCOVERY_DEVICE_BME680,
+    I2C_DISCOVERY_DEVICE_BMP280,
+    I2C_DISCOVERY_DEVICE_BMP390,
+    I2C_DISCOVERY_DEVICE_CCS811,
+    I2C_DISCOVERY_DEVICE_ENS160,
+    I2C_DISCOVERY_DEVICE_HDC1080,
+    I2C_DISCOVERY_DEVICE_HMC5883L,
+    I2C_DISCOVERY_DEVICE_INA226,
+    I2C_DISCOVERY_DEVICE_INA228,
+    I2C_DISCOVERY_DEVICE_LTR390UV,
+    I2C_DISCOVERY_DEVICE_MAX30105,
+    I2C_DISCOVERY_DEVICE_MLX90614,
+    I2C_DISCOVERY_DEVICE_MMC56X3,
+    I2C_DISCOVERY_DEVICE_MPU6050,
+    I2C_DISCOVERY_DEVICE_PCT2075,
+    I2C_DISCOVERY_DEVICE_SGP4X,
+    I2C_DISCOVERY_DEVICE_SHT4X,
+    I2C_DISCOVERY_DEVICE_SSD1306,
+    I2C_DISCOVERY_DEVICE_TBI2CXXX,
+    I2C_DISCOVERY_DEVICE_TCS3472,
+    I2C_DISCOVERY_DEVICE_TLV493D,
+    I2C_DISCOVERY_DEVICE_VEML6040,
+    I2C_DISCOVERY_DEVICE_VEML7700,
+    I2C_DISCOVERY_DEVICE_VL53L4CX,
+} i2c_discovery_device_types_t;
+
+/**
+ * @brief I2C discovery configuration structure.
+ */
+typedef struct i2c_discovery_config_s {
+    uint16_t                        probe_timeout_ms;       /*!< i2c discovery, initial and maximum probe timeout in milliseconds */
+    uint16_t                        probe_timeout_min_ms;   /*!< i2c discovery, minimum probe timeout in milliseconds */
+    uint8_t                         probe_timeout_margin;   /*!< i2c discovery, probe timeout as a multiple of the slowest completed probe */
+    uint8_t                         bus_fault_timeouts;     /*!< i2c discovery, consecutive probe timeouts that stop the scan as a bus fault, 0 never stops */
+    uint32_t                        scl_speed_hz;           /*!< i2c discovery, clock speed of the fingerprint register reads */
+    bool                            known_addresses_only;   /*!< i2c discovery, probe only the addresses used by the drivers of this repository */
+    bool                            fingerprint_enabled;    /*!< i2c discovery, read chip identifier registers of the devices found */
+} i2c_discovery_config_t;
+
+/**
+ * @brief I2C discovery device structure.
+ */
+typedef struct i2c_discovery_device_s {
+    uint8_t                         address;                /*!< i2c discovery device, 7-bit address */
+    i2c_discovery_device_types_t    type;                   /*!< i2c discovery device, device type */
+    bool                            fingerprinted;          /*!< i2c discovery device, type identified by a chip identifier register, false when matched by address only */
+    uint16_t                        chip_id;                /*!< i2c discovery device, chip identifier register value when fingerprinted */
+    void                           *handle;                 /*!< i2c discovery device, driver handle set by `i2c_discovery_instantiate` */
+} i2c_discovery_device_t;
+
+/**
+ * @brief I2C discovery result structure.
+ */
+typedef struct i2c_discovery_result_s {
+    uint8_t                         present[I2C_DISCOVERY_ADDRESS_BITMAP_SIZE];   /*!< i2c discovery result, bitmap of the addresses that acknowledged */
+    uint8_t                         timed_out[I2C_DISCOVERY_ADDRESS_BITMAP_SIZE]; /*!< i2c discovery result, bitmap of the addresses whose probe timed out */
+    uint8_t                         device_count;           /*!< i2c discovery result, number of valid devices */
+    i2c_discovery_device_t          devices[I2C_DISCOVERY_DEVICES_MAX]; /*!< i2c discovery result, devices found in address order */
+    uint8_t                         probes;                 /*!< i2c discovery result, number of probes */
+    uint8_t                         timeouts;               /*!< i2c discovery result, number of probes that timed out */
+    bool                            bus_fault;              /*!< i2c discovery result, scan stopped by consecutive probe timeouts */
+    uint16_t                        probe_timeout_ms;       /*!< i2c discovery result, adapted probe timeout at the end of the scan in milliseconds */
+    uint32_t                        elapsed_us;             /*!< i2c discovery result, scan and fingerprint time in microseconds */
+} i2c_discovery_result_t;
+
+/**
+ * @brief I2C discovery driver init handler, creates the driver handle of a discovered device.
+ * 
+ * @param bus_handle I2C master bus handle.
+ * @param device Discovered device, the handler configures the driver with the device address.
+ * @param handle Driver handle created by the handler.
+ * @return esp_err_t ESP_OK on success.
+ */
+typedef esp_err_t (*i2c_discovery_init_handler_t)(i2c_master_bus_handle_t bus_handle, const i2c_discovery_device_t *const device, void **const handle);
+
+/**
+ * @brief I2C discovery driver structure, maps a device type to a driver init handler.
+ */
+typedef struct i2c_discovery_driver_s {
+    i2c_discovery_device_types_t    type;                   /*!< i2c discovery driver, device type */
+    i2c_discovery_init_handler_t    init_handler;           /*!< i2c discovery driver, init handler */
+} i2c_discovery_driver_t;
+
+/**
+ * @brief Scans an I2C master bus for devices and fingerprints the devices found.
+ * 
+ * @param bus_handle I2C master bus handle.
+ * @param config I2C discovery configuration.
+ * @param result I2C discovery result.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when the scan was stopped as a bus fault, the 
+ * result holds the addresses probed before the fault.
+ */
+esp_err_t i2c_discovery_scan(i2c_master_bus_handle_t bus_handle, const i2c_discovery_config_t *const config, i2c_discovery_result_t *const result);
+
+/**
+ * @brief Creates the driver handles of the discovered devices by device type.  Devices without a 
+ * driver, or whose handle was already created, are skipped.
+ * 
+ * @param bus_handle I2C master bus handle.
+ * @param result I2C discovery result, the device handles are set.
+ * @param drivers Driver init handlers by device type.
+ * @param driver_count Number of driver init handlers.
+ * @return esp_err_t ESP_OK on success, the first init handler error otherwise, the remaining devices 
+ * are still instantiated.
+ */
+esp_err_t i2c_discovery_instantiate(i2c_master_bus_handle_t bus_handle, i2c_discovery_result_t *const result, const i2c_discovery_driver_t *const drivers, const size_t driver_count);
+
+/**
+ * @brief Finds the first discovered device of a device type.
+ * 
+ * @param result I2C discovery result.
+ * @param type Device type.
+ * @param device Discovered device.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no device of the type was discovered.
+ */
+esp_err_t i2c_discovery_find_device(const i2c_discovery_result_t *const result, const i2c_discovery_device_types_t type, const i2c_discovery_device_t **const device);
+
+/**
+ * @brief Checks whether an address acknowledged.
+ * 
+ * @param result I2C discovery result.
+ * @param address 7-bit address.
+ * @return true when the address acknowledged.
+ */
+bool i2c_discovery_is_present(const i2c_discovery_result_t *const result, const uint8_t address);
+
+/**
+ * @brief Gets the name of a device type.
+ * 
+ * @param type Device type.
+ * @return const char* Device type name, "unknown" when not identified.
+ */
+const char *i2c_discovery_get_device_name(const i2c_discovery_device_types_t type);
+
+/**
+ * @brief Prints the address map and logs the device table of a discovery result.
+ * 
+ * @param result I2C discovery result.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_discovery_print(const i2c_discovery_result_t *const result);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_DISCOVERY_H__
@@ -0,0 +1,256 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_regcache.c
+ *
+ * ESP-IDF I2C device shadow register cache
+ * 
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_regcache.h"
+#include <string.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <i2c_trace.h>
+
+/*
+ * I2C register cache definitions
+*/
+#define I2C_REGCACHE_ADDRESS_COUNT  (256)   //!< i2c register cache, number of 8-bit register addresses
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+* static constant declarations
+*/
+static const char *TAG = "i2c_regcache";
+
+
+/**
+ * @brief Gets the index of a register in the cache window when the register can be cached.
+ * 
+ * @param cache Register cache.
+ * @param reg_addr Register address.
+ * @param index Index of the register in the cache window.
+ * @return bool True when the register is in the cache window and is not volatile.
+ */
+static inline bool i2c_regcache_get_index(const i2c_regcache_t *const cache, const uint16_t reg_addr, uint8_t *const index) {
+    if (reg_addr < cache->config.first_register || reg_addr >= cache->config.first_register + cache->config.size) return false;
+
+    *index = (uint8_t)(reg_addr - cache->config.first_register);
+
+    return (cache->config.volatile_mask & (UINT32_C(1) << *index)) == 0;
+}
+
+/**
+ * @brief Gets a cached register value.
+ * 
+ * @param cache Register cache.
+ * @param reg_addr Register address.
+ * @param value Cached register value.
+ * @return bool True when the register is cached.
+ */
+static inline bool i2c_regcache_get_cached(const i2c_regcache_t *const cache, const uint16_t reg_addr, uint8_t *const value) {
+    uint8_t index;
+
+    if (!i2c_regcache_get_index(cache, reg_addr, &index) || (cache->valid & (UINT32_C(1) << index)) == 0) return false;
+
+    *value = cache->values[index];
+
+    return true;
+}
+
+/**
+ * @brief Sets a cached register value, registers that cannot be cached are ignored.
+ * 
+ * @param cache Register cache.
+ * @param reg_addr Register address.
+ * @param value Register value.
+ */
+static inline void i2c_regcache_set_cached(i2c_regcache_t *const cache, const uint16_t reg_addr, const uint8_t value) {
+    uint8_t index;
+
+    if (!i2c_regcache_get_index(cache, reg_addr, &index)) return;
+
+    cache->values[index] = value;
+    cache->valid        |= UINT32_C(1) << index;
+}
+
+esp_err_t i2c_regcache_init(i2c_regcache_t *const cache, i2c_master_dev_handle_t i2c_handle, const i2c_regcache_config_t *config) {
+    /* validate arguments */
+    ESP_ARG_CHECK( cache && i2c_handle && config );
+    ESP_RETURN_ON_FALSE( config->size > 0 && config->size <= I2C_REGCACHE_SIZE_MAX, ESP_ERR_INVALID_ARG, TAG, "cache window size must be between 1 and %d registers", I2C_REGCACHE_SIZE_MAX );
+    ESP_RETURN_ON_FALSE( config->first_register + config->size <= I2C_REGCACHE_ADDRESS_COUNT, ESP_ERR_INVALID_ARG, TAG, "cache window exceeds the register address range" );
+
+    /* initialize cache, nothing is cached */
+    memset(cache, 0, sizeof(i2c_regcache_t));
+    cache->config     = *config;
+    cache->i2c_handle = i2c_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_read(i2c_regcache_t *const cache, const uint8_t reg_addr, uint8_t *const buffer, const uint8_t size) {
+    int16_t first = -1;
+    int16_t last  = -1;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( cache && buffer && size > 0 && size <= I2C_REGCACHE_XFR_SIZE_MAX );
+    ESP_ARG_CHECK( reg_addr + size <= I2C_REGCACHE_ADDRESS_COUNT );
+
+    /* serve cached registers and find the span of registers to read from the device */
+    for (uint8_t i = 0; i < size; i++) {
+        if (i2c_regcache_get_cached(cache, reg_addr + i, &buffer[i])) continue;
+        if (first < 0) first = i;
+        last = i;
+    }
+
+    /* validate all registers were cached */
+    if (first < 0) return ESP_OK;
+
+    /* attempt to read the span in a single transaction, cached registers inside the span are read again */
+    const uint8_t tx[1] = { (uint8_t)(reg_addr + first) };
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(cache->i2c_handle, tx, sizeof(tx), &buffer[first], (size_t)(last - first + 1), cache->config.timeout_ms), TAG, "read registers 0x%02x to 0x%02x failed", reg_addr + first, reg_addr + last );
+
+    /* update cache */
+    for (int16_t i = first; i <= last; i++) {
+        i2c_regcache_set_cached(cache, reg_addr + i, buffer[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_read_byte(i2c_regcache_t *const cache, const uint8_t reg_addr, uint8_t *const value) {
+    return i2c_regcache_read(cache, reg_addr, value, 1);
+}
+
+esp_err_t i2c_regcache_write(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t *const buffer, const uint8_t size) {
+    uint8_t tx[I2C_REGCACHE_XFR_SIZE_MAX * 2];
+    size_t  tx_size;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( cache && buffer && size > 0 && size <= I2C_REGCACHE_XFR_SIZE_MAX );
+    ESP_ARG_CHECK( reg_addr + size <= I2C_REGCACHE_ADDRESS_COUNT );
+
+    /* build register and value pairs or an auto-increment burst */
+    if (cache->config.pair_writes == true) {
+        for (uint8_t i = 0; i < size; i++) {
+            tx[i * 2]     = (uint8_t)(reg_addr + i);
+            tx[i * 2 + 1] = buffer[i];
+        }
+        tx_size = (size_t)size * 2;
+    } else {
+        tx[0] = reg_addr;
+        memcpy(&tx[1], buffer, size);
+        tx_size = (size_t)size + 1;
+    }
+
+    /* attempt i2c write transaction */
+    const esp_err_t ret = I2C_TRACE_TRANSMIT(cache->i2c_handle, tx, tx_size, cache->config.timeout_ms);
+    if (ret != ESP_OK) {
+        /* registers are in an unknown state after a failed write */
+        i2c_regcache_invalidate_range(cache, reg_addr, size);
+        ESP_RETURN_ON_ERROR( ret, TAG, "write registers 0x%02x to 0x%02x failed", reg_addr, reg_addr + size - 1 );
+    }
+
+    /* update cache */
+    for (uint8_t i = 0; i < size; i++) {
+        i2c_regcache_set_cached(cache, reg_addr + i, buffer[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_write_byte(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t value) {
+    return i2c_regcache_write(cache, reg_addr, &value, 1);
+}
+
+esp_err_t i2c_regcache_update_bits(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t mask, const uint8_t value) {
+    uint8_t reg = 0;
+
+    /* attempt to read register */
+    ESP_RETURN_ON_ERROR( i2c_regcache_read_byte(cache, reg_addr, &reg), TAG, "read register for update bits failed" );
+
+    /* attempt to write register */
+    ESP_RETURN_ON_ERROR( i2c_regcache_write_byte(cache, reg_addr, (uint8_t)((reg & ~mask) | (value & mask))), TAG, "write register for update bits failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_store(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t value) {
+    /* validate arguments */
+    ESP_ARG_CHECK( cache );
+
+    i2c_regcache_set_cached(cache, reg_addr, value);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_invalidate(i2c_regcache_t *const cache) {
+    /* validate arguments */
+    ESP_ARG_CHECK( cache );
+
+    cache->valid = 0;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_invalidate_range(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t size) {
+    uint8_t index;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( cache );
+
+    for (uint16_t reg = reg_addr; reg < (uint16_t)reg_addr + size; reg++) {
+        if (i2c_regcache_get_index(cache, reg, &index)) {
+            cache->valid &= ~(UINT32_C(1) << index);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_regcache_refresh(i2c_regcache_t *const cache) {
+    uint8_t rx[I2C_REGCACHE_SIZE_MAX];
+
+    /* validate arguments */
+    ESP_ARG_CHECK( cache );
+
+    /* attempt to read the window in a single transaction */
+    const uint8_t tx[1] = { cache->config.first_register };
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(cache->i2c_handle, tx, sizeof(tx), rx, cache->config.size, cache->config.timeout_ms), TAG, "read registers for refresh failed" );
+
+    /* replace cache */
+    cache->valid = 0;
+    for (uint8_t i = 0; i < cache->config.size; i++) {
+        i2c_regcache_set_cached(cache, cache->config.first_register + i, rx[i]);
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,212 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_regcache.h
+ * @defgroup drivers i2c_regcache
+ * @{
+ *
+ * ESP-IDF I2C device shadow register cache
+ *
+ * Keeps a copy of a window of up to 32 consecutive configuration registers 
+ * of an I2C device.  Writes go through to the device and update the copy, 
+ * reads of cached registers are served without a bus transaction, and the 
+ * registers that must come from the device (not yet cached or volatile) are 
+ * coalesced into a single burst read.  Multi-register writes are a single 
+ * transaction, either an auto-increment burst or register and value pairs 
+ * (Bosch sensors).  Accesses outside of the window pass through to the device.
+ * 
+ * The cache is not locked, accesses to a device are serialized by its driver.
+ * Drivers must invalidate or refresh the cache after a device reset and must 
+ * store the value a register changes to on its own, i.e. the power mode 
+ * returning to sleep after a forced measurement.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_REGCACHE_H__
+#define __I2C_REGCACHE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <driver/i2c_master.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C register cache definitions
+*/
+#define I2C_REGCACHE_SIZE_MAX       (32)    //!< i2c register cache, maximum number of registers in a cache window
+#define I2C_REGCACHE_XFR_SIZE_MAX   (32)    //!< i2c register cache, maximum number of registers in a single read or write
+
+/*
+ * I2C register cache configuration declarations
+*/
+#define I2C_REGCACHE_CONFIG_DEFAULT {                   \
+    .first_register             = 0x00,                 \
+    .size                       = 0,                    \
+    .volatile_mask              = 0,                    \
+    .pair_writes                = false,                \
+    .timeout_ms                 = 500, }
+
+/*
+ * I2C register cache enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C register cache configuration structure definition.
+ */
+typedef struct i2c_regcache_config_s {
+    uint8_t     first_register; /*!< first register of the cache window */
+    uint8_t     size;           /*!< number of registers in the cache window, 1 to I2C_REGCACHE_SIZE_MAX */
+    uint32_t    volatile_mask;  /*!< registers that are always read from the device, bit n is register first_register + n */
+    bool        pair_writes;    /*!< multi-register writes are sent as register and value pairs when true, otherwise as an auto-increment burst */
+    int         timeout_ms;     /*!< i2c transaction timeout in milliseconds */
+} i2c_regcache_config_t;
+
+/**
+ * @brief I2C register cache structure definition.  The structure is embedded in a driver's device descriptor.
+ */
+typedef struct i2c_regcache_s {
+    i2c_regcache_config_t   config;                         /*!< register cache configuration */
+    i2c_master_dev_handle_t i2c_handle;                     /*!< i2c device handle */
+    uint32_t                valid;                          /*!< registers holding a cached value, bit n is register first_register + n */
+    uint8_t                 values[I2C_REGCACHE_SIZE_MAX];  /*!< cached register values */
+} i2c_regcache_t;
+
+/**
+ * @brief Initializes a register cache for an i2c device, the cache is empty.
+ * 
+ * @param[out] cache Register cache to initialize.
+ * @param[in] i2c_handle I2C device handle of the device.
+ * @param[in] config Register cache configuration.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_init(i2c_regcache_t *const cache, i2c_master_dev_handle_t i2c_handle, const i2c_regcache_config_t *config);
+
+/**
+ * @brief Reads consecutive registers.  Cached registers are served from the cache and the 
+ * span of registers that are not cached or volatile is read from the device in a single transaction.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr First register to read.
+ * @param[out] buffer Register values.
+ * @param[in] size Number of registers to read, 1 to I2C_REGCACHE_XFR_SIZE_MAX.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_read(i2c_regcache_t *const cache, const uint8_t reg_addr, uint8_t *const buffer, const uint8_t size);
+
+/**
+ * @brief Reads a register, served from the cache when the register is cached.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr Register to read.
+ * @param[out] value Register value.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_read_byte(i2c_regcache_t *const cache, const uint8_t reg_addr, uint8_t *const value);
+
+/**
+ * @brief Writes consecutive registers in a single transaction and updates the cache.  The write 
+ * is always sent, an unchanged value can still trigger an action on the device.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr First register to write.
+ * @param[in] buffer Register values.
+ * @param[in] size Number of registers to write, 1 to I2C_REGCACHE_XFR_SIZE_MAX.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_write(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t *const buffer, const uint8_t size);
+
+/**
+ * @brief Writes a register and updates the cache.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr Register to write.
+ * @param[in] value Register value.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_write_byte(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t value);
+
+/**
+ * @brief Read-modify-write of the bits of a register selected by the mask, the read is 
+ * served from the cache when the register is cached.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr Register to update.
+ * @param[in] mask Bits to update.
+ * @param[in] value New value of the bits selected by the mask.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_update_bits(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t mask, const uint8_t value);
+
+/**
+ * @brief Stores a register value in the cache without a bus transaction, i.e. the value a 
+ * register changes to on its own.  Registers outside of the window or volatile are ignored.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr Register to store.
+ * @param[in] value Register value.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_store(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t value);
+
+/**
+ * @brief Invalidates all cached registers, i.e. after a device reset.  The next read of a 
+ * register is from the device.
+ * 
+ * @param[in] cache Register cache.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_invalidate(i2c_regcache_t *const cache);
+
+/**
+ * @brief Invalidates consecutive cached registers.
+ * 
+ * @param[in] cache Register cache.
+ * @param[in] reg_addr First register to invalidate.
+ * @param[in] size Number of registers to invalidate.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_invalidate_range(i2c_regcache_t *const cache, const uint8_t reg_addr, const uint8_t size);
+
+/**
+ * @brief Reads the cache window from the device in a single transaction.
+ * 
+ * @param[in] cache Register cache.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_regcache_refresh(i2c_regcache_t *const cache);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_REGCACHE_H__
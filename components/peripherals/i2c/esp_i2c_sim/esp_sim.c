@@ -0,0 +1,142 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file esp_sim.c
+ *
+ * Host esp_log, esp_err, esp_mac, esp_random and esp_rom_crc shim for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_sim.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_mac.h>
+#include <esp_random.h>
+#include <esp_rom_crc.h>
+
+/*
+ * static constant declarations
+*/
+static const char esp_sim_level_letters[] = { 'N', 'E', 'W', 'I', 'D', 'V' };
+static const uint8_t esp_sim_mac[6] = { 0x02, 0x00, 0x00, 0x12, 0x34, 0x56 };
+
+/*
+ * static variable declarations
+*/
+static esp_log_level_t esp_sim_log_level = ESP_LOG_INFO;
+static uint64_t esp_sim_random_state = 0x853c49e6748fea9bULL;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    __atomic_store_n(&esp_sim_log_level, level, __ATOMIC_SEQ_CST);
+}
+
+esp_log_level_t esp_log_get_level(void) {
+    return __atomic_load_n(&esp_sim_log_level, __ATOMIC_SEQ_CST);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    if (level == ESP_LOG_NONE || level > esp_log_get_level()) return;
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c (%lld) %s: ", esp_sim_level_letters[level], (long long)(i2c_sim_get_time_us() / 1000), tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+void esp_log_buffer_hexdump_internal(const char *tag, const void *buffer, uint16_t buff_len, esp_log_level_t level) {
+    if (buffer == NULL || level == ESP_LOG_NONE || level > esp_log_get_level()) return;
+
+    const uint8_t *bytes = (const uint8_t*)buffer;
+
+    for (uint16_t offset = 0; offset < buff_len; offset += 16) {
+        char line[16 * 3 + 1] = { 0 };
+        for (uint16_t i = offset; i < buff_len && i < offset + 16; i++) {
+            snprintf(line + (i - offset) * 3, 4, "%02x ", bytes[i]);
+        }
+        esp_log_write(level, tag, "%p: %s", (const void*)(bytes + offset), line);
+    }
+}
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:                    return "ESP_OK";
+        case ESP_FAIL:                  return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:       return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:     return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:      return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:         return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:     return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:           return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:  return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC:       return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_INVALID_VERSION:   return "ESP_ERR_INVALID_VERSION";
+        case ESP_ERR_INVALID_MAC:       return "ESP_ERR_INVALID_MAC";
+        case ESP_ERR_NOT_FINISHED:      return "ESP_ERR_NOT_FINISHED";
+        case ESP_ERR_NOT_ALLOWED:       return "ESP_ERR_NOT_ALLOWED";
+        default:                        return "UNKNOWN ERROR";
+    }
+}
+
+esp_err_t esp_efuse_mac_get_default(uint8_t *mac) {
+    if (mac == NULL) return ESP_ERR_INVALID_ARG;
+
+    memcpy(mac, esp_sim_mac, sizeof(esp_sim_mac));
+
+    return ESP_OK;
+}
+
+uint32_t esp_random(void) {
+    /* splitmix64, fixed seed */
+    uint64_t z = __atomic_add_fetch(&esp_sim_random_state, 0x9e3779b97f4a7c15ULL, __ATOMIC_SEQ_CST);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+void esp_fill_random(void *buf, size_t len) {
+    uint8_t *bytes = (uint8_t*)buf;
+
+    for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+        const uint32_t value = esp_random();
+        memcpy(bytes + i, &value, (len - i) < sizeof(uint32_t) ? (len - i) : sizeof(uint32_t));
+    }
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,505 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file freertos_sim.c
+ *
+ * Host FreeRTOS task, queue, semaphore and critical section shim for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_sim.h"
+#include <string.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+/*
+ * macro definitions
+*/
+#define FREERTOS_SIM_WAIT_SLICE_MS      (20)    //!< freertos simulator, host milliseconds a bounded wait blocks before the virtual timeout is taken
+
+/**
+ * @brief FreeRTOS simulator queue kinds, semaphores are queues without item storage.
+ */
+typedef enum freertos_sim_queue_kinds_e {
+    FREERTOS_SIM_QUEUE = 0,
+    FREERTOS_SIM_SEMAPHORE,
+    FREERTOS_SIM_MUTEX,
+    FREERTOS_SIM_RECURSIVE_MUTEX
+} freertos_sim_queue_kinds_t;
+
+/**
+ * @brief FreeRTOS simulator queue structure definition.
+ */
+struct QueueDefinition {
+    freertos_sim_queue_kinds_t  kind;       /*!< queue, kind of queue or semaphore */
+    pthread_mutex_t             mutex;      /*!< queue, host mutex guarding the state */
+    pthread_cond_t              cond;       /*!< queue, host condition signalled on every change */
+    uint8_t*                    storage;    /*!< queue, item storage, NULL for semaphores */
+    UBaseType_t                 length;     /*!< queue, maximum number of items or semaphore count */
+    UBaseType_t                 item_size;  /*!< queue, item size in bytes */
+    UBaseType_t                 count;      /*!< queue, number of items or semaphore count */
+    UBaseType_t                 head;       /*!< queue, index of the oldest item */
+    TaskHandle_t                holder;     /*!< queue, mutex holder */
+    UBaseType_t                 recursion;  /*!< queue, recursive mutex take count */
+};
+
+/**
+ * @brief FreeRTOS simulator task structure definition.
+ */
+struct tskTaskControlBlock {
+    pthread_t                   thread;     /*!< task, host thread */
+    TaskFunction_t              function;   /*!< task, task function, NULL for adopted host threads */
+    void*                       parameters; /*!< task, task function parameter */
+    pthread_mutex_t             mutex;      /*!< task, host mutex guarding the notification */
+    pthread_cond_t              cond;       /*!< task, host condition signalled on notification */
+    uint32_t                    notify;     /*!< task, notification value */
+};
+
+/*
+ * static variable declarations
+*/
+static pthread_once_t           freertos_sim_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t          freertos_sim_critical;
+static __thread TaskHandle_t    freertos_sim_current = NULL;
+
+/**
+ * @brief Initializes the recursive critical section mutex.
+ */
+static void freertos_sim_init_critical(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&freertos_sim_critical, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+/**
+ * @brief Converts ticks to virtual microseconds.
+ */
+static inline uint64_t freertos_sim_ticks_to_us(const TickType_t ticks) {
+    return (uint64_t)ticks * 1000000 / configTICK_RATE_HZ;
+}
+
+/**
+ * @brief Waits on a condition for a bounded wait.  The host thread blocks for at most 
+ * one wait slice so another thread can satisfy the wait, an unsatisfied wait returns 
+ * ETIMEDOUT and the caller takes the virtual timeout.
+ * 
+ * @param cond Host condition.
+ * @param mutex Host mutex held by the caller.
+ * @param ticks Ticks to wait, portMAX_DELAY blocks until signalled.
+ * @return int 0 when signalled, ETIMEDOUT when the wait slice elapsed.
+ */
+static inline int freertos_sim_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex, const TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return pthread_cond_wait(cond, mutex);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += (long)FREERTOS_SIM_WAIT_SLICE_MS * 1000000L;
+    deadline.tv_sec  += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+
+    return pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+/**
+ * @brief Creates a task handle for the calling host thread when it is not a task.
+ */
+static inline TaskHandle_t freertos_sim_get_current(void) {
+    if (freertos_sim_current) return freertos_sim_current;
+
+    TaskHandle_t task = (TaskHandle_t)calloc(1, sizeof(struct tskTaskControlBlock));
+    if (task == NULL) abort();
+
+    task->thread = pthread_self();
+    pthread_mutex_init(&task->mutex, NULL);
+    pthread_cond_init(&task->cond, NULL);
+    freertos_sim_current = task;
+
+    return task;
+}
+
+/**
+ * @brief Host thread entry of a task.
+ */
+static void* freertos_sim_task_entry(void *arg) {
+    TaskHandle_t task = (TaskHandle_t)arg;
+
+    freertos_sim_current = task;
+    task->function(task->parameters);
+
+    /* a task function must not return, end the thread as vTaskDelete(NULL) would */
+    vTaskDelete(NULL);
+
+    return NULL;
+}
+
+/**
+ * @brief Creates a queue or semaphore.
+ */
+static QueueHandle_t freertos_sim_queue_create(const freertos_sim_queue_kinds_t kind, const UBaseType_t length, const UBaseType_t item_size, const UBaseType_t count) {
+    QueueHandle_t queue = (QueueHandle_t)calloc(1, sizeof(struct QueueDefinition));
+    if (queue == NULL) return NULL;
+
+    if (kind == FREERTOS_SIM_QUEUE) {
+        queue->storage = (uint8_t*)calloc(length, item_size);
+        if (queue->storage == NULL) {
+            free(queue);
+            return NULL;
+        }
+    }
+
+    queue->kind      = kind;
+    queue->length    = length;
+    queue->item_size = item_size;
+    queue->count     = count;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+
+    return queue;
+}
+
+/**
+ * @brief Sends an item to a queue or gives a semaphore.
+ */
+static BaseType_t freertos_sim_queue_send(QueueHandle_t queue, const void *const item, const TickType_t ticks) {
+    if (queue == NULL) return pdFAIL;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count >= queue->length) {
+        if (ticks == 0 || freertos_sim_cond_wait(&queue->cond, &queue->mutex, ticks) == ETIMEDOUT) {
+            pthread_mutex_unlock(&queue->mutex);
+            if (ticks) i2c_sim_delay_us(freertos_sim_ticks_to_us(ticks));
+            return pdFAIL;
+        }
+    }
+
+    if (queue->storage && item) {
+        const UBaseType_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->storage + tail * queue->item_size, item, queue->item_size);
+    }
+    queue->count++;
+    if (queue->kind == FREERTOS_SIM_MUTEX || queue->kind == FREERTOS_SIM_RECURSIVE_MUTEX) queue->holder = NULL;
+
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return pdPASS;
+}
+
+/**
+ * @brief Receives an item from a queue or takes a semaphore.
+ */
+static BaseType_t freertos_sim_queue_receive(QueueHandle_t queue, void *const item, const TickType_t ticks) {
+    if (queue == NULL) return pdFAIL;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count == 0) {
+        if (ticks == 0 || freertos_sim_cond_wait(&queue->cond, &queue->mutex, ticks) == ETIMEDOUT) {
+            pthread_mutex_unlock(&queue->mutex);
+            if (ticks) i2c_sim_delay_us(freertos_sim_ticks_to_us(ticks));
+            return pdFAIL;
+        }
+    }
+
+    if (queue->storage) {
+        memcpy(item, queue->storage + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+    }
+    queue->count--;
+    if (queue->kind == FREERTOS_SIM_MUTEX || queue->kind == FREERTOS_SIM_RECURSIVE_MUTEX) queue->holder = freertos_sim_get_current();
+
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return pdPASS;
+}
+
+/*
+ * critical sections
+*/
+
+void vPortEnterCritical(portMUX_TYPE *mux) {
+    pthread_once(&freertos_sim_once, freertos_sim_init_critical);
+    pthread_mutex_lock(&freertos_sim_critical);
+    if (mux) mux->count++;
+}
+
+void vPortExitCritical(portMUX_TYPE *mux) {
+    if (mux && mux->count) mux->count--;
+    pthread_mutex_unlock(&freertos_sim_critical);
+}
+
+/*
+ * tasks
+*/
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                                   void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask, const BaseType_t xCoreID) {
+    if (pxTaskCode == NULL) return pdFAIL;
+
+    TaskHandle_t task = (TaskHandle_t)calloc(1, sizeof(struct tskTaskControlBlock));
+    if (task == NULL) return pdFAIL;
+
+    task->function   = pxTaskCode;
+    task->parameters = pvParameters;
+    pthread_mutex_init(&task->mutex, NULL);
+    pthread_cond_init(&task->cond, NULL);
+
+    /* the handle is published before the task runs, as the scheduler would */
+    if (pxCreatedTask) *pxCreatedTask = task;
+
+    if (pthread_create(&task->thread, NULL, freertos_sim_task_entry, task) != 0) {
+        if (pxCreatedTask) *pxCreatedTask = NULL;
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(task->thread);
+
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask) {
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    TaskHandle_t task = freertos_sim_get_current();
+
+    if (xTaskToDelete != NULL && xTaskToDelete != task) {
+        ESP_LOGE("freertos_sim", "only the calling task can be deleted");
+        return;
+    }
+
+    /* the handle is not released, other tasks may still hold it */
+    pthread_exit(NULL);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+    i2c_sim_delay_us(freertos_sim_ticks_to_us(xTicksToDelay));
+    sched_yield();
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)((uint64_t)i2c_sim_get_time_us() * configTICK_RATE_HZ / 1000000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return freertos_sim_get_current();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    if (xTaskToNotify == NULL) return pdFAIL;
+
+    pthread_mutex_lock(&xTaskToNotify->mutex);
+    xTaskToNotify->notify++;
+    pthread_cond_broadcast(&xTaskToNotify->cond);
+    pthread_mutex_unlock(&xTaskToNotify->mutex);
+
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) {
+    xTaskNotifyGive(xTaskToNotify);
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    TaskHandle_t task = freertos_sim_get_current();
+
+    pthread_mutex_lock(&task->mutex);
+
+    while (task->notify == 0) {
+        if (xTicksToWait == 0 || freertos_sim_cond_wait(&task->cond, &task->mutex, xTicksToWait) == ETIMEDOUT) {
+            pthread_mutex_unlock(&task->mutex);
+            if (xTicksToWait) i2c_sim_delay_us(freertos_sim_ticks_to_us(xTicksToWait));
+            return 0;
+        }
+    }
+
+    const uint32_t value = task->notify;
+    task->notify = xClearCountOnExit ? 0 : value - 1;
+
+    pthread_mutex_unlock(&task->mutex);
+
+    return value;
+}
+
+/*
+ * queues
+*/
+
+QueueHandle_t xQueueCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize) {
+    if (uxQueueLength == 0 || uxItemSize == 0) return NULL;
+
+    return freertos_sim_queue_create(FREERTOS_SIM_QUEUE, uxQueueLength, uxItemSize, 0);
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+    if (xQueue == NULL) return;
+
+    pthread_cond_destroy(&xQueue->cond);
+    pthread_mutex_destroy(&xQueue->mutex);
+    free(xQueue->storage);
+    free(xQueue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *const pvItemToQueue, TickType_t xTicksToWait) {
+    return freertos_sim_queue_send(xQueue, pvItemToQueue, xTicksToWait);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *const pvItemToQueue, TickType_t xTicksToWait) {
+    return freertos_sim_queue_send(xQueue, pvItemToQueue, xTicksToWait);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void *const pvItemToQueue, BaseType_t *const pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return freertos_sim_queue_send(xQueue, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *const pvBuffer, TickType_t xTicksToWait) {
+    return freertos_sim_queue_receive(xQueue, pvBuffer, xTicksToWait);
+}
+
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue) {
+    if (xQueue == NULL) return 0;
+
+    pthread_mutex_lock(&xQueue->mutex);
+    const UBaseType_t count = xQueue->count;
+    pthread_mutex_unlock(&xQueue->mutex);
+
+    return count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue) {
+    if (xQueue == NULL) return pdFAIL;
+
+    pthread_mutex_lock(&xQueue->mutex);
+    xQueue->count = 0;
+    xQueue->head  = 0;
+    pthread_cond_broadcast(&xQueue->cond);
+    pthread_mutex_unlock(&xQueue->mutex);
+
+    return pdPASS;
+}
+
+/*
+ * semaphores
+*/
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return freertos_sim_queue_create(FREERTOS_SIM_SEMAPHORE, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount) {
+    if (uxMaxCount == 0 || uxInitialCount > uxMaxCount) return NULL;
+
+    return freertos_sim_queue_create(FREERTOS_SIM_SEMAPHORE, uxMaxCount, 0, uxInitialCount);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return freertos_sim_queue_create(FREERTOS_SIM_MUTEX, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+    return freertos_sim_queue_create(FREERTOS_SIM_RECURSIVE_MUTEX, 1, 0, 1);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+    vQueueDelete(xSemaphore);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait) {
+    return freertos_sim_queue_receive(xSemaphore, NULL, xTicksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    return freertos_sim_queue_send(xSemaphore, NULL, 0);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *const pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return freertos_sim_queue_send(xSemaphore, NULL, 0);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait) {
+    if (xMutex == NULL) return pdFAIL;
+
+    TaskHandle_t task = freertos_sim_get_current();
+
+    /* a nested take by the holder only counts */
+    pthread_mutex_lock(&xMutex->mutex);
+    if (xMutex->count == 0 && xMutex->holder == task) {
+        xMutex->recursion++;
+        pthread_mutex_unlock(&xMutex->mutex);
+        return pdPASS;
+    }
+    pthread_mutex_unlock(&xMutex->mutex);
+
+    if (freertos_sim_queue_receive(xMutex, NULL, xTicksToWait) != pdPASS) return pdFAIL;
+
+    pthread_mutex_lock(&xMutex->mutex);
+    xMutex->recursion = 1;
+    pthread_mutex_unlock(&xMutex->mutex);
+
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex) {
+    if (xMutex == NULL) return pdFAIL;
+
+    TaskHandle_t task = freertos_sim_get_current();
+
+    pthread_mutex_lock(&xMutex->mutex);
+    if (xMutex->holder != task || xMutex->recursion == 0) {
+        pthread_mutex_unlock(&xMutex->mutex);
+        return pdFAIL;
+    }
+    if (--xMutex->recursion > 0) {
+        pthread_mutex_unlock(&xMutex->mutex);
+        return pdPASS;
+    }
+    pthread_mutex_unlock(&xMutex->mutex);
+
+    return freertos_sim_queue_send(xMutex, NULL, 0);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) {
+    return uxQueueMessagesWaiting(xSemaphore);
+}
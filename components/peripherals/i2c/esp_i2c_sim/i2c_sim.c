@@ -0,0 +1,757 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim.c
+ *
+ * Host I2C master bus simulator for ESP-IDF I2C device drivers
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_sim.h"
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/**
+ * @brief I2C simulator device structure definition, a model attached to a port and address.
+ */
+typedef struct i2c_sim_device_s {
+    i2c_port_num_t              port;           /*!< i2c simulator device, port number of the simulated bus */
+    uint16_t                    address;        /*!< i2c simulator device, 7-bit address */
+    i2c_sim_model_t*            model;          /*!< i2c simulator device, model */
+    uint32_t                    nack_count;     /*!< i2c simulator device, number of injected NACKs pending */
+    uint32_t                    timeout_count;  /*!< i2c simulator device, number of injected timeouts pending */
+    i2c_sim_stats_t             stats;          /*!< i2c simulator device, statistics */
+    struct i2c_sim_device_s*    next;           /*!< i2c simulator device, next device in the list */
+} i2c_sim_device_t;
+
+/**
+ * @brief I2C master bus handle structure definition for the shim.
+ */
+struct i2c_master_bus_t {
+    i2c_port_num_t              port;           /*!< i2c master bus, port number */
+    uint32_t                    device_count;   /*!< i2c master bus, number of device handles */
+};
+
+/**
+ * @brief I2C master device handle structure definition for the shim.
+ */
+struct i2c_master_dev_t {
+    i2c_master_bus_handle_t     bus;            /*!< i2c master device, bus handle */
+    uint16_t                    address;        /*!< i2c master device, 7-bit address */
+    uint32_t                    scl_speed_hz;   /*!< i2c master device, scl speed in hertz */
+};
+
+/**
+ * @brief GPIO interrupt state structure definition for the shim.
+ */
+typedef struct i2c_sim_gpio_s {
+    gpio_isr_t                  handler;        /*!< gpio, interrupt handler */
+    void*                       args;           /*!< gpio, interrupt handler argument */
+    bool                        intr_enabled;   /*!< gpio, interrupt is enabled when true */
+    uint32_t                    level;          /*!< gpio, output level */
+    i2c_sim_gpio_update_t       update;         /*!< gpio, device model line update called before the level is read */
+    void*                       update_context; /*!< gpio, device model line update context */
+} i2c_sim_gpio_t;
+
+/*
+ * static constant declarations
+*/
+static const char *TAG = "i2c_sim";
+
+/*
+ * static variable declarations
+*/
+static pthread_once_t           i2c_sim_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t          i2c_sim_mutex;
+static int64_t                  i2c_sim_time_us = 0;
+static i2c_sim_device_t*        i2c_sim_devices = NULL;
+static i2c_sim_stats_t          i2c_sim_stats   = { 0 };
+static i2c_master_bus_handle_t  i2c_sim_buses[I2C_NUM_MAX] = { NULL };
+static bool                     i2c_sim_bus_faults[I2C_NUM_MAX] = { false };
+static bool                     i2c_sim_isr_service = false;
+static i2c_sim_gpio_t           i2c_sim_gpios[GPIO_PIN_COUNT] = { 0 };
+
+/**
+ * @brief Initializes the recursive simulation lock, models may call back into the simulator.
+ */
+static void i2c_sim_init_lock(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&i2c_sim_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+static inline void i2c_sim_lock(void) {
+    pthread_once(&i2c_sim_once, i2c_sim_init_lock);
+    pthread_mutex_lock(&i2c_sim_mutex);
+}
+
+static inline void i2c_sim_unlock(void) {
+    pthread_mutex_unlock(&i2c_sim_mutex);
+}
+
+/**
+ * @brief Finds the device attached at a port and address, the lock must be held.
+ * 
+ * @param port I2C port number.
+ * @param address 7-bit device address.
+ * @return i2c_sim_device_t* Device or NULL when no model is attached.
+ */
+static inline i2c_sim_device_t* i2c_sim_find_device(const i2c_port_num_t port, const uint16_t address) {
+    for (i2c_sim_device_t *device = i2c_sim_devices; device; device = device->next) {
+        if (device->port == port && device->address == address) return device;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Gets the simulated bus time of a transaction.  Each byte is 8 data bits and an 
+ * acknowledge bit, start, repeated start and stop conditions are one bit time each.
+ * 
+ * @param scl_speed_hz SCL speed in hertz.
+ * @param write_size Number of bytes written, excluding the address byte.
+ * @param read_size Number of bytes read, excluding the address byte.
+ * @param combined Transaction is a write followed by a repeated start and a read when true.
+ * @return uint64_t Bus time in microseconds, rounded up.
+ */
+static inline uint64_t i2c_sim_get_bus_time(const uint32_t scl_speed_hz, const size_t write_size, const size_t read_size, const bool combined) {
+    const uint64_t speed = scl_speed_hz ? scl_speed_hz : I2C_SIM_DEFAULT_SCL_SPEED_HZ;
+    uint64_t bits = 2 * I2C_SIM_BIT_TIME_START_STOP;
+
+    if (combined) {
+        bits += I2C_SIM_BIT_TIME_START_STOP + 2 * I2C_SIM_BIT_TIME_BYTE;
+    } else {
+        bits += I2C_SIM_BIT_TIME_BYTE;
+    }
+    bits += (uint64_t)(write_size + read_size) * I2C_SIM_BIT_TIME_BYTE;
+
+    return (bits * 1000000 + speed - 1) / speed;
+}
+
+/**
+ * @brief Adds a transaction to the simulation and device statistics and advances the 
+ * virtual time by its bus time, the lock must be held.
+ */
+static inline void i2c_sim_account(i2c_sim_device_t *const device, const size_t write_size, const size_t read_size, const uint64_t bus_time_us, const esp_err_t result) {
+    i2c_sim_stats_t *const stats[2] = { &i2c_sim_stats, device ? &device->stats : NULL };
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if (stats[i] == NULL) continue;
+        stats[i]->transactions++;
+        stats[i]->bytes_written += write_size;
+        stats[i]->bytes_read    += read_size;
+        stats[i]->bus_time_us   += bus_time_us;
+        if (result == ESP_ERR_INVALID_STATE) stats[i]->nacks++;
+        if (result == ESP_ERR_TIMEOUT) stats[i]->timeouts++;
+    }
+
+    __atomic_add_fetch(&i2c_sim_time_us, (int64_t)bus_time_us, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Runs a simulated transaction on a device handle.
+ * 
+ * @param i2c_dev I2C device handle.
+ * @param write_buffer Bytes to write, NULL for a read.
+ * @param write_size Number of bytes to write.
+ * @param read_buffer Buffer for the bytes read, NULL for a write.
+ * @param read_size Number of bytes to read.
+ * @param xfer_timeout_ms Transfer timeout in milliseconds, an injected timeout holds the bus for this time.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE on NACK, ESP_ERR_TIMEOUT on an injected timeout.
+ */
+static esp_err_t i2c_sim_transaction(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, const size_t write_size, uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( i2c_dev && (write_buffer || write_size == 0) && (read_buffer || read_size == 0) );
+
+    const bool combined = (write_size > 0 && read_size > 0);
+
+    i2c_sim_lock();
+
+    i2c_sim_device_t *device = i2c_sim_find_device(i2c_dev->bus->port, i2c_dev->address);
+
+    /* a faulted bus times out every transaction, i.e. SDA held low */
+    if (i2c_sim_bus_faults[i2c_dev->bus->port] == true) {
+        i2c_sim_account(device, 0, 0, xfer_timeout_ms > 0 ? (uint64_t)xfer_timeout_ms * 1000 : i2c_sim_get_bus_time(i2c_dev->scl_speed_hz, 0, 0, false), ESP_ERR_TIMEOUT);
+        i2c_sim_unlock();
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* address is not acknowledged without a model or with an injected NACK */
+    if (device == NULL || device->nack_count > 0) {
+        if (device) device->nack_count--;
+        i2c_sim_account(device, 0, 0, i2c_sim_get_bus_time(i2c_dev->scl_speed_hz, 0, 0, false), ESP_ERR_INVALID_STATE);
+        i2c_sim_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* an injected timeout holds the bus for the transfer timeout, i.e. a device stretching the clock */
+    if (device->timeout_count > 0) {
+        device->timeout_count--;
+        i2c_sim_account(device, 0, 0, xfer_timeout_ms > 0 ? (uint64_t)xfer_timeout_ms * 1000 : i2c_sim_get_bus_time(i2c_dev->scl_speed_hz, 0, 0, false), ESP_ERR_TIMEOUT);
+        i2c_sim_unlock();
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* write phase, a NACK ends the transaction */
+    if (write_size > 0) {
+        ret = device->model->write(device->model->context, write_buffer, write_size);
+    }
+
+    /* read phase after a start or repeated start */
+    if (ret == ESP_OK && read_size > 0) {
+        ret = device->model->read(device->model->context, read_buffer, read_size);
+    }
+
+    if (ret == ESP_OK) {
+        i2c_sim_account(device, write_size, read_size, i2c_sim_get_bus_time(i2c_dev->scl_speed_hz, write_size, read_size, combined), ESP_OK);
+    } else {
+        i2c_sim_account(device, write_size, 0, i2c_sim_get_bus_time(i2c_dev->scl_speed_hz, write_size, 0, false), ESP_ERR_INVALID_STATE);
+        ret = ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_sim_unlock();
+
+    return ret;
+}
+
+int64_t i2c_sim_get_time_us(void) {
+    return __atomic_load_n(&i2c_sim_time_us, __ATOMIC_SEQ_CST);
+}
+
+void i2c_sim_advance_time_us(const uint64_t time_us) {
+    __atomic_add_fetch(&i2c_sim_time_us, (int64_t)time_us, __ATOMIC_SEQ_CST);
+}
+
+void i2c_sim_delay_us(const uint64_t time_us) {
+    i2c_sim_lock();
+    i2c_sim_stats.delays++;
+    i2c_sim_stats.delay_time_us += time_us;
+    i2c_sim_unlock();
+
+    i2c_sim_advance_time_us(time_us);
+}
+
+esp_err_t i2c_sim_add_device(const i2c_port_num_t port, const uint16_t address, i2c_sim_model_t *const model) {
+    /* validate arguments */
+    ESP_ARG_CHECK( port >= 0 && port < I2C_NUM_MAX && model && model->write && model->read );
+
+    i2c_sim_lock();
+
+    if (i2c_sim_find_device(port, address)) {
+        i2c_sim_unlock();
+        ESP_LOGE(TAG, "address 0x%02x is in use on port %d", address, port);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_sim_device_t *device = (i2c_sim_device_t*)calloc(1, sizeof(i2c_sim_device_t));
+    if (device == NULL) {
+        i2c_sim_unlock();
+        return ESP_ERR_NO_MEM;
+    }
+
+    device->port    = port;
+    device->address = address;
+    device->model   = model;
+    device->next    = i2c_sim_devices;
+    i2c_sim_devices = device;
+
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_remove_device(const i2c_port_num_t port, const uint16_t address) {
+    i2c_sim_lock();
+
+    for (i2c_sim_device_t **link = &i2c_sim_devices; *link; link = &(*link)->next) {
+        i2c_sim_device_t *device = *link;
+        if (device->port != port || device->address != address) continue;
+
+        *link = device->next;
+        i2c_sim_unlock();
+
+        if (device->model->destroy) device->model->destroy(device->model->context);
+        free(device->model);
+        free(device);
+
+        return ESP_OK;
+    }
+
+    i2c_sim_unlock();
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_sim_get_device(const i2c_port_num_t port, const uint16_t address, i2c_sim_model_t **const model) {
+    /* validate arguments */
+    ESP_ARG_CHECK( model );
+
+    i2c_sim_lock();
+    i2c_sim_device_t *device = i2c_sim_find_device(port, address);
+    if (device) *model = device->model;
+    i2c_sim_unlock();
+
+    return device ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_sim_inject_nacks(const i2c_port_num_t port, const uint16_t address, const uint32_t count) {
+    i2c_sim_lock();
+    i2c_sim_device_t *device = i2c_sim_find_device(port, address);
+    if (device) device->nack_count = count;
+    i2c_sim_unlock();
+
+    return device ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_sim_inject_timeouts(const i2c_port_num_t port, const uint16_t address, const uint32_t count) {
+    i2c_sim_lock();
+    i2c_sim_device_t *device = i2c_sim_find_device(port, address);
+    if (device) device->timeout_count = count;
+    i2c_sim_unlock();
+
+    return device ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t i2c_sim_set_bus_fault(const i2c_port_num_t port, const bool fault) {
+    /* validate arguments */
+    ESP_ARG_CHECK( port >= 0 && port < I2C_NUM_MAX );
+
+    i2c_sim_lock();
+    i2c_sim_bus_faults[port] = fault;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+void i2c_sim_get_stats(i2c_sim_stats_t *const stats) {
+    if (stats == NULL) return;
+
+    i2c_sim_lock();
+    *stats = i2c_sim_stats;
+    i2c_sim_unlock();
+}
+
+esp_err_t i2c_sim_get_device_stats(const i2c_port_num_t port, const uint16_t address, i2c_sim_stats_t *const stats) {
+    /* validate arguments */
+    ESP_ARG_CHECK( stats );
+
+    i2c_sim_lock();
+    i2c_sim_device_t *device = i2c_sim_find_device(port, address);
+    if (device) *stats = device->stats;
+    i2c_sim_unlock();
+
+    return device ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void i2c_sim_reset_stats(void) {
+    i2c_sim_lock();
+    memset(&i2c_sim_stats, 0, sizeof(i2c_sim_stats_t));
+    for (i2c_sim_device_t *device = i2c_sim_devices; device; device = device->next) {
+        memset(&device->stats, 0, sizeof(i2c_sim_stats_t));
+    }
+    i2c_sim_unlock();
+}
+
+void i2c_sim_reset(void) {
+    i2c_sim_lock();
+    i2c_sim_device_t *device = i2c_sim_devices;
+    i2c_sim_devices = NULL;
+    memset(&i2c_sim_stats, 0, sizeof(i2c_sim_stats_t));
+    memset(i2c_sim_bus_faults, 0, sizeof(i2c_sim_bus_faults));
+    i2c_sim_unlock();
+
+    while (device) {
+        i2c_sim_device_t *next = device->next;
+        if (device->model->destroy) device->model->destroy(device->model->context);
+        free(device->model);
+        free(device);
+        device = next;
+    }
+}
+
+esp_err_t i2c_sim_gpio_trigger(const gpio_num_t gpio_num) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    const i2c_sim_gpio_t gpio = i2c_sim_gpios[gpio_num];
+    i2c_sim_unlock();
+
+    if (i2c_sim_isr_service == false || gpio.handler == NULL || gpio.intr_enabled == false) return ESP_ERR_INVALID_STATE;
+
+    gpio.handler(gpio.args);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_gpio_set_update(const gpio_num_t gpio_num, i2c_sim_gpio_update_t update, void *context) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    i2c_sim_gpios[gpio_num].update         = update;
+    i2c_sim_gpios[gpio_num].update_context = context;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+/*
+ * esp_timer shim
+*/
+
+int64_t esp_timer_get_time(void) {
+    return i2c_sim_get_time_us();
+}
+
+/*
+ * i2c master driver shim
+*/
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_master_bus_handle_t *ret_bus_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_config && ret_bus_handle && bus_config->i2c_port >= -1 && bus_config->i2c_port < I2C_NUM_MAX );
+
+    i2c_sim_lock();
+
+    /* -1 selects the first free port */
+    i2c_port_num_t port = bus_config->i2c_port;
+    if (port == -1) {
+        for (port = 0; port < I2C_NUM_MAX && i2c_sim_buses[port]; port++);
+        if (port == I2C_NUM_MAX) {
+            i2c_sim_unlock();
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    if (i2c_sim_buses[port]) {
+        i2c_sim_unlock();
+        ESP_LOGE(TAG, "bus port %d is already created", port);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_master_bus_handle_t bus = (i2c_master_bus_handle_t)calloc(1, sizeof(struct i2c_master_bus_t));
+    if (bus == NULL) {
+        i2c_sim_unlock();
+        return ESP_ERR_NO_MEM;
+    }
+
+    bus->port = port;
+    i2c_sim_buses[port] = bus;
+    *ret_bus_handle = bus;
+
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle );
+
+    if (bus_handle->device_count > 0) {
+        ESP_LOGE(TAG, "bus port %d still has %u devices", bus_handle->port, bus_handle->device_count);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_sim_lock();
+    i2c_sim_buses[bus_handle->port] = NULL;
+    i2c_sim_unlock();
+
+    free(bus_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus_handle, int timeout_ms) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle );
+
+    /* transactions are synchronous */
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_get_bus_handle(i2c_port_num_t port_num, i2c_master_bus_handle_t *ret_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( port_num >= 0 && port_num < I2C_NUM_MAX && ret_handle );
+
+    i2c_sim_lock();
+    *ret_handle = i2c_sim_buses[port_num];
+    i2c_sim_unlock();
+
+    return *ret_handle ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config, i2c_master_dev_handle_t *ret_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle && dev_config && ret_handle );
+
+    i2c_master_dev_handle_t dev = (i2c_master_dev_handle_t)calloc(1, sizeof(struct i2c_master_dev_t));
+    if (dev == NULL) return ESP_ERR_NO_MEM;
+
+    dev->bus          = bus_handle;
+    dev->address      = dev_config->device_address;
+    dev->scl_speed_hz = dev_config->scl_speed_hz;
+
+    i2c_sim_lock();
+    bus_handle->device_count++;
+    i2c_sim_unlock();
+
+    *ret_handle = dev;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    i2c_sim_lock();
+    handle->bus->device_count--;
+    i2c_sim_unlock();
+
+    free(handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms) {
+    /* validate arguments */
+    ESP_ARG_CHECK( write_size > 0 );
+
+    return i2c_sim_transaction(i2c_dev, write_buffer, write_size, NULL, 0, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    /* validate arguments */
+    ESP_ARG_CHECK( read_size > 0 );
+
+    return i2c_sim_transaction(i2c_dev, NULL, 0, read_buffer, read_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    /* validate arguments */
+    ESP_ARG_CHECK( write_size > 0 && read_size > 0 );
+
+    return i2c_sim_transaction(i2c_dev, write_buffer, write_size, read_buffer, read_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address, int xfer_timeout_ms) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bus_handle );
+
+    i2c_sim_lock();
+
+    i2c_sim_device_t *device = i2c_sim_find_device(bus_handle->port, address);
+    uint64_t bus_time_us = i2c_sim_get_bus_time(I2C_SIM_DEFAULT_SCL_SPEED_HZ, 0, 0, false);
+    esp_err_t ret = device ? ESP_OK : ESP_ERR_NOT_FOUND;
+
+    /* a faulted bus or an injected timeout holds the bus for the probe timeout, an injected NACK is not found */
+    if (i2c_sim_bus_faults[bus_handle->port] == true || (device && device->timeout_count > 0)) {
+        if (i2c_sim_bus_faults[bus_handle->port] == false) device->timeout_count--;
+        if (xfer_timeout_ms > 0) bus_time_us = (uint64_t)xfer_timeout_ms * 1000;
+        ret = ESP_ERR_TIMEOUT;
+    } else if (device && device->nack_count > 0) {
+        device->nack_count--;
+        ret = ESP_ERR_NOT_FOUND;
+    }
+
+    i2c_sim_stats.probes++;
+    i2c_sim_stats.bus_time_us += bus_time_us;
+    if (ret == ESP_ERR_TIMEOUT) i2c_sim_stats.timeouts++;
+    if (device) {
+        device->stats.probes++;
+        device->stats.bus_time_us += bus_time_us;
+        if (ret == ESP_ERR_TIMEOUT) device->stats.timeouts++;
+    }
+    i2c_sim_advance_time_us(bus_time_us);
+
+    i2c_sim_unlock();
+
+    return ret;
+}
+
+/*
+ * gpio driver shim
+*/
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig) {
+    /* validate arguments */
+    ESP_ARG_CHECK( pGPIOConfig );
+
+    for (uint8_t gpio = 0; gpio < GPIO_PIN_COUNT; gpio++) {
+        if ((pGPIOConfig->pin_bit_mask & (1ULL << gpio)) == 0) continue;
+        gpio_set_intr_type((gpio_num_t)gpio, pGPIOConfig->intr_type);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    /* the line update belongs to the device model driving the line and is kept */
+    i2c_sim_lock();
+    const i2c_sim_gpio_update_t update         = i2c_sim_gpios[gpio_num].update;
+    void *const                 update_context = i2c_sim_gpios[gpio_num].update_context;
+    memset(&i2c_sim_gpios[gpio_num], 0, sizeof(i2c_sim_gpio_t));
+    i2c_sim_gpios[gpio_num].update         = update;
+    i2c_sim_gpios[gpio_num].update_context = update_context;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    i2c_sim_gpios[gpio_num].level = level ? 1 : 0;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    if (!GPIO_IS_VALID_GPIO(gpio_num)) return 0;
+
+    /* bring the line of the driving device model up to the virtual time */
+    i2c_sim_lock();
+    const i2c_sim_gpio_update_t update         = i2c_sim_gpios[gpio_num].update;
+    void *const                 update_context = i2c_sim_gpios[gpio_num].update_context;
+    i2c_sim_unlock();
+    if (update) update(update_context);
+
+    i2c_sim_lock();
+    const int level = (int)i2c_sim_gpios[gpio_num].level;
+    i2c_sim_unlock();
+
+    return level;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) && intr_type < GPIO_INTR_MAX );
+
+    i2c_sim_lock();
+    i2c_sim_gpios[gpio_num].intr_enabled = (intr_type != GPIO_INTR_DISABLE);
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    i2c_sim_gpios[gpio_num].intr_enabled = true;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    i2c_sim_gpios[gpio_num].intr_enabled = false;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags) {
+    i2c_sim_lock();
+    const bool installed = i2c_sim_isr_service;
+    i2c_sim_isr_service = true;
+    i2c_sim_unlock();
+
+    return installed ? ESP_ERR_INVALID_STATE : ESP_OK;
+}
+
+void gpio_uninstall_isr_service(void) {
+    i2c_sim_lock();
+    i2c_sim_isr_service = false;
+    for (uint8_t gpio = 0; gpio < GPIO_PIN_COUNT; gpio++) {
+        i2c_sim_gpios[gpio].handler = NULL;
+        i2c_sim_gpios[gpio].args    = NULL;
+    }
+    i2c_sim_unlock();
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    if (i2c_sim_isr_service == false) {
+        i2c_sim_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+    i2c_sim_gpios[gpio_num].handler = isr_handler;
+    i2c_sim_gpios[gpio_num].args    = args;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num) {
+    /* validate arguments */
+    ESP_ARG_CHECK( GPIO_IS_VALID_GPIO(gpio_num) );
+
+    i2c_sim_lock();
+    if (i2c_sim_isr_service == false) {
+        i2c_sim_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+    i2c_sim_gpios[gpio_num].handler = NULL;
+    i2c_sim_gpios[gpio_num].args    = NULL;
+    i2c_sim_unlock();
+
+    return ESP_OK;
+}
@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim.h
+ * @defgroup drivers i2c_sim
+ * @{
+ *
+ * Host I2C master bus simulator for ESP-IDF I2C device drivers
+ *
+ * The `shim` include directory replaces `driver/i2c_master.h`, the FreeRTOS 
+ * task, queue and semaphore headers, and the esp_timer, esp_log and esp_check 
+ * headers so an unmodified driver source file builds on a Linux host.  Bus 
+ * transactions are routed to device models attached by port and address, and 
+ * time is virtual: `vTaskDelay` and every transaction advance a simulation 
+ * clock that `esp_timer_get_time` returns.  Transactions, bytes, NACKs, and 
+ * simulated bus microseconds at the device SCL speed are counted per device 
+ * and for the simulation, delays are counted for the simulation.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_SIM_H__
+#define __I2C_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include <driver/i2c_master.h>
+#include <driver/gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C simulator definitions
+*/
+#define I2C_SIM_BIT_TIME_START_STOP     (1)         //!< i2c simulator, bit times of a start, repeated start or stop condition
+#define I2C_SIM_BIT_TIME_BYTE           (9)         //!< i2c simulator, bit times of a byte and its acknowledge
+#define I2C_SIM_DEFAULT_SCL_SPEED_HZ    (100000)    //!< i2c simulator, scl speed when the device configuration speed is 0
+
+/*
+ * I2C simulator enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C simulator device model write function signature.  Called with the bytes of a 
+ * write transaction after the address byte, a non ESP_OK return is a NACK.
+ */
+typedef esp_err_t (*i2c_sim_model_write_t)(void *context, const uint8_t *buffer, const size_t size);
+
+/**
+ * @brief I2C simulator device model read function signature.  Called to fill the bytes of a 
+ * read transaction after the address byte, a non ESP_OK return is an address NACK.
+ */
+typedef esp_err_t (*i2c_sim_model_read_t)(void *context, uint8_t *buffer, const size_t size);
+
+/**
+ * @brief I2C simulator device model destroy function signature, releases the context.
+ */
+typedef void (*i2c_sim_model_destroy_t)(void *context);
+
+/**
+ * @brief GPIO line update function signature.  Called before `gpio_get_level` reads a line 
+ * driven by a device model, i.e. to set a data-ready line when a conversion completed at the 
+ * virtual time.  The simulation lock is not held during the call.
+ */
+typedef void (*i2c_sim_gpio_update_t)(void *context);
+
+/**
+ * @brief I2C simulator device model structure.  A model reads the virtual time with 
+ * `i2c_sim_get_time_us` to emulate conversion times, the bus lock is held during callbacks.
+ */
+typedef struct i2c_sim_model_s {
+    const char*                 name;       /*!< i2c simulator model, device name used in logs */
+    void*                       context;    /*!< i2c simulator model, device state passed to the callbacks */
+    i2c_sim_model_write_t       write;      /*!< i2c simulator model, write transaction callback */
+    i2c_sim_model_read_t        read;       /*!< i2c simulator model, read transaction callback */
+    i2c_sim_model_destroy_t     destroy;    /*!< i2c simulator model, context release callback, optional */
+} i2c_sim_model_t;
+
+/**
+ * @brief I2C simulator statistics structure.
+ */
+typedef struct i2c_sim_stats_s {
+    uint32_t                    transactions;   /*!< i2c simulator, transmit, receive and transmit-receive transactions */
+    uint32_t                    probes;         /*!< i2c simulator, probe transactions */
+    uint32_t                    nacks;          /*!< i2c simulator, transactions not acknowledged */
+    uint32_t                    timeouts;       /*!< i2c simulator, transactions timed out by an injected timeout */
+    uint64_t                    bytes_written;  /*!< i2c simulator, data bytes written excluding address bytes */
+    uint64_t                    bytes_read;     /*!< i2c simulator, data bytes read */
+    uint64_t                    bus_time_us;    /*!< i2c simulator, simulated bus time in microseconds */
+    uint32_t                    delays;         /*!< i2c simulator, task delays and unsatisfied timed waits, simulation only */
+    uint64_t                    delay_time_us;  /*!< i2c simulator, virtual time spent in task delays and timed waits in microseconds, simulation only */
+} i2c_sim_stats_t;
+
+/**
+ * @brief Gets the simulation virtual time.
+ * 
+ * @return int64_t Virtual time in microseconds.
+ */
+int64_t i2c_sim_get_time_us(void);
+
+/**
+ * @brief Advances the simulation virtual time, i.e. to let a device conversion complete 
+ * without a task delay.
+ * 
+ * @param time_us Time to advance in microseconds.
+ */
+void i2c_sim_advance_time_us(const uint64_t time_us);
+
+/**
+ * @brief Attaches a device model to a simulated bus port and address.  The simulator owns 
+ * the model and destroys it when the device is removed.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @param model Device model, see `i2c_sim_models.h` for the included device models.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the address is in use.
+ */
+esp_err_t i2c_sim_add_device(const i2c_port_num_t port, const uint16_t address, i2c_sim_model_t *const model);
+
+/**
+ * @brief Detaches and destroys the device model at a simulated bus port and address.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t i2c_sim_remove_device(const i2c_port_num_t port, const uint16_t address);
+
+/**
+ * @brief Gets the device model attached at a simulated bus port and address.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @param model Device model.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t i2c_sim_get_device(const i2c_port_num_t port, const uint16_t address, i2c_sim_model_t **const model);
+
+/**
+ * @brief Forces the next transactions or probes to a device to be not acknowledged, i.e. to test driver 
+ * error and retry paths.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @param count Number of transactions to NACK.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t i2c_sim_inject_nacks(const i2c_port_num_t port, const uint16_t address, const uint32_t count);
+
+/**
+ * @brief Forces the next transactions to a device to time out, i.e. to test that driver error 
+ * paths tell a bus fault from a NACK.  A timed out transaction or probe holds the bus for its transfer timeout.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @param count Number of transactions to time out.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t i2c_sim_inject_timeouts(const i2c_port_num_t port, const uint16_t address, const uint32_t count);
+
+/**
+ * @brief Sets or clears a bus fault on a simulated bus port, i.e. SDA held low by a device.  While 
+ * the fault is set every probe and transaction on the port times out and holds the bus for its 
+ * transfer timeout.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param fault Bus fault is set when true.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for an invalid port.
+ */
+esp_err_t i2c_sim_set_bus_fault(const i2c_port_num_t port, const bool fault);
+
+/**
+ * @brief Gets the simulation statistics, all devices and task delays.
+ * 
+ * @param stats Simulation statistics.
+ */
+void i2c_sim_get_stats(i2c_sim_stats_t *const stats);
+
+/**
+ * @brief Gets the statistics of a device, the delay counters are not tracked per device.
+ * 
+ * @param port I2C port number of the simulated bus.
+ * @param address 7-bit device address.
+ * @param stats Device statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t i2c_sim_get_device_stats(const i2c_port_num_t port, const uint16_t address, i2c_sim_stats_t *const stats);
+
+/**
+ * @brief Clears the simulation and device statistics, the virtual time is not changed.
+ */
+void i2c_sim_reset_stats(void);
+
+/**
+ * @brief Removes and destroys all device models and clears the statistics.  Buses and 
+ * device handles created by drivers must be deleted before.
+ */
+void i2c_sim_reset(void);
+
+/**
+ * @brief Records a task delay or an unsatisfied timed wait and advances the virtual time, 
+ * used by the FreeRTOS shim.
+ * 
+ * @param time_us Delay time in microseconds.
+ */
+void i2c_sim_delay_us(const uint64_t time_us);
+
+/**
+ * @brief Calls the interrupt handler installed on a GPIO when its interrupt is enabled, 
+ * i.e. to emulate a device interrupt line from a test.
+ * 
+ * @param gpio_num GPIO number.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when no handler is installed or the interrupt is disabled.
+ */
+esp_err_t i2c_sim_gpio_trigger(const gpio_num_t gpio_num);
+
+/**
+ * @brief Sets the line update of a GPIO driven by a device model, the update is called 
+ * before the level is read with `gpio_get_level`.
+ * 
+ * @param gpio_num GPIO number.
+ * @param update Line update, NULL to remove the update.
+ * @param context Line update context.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_gpio_set_update(const gpio_num_t gpio_num, i2c_sim_gpio_update_t update, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_SIM_H__
@@ -0,0 +1,345 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_models.h
+ * @defgroup drivers i2c_sim_models
+ * @{
+ *
+ * Device models for the host I2C master bus simulator
+ *
+ * Each model follows the register map, command set and timing of its device 
+ * datasheet closely enough for the driver in this repository to initialize, 
+ * configure and read measurements.  Measurement inputs are set in engineering 
+ * units and converted to raw values with the calibration the model reports.  A 
+ * created model is attached with `i2c_sim_add_device`, which takes ownership.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_SIM_MODELS_H__
+#define __I2C_SIM_MODELS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include "i2c_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C simulator model definitions
+*/
+#define I2C_SIM_BMP280_ADDRESS      UINT8_C(0x76)   //!< bmp280 model, default address (SDO low)
+#define I2C_SIM_BMP390_ADDRESS      UINT8_C(0x77)   //!< bmp390 model, default address (SDO high)
+#define I2C_SIM_SHT4X_ADDRESS       UINT8_C(0x44)   //!< sht4x model, default address
+#define I2C_SIM_AHTXX_ADDRESS       UINT8_C(0x38)   //!< ahtxx model, default address
+#define I2C_SIM_INA228_ADDRESS      UINT8_C(0x40)   //!< ina228 model, default address (A0 and A1 low)
+#define I2C_SIM_INA226_ADDRESS      UINT8_C(0x40)   //!< ina226 model, default address (A0 and A1 low)
+#define I2C_SIM_HDC1080_ADDRESS     UINT8_C(0x40)   //!< hdc1080 model, fixed address
+#define I2C_SIM_PCT2075_ADDRESS     UINT8_C(0x37)   //!< pct2075 model, default address (A0, A1 and A2 floating)
+#define I2C_SIM_MLX90614_ADDRESS    UINT8_C(0x5A)   //!< mlx90614 model, default SMBus address
+#define I2C_SIM_MPU6050_ADDRESS     UINT8_C(0x68)   //!< mpu6050 model, default address (AD0 low)
+#define I2C_SIM_MAX30105_ADDRESS    UINT8_C(0x57)   //!< max30105 model, default address
+#define I2C_SIM_SSD1306_ADDRESS     UINT8_C(0x3C)   //!< ssd1306 model, default address
+#define I2C_SIM_SSD1306_WIDTH       UINT8_C(128)    //!< ssd1306 model, display width in pixels
+#define I2C_SIM_SSD1306_PAGES       UINT8_C(8)      //!< ssd1306 model, display RAM pages of 8 rows
+#define I2C_SIM_SSD1306_RAM_SIZE    (I2C_SIM_SSD1306_WIDTH * I2C_SIM_SSD1306_PAGES) //!< ssd1306 model, display RAM size in bytes
+
+/*
+ * I2C simulator model function prototypes
+*/
+
+/**
+ * @brief Creates a BMP280 pressure and temperature sensor model with the datasheet 
+ * example calibration.  Forced and normal mode conversions take the maximum 
+ * measurement time of the oversampling settings.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_bmp280_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the environment measured by a BMP280 model.
+ * 
+ * @param model BMP280 model.
+ * @param temperature Temperature in degrees Celsius.
+ * @param pressure Pressure in pascal.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_bmp280_set_environment(i2c_sim_model_t *const model, const float temperature, const float pressure);
+
+/**
+ * @brief Creates a BMP390 pressure and temperature sensor model with a fixed NVM 
+ * calibration.  The model converts in forced and normal mode and fills the FIFO 
+ * at the output data rate.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_bmp390_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the environment measured by a BMP390 model.
+ * 
+ * @param model BMP390 model.
+ * @param temperature Temperature in degrees Celsius.
+ * @param pressure Pressure in pascal.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_bmp390_set_environment(i2c_sim_model_t *const model, const float temperature, const float pressure);
+
+/**
+ * @brief Creates a SHT4x temperature and humidity sensor model.  Reads are not 
+ * acknowledged while a measurement or heater command is in progress.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_sht4x_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the environment measured by a SHT4x model.
+ * 
+ * @param model SHT4x model.
+ * @param temperature Temperature in degrees Celsius.
+ * @param humidity Relative humidity in percent.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_sht4x_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity);
+
+/**
+ * @brief Creates an AHT2x temperature and humidity sensor model.  The status busy 
+ * bit is set for the measurement time after a trigger command.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ahtxx_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the environment measured by an AHTxx model.
+ * 
+ * @param model AHTxx model.
+ * @param temperature Temperature in degrees Celsius.
+ * @param humidity Relative humidity in percent.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ahtxx_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity);
+
+/**
+ * @brief Creates an INA228 power monitor model.  Triggered and continuous modes 
+ * convert with the conversion times and averaging of the ADC configuration.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ina228_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the inputs measured by an INA228 model.
+ * 
+ * @param model INA228 model.
+ * @param bus_voltage Bus voltage in volts.
+ * @param shunt_voltage Shunt voltage in volts.
+ * @param die_temperature Die temperature in degrees Celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ina228_set_inputs(i2c_sim_model_t *const model, const float bus_voltage, const float shunt_voltage, const float die_temperature);
+
+/**
+ * @brief Creates an INA226 power monitor model.  Triggered and continuous modes 
+ * convert with the conversion times and averaging of the configuration register 
+ * and set the conversion ready flag, which clears when the mask/enable register 
+ * is read.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ina226_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the inputs measured by an INA226 model.
+ * 
+ * @param model INA226 model.
+ * @param bus_voltage Bus voltage in volts.
+ * @param shunt_voltage Shunt voltage in volts.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ina226_set_inputs(i2c_sim_model_t *const model, const float bus_voltage, const float shunt_voltage);
+
+/**
+ * @brief Creates a HDC1080 temperature and humidity sensor model.  A pointer write to 
+ * the temperature or humidity register triggers a conversion with the resolution 
+ * conversion times, temperature and humidity in sequenced acquisition mode, and the 
+ * result read is not acknowledged until the conversion completes.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_hdc1080_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the environment measured by a HDC1080 model.
+ * 
+ * @param model HDC1080 model.
+ * @param temperature Temperature in degrees Celsius (-40 to 125).
+ * @param humidity Relative humidity in percent (0 to 100).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_hdc1080_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity);
+
+/**
+ * @brief Creates a PCT2075 temperature sensor model.  The temperature register holds 
+ * the power-on value of 0 degrees Celsius until the first conversion completes 28 ms 
+ * after creation, conversions repeat at the idle register sampling period and stop 
+ * in shutdown.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_pct2075_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the temperature measured by a PCT2075 model.
+ * 
+ * @param model PCT2075 model.
+ * @param temperature Temperature in degrees Celsius (-55 to 125).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_pct2075_set_temperature(i2c_sim_model_t *const model, const float temperature);
+
+/**
+ * @brief Creates a MLX90614 infrared thermometer model.  Words carry the SMBus packet 
+ * error code for the default address, a write with a bad packet error code is not 
+ * acknowledged.  An EEPROM write takes the 5 ms erase or write cell time, EEPROM 
+ * accesses are not acknowledged until the cycle completes.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_mlx90614_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the temperatures measured by a MLX90614 model, both object channels 
+ * report the object temperature.
+ * 
+ * @param model MLX90614 model.
+ * @param ambient_temperature Ambient temperature in degrees Celsius (-40 to 125).
+ * @param object_temperature Object temperature in degrees Celsius (-70 to 380).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_mlx90614_set_temperatures(i2c_sim_model_t *const model, const float ambient_temperature, const float object_temperature);
+
+/**
+ * @brief Gets the number of EEPROM erase and write cycles started on a MLX90614 model.
+ * 
+ * @param model MLX90614 model.
+ * @param[out] writes EEPROM erase and write cycles.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_mlx90614_get_eeprom_writes(i2c_sim_model_t *const model, uint32_t *const writes);
+
+/**
+ * @brief Creates a MPU6050 motion sensor model.  Samples are generated at the 
+ * sample rate with the data ready interrupt status and the FIFO.  An acceleration 
+ * step above the motion threshold sets the motion interrupt status when enabled.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_mpu6050_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the motion measured by a MPU6050 model.
+ * 
+ * @param model MPU6050 model.
+ * @param accel Acceleration of the x, y and z axes in g.
+ * @param gyro Angular rate of the x, y and z axes in degrees per second.
+ * @param temperature Temperature in degrees Celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_mpu6050_set_motion(i2c_sim_model_t *const model, const float accel[3], const float gyro[3], const float temperature);
+
+/**
+ * @brief Creates a MAX30105 particle sensor model.  Samples are written to the 
+ * 32-sample FIFO at the sample rate and averaging with the active LED slots, a 
+ * full FIFO counts lost samples and rolls over when enabled.
+ * 
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_max30105_create(i2c_sim_model_t **const model);
+
+/**
+ * @brief Sets the ADC counts measured by a MAX30105 model.  The model adds the sample 
+ * number to the counts, so consecutive samples ramp by one count.
+ * 
+ * @param model MAX30105 model.
+ * @param red Red LED ADC count.
+ * @param ir IR LED ADC count.
+ * @param green Green LED ADC count.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_max30105_set_counts(i2c_sim_model_t *const model, const uint32_t red, const uint32_t ir, const uint32_t green);
+
+/**
+ * @brief Creates a SSD1306 display controller model with 128 columns.
+ * 
+ * @param height Display height in pixels, 32 or 64.
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ssd1306_create(const uint8_t height, i2c_sim_model_t **const model);
+
+/**
+ * @brief Gets a copy of the display RAM of the visible pages of a SSD1306 model, page by page.
+ * 
+ * @param model SSD1306 model.
+ * @param[out] buffer Buffer for the display RAM.
+ * @param size Buffer size, at most 128 bytes per visible page are copied.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ssd1306_get_ram(i2c_sim_model_t *const model, uint8_t *const buffer, const size_t size);
+
+/**
+ * @brief Gets the display on state of a SSD1306 model.
+ * 
+ * @param model SSD1306 model.
+ * @param[out] display_on Display is on when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_ssd1306_get_display_on(i2c_sim_model_t *const model, bool *const display_on);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_SIM_MODELS_H__
@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file rmt_sim.h
+ * @defgroup drivers rmt_sim
+ * @{
+ *
+ * Host RMT simulator for the ESP-IDF RMT backed drivers, i.e. the 1-wire bus
+ *
+ * The `shim/driver/rmt_*.h` headers replace the RMT TX and RX channel and
+ * encoder API.  A transmission is encoded into the master waveform of the
+ * channel GPIO, a line model adds the levels driven by the devices on the
+ * line, and a pending receive on the same GPIO records the line as RMT
+ * symbols from its first edge until the line idles longer than the receive
+ * signal range, the done callback is called before `rmt_transmit` returns.
+ * Without a line model the line follows the master waveform.  Each
+ * transmission advances the simulation virtual time by its duration, the
+ * transmit done callback is called at the end of the last symbol before
+ * `rmt_transmit` returns.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __RMT_SIM_H__
+#define __RMT_SIM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <driver/rmt_tx.h>
+#include <driver/rmt_rx.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RMT simulator line level structure, a level held for a duration.
+ */
+typedef struct rmt_sim_level_s {
+    uint8_t     level;          /*!< rmt simulator, line level, 0 or 1 */
+    uint32_t    duration_us;    /*!< rmt simulator, level duration in microseconds */
+} rmt_sim_level_t;
+
+/**
+ * @brief RMT simulator statistics structure.
+ */
+typedef struct rmt_sim_stats_s {
+    uint32_t    transmits;              /*!< rmt simulator, transmissions */
+    uint32_t    receives;               /*!< rmt simulator, completed receives */
+    uint64_t    symbols_sent;           /*!< rmt simulator, symbols transmitted */
+    uint64_t    symbols_received;       /*!< rmt simulator, symbols recorded by receives */
+    uint32_t    rx_overflows;           /*!< rmt simulator, receives truncated by the receive buffer */
+    size_t      tx_mem_block_symbols;   /*!< rmt simulator, memory block symbols requested by the tx channels */
+    size_t      rx_mem_block_symbols;   /*!< rmt simulator, memory block symbols requested by the rx channels */
+} rmt_sim_stats_t;
+
+/**
+ * @brief Line model, returns the line levels of a transmission from the master waveform, i.e. the master
+ * waveform with the levels pulled low by the devices.  The line levels must span the master waveform.
+ * 
+ * @param context Line model context.
+ * @param master Master waveform levels.
+ * @param master_count Number of master waveform levels.
+ * @param line Line levels.
+ * @param line_size Size of the line levels array.
+ * @return size_t Number of line levels.
+ */
+typedef size_t (*rmt_sim_line_model_t)(void *const context, const rmt_sim_level_t *const master, const size_t master_count, 
+                                       rmt_sim_level_t *const line, const size_t line_size);
+
+/**
+ * @brief Sets the line model of the simulated RMT channels, NULL to follow the master waveform.
+ * 
+ * @param model Line model.
+ * @param context Line model context.
+ */
+void rmt_sim_set_line_model(rmt_sim_line_model_t model, void *const context);
+
+/**
+ * @brief Gets the RMT simulator statistics.
+ */
+void rmt_sim_get_stats(rmt_sim_stats_t *const stats);
+
+/**
+ * @brief Clears the RMT simulator statistics, the channel memory block symbols are kept.
+ */
+void rmt_sim_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __RMT_SIM_H__
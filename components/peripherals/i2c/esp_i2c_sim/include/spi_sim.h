@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file spi_sim.h
+ * @defgroup drivers spi_sim
+ * @{
+ *
+ * Host SPI simulator for the ESP-IDF SPI master drivers, i.e. the max31865
+ *
+ * The `shim/driver/spi_*.h` headers replace the SPI master device API.  A 
+ * device added to a host with `spi_bus_add_device` is routed to the device 
+ * model attached to the host and CS gpio, the model receives the command, 
+ * address and data phase of each transaction.  A transaction advances the 
+ * simulation virtual time by its bit count at the device clock speed.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __SPI_SIM_H__
+#define __SPI_SIM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include <driver/spi_master.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SPI simulator definitions
+*/
+#define SPI_SIM_DEFAULT_CLOCK_SPEED_HZ  (1000000)   //!< spi simulator, clock speed when the device configuration speed is 0
+
+/*
+ * SPI simulator enumerator and structure declarations
+*/
+
+/**
+ * @brief SPI simulator device model transfer function signature.  Called with the command and address 
+ * of a transaction and the data phase buffers, a buffer is NULL when the transaction does not 
+ * write or read data.  A non ESP_OK return fails the transaction.
+ */
+typedef esp_err_t (*spi_sim_model_transfer_t)(void *context, const spi_device_interface_config_t *config, const uint16_t command,
+                                              const uint64_t address, const uint8_t *tx_buffer, uint8_t *rx_buffer, const size_t size);
+
+/**
+ * @brief SPI simulator device model destroy function signature, releases the context.
+ */
+typedef void (*spi_sim_model_destroy_t)(void *context);
+
+/**
+ * @brief SPI simulator device model structure.  The simulation lock is not held during callbacks, a 
+ * model shared with a gpio line update guards its state.
+ */
+typedef struct spi_sim_model_s {
+    const char*                 name;       /*!< spi simulator model, device name used in logs */
+    void*                       context;    /*!< spi simulator model, device state passed to the callbacks */
+    spi_sim_model_transfer_t    transfer;   /*!< spi simulator model, transaction callback */
+    spi_sim_model_destroy_t     destroy;    /*!< spi simulator model, context release callback, optional */
+} spi_sim_model_t;
+
+/**
+ * @brief SPI simulator statistics structure.
+ */
+typedef struct spi_sim_stats_s {
+    uint32_t                    transactions;   /*!< spi simulator, transactions */
+    uint64_t                    bytes_written;  /*!< spi simulator, data phase bytes written */
+    uint64_t                    bytes_read;     /*!< spi simulator, data phase bytes read */
+    uint64_t                    bus_time_us;    /*!< spi simulator, simulated bus time in microseconds */
+} spi_sim_stats_t;
+
+/**
+ * @brief Attaches a device model to a simulated SPI host and CS gpio.  The simulator owns 
+ * the model and destroys it when the device is removed.
+ * 
+ * @param host SPI host of the simulated bus.
+ * @param cs_io_num CS gpio number of the device.
+ * @param model Device model.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the CS gpio is in use.
+ */
+esp_err_t spi_sim_add_device(const spi_host_device_t host, const int cs_io_num, spi_sim_model_t *const model);
+
+/**
+ * @brief Detaches and destroys the device model of a simulated SPI host and CS gpio.
+ * 
+ * @param host SPI host of the simulated bus.
+ * @param cs_io_num CS gpio number of the device.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when no model is attached.
+ */
+esp_err_t spi_sim_remove_device(const spi_host_device_t host, const int cs_io_num);
+
+/**
+ * @brief Gets the SPI simulator statistics.
+ */
+void spi_sim_get_stats(spi_sim_stats_t *const stats);
+
+/**
+ * @brief Clears the SPI simulator statistics.
+ */
+void spi_sim_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif // __SPI_SIM_H__
@@ -0,0 +1,173 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_ahtxx.c
+ *
+ * AHTxx temperature and humidity sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * AHTxx model definitions
+*/
+#define AHTXX_SIM_CMD_AHT10_INIT        UINT8_C(0xE1)
+#define AHTXX_SIM_CMD_AHT20_INIT        UINT8_C(0xBE)
+#define AHTXX_SIM_CMD_STATUS            UINT8_C(0x71)
+#define AHTXX_SIM_CMD_TRIGGER_MEAS      UINT8_C(0xAC)
+#define AHTXX_SIM_CMD_RESET             UINT8_C(0xBA)
+#define AHTXX_SIM_REG_1B                UINT8_C(0x1B)
+#define AHTXX_SIM_REG_1C                UINT8_C(0x1C)
+#define AHTXX_SIM_REG_1E                UINT8_C(0x1E)
+#define AHTXX_SIM_REG_WRITE             UINT8_C(0xB0)       //!< ahtxx model, initialization register write command prefix
+#define AHTXX_SIM_STATUS_WORD           UINT8_C(0x18)       //!< ahtxx model, status of an initialized and calibrated sensor
+#define AHTXX_SIM_STATUS_BUSY           UINT8_C(0x80)
+#define AHTXX_SIM_STATUS_CALIBRATED     UINT8_C(0x08)
+#define AHTXX_SIM_MEAS_US               UINT32_C(80000)     //!< ahtxx model, measurement time after a trigger command
+#define AHTXX_SIM_RESET_US              UINT32_C(20000)     //!< ahtxx model, soft reset time
+
+/**
+ * @brief AHTxx model context structure definition.
+ */
+typedef struct ahtxx_sim_context_s {
+    uint8_t                     status;         /*!< ahtxx model, status byte without the busy bit */
+    int64_t                     ready_time;     /*!< ahtxx model, virtual time the measurement or reset completes */
+    uint8_t                     data[5];        /*!< ahtxx model, humidity and temperature signals of the last measurement */
+    uint8_t                     init_regs[3][2];/*!< ahtxx model, initialization registers 0x1b, 0x1c and 0x1e */
+    int8_t                      init_read;      /*!< ahtxx model, index of the initialization register returned by the next read, -1 for none */
+    float                       temperature;    /*!< ahtxx model, temperature input in degrees Celsius */
+    float                       humidity;       /*!< ahtxx model, relative humidity input in percent */
+} ahtxx_sim_context_t;
+
+/**
+ * @brief Gets the index of an initialization register, -1 when the address is not one.
+ */
+static inline int8_t ahtxx_sim_get_init_index(const uint8_t reg) {
+    switch (reg) {
+        case AHTXX_SIM_REG_1B: return 0;
+        case AHTXX_SIM_REG_1C: return 1;
+        case AHTXX_SIM_REG_1E: return 2;
+        default:               return -1;
+    }
+}
+
+/**
+ * @brief Converts the inputs to 20-bit signals, see datasheet section 6.
+ */
+static inline void ahtxx_sim_measure(ahtxx_sim_context_t *const ctx) {
+    const uint32_t humidity_sig    = (uint32_t)fmin(fmax(lround((double)ctx->humidity / 100.0 * 1048576.0), 0), 0xfffff);
+    const uint32_t temperature_sig = (uint32_t)fmin(fmax(lround(((double)ctx->temperature + 50.0) / 200.0 * 1048576.0), 0), 0xfffff);
+
+    ctx->data[0] = (uint8_t)(humidity_sig >> 12);
+    ctx->data[1] = (uint8_t)(humidity_sig >> 4);
+    ctx->data[2] = (uint8_t)(((humidity_sig & 0x0f) << 4) | (temperature_sig >> 16));
+    ctx->data[3] = (uint8_t)(temperature_sig >> 8);
+    ctx->data[4] = (uint8_t)(temperature_sig & 0xff);
+}
+
+static esp_err_t ahtxx_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    ahtxx_sim_context_t *ctx = (ahtxx_sim_context_t*)context;
+    const int64_t now = i2c_sim_get_time_us();
+    const int8_t init_index = ahtxx_sim_get_init_index(buffer[0] & (uint8_t)~AHTXX_SIM_REG_WRITE);
+
+    ctx->init_read = -1;
+
+    if (buffer[0] == AHTXX_SIM_CMD_TRIGGER_MEAS) {
+        ahtxx_sim_measure(ctx);
+        ctx->ready_time = now + AHTXX_SIM_MEAS_US;
+    } else if (buffer[0] == AHTXX_SIM_CMD_AHT10_INIT || buffer[0] == AHTXX_SIM_CMD_AHT20_INIT) {
+        ctx->status |= AHTXX_SIM_STATUS_CALIBRATED;
+    } else if (buffer[0] == AHTXX_SIM_CMD_RESET) {
+        ctx->status     = AHTXX_SIM_STATUS_WORD;
+        ctx->ready_time = now + AHTXX_SIM_RESET_US;
+    } else if (buffer[0] == AHTXX_SIM_CMD_STATUS) {
+        /* the next read returns the status byte */
+    } else if (init_index >= 0 && (buffer[0] & AHTXX_SIM_REG_WRITE) == AHTXX_SIM_REG_WRITE) {
+        /* initialization register write, the data follows the command */
+        if (size >= 3) {
+            ctx->init_regs[init_index][0] = buffer[1];
+            ctx->init_regs[init_index][1] = buffer[2];
+        }
+    } else if (init_index >= 0) {
+        /* initialization register read, the next read returns the register */
+        ctx->init_read = init_index;
+    } else {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t ahtxx_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    ahtxx_sim_context_t *ctx = (ahtxx_sim_context_t*)context;
+    uint8_t frame[7] = { ctx->status };
+
+    if (i2c_sim_get_time_us() < ctx->ready_time) frame[0] |= AHTXX_SIM_STATUS_BUSY;
+
+    if (ctx->init_read >= 0) {
+        frame[1] = ctx->init_regs[ctx->init_read][0];
+        frame[2] = ctx->init_regs[ctx->init_read][1];
+    } else {
+        memcpy(&frame[1], ctx->data, sizeof(ctx->data));
+    }
+    frame[6] = i2c_sim_model_crc8(frame, 6);
+
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < sizeof(frame)) ? frame[i] : 0xff;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ahtxx_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("ahtxx", sizeof(ahtxx_sim_context_t), ahtxx_sim_write, ahtxx_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    ahtxx_sim_context_t *ctx = (ahtxx_sim_context_t*)(*model)->context;
+
+    ctx->status      = AHTXX_SIM_STATUS_WORD;
+    ctx->init_read   = -1;
+    ctx->temperature = 25.0f;
+    ctx->humidity    = 50.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ahtxx_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity) {
+    ahtxx_sim_context_t *ctx = (ahtxx_sim_context_t*)i2c_sim_model_get_context(model, ahtxx_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -40.0f && temperature <= 85.0f && humidity >= 0.0f && humidity <= 100.0f );
+
+    ctx->temperature = temperature;
+    ctx->humidity    = humidity;
+
+    return ESP_OK;
+}
@@ -0,0 +1,295 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_bmp280.c
+ *
+ * BMP280 pressure and temperature sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * BMP280 model definitions
+*/
+#define BMP280_SIM_REG_CALIB            UINT8_C(0x88)
+#define BMP280_SIM_REG_ID               UINT8_C(0xD0)
+#define BMP280_SIM_REG_RESET            UINT8_C(0xE0)
+#define BMP280_SIM_REG_STATUS           UINT8_C(0xF3)
+#define BMP280_SIM_REG_CTRL             UINT8_C(0xF4)
+#define BMP280_SIM_REG_CONFIG           UINT8_C(0xF5)
+#define BMP280_SIM_REG_PRESS_MSB        UINT8_C(0xF7)
+#define BMP280_SIM_REG_TEMP_MSB         UINT8_C(0xFA)
+#define BMP280_SIM_CHIP_ID              UINT8_C(0x58)
+#define BMP280_SIM_RESET_VALUE          UINT8_C(0xB6)
+#define BMP280_SIM_STATUS_MEASURING     UINT8_C(0x08)
+#define BMP280_SIM_STATUS_IM_UPDATE     UINT8_C(0x01)
+#define BMP280_SIM_ADC_SKIPPED          UINT32_C(0x80000)   //!< bmp280 model, adc value of a skipped measurement
+#define BMP280_SIM_ADC_MAX              UINT32_C(0xFFFFF)
+#define BMP280_SIM_NVM_COPY_US          UINT32_C(2000)      //!< bmp280 model, start-up time of the NVM copy after reset
+#define BMP280_SIM_MEAS_BASE_US         UINT32_C(1250)
+#define BMP280_SIM_MEAS_SAMPLE_US       UINT32_C(2300)
+#define BMP280_SIM_MEAS_PRESS_US        UINT32_C(575)
+
+/**
+ * @brief BMP280 model calibration structure definition, the datasheet section 8.2 example.
+ */
+typedef struct bmp280_sim_calibration_s {
+    uint16_t    T1;
+    int16_t     T2, T3;
+    uint16_t    P1;
+    int16_t     P2, P3, P4, P5, P6, P7, P8, P9;
+} bmp280_sim_calibration_t;
+
+/**
+ * @brief BMP280 model context structure definition.
+ */
+typedef struct bmp280_sim_context_s {
+    uint8_t                     regs[256];          /*!< bmp280 model, register file */
+    uint8_t                     pointer;            /*!< bmp280 model, register pointer */
+    int64_t                     nvm_ready_time;     /*!< bmp280 model, virtual time the NVM copy completes */
+    int64_t                     meas_start_time;    /*!< bmp280 model, virtual time the forced conversion or normal mode started */
+    bool                        measured;           /*!< bmp280 model, data registers hold the latest conversion */
+    float                       temperature;        /*!< bmp280 model, temperature input in degrees Celsius */
+    float                       pressure;           /*!< bmp280 model, pressure input in pascal */
+} bmp280_sim_context_t;
+
+/*
+ * static constant declarations
+*/
+static const bmp280_sim_calibration_t bmp280_sim_calibration = {
+    .T1 = 27504, .T2 = 26435, .T3 = -1000,
+    .P1 = 36477, .P2 = -10685, .P3 = 3024, .P4 = 2855, .P5 = 140, .P6 = -7, .P7 = 15500, .P8 = -14600, .P9 = 6000
+};
+
+/* standby time in microseconds for config register t_sb, see datasheet table 11 */
+static const uint32_t bmp280_sim_standby_us[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+
+/**
+ * @brief Gets the number of samples for an oversampling setting, 0 is skipped.
+ */
+static inline uint32_t bmp280_sim_get_samples(const uint8_t oversampling) {
+    return (oversampling == 0) ? 0 : (1u << ((oversampling > 5 ? 5 : oversampling) - 1));
+}
+
+/**
+ * @brief Gets the maximum measurement time of the control measurement register settings.
+ */
+static inline uint32_t bmp280_sim_get_meas_time(const uint8_t ctrl_meas) {
+    const uint32_t osrs_t = bmp280_sim_get_samples((ctrl_meas >> 5) & 0x07);
+    const uint32_t osrs_p = bmp280_sim_get_samples((ctrl_meas >> 2) & 0x07);
+    uint32_t time_us = BMP280_SIM_MEAS_BASE_US + BMP280_SIM_MEAS_SAMPLE_US * osrs_t;
+
+    if (osrs_p) time_us += BMP280_SIM_MEAS_SAMPLE_US * osrs_p + BMP280_SIM_MEAS_PRESS_US;
+
+    return time_us;
+}
+
+/**
+ * @brief Converts an adc temperature to t_fine with the datasheet floating point compensation.
+ */
+static double bmp280_sim_convert_t_fine(const void *context, uint32_t adc) {
+    const bmp280_sim_calibration_t *cal = &bmp280_sim_calibration;
+    const double var1 = ((double)adc / 16384.0 - (double)cal->T1 / 1024.0) * (double)cal->T2;
+    const double var2 = ((double)adc / 131072.0 - (double)cal->T1 / 8192.0) * ((double)adc / 131072.0 - (double)cal->T1 / 8192.0) * (double)cal->T3;
+
+    return var1 + var2;
+}
+
+/**
+ * @brief Converts an adc pressure to pascal with the datasheet floating point compensation, 
+ * the context is t_fine.
+ */
+static double bmp280_sim_convert_pressure(const void *context, uint32_t adc) {
+    const bmp280_sim_calibration_t *cal = &bmp280_sim_calibration;
+    const double t_fine = *(const double*)context;
+    double var1 = t_fine / 2.0 - 64000.0;
+    double var2 = var1 * var1 * (double)cal->P6 / 32768.0;
+
+    var2 = var2 + var1 * (double)cal->P5 * 2.0;
+    var2 = var2 / 4.0 + (double)cal->P4 * 65536.0;
+    var1 = ((double)cal->P3 * var1 * var1 / 524288.0 + (double)cal->P2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * (double)cal->P1;
+    if (var1 == 0.0) return 0.0;
+
+    double p = 1048576.0 - (double)adc;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = (double)cal->P9 * p * p / 2147483648.0;
+    var2 = p * (double)cal->P8 / 32768.0;
+
+    return p + (var1 + var2 + (double)cal->P7) / 16.0;
+}
+
+/**
+ * @brief Stores a 20-bit adc value in a msb, lsb and xlsb register triple.
+ */
+static inline void bmp280_sim_set_adc(uint8_t *const regs, const uint32_t adc) {
+    regs[0] = (uint8_t)(adc >> 12);
+    regs[1] = (uint8_t)(adc >> 4);
+    regs[2] = (uint8_t)((adc & 0x0f) << 4);
+}
+
+/**
+ * @brief Converts the inputs into the data registers for the oversampling settings.
+ */
+static inline void bmp280_sim_convert(bmp280_sim_context_t *const ctx) {
+    const uint8_t ctrl_meas = ctx->regs[BMP280_SIM_REG_CTRL];
+    const uint32_t adc_t = i2c_sim_model_bisect(bmp280_sim_convert_t_fine, NULL, 0, BMP280_SIM_ADC_MAX, (double)ctx->temperature * 5120.0);
+    const double t_fine = bmp280_sim_convert_t_fine(NULL, adc_t);
+    const uint32_t adc_p = i2c_sim_model_bisect(bmp280_sim_convert_pressure, &t_fine, 0, BMP280_SIM_ADC_MAX, (double)ctx->pressure);
+
+    bmp280_sim_set_adc(&ctx->regs[BMP280_SIM_REG_TEMP_MSB], ((ctrl_meas >> 5) & 0x07) ? adc_t : BMP280_SIM_ADC_SKIPPED);
+    bmp280_sim_set_adc(&ctx->regs[BMP280_SIM_REG_PRESS_MSB], ((ctrl_meas >> 2) & 0x07) ? adc_p : BMP280_SIM_ADC_SKIPPED);
+    ctx->measured = true;
+}
+
+/**
+ * @brief Advances the conversion state to the current virtual time and updates the status register.
+ */
+static inline void bmp280_sim_update(bmp280_sim_context_t *const ctx) {
+    const int64_t now = i2c_sim_get_time_us();
+    const uint8_t ctrl_meas = ctx->regs[BMP280_SIM_REG_CTRL];
+    const uint8_t mode = ctrl_meas & 0x03;
+    const int64_t meas_time = bmp280_sim_get_meas_time(ctrl_meas);
+    uint8_t status = 0;
+
+    if (now < ctx->nvm_ready_time) status |= BMP280_SIM_STATUS_IM_UPDATE;
+
+    if (mode == 0x01 || mode == 0x02) {
+        /* forced mode returns to sleep once the conversion completes */
+        if (now - ctx->meas_start_time >= meas_time) {
+            bmp280_sim_convert(ctx);
+            ctx->regs[BMP280_SIM_REG_CTRL] &= (uint8_t)~0x03;
+        } else {
+            status |= BMP280_SIM_STATUS_MEASURING;
+        }
+    } else if (mode == 0x03) {
+        /* normal mode cycles between a conversion and the standby time */
+        const int64_t period = meas_time + bmp280_sim_standby_us[(ctx->regs[BMP280_SIM_REG_CONFIG] >> 5) & 0x07];
+        const int64_t elapsed = now - ctx->meas_start_time;
+
+        if (elapsed >= meas_time) bmp280_sim_convert(ctx);
+        if (elapsed % period < meas_time) status |= BMP280_SIM_STATUS_MEASURING;
+    }
+
+    ctx->regs[BMP280_SIM_REG_STATUS] = status;
+}
+
+/**
+ * @brief Restores the power-on register state.
+ */
+static inline void bmp280_sim_reset(bmp280_sim_context_t *const ctx) {
+    const bmp280_sim_calibration_t *cal = &bmp280_sim_calibration;
+    const uint16_t words[12] = { cal->T1, (uint16_t)cal->T2, (uint16_t)cal->T3, cal->P1, (uint16_t)cal->P2, (uint16_t)cal->P3,
+                                 (uint16_t)cal->P4, (uint16_t)cal->P5, (uint16_t)cal->P6, (uint16_t)cal->P7, (uint16_t)cal->P8, (uint16_t)cal->P9 };
+
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+
+    /* calibration words are little-endian */
+    for (uint8_t i = 0; i < 12; i++) {
+        ctx->regs[BMP280_SIM_REG_CALIB + i * 2]     = (uint8_t)(words[i] & 0xff);
+        ctx->regs[BMP280_SIM_REG_CALIB + i * 2 + 1] = (uint8_t)(words[i] >> 8);
+    }
+
+    ctx->regs[BMP280_SIM_REG_ID] = BMP280_SIM_CHIP_ID;
+    bmp280_sim_set_adc(&ctx->regs[BMP280_SIM_REG_PRESS_MSB], BMP280_SIM_ADC_SKIPPED);
+    bmp280_sim_set_adc(&ctx->regs[BMP280_SIM_REG_TEMP_MSB], BMP280_SIM_ADC_SKIPPED);
+    ctx->nvm_ready_time = i2c_sim_get_time_us() + BMP280_SIM_NVM_COPY_US;
+    ctx->measured       = false;
+}
+
+static esp_err_t bmp280_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    bmp280_sim_context_t *ctx = (bmp280_sim_context_t*)context;
+
+    bmp280_sim_update(ctx);
+
+    /* first byte is the register pointer, writes are register address and data pairs, see datasheet section 5.2.1 */
+    ctx->pointer = buffer[0];
+    for (size_t i = 1; i < size; i += 2) {
+        ctx->pointer = buffer[i - 1];
+        switch (ctx->pointer) {
+            case BMP280_SIM_REG_RESET:
+                if (buffer[i] == BMP280_SIM_RESET_VALUE) bmp280_sim_reset(ctx);
+                break;
+            case BMP280_SIM_REG_CTRL:
+                ctx->regs[BMP280_SIM_REG_CTRL] = buffer[i];
+                ctx->meas_start_time = i2c_sim_get_time_us();
+                break;
+            case BMP280_SIM_REG_CONFIG:
+            case 0xF2:
+                ctx->regs[ctx->pointer] = buffer[i];
+                break;
+            default:
+                /* read-only registers ignore writes */
+                break;
+        }
+    }
+
+    bmp280_sim_update(ctx);
+
+    return ESP_OK;
+}
+
+static esp_err_t bmp280_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    bmp280_sim_context_t *ctx = (bmp280_sim_context_t*)context;
+
+    bmp280_sim_update(ctx);
+
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = ctx->regs[ctx->pointer++];
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_bmp280_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("bmp280", sizeof(bmp280_sim_context_t), bmp280_sim_write, bmp280_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    bmp280_sim_context_t *ctx = (bmp280_sim_context_t*)(*model)->context;
+
+    bmp280_sim_reset(ctx);
+    ctx->nvm_ready_time = 0;
+    ctx->temperature    = 25.0f;
+    ctx->pressure       = 101325.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_bmp280_set_environment(i2c_sim_model_t *const model, const float temperature, const float pressure) {
+    bmp280_sim_context_t *ctx = (bmp280_sim_context_t*)i2c_sim_model_get_context(model, bmp280_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -40.0f && temperature <= 85.0f && pressure >= 30000.0f && pressure <= 110000.0f );
+
+    ctx->temperature = temperature;
+    ctx->pressure    = pressure;
+
+    return ESP_OK;
+}
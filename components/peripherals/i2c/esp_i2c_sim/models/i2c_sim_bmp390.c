@@ -0,0 +1,486 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_bmp390.c
+ *
+ * BMP390 pressure and temperature sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * BMP390 model definitions
+*/
+#define BMP390_SIM_REG_CHIP_ID          UINT8_C(0x00)
+#define BMP390_SIM_REG_STATUS           UINT8_C(0x03)
+#define BMP390_SIM_REG_PRESS_XLSB       UINT8_C(0x04)
+#define BMP390_SIM_REG_TEMP_XLSB        UINT8_C(0x07)
+#define BMP390_SIM_REG_TEMP_MSB         UINT8_C(0x09)
+#define BMP390_SIM_REG_SNRTIME_XLSB     UINT8_C(0x0C)
+#define BMP390_SIM_REG_EVENT            UINT8_C(0x10)
+#define BMP390_SIM_REG_INT_STATUS       UINT8_C(0x11)
+#define BMP390_SIM_REG_FIFO_LENGTH_0    UINT8_C(0x12)
+#define BMP390_SIM_REG_FIFO_LENGTH_1    UINT8_C(0x13)
+#define BMP390_SIM_REG_FIFO_DATA        UINT8_C(0x14)
+#define BMP390_SIM_REG_FIFO_WTM_0       UINT8_C(0x15)
+#define BMP390_SIM_REG_FIFO_WTM_1       UINT8_C(0x16)
+#define BMP390_SIM_REG_FIFO_CONFIG_1    UINT8_C(0x17)
+#define BMP390_SIM_REG_FIFO_CONFIG_2    UINT8_C(0x18)
+#define BMP390_SIM_REG_INT_CTRL         UINT8_C(0x19)
+#define BMP390_SIM_REG_PWR_CTRL         UINT8_C(0x1B)
+#define BMP390_SIM_REG_OSR              UINT8_C(0x1C)
+#define BMP390_SIM_REG_ODR              UINT8_C(0x1D)
+#define BMP390_SIM_REG_CONFIG           UINT8_C(0x1F)
+#define BMP390_SIM_REG_NVM              UINT8_C(0x31)
+#define BMP390_SIM_REG_CMD              UINT8_C(0x7E)
+#define BMP390_SIM_CHIP_ID              UINT8_C(0x60)
+#define BMP390_SIM_CMD_SOFT_RESET       UINT8_C(0xB6)
+#define BMP390_SIM_CMD_FIFO_FLUSH       UINT8_C(0xB0)
+#define BMP390_SIM_STATUS_CMD_RDY       UINT8_C(0x10)
+#define BMP390_SIM_STATUS_DRDY_PRESS    UINT8_C(0x20)
+#define BMP390_SIM_STATUS_DRDY_TEMP     UINT8_C(0x40)
+#define BMP390_SIM_INT_FWM              UINT8_C(0x01)
+#define BMP390_SIM_INT_FFULL            UINT8_C(0x02)
+#define BMP390_SIM_INT_DRDY             UINT8_C(0x08)
+#define BMP390_SIM_FIFO_SIZE            UINT16_C(512)
+#define BMP390_SIM_FIFO_PRESS_TEMP      UINT8_C(0x94)
+#define BMP390_SIM_FIFO_TEMP            UINT8_C(0x90)
+#define BMP390_SIM_FIFO_PRESS           UINT8_C(0x84)
+#define BMP390_SIM_FIFO_TIME            UINT8_C(0xA0)
+#define BMP390_SIM_FIFO_EMPTY           UINT8_C(0x80)
+#define BMP390_SIM_FIFO_CONFIG_CHG      UINT8_C(0x48)
+#define BMP390_SIM_ADC_MAX              UINT32_C(0xFFFFFF)
+#define BMP390_SIM_ODR_BASE_US          UINT32_C(5000)      //!< bmp390 model, sampling period of odr_sel 0
+#define BMP390_SIM_PENDING_MAX          UINT32_C(128)       //!< bmp390 model, most normal mode samples replayed into the FIFO at once
+
+/**
+ * @brief BMP390 model NVM calibration structure definition.
+ */
+typedef struct bmp390_sim_calibration_s {
+    uint16_t    T1, T2;
+    int8_t      T3;
+    int16_t     P1, P2;
+    int8_t      P3, P4;
+    uint16_t    P5, P6;
+    int8_t      P7, P8;
+    int16_t     P9;
+    int8_t      P10, P11;
+} bmp390_sim_calibration_t;
+
+/**
+ * @brief BMP390 model context structure definition.
+ */
+typedef struct bmp390_sim_context_s {
+    uint8_t                     regs[128];          /*!< bmp390 model, register file */
+    uint8_t                     pointer;            /*!< bmp390 model, register pointer */
+    int64_t                     meas_start_time;    /*!< bmp390 model, virtual time the forced conversion or normal mode started */
+    uint32_t                    samples;            /*!< bmp390 model, normal mode samples completed since the start time */
+    uint8_t                     fifo[BMP390_SIM_FIFO_SIZE]; /*!< bmp390 model, FIFO frames */
+    uint16_t                    fifo_length;        /*!< bmp390 model, FIFO fill level in bytes */
+    uint16_t                    fifo_index;         /*!< bmp390 model, FIFO read index in bytes */
+    uint8_t                     fifo_time[4];       /*!< bmp390 model, sensor time frame returned after the last frame */
+    uint8_t                     fifo_time_index;    /*!< bmp390 model, sensor time frame read index */
+    float                       temperature;        /*!< bmp390 model, temperature input in degrees Celsius */
+    float                       pressure;           /*!< bmp390 model, pressure input in pascal */
+} bmp390_sim_context_t;
+
+/*
+ * static constant declarations
+*/
+static const bmp390_sim_calibration_t bmp390_sim_calibration = {
+    .T1 = 27474, .T2 = 19367, .T3 = -7,
+    .P1 = 1193, .P2 = -3018, .P3 = 35, .P4 = 0, .P5 = 25218, .P6 = 30180, .P7 = 3, .P8 = -6, .P9 = 15844, .P10 = 7, .P11 = -60
+};
+
+/**
+ * @brief Converts an adc temperature to degrees Celsius with the datasheet floating point compensation.
+ */
+static double bmp390_sim_convert_temperature(const void *context, uint32_t adc) {
+    const bmp390_sim_calibration_t *cal = &bmp390_sim_calibration;
+    const double partial1 = (double)adc - (double)cal->T1 * 256.0;
+    const double partial2 = partial1 * ((double)cal->T2 / 1073741824.0);
+
+    return partial2 + partial1 * partial1 * ((double)cal->T3 / 281474976710656.0);
+}
+
+/**
+ * @brief Converts an adc pressure to pascal with the datasheet floating point compensation, 
+ * the context is the compensated temperature.
+ */
+static double bmp390_sim_convert_pressure(const void *context, uint32_t adc) {
+    const bmp390_sim_calibration_t *cal = &bmp390_sim_calibration;
+    const double t = *(const double*)context;
+    const double p  = (double)adc;
+    const double p1 = ((double)cal->P1 - 16384.0) / 1048576.0;
+    const double p2 = ((double)cal->P2 - 16384.0) / 536870912.0;
+    const double p3 = (double)cal->P3 / 4294967296.0;
+    const double p4 = (double)cal->P4 / 137438953472.0;
+    const double p5 = (double)cal->P5 * 8.0;
+    const double p6 = (double)cal->P6 / 64.0;
+    const double p7 = (double)cal->P7 / 256.0;
+    const double p8 = (double)cal->P8 / 32768.0;
+    const double p9 = (double)cal->P9 / 281474976710656.0;
+    const double p10 = (double)cal->P10 / 281474976710656.0;
+    const double p11 = (double)cal->P11 / 36893488147419103232.0;
+    const double out1 = p5 + p6 * t + p7 * t * t + p8 * t * t * t;
+    const double out2 = p * (p1 + p2 * t + p3 * t * t + p4 * t * t * t);
+
+    return out1 + out2 + p * p * (p9 + p10 * t) + p * p * p * p11;
+}
+
+/**
+ * @brief Gets the conversion time of the power control and oversampling settings, see datasheet section 3.9.2.
+ */
+static inline uint32_t bmp390_sim_get_conv_time(const bmp390_sim_context_t *const ctx) {
+    const uint8_t pwr_ctrl = ctx->regs[BMP390_SIM_REG_PWR_CTRL];
+    const uint8_t osr      = ctx->regs[BMP390_SIM_REG_OSR];
+    uint32_t time_us = 234;
+
+    if (pwr_ctrl & 0x01) time_us += 392 + (1u << (osr & 0x07)) * 2020;
+    if (pwr_ctrl & 0x02) time_us += 163 + (1u << ((osr >> 3) & 0x07)) * 2020;
+
+    return time_us;
+}
+
+/**
+ * @brief Stores a 24-bit little-endian value.
+ */
+static inline void bmp390_sim_set_u24(uint8_t *const buffer, const uint32_t value) {
+    buffer[0] = (uint8_t)(value & 0xff);
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+}
+
+/**
+ * @brief Gets the 24-bit sensor time at 25.6 kHz for the virtual time.
+ */
+static inline uint32_t bmp390_sim_get_sensor_time(void) {
+    return (uint32_t)(((uint64_t)i2c_sim_get_time_us() * 256 / 10000) & 0xffffff);
+}
+
+/**
+ * @brief Gets the size of a FIFO frame in bytes from its header.
+ */
+static inline uint16_t bmp390_sim_get_frame_size(const uint8_t header) {
+    switch (header) {
+        case BMP390_SIM_FIFO_PRESS_TEMP:
+            return 7;
+        case BMP390_SIM_FIFO_TEMP:
+        case BMP390_SIM_FIFO_PRESS:
+        case BMP390_SIM_FIFO_TIME:
+            return 4;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * @brief Appends a frame to the FIFO and raises the watermark and full interrupt status.
+ */
+static inline void bmp390_sim_push_frame(bmp390_sim_context_t *const ctx, const uint8_t *const frame, const uint16_t frame_size) {
+    /* compact the read frames before appending */
+    if (ctx->fifo_index) {
+        memmove(ctx->fifo, ctx->fifo + ctx->fifo_index, ctx->fifo_length - ctx->fifo_index);
+        ctx->fifo_length -= ctx->fifo_index;
+        ctx->fifo_index = 0;
+    }
+
+    if (ctx->fifo_length + frame_size > BMP390_SIM_FIFO_SIZE) {
+        ctx->regs[BMP390_SIM_REG_INT_STATUS] |= BMP390_SIM_INT_FFULL;
+        if (ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_1] & 0x02) return;
+
+        /* without stop on full the oldest whole frames are overwritten */
+        uint16_t drop = 0;
+        while (drop < ctx->fifo_length && ctx->fifo_length - drop + frame_size > BMP390_SIM_FIFO_SIZE) {
+            drop += bmp390_sim_get_frame_size(ctx->fifo[drop]);
+        }
+        memmove(ctx->fifo, ctx->fifo + drop, ctx->fifo_length - drop);
+        ctx->fifo_length -= drop;
+    }
+
+    memcpy(&ctx->fifo[ctx->fifo_length], frame, frame_size);
+    ctx->fifo_length += frame_size;
+
+    const uint16_t watermark = ((uint16_t)ctx->regs[BMP390_SIM_REG_FIFO_WTM_0] | ((uint16_t)ctx->regs[BMP390_SIM_REG_FIFO_WTM_1] << 8)) & 0x01ff;
+    if (watermark && ctx->fifo_length >= watermark) ctx->regs[BMP390_SIM_REG_INT_STATUS] |= BMP390_SIM_INT_FWM;
+    if (ctx->fifo_length + frame_size > BMP390_SIM_FIFO_SIZE) ctx->regs[BMP390_SIM_REG_INT_STATUS] |= BMP390_SIM_INT_FFULL;
+}
+
+/**
+ * @brief Appends a sensor frame to the FIFO when enabled by the FIFO configuration.
+ */
+static inline void bmp390_sim_push_fifo(bmp390_sim_context_t *const ctx, const uint32_t sample) {
+    const uint8_t config1 = ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_1];
+    const bool press_en = (config1 & 0x08) != 0;
+    const bool temp_en  = (config1 & 0x10) != 0;
+
+    if ((config1 & 0x01) == 0 || (press_en == false && temp_en == false)) return;
+
+    /* subsampling keeps one sample in 2^fifo_subsampling */
+    if (sample % (1u << (ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_2] & 0x07)) != 0) return;
+
+    uint8_t frame[7] = { press_en ? (temp_en ? BMP390_SIM_FIFO_PRESS_TEMP : BMP390_SIM_FIFO_PRESS) : BMP390_SIM_FIFO_TEMP };
+    uint8_t index = 1;
+
+    if (temp_en) {
+        memcpy(&frame[index], &ctx->regs[BMP390_SIM_REG_TEMP_XLSB], 3);
+        index += 3;
+    }
+    if (press_en) memcpy(&frame[index], &ctx->regs[BMP390_SIM_REG_PRESS_XLSB], 3);
+
+    bmp390_sim_push_frame(ctx, frame, bmp390_sim_get_frame_size(frame[0]));
+}
+
+/**
+ * @brief Appends a configuration change frame to the enabled FIFO, written when the 
+ * oversampling, output data rate or filter configuration changes.
+ */
+static inline void bmp390_sim_push_config_change(bmp390_sim_context_t *const ctx) {
+    const uint8_t frame[2] = { BMP390_SIM_FIFO_CONFIG_CHG, 0x01 };
+
+    if ((ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_1] & 0x01) == 0) return;
+
+    bmp390_sim_push_frame(ctx, frame, sizeof(frame));
+}
+
+/**
+ * @brief Converts the inputs into the data registers and raises the data ready status.
+ */
+static inline void bmp390_sim_convert(bmp390_sim_context_t *const ctx) {
+    const uint8_t pwr_ctrl = ctx->regs[BMP390_SIM_REG_PWR_CTRL];
+    const uint32_t adc_t = i2c_sim_model_bisect(bmp390_sim_convert_temperature, NULL, 0, BMP390_SIM_ADC_MAX, (double)ctx->temperature);
+    const double t = bmp390_sim_convert_temperature(NULL, adc_t);
+    const uint32_t adc_p = i2c_sim_model_bisect(bmp390_sim_convert_pressure, &t, 0, BMP390_SIM_ADC_MAX, (double)ctx->pressure);
+
+    if (pwr_ctrl & 0x01) {
+        bmp390_sim_set_u24(&ctx->regs[BMP390_SIM_REG_PRESS_XLSB], adc_p);
+        ctx->regs[BMP390_SIM_REG_STATUS] |= BMP390_SIM_STATUS_DRDY_PRESS;
+    }
+    if (pwr_ctrl & 0x02) {
+        bmp390_sim_set_u24(&ctx->regs[BMP390_SIM_REG_TEMP_XLSB], adc_t);
+        ctx->regs[BMP390_SIM_REG_STATUS] |= BMP390_SIM_STATUS_DRDY_TEMP;
+    }
+    ctx->regs[BMP390_SIM_REG_INT_STATUS] |= BMP390_SIM_INT_DRDY;
+}
+
+/**
+ * @brief Advances the conversion state to the current virtual time.
+ */
+static inline void bmp390_sim_update(bmp390_sim_context_t *const ctx) {
+    const int64_t now  = i2c_sim_get_time_us();
+    const uint8_t mode = (ctx->regs[BMP390_SIM_REG_PWR_CTRL] >> 4) & 0x03;
+    const int64_t conv_time = bmp390_sim_get_conv_time(ctx);
+    const int64_t elapsed = now - ctx->meas_start_time;
+
+    if (mode == 0x01 || mode == 0x02) {
+        /* forced mode returns to sleep once the conversion completes */
+        if (elapsed >= conv_time) {
+            bmp390_sim_convert(ctx);
+            bmp390_sim_push_fifo(ctx, 0);
+            ctx->regs[BMP390_SIM_REG_PWR_CTRL] &= (uint8_t)~0x30;
+        }
+    } else if (mode == 0x03 && elapsed >= conv_time) {
+        /* normal mode samples at the output data rate */
+        const int64_t period = (int64_t)BMP390_SIM_ODR_BASE_US << (ctx->regs[BMP390_SIM_REG_ODR] & 0x1f);
+        const uint32_t samples = (uint32_t)((elapsed - conv_time) / period) + 1;
+
+        if (samples > ctx->samples) {
+            uint32_t sample = ctx->samples;
+            if (samples - sample > BMP390_SIM_PENDING_MAX) sample = samples - BMP390_SIM_PENDING_MAX;
+            bmp390_sim_convert(ctx);
+            for (; sample < samples; sample++) bmp390_sim_push_fifo(ctx, sample);
+            ctx->samples = samples;
+        }
+    }
+
+    bmp390_sim_set_u24(&ctx->regs[BMP390_SIM_REG_SNRTIME_XLSB], bmp390_sim_get_sensor_time());
+    ctx->regs[BMP390_SIM_REG_FIFO_LENGTH_0] = (uint8_t)((ctx->fifo_length - ctx->fifo_index) & 0xff);
+    ctx->regs[BMP390_SIM_REG_FIFO_LENGTH_1] = (uint8_t)((ctx->fifo_length - ctx->fifo_index) >> 8);
+}
+
+/**
+ * @brief Empties the FIFO.
+ */
+static inline void bmp390_sim_flush_fifo(bmp390_sim_context_t *const ctx) {
+    ctx->fifo_length     = 0;
+    ctx->fifo_index      = 0;
+    ctx->fifo_time_index = 0;
+    ctx->regs[BMP390_SIM_REG_INT_STATUS] &= (uint8_t)~(BMP390_SIM_INT_FWM | BMP390_SIM_INT_FFULL);
+}
+
+/**
+ * @brief Reads a byte from the FIFO data register.  The sensor time frame follows the 
+ * last frame when enabled, then empty frames are returned.
+ */
+static inline uint8_t bmp390_sim_read_fifo(bmp390_sim_context_t *const ctx) {
+    if (ctx->fifo_index < ctx->fifo_length) {
+        const uint8_t value = ctx->fifo[ctx->fifo_index++];
+        if (ctx->fifo_index == ctx->fifo_length) {
+            ctx->fifo_time[0] = BMP390_SIM_FIFO_TIME;
+            bmp390_sim_set_u24(&ctx->fifo_time[1], bmp390_sim_get_sensor_time());
+            ctx->fifo_time_index = 0;
+        }
+        return value;
+    }
+
+    if ((ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_1] & 0x04) && ctx->fifo_length && ctx->fifo_time_index < sizeof(ctx->fifo_time)) {
+        return ctx->fifo_time[ctx->fifo_time_index++];
+    }
+
+    return BMP390_SIM_FIFO_EMPTY;
+}
+
+/**
+ * @brief Restores the power-on register state.
+ */
+static inline void bmp390_sim_reset(bmp390_sim_context_t *const ctx) {
+    const bmp390_sim_calibration_t *cal = &bmp390_sim_calibration;
+    const uint8_t nvm[21] = {
+        (uint8_t)(cal->T1 & 0xff), (uint8_t)(cal->T1 >> 8), (uint8_t)(cal->T2 & 0xff), (uint8_t)(cal->T2 >> 8), (uint8_t)cal->T3,
+        (uint8_t)((uint16_t)cal->P1 & 0xff), (uint8_t)((uint16_t)cal->P1 >> 8), (uint8_t)((uint16_t)cal->P2 & 0xff), (uint8_t)((uint16_t)cal->P2 >> 8),
+        (uint8_t)cal->P3, (uint8_t)cal->P4, (uint8_t)(cal->P5 & 0xff), (uint8_t)(cal->P5 >> 8), (uint8_t)(cal->P6 & 0xff), (uint8_t)(cal->P6 >> 8),
+        (uint8_t)cal->P7, (uint8_t)cal->P8, (uint8_t)((uint16_t)cal->P9 & 0xff), (uint8_t)((uint16_t)cal->P9 >> 8), (uint8_t)cal->P10, (uint8_t)cal->P11
+    };
+
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+    memcpy(&ctx->regs[BMP390_SIM_REG_NVM], nvm, sizeof(nvm));
+
+    ctx->regs[BMP390_SIM_REG_CHIP_ID]       = BMP390_SIM_CHIP_ID;
+    ctx->regs[BMP390_SIM_REG_STATUS]        = BMP390_SIM_STATUS_CMD_RDY;
+    ctx->regs[BMP390_SIM_REG_EVENT]         = 0x01;
+    ctx->regs[BMP390_SIM_REG_FIFO_WTM_0]    = 0x01;
+    ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_1] = 0x02;
+    ctx->regs[BMP390_SIM_REG_FIFO_CONFIG_2] = 0x02;
+    ctx->regs[BMP390_SIM_REG_INT_CTRL]      = 0x02;
+    ctx->regs[BMP390_SIM_REG_OSR]           = 0x02;
+    ctx->samples = 0;
+    bmp390_sim_flush_fifo(ctx);
+}
+
+static esp_err_t bmp390_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    bmp390_sim_context_t *ctx = (bmp390_sim_context_t*)context;
+
+    bmp390_sim_update(ctx);
+
+    ctx->pointer = buffer[0];
+    for (size_t i = 1; i < size; i++, ctx->pointer++) {
+        const uint8_t reg = ctx->pointer & 0x7f;
+        switch (reg) {
+            case BMP390_SIM_REG_CMD:
+                if (buffer[i] == BMP390_SIM_CMD_SOFT_RESET) bmp390_sim_reset(ctx);
+                if (buffer[i] == BMP390_SIM_CMD_FIFO_FLUSH) bmp390_sim_flush_fifo(ctx);
+                break;
+            case BMP390_SIM_REG_PWR_CTRL:
+                ctx->regs[reg]       = buffer[i] & 0x33;
+                ctx->meas_start_time = i2c_sim_get_time_us();
+                ctx->samples         = 0;
+                break;
+            case BMP390_SIM_REG_FIFO_WTM_0:
+            case BMP390_SIM_REG_FIFO_WTM_1:
+            case BMP390_SIM_REG_FIFO_CONFIG_1:
+            case BMP390_SIM_REG_FIFO_CONFIG_2:
+            case BMP390_SIM_REG_INT_CTRL:
+            case 0x1A:
+                ctx->regs[reg] = buffer[i];
+                break;
+            case BMP390_SIM_REG_OSR:
+            case BMP390_SIM_REG_ODR:
+            case BMP390_SIM_REG_CONFIG:
+                if (ctx->regs[reg] != buffer[i]) bmp390_sim_push_config_change(ctx);
+                ctx->regs[reg] = buffer[i];
+                break;
+            default:
+                /* read-only registers ignore writes */
+                break;
+        }
+    }
+
+    bmp390_sim_update(ctx);
+
+    return ESP_OK;
+}
+
+static esp_err_t bmp390_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    bmp390_sim_context_t *ctx = (bmp390_sim_context_t*)context;
+    uint8_t clear_int_status = 0, clear_event = 0, clear_status = 0;
+
+    bmp390_sim_update(ctx);
+
+    for (size_t i = 0; i < size; i++) {
+        const uint8_t reg = ctx->pointer & 0x7f;
+
+        /* the FIFO data register does not auto-increment */
+        if (reg == BMP390_SIM_REG_FIFO_DATA) {
+            buffer[i] = bmp390_sim_read_fifo(ctx);
+            continue;
+        }
+
+        buffer[i] = ctx->regs[reg];
+        if (reg == BMP390_SIM_REG_INT_STATUS) clear_int_status = buffer[i];
+        if (reg == BMP390_SIM_REG_EVENT) clear_event = buffer[i];
+        if (reg >= BMP390_SIM_REG_PRESS_XLSB && reg < BMP390_SIM_REG_TEMP_XLSB) clear_status |= BMP390_SIM_STATUS_DRDY_PRESS;
+        if (reg >= BMP390_SIM_REG_TEMP_XLSB && reg <= BMP390_SIM_REG_TEMP_MSB) clear_status |= BMP390_SIM_STATUS_DRDY_TEMP;
+        ctx->pointer++;
+    }
+
+    /* interrupt status, event and data ready status clear after the read */
+    ctx->regs[BMP390_SIM_REG_INT_STATUS] &= (uint8_t)~clear_int_status;
+    ctx->regs[BMP390_SIM_REG_EVENT]      &= (uint8_t)~clear_event;
+    ctx->regs[BMP390_SIM_REG_STATUS]     &= (uint8_t)~clear_status;
+
+    bmp390_sim_update(ctx);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_bmp390_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("bmp390", sizeof(bmp390_sim_context_t), bmp390_sim_write, bmp390_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    bmp390_sim_context_t *ctx = (bmp390_sim_context_t*)(*model)->context;
+
+    bmp390_sim_reset(ctx);
+    ctx->temperature = 25.0f;
+    ctx->pressure    = 101325.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_bmp390_set_environment(i2c_sim_model_t *const model, const float temperature, const float pressure) {
+    bmp390_sim_context_t *ctx = (bmp390_sim_context_t*)i2c_sim_model_get_context(model, bmp390_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -40.0f && temperature <= 85.0f && pressure >= 30000.0f && pressure <= 125000.0f );
+
+    ctx->temperature = temperature;
+    ctx->pressure    = pressure;
+
+    return ESP_OK;
+}
@@ -0,0 +1,200 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_hdc1080.c
+ *
+ * HDC1080 temperature and humidity sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * HDC1080 model definitions
+*/
+#define HDC1080_SIM_REG_TEMPERATURE     UINT8_C(0x00)
+#define HDC1080_SIM_REG_HUMIDITY        UINT8_C(0x01)
+#define HDC1080_SIM_REG_CONFIGURATION   UINT8_C(0x02)
+#define HDC1080_SIM_REG_SERIAL_ID_FBP   UINT8_C(0xFB)
+#define HDC1080_SIM_REG_SERIAL_ID_MBP   UINT8_C(0xFC)
+#define HDC1080_SIM_REG_SERIAL_ID_LBP   UINT8_C(0xFD)
+#define HDC1080_SIM_REG_MANUFACTURER_ID UINT8_C(0xFE)
+#define HDC1080_SIM_REG_DEVICE_ID       UINT8_C(0xFF)
+#define HDC1080_SIM_CONFIG_RST          UINT16_C(0x8000)
+#define HDC1080_SIM_CONFIG_MODE         UINT16_C(0x1000)    //!< hdc1080 model, sequenced temperature and humidity acquisition
+#define HDC1080_SIM_CONFIG_TRES         UINT16_C(0x0400)    //!< hdc1080 model, 11-bit temperature resolution
+#define HDC1080_SIM_CONFIG_HRES         UINT16_C(0x0300)    //!< hdc1080 model, humidity resolution
+#define HDC1080_SIM_CONFIG_WRITABLE     UINT16_C(0x3700)    //!< hdc1080 model, heater, mode and resolution bits
+#define HDC1080_SIM_CONFIG_DEFAULT      UINT16_C(0x1000)
+#define HDC1080_SIM_MANUFACTURER_ID     UINT16_C(0x5449)    //!< hdc1080 model, "TI" in ASCII
+#define HDC1080_SIM_DEVICE_ID           UINT16_C(0x1050)
+
+/**
+ * @brief HDC1080 model context structure definition.
+ */
+typedef struct hdc1080_sim_context_s {
+    uint16_t                    config;         /*!< hdc1080 model, configuration register */
+    uint8_t                     pointer;        /*!< hdc1080 model, register pointer */
+    int64_t                     ready_time;     /*!< hdc1080 model, virtual time the conversion in progress completes */
+    uint8_t                     response[4];    /*!< hdc1080 model, result of the last conversion */
+    uint8_t                     response_size;  /*!< hdc1080 model, result bytes pending, 0 without a conversion */
+    float                       temperature;    /*!< hdc1080 model, temperature input in degrees Celsius */
+    float                       humidity;       /*!< hdc1080 model, relative humidity input in percent */
+} hdc1080_sim_context_t;
+
+/* temperature conversion time in microseconds for TRES, see datasheet table 7.5 */
+static const uint32_t hdc1080_sim_temperature_time_us[2] = { 6350, 3650 };
+
+/* humidity conversion time in microseconds for HRES */
+static const uint32_t hdc1080_sim_humidity_time_us[4] = { 6500, 3850, 2500, 2500 };
+
+/**
+ * @brief Appends a conversion result word to the response.
+ */
+static inline void hdc1080_sim_add_response(hdc1080_sim_context_t *const ctx, const double ticks) {
+    const uint16_t word = (uint16_t)fmin(fmax(lround(ticks), 0), 65535) & 0xfffc;
+
+    ctx->response[ctx->response_size++] = (uint8_t)(word >> 8);
+    ctx->response[ctx->response_size++] = (uint8_t)(word & 0xff);
+}
+
+/**
+ * @brief Starts a conversion from a pointer write to a result register, see datasheet section 8.5.1.
+ */
+static inline void hdc1080_sim_convert(hdc1080_sim_context_t *const ctx, const uint8_t reg) {
+    const uint32_t t_us = hdc1080_sim_temperature_time_us[(ctx->config & HDC1080_SIM_CONFIG_TRES) ? 1 : 0];
+    const uint32_t h_us = hdc1080_sim_humidity_time_us[(ctx->config & HDC1080_SIM_CONFIG_HRES) >> 8];
+    const double t_ticks = ((double)ctx->temperature + 40.0) * 65536.0 / 165.0;
+    const double h_ticks = (double)ctx->humidity * 65536.0 / 100.0;
+    uint32_t busy_us = 0;
+
+    ctx->response_size = 0;
+
+    if (reg == HDC1080_SIM_REG_TEMPERATURE) {
+        hdc1080_sim_add_response(ctx, t_ticks);
+        busy_us += t_us;
+        /* sequenced acquisition converts humidity after temperature */
+        if (ctx->config & HDC1080_SIM_CONFIG_MODE) {
+            hdc1080_sim_add_response(ctx, h_ticks);
+            busy_us += h_us;
+        }
+    } else {
+        hdc1080_sim_add_response(ctx, h_ticks);
+        busy_us += h_us;
+    }
+
+    ctx->ready_time = i2c_sim_get_time_us() + busy_us;
+}
+
+static inline uint16_t hdc1080_sim_get_register(const hdc1080_sim_context_t *const ctx, const uint8_t reg) {
+    switch (reg) {
+        case HDC1080_SIM_REG_CONFIGURATION:     return ctx->config;
+        case HDC1080_SIM_REG_SERIAL_ID_FBP:     return 0x0bad;
+        case HDC1080_SIM_REG_SERIAL_ID_MBP:     return 0xcafe;
+        case HDC1080_SIM_REG_SERIAL_ID_LBP:     return 0x8000;
+        case HDC1080_SIM_REG_MANUFACTURER_ID:   return HDC1080_SIM_MANUFACTURER_ID;
+        case HDC1080_SIM_REG_DEVICE_ID:         return HDC1080_SIM_DEVICE_ID;
+        default:                                return 0x0000;
+    }
+}
+
+static esp_err_t hdc1080_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    hdc1080_sim_context_t *ctx = (hdc1080_sim_context_t*)context;
+
+    ctx->pointer = buffer[0];
+
+    switch (ctx->pointer) {
+        case HDC1080_SIM_REG_TEMPERATURE:
+        case HDC1080_SIM_REG_HUMIDITY:
+            /* a pointer write to a result register triggers a conversion */
+            hdc1080_sim_convert(ctx, ctx->pointer);
+            break;
+        case HDC1080_SIM_REG_CONFIGURATION:
+            if (size < 3) break;
+            if (buffer[1] & (HDC1080_SIM_CONFIG_RST >> 8)) {
+                ctx->config        = HDC1080_SIM_CONFIG_DEFAULT;
+                ctx->response_size = 0;
+                break;
+            }
+            ctx->config = (uint16_t)(((uint16_t)buffer[1] << 8) | buffer[2]) & HDC1080_SIM_CONFIG_WRITABLE;
+            break;
+        default:
+            break;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t hdc1080_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    hdc1080_sim_context_t *ctx = (hdc1080_sim_context_t*)context;
+
+    if (ctx->pointer == HDC1080_SIM_REG_TEMPERATURE || ctx->pointer == HDC1080_SIM_REG_HUMIDITY) {
+        /* a result read is not acknowledged while converting or without a conversion */
+        if (i2c_sim_get_time_us() < ctx->ready_time || ctx->response_size == 0) return ESP_ERR_INVALID_STATE;
+
+        for (size_t i = 0; i < size; i++) {
+            buffer[i] = (i < ctx->response_size) ? ctx->response[i] : 0xff;
+        }
+        ctx->response_size = 0;
+
+        return ESP_OK;
+    }
+
+    const uint16_t word = hdc1080_sim_get_register(ctx, ctx->pointer);
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < 2) ? (uint8_t)(word >> (8 * (1 - i))) : 0xff;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_hdc1080_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("hdc1080", sizeof(hdc1080_sim_context_t), hdc1080_sim_write, hdc1080_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    hdc1080_sim_context_t *ctx = (hdc1080_sim_context_t*)(*model)->context;
+
+    ctx->config      = HDC1080_SIM_CONFIG_DEFAULT;
+    ctx->temperature = 25.0f;
+    ctx->humidity    = 50.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_hdc1080_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity) {
+    hdc1080_sim_context_t *ctx = (hdc1080_sim_context_t*)i2c_sim_model_get_context(model, hdc1080_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -40.0f && temperature <= 125.0f && humidity >= 0.0f && humidity <= 100.0f );
+
+    ctx->temperature = temperature;
+    ctx->humidity    = humidity;
+
+    return ESP_OK;
+}
@@ -0,0 +1,242 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_ina226.c
+ *
+ * INA226 power monitor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * INA226 model definitions
+*/
+#define INA226_SIM_REG_CONFIG           UINT8_C(0x00)
+#define INA226_SIM_REG_SHUNT_V          UINT8_C(0x01)
+#define INA226_SIM_REG_BUS_V            UINT8_C(0x02)
+#define INA226_SIM_REG_POWER            UINT8_C(0x03)
+#define INA226_SIM_REG_CURRENT          UINT8_C(0x04)
+#define INA226_SIM_REG_CALIBRATION      UINT8_C(0x05)
+#define INA226_SIM_REG_MSK_ENA          UINT8_C(0x06)
+#define INA226_SIM_REG_ALERT_LIMIT      UINT8_C(0x07)
+#define INA226_SIM_REG_MANUFACTURER_ID  UINT8_C(0xFE)
+#define INA226_SIM_REG_DIE_ID           UINT8_C(0xFF)
+#define INA226_SIM_CONFIG_RST           UINT16_C(0x8000)
+#define INA226_SIM_CONFIG_DEFAULT       UINT16_C(0x4127)
+#define INA226_SIM_MSK_ENA_CVRF         UINT16_C(0x0008)    //!< ina226 model, conversion ready flag
+#define INA226_SIM_MSK_ENA_FLAGS        UINT16_C(0x001C)    //!< ina226 model, read-only overflow, conversion ready and alert flags
+#define INA226_SIM_MSK_ENA_WRITABLE     UINT16_C(0xFC03)    //!< ina226 model, alert function, polarity and latch bits
+#define INA226_SIM_MANUFACTURER_ID      UINT16_C(0x5449)    //!< ina226 model, "TI" in ASCII
+#define INA226_SIM_DIE_ID               UINT16_C(0x2260)    //!< ina226 model, device 0x226 revision 0
+#define INA226_SIM_VSHUNT_LSB           (2.5e-6)            //!< ina226 model, shunt voltage lsb in volts
+#define INA226_SIM_VBUS_LSB             (1.25e-3)           //!< ina226 model, bus voltage lsb in volts
+
+/**
+ * @brief INA226 model context structure definition.
+ */
+typedef struct ina226_sim_context_s {
+    uint16_t                    regs[8];            /*!< ina226 model, register file up to the alert limit register */
+    uint8_t                     pointer;            /*!< ina226 model, register pointer */
+    int64_t                     conv_start_time;    /*!< ina226 model, virtual time the conversions started */
+    uint32_t                    conversions;        /*!< ina226 model, conversions completed since the start time */
+    float                       bus_voltage;        /*!< ina226 model, bus voltage input in volts */
+    float                       shunt_voltage;      /*!< ina226 model, shunt voltage input in volts */
+} ina226_sim_context_t;
+
+/*
+ * static constant declarations
+*/
+
+/* conversion time in microseconds for VBUSCT and VSHCT, see datasheet table 7 */
+static const uint32_t ina226_sim_conv_time_us[8] = { 140, 204, 332, 588, 1100, 2116, 4156, 8244 };
+
+/* averaging count for AVG */
+static const uint32_t ina226_sim_averages[8] = { 1, 4, 16, 64, 128, 256, 512, 1024 };
+
+/**
+ * @brief Gets the time of one averaged conversion of the enabled channels.
+ */
+static inline uint32_t ina226_sim_get_conv_time(const ina226_sim_context_t *const ctx) {
+    const uint16_t config = ctx->regs[INA226_SIM_REG_CONFIG];
+    uint32_t time_us = 0;
+
+    if (config & 0x01) time_us += ina226_sim_conv_time_us[(config >> 3) & 0x07];
+    if (config & 0x02) time_us += ina226_sim_conv_time_us[(config >> 6) & 0x07];
+
+    return time_us * ina226_sim_averages[(config >> 9) & 0x07];
+}
+
+/**
+ * @brief Converts the inputs into the result registers for the enabled channels, see datasheet section 7.5.
+ */
+static inline void ina226_sim_convert(ina226_sim_context_t *const ctx) {
+    const uint16_t config = ctx->regs[INA226_SIM_REG_CONFIG];
+
+    if (config & 0x01) ctx->regs[INA226_SIM_REG_SHUNT_V] = (uint16_t)(int16_t)fmin(fmax(lround((double)ctx->shunt_voltage / INA226_SIM_VSHUNT_LSB), -32768), 32767);
+    if (config & 0x02) ctx->regs[INA226_SIM_REG_BUS_V] = (uint16_t)fmin(fmax(lround((double)ctx->bus_voltage / INA226_SIM_VBUS_LSB), 0), 0x7fff);
+
+    /* current and power follow the calibration register */
+    const double current = (double)(int16_t)ctx->regs[INA226_SIM_REG_SHUNT_V] * (double)ctx->regs[INA226_SIM_REG_CALIBRATION] / 2048.0;
+    const double power   = fabs(current) * (double)ctx->regs[INA226_SIM_REG_BUS_V] / 20000.0;
+
+    ctx->regs[INA226_SIM_REG_CURRENT] = (uint16_t)(int16_t)fmin(fmax(lround(current), -32768), 32767);
+    ctx->regs[INA226_SIM_REG_POWER]   = (uint16_t)fmin(lround(power), 0xffff);
+    ctx->regs[INA226_SIM_REG_MSK_ENA] |= INA226_SIM_MSK_ENA_CVRF;
+}
+
+/**
+ * @brief Advances the conversion state to the current virtual time.
+ */
+static inline void ina226_sim_update(ina226_sim_context_t *const ctx) {
+    const uint8_t mode = ctx->regs[INA226_SIM_REG_CONFIG] & 0x07;
+    const int64_t conv_time = ina226_sim_get_conv_time(ctx);
+
+    if ((mode & 0x03) == 0 || conv_time == 0) return;
+
+    const int64_t elapsed = i2c_sim_get_time_us() - ctx->conv_start_time;
+    uint32_t conversions = (uint32_t)(elapsed / conv_time);
+
+    /* triggered modes convert once */
+    if ((mode & 0x04) == 0 && conversions > 1) conversions = 1;
+
+    if (conversions > ctx->conversions) {
+        ina226_sim_convert(ctx);
+        ctx->conversions = conversions;
+    }
+}
+
+/**
+ * @brief Restores the power-on register state.
+ */
+static inline void ina226_sim_reset(ina226_sim_context_t *const ctx) {
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+
+    ctx->regs[INA226_SIM_REG_CONFIG] = INA226_SIM_CONFIG_DEFAULT;
+    ctx->conv_start_time = i2c_sim_get_time_us();
+    ctx->conversions     = 0;
+}
+
+static esp_err_t ina226_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    ina226_sim_context_t *ctx = (ina226_sim_context_t*)context;
+
+    ina226_sim_update(ctx);
+
+    ctx->pointer = buffer[0];
+    if (size < 3) return ESP_OK;
+
+    /* registers are 16-bit and big-endian */
+    const uint16_t value = ((uint16_t)buffer[1] << 8) | buffer[2];
+
+    switch (ctx->pointer) {
+        case INA226_SIM_REG_CONFIG:
+            if (value & INA226_SIM_CONFIG_RST) {
+                ina226_sim_reset(ctx);
+                break;
+            }
+            /* a write starts a triggered conversion or restarts continuous conversions */
+            ctx->regs[INA226_SIM_REG_CONFIG] = value;
+            ctx->regs[INA226_SIM_REG_MSK_ENA] &= (uint16_t)~INA226_SIM_MSK_ENA_CVRF;
+            ctx->conv_start_time = i2c_sim_get_time_us();
+            ctx->conversions     = 0;
+            break;
+        case INA226_SIM_REG_CALIBRATION:
+            ctx->regs[INA226_SIM_REG_CALIBRATION] = value & 0x7fff;
+            break;
+        case INA226_SIM_REG_MSK_ENA:
+            /* flag bits are read-only */
+            ctx->regs[INA226_SIM_REG_MSK_ENA] = (ctx->regs[INA226_SIM_REG_MSK_ENA] & INA226_SIM_MSK_ENA_FLAGS) | (value & INA226_SIM_MSK_ENA_WRITABLE);
+            break;
+        case INA226_SIM_REG_ALERT_LIMIT:
+            ctx->regs[INA226_SIM_REG_ALERT_LIMIT] = value;
+            break;
+        default:
+            /* read-only registers ignore writes */
+            break;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t ina226_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    ina226_sim_context_t *ctx = (ina226_sim_context_t*)context;
+    uint16_t value = 0;
+
+    ina226_sim_update(ctx);
+
+    switch (ctx->pointer) {
+        case INA226_SIM_REG_MANUFACTURER_ID:
+            value = INA226_SIM_MANUFACTURER_ID;
+            break;
+        case INA226_SIM_REG_DIE_ID:
+            value = INA226_SIM_DIE_ID;
+            break;
+        default:
+            value = (ctx->pointer < 8) ? ctx->regs[ctx->pointer] : 0;
+            break;
+    }
+
+    /* big-endian register bytes, the pointer does not auto-increment */
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < 2) ? (uint8_t)(value >> (8 * (1 - i))) : 0x00;
+    }
+
+    /* conversion ready flag clears when the mask/enable register is read */
+    if (ctx->pointer == INA226_SIM_REG_MSK_ENA) ctx->regs[INA226_SIM_REG_MSK_ENA] &= (uint16_t)~INA226_SIM_MSK_ENA_CVRF;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ina226_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("ina226", sizeof(ina226_sim_context_t), ina226_sim_write, ina226_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    ina226_sim_context_t *ctx = (ina226_sim_context_t*)(*model)->context;
+
+    ina226_sim_reset(ctx);
+    ctx->bus_voltage   = 5.0f;
+    ctx->shunt_voltage = 0.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ina226_set_inputs(i2c_sim_model_t *const model, const float bus_voltage, const float shunt_voltage) {
+    ina226_sim_context_t *ctx = (ina226_sim_context_t*)i2c_sim_model_get_context(model, ina226_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && bus_voltage >= 0.0f && bus_voltage <= 36.0f && fabsf(shunt_voltage) <= 0.08192f );
+
+    /* conversions due before the change keep the previous inputs */
+    ina226_sim_update(ctx);
+
+    ctx->bus_voltage   = bus_voltage;
+    ctx->shunt_voltage = shunt_voltage;
+
+    return ESP_OK;
+}
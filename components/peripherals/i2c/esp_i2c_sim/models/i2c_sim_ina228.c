@@ -0,0 +1,310 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_ina228.c
+ *
+ * INA228 power monitor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * INA228 model definitions
+*/
+#define INA228_SIM_REG_CONFIG           UINT8_C(0x00)
+#define INA228_SIM_REG_ADC_CONFIG       UINT8_C(0x01)
+#define INA228_SIM_REG_SHUNT_CAL        UINT8_C(0x02)
+#define INA228_SIM_REG_VSHUNT           UINT8_C(0x04)
+#define INA228_SIM_REG_VBUS             UINT8_C(0x05)
+#define INA228_SIM_REG_DIETEMP          UINT8_C(0x06)
+#define INA228_SIM_REG_CURRENT          UINT8_C(0x07)
+#define INA228_SIM_REG_POWER            UINT8_C(0x08)
+#define INA228_SIM_REG_ENERGY           UINT8_C(0x09)
+#define INA228_SIM_REG_CHARGE           UINT8_C(0x0A)
+#define INA228_SIM_REG_DIAG_ALRT        UINT8_C(0x0B)
+#define INA228_SIM_REG_POWER_LIMIT      UINT8_C(0x11)
+#define INA228_SIM_REG_MANUFACTURER_ID  UINT8_C(0x3E)
+#define INA228_SIM_REG_DEVICE_ID        UINT8_C(0x3F)
+#define INA228_SIM_REG_COUNT            UINT8_C(0x40)
+#define INA228_SIM_CONFIG_RST           UINT16_C(0x8000)
+#define INA228_SIM_CONFIG_RSTACC        UINT16_C(0x4000)
+#define INA228_SIM_CONFIG_ADCRANGE      UINT16_C(0x0010)
+#define INA228_SIM_DIAG_CNVRF           UINT16_C(0x0002)
+#define INA228_SIM_DIAG_MEMSTAT         UINT16_C(0x0001)
+#define INA228_SIM_ADC_CONFIG_DEFAULT   UINT16_C(0xFB68)
+#define INA228_SIM_SHUNT_CAL_DEFAULT    UINT16_C(0x1000)
+#define INA228_SIM_MANUFACTURER_ID      UINT16_C(0x5449)    //!< ina228 model, "TI" in ASCII
+#define INA228_SIM_DEVICE_ID            UINT16_C(0x2281)    //!< ina228 model, device 0x228 revision 1
+#define INA228_SIM_VSHUNT_LSB           (312.5e-9)          //!< ina228 model, shunt voltage lsb in volts for ADCRANGE 0
+#define INA228_SIM_VBUS_LSB             (195.3125e-6)       //!< ina228 model, bus voltage lsb in volts
+#define INA228_SIM_DIETEMP_LSB          (7.8125e-3)         //!< ina228 model, die temperature lsb in degrees Celsius
+#define INA228_SIM_PENDING_MAX          UINT32_C(100000)    //!< ina228 model, most continuous conversions accumulated at once
+
+/**
+ * @brief INA228 model context structure definition.
+ */
+typedef struct ina228_sim_context_s {
+    uint64_t                    regs[INA228_SIM_REG_COUNT]; /*!< ina228 model, register file right justified */
+    uint8_t                     pointer;            /*!< ina228 model, register pointer */
+    int64_t                     conv_start_time;    /*!< ina228 model, virtual time the conversions started */
+    uint32_t                    conversions;        /*!< ina228 model, conversions completed since the start time */
+    double                      energy;             /*!< ina228 model, accumulated energy in power lsb seconds */
+    double                      charge;             /*!< ina228 model, accumulated charge in current lsb seconds */
+    float                       bus_voltage;        /*!< ina228 model, bus voltage input in volts */
+    float                       shunt_voltage;      /*!< ina228 model, shunt voltage input in volts */
+    float                       die_temperature;    /*!< ina228 model, die temperature input in degrees Celsius */
+} ina228_sim_context_t;
+
+/*
+ * static constant declarations
+*/
+
+/* conversion time in microseconds for VBUSCT, VSHCT and VTCT, see datasheet section 7.6.1.2 */
+static const uint32_t ina228_sim_conv_time_us[8] = { 50, 84, 150, 280, 540, 1052, 2074, 4120 };
+
+/* averaging count for AVG */
+static const uint32_t ina228_sim_averages[8] = { 1, 4, 16, 64, 128, 256, 512, 1024 };
+
+/**
+ * @brief Gets the register width in bytes, see datasheet table 7-3.
+ */
+static inline uint8_t ina228_sim_get_width(const uint8_t reg) {
+    switch (reg) {
+        case INA228_SIM_REG_VSHUNT:
+        case INA228_SIM_REG_VBUS:
+        case INA228_SIM_REG_CURRENT:
+        case INA228_SIM_REG_POWER:
+            return 3;
+        case INA228_SIM_REG_ENERGY:
+        case INA228_SIM_REG_CHARGE:
+            return 5;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * @brief Gets the time of one averaged conversion of the enabled channels.
+ */
+static inline uint32_t ina228_sim_get_conv_time(const ina228_sim_context_t *const ctx) {
+    const uint16_t adc_config = (uint16_t)ctx->regs[INA228_SIM_REG_ADC_CONFIG];
+    const uint8_t mode = (adc_config >> 12) & 0x07;
+    uint32_t time_us = 0;
+
+    if (mode & 0x01) time_us += ina228_sim_conv_time_us[(adc_config >> 9) & 0x07];
+    if (mode & 0x02) time_us += ina228_sim_conv_time_us[(adc_config >> 6) & 0x07];
+    if (mode & 0x04) time_us += ina228_sim_conv_time_us[(adc_config >> 3) & 0x07];
+
+    return time_us * ina228_sim_averages[adc_config & 0x07];
+}
+
+/**
+ * @brief Encodes a signed value in the upper 20 bits of a 24-bit register.
+ */
+static inline uint64_t ina228_sim_encode_20bit(const double value) {
+    const int32_t raw = (int32_t)fmin(fmax(lround(value), -524288), 524287);
+
+    return ((uint64_t)(uint32_t)raw & 0xfffff) << 4;
+}
+
+/**
+ * @brief Converts the inputs into the result registers for the enabled channels and 
+ * accumulates energy and charge over the conversion.
+ */
+static inline void ina228_sim_convert(ina228_sim_context_t *const ctx, const uint32_t count) {
+    const uint16_t adc_config = (uint16_t)ctx->regs[INA228_SIM_REG_ADC_CONFIG];
+    const uint8_t mode = (adc_config >> 12) & 0x07;
+    const bool adcrange = (ctx->regs[INA228_SIM_REG_CONFIG] & INA228_SIM_CONFIG_ADCRANGE) != 0;
+    const double shunt_lsb = adcrange ? INA228_SIM_VSHUNT_LSB / 4.0 : INA228_SIM_VSHUNT_LSB;
+    const double shunt_cal = (double)(ctx->regs[INA228_SIM_REG_SHUNT_CAL] & 0x7fff);
+
+    if (mode & 0x01) ctx->regs[INA228_SIM_REG_VBUS] = ina228_sim_encode_20bit((double)ctx->bus_voltage / INA228_SIM_VBUS_LSB);
+    if (mode & 0x02) ctx->regs[INA228_SIM_REG_VSHUNT] = ina228_sim_encode_20bit((double)ctx->shunt_voltage / shunt_lsb);
+    if (mode & 0x04) ctx->regs[INA228_SIM_REG_DIETEMP] = (uint16_t)(int16_t)lround((double)ctx->die_temperature / INA228_SIM_DIETEMP_LSB);
+
+    /* current and power follow the shunt calibration, see datasheet section 8.1.2 */
+    const double current = shunt_cal ? (double)ctx->shunt_voltage * 13107.2e6 * (adcrange ? 4.0 : 1.0) / shunt_cal : 0.0;
+    const double power   = fabs(current) * (double)ctx->bus_voltage / 3.2;
+    const double seconds = (double)ina228_sim_get_conv_time(ctx) * count / 1e6;
+
+    ctx->regs[INA228_SIM_REG_CURRENT] = ina228_sim_encode_20bit(current);
+    ctx->regs[INA228_SIM_REG_POWER]   = (uint64_t)fmin(lround(power), 0xffffff);
+
+    ctx->energy += power * seconds;
+    ctx->charge += current * seconds;
+    ctx->regs[INA228_SIM_REG_ENERGY] = (uint64_t)fmin(ctx->energy / 16.0, 1099511627775.0);
+    ctx->regs[INA228_SIM_REG_CHARGE] = (uint64_t)(int64_t)llround(ctx->charge) & 0xffffffffffULL;
+
+    ctx->regs[INA228_SIM_REG_DIAG_ALRT] |= INA228_SIM_DIAG_CNVRF;
+}
+
+/**
+ * @brief Advances the conversion state to the current virtual time.
+ */
+static inline void ina228_sim_update(ina228_sim_context_t *const ctx) {
+    const uint8_t mode = ((uint16_t)ctx->regs[INA228_SIM_REG_ADC_CONFIG] >> 12) & 0x0f;
+    const int64_t conv_time = ina228_sim_get_conv_time(ctx);
+
+    if ((mode & 0x07) == 0 || conv_time == 0) return;
+
+    const int64_t elapsed = i2c_sim_get_time_us() - ctx->conv_start_time;
+    uint32_t conversions = (uint32_t)(elapsed / conv_time);
+
+    /* triggered modes convert once */
+    if ((mode & 0x08) == 0 && conversions > 1) conversions = 1;
+
+    if (conversions > ctx->conversions) {
+        uint32_t count = conversions - ctx->conversions;
+        if (count > INA228_SIM_PENDING_MAX) count = INA228_SIM_PENDING_MAX;
+        ina228_sim_convert(ctx, count);
+        ctx->conversions = conversions;
+    }
+}
+
+/**
+ * @brief Restores the power-on register state.
+ */
+static inline void ina228_sim_reset(ina228_sim_context_t *const ctx) {
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+
+    ctx->regs[INA228_SIM_REG_ADC_CONFIG]      = INA228_SIM_ADC_CONFIG_DEFAULT;
+    ctx->regs[INA228_SIM_REG_SHUNT_CAL]       = INA228_SIM_SHUNT_CAL_DEFAULT;
+    ctx->regs[INA228_SIM_REG_DIAG_ALRT]       = INA228_SIM_DIAG_MEMSTAT;
+    ctx->regs[0x0C] = 0x7fff;
+    ctx->regs[0x0D] = 0x8000;
+    ctx->regs[0x0E] = 0x7fff;
+    ctx->regs[0x10] = 0x7fff;
+    ctx->regs[INA228_SIM_REG_POWER_LIMIT]     = 0xffff;
+    ctx->regs[INA228_SIM_REG_MANUFACTURER_ID] = INA228_SIM_MANUFACTURER_ID;
+    ctx->regs[INA228_SIM_REG_DEVICE_ID]       = INA228_SIM_DEVICE_ID;
+    ctx->conv_start_time = i2c_sim_get_time_us();
+    ctx->conversions     = 0;
+    ctx->energy          = 0.0;
+    ctx->charge          = 0.0;
+}
+
+static esp_err_t ina228_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    ina228_sim_context_t *ctx = (ina228_sim_context_t*)context;
+
+    ina228_sim_update(ctx);
+
+    ctx->pointer = buffer[0] & 0x3f;
+    if (size < 3) return ESP_OK;
+
+    /* writable registers are 16-bit and big-endian, the pointer does not auto-increment */
+    const uint16_t value = ((uint16_t)buffer[1] << 8) | buffer[2];
+
+    switch (ctx->pointer) {
+        case INA228_SIM_REG_CONFIG:
+            if (value & INA228_SIM_CONFIG_RST) {
+                ina228_sim_reset(ctx);
+                break;
+            }
+            if (value & INA228_SIM_CONFIG_RSTACC) {
+                ctx->energy = 0.0;
+                ctx->charge = 0.0;
+                ctx->regs[INA228_SIM_REG_ENERGY] = 0;
+                ctx->regs[INA228_SIM_REG_CHARGE] = 0;
+            }
+            ctx->regs[INA228_SIM_REG_CONFIG] = value & (uint16_t)~(INA228_SIM_CONFIG_RST | INA228_SIM_CONFIG_RSTACC);
+            break;
+        case INA228_SIM_REG_ADC_CONFIG:
+            /* a write starts a triggered conversion or restarts continuous conversions */
+            ctx->regs[INA228_SIM_REG_ADC_CONFIG] = value;
+            ctx->conv_start_time = i2c_sim_get_time_us();
+            ctx->conversions     = 0;
+            break;
+        case INA228_SIM_REG_DIAG_ALRT:
+            /* flag bits are read-only */
+            ctx->regs[INA228_SIM_REG_DIAG_ALRT] = (ctx->regs[INA228_SIM_REG_DIAG_ALRT] & 0x00ff) | (value & 0xff00);
+            break;
+        case INA228_SIM_REG_SHUNT_CAL:
+        case 0x03:
+        case 0x0C:
+        case 0x0D:
+        case 0x0E:
+        case 0x0F:
+        case 0x10:
+        case INA228_SIM_REG_POWER_LIMIT:
+            ctx->regs[ctx->pointer] = value;
+            break;
+        default:
+            /* read-only registers ignore writes */
+            break;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t ina228_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    ina228_sim_context_t *ctx = (ina228_sim_context_t*)context;
+
+    ina228_sim_update(ctx);
+
+    const uint8_t width = ina228_sim_get_width(ctx->pointer);
+    const uint64_t value = ctx->regs[ctx->pointer];
+
+    /* big-endian register bytes, reads beyond the register width return zero */
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < width) ? (uint8_t)(value >> (8 * (width - 1 - i))) : 0x00;
+    }
+
+    /* conversion ready flag clears when the diagnostic register is read */
+    if (ctx->pointer == INA228_SIM_REG_DIAG_ALRT) ctx->regs[INA228_SIM_REG_DIAG_ALRT] &= ~(uint64_t)INA228_SIM_DIAG_CNVRF;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ina228_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("ina228", sizeof(ina228_sim_context_t), ina228_sim_write, ina228_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    ina228_sim_context_t *ctx = (ina228_sim_context_t*)(*model)->context;
+
+    ina228_sim_reset(ctx);
+    ctx->bus_voltage     = 5.0f;
+    ctx->shunt_voltage   = 0.0f;
+    ctx->die_temperature = 25.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ina228_set_inputs(i2c_sim_model_t *const model, const float bus_voltage, const float shunt_voltage, const float die_temperature) {
+    ina228_sim_context_t *ctx = (ina228_sim_context_t*)i2c_sim_model_get_context(model, ina228_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && bus_voltage >= 0.0f && bus_voltage <= 85.0f && fabsf(shunt_voltage) <= 0.16384f );
+
+    ctx->bus_voltage     = bus_voltage;
+    ctx->shunt_voltage   = shunt_voltage;
+    ctx->die_temperature = die_temperature;
+
+    return ESP_OK;
+}
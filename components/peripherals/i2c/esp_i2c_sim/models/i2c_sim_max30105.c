@@ -0,0 +1,292 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_max30105.c
+ *
+ * MAX30105 particle sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+
+/*
+ * MAX30105 model definitions
+*/
+#define MAX30105_SIM_REG_INT_STS1       UINT8_C(0x00)
+#define MAX30105_SIM_REG_FIFO_WR_PTR    UINT8_C(0x04)
+#define MAX30105_SIM_REG_FIFO_OVF_CNT   UINT8_C(0x05)
+#define MAX30105_SIM_REG_FIFO_RD_PTR    UINT8_C(0x06)
+#define MAX30105_SIM_REG_FIFO_DATA      UINT8_C(0x07)
+#define MAX30105_SIM_REG_FIFO_CONFIG    UINT8_C(0x08)
+#define MAX30105_SIM_REG_MODE_CONFIG    UINT8_C(0x09)
+#define MAX30105_SIM_REG_SPO2_CONFIG    UINT8_C(0x0A)
+#define MAX30105_SIM_REG_MLED1_MC       UINT8_C(0x11)
+#define MAX30105_SIM_REG_MLED2_MC       UINT8_C(0x12)
+#define MAX30105_SIM_REG_REV_ID         UINT8_C(0xFE)
+#define MAX30105_SIM_REG_PART_ID        UINT8_C(0xFF)
+#define MAX30105_SIM_PART_ID            UINT8_C(0x15)
+#define MAX30105_SIM_MODE_SHDN          UINT8_C(0x80)
+#define MAX30105_SIM_MODE_RESET         UINT8_C(0x40)
+#define MAX30105_SIM_MODE_RED           UINT8_C(0x02)
+#define MAX30105_SIM_MODE_RED_IR        UINT8_C(0x03)
+#define MAX30105_SIM_MODE_MULTI_LED     UINT8_C(0x07)
+#define MAX30105_SIM_FIFO_ROLLOVER      UINT8_C(0x10)
+#define MAX30105_SIM_INT_A_FULL         UINT8_C(0x80)
+#define MAX30105_SIM_INT_PPG_RDY        UINT8_C(0x40)
+#define MAX30105_SIM_POINTER_MASK       UINT8_C(0x1f)
+#define MAX30105_SIM_FIFO_DEPTH         UINT8_C(32)         //!< max30105 model, FIFO samples
+#define MAX30105_SIM_SLOT_MAX           UINT8_C(4)          //!< max30105 model, LED time slots per sample
+#define MAX30105_SIM_SAMPLE_SIZE        (MAX30105_SIM_SLOT_MAX * 3) //!< max30105 model, most bytes per sample
+#define MAX30105_SIM_COUNT_MASK         UINT32_C(0x3ffff)   //!< max30105 model, 18-bit left-justified ADC count
+#define MAX30105_SIM_PENDING_MAX        UINT32_C(64)        //!< max30105 model, most samples replayed at once, enough to overflow the FIFO
+
+/**
+ * @brief MAX30105 model context structure definition.
+ */
+typedef struct max30105_sim_context_s {
+    uint8_t                     regs[256];          /*!< max30105 model, register file */
+    uint8_t                     pointer;            /*!< max30105 model, register pointer */
+    int64_t                     sample_time;        /*!< max30105 model, virtual time of the last sample */
+    uint32_t                    sequence;           /*!< max30105 model, number of samples taken */
+    uint8_t                     fifo[MAX30105_SIM_FIFO_DEPTH][MAX30105_SIM_SAMPLE_SIZE]; /*!< max30105 model, FIFO samples */
+    uint8_t                     fifo_byte;          /*!< max30105 model, byte of the sample at the read pointer read next */
+    uint8_t                     fifo_count;         /*!< max30105 model, samples in the FIFO, equal pointers are an empty or a full FIFO */
+    uint32_t                    counts[3];          /*!< max30105 model, red, IR and green ADC count inputs */
+} max30105_sim_context_t;
+
+static inline int64_t max30105_sim_get_sample_period(const max30105_sim_context_t *const ctx) {
+    static const int64_t sample_rates[] = { 50, 100, 200, 400, 800, 1000, 1600, 3200 };
+    const uint8_t average = ctx->regs[MAX30105_SIM_REG_FIFO_CONFIG] >> 5;
+
+    /* averaging is capped at 32 samples */
+    return (1000000LL << ((average > 5) ? 5 : average)) / sample_rates[(ctx->regs[MAX30105_SIM_REG_SPO2_CONFIG] >> 2) & 0x07];
+}
+
+/* led of a time slot, 0 red, 1 IR and 2 green, -1 when the slot is inactive */
+static inline int max30105_sim_get_slot_led(const max30105_sim_context_t *const ctx, const uint8_t slot) {
+    const uint8_t mode = ctx->regs[MAX30105_SIM_REG_MODE_CONFIG] & 0x07;
+
+    if (mode == MAX30105_SIM_MODE_RED) return (slot == 0) ? 0 : -1;
+    if (mode == MAX30105_SIM_MODE_RED_IR) return (slot < 2) ? (int)slot : -1;
+    if (mode != MAX30105_SIM_MODE_MULTI_LED) return -1;
+
+    const uint8_t control = ctx->regs[MAX30105_SIM_REG_MLED1_MC + slot / 2] >> ((slot % 2) * 4);
+
+    switch (control & 0x07) {
+        case 1: case 5: return 0;
+        case 2: case 6: return 1;
+        case 3: case 7: return 2;
+        default:        return -1;
+    }
+}
+
+static inline void max30105_sim_sample(max30105_sim_context_t *const ctx) {
+    const uint8_t shift = 3 - (ctx->regs[MAX30105_SIM_REG_SPO2_CONFIG] & 0x03);
+    uint8_t *sample = ctx->fifo[ctx->regs[MAX30105_SIM_REG_FIFO_WR_PTR]];
+    uint8_t  size   = 0;
+
+    /* a full FIFO drops the new sample, or the oldest sample with rollover, and counts it as lost */
+    if (ctx->fifo_count == MAX30105_SIM_FIFO_DEPTH) {
+        if (ctx->regs[MAX30105_SIM_REG_FIFO_OVF_CNT] < MAX30105_SIM_POINTER_MASK) ctx->regs[MAX30105_SIM_REG_FIFO_OVF_CNT]++;
+        if ((ctx->regs[MAX30105_SIM_REG_FIFO_CONFIG] & MAX30105_SIM_FIFO_ROLLOVER) == 0) {
+            ctx->sequence++;
+            return;
+        }
+        ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR] = (ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR] + 1) & MAX30105_SIM_POINTER_MASK;
+        ctx->fifo_byte = 0;
+        ctx->fifo_count--;
+    }
+
+    /* the counts ramp by one per sample, so lost and reordered samples are visible */
+    for (uint8_t slot = 0; slot < MAX30105_SIM_SLOT_MAX; slot++) {
+        const int led = max30105_sim_get_slot_led(ctx, slot);
+        if (led < 0) continue;
+
+        const uint32_t count = (((ctx->counts[led] + ctx->sequence) << shift) & MAX30105_SIM_COUNT_MASK);
+        sample[size++] = (uint8_t)(count >> 16);
+        sample[size++] = (uint8_t)(count >> 8);
+        sample[size++] = (uint8_t)count;
+    }
+
+    ctx->sequence++;
+    ctx->regs[MAX30105_SIM_REG_FIFO_WR_PTR] = (ctx->regs[MAX30105_SIM_REG_FIFO_WR_PTR] + 1) & MAX30105_SIM_POINTER_MASK;
+    ctx->regs[MAX30105_SIM_REG_INT_STS1] |= MAX30105_SIM_INT_PPG_RDY;
+    ctx->fifo_count++;
+
+    /* almost full when the free samples reach the threshold */
+    if (MAX30105_SIM_FIFO_DEPTH - ctx->fifo_count <= (ctx->regs[MAX30105_SIM_REG_FIFO_CONFIG] & 0x0f)) {
+        ctx->regs[MAX30105_SIM_REG_INT_STS1] |= MAX30105_SIM_INT_A_FULL;
+    }
+}
+
+static inline void max30105_sim_update(max30105_sim_context_t *const ctx) {
+    const int64_t now = i2c_sim_get_time_us();
+
+    /* shutdown and proximity modes do not write the FIFO */
+    if ((ctx->regs[MAX30105_SIM_REG_MODE_CONFIG] & MAX30105_SIM_MODE_SHDN) || max30105_sim_get_slot_led(ctx, 0) < 0) {
+        ctx->sample_time = now;
+        return;
+    }
+
+    const int64_t period = max30105_sim_get_sample_period(ctx);
+    const int64_t due = (now - ctx->sample_time) / period;
+
+    if (due <= 0) return;
+
+    ctx->sample_time += due * period;
+    for (int64_t i = (due > MAX30105_SIM_PENDING_MAX) ? due - MAX30105_SIM_PENDING_MAX : 0; i < due; i++) {
+        max30105_sim_sample(ctx);
+    }
+}
+
+static inline void max30105_sim_reset(max30105_sim_context_t *const ctx) {
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+
+    ctx->regs[MAX30105_SIM_REG_PART_ID] = MAX30105_SIM_PART_ID;
+    ctx->fifo_byte   = 0;
+    ctx->fifo_count  = 0;
+    ctx->sample_time = i2c_sim_get_time_us();
+}
+
+static esp_err_t max30105_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    max30105_sim_context_t *ctx = (max30105_sim_context_t*)context;
+
+    max30105_sim_update(ctx);
+
+    ctx->pointer = buffer[0];
+    for (size_t i = 1; i < size; i++) {
+        const uint8_t reg = ctx->pointer;
+
+        switch (reg) {
+            case MAX30105_SIM_REG_MODE_CONFIG:
+                /* reset bit clears itself */
+                if (buffer[i] & MAX30105_SIM_MODE_RESET) {
+                    max30105_sim_reset(ctx);
+                } else {
+                    ctx->regs[reg]   = buffer[i];
+                    ctx->sample_time = i2c_sim_get_time_us();
+                }
+                break;
+            case MAX30105_SIM_REG_SPO2_CONFIG:
+                ctx->regs[reg]   = buffer[i];
+                ctx->sample_time = i2c_sim_get_time_us();
+                break;
+            case MAX30105_SIM_REG_FIFO_WR_PTR:
+            case MAX30105_SIM_REG_FIFO_OVF_CNT:
+            case MAX30105_SIM_REG_FIFO_RD_PTR:
+                ctx->regs[reg]  = buffer[i] & MAX30105_SIM_POINTER_MASK;
+                ctx->fifo_byte  = 0;
+                ctx->fifo_count = (ctx->regs[MAX30105_SIM_REG_FIFO_WR_PTR] - ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR]) & MAX30105_SIM_POINTER_MASK;
+                break;
+            case MAX30105_SIM_REG_FIFO_DATA:
+                /* FIFO data is read-only in the model */
+                break;
+            case MAX30105_SIM_REG_INT_STS1:
+            case MAX30105_SIM_REG_INT_STS1 + 1:
+            case MAX30105_SIM_REG_REV_ID:
+            case MAX30105_SIM_REG_PART_ID:
+                /* read-only registers ignore writes */
+                break;
+            default:
+                ctx->regs[reg] = buffer[i];
+                break;
+        }
+
+        ctx->pointer++;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t max30105_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    max30105_sim_context_t *ctx = (max30105_sim_context_t*)context;
+    uint8_t sample_size = 0;
+
+    max30105_sim_update(ctx);
+
+    for (uint8_t slot = 0; slot < MAX30105_SIM_SLOT_MAX; slot++) {
+        if (max30105_sim_get_slot_led(ctx, slot) >= 0) sample_size += 3;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        const uint8_t reg = ctx->pointer;
+
+        if (reg == MAX30105_SIM_REG_FIFO_DATA) {
+            /* the FIFO data register does not auto-increment, a whole sample advances the read pointer */
+            if (sample_size == 0 || ctx->fifo_count == 0) {
+                buffer[i] = 0;
+                continue;
+            }
+            buffer[i] = ctx->fifo[ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR]][ctx->fifo_byte++];
+            if (ctx->fifo_byte == sample_size) {
+                ctx->fifo_byte = 0;
+                ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR] = (ctx->regs[MAX30105_SIM_REG_FIFO_RD_PTR] + 1) & MAX30105_SIM_POINTER_MASK;
+                ctx->regs[MAX30105_SIM_REG_FIFO_OVF_CNT] = 0;
+                ctx->fifo_count--;
+                ctx->regs[MAX30105_SIM_REG_INT_STS1] &= (uint8_t)~MAX30105_SIM_INT_PPG_RDY;
+            }
+            continue;
+        }
+
+        buffer[i] = ctx->regs[reg];
+
+        /* interrupt status clears after it is read */
+        if (reg == MAX30105_SIM_REG_INT_STS1) ctx->regs[reg] = 0;
+
+        ctx->pointer++;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_max30105_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("max30105", sizeof(max30105_sim_context_t), max30105_sim_write, max30105_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    max30105_sim_context_t *ctx = (max30105_sim_context_t*)(*model)->context;
+
+    max30105_sim_reset(ctx);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_max30105_set_counts(i2c_sim_model_t *const model, const uint32_t red, const uint32_t ir, const uint32_t green) {
+    max30105_sim_context_t *ctx = (max30105_sim_context_t*)i2c_sim_model_get_context(model, max30105_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx );
+
+    /* samples due before the change keep the previous counts */
+    max30105_sim_update(ctx);
+
+    ctx->counts[0] = red;
+    ctx->counts[1] = ir;
+    ctx->counts[2] = green;
+
+    return ESP_OK;
+}
@@ -0,0 +1,199 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_mlx90614.c
+ *
+ * MLX90614 infrared thermometer model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * MLX90614 model definitions
+*/
+#define MLX90614_SIM_OPCODE_MASK        UINT8_C(0xE0)
+#define MLX90614_SIM_OPCODE_RAM         UINT8_C(0x00)       //!< mlx90614 model, RAM access opcode 000x xxxx
+#define MLX90614_SIM_OPCODE_EEPROM      UINT8_C(0x20)       //!< mlx90614 model, EEPROM access opcode 001x xxxx
+#define MLX90614_SIM_CMD_READ_FLAGS     UINT8_C(0xF0)
+#define MLX90614_SIM_CMD_SLEEP          UINT8_C(0xFF)
+#define MLX90614_SIM_RAM_RAWIR1         UINT8_C(0x04)
+#define MLX90614_SIM_RAM_RAWIR2         UINT8_C(0x05)
+#define MLX90614_SIM_RAM_TA             UINT8_C(0x06)
+#define MLX90614_SIM_RAM_TOBJ1          UINT8_C(0x07)
+#define MLX90614_SIM_RAM_TOBJ2          UINT8_C(0x08)
+#define MLX90614_SIM_FLAG_EEBUSY        UINT16_C(0x0080)    //!< mlx90614 model, previous EEPROM erase or write in progress
+#define MLX90614_SIM_FLAG_INIT          UINT16_C(0x0010)    //!< mlx90614 model, power-on initialization completed (low active busy)
+#define MLX90614_SIM_EEPROM_SIZE        (32)
+#define MLX90614_SIM_EEPROM_CYCLE_US    (5000)              //!< mlx90614 model, erase or write cell time, see datasheet Terase and Twrite
+
+/**
+ * @brief MLX90614 model context structure definition.
+ */
+typedef struct mlx90614_sim_context_s {
+    uint16_t                    eeprom[MLX90614_SIM_EEPROM_SIZE];   /*!< mlx90614 model, EEPROM cells 0x20 to 0x3F */
+    uint8_t                     command;        /*!< mlx90614 model, command of the last write */
+    int64_t                     ready_time;     /*!< mlx90614 model, virtual time the EEPROM erase or write cycle in progress completes */
+    uint32_t                    eeprom_writes;  /*!< mlx90614 model, EEPROM erase and write cycles started */
+    float                       ambient;        /*!< mlx90614 model, ambient temperature input in degrees Celsius */
+    float                       object;         /*!< mlx90614 model, object temperature input in degrees Celsius */
+} mlx90614_sim_context_t;
+
+/**
+ * @brief Calculates the SMBus packet error code (polynomial 0x07, initialization 0x00).
+ */
+static inline uint8_t mlx90614_sim_pec(const uint8_t *buffer, const size_t size) {
+    uint8_t crc = 0x00;
+
+    for (size_t i = 0; i < size; i++) {
+        crc ^= buffer[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Encodes a temperature to the RAM format, 0.02 K per bit.
+ */
+static inline uint16_t mlx90614_sim_encode_temperature(const float temperature) {
+    return (uint16_t)fmin(fmax(lround(((double)temperature + 273.15) * 50.0), 0), 0x7fff);
+}
+
+static inline bool mlx90614_sim_eeprom_busy(const mlx90614_sim_context_t *const ctx) {
+    return i2c_sim_get_time_us() < ctx->ready_time;
+}
+
+static inline uint16_t mlx90614_sim_get_word(const mlx90614_sim_context_t *const ctx, const uint8_t command) {
+    if ((command & MLX90614_SIM_OPCODE_MASK) == MLX90614_SIM_OPCODE_EEPROM) {
+        return ctx->eeprom[command & 0x1f];
+    }
+
+    switch (command) {
+        case MLX90614_SIM_RAM_TA:           return mlx90614_sim_encode_temperature(ctx->ambient);
+        case MLX90614_SIM_RAM_TOBJ1:
+        case MLX90614_SIM_RAM_TOBJ2:        return mlx90614_sim_encode_temperature(ctx->object);
+        case MLX90614_SIM_CMD_READ_FLAGS:   return MLX90614_SIM_FLAG_INIT | (mlx90614_sim_eeprom_busy(ctx) ? MLX90614_SIM_FLAG_EEBUSY : 0);
+        default:                            return 0x0000;
+    }
+}
+
+static esp_err_t mlx90614_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    mlx90614_sim_context_t *ctx = (mlx90614_sim_context_t*)context;
+
+    ctx->command = buffer[0];
+
+    /* a read command or the sleep command carry no data */
+    if (size < 4) return ESP_OK;
+
+    /* the packet error code covers the address byte, command and data, a mismatch is not acknowledged */
+    const uint8_t packet[4] = { (uint8_t)(I2C_SIM_MLX90614_ADDRESS << 1), buffer[0], buffer[1], buffer[2] };
+    if (mlx90614_sim_pec(packet, sizeof(packet)) != buffer[3]) return ESP_ERR_INVALID_STATE;
+
+    /* only EEPROM cells are writable, a write is not acknowledged until the previous cycle completes */
+    if ((ctx->command & MLX90614_SIM_OPCODE_MASK) != MLX90614_SIM_OPCODE_EEPROM) return ESP_ERR_INVALID_STATE;
+    if (mlx90614_sim_eeprom_busy(ctx)) return ESP_ERR_INVALID_STATE;
+
+    /* only the customer cells of datasheet table 5 are writable */
+    const uint8_t cell = ctx->command & 0x1f;
+    if (cell <= 0x05 || cell == 0x0E || cell == 0x0F || cell == 0x19) {
+        ctx->eeprom[cell] = (uint16_t)buffer[1] | ((uint16_t)buffer[2] << 8);
+    }
+    ctx->ready_time = i2c_sim_get_time_us() + MLX90614_SIM_EEPROM_CYCLE_US;
+    ctx->eeprom_writes++;
+
+    return ESP_OK;
+}
+
+static esp_err_t mlx90614_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    mlx90614_sim_context_t *ctx = (mlx90614_sim_context_t*)context;
+
+    /* an EEPROM read is not acknowledged during an erase or write cycle */
+    if ((ctx->command & MLX90614_SIM_OPCODE_MASK) == MLX90614_SIM_OPCODE_EEPROM && mlx90614_sim_eeprom_busy(ctx)) return ESP_ERR_INVALID_STATE;
+
+    const uint16_t word = mlx90614_sim_get_word(ctx, ctx->command);
+    const uint8_t packet[5] = { (uint8_t)(I2C_SIM_MLX90614_ADDRESS << 1), ctx->command, (uint8_t)((I2C_SIM_MLX90614_ADDRESS << 1) | 1), 
+                                (uint8_t)(word & 0xff), (uint8_t)(word >> 8) };
+    const uint8_t response[3] = { packet[3], packet[4], mlx90614_sim_pec(packet, sizeof(packet)) };
+
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < sizeof(response)) ? response[i] : 0xff;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_mlx90614_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("mlx90614", sizeof(mlx90614_sim_context_t), mlx90614_sim_write, mlx90614_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    mlx90614_sim_context_t *ctx = (mlx90614_sim_context_t*)(*model)->context;
+
+    /* EEPROM layout of datasheet table 5, the emissivity cell holds the factory default of 1.0 */
+    ctx->eeprom[0x00] = 0x9993;                     // object temperature maximum
+    ctx->eeprom[0x01] = 0x62E3;                     // object temperature minimum
+    ctx->eeprom[0x02] = 0x0201;                     // pwm control
+    ctx->eeprom[0x03] = 0xF71C;                     // ambient temperature range
+    ctx->eeprom[0x04] = 0xFFFF;                     // emissivity of 1.0
+    ctx->eeprom[0x05] = 0x9FB4;                     // configuration register 1
+    ctx->eeprom[0x0E] = I2C_SIM_MLX90614_ADDRESS;   // SMBus address
+    ctx->eeprom[0x1C] = 0x1234;                     // identification numbers
+    ctx->eeprom[0x1D] = 0x5678;
+    ctx->eeprom[0x1E] = 0x9abc;
+    ctx->eeprom[0x1F] = 0xdef0;
+    ctx->ambient      = 25.0f;
+    ctx->object       = 25.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_mlx90614_set_temperatures(i2c_sim_model_t *const model, const float ambient_temperature, const float object_temperature) {
+    mlx90614_sim_context_t *ctx = (mlx90614_sim_context_t*)i2c_sim_model_get_context(model, mlx90614_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && ambient_temperature >= -40.0f && ambient_temperature <= 125.0f && object_temperature >= -70.0f && object_temperature <= 380.0f );
+
+    ctx->ambient = ambient_temperature;
+    ctx->object  = object_temperature;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_mlx90614_get_eeprom_writes(i2c_sim_model_t *const model, uint32_t *const writes) {
+    mlx90614_sim_context_t *ctx = (mlx90614_sim_context_t*)i2c_sim_model_get_context(model, mlx90614_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && writes );
+
+    *writes = ctx->eeprom_writes;
+
+    return ESP_OK;
+}
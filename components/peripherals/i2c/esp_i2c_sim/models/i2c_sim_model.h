@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_model.h
+ *
+ * Common helpers for the I2C simulator device models
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_SIM_MODEL_H__
+#define __I2C_SIM_MODEL_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <esp_err.h>
+#include "../include/i2c_sim.h"
+
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/**
+ * @brief Allocates a model and its zeroed context.
+ * 
+ * @param name Device name.
+ * @param context_size Context size in bytes.
+ * @param write Write transaction callback.
+ * @param read Read transaction callback.
+ * @param[out] model Created model, the context is released with the model.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_sim_model_new(const char *name, const size_t context_size, i2c_sim_model_write_t write, i2c_sim_model_read_t read, i2c_sim_model_t **const model) {
+    /* validate arguments */
+    ESP_ARG_CHECK( model );
+
+    i2c_sim_model_t *out = (i2c_sim_model_t*)calloc(1, sizeof(i2c_sim_model_t));
+    if (out == NULL) return ESP_ERR_NO_MEM;
+
+    out->context = calloc(1, context_size);
+    if (out->context == NULL) {
+        free(out);
+        return ESP_ERR_NO_MEM;
+    }
+
+    out->name    = name;
+    out->write   = write;
+    out->read    = read;
+    out->destroy = free;
+    *model       = out;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Gets the context of a model when the model is of the expected kind.
+ * 
+ * @param model Model.
+ * @param write Write transaction callback of the expected kind.
+ * @return void* Context, NULL when the model is of another kind.
+ */
+static inline void* i2c_sim_model_get_context(i2c_sim_model_t *const model, i2c_sim_model_write_t write) {
+    if (model == NULL || model->write != write) return NULL;
+    return model->context;
+}
+
+/**
+ * @brief Calculates a Sensirion style CRC-8 (polynomial 0x31, initialization 0xff).
+ * 
+ * @param buffer Bytes.
+ * @param size Number of bytes.
+ * @return uint8_t CRC-8.
+ */
+static inline uint8_t i2c_sim_model_crc8(const uint8_t *buffer, const size_t size) {
+    uint8_t crc = 0xff;
+
+    for (size_t i = 0; i < size; i++) {
+        crc ^= buffer[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Finds the raw value of a monotonic conversion by bisection.
+ * 
+ * @param convert Conversion from raw value to engineering units.
+ * @param context Conversion context.
+ * @param minimum Lowest raw value.
+ * @param maximum Highest raw value.
+ * @param target Engineering value.
+ * @return uint32_t Raw value converting closest to the target.
+ */
+static inline uint32_t i2c_sim_model_bisect(double (*convert)(const void*, uint32_t), const void *context, uint32_t minimum, uint32_t maximum, const double target) {
+    const bool increasing = convert(context, maximum) >= convert(context, minimum);
+
+    while (maximum - minimum > 1) {
+        const uint32_t middle = minimum + (maximum - minimum) / 2;
+        if ((convert(context, middle) < target) == increasing) {
+            minimum = middle;
+        } else {
+            maximum = middle;
+        }
+    }
+
+    return (fabs(convert(context, minimum) - target) <= fabs(convert(context, maximum) - target)) ? minimum : maximum;
+}
+
+#endif  // __I2C_SIM_MODEL_H__
@@ -0,0 +1,319 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_mpu6050.c
+ *
+ * MPU6050 motion sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * MPU6050 model definitions
+*/
+#define MPU6050_SIM_REG_SMPLRT_DIV      UINT8_C(0x19)
+#define MPU6050_SIM_REG_CONFIG          UINT8_C(0x1A)
+#define MPU6050_SIM_REG_GYRO_CONFIG     UINT8_C(0x1B)
+#define MPU6050_SIM_REG_ACCEL_CONFIG    UINT8_C(0x1C)
+#define MPU6050_SIM_REG_MOT_THR         UINT8_C(0x1F)
+#define MPU6050_SIM_REG_FIFO_EN         UINT8_C(0x23)
+#define MPU6050_SIM_REG_INT_ENABLE      UINT8_C(0x38)
+#define MPU6050_SIM_REG_INT_STATUS      UINT8_C(0x3A)
+#define MPU6050_SIM_REG_ACCEL_XOUT_H    UINT8_C(0x3B)
+#define MPU6050_SIM_REG_TEMP_OUT_H      UINT8_C(0x41)
+#define MPU6050_SIM_REG_GYRO_XOUT_H     UINT8_C(0x43)
+#define MPU6050_SIM_REG_USER_CTRL       UINT8_C(0x6A)
+#define MPU6050_SIM_REG_PWR_MGMT_1      UINT8_C(0x6B)
+#define MPU6050_SIM_REG_FIFO_COUNT_H    UINT8_C(0x72)
+#define MPU6050_SIM_REG_FIFO_COUNT_L    UINT8_C(0x73)
+#define MPU6050_SIM_REG_FIFO_R_W        UINT8_C(0x74)
+#define MPU6050_SIM_REG_WHO_AM_I        UINT8_C(0x75)
+#define MPU6050_SIM_WHO_AM_I            UINT8_C(0x68)
+#define MPU6050_SIM_PWR_MGMT_1_DEFAULT  UINT8_C(0x40)       //!< mpu6050 model, power-on state is sleep
+#define MPU6050_SIM_PWR_DEVICE_RESET    UINT8_C(0x80)
+#define MPU6050_SIM_PWR_SLEEP           UINT8_C(0x40)
+#define MPU6050_SIM_USER_FIFO_EN        UINT8_C(0x40)
+#define MPU6050_SIM_USER_FIFO_RESET     UINT8_C(0x04)
+#define MPU6050_SIM_USER_SIG_COND_RESET UINT8_C(0x01)
+#define MPU6050_SIM_FIFO_EN_TEMP        UINT8_C(0x80)
+#define MPU6050_SIM_FIFO_EN_XG          UINT8_C(0x40)
+#define MPU6050_SIM_FIFO_EN_YG          UINT8_C(0x20)
+#define MPU6050_SIM_FIFO_EN_ZG          UINT8_C(0x10)
+#define MPU6050_SIM_FIFO_EN_ACCEL       UINT8_C(0x08)
+#define MPU6050_SIM_INT_MOT             UINT8_C(0x40)
+#define MPU6050_SIM_INT_FIFO_OFLOW      UINT8_C(0x10)
+#define MPU6050_SIM_INT_DATA_RDY        UINT8_C(0x01)
+#define MPU6050_SIM_MOT_THR_LSB_G       (0.002)             //!< mpu6050 model, motion threshold resolution in g
+#define MPU6050_SIM_FIFO_SIZE           UINT16_C(1024)
+#define MPU6050_SIM_PENDING_MAX         UINT32_C(1024)      //!< mpu6050 model, most samples replayed at once, enough to overflow the FIFO
+
+/**
+ * @brief MPU6050 model context structure definition.
+ */
+typedef struct mpu6050_sim_context_s {
+    uint8_t                     regs[128];          /*!< mpu6050 model, register file */
+    uint8_t                     pointer;            /*!< mpu6050 model, register pointer */
+    int64_t                     sample_time;        /*!< mpu6050 model, virtual time of the last sample */
+    uint8_t                     fifo[MPU6050_SIM_FIFO_SIZE]; /*!< mpu6050 model, FIFO ring buffer */
+    uint16_t                    fifo_head;          /*!< mpu6050 model, FIFO index of the oldest byte */
+    uint16_t                    fifo_count;         /*!< mpu6050 model, FIFO fill level in bytes */
+    float                       accel[3];           /*!< mpu6050 model, acceleration input in g */
+    float                       motion_accel[3];    /*!< mpu6050 model, acceleration of the last sample for motion detection in g */
+    float                       gyro[3];            /*!< mpu6050 model, angular rate input in degrees per second */
+    float                       temperature;        /*!< mpu6050 model, temperature input in degrees Celsius */
+} mpu6050_sim_context_t;
+
+/**
+ * @brief Gets the sample period, see register map section 4.2.
+ */
+static inline int64_t mpu6050_sim_get_sample_period(const mpu6050_sim_context_t *const ctx) {
+    const uint8_t dlpf = ctx->regs[MPU6050_SIM_REG_CONFIG] & 0x07;
+    const int64_t gyro_output_rate = (dlpf == 0 || dlpf == 7) ? 8000 : 1000;
+
+    return (1000000LL * (1 + ctx->regs[MPU6050_SIM_REG_SMPLRT_DIV])) / gyro_output_rate;
+}
+
+/**
+ * @brief Stores a signed 16-bit big-endian value, saturated.
+ */
+static inline void mpu6050_sim_set_i16(uint8_t *const buffer, const double value) {
+    const int16_t raw = (int16_t)fmin(fmax(lround(value), -32768), 32767);
+
+    buffer[0] = (uint8_t)((uint16_t)raw >> 8);
+    buffer[1] = (uint8_t)((uint16_t)raw & 0xff);
+}
+
+/**
+ * @brief Appends bytes to the FIFO, the oldest bytes are dropped on overflow.
+ */
+static inline void mpu6050_sim_push_fifo(mpu6050_sim_context_t *const ctx, const uint8_t *buffer, const uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        if (ctx->fifo_count == MPU6050_SIM_FIFO_SIZE) {
+            ctx->fifo_head = (ctx->fifo_head + 1) % MPU6050_SIM_FIFO_SIZE;
+            ctx->fifo_count--;
+            ctx->regs[MPU6050_SIM_REG_INT_STATUS] |= MPU6050_SIM_INT_FIFO_OFLOW;
+        }
+        ctx->fifo[(ctx->fifo_head + ctx->fifo_count) % MPU6050_SIM_FIFO_SIZE] = buffer[i];
+        ctx->fifo_count++;
+    }
+}
+
+/**
+ * @brief Converts the inputs into the sensor data registers and writes the enabled 
+ * registers to the FIFO in register order.
+ */
+static inline void mpu6050_sim_sample(mpu6050_sim_context_t *const ctx) {
+    const double accel_sensitivity = 16384.0 / (double)(1 << ((ctx->regs[MPU6050_SIM_REG_ACCEL_CONFIG] >> 3) & 0x03));
+    const double gyro_sensitivity  = 131.0 / (double)(1 << ((ctx->regs[MPU6050_SIM_REG_GYRO_CONFIG] >> 3) & 0x03));
+    const uint8_t fifo_en = ctx->regs[MPU6050_SIM_REG_FIFO_EN];
+
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        mpu6050_sim_set_i16(&ctx->regs[MPU6050_SIM_REG_ACCEL_XOUT_H + axis * 2], (double)ctx->accel[axis] * accel_sensitivity);
+        mpu6050_sim_set_i16(&ctx->regs[MPU6050_SIM_REG_GYRO_XOUT_H + axis * 2], (double)ctx->gyro[axis] * gyro_sensitivity);
+    }
+    mpu6050_sim_set_i16(&ctx->regs[MPU6050_SIM_REG_TEMP_OUT_H], ((double)ctx->temperature - 36.53) * 340.0);
+
+    ctx->regs[MPU6050_SIM_REG_INT_STATUS] |= MPU6050_SIM_INT_DATA_RDY;
+
+    /* motion is an acceleration step above the threshold between samples, the duration counter is not modelled */
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        const double step = fabs((double)ctx->accel[axis] - (double)ctx->motion_accel[axis]);
+
+        if ((ctx->regs[MPU6050_SIM_REG_INT_ENABLE] & MPU6050_SIM_INT_MOT) && step > ctx->regs[MPU6050_SIM_REG_MOT_THR] * MPU6050_SIM_MOT_THR_LSB_G) {
+            ctx->regs[MPU6050_SIM_REG_INT_STATUS] |= MPU6050_SIM_INT_MOT;
+        }
+        ctx->motion_accel[axis] = ctx->accel[axis];
+    }
+
+    if ((ctx->regs[MPU6050_SIM_REG_USER_CTRL] & MPU6050_SIM_USER_FIFO_EN) == 0) return;
+
+    if (fifo_en & MPU6050_SIM_FIFO_EN_ACCEL) mpu6050_sim_push_fifo(ctx, &ctx->regs[MPU6050_SIM_REG_ACCEL_XOUT_H], 6);
+    if (fifo_en & MPU6050_SIM_FIFO_EN_TEMP)  mpu6050_sim_push_fifo(ctx, &ctx->regs[MPU6050_SIM_REG_TEMP_OUT_H], 2);
+    if (fifo_en & MPU6050_SIM_FIFO_EN_XG)    mpu6050_sim_push_fifo(ctx, &ctx->regs[MPU6050_SIM_REG_GYRO_XOUT_H], 2);
+    if (fifo_en & MPU6050_SIM_FIFO_EN_YG)    mpu6050_sim_push_fifo(ctx, &ctx->regs[MPU6050_SIM_REG_GYRO_XOUT_H + 2], 2);
+    if (fifo_en & MPU6050_SIM_FIFO_EN_ZG)    mpu6050_sim_push_fifo(ctx, &ctx->regs[MPU6050_SIM_REG_GYRO_XOUT_H + 4], 2);
+}
+
+/**
+ * @brief Generates the samples due since the last sample at the sample rate.
+ */
+static inline void mpu6050_sim_update(mpu6050_sim_context_t *const ctx) {
+    const int64_t now = i2c_sim_get_time_us();
+
+    /* sleep mode does not sample */
+    if (ctx->regs[MPU6050_SIM_REG_PWR_MGMT_1] & MPU6050_SIM_PWR_SLEEP) {
+        ctx->sample_time = now;
+        return;
+    }
+
+    const int64_t period = mpu6050_sim_get_sample_period(ctx);
+    const int64_t due = (now - ctx->sample_time) / period;
+
+    if (due <= 0) return;
+
+    ctx->sample_time += due * period;
+    for (int64_t i = (due > MPU6050_SIM_PENDING_MAX) ? due - MPU6050_SIM_PENDING_MAX : 0; i < due; i++) {
+        mpu6050_sim_sample(ctx);
+    }
+}
+
+/**
+ * @brief Restores the power-on register state.
+ */
+static inline void mpu6050_sim_reset(mpu6050_sim_context_t *const ctx) {
+    memset(ctx->regs, 0, sizeof(ctx->regs));
+
+    ctx->regs[MPU6050_SIM_REG_PWR_MGMT_1] = MPU6050_SIM_PWR_MGMT_1_DEFAULT;
+    ctx->regs[MPU6050_SIM_REG_WHO_AM_I]   = MPU6050_SIM_WHO_AM_I;
+    ctx->fifo_head   = 0;
+    ctx->fifo_count  = 0;
+    ctx->sample_time = i2c_sim_get_time_us();
+}
+
+static esp_err_t mpu6050_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    mpu6050_sim_context_t *ctx = (mpu6050_sim_context_t*)context;
+
+    mpu6050_sim_update(ctx);
+
+    ctx->pointer = buffer[0] & 0x7f;
+    for (size_t i = 1; i < size; i++) {
+        const uint8_t reg = ctx->pointer;
+
+        switch (reg) {
+            case MPU6050_SIM_REG_PWR_MGMT_1:
+                if (buffer[i] & MPU6050_SIM_PWR_DEVICE_RESET) {
+                    mpu6050_sim_reset(ctx);
+                } else {
+                    ctx->regs[reg] = buffer[i];
+                    ctx->sample_time = i2c_sim_get_time_us();
+                }
+                break;
+            case MPU6050_SIM_REG_USER_CTRL:
+                /* reset bits clear themselves */
+                if (buffer[i] & MPU6050_SIM_USER_FIFO_RESET) {
+                    ctx->fifo_head  = 0;
+                    ctx->fifo_count = 0;
+                }
+                ctx->regs[reg] = buffer[i] & (uint8_t)~(MPU6050_SIM_USER_FIFO_RESET | MPU6050_SIM_USER_SIG_COND_RESET | 0x02);
+                break;
+            case MPU6050_SIM_REG_FIFO_R_W:
+                mpu6050_sim_push_fifo(ctx, &buffer[i], 1);
+                break;
+            case MPU6050_SIM_REG_INT_STATUS:
+            case MPU6050_SIM_REG_FIFO_COUNT_H:
+            case MPU6050_SIM_REG_FIFO_COUNT_L:
+            case MPU6050_SIM_REG_WHO_AM_I:
+                /* read-only registers ignore writes */
+                break;
+            default:
+                /* sensor data registers are read-only */
+                if (reg < MPU6050_SIM_REG_ACCEL_XOUT_H || reg > 0x60) ctx->regs[reg] = buffer[i];
+                break;
+        }
+
+        /* the FIFO data register does not auto-increment */
+        if (reg != MPU6050_SIM_REG_FIFO_R_W) ctx->pointer = (ctx->pointer + 1) & 0x7f;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t mpu6050_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    mpu6050_sim_context_t *ctx = (mpu6050_sim_context_t*)context;
+    uint8_t clear_int_status = 0;
+
+    mpu6050_sim_update(ctx);
+
+    for (size_t i = 0; i < size; i++) {
+        const uint8_t reg = ctx->pointer;
+
+        switch (reg) {
+            case MPU6050_SIM_REG_FIFO_R_W:
+                if (ctx->fifo_count) {
+                    buffer[i] = ctx->fifo[ctx->fifo_head];
+                    ctx->fifo_head = (ctx->fifo_head + 1) % MPU6050_SIM_FIFO_SIZE;
+                    ctx->fifo_count--;
+                } else {
+                    buffer[i] = 0xff;
+                }
+                break;
+            case MPU6050_SIM_REG_FIFO_COUNT_H:
+                buffer[i] = (uint8_t)(ctx->fifo_count >> 8);
+                break;
+            case MPU6050_SIM_REG_FIFO_COUNT_L:
+                buffer[i] = (uint8_t)(ctx->fifo_count & 0xff);
+                break;
+            case MPU6050_SIM_REG_INT_STATUS:
+                buffer[i] = ctx->regs[reg];
+                clear_int_status = buffer[i];
+                break;
+            default:
+                buffer[i] = ctx->regs[reg];
+                break;
+        }
+
+        if (reg != MPU6050_SIM_REG_FIFO_R_W) ctx->pointer = (ctx->pointer + 1) & 0x7f;
+    }
+
+    /* interrupt status clears after it is read */
+    ctx->regs[MPU6050_SIM_REG_INT_STATUS] &= (uint8_t)~clear_int_status;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_mpu6050_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("mpu6050", sizeof(mpu6050_sim_context_t), mpu6050_sim_write, mpu6050_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    mpu6050_sim_context_t *ctx = (mpu6050_sim_context_t*)(*model)->context;
+
+    mpu6050_sim_reset(ctx);
+    ctx->accel[2]    = 1.0f;
+    ctx->temperature = 25.0f;
+    memcpy(ctx->motion_accel, ctx->accel, sizeof(ctx->motion_accel));
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_mpu6050_set_motion(i2c_sim_model_t *const model, const float accel[3], const float gyro[3], const float temperature) {
+    mpu6050_sim_context_t *ctx = (mpu6050_sim_context_t*)i2c_sim_model_get_context(model, mpu6050_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && accel && gyro );
+
+    /* samples due before the change keep the previous motion */
+    mpu6050_sim_update(ctx);
+
+    memcpy(ctx->accel, accel, sizeof(ctx->accel));
+    memcpy(ctx->gyro, gyro, sizeof(ctx->gyro));
+    ctx->temperature = temperature;
+
+    return ESP_OK;
+}
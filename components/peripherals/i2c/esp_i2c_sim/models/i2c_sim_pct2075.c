@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_pct2075.c
+ *
+ * PCT2075 temperature sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * PCT2075 model definitions
+*/
+#define PCT2075_SIM_REG_TEMP            UINT8_C(0x00)
+#define PCT2075_SIM_REG_CONF            UINT8_C(0x01)
+#define PCT2075_SIM_REG_THYST           UINT8_C(0x02)
+#define PCT2075_SIM_REG_TOS             UINT8_C(0x03)
+#define PCT2075_SIM_REG_TIDLE           UINT8_C(0x04)
+#define PCT2075_SIM_CONF_SHUTDOWN       UINT8_C(0x01)
+#define PCT2075_SIM_TIDLE_MASK          UINT8_C(0x1F)
+#define PCT2075_SIM_CONVERSION_US       (28000)     //!< pct2075 model, temperature conversion time tconv(T), see datasheet section 7.1
+#define PCT2075_SIM_TIDLE_STEP_US       (100000)    //!< pct2075 model, sampling period step of the idle register
+
+/**
+ * @brief PCT2075 model context structure definition.
+ */
+typedef struct pct2075_sim_context_s {
+    uint8_t                     pointer;        /*!< pct2075 model, register pointer */
+    uint8_t                     conf;           /*!< pct2075 model, configuration register */
+    uint8_t                     tidle;          /*!< pct2075 model, temperature idle register */
+    uint16_t                    thyst;          /*!< pct2075 model, hysteresis register */
+    uint16_t                    tos;            /*!< pct2075 model, overtemperature shutdown register */
+    uint16_t                    temp;           /*!< pct2075 model, temperature register */
+    int64_t                     ready_time;     /*!< pct2075 model, virtual time the next conversion completes */
+    float                       temperature;    /*!< pct2075 model, temperature input in degrees Celsius */
+} pct2075_sim_context_t;
+
+static inline int64_t pct2075_sim_get_period_us(const pct2075_sim_context_t *const ctx) {
+    const uint8_t tidle = ctx->tidle & PCT2075_SIM_TIDLE_MASK;
+
+    /* an idle value of 0 is treated as 1 */
+    return (int64_t)(tidle == 0 ? 1 : tidle) * PCT2075_SIM_TIDLE_STEP_US;
+}
+
+/**
+ * @brief Updates the temperature register with the conversions completed by the virtual time.
+ */
+static inline void pct2075_sim_update(pct2075_sim_context_t *const ctx) {
+    const int64_t now = i2c_sim_get_time_us();
+
+    if ((ctx->conf & PCT2075_SIM_CONF_SHUTDOWN) || now < ctx->ready_time) return;
+
+    /* 11-bit two's complement with 0.125 degrees Celsius resolution, left aligned */
+    const long steps = lround(fmin(fmax((double)ctx->temperature, -55.0), 125.0) / 0.125);
+    ctx->temp = (uint16_t)((uint16_t)(int16_t)steps << 5);
+
+    while (ctx->ready_time <= now) {
+        ctx->ready_time += pct2075_sim_get_period_us(ctx);
+    }
+}
+
+static esp_err_t pct2075_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    pct2075_sim_context_t *ctx = (pct2075_sim_context_t*)context;
+
+    pct2075_sim_update(ctx);
+
+    ctx->pointer = buffer[0] & 0x07;
+
+    if (size < 2) return ESP_OK;
+
+    switch (ctx->pointer) {
+        case PCT2075_SIM_REG_CONF:
+            /* leaving shutdown initiates a conversion */
+            if ((ctx->conf & PCT2075_SIM_CONF_SHUTDOWN) && !(buffer[1] & PCT2075_SIM_CONF_SHUTDOWN)) {
+                ctx->ready_time = i2c_sim_get_time_us() + PCT2075_SIM_CONVERSION_US;
+            }
+            ctx->conf = buffer[1];
+            break;
+        case PCT2075_SIM_REG_TIDLE:
+            ctx->tidle = buffer[1] & PCT2075_SIM_TIDLE_MASK;
+            break;
+        case PCT2075_SIM_REG_THYST:
+            if (size >= 3) ctx->thyst = (uint16_t)(((uint16_t)buffer[1] << 8) | buffer[2]) & 0xff80;
+            break;
+        case PCT2075_SIM_REG_TOS:
+            if (size >= 3) ctx->tos = (uint16_t)(((uint16_t)buffer[1] << 8) | buffer[2]) & 0xff80;
+            break;
+        default:
+            break;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t pct2075_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    pct2075_sim_context_t *ctx = (pct2075_sim_context_t*)context;
+    uint8_t response[2] = { 0xff, 0xff };
+
+    pct2075_sim_update(ctx);
+
+    switch (ctx->pointer) {
+        case PCT2075_SIM_REG_TEMP:
+            response[0] = (uint8_t)(ctx->temp >> 8);
+            response[1] = (uint8_t)(ctx->temp & 0xff);
+            break;
+        case PCT2075_SIM_REG_CONF:
+            response[0] = ctx->conf;
+            break;
+        case PCT2075_SIM_REG_THYST:
+            response[0] = (uint8_t)(ctx->thyst >> 8);
+            response[1] = (uint8_t)(ctx->thyst & 0xff);
+            break;
+        case PCT2075_SIM_REG_TOS:
+            response[0] = (uint8_t)(ctx->tos >> 8);
+            response[1] = (uint8_t)(ctx->tos & 0xff);
+            break;
+        case PCT2075_SIM_REG_TIDLE:
+            response[0] = ctx->tidle;
+            break;
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < sizeof(response)) ? response[i] : 0xff;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_pct2075_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("pct2075", sizeof(pct2075_sim_context_t), pct2075_sim_write, pct2075_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    pct2075_sim_context_t *ctx = (pct2075_sim_context_t*)(*model)->context;
+
+    /* power-on reset state, see datasheet table 7, the first conversion starts at creation */
+    ctx->tidle       = 0x01;
+    ctx->thyst       = 0x4B00;
+    ctx->tos         = 0x5000;
+    ctx->ready_time  = i2c_sim_get_time_us() + PCT2075_SIM_CONVERSION_US;
+    ctx->temperature = 25.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_pct2075_set_temperature(i2c_sim_model_t *const model, const float temperature) {
+    pct2075_sim_context_t *ctx = (pct2075_sim_context_t*)i2c_sim_model_get_context(model, pct2075_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -55.0f && temperature <= 125.0f );
+
+    ctx->temperature = temperature;
+
+    return ESP_OK;
+}
@@ -0,0 +1,181 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_sht4x.c
+ *
+ * SHT4x temperature and humidity sensor model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * SHT4x model definitions
+*/
+#define SHT4X_SIM_CMD_RESET             UINT8_C(0x94)
+#define SHT4X_SIM_CMD_SERIAL            UINT8_C(0x89)
+#define SHT4X_SIM_CMD_MEAS_HIGH         UINT8_C(0xFD)
+#define SHT4X_SIM_CMD_MEAS_MED          UINT8_C(0xF6)
+#define SHT4X_SIM_CMD_MEAS_LOW          UINT8_C(0xE0)
+#define SHT4X_SIM_CMD_HEATER_HIGH_LONG  UINT8_C(0x39)
+#define SHT4X_SIM_CMD_HEATER_HIGH_SHORT UINT8_C(0x32)
+#define SHT4X_SIM_CMD_HEATER_MED_LONG   UINT8_C(0x2F)
+#define SHT4X_SIM_CMD_HEATER_MED_SHORT  UINT8_C(0x24)
+#define SHT4X_SIM_CMD_HEATER_LOW_LONG   UINT8_C(0x1E)
+#define SHT4X_SIM_CMD_HEATER_LOW_SHORT  UINT8_C(0x15)
+#define SHT4X_SIM_SERIAL_NUMBER         UINT32_C(0x0BADCAFE)
+#define SHT4X_SIM_RESET_US              UINT32_C(1000)      //!< sht4x model, soft reset time, see datasheet table 5
+#define SHT4X_SIM_MEAS_HIGH_US          UINT32_C(8300)      //!< sht4x model, high repeatability measurement time
+#define SHT4X_SIM_MEAS_MED_US           UINT32_C(4500)      //!< sht4x model, medium repeatability measurement time
+#define SHT4X_SIM_MEAS_LOW_US           UINT32_C(1600)      //!< sht4x model, low repeatability measurement time
+#define SHT4X_SIM_HEATER_LONG_US        UINT32_C(1100000)   //!< sht4x model, 1 s heater pulse and measurement time
+#define SHT4X_SIM_HEATER_SHORT_US       UINT32_C(110000)    //!< sht4x model, 0.1 s heater pulse and measurement time
+
+/**
+ * @brief SHT4x model context structure definition.
+ */
+typedef struct sht4x_sim_context_s {
+    int64_t                     ready_time;     /*!< sht4x model, virtual time the command in progress completes */
+    uint8_t                     response[6];    /*!< sht4x model, response of the last command */
+    bool                        response_valid; /*!< sht4x model, response is pending when true */
+    float                       temperature;    /*!< sht4x model, temperature input in degrees Celsius */
+    float                       humidity;       /*!< sht4x model, relative humidity input in percent */
+} sht4x_sim_context_t;
+
+/**
+ * @brief Stores two 16-bit words with their CRC-8 as a 6 byte response.
+ */
+static inline void sht4x_sim_set_response(sht4x_sim_context_t *const ctx, const uint16_t word1, const uint16_t word2) {
+    ctx->response[0] = (uint8_t)(word1 >> 8);
+    ctx->response[1] = (uint8_t)(word1 & 0xff);
+    ctx->response[2] = i2c_sim_model_crc8(&ctx->response[0], 2);
+    ctx->response[3] = (uint8_t)(word2 >> 8);
+    ctx->response[4] = (uint8_t)(word2 & 0xff);
+    ctx->response[5] = i2c_sim_model_crc8(&ctx->response[3], 2);
+    ctx->response_valid = true;
+}
+
+/**
+ * @brief Converts the inputs to raw signal words, see datasheet section 4.6.
+ */
+static inline void sht4x_sim_measure(sht4x_sim_context_t *const ctx) {
+    const double t_ticks  = ((double)ctx->temperature + 45.0) * 65535.0 / 175.0;
+    const double rh_ticks = ((double)ctx->humidity + 6.0) * 65535.0 / 125.0;
+
+    sht4x_sim_set_response(ctx, (uint16_t)fmin(fmax(lround(t_ticks), 0), 65535), (uint16_t)fmin(fmax(lround(rh_ticks), 0), 65535));
+}
+
+static esp_err_t sht4x_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    sht4x_sim_context_t *ctx = (sht4x_sim_context_t*)context;
+    const int64_t now = i2c_sim_get_time_us();
+    uint32_t busy_us = 0;
+
+    /* the sensor does not acknowledge its address while a command is in progress */
+    if (now < ctx->ready_time) return ESP_ERR_INVALID_STATE;
+
+    ctx->response_valid = false;
+
+    switch (buffer[0]) {
+        case SHT4X_SIM_CMD_RESET:
+            busy_us = SHT4X_SIM_RESET_US;
+            break;
+        case SHT4X_SIM_CMD_SERIAL:
+            sht4x_sim_set_response(ctx, (uint16_t)(SHT4X_SIM_SERIAL_NUMBER >> 16), (uint16_t)(SHT4X_SIM_SERIAL_NUMBER & 0xffff));
+            break;
+        case SHT4X_SIM_CMD_MEAS_HIGH:
+            busy_us = SHT4X_SIM_MEAS_HIGH_US;
+            sht4x_sim_measure(ctx);
+            break;
+        case SHT4X_SIM_CMD_MEAS_MED:
+            busy_us = SHT4X_SIM_MEAS_MED_US;
+            sht4x_sim_measure(ctx);
+            break;
+        case SHT4X_SIM_CMD_MEAS_LOW:
+            busy_us = SHT4X_SIM_MEAS_LOW_US;
+            sht4x_sim_measure(ctx);
+            break;
+        case SHT4X_SIM_CMD_HEATER_HIGH_LONG:
+        case SHT4X_SIM_CMD_HEATER_MED_LONG:
+        case SHT4X_SIM_CMD_HEATER_LOW_LONG:
+            busy_us = SHT4X_SIM_HEATER_LONG_US;
+            sht4x_sim_measure(ctx);
+            break;
+        case SHT4X_SIM_CMD_HEATER_HIGH_SHORT:
+        case SHT4X_SIM_CMD_HEATER_MED_SHORT:
+        case SHT4X_SIM_CMD_HEATER_LOW_SHORT:
+            busy_us = SHT4X_SIM_HEATER_SHORT_US;
+            sht4x_sim_measure(ctx);
+            break;
+        default:
+            /* unknown commands are not acknowledged */
+            return ESP_ERR_INVALID_STATE;
+    }
+
+    ctx->ready_time = now + busy_us;
+
+    return ESP_OK;
+}
+
+static esp_err_t sht4x_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    sht4x_sim_context_t *ctx = (sht4x_sim_context_t*)context;
+
+    /* a read header is not acknowledged while busy or without a pending response */
+    if (i2c_sim_get_time_us() < ctx->ready_time || ctx->response_valid == false) return ESP_ERR_INVALID_STATE;
+
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = (i < sizeof(ctx->response)) ? ctx->response[i] : 0xff;
+    }
+    ctx->response_valid = false;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_sht4x_create(i2c_sim_model_t **const model) {
+    esp_err_t ret = i2c_sim_model_new("sht4x", sizeof(sht4x_sim_context_t), sht4x_sim_write, sht4x_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    sht4x_sim_context_t *ctx = (sht4x_sim_context_t*)(*model)->context;
+
+    ctx->temperature = 25.0f;
+    ctx->humidity    = 50.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_sht4x_set_environment(i2c_sim_model_t *const model, const float temperature, const float humidity) {
+    sht4x_sim_context_t *ctx = (sht4x_sim_context_t*)i2c_sim_model_get_context(model, sht4x_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && temperature >= -40.0f && temperature <= 125.0f && humidity >= 0.0f && humidity <= 100.0f );
+
+    ctx->temperature = temperature;
+    ctx->humidity    = humidity;
+
+    return ESP_OK;
+}
@@ -0,0 +1,227 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_sim_ssd1306.c
+ *
+ * SSD1306 display controller model for the I2C simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "i2c_sim_model.h"
+#include "../include/i2c_sim_models.h"
+#include <string.h>
+
+/*
+ * SSD1306 model definitions
+*/
+#define SSD1306_SIM_CONTROL_CO          UINT8_C(0x80)       //!< ssd1306 model, continuation bit, one byte follows the control byte
+#define SSD1306_SIM_CONTROL_DC          UINT8_C(0x40)       //!< ssd1306 model, data or command selection bit
+#define SSD1306_SIM_ADDR_MODE_HORIZONTAL UINT8_C(0x00)
+#define SSD1306_SIM_ADDR_MODE_VERTICAL  UINT8_C(0x01)
+#define SSD1306_SIM_ADDR_MODE_PAGE      UINT8_C(0x02)
+
+/**
+ * @brief SSD1306 model context structure definition.
+ */
+typedef struct ssd1306_sim_context_s {
+    uint8_t                     ram[I2C_SIM_SSD1306_PAGES][I2C_SIM_SSD1306_WIDTH]; /*!< ssd1306 model, graphic display data RAM */
+    uint8_t                     height;             /*!< ssd1306 model, display height in pixels */
+    bool                        display_on;         /*!< ssd1306 model, display is on when true */
+    uint8_t                     addr_mode;          /*!< ssd1306 model, memory addressing mode */
+    uint8_t                     column;             /*!< ssd1306 model, column address pointer */
+    uint8_t                     page;               /*!< ssd1306 model, page address pointer */
+    uint8_t                     column_start;       /*!< ssd1306 model, horizontal and vertical mode column start */
+    uint8_t                     column_end;         /*!< ssd1306 model, horizontal and vertical mode column end */
+    uint8_t                     page_start;         /*!< ssd1306 model, horizontal and vertical mode page start */
+    uint8_t                     page_end;           /*!< ssd1306 model, horizontal and vertical mode page end */
+    uint8_t                     command;            /*!< ssd1306 model, command awaiting arguments */
+    uint8_t                     args[6];            /*!< ssd1306 model, arguments of the command received so far */
+    uint8_t                     arg_count;          /*!< ssd1306 model, number of arguments received */
+    uint8_t                     arg_total;          /*!< ssd1306 model, number of arguments of the command */
+} ssd1306_sim_context_t;
+
+/**
+ * @brief Gets the number of argument bytes of a command, see datasheet section 9.
+ */
+static inline uint8_t ssd1306_sim_get_arg_count(const uint8_t command) {
+    switch (command) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Executes a command with its arguments.
+ */
+static inline void ssd1306_sim_execute(ssd1306_sim_context_t *const ctx, const uint8_t command, const uint8_t *args) {
+    if (command <= 0x0F) {
+        ctx->column = (ctx->column & 0xF0) | command;
+    } else if (command <= 0x1F) {
+        ctx->column = (uint8_t)(((command & 0x07) << 4) | (ctx->column & 0x0F));
+    } else if (command >= 0xB0 && command <= 0xB7) {
+        ctx->page = command & 0x07;
+    } else if (command == 0x20) {
+        ctx->addr_mode = args[0] & 0x03;
+    } else if (command == 0x21) {
+        ctx->column_start = ctx->column = args[0] & 0x7F;
+        ctx->column_end   = args[1] & 0x7F;
+    } else if (command == 0x22) {
+        ctx->page_start = ctx->page = args[0] & 0x07;
+        ctx->page_end   = args[1] & 0x07;
+    } else if (command == 0xAE || command == 0xAF) {
+        ctx->display_on = (command == 0xAF);
+    }
+    /* contrast, scrolling, hardware configuration and timing commands do not change the RAM */
+}
+
+/**
+ * @brief Parses a command or argument byte.
+ */
+static inline void ssd1306_sim_command(ssd1306_sim_context_t *const ctx, const uint8_t value) {
+    if (ctx->arg_total) {
+        ctx->args[ctx->arg_count++] = value;
+        if (ctx->arg_count == ctx->arg_total) {
+            ssd1306_sim_execute(ctx, ctx->command, ctx->args);
+            ctx->arg_total = 0;
+        }
+        return;
+    }
+
+    ctx->command   = value;
+    ctx->arg_count = 0;
+    ctx->arg_total = ssd1306_sim_get_arg_count(value);
+    if (ctx->arg_total == 0) ssd1306_sim_execute(ctx, value, ctx->args);
+}
+
+/**
+ * @brief Writes a display data byte and advances the address pointers, see datasheet section 10.1.3.
+ */
+static inline void ssd1306_sim_data(ssd1306_sim_context_t *const ctx, const uint8_t value) {
+    ctx->ram[ctx->page][ctx->column] = value;
+
+    switch (ctx->addr_mode) {
+        case SSD1306_SIM_ADDR_MODE_HORIZONTAL:
+            if (ctx->column++ >= ctx->column_end) {
+                ctx->column = ctx->column_start;
+                ctx->page   = (ctx->page >= ctx->page_end) ? ctx->page_start : ctx->page + 1;
+            }
+            break;
+        case SSD1306_SIM_ADDR_MODE_VERTICAL:
+            if (ctx->page++ >= ctx->page_end) {
+                ctx->page   = ctx->page_start;
+                ctx->column = (ctx->column >= ctx->column_end) ? ctx->column_start : ctx->column + 1;
+            }
+            break;
+        default:
+            /* page addressing mode wraps within the page */
+            ctx->column = (ctx->column + 1) % I2C_SIM_SSD1306_WIDTH;
+            break;
+    }
+}
+
+static esp_err_t ssd1306_sim_write(void *context, const uint8_t *buffer, const size_t size) {
+    ssd1306_sim_context_t *ctx = (ssd1306_sim_context_t*)context;
+    size_t index = 0;
+
+    /* each control byte with the continuation bit is followed by one byte, without it the 
+       remaining bytes are a command or data stream */
+    while (index < size) {
+        const uint8_t control = buffer[index++];
+        const bool data = (control & SSD1306_SIM_CONTROL_DC) != 0;
+        const size_t end = (control & SSD1306_SIM_CONTROL_CO) ? ((index + 1 < size) ? index + 1 : size) : size;
+
+        for (; index < end; index++) {
+            if (data) {
+                ssd1306_sim_data(ctx, buffer[index]);
+            } else {
+                ssd1306_sim_command(ctx, buffer[index]);
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t ssd1306_sim_read(void *context, uint8_t *buffer, const size_t size) {
+    ssd1306_sim_context_t *ctx = (ssd1306_sim_context_t*)context;
+
+    /* the status byte reports display off in bit 6 */
+    for (size_t i = 0; i < size; i++) {
+        buffer[i] = ctx->display_on ? 0x00 : 0x40;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ssd1306_create(const uint8_t height, i2c_sim_model_t **const model) {
+    /* validate arguments */
+    ESP_ARG_CHECK( height == 32 || height == 64 );
+
+    esp_err_t ret = i2c_sim_model_new("ssd1306", sizeof(ssd1306_sim_context_t), ssd1306_sim_write, ssd1306_sim_read, model);
+    if (ret != ESP_OK) return ret;
+
+    ssd1306_sim_context_t *ctx = (ssd1306_sim_context_t*)(*model)->context;
+
+    ctx->height     = height;
+    ctx->addr_mode  = SSD1306_SIM_ADDR_MODE_PAGE;
+    ctx->column_end = I2C_SIM_SSD1306_WIDTH - 1;
+    ctx->page_end   = I2C_SIM_SSD1306_PAGES - 1;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ssd1306_get_ram(i2c_sim_model_t *const model, uint8_t *const buffer, const size_t size) {
+    ssd1306_sim_context_t *ctx = (ssd1306_sim_context_t*)i2c_sim_model_get_context(model, ssd1306_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && buffer );
+
+    const size_t visible = (size_t)(ctx->height / 8) * I2C_SIM_SSD1306_WIDTH;
+
+    memcpy(buffer, ctx->ram, (size < visible) ? size : visible);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_sim_ssd1306_get_display_on(i2c_sim_model_t *const model, bool *const display_on) {
+    ssd1306_sim_context_t *ctx = (ssd1306_sim_context_t*)i2c_sim_model_get_context(model, ssd1306_sim_write);
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctx && display_on );
+
+    *display_on = ctx->display_on;
+
+    return ESP_OK;
+}
@@ -0,0 +1,226 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file nvs_sim.c
+ *
+ * Host nvs shim for the I2C simulator, blobs are kept in process memory
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+
+/*
+ * definitions
+*/
+#define NVS_SIM_ENTRY_MAX       (32)    //!< nvs simulator, maximum number of stored blobs
+#define NVS_SIM_BLOB_SIZE_MAX   (512)   //!< nvs simulator, maximum blob size in bytes
+#define NVS_SIM_NAME_SIZE_MAX   (16)    //!< nvs simulator, maximum namespace and key length including the terminator
+#define NVS_SIM_HANDLE_MAX      (8)     //!< nvs simulator, maximum number of open handles
+
+/**
+ * @brief NVS simulator blob entry structure.
+ */
+typedef struct nvs_sim_entry_s {
+    bool    used;                               /*!< entry holds a blob */
+    char    namespace_name[NVS_SIM_NAME_SIZE_MAX];  /*!< namespace of the blob */
+    char    key[NVS_SIM_NAME_SIZE_MAX];         /*!< key of the blob */
+    uint8_t value[NVS_SIM_BLOB_SIZE_MAX];       /*!< blob bytes */
+    size_t  length;                             /*!< blob length in bytes */
+} nvs_sim_entry_t;
+
+/**
+ * @brief NVS simulator open handle structure.
+ */
+typedef struct nvs_sim_handle_s {
+    bool            open;                               /*!< handle is open */
+    nvs_open_mode_t mode;                               /*!< handle open mode */
+    char            namespace_name[NVS_SIM_NAME_SIZE_MAX];  /*!< namespace of the handle */
+} nvs_sim_handle_t;
+
+/*
+ * static variable declarations
+*/
+static pthread_mutex_t  nvs_sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static nvs_sim_entry_t  nvs_sim_entries[NVS_SIM_ENTRY_MAX];
+static nvs_sim_handle_t nvs_sim_handles[NVS_SIM_HANDLE_MAX];
+
+/**
+ * @brief Gets the open handle structure of an nvs handle, the mutex must be held.
+ */
+static inline nvs_sim_handle_t *nvs_sim_get_handle(const nvs_handle_t handle) {
+    if (handle == 0 || handle > NVS_SIM_HANDLE_MAX || !nvs_sim_handles[handle - 1].open) return NULL;
+
+    return &nvs_sim_handles[handle - 1];
+}
+
+/**
+ * @brief Finds the blob entry of a namespace and key, the mutex must be held.
+ */
+static inline nvs_sim_entry_t *nvs_sim_find_entry(const char *namespace_name, const char *key) {
+    for (size_t i = 0; i < NVS_SIM_ENTRY_MAX; i++) {
+        if (nvs_sim_entries[i].used && strcmp(nvs_sim_entries[i].namespace_name, namespace_name) == 0 &&
+            strcmp(nvs_sim_entries[i].key, key) == 0) return &nvs_sim_entries[i];
+    }
+
+    return NULL;
+}
+
+esp_err_t nvs_flash_init(void) {
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    pthread_mutex_lock(&nvs_sim_mutex);
+    memset(nvs_sim_entries, 0, sizeof(nvs_sim_entries));
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) {
+    if (namespace_name == NULL || out_handle == NULL || strlen(namespace_name) >= NVS_SIM_NAME_SIZE_MAX) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+
+    pthread_mutex_lock(&nvs_sim_mutex);
+    for (size_t i = 0; i < NVS_SIM_HANDLE_MAX; i++) {
+        if (nvs_sim_handles[i].open) continue;
+
+        nvs_sim_handles[i].open = true;
+        nvs_sim_handles[i].mode = open_mode;
+        strcpy(nvs_sim_handles[i].namespace_name, namespace_name);
+        *out_handle = (nvs_handle_t)(i + 1);
+        ret = ESP_OK;
+        break;
+    }
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ret;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+    if (key == NULL || length == NULL) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = ESP_OK;
+
+    pthread_mutex_lock(&nvs_sim_mutex);
+    const nvs_sim_handle_t *hdl   = nvs_sim_get_handle(handle);
+    const nvs_sim_entry_t  *entry = hdl ? nvs_sim_find_entry(hdl->namespace_name, key) : NULL;
+    if (hdl == NULL) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (entry == NULL) {
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else if (out_value == NULL) {
+        /* length query */
+        *length = entry->length;
+    } else if (*length < entry->length) {
+        ret = ESP_ERR_NVS_INVALID_LENGTH;
+    } else {
+        memcpy(out_value, entry->value, entry->length);
+        *length = entry->length;
+    }
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ret;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    if (key == NULL || value == NULL || strlen(key) >= NVS_SIM_NAME_SIZE_MAX) return ESP_ERR_INVALID_ARG;
+    if (length > NVS_SIM_BLOB_SIZE_MAX) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+
+    esp_err_t ret = ESP_OK;
+
+    pthread_mutex_lock(&nvs_sim_mutex);
+    const nvs_sim_handle_t *hdl   = nvs_sim_get_handle(handle);
+    nvs_sim_entry_t        *entry = hdl ? nvs_sim_find_entry(hdl->namespace_name, key) : NULL;
+    if (hdl == NULL) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (hdl->mode == NVS_READONLY) {
+        ret = ESP_ERR_NVS_READ_ONLY;
+    } else {
+        /* claim a free entry for a new key */
+        for (size_t i = 0; entry == NULL && i < NVS_SIM_ENTRY_MAX; i++) {
+            if (nvs_sim_entries[i].used) continue;
+
+            entry = &nvs_sim_entries[i];
+            entry->used = true;
+            strcpy(entry->namespace_name, hdl->namespace_name);
+            strcpy(entry->key, key);
+        }
+
+        if (entry == NULL) {
+            ret = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        } else {
+            memcpy(entry->value, value, length);
+            entry->length = length;
+        }
+    }
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ret;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key) {
+    if (key == NULL) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = ESP_OK;
+
+    pthread_mutex_lock(&nvs_sim_mutex);
+    const nvs_sim_handle_t *hdl   = nvs_sim_get_handle(handle);
+    nvs_sim_entry_t        *entry = hdl ? nvs_sim_find_entry(hdl->namespace_name, key) : NULL;
+    if (hdl == NULL) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (hdl->mode == NVS_READONLY) {
+        ret = ESP_ERR_NVS_READ_ONLY;
+    } else if (entry == NULL) {
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        memset(entry, 0, sizeof(nvs_sim_entry_t));
+    }
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ret;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    pthread_mutex_lock(&nvs_sim_mutex);
+    const esp_err_t ret = nvs_sim_get_handle(handle) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+    pthread_mutex_unlock(&nvs_sim_mutex);
+
+    return ret;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    pthread_mutex_lock(&nvs_sim_mutex);
+    nvs_sim_handle_t *hdl = nvs_sim_get_handle(handle);
+    if (hdl) memset(hdl, 0, sizeof(nvs_sim_handle_t));
+    pthread_mutex_unlock(&nvs_sim_mutex);
+}
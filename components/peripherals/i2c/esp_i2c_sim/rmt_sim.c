@@ -0,0 +1,419 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file rmt_sim.c
+ *
+ * Host RMT channel and encoder shim for the I2C simulator, transmissions are 
+ * looped back through a line model to the receive channel of the same GPIO
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <rmt_sim.h>
+#include <i2c_sim.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <esp_log.h>
+
+/*
+ * definitions
+*/
+#define RMT_SIM_CHANNEL_MAX     (8)     //!< rmt simulator, maximum number of channels
+#define RMT_SIM_GPIO_MAX        (64)    //!< rmt simulator, maximum gpio number of a channel
+
+/**
+ * @brief RMT simulator channel structure.
+ */
+struct rmt_channel_t {
+    bool                    rx;                 /*!< channel is a receive channel */
+    int                     gpio_num;           /*!< channel gpio */
+    size_t                  mem_block_symbols;  /*!< channel memory block symbols */
+    bool                    enabled;            /*!< channel is enabled */
+    rmt_rx_done_callback_t  on_recv_done;       /*!< receive done callback */
+    rmt_tx_done_callback_t  on_trans_done;      /*!< transmit done callback */
+    void                   *user_data;          /*!< receive or transmit done callback user data */
+    rmt_symbol_word_t      *rx_buffer;          /*!< pending receive buffer, NULL when no receive is pending */
+    size_t                  rx_buffer_symbols;  /*!< pending receive buffer size in symbols */
+    uint32_t                rx_range_max_us;    /*!< pending receive idle threshold in microseconds */
+};
+
+/**
+ * @brief RMT simulator encoder structure.
+ */
+struct rmt_encoder_t {
+    bool                    bytes;      /*!< bytes encoder when true, copy encoder otherwise */
+    rmt_bytes_encoder_config_t config;  /*!< bytes encoder bit symbols and order */
+};
+
+/*
+ * static variable declarations
+*/
+static pthread_mutex_t          rmt_sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static rmt_channel_handle_t     rmt_sim_channels[RMT_SIM_CHANNEL_MAX];
+static uint8_t                  rmt_sim_line_levels[RMT_SIM_GPIO_MAX];
+static rmt_sim_line_model_t     rmt_sim_line_model;
+static void                    *rmt_sim_line_context;
+static rmt_sim_stats_t          rmt_sim_stats;
+
+static const char *TAG = "rmt_sim";
+
+/**
+ * @brief Appends a level to a level array, a zero duration is dropped.
+ */
+static inline void rmt_sim_append_level(rmt_sim_level_t *const levels, size_t *const count, const uint8_t level, const uint32_t duration_us) {
+    if (duration_us == 0) return;
+
+    levels[*count].level       = level;
+    levels[*count].duration_us = duration_us;
+    (*count)++;
+}
+
+/**
+ * @brief Records the line levels as RMT symbols from the first edge until the line idles high longer 
+ * than the idle threshold, the idle level is stored with a zero duration as the end marker.
+ */
+static size_t rmt_sim_record(const rmt_channel_handle_t channel, const uint8_t initial_level, const rmt_sim_level_t *const line, 
+                             const size_t line_count, bool *const overflow) {
+    /* merge runs of the same level */
+    rmt_sim_level_t *const runs = (rmt_sim_level_t *)calloc(line_count + 1, sizeof(rmt_sim_level_t));
+    size_t run_count = 0;
+    bool   started   = false;
+    uint8_t level    = initial_level;
+
+    for (size_t i = 0; i < line_count; i++) {
+        if (!started && line[i].level == level) continue;
+        started = true;
+        if (run_count > 0 && runs[run_count - 1].level == line[i].level) {
+            runs[run_count - 1].duration_us += line[i].duration_us;
+        } else {
+            rmt_sim_append_level(runs, &run_count, line[i].level, line[i].duration_us);
+        }
+    }
+
+    /* the line idles high after the transmission, the idle level ends the receive */
+    if (run_count > 0 && runs[run_count - 1].level == 1) {
+        runs[run_count - 1].duration_us = 0;
+    } else if (run_count > 0) {
+        runs[run_count].level = 1;
+        runs[run_count].duration_us = 0;
+        run_count++;
+    }
+    for (size_t i = 0; i < run_count; i++) {
+        if (runs[i].level == 1 && runs[i].duration_us > channel->rx_range_max_us) {
+            runs[i].duration_us = 0;
+            run_count = i + 1;
+            break;
+        }
+    }
+
+    /* pack the runs into symbols */
+    size_t symbol_count = (run_count + 1) / 2;
+    *overflow = symbol_count > channel->rx_buffer_symbols;
+    if (*overflow) symbol_count = channel->rx_buffer_symbols;
+    for (size_t i = 0; i < symbol_count; i++) {
+        rmt_symbol_word_t symbol = { .val = 0 };
+        symbol.level0    = runs[2 * i].level;
+        symbol.duration0 = runs[2 * i].duration_us;
+        if (2 * i + 1 < run_count) {
+            symbol.level1    = runs[2 * i + 1].level;
+            symbol.duration1 = runs[2 * i + 1].duration_us;
+        }
+        channel->rx_buffer[i] = symbol;
+    }
+
+    free(runs);
+
+    return symbol_count;
+}
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder) {
+    if (config == NULL || ret_encoder == NULL) return ESP_ERR_INVALID_ARG;
+
+    rmt_encoder_handle_t encoder = (rmt_encoder_handle_t)calloc(1, sizeof(struct rmt_encoder_t));
+    if (encoder == NULL) return ESP_ERR_NO_MEM;
+
+    encoder->bytes  = true;
+    encoder->config = *config;
+    *ret_encoder    = encoder;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder) {
+    if (config == NULL || ret_encoder == NULL) return ESP_ERR_INVALID_ARG;
+
+    rmt_encoder_handle_t encoder = (rmt_encoder_handle_t)calloc(1, sizeof(struct rmt_encoder_t));
+    if (encoder == NULL) return ESP_ERR_NO_MEM;
+
+    *ret_encoder = encoder;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) {
+    if (encoder == NULL) return ESP_ERR_INVALID_ARG;
+
+    free(encoder);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Registers a new channel, the mutex must not be held.
+ */
+static esp_err_t rmt_sim_new_channel(const bool rx, const int gpio_num, const size_t mem_block_symbols, rmt_channel_handle_t *ret_chan) {
+    if (ret_chan == NULL || gpio_num < 0 || gpio_num >= RMT_SIM_GPIO_MAX) return ESP_ERR_INVALID_ARG;
+
+    rmt_channel_handle_t channel = (rmt_channel_handle_t)calloc(1, sizeof(struct rmt_channel_t));
+    if (channel == NULL) return ESP_ERR_NO_MEM;
+
+    channel->rx                = rx;
+    channel->gpio_num          = gpio_num;
+    channel->mem_block_symbols = mem_block_symbols;
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    pthread_mutex_lock(&rmt_sim_mutex);
+    for (size_t i = 0; i < RMT_SIM_CHANNEL_MAX; i++) {
+        if (rmt_sim_channels[i] != NULL) continue;
+
+        rmt_sim_channels[i] = channel;
+        if (rx) {
+            rmt_sim_stats.rx_mem_block_symbols += mem_block_symbols;
+        } else {
+            rmt_sim_stats.tx_mem_block_symbols += mem_block_symbols;
+        }
+        ret = ESP_OK;
+        break;
+    }
+    pthread_mutex_unlock(&rmt_sim_mutex);
+
+    if (ret != ESP_OK) {
+        free(channel);
+        return ret;
+    }
+
+    *ret_chan = channel;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t *config, rmt_channel_handle_t *ret_chan) {
+    if (config == NULL) return ESP_ERR_INVALID_ARG;
+
+    return rmt_sim_new_channel(false, config->gpio_num, config->mem_block_symbols, ret_chan);
+}
+
+esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t *config, rmt_channel_handle_t *ret_chan) {
+    if (config == NULL) return ESP_ERR_INVALID_ARG;
+
+    return rmt_sim_new_channel(true, config->gpio_num, config->mem_block_symbols, ret_chan);
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel) {
+    if (channel == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&rmt_sim_mutex);
+    for (size_t i = 0; i < RMT_SIM_CHANNEL_MAX; i++) {
+        if (rmt_sim_channels[i] != channel) continue;
+
+        rmt_sim_channels[i] = NULL;
+        if (channel->rx) {
+            rmt_sim_stats.rx_mem_block_symbols -= channel->mem_block_symbols;
+        } else {
+            rmt_sim_stats.tx_mem_block_symbols -= channel->mem_block_symbols;
+        }
+    }
+    pthread_mutex_unlock(&rmt_sim_mutex);
+
+    free(channel);
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel) {
+    if (channel == NULL) return ESP_ERR_INVALID_ARG;
+
+    channel->enabled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_disable(rmt_channel_handle_t channel) {
+    if (channel == NULL) return ESP_ERR_INVALID_ARG;
+
+    channel->enabled   = false;
+    channel->rx_buffer = NULL;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t rx_channel, const rmt_rx_event_callbacks_t *cbs, void *user_data) {
+    if (rx_channel == NULL || cbs == NULL || !rx_channel->rx) return ESP_ERR_INVALID_ARG;
+
+    rx_channel->on_recv_done = cbs->on_recv_done;
+    rx_channel->user_data    = user_data;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t tx_channel, const rmt_tx_event_callbacks_t *cbs, void *user_data) {
+    if (tx_channel == NULL || cbs == NULL || tx_channel->rx) return ESP_ERR_INVALID_ARG;
+
+    tx_channel->on_trans_done = cbs->on_trans_done;
+    tx_channel->user_data     = user_data;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_receive(rmt_channel_handle_t rx_channel, void *buffer, size_t buffer_size, const rmt_receive_config_t *config) {
+    if (rx_channel == NULL || buffer == NULL || config == NULL || !rx_channel->rx) return ESP_ERR_INVALID_ARG;
+    if (!rx_channel->enabled) return ESP_ERR_INVALID_STATE;
+
+    rx_channel->rx_buffer         = (rmt_symbol_word_t *)buffer;
+    rx_channel->rx_buffer_symbols = buffer_size / sizeof(rmt_symbol_word_t);
+    rx_channel->rx_range_max_us   = config->signal_range_max_ns / 1000;
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t tx_channel, rmt_encoder_handle_t encoder, const void *payload, size_t payload_bytes, const rmt_transmit_config_t *config) {
+    if (tx_channel == NULL || encoder == NULL || payload == NULL || config == NULL || tx_channel->rx) return ESP_ERR_INVALID_ARG;
+    if (!tx_channel->enabled) return ESP_ERR_INVALID_STATE;
+
+    /* encode the payload into symbols */
+    const size_t symbol_count = encoder->bytes ? payload_bytes * 8 : payload_bytes / sizeof(rmt_symbol_word_t);
+    rmt_symbol_word_t *const symbols = (rmt_symbol_word_t *)calloc(symbol_count + 1, sizeof(rmt_symbol_word_t));
+    if (symbols == NULL) return ESP_ERR_NO_MEM;
+    if (encoder->bytes) {
+        const uint8_t *const bytes = (const uint8_t *)payload;
+        for (size_t i = 0; i < symbol_count; i++) {
+            const uint8_t bit = encoder->config.flags.msb_first ? (uint8_t)(0x80 >> (i % 8)) : (uint8_t)(1 << (i % 8));
+            symbols[i] = (bytes[i / 8] & bit) ? encoder->config.bit1 : encoder->config.bit0;
+        }
+    } else {
+        memcpy(symbols, payload, symbol_count * sizeof(rmt_symbol_word_t));
+    }
+
+    /* master waveform, a zero duration ends the transmission */
+    rmt_sim_level_t *const master = (rmt_sim_level_t *)calloc(symbol_count * 2 + 1, sizeof(rmt_sim_level_t));
+    size_t   master_count = 0;
+    uint64_t duration_us  = 0;
+    for (size_t i = 0; i < symbol_count; i++) {
+        if (symbols[i].duration0 == 0) break;
+        rmt_sim_append_level(master, &master_count, symbols[i].level0, symbols[i].duration0);
+        if (symbols[i].duration1 == 0) break;
+        rmt_sim_append_level(master, &master_count, symbols[i].level1, symbols[i].duration1);
+    }
+    for (size_t i = 0; i < master_count; i++) duration_us += master[i].duration_us;
+
+    /* line levels driven by the devices */
+    const size_t line_size = master_count * 4 + 16;
+    rmt_sim_level_t *const line = (rmt_sim_level_t *)calloc(line_size, sizeof(rmt_sim_level_t));
+    size_t line_count;
+
+    pthread_mutex_lock(&rmt_sim_mutex);
+    if (rmt_sim_line_model) {
+        line_count = rmt_sim_line_model(rmt_sim_line_context, master, master_count, line, line_size);
+    } else {
+        memcpy(line, master, master_count * sizeof(rmt_sim_level_t));
+        line_count = master_count;
+    }
+
+    /* record the line on a pending receive of the same gpio */
+    rmt_channel_handle_t rx_channel = NULL;
+    for (size_t i = 0; i < RMT_SIM_CHANNEL_MAX; i++) {
+        rmt_channel_handle_t channel = rmt_sim_channels[i];
+        if (channel && channel->rx && channel->gpio_num == tx_channel->gpio_num && channel->rx_buffer) rx_channel = channel;
+    }
+    rmt_rx_done_event_data_t edata = { 0 };
+    if (rx_channel) {
+        bool overflow = false;
+        edata.received_symbols = rx_channel->rx_buffer;
+        edata.num_symbols      = rmt_sim_record(rx_channel, rmt_sim_line_levels[tx_channel->gpio_num], line, line_count, &overflow);
+        edata.flags.is_last    = 1;
+        rx_channel->rx_buffer  = NULL;
+        rmt_sim_stats.receives++;
+        rmt_sim_stats.symbols_received += edata.num_symbols;
+        if (overflow) {
+            rmt_sim_stats.rx_overflows++;
+            ESP_LOGW(TAG, "receive buffer of %u symbols overflowed", (unsigned)rx_channel->rx_buffer_symbols);
+        }
+    }
+    rmt_sim_line_levels[tx_channel->gpio_num] = config->flags.eot_level;
+    rmt_sim_stats.transmits++;
+    rmt_sim_stats.symbols_sent += symbol_count;
+    pthread_mutex_unlock(&rmt_sim_mutex);
+
+    free(line);
+    free(master);
+    free(symbols);
+
+    i2c_sim_advance_time_us(duration_us);
+
+    /* transmit done at the end of the last symbol, called from the transmitting task */
+    if (tx_channel->on_trans_done) {
+        const rmt_tx_done_event_data_t tx_edata = { .num_symbols = symbol_count };
+        tx_channel->on_trans_done(tx_channel, &tx_edata, tx_channel->user_data);
+    }
+
+    /* receive done, called from the transmitting task */
+    if (rx_channel && edata.num_symbols > 0 && rx_channel->on_recv_done) {
+        rx_channel->on_recv_done(rx_channel, &edata, rx_channel->user_data);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t tx_channel, int timeout_ms) {
+    if (tx_channel == NULL) return ESP_ERR_INVALID_ARG;
+
+    /* transmissions complete before rmt_transmit returns */
+    return ESP_OK;
+}
+
+void rmt_sim_set_line_model(rmt_sim_line_model_t model, void *const context) {
+    pthread_mutex_lock(&rmt_sim_mutex);
+    rmt_sim_line_model   = model;
+    rmt_sim_line_context = context;
+    pthread_mutex_unlock(&rmt_sim_mutex);
+}
+
+void rmt_sim_get_stats(rmt_sim_stats_t *const stats) {
+    pthread_mutex_lock(&rmt_sim_mutex);
+    *stats = rmt_sim_stats;
+    pthread_mutex_unlock(&rmt_sim_mutex);
+}
+
+void rmt_sim_reset_stats(void) {
+    pthread_mutex_lock(&rmt_sim_mutex);
+    const size_t tx_mem_block_symbols = rmt_sim_stats.tx_mem_block_symbols;
+    const size_t rx_mem_block_symbols = rmt_sim_stats.rx_mem_block_symbols;
+    memset(&rmt_sim_stats, 0, sizeof(rmt_sim_stats));
+    rmt_sim_stats.tx_mem_block_symbols = tx_mem_block_symbols;
+    rmt_sim_stats.rx_mem_block_symbols = rx_mem_block_symbols;
+    pthread_mutex_unlock(&rmt_sim_mutex);
+}
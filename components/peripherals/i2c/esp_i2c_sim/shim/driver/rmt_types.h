@@ -0,0 +1,83 @@
+/**
+ * @file rmt_types.h
+ *
+ * Host simulation shim for the ESP-IDF `driver/rmt_types.h`, `driver/rmt_common.h` and
+ * `driver/rmt_encoder.h` headers, see esp_i2c_sim and `rmt_sim.h`.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __DRIVER_RMT_TYPES_H__
+#define __DRIVER_RMT_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef __containerof
+#define __containerof(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+#endif
+
+typedef struct rmt_channel_t *rmt_channel_handle_t;
+typedef struct rmt_encoder_t *rmt_encoder_handle_t;
+
+typedef enum {
+    RMT_CLK_SRC_DEFAULT = 0,
+} rmt_clock_source_t;
+
+typedef union {
+    struct {
+        uint16_t duration0 : 15;
+        uint16_t level0 : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct {
+    rmt_symbol_word_t *received_symbols;
+    size_t num_symbols;
+    struct {
+        uint32_t is_last: 1;
+    } flags;
+} rmt_rx_done_event_data_t;
+
+typedef bool (*rmt_rx_done_callback_t)(rmt_channel_handle_t rx_chan, const rmt_rx_done_event_data_t *edata, void *user_ctx);
+
+typedef struct {
+    size_t num_symbols;
+} rmt_tx_done_event_data_t;
+
+typedef bool (*rmt_tx_done_callback_t)(rmt_channel_handle_t tx_chan, const rmt_tx_done_event_data_t *edata, void *user_ctx);
+
+typedef struct {
+    rmt_symbol_word_t bit0;
+    rmt_symbol_word_t bit1;
+    struct {
+        uint32_t msb_first: 1;
+    } flags;
+} rmt_bytes_encoder_config_t;
+
+typedef struct {
+} rmt_copy_encoder_config_t;
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder);
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder);
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder);
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel);
+esp_err_t rmt_enable(rmt_channel_handle_t channel);
+esp_err_t rmt_disable(rmt_channel_handle_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __DRIVER_RMT_TYPES_H__
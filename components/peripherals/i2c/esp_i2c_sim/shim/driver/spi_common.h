@@ -0,0 +1,32 @@
+/**
+ * @file spi_common.h
+ *
+ * Host simulation shim for the ESP-IDF `driver/spi_common.h` header, see esp_i2c_sim and `spi_sim.h`.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __DRIVER_SPI_COMMON_H__
+#define __DRIVER_SPI_COMMON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2,
+    SPI_HOST_MAX,
+} spi_host_device_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DRIVER_SPI_COMMON_H__
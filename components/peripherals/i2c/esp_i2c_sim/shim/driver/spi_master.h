@@ -0,0 +1,83 @@
+/**
+ * @file spi_master.h
+ *
+ * Host simulation shim for the ESP-IDF `driver/spi_master.h` header, see esp_i2c_sim and `spi_sim.h`.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __DRIVER_SPI_MASTER_H__
+#define __DRIVER_SPI_MASTER_H__
+
+#include <stddef.h>
+#include "driver/spi_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPI_DEVICE_TXBIT_LSBFIRST   (1 << 0)
+#define SPI_DEVICE_RXBIT_LSBFIRST   (1 << 1)
+#define SPI_DEVICE_BIT_LSBFIRST     (SPI_DEVICE_TXBIT_LSBFIRST | SPI_DEVICE_RXBIT_LSBFIRST)
+#define SPI_DEVICE_3WIRE            (1 << 2)
+#define SPI_DEVICE_POSITIVE_CS      (1 << 3)
+#define SPI_DEVICE_HALFDUPLEX       (1 << 4)
+#define SPI_DEVICE_CLK_AS_CS        (1 << 5)
+#define SPI_DEVICE_NO_DUMMY         (1 << 6)
+
+#define SPI_TRANS_MODE_DIO          (1 << 0)
+#define SPI_TRANS_MODE_QIO          (1 << 1)
+#define SPI_TRANS_USE_RXDATA        (1 << 2)
+#define SPI_TRANS_USE_TXDATA        (1 << 3)
+
+typedef struct spi_transaction_t spi_transaction_t;
+
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+typedef struct {
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint8_t mode;
+    uint16_t duty_cycle_pos;
+    uint16_t cs_ena_pretrans;
+    uint8_t cs_ena_posttrans;
+    int clock_speed_hz;
+    int input_delay_ns;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+    transaction_cb_t pre_cb;
+    transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+struct spi_transaction_t {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;
+    size_t rxlength;
+    void *user;
+    union {
+        const void *tx_buffer;
+        uint8_t tx_data[4];
+    };
+    union {
+        void *rx_buffer;
+        uint8_t rx_data[4];
+    };
+};
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DRIVER_SPI_MASTER_H__
@@ -0,0 +1,19 @@
+/**
+ * @file esp_attr.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_attr.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_ATTR_H__
+#define __ESP_ATTR_H__
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define EXT_RAM_BSS_ATTR
+
+#endif  // __ESP_ATTR_H__
@@ -0,0 +1,63 @@
+/**
+ * @file esp_check.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_check.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_CHECK_H__
+#define __ESP_CHECK_H__
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#define ESP_RETURN_ON_ERROR(x, log_tag, format, ...) do {                   \
+        esp_err_t err_rc_ = (x);                                            \
+        if (err_rc_ != ESP_OK) {                                            \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            return err_rc_;                                                 \
+        }                                                                   \
+    } while(0)
+
+#define ESP_RETURN_VOID_ON_ERROR(x, log_tag, format, ...) do {              \
+        esp_err_t err_rc_ = (x);                                            \
+        if (err_rc_ != ESP_OK) {                                            \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            return;                                                         \
+        }                                                                   \
+    } while(0)
+
+#define ESP_GOTO_ON_ERROR(x, goto_tag, log_tag, format, ...) do {           \
+        esp_err_t err_rc_ = (x);                                            \
+        if (err_rc_ != ESP_OK) {                                            \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            ret = err_rc_;                                                  \
+            goto goto_tag;                                                  \
+        }                                                                   \
+    } while(0)
+
+#define ESP_RETURN_ON_FALSE(a, err_code, log_tag, format, ...) do {         \
+        if (!(a)) {                                                         \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            return err_code;                                                \
+        }                                                                   \
+    } while(0)
+
+#define ESP_RETURN_VOID_ON_FALSE(a, log_tag, format, ...) do {              \
+        if (!(a)) {                                                         \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            return;                                                         \
+        }                                                                   \
+    } while(0)
+
+#define ESP_GOTO_ON_FALSE(a, err_code, goto_tag, log_tag, format, ...) do { \
+        if (!(a)) {                                                         \
+            ESP_LOGE(log_tag, "%s(%d): " format, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            ret = err_code;                                                 \
+            goto goto_tag;                                                  \
+        }                                                                   \
+    } while(0)
+
+#endif  // __ESP_CHECK_H__
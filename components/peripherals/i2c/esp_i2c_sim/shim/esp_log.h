@@ -0,0 +1,63 @@
+/**
+ * @file esp_log.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_log.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_LOG_H__
+#define __ESP_LOG_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+/**
+ * @brief Sets the log level, the tag is ignored and the level applies to all tags.
+ */
+void esp_log_level_set(const char *tag, esp_log_level_t level);
+
+/**
+ * @brief Gets the log level.
+ */
+esp_log_level_t esp_log_get_level(void);
+
+/**
+ * @brief Writes a log line with the virtual time stamp in milliseconds.
+ */
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Writes a buffer as a hex dump.
+ */
+void esp_log_buffer_hexdump_internal(const char *tag, const void *buffer, uint16_t buff_len, esp_log_level_t level);
+
+#define ESP_LOGE(tag, format, ...) esp_log_write(ESP_LOG_ERROR,   tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) esp_log_write(ESP_LOG_WARN,    tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) esp_log_write(ESP_LOG_INFO,    tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) esp_log_write(ESP_LOG_DEBUG,   tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) esp_log_write(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+#define ESP_LOG_BUFFER_HEXDUMP(tag, buffer, buff_len, level) esp_log_buffer_hexdump_internal(tag, buffer, buff_len, level)
+#define ESP_LOG_BUFFER_HEX(tag, buffer, buff_len) esp_log_buffer_hexdump_internal(tag, buffer, buff_len, ESP_LOG_INFO)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __ESP_LOG_H__
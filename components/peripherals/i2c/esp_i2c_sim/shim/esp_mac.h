@@ -0,0 +1,29 @@
+/**
+ * @file esp_mac.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_mac.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_MAC_H__
+#define __ESP_MAC_H__
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets the simulated base MAC address, a fixed locally administered address.
+ */
+esp_err_t esp_efuse_mac_get_default(uint8_t *mac);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __ESP_MAC_H__
@@ -0,0 +1,34 @@
+/**
+ * @file esp_random.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_random.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_RANDOM_H__
+#define __ESP_RANDOM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets a pseudo-random number, the sequence is fixed so a simulation is repeatable.
+ */
+uint32_t esp_random(void);
+
+/**
+ * @brief Fills a buffer with pseudo-random bytes from `esp_random`.
+ */
+void esp_fill_random(void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __ESP_RANDOM_H__
@@ -0,0 +1,29 @@
+/**
+ * @file esp_rom_crc.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_rom_crc.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_ROM_CRC_H__
+#define __ESP_ROM_CRC_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calculates the little endian CRC32 (polynomial 0xedb88320) of a buffer, the crc is 
+ * inverted on entry and exit as in the ROM function, `esp_rom_crc32_le(0, ...)` is the zlib CRC32.
+ */
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __ESP_ROM_CRC_H__
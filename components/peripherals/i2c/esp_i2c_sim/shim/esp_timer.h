@@ -0,0 +1,28 @@
+/**
+ * @file esp_timer.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_timer.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_TIMER_H__
+#define __ESP_TIMER_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets the simulation virtual time in microseconds.
+ */
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __ESP_TIMER_H__
@@ -0,0 +1,17 @@
+/**
+ * @file esp_types.h
+ *
+ * Host simulation shim for the ESP-IDF `esp_types.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ESP_TYPES_H__
+#define __ESP_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#endif  // __ESP_TYPES_H__
@@ -0,0 +1,73 @@
+/**
+ * @file FreeRTOS.h
+ *
+ * Host simulation shim for the ESP-IDF `freertos/FreeRTOS.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __FREERTOS_H__
+#define __FREERTOS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sdkconfig.h"
+#include "esp_bit_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t    TickType_t;
+typedef int         BaseType_t;
+typedef unsigned    UBaseType_t;
+
+#define pdFALSE                     ((BaseType_t)0)
+#define pdTRUE                      ((BaseType_t)1)
+#define pdFAIL                      (pdFALSE)
+#define pdPASS                      (pdTRUE)
+
+#define configTICK_RATE_HZ          (CONFIG_FREERTOS_HZ)
+#define configMINIMAL_STACK_SIZE    (768)
+#define configMAX_PRIORITIES        (25)
+
+#define portMAX_DELAY               ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portNUM_PROCESSORS          (2)
+#define PRO_CPU_NUM                 (0)
+#define APP_CPU_NUM                 (1)
+
+#define pdMS_TO_TICKS(xTimeInMs)    ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#define pdTICKS_TO_MS(xTicks)       ((TickType_t)(((uint64_t)(xTicks) * (uint64_t)1000U) / (uint64_t)configTICK_RATE_HZ))
+
+/**
+ * @brief Critical sections share one recursive host mutex, the spinlock is not used.
+ */
+typedef struct {
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { .owner = 0, .count = 0 }
+#define portMUX_INITIALIZE(mux)         do { (mux)->owner = 0; (mux)->count = 0; } while(0)
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+
+#define portENTER_CRITICAL(mux)         vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)          vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)     vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)      vPortExitCritical(mux)
+#define portENTER_CRITICAL_SAFE(mux)    vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_SAFE(mux)     vPortExitCritical(mux)
+#define taskENTER_CRITICAL(mux)         vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux)          vPortExitCritical(mux)
+#define portYIELD_FROM_ISR(...)         do { } while(0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __FREERTOS_H__
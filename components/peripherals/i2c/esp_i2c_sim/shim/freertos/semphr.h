@@ -0,0 +1,43 @@
+/**
+ * @file semphr.h
+ *
+ * Host simulation shim for the ESP-IDF `freertos/semphr.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __FREERTOS_SEMPHR_H__
+#define __FREERTOS_SEMPHR_H__
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
+
+/**
+ * @brief Takes a semaphore.  A bounded wait that is not satisfied advances the virtual 
+ * time by the timeout, portMAX_DELAY blocks the host thread.
+ */
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *const pxHigherPriorityTaskWoken);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __FREERTOS_SEMPHR_H__
@@ -0,0 +1,59 @@
+/**
+ * @file task.h
+ *
+ * Host simulation shim for the ESP-IDF `freertos/task.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __FREERTOS_TASK_H__
+#define __FREERTOS_TASK_H__
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskIDLE_PRIORITY    ((UBaseType_t)0U)
+#define tskNO_AFFINITY      (0x7FFFFFFF)
+
+/**
+ * @brief Tasks run as host threads.  The task stack size, priority and core are ignored.
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                                   void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask, const BaseType_t xCoreID);
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask);
+
+/**
+ * @brief Deletes a task, only the calling task (NULL or its own handle) is supported.
+ */
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+
+/**
+ * @brief Advances the virtual time by the number of ticks and yields the host thread.
+ */
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Takes the task notification.  A bounded wait that is not satisfied advances the 
+ * virtual time by the timeout, portMAX_DELAY blocks the host thread.
+ */
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __FREERTOS_TASK_H__
@@ -0,0 +1,33 @@
+/**
+ * @file nvs_flash.h
+ *
+ * Host simulation shim for the ESP-IDF `nvs_flash.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __NVS_FLASH_H__
+#define __NVS_FLASH_H__
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the simulated nvs partition, the stored blobs are kept.
+ */
+esp_err_t nvs_flash_init(void);
+
+/**
+ * @brief Erases every blob of the simulated nvs partition.
+ */
+esp_err_t nvs_flash_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NVS_FLASH_H__
@@ -0,0 +1,16 @@
+/**
+ * @file sdkconfig.h
+ *
+ * Host simulation shim for the ESP-IDF `sdkconfig.h` header, see esp_i2c_sim.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __SDKCONFIG_H__
+#define __SDKCONFIG_H__
+
+#define CONFIG_FREERTOS_HZ          1000
+#define CONFIG_LOG_DEFAULT_LEVEL    3
+
+#endif  // __SDKCONFIG_H__
@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file spi_sim.c
+ *
+ * Host SPI master device shim for the simulator, transactions are routed to 
+ * the device model attached to the host and CS gpio of the device
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <spi_sim.h>
+#include <i2c_sim.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <esp_log.h>
+
+/**
+ * @brief SPI simulator attached device model structure.
+ */
+typedef struct spi_sim_device_s {
+    spi_host_device_t           host;       /*!< spi simulator device, host */
+    int                         cs_io_num;  /*!< spi simulator device, CS gpio number */
+    spi_sim_model_t*            model;      /*!< spi simulator device, model */
+    struct spi_sim_device_s*    next;       /*!< spi simulator device, next attached device */
+} spi_sim_device_t;
+
+/**
+ * @brief SPI master device structure definition for the shim.
+ */
+struct spi_device_t {
+    spi_host_device_t               host;   /*!< spi master device, host */
+    spi_device_interface_config_t   config; /*!< spi master device, interface configuration */
+};
+
+/*
+ * static variable declarations
+*/
+static pthread_mutex_t          spi_sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static spi_sim_device_t*        spi_sim_devices = NULL;
+static spi_sim_stats_t          spi_sim_stats;
+
+static const char *TAG = "spi_sim";
+
+/**
+ * @brief Finds the attached device of a host and CS gpio, the mutex must be held.
+ */
+static inline spi_sim_device_t *spi_sim_find_device(const spi_host_device_t host, const int cs_io_num) {
+    for (spi_sim_device_t *device = spi_sim_devices; device; device = device->next) {
+        if (device->host == host && device->cs_io_num == cs_io_num) return device;
+    }
+    return NULL;
+}
+
+esp_err_t spi_sim_add_device(const spi_host_device_t host, const int cs_io_num, spi_sim_model_t *const model) {
+    if (host >= SPI_HOST_MAX || model == NULL || model->transfer == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&spi_sim_mutex);
+    if (spi_sim_find_device(host, cs_io_num)) {
+        pthread_mutex_unlock(&spi_sim_mutex);
+        ESP_LOGE(TAG, "cs gpio %d is in use on host %d", cs_io_num, host);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    spi_sim_device_t *device = (spi_sim_device_t *)calloc(1, sizeof(spi_sim_device_t));
+    if (device == NULL) {
+        pthread_mutex_unlock(&spi_sim_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+
+    device->host      = host;
+    device->cs_io_num = cs_io_num;
+    device->model     = model;
+    device->next      = spi_sim_devices;
+    spi_sim_devices   = device;
+    pthread_mutex_unlock(&spi_sim_mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_sim_remove_device(const spi_host_device_t host, const int cs_io_num) {
+    spi_sim_device_t *device = NULL;
+
+    pthread_mutex_lock(&spi_sim_mutex);
+    for (spi_sim_device_t **link = &spi_sim_devices; *link; link = &(*link)->next) {
+        if ((*link)->host != host || (*link)->cs_io_num != cs_io_num) continue;
+
+        device = *link;
+        *link  = device->next;
+        break;
+    }
+    pthread_mutex_unlock(&spi_sim_mutex);
+
+    if (device == NULL) return ESP_ERR_NOT_FOUND;
+
+    if (device->model->destroy) device->model->destroy(device->model->context);
+    free(device->model);
+    free(device);
+
+    return ESP_OK;
+}
+
+void spi_sim_get_stats(spi_sim_stats_t *const stats) {
+    pthread_mutex_lock(&spi_sim_mutex);
+    *stats = spi_sim_stats;
+    pthread_mutex_unlock(&spi_sim_mutex);
+}
+
+void spi_sim_reset_stats(void) {
+    pthread_mutex_lock(&spi_sim_mutex);
+    memset(&spi_sim_stats, 0, sizeof(spi_sim_stats_t));
+    pthread_mutex_unlock(&spi_sim_mutex);
+}
+
+/*
+ * spi master driver shim
+*/
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle) {
+    if (host_id >= SPI_HOST_MAX || dev_config == NULL || handle == NULL) return ESP_ERR_INVALID_ARG;
+    if (dev_config->mode > 3) return ESP_ERR_INVALID_ARG;
+
+    spi_device_handle_t device = (spi_device_handle_t)calloc(1, sizeof(struct spi_device_t));
+    if (device == NULL) return ESP_ERR_NO_MEM;
+
+    device->host   = host_id;
+    device->config = *dev_config;
+    *handle        = device;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+    if (handle == NULL) return ESP_ERR_INVALID_ARG;
+
+    free(handle);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc) {
+    if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+
+    const spi_transaction_t *const trans = trans_desc;
+    const bool   half_duplex = (handle->config.flags & SPI_DEVICE_HALFDUPLEX) != 0;
+    const size_t rx_bits     = (trans->rxlength == 0 && half_duplex == false) ? trans->length : trans->rxlength;
+    const size_t data_bits   = half_duplex ? trans->length + rx_bits : (trans->length > rx_bits ? trans->length : rx_bits);
+    const size_t size        = ((trans->length > rx_bits ? trans->length : rx_bits) + 7) / 8;
+    const uint8_t *tx_buffer = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans_desc->tx_data : (const uint8_t *)trans->tx_buffer;
+    uint8_t *rx_buffer       = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans_desc->rx_data : (uint8_t *)trans->rx_buffer;
+
+    if (((trans->flags & SPI_TRANS_USE_TXDATA) || (trans->flags & SPI_TRANS_USE_RXDATA)) && size > 4) return ESP_ERR_INVALID_ARG;
+    if (trans->length == 0) tx_buffer = NULL;
+    if (rx_bits == 0) rx_buffer = NULL;
+
+    /* transaction bus time at the device clock speed */
+    const uint64_t clock_speed_hz = handle->config.clock_speed_hz > 0 ? (uint64_t)handle->config.clock_speed_hz : SPI_SIM_DEFAULT_CLOCK_SPEED_HZ;
+    const uint64_t bits           = handle->config.command_bits + handle->config.address_bits + handle->config.dummy_bits + data_bits;
+    const uint64_t bus_time_us    = (bits * 1000000 + clock_speed_hz - 1) / clock_speed_hz;
+
+    pthread_mutex_lock(&spi_sim_mutex);
+    const spi_sim_device_t *const device = spi_sim_find_device(handle->host, handle->config.spics_io_num);
+    spi_sim_model_t *const model = device ? device->model : NULL;
+    spi_sim_stats.transactions++;
+    spi_sim_stats.bytes_written += tx_buffer ? (trans->length + 7) / 8 : 0;
+    spi_sim_stats.bytes_read    += rx_buffer ? (rx_bits + 7) / 8 : 0;
+    spi_sim_stats.bus_time_us   += bus_time_us;
+    pthread_mutex_unlock(&spi_sim_mutex);
+
+    i2c_sim_advance_time_us(bus_time_us);
+
+    /* without a device model the data line reads high */
+    if (model == NULL) {
+        if (rx_buffer) memset(rx_buffer, 0xFF, (rx_bits + 7) / 8);
+        return ESP_OK;
+    }
+
+    return model->transfer(model->context, &handle->config, trans->cmd, trans->addr, tx_buffer, rx_buffer, size);
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc) {
+    return spi_device_polling_transmit(handle, trans_desc);
+}
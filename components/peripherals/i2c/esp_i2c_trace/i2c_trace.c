@@ -0,0 +1,562 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_trace.c
+ *
+ * ESP-IDF I2C master transaction instrumentation
+ * 
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_trace.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <esp_timer.h>
+
+/*
+ * I2C trace definitions
+*/
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+ * static constant declarations
+ */
+static const char *TAG = "i2c_trace";
+
+/**
+ * @brief Gets the latency histogram bucket bound in microseconds, UINT32_MAX for the last bucket.
+ */
+static inline uint32_t i2c_trace_get_bucket_bound_us(const uint8_t bucket) {
+    return (bucket < I2C_TRACE_HISTOGRAM_BUCKETS - 1) ? (uint32_t)I2C_TRACE_HISTOGRAM_BASE_US << bucket : UINT32_MAX;
+}
+
+uint32_t i2c_trace_get_percentile_us(const i2c_trace_register_stats_t *const stats, const float percentile) {
+    if (!stats || stats->transactions == 0) return 0;
+
+    /* smallest bucket bound that covers the percentile of the transactions */
+    const uint64_t target = (uint64_t)((double)stats->transactions * (percentile < 0.0f ? 0.0f : percentile > 100.0f ? 100.0f : percentile) / 100.0 + 0.5);
+    uint64_t count = 0;
+    for (uint8_t i = 0; i < I2C_TRACE_HISTOGRAM_BUCKETS; i++) {
+        count += stats->histogram[i];
+        if (count >= target && count > 0) return i2c_trace_get_bucket_bound_us(i);
+    }
+
+    return UINT32_MAX;
+}
+
+#if CONFIG_I2C_TRACE_ENABLED
+
+_Static_assert((I2C_TRACE_RING_SIZE & (I2C_TRACE_RING_SIZE - 1)) == 0, "CONFIG_I2C_TRACE_RING_SIZE must be a power of 2");
+
+/*
+ * I2C trace enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C trace register counters, the key is the register plus 1 and 0 when unused.
+ */
+typedef struct i2c_trace_register_s {
+    _Atomic uint32_t            key;
+    _Atomic uint32_t            transactions;
+    _Atomic uint32_t            nacks;
+    _Atomic uint32_t            timeouts;
+    _Atomic uint32_t            bytes_written;
+    _Atomic uint32_t            bytes_read;
+    _Atomic uint64_t            latency_total_us;
+    _Atomic uint32_t            latency_max_us;
+    _Atomic uint32_t            histogram[I2C_TRACE_HISTOGRAM_BUCKETS];
+} i2c_trace_register_t;
+
+/**
+ * @brief I2C trace device counters, the device handle is 0 when the slot is unused.  The last 
+ * register slot counts the transactions beyond I2C_TRACE_MAX_REGISTERS.
+ */
+typedef struct i2c_trace_device_s {
+    _Atomic uintptr_t           device;
+    _Atomic uint32_t            address;
+    char                        name[I2C_TRACE_NAME_SIZE];
+    _Atomic uint32_t            last_register;  /* register plus 1, 0 before the first write */
+    _Atomic uint32_t            delays;
+    _Atomic uint64_t            delay_total_us;
+    i2c_trace_register_t        registers[I2C_TRACE_MAX_REGISTERS + 1];
+} i2c_trace_device_t;
+
+/**
+ * @brief I2C trace ring slot.  The sequence is odd while the record is written and twice 
+ * the record index plus 2 when it is complete, readers retry or skip torn slots.
+ */
+typedef struct i2c_trace_slot_s {
+    _Atomic uint32_t            sequence;
+    i2c_trace_record_t          record;
+} i2c_trace_slot_t;
+
+/*
+ * static variable declarations
+ */
+static i2c_trace_device_t   i2c_trace_devices[I2C_TRACE_MAX_DEVICES];
+static i2c_trace_slot_t     i2c_trace_ring[I2C_TRACE_RING_SIZE];
+static _Atomic uint32_t     i2c_trace_head;
+static _Atomic uint32_t     i2c_trace_dropped;
+static _Atomic int64_t      i2c_trace_reset_time_us;
+
+/**
+ * @brief Gets the latency histogram bucket of a transaction time.
+ */
+static inline uint8_t i2c_trace_get_bucket(const uint32_t latency_us) {
+    uint8_t bucket = 0;
+    while (bucket < I2C_TRACE_HISTOGRAM_BUCKETS - 1 && latency_us >= i2c_trace_get_bucket_bound_us(bucket)) bucket++;
+    return bucket;
+}
+
+/**
+ * @brief Finds the counters of a device handle, optionally claiming a free slot.
+ */
+static inline i2c_trace_device_t *i2c_trace_find_device(i2c_master_dev_handle_t i2c_dev, const bool claim) {
+    const uintptr_t key = (uintptr_t)i2c_dev;
+
+    if (!i2c_dev) return NULL;
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        if (atomic_load_explicit(&i2c_trace_devices[i].device, memory_order_acquire) == key) return &i2c_trace_devices[i];
+    }
+    if (!claim) return NULL;
+
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        uintptr_t expected = 0;
+        if (atomic_compare_exchange_strong(&i2c_trace_devices[i].device, &expected, key) || expected == key) {
+            return &i2c_trace_devices[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Finds or claims the counters of a register, the overflow slot when all are in use.
+ */
+static inline i2c_trace_register_t *i2c_trace_find_register(i2c_trace_device_t *const device, const uint16_t register_address) {
+    const uint32_t key = (uint32_t)register_address + 1;
+
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_REGISTERS; i++) {
+        uint32_t expected = atomic_load_explicit(&device->registers[i].key, memory_order_acquire);
+        if (expected == key) return &device->registers[i];
+        if (expected == 0) {
+            if (atomic_compare_exchange_strong(&device->registers[i].key, &expected, key) || expected == key) {
+                return &device->registers[i];
+            }
+        }
+    }
+
+    i2c_trace_register_t *const other = &device->registers[I2C_TRACE_MAX_REGISTERS];
+    atomic_store_explicit(&other->key, (uint32_t)I2C_TRACE_REGISTER_OTHER + 1, memory_order_release);
+    return other;
+}
+
+/**
+ * @brief Gets the last register written to a device, I2C_TRACE_REGISTER_NONE before the first write.
+ */
+static inline uint16_t i2c_trace_get_last_register(i2c_trace_device_t *const device) {
+    const uint32_t key = atomic_load_explicit(&device->last_register, memory_order_relaxed);
+    return key ? (uint16_t)(key - 1) : I2C_TRACE_REGISTER_NONE;
+}
+
+/**
+ * @brief Atomically raises a maximum.
+ */
+static inline void i2c_trace_update_max(_Atomic uint32_t *const max, const uint32_t value) {
+    uint32_t current = atomic_load_explicit(max, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak_explicit(max, &current, value, memory_order_relaxed, memory_order_relaxed)) { }
+}
+
+/**
+ * @brief Writes a record to the ring.
+ */
+static inline void i2c_trace_push_record(const i2c_trace_record_t *const record) {
+    const uint32_t index = atomic_fetch_add_explicit(&i2c_trace_head, 1, memory_order_relaxed);
+    i2c_trace_slot_t *const slot = &i2c_trace_ring[index & (I2C_TRACE_RING_SIZE - 1)];
+
+    atomic_store_explicit(&slot->sequence, index * 2 + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->record          = *record;
+    slot->record.sequence = index;
+    atomic_store_explicit(&slot->sequence, index * 2 + 2, memory_order_release);
+}
+
+/**
+ * @brief Records a completed transaction in the device and register counters and the ring.
+ */
+static inline void i2c_trace_record_transaction(i2c_master_dev_handle_t i2c_dev, const i2c_trace_operations_t operation, const uint8_t *write_buffer, 
+                                                const size_t write_size, const size_t read_size, const int64_t start_time_us, const esp_err_t result) {
+    const uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_time_us);
+    i2c_trace_device_t *const device = i2c_trace_find_device(i2c_dev, true);
+    uint16_t register_address = I2C_TRACE_REGISTER_NONE;
+
+    if (write_buffer && write_size > 0) {
+        register_address = write_buffer[0];
+        if (device) atomic_store_explicit(&device->last_register, (uint32_t)register_address + 1, memory_order_relaxed);
+    } else if (device) {
+        register_address = i2c_trace_get_last_register(device);
+    }
+
+    if (device) {
+        i2c_trace_register_t *const reg = i2c_trace_find_register(device, register_address);
+
+        atomic_fetch_add_explicit(&reg->transactions, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&reg->bytes_written, (uint32_t)write_size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&reg->bytes_read, (uint32_t)read_size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&reg->latency_total_us, latency_us, memory_order_relaxed);
+        atomic_fetch_add_explicit(&reg->histogram[i2c_trace_get_bucket(latency_us)], 1, memory_order_relaxed);
+        i2c_trace_update_max(&reg->latency_max_us, latency_us);
+        if (result == ESP_ERR_TIMEOUT) {
+            atomic_fetch_add_explicit(&reg->timeouts, 1, memory_order_relaxed);
+        } else if (result != ESP_OK) {
+            atomic_fetch_add_explicit(&reg->nacks, 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_fetch_add_explicit(&i2c_trace_dropped, 1, memory_order_relaxed);
+    }
+
+    const i2c_trace_record_t record = {
+        .timestamp_us       = start_time_us,
+        .device             = i2c_dev,
+        .register_address   = register_address,
+        .operation          = operation,
+        .write_size         = (uint16_t)write_size,
+        .read_size          = (uint16_t)read_size,
+        .latency_us         = latency_us,
+        .result             = result };
+    i2c_trace_push_record(&record);
+}
+
+/**
+ * @brief Clears the counters of a device slot, the device handle and name are not changed.
+ */
+static inline void i2c_trace_clear_device(i2c_trace_device_t *const device) {
+    atomic_store_explicit(&device->last_register, 0, memory_order_relaxed);
+    atomic_store_explicit(&device->delays, 0, memory_order_relaxed);
+    atomic_store_explicit(&device->delay_total_us, 0, memory_order_relaxed);
+    for (uint8_t i = 0; i <= I2C_TRACE_MAX_REGISTERS; i++) {
+        i2c_trace_register_t *const reg = &device->registers[i];
+        atomic_store_explicit(&reg->key, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->transactions, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->nacks, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->timeouts, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->bytes_written, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->bytes_read, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->latency_total_us, 0, memory_order_relaxed);
+        atomic_store_explicit(&reg->latency_max_us, 0, memory_order_relaxed);
+        for (uint8_t b = 0; b < I2C_TRACE_HISTOGRAM_BUCKETS; b++) {
+            atomic_store_explicit(&reg->histogram[b], 0, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Copies the counters of a device slot.
+ */
+static inline void i2c_trace_copy_device(i2c_trace_device_t *const device, i2c_trace_device_stats_t *const stats) {
+    memset(stats, 0, sizeof(i2c_trace_device_stats_t));
+
+    stats->device         = (i2c_master_dev_handle_t)atomic_load_explicit(&device->device, memory_order_acquire);
+    stats->address        = (uint16_t)atomic_load_explicit(&device->address, memory_order_relaxed);
+    stats->delays         = atomic_load_explicit(&device->delays, memory_order_relaxed);
+    stats->delay_total_us = atomic_load_explicit(&device->delay_total_us, memory_order_relaxed);
+    memcpy(stats->name, device->name, sizeof(stats->name));
+    stats->name[I2C_TRACE_NAME_SIZE - 1] = '\0';
+
+    for (uint8_t i = 0; i <= I2C_TRACE_MAX_REGISTERS; i++) {
+        i2c_trace_register_t *const reg = &device->registers[i];
+        const uint32_t key = atomic_load_explicit(&reg->key, memory_order_acquire);
+        if (key == 0) continue;
+
+        i2c_trace_register_stats_t *const out = &stats->registers[stats->register_count++];
+        out->register_address = (uint16_t)(key - 1);
+        out->transactions     = atomic_load_explicit(&reg->transactions, memory_order_relaxed);
+        out->nacks            = atomic_load_explicit(&reg->nacks, memory_order_relaxed);
+        out->timeouts         = atomic_load_explicit(&reg->timeouts, memory_order_relaxed);
+        out->bytes_written    = atomic_load_explicit(&reg->bytes_written, memory_order_relaxed);
+        out->bytes_read       = atomic_load_explicit(&reg->bytes_read, memory_order_relaxed);
+        out->latency_total_us = atomic_load_explicit(&reg->latency_total_us, memory_order_relaxed);
+        out->latency_max_us   = atomic_load_explicit(&reg->latency_max_us, memory_order_relaxed);
+        for (uint8_t b = 0; b < I2C_TRACE_HISTOGRAM_BUCKETS; b++) {
+            out->histogram[b] = atomic_load_explicit(&reg->histogram[b], memory_order_relaxed);
+        }
+
+        stats->transactions     += out->transactions;
+        stats->nacks            += out->nacks;
+        stats->timeouts         += out->timeouts;
+        stats->bytes_written    += out->bytes_written;
+        stats->bytes_read       += out->bytes_read;
+        stats->latency_total_us += out->latency_total_us;
+        if (out->latency_max_us > stats->latency_max_us) stats->latency_max_us = out->latency_max_us;
+    }
+}
+
+esp_err_t i2c_trace_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms) {
+    const int64_t start_time_us = esp_timer_get_time();
+    const esp_err_t ret = i2c_master_transmit(i2c_dev, write_buffer, write_size, xfer_timeout_ms);
+
+    i2c_trace_record_transaction(i2c_dev, I2C_TRACE_OP_TRANSMIT, write_buffer, write_size, 0, start_time_us, ret);
+
+    return ret;
+}
+
+esp_err_t i2c_trace_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    const int64_t start_time_us = esp_timer_get_time();
+    const esp_err_t ret = i2c_master_receive(i2c_dev, read_buffer, read_size, xfer_timeout_ms);
+
+    i2c_trace_record_transaction(i2c_dev, I2C_TRACE_OP_RECEIVE, NULL, 0, read_size, start_time_us, ret);
+
+    return ret;
+}
+
+esp_err_t i2c_trace_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    const int64_t start_time_us = esp_timer_get_time();
+    const esp_err_t ret = i2c_master_transmit_receive(i2c_dev, write_buffer, write_size, read_buffer, read_size, xfer_timeout_ms);
+
+    i2c_trace_record_transaction(i2c_dev, I2C_TRACE_OP_TRANSMIT_RECEIVE, write_buffer, write_size, read_size, start_time_us, ret);
+
+    return ret;
+}
+
+void i2c_trace_delay(i2c_master_dev_handle_t i2c_dev, const TickType_t ticks) {
+    const int64_t start_time_us = esp_timer_get_time();
+
+    vTaskDelay(ticks);
+
+    const uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_time_us);
+    i2c_trace_device_t *const device = i2c_trace_find_device(i2c_dev, true);
+
+    if (device) {
+        atomic_fetch_add_explicit(&device->delays, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&device->delay_total_us, latency_us, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&i2c_trace_dropped, 1, memory_order_relaxed);
+    }
+
+    const i2c_trace_record_t record = {
+        .timestamp_us       = start_time_us,
+        .device             = i2c_dev,
+        .register_address   = device ? i2c_trace_get_last_register(device) : I2C_TRACE_REGISTER_NONE,
+        .operation          = I2C_TRACE_OP_DELAY,
+        .latency_us         = latency_us,
+        .result             = ESP_OK };
+    i2c_trace_push_record(&record);
+}
+
+esp_err_t i2c_trace_add_device(i2c_master_dev_handle_t i2c_dev, const char *name, const uint16_t address) {
+    /* validate arguments */
+    ESP_ARG_CHECK( i2c_dev );
+
+    i2c_trace_device_t *const device = i2c_trace_find_device(i2c_dev, true);
+    ESP_RETURN_ON_FALSE( device, ESP_ERR_NO_MEM, TAG, "maximum traced devices reached, add device failed" );
+
+    /* a handle claimed by a transaction before it was added has no name yet */
+    memset(device->name, 0, sizeof(device->name));
+    if (name) strncpy(device->name, name, I2C_TRACE_NAME_SIZE - 1);
+    atomic_store_explicit(&device->address, address, memory_order_relaxed);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_remove_device(i2c_master_dev_handle_t i2c_dev) {
+    /* validate arguments */
+    ESP_ARG_CHECK( i2c_dev );
+
+    i2c_trace_device_t *const device = i2c_trace_find_device(i2c_dev, false);
+    if (!device) return ESP_ERR_NOT_FOUND;
+
+    i2c_trace_clear_device(device);
+    memset(device->name, 0, sizeof(device->name));
+    atomic_store_explicit(&device->address, 0, memory_order_relaxed);
+    atomic_store_explicit(&device->device, 0, memory_order_release);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_get_snapshot(i2c_trace_snapshot_t *const snapshot) {
+    /* validate arguments */
+    ESP_ARG_CHECK( snapshot );
+
+    snapshot->timestamp_us    = esp_timer_get_time();
+    snapshot->elapsed_us      = snapshot->timestamp_us - atomic_load_explicit(&i2c_trace_reset_time_us, memory_order_relaxed);
+    snapshot->records         = atomic_load_explicit(&i2c_trace_head, memory_order_relaxed);
+    snapshot->dropped_devices = atomic_load_explicit(&i2c_trace_dropped, memory_order_relaxed);
+    snapshot->device_count    = 0;
+
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        if (atomic_load_explicit(&i2c_trace_devices[i].device, memory_order_acquire) == 0) continue;
+        i2c_trace_copy_device(&i2c_trace_devices[i], &snapshot->devices[snapshot->device_count++]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_get_device_stats(i2c_master_dev_handle_t i2c_dev, i2c_trace_device_stats_t *const stats) {
+    /* validate arguments */
+    ESP_ARG_CHECK( i2c_dev && stats );
+
+    i2c_trace_device_t *const device = i2c_trace_find_device(i2c_dev, false);
+    if (!device) return ESP_ERR_NOT_FOUND;
+
+    i2c_trace_copy_device(device, stats);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_get_records(i2c_trace_record_t *const records, const size_t size, size_t *const count) {
+    /* validate arguments */
+    ESP_ARG_CHECK( records && count );
+
+    const uint32_t head  = atomic_load_explicit(&i2c_trace_head, memory_order_acquire);
+    const uint32_t avail = head < I2C_TRACE_RING_SIZE ? head : I2C_TRACE_RING_SIZE;
+    const uint32_t first = head - (size < avail ? (uint32_t)size : avail);
+
+    *count = 0;
+    for (uint32_t index = first; index != head; index++) {
+        i2c_trace_slot_t *const slot = &i2c_trace_ring[index & (I2C_TRACE_RING_SIZE - 1)];
+        const uint32_t sequence = index * 2 + 2;
+
+        /* skip records that are incomplete or were overwritten during the copy */
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != sequence) continue;
+        records[*count] = slot->record;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != sequence) continue;
+        (*count)++;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_dump(void) {
+    i2c_trace_device_stats_t stats;
+
+    ESP_LOGI(TAG, "%lu records, %lu untraced, %lld ms", 
+             (unsigned long)atomic_load(&i2c_trace_head), (unsigned long)atomic_load(&i2c_trace_dropped), 
+             (long long)((esp_timer_get_time() - atomic_load(&i2c_trace_reset_time_us)) / 1000));
+
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        if (atomic_load_explicit(&i2c_trace_devices[i].device, memory_order_acquire) == 0) continue;
+        i2c_trace_copy_device(&i2c_trace_devices[i], &stats);
+
+        ESP_LOGI(TAG, "%s (0x%02x): %lu transactions, %lu nacks, %lu timeouts, %lu/%lu bytes, avg %lu us, max %lu us, %lu sleeps %llu us",
+                 stats.name[0] ? stats.name : "?", stats.address,
+                 (unsigned long)stats.transactions, (unsigned long)stats.nacks, (unsigned long)stats.timeouts,
+                 (unsigned long)stats.bytes_written, (unsigned long)stats.bytes_read,
+                 (unsigned long)(stats.transactions ? stats.latency_total_us / stats.transactions : 0), (unsigned long)stats.latency_max_us,
+                 (unsigned long)stats.delays, (unsigned long long)stats.delay_total_us);
+
+        for (uint8_t r = 0; r < stats.register_count; r++) {
+            const i2c_trace_register_stats_t *const reg = &stats.registers[r];
+            const uint32_t p50 = i2c_trace_get_percentile_us(reg, 50.0f);
+            const uint32_t p99 = i2c_trace_get_percentile_us(reg, 99.0f);
+
+            char reg_name[8];
+
+            if (reg->register_address == I2C_TRACE_REGISTER_NONE) strcpy(reg_name, "none");
+            else if (reg->register_address == I2C_TRACE_REGISTER_OTHER) strcpy(reg_name, "other");
+            else snprintf(reg_name, sizeof(reg_name), "0x%02x", reg->register_address);
+
+            ESP_LOGI(TAG, "  reg %s: %lu transactions, %lu nacks, %lu timeouts, %lu/%lu bytes, avg %lu us, p50 <%ld us, p99 <%ld us, max %lu us",
+                     reg_name,
+                     (unsigned long)reg->transactions, (unsigned long)reg->nacks, (unsigned long)reg->timeouts,
+                     (unsigned long)reg->bytes_written, (unsigned long)reg->bytes_read,
+                     (unsigned long)(reg->transactions ? reg->latency_total_us / reg->transactions : 0),
+                     p50 == UINT32_MAX ? -1L : (long)p50, p99 == UINT32_MAX ? -1L : (long)p99, 
+                     (unsigned long)reg->latency_max_us);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_reset(void) {
+    for (uint8_t i = 0; i < I2C_TRACE_MAX_DEVICES; i++) {
+        i2c_trace_clear_device(&i2c_trace_devices[i]);
+    }
+    for (uint32_t i = 0; i < I2C_TRACE_RING_SIZE; i++) {
+        atomic_store_explicit(&i2c_trace_ring[i].sequence, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&i2c_trace_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&i2c_trace_head, 0, memory_order_release);
+    atomic_store_explicit(&i2c_trace_reset_time_us, esp_timer_get_time(), memory_order_relaxed);
+
+    return ESP_OK;
+}
+
+#else
+
+esp_err_t i2c_trace_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms) {
+    return i2c_master_transmit(i2c_dev, write_buffer, write_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_trace_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    return i2c_master_receive(i2c_dev, read_buffer, read_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_trace_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    return i2c_master_transmit_receive(i2c_dev, write_buffer, write_size, read_buffer, read_size, xfer_timeout_ms);
+}
+
+void i2c_trace_delay(i2c_master_dev_handle_t i2c_dev, const TickType_t ticks) {
+    vTaskDelay(ticks);
+}
+
+esp_err_t i2c_trace_add_device(i2c_master_dev_handle_t i2c_dev, const char *name, const uint16_t address) {
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_remove_device(i2c_master_dev_handle_t i2c_dev) {
+    return ESP_OK;
+}
+
+esp_err_t i2c_trace_get_snapshot(i2c_trace_snapshot_t *const snapshot) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_trace_get_device_stats(i2c_master_dev_handle_t i2c_dev, i2c_trace_device_stats_t *const stats) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_trace_get_records(i2c_trace_record_t *const records, const size_t size, size_t *const count) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_trace_dump(void) {
+    ESP_LOGW(TAG, "CONFIG_I2C_TRACE_ENABLED is not set, nothing to dump");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_trace_reset(void) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_trace.h
+ * @defgroup drivers i2c_trace
+ * @{
+ *
+ * ESP-IDF I2C master transaction instrumentation
+ *
+ * Drivers issue bus transactions and driver sleeps through the 
+ * `I2C_TRACE_TRANSMIT`, `I2C_TRACE_RECEIVE`, `I2C_TRACE_TRANSMIT_RECEIVE`, 
+ * and `I2C_TRACE_DELAY` macros.  When `CONFIG_I2C_TRACE_ENABLED` is not set 
+ * the macros expand to the `i2c_master_*` and `vTaskDelay` calls and there is 
+ * no overhead.  When it is set each transaction is timed and recorded per 
+ * device and per register (the first byte written, a receive is counted 
+ * against the last register written to the device) with a latency 
+ * histogram, byte counts, and NACK and timeout counts, and each driver sleep 
+ * is recorded per device.  The counters and a fixed-size record ring are 
+ * updated with atomic operations, there are no locks on the bus path.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_TRACE_H__
+#define __I2C_TRACE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <driver/i2c_master.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C trace definitions
+*/
+#ifndef CONFIG_I2C_TRACE_MAX_DEVICES
+#define CONFIG_I2C_TRACE_MAX_DEVICES        (8)
+#endif
+#ifndef CONFIG_I2C_TRACE_MAX_REGISTERS
+#define CONFIG_I2C_TRACE_MAX_REGISTERS      (16)
+#endif
+#ifndef CONFIG_I2C_TRACE_RING_SIZE
+#define CONFIG_I2C_TRACE_RING_SIZE          (128)
+#endif
+
+#define I2C_TRACE_MAX_DEVICES           (CONFIG_I2C_TRACE_MAX_DEVICES)      //!< i2c trace, number of traced device handles
+#define I2C_TRACE_MAX_REGISTERS         (CONFIG_I2C_TRACE_MAX_REGISTERS)    //!< i2c trace, number of traced registers per device, further registers are counted as I2C_TRACE_REGISTER_OTHER
+#define I2C_TRACE_RING_SIZE             (CONFIG_I2C_TRACE_RING_SIZE)        //!< i2c trace, number of records in the ring, a power of 2
+#define I2C_TRACE_HISTOGRAM_BUCKETS     (12)                                //!< i2c trace, number of latency histogram buckets
+#define I2C_TRACE_HISTOGRAM_BASE_US     (32)                                //!< i2c trace, upper bound of the first latency histogram bucket in microseconds, the bounds double per bucket
+#define I2C_TRACE_REGISTER_NONE         UINT16_C(0x100)                     //!< i2c trace, register of a receive before any write to the device
+#define I2C_TRACE_REGISTER_OTHER        UINT16_C(0x101)                     //!< i2c trace, register of transactions beyond I2C_TRACE_MAX_REGISTERS
+#define I2C_TRACE_NAME_SIZE             (12)                                //!< i2c trace, device name size including the terminator
+
+/*
+ * I2C trace macro definitions
+*/
+#if CONFIG_I2C_TRACE_ENABLED
+#define I2C_TRACE_TRANSMIT(dev, tx, tx_size, timeout)                                 i2c_trace_transmit(dev, tx, tx_size, timeout)
+#define I2C_TRACE_RECEIVE(dev, rx, rx_size, timeout)                                  i2c_trace_receive(dev, rx, rx_size, timeout)
+#define I2C_TRACE_TRANSMIT_RECEIVE(dev, tx, tx_size, rx, rx_size, timeout)            i2c_trace_transmit_receive(dev, tx, tx_size, rx, rx_size, timeout)
+#define I2C_TRACE_DELAY(dev, ticks)                                                   i2c_trace_delay(dev, ticks)
+#define I2C_TRACE_ADD_DEVICE(dev, name, address)                                      i2c_trace_add_device(dev, name, address)
+#define I2C_TRACE_REMOVE_DEVICE(dev)                                                  i2c_trace_remove_device(dev)
+#else
+#define I2C_TRACE_TRANSMIT(dev, tx, tx_size, timeout)                                 i2c_master_transmit(dev, tx, tx_size, timeout)
+#define I2C_TRACE_RECEIVE(dev, rx, rx_size, timeout)                                  i2c_master_receive(dev, rx, rx_size, timeout)
+#define I2C_TRACE_TRANSMIT_RECEIVE(dev, tx, tx_size, rx, rx_size, timeout)            i2c_master_transmit_receive(dev, tx, tx_size, rx, rx_size, timeout)
+#define I2C_TRACE_DELAY(dev, ticks)                                                   vTaskDelay(ticks)
+#define I2C_TRACE_ADD_DEVICE(dev, name, address)                                      do { } while(0)
+#define I2C_TRACE_REMOVE_DEVICE(dev)                                                  do { } while(0)
+#endif
+
+/*
+ * I2C trace enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C trace record operations enumerator.
+ */
+typedef enum i2c_trace_operations_e {
+    I2C_TRACE_OP_TRANSMIT           = 0,    /*!< i2c trace, write transaction */
+    I2C_TRACE_OP_RECEIVE            = 1,    /*!< i2c trace, read transaction */
+    I2C_TRACE_OP_TRANSMIT_RECEIVE   = 2,    /*!< i2c trace, write then read transaction with a repeated start */
+    I2C_TRACE_OP_DELAY              = 3     /*!< i2c trace, driver sleep */
+} i2c_trace_operations_t;
+
+/**
+ * @brief I2C trace record structure, one transaction or driver sleep.
+ */
+typedef struct i2c_trace_record_s {
+    uint32_t                    sequence;           /*!< i2c trace record, sequence number since the trace was reset */
+    int64_t                     timestamp_us;       /*!< i2c trace record, start time from esp_timer in microseconds */
+    i2c_master_dev_handle_t     device;             /*!< i2c trace record, device handle */
+    uint16_t                    register_address;   /*!< i2c trace record, register or command, I2C_TRACE_REGISTER_NONE for a receive before any write */
+    i2c_trace_operations_t      operation;          /*!< i2c trace record, operation */
+    uint16_t                    write_size;         /*!< i2c trace record, bytes written */
+    uint16_t                    read_size;          /*!< i2c trace record, bytes read */
+    uint32_t                    latency_us;         /*!< i2c trace record, transaction or sleep time in microseconds */
+    esp_err_t                   result;             /*!< i2c trace record, transaction result */
+} i2c_trace_record_t;
+
+/**
+ * @brief I2C trace register statistics structure.
+ */
+typedef struct i2c_trace_register_stats_s {
+    uint16_t                    register_address;   /*!< i2c trace register, register or command, I2C_TRACE_REGISTER_NONE or I2C_TRACE_REGISTER_OTHER */
+    uint32_t                    transactions;       /*!< i2c trace register, number of transactions */
+    uint32_t                    nacks;              /*!< i2c trace register, number of transactions not acknowledged or failed other than by timeout */
+    uint32_t                    timeouts;           /*!< i2c trace register, number of transactions that timed out */
+    uint32_t                    bytes_written;      /*!< i2c trace register, bytes written */
+    uint32_t                    bytes_read;         /*!< i2c trace register, bytes read */
+    uint64_t                    latency_total_us;   /*!< i2c trace register, total transaction time in microseconds */
+    uint32_t                    latency_max_us;     /*!< i2c trace register, maximum transaction time in microseconds */
+    uint32_t                    histogram[I2C_TRACE_HISTOGRAM_BUCKETS]; /*!< i2c trace register, transactions by latency, bucket n is below I2C_TRACE_HISTOGRAM_BASE_US << n and the last bucket is unbounded */
+} i2c_trace_register_stats_t;
+
+/**
+ * @brief I2C trace device statistics structure.
+ */
+typedef struct i2c_trace_device_stats_s {
+    i2c_master_dev_handle_t     device;             /*!< i2c trace device, device handle */
+    char                        name[I2C_TRACE_NAME_SIZE]; /*!< i2c trace device, name given when the device was added */
+    uint16_t                    address;            /*!< i2c trace device, 7-bit address given when the device was added */
+    uint32_t                    transactions;       /*!< i2c trace device, number of transactions of all registers */
+    uint32_t                    nacks;              /*!< i2c trace device, number of transactions not acknowledged of all registers */
+    uint32_t                    timeouts;           /*!< i2c trace device, number of transactions that timed out of all registers */
+    uint32_t                    bytes_written;      /*!< i2c trace device, bytes written of all registers */
+    uint32_t                    bytes_read;         /*!< i2c trace device, bytes read of all registers */
+    uint64_t                    latency_total_us;   /*!< i2c trace device, total transaction time of all registers in microseconds */
+    uint32_t                    latency_max_us;     /*!< i2c trace device, maximum transaction time of all registers in microseconds */
+    uint32_t                    delays;             /*!< i2c trace device, number of driver sleeps */
+    uint64_t                    delay_total_us;     /*!< i2c trace device, time spent in driver sleeps in microseconds */
+    uint8_t                     register_count;     /*!< i2c trace device, number of valid register statistics */
+    i2c_trace_register_stats_t  registers[I2C_TRACE_MAX_REGISTERS + 1]; /*!< i2c trace device, register statistics in order of first use, followed by I2C_TRACE_REGISTER_OTHER when used */
+} i2c_trace_device_stats_t;
+
+/**
+ * @brief I2C trace snapshot structure.
+ */
+typedef struct i2c_trace_snapshot_s {
+    int64_t                     timestamp_us;       /*!< i2c trace snapshot, time of the snapshot from esp_timer in microseconds */
+    int64_t                     elapsed_us;         /*!< i2c trace snapshot, time since the trace was reset in microseconds */
+    uint32_t                    records;            /*!< i2c trace snapshot, number of records written to the ring since the trace was reset */
+    uint32_t                    dropped_devices;    /*!< i2c trace snapshot, transactions not recorded because I2C_TRACE_MAX_DEVICES was reached */
+    uint8_t                     device_count;       /*!< i2c trace snapshot, number of valid device statistics */
+    i2c_trace_device_stats_t    devices[I2C_TRACE_MAX_DEVICES]; /*!< i2c trace snapshot, device statistics */
+} i2c_trace_snapshot_t;
+
+/**
+ * @brief Writes to an I2C device and records the transaction, see `i2c_master_transmit`.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param write_buffer Data bytes to write, the first byte is recorded as the register.
+ * @param write_size Size of the write buffer in bytes.
+ * @param xfer_timeout_ms Transaction timeout in milliseconds, -1 waits forever.
+ * @return esp_err_t Result of `i2c_master_transmit`.
+ */
+esp_err_t i2c_trace_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms);
+
+/**
+ * @brief Reads from an I2C device and records the transaction against the last register 
+ * written to the device, see `i2c_master_receive`.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param read_buffer Data bytes read.
+ * @param read_size Size of the read buffer in bytes.
+ * @param xfer_timeout_ms Transaction timeout in milliseconds, -1 waits forever.
+ * @return esp_err_t Result of `i2c_master_receive`.
+ */
+esp_err_t i2c_trace_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms);
+
+/**
+ * @brief Writes to and reads from an I2C device with a repeated start and records the 
+ * transaction, see `i2c_master_transmit_receive`.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param write_buffer Data bytes to write, the first byte is recorded as the register.
+ * @param write_size Size of the write buffer in bytes.
+ * @param read_buffer Data bytes read.
+ * @param read_size Size of the read buffer in bytes.
+ * @param xfer_timeout_ms Transaction timeout in milliseconds, -1 waits forever.
+ * @return esp_err_t Result of `i2c_master_transmit_receive`.
+ */
+esp_err_t i2c_trace_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms);
+
+/**
+ * @brief Delays the calling task and records the sleep against an I2C device, see `vTaskDelay`.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param ticks Delay in ticks.
+ */
+void i2c_trace_delay(i2c_master_dev_handle_t i2c_dev, const TickType_t ticks);
+
+/**
+ * @brief Names an I2C device in the trace statistics, called by drivers after the device 
+ * handle is added to the bus.  Devices are also traced without a name.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param name Device name, truncated to I2C_TRACE_NAME_SIZE - 1 characters.
+ * @param address 7-bit device address.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when I2C_TRACE_MAX_DEVICES are traced.
+ */
+esp_err_t i2c_trace_add_device(i2c_master_dev_handle_t i2c_dev, const char *name, const uint16_t address);
+
+/**
+ * @brief Releases the trace statistics of an I2C device, called by drivers before the device 
+ * handle is removed from the bus so that a new handle at the same location is not mixed up.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the device is not traced.
+ */
+esp_err_t i2c_trace_remove_device(i2c_master_dev_handle_t i2c_dev);
+
+/**
+ * @brief Copies the statistics of all traced devices.  Counters are read individually while 
+ * transactions may be recorded, the snapshot is consistent per counter.
+ * 
+ * @param snapshot Trace snapshot.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+esp_err_t i2c_trace_get_snapshot(i2c_trace_snapshot_t *const snapshot);
+
+/**
+ * @brief Copies the statistics of a traced device.
+ * 
+ * @param i2c_dev I2C master device handle.
+ * @param stats Device statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the device is not traced, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+esp_err_t i2c_trace_get_device_stats(i2c_master_dev_handle_t i2c_dev, i2c_trace_device_stats_t *const stats);
+
+/**
+ * @brief Copies the most recent records from the ring, oldest first.  Records overwritten 
+ * while they are copied are skipped.
+ * 
+ * @param records Record array.
+ * @param size Size of the record array.
+ * @param count Number of records copied.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+esp_err_t i2c_trace_get_records(i2c_trace_record_t *const records, const size_t size, size_t *const count);
+
+/**
+ * @brief Logs the statistics of all traced devices and registers.
+ * 
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+esp_err_t i2c_trace_dump(void);
+
+/**
+ * @brief Clears the statistics and the record ring, traced devices remain traced.
+ * 
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+esp_err_t i2c_trace_reset(void);
+
+/**
+ * @brief Gets the latency below which a percentage of the transactions of a register completed, 
+ * from the histogram bucket bounds.
+ * 
+ * @param stats Register statistics.
+ * @param percentile Percentile, 0 to 100.
+ * @return uint32_t Latency bucket bound in microseconds, UINT32_MAX when it is in the last bucket, 0 without transactions.
+ */
+uint32_t i2c_trace_get_percentile_us(const i2c_trace_register_stats_t *const stats, const float percentile);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_TRACE_H__
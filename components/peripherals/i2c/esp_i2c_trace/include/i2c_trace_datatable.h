@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_trace_datatable.h
+ * @defgroup drivers i2c_trace
+ * @{
+ *
+ * Exports I2C trace device statistics into an esp_datalogger data-table
+ *
+ * Header only, so that drivers that use esp_i2c_trace do not depend on 
+ * esp_datalogger.  The application that includes this header requires 
+ * esp_datalogger.  Per sample interval the mean transaction latency, the 
+ * cumulative NACK and timeout count, and the driver sleep time of a device 
+ * are pushed as data-table samples.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_TRACE_DATATABLE_H__
+#define __I2C_TRACE_DATATABLE_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <esp_check.h>
+#include <datatable.h>
+#include "i2c_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C trace data-table definitions
+*/
+#define I2C_TRACE_DATATABLE_NAME_MAX_SIZE   (DATATABLE_COLUMN_NAME_SIZE - 4)    //!< i2c trace data-table, maximum column name prefix length, a 4-character suffix is appended
+
+/**
+ * @brief I2C trace data-table columns structure, column indexes and the totals of the previous sample.
+ */
+typedef struct i2c_trace_datatable_columns_s {
+    i2c_master_dev_handle_t     device;                 /*!< i2c trace data-table, traced device handle */
+    uint8_t                     latency_avg_index;      /*!< i2c trace data-table, mean transaction latency in microseconds column index, average process-type */
+    uint8_t                     latency_max_index;      /*!< i2c trace data-table, mean transaction latency in microseconds column index, maximum process-type */
+    uint8_t                     errors_index;           /*!< i2c trace data-table, cumulative nacks and timeouts column index, sample process-type */
+    uint8_t                     delay_index;            /*!< i2c trace data-table, driver sleep time in milliseconds column index, average process-type */
+    uint32_t                    transactions;           /*!< i2c trace data-table, transactions at the previous sample */
+    uint64_t                    latency_total_us;       /*!< i2c trace data-table, total latency at the previous sample */
+    uint64_t                    delay_total_us;         /*!< i2c trace data-table, total sleep time at the previous sample */
+} i2c_trace_datatable_columns_t;
+
+/**
+ * @brief Adds the columns of a traced device to a data-table.  Columns are named `<name>_lat`, 
+ * `<name>_lmx`, `<name>_err`, and `<name>_slp`.
+ * 
+ * @param datatable_handle Data-table handle.
+ * @param i2c_dev I2C master device handle.
+ * @param name Column name prefix, maximum of I2C_TRACE_DATATABLE_NAME_MAX_SIZE characters.
+ * @param columns I2C trace data-table columns, used by `i2c_trace_datatable_push_samples`.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_trace_datatable_add_columns(datatable_handle_t datatable_handle, i2c_master_dev_handle_t i2c_dev, const char *name, i2c_trace_datatable_columns_t *const columns) {
+    char column_name[DATATABLE_COLUMN_NAME_SIZE + 1];
+
+    /* validate arguments */
+    if (!datatable_handle || !i2c_dev || !name || !columns || strlen(name) > I2C_TRACE_DATATABLE_NAME_MAX_SIZE) return ESP_ERR_INVALID_ARG;
+
+    memset(columns, 0, sizeof(i2c_trace_datatable_columns_t));
+    columns->device = i2c_dev;
+
+    snprintf(column_name, sizeof(column_name), "%s_lat", name);
+    ESP_RETURN_ON_ERROR( datatable_add_float_avg_column(datatable_handle, column_name, &columns->latency_avg_index), "i2c_trace", "add latency average column failed" );
+    snprintf(column_name, sizeof(column_name), "%s_lmx", name);
+    ESP_RETURN_ON_ERROR( datatable_add_float_max_column(datatable_handle, column_name, &columns->latency_max_index), "i2c_trace", "add latency maximum column failed" );
+    snprintf(column_name, sizeof(column_name), "%s_err", name);
+    ESP_RETURN_ON_ERROR( datatable_add_int16_smp_column(datatable_handle, column_name, &columns->errors_index), "i2c_trace", "add errors column failed" );
+    snprintf(column_name, sizeof(column_name), "%s_slp", name);
+    ESP_RETURN_ON_ERROR( datatable_add_float_avg_column(datatable_handle, column_name, &columns->delay_index), "i2c_trace", "add sleep column failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Pushes the trace statistics of a device since the previous call as data-table samples, 
+ * called from the data-table sampling task after `datatable_sampling_task_delay`.
+ * 
+ * @param datatable_handle Data-table handle.
+ * @param columns I2C trace data-table columns added with `i2c_trace_datatable_add_columns`.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when CONFIG_I2C_TRACE_ENABLED is not set.
+ */
+static inline esp_err_t i2c_trace_datatable_push_samples(datatable_handle_t datatable_handle, i2c_trace_datatable_columns_t *const columns) {
+    i2c_trace_device_stats_t stats;
+
+    /* validate arguments */
+    if (!datatable_handle || !columns) return ESP_ERR_INVALID_ARG;
+
+    /* a device without transactions yet has no statistics */
+    const esp_err_t ret = i2c_trace_get_device_stats(columns->device, &stats);
+    if (ret == ESP_ERR_NOT_FOUND) memset(&stats, 0, sizeof(stats));
+    else if (ret != ESP_OK) return ret;
+
+    /* counters restart after i2c_trace_reset */
+    if (stats.transactions < columns->transactions || stats.delay_total_us < columns->delay_total_us) {
+        columns->transactions     = 0;
+        columns->latency_total_us = 0;
+        columns->delay_total_us   = 0;
+    }
+
+    const uint32_t transactions = stats.transactions - columns->transactions;
+    const float latency_us = transactions ? (float)(stats.latency_total_us - columns->latency_total_us) / (float)transactions : 0.0f;
+    const uint32_t errors = stats.nacks + stats.timeouts;
+
+    ESP_RETURN_ON_ERROR( datatable_push_float_sample(datatable_handle, columns->latency_avg_index, latency_us), "i2c_trace", "push latency average sample failed" );
+    ESP_RETURN_ON_ERROR( datatable_push_float_sample(datatable_handle, columns->latency_max_index, latency_us), "i2c_trace", "push latency maximum sample failed" );
+    ESP_RETURN_ON_ERROR( datatable_push_int16_sample(datatable_handle, columns->errors_index, (int16_t)(errors > INT16_MAX ? INT16_MAX : errors)), "i2c_trace", "push errors sample failed" );
+    ESP_RETURN_ON_ERROR( datatable_push_float_sample(datatable_handle, columns->delay_index, (float)(stats.delay_total_us - columns->delay_total_us) / 1000.0f), "i2c_trace", "push sleep sample failed" );
+
+    columns->transactions     = stats.transactions;
+    columns->latency_total_us = stats.latency_total_us;
+    columns->delay_total_us   = stats.delay_total_us;
+
+    return ESP_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_TRACE_DATATABLE_H__
@@ -69,6 +69,7 @@
 #define INA226_DATA_POLL_TIMEOUT_MS     UINT16_C(100)
 #define INA226_CMD_DELAY_MS             UINT16_C(10)
 #define INA226_TX_RX_DELAY_MS           UINT16_C(10)
+#define INA226_CONFIG_RESERVED          UINT8_C(0b100)  //!< ina226 configuration register reserved bits (bit:12-14) power-on value
 
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
@@ -140,6 +141,28 @@ static inline esp_err_t ina226_i2c_write_word_to(ina226_device_t *const device,
     return ESP_OK;
 }
 
+/**
+ * @brief Gets INA226 ADC conversion time in microseconds from conversion time setting.  See datasheet for details.
+ * 
+ * @param conv_time INA226 voltage conversion time setting.
+ * @return uint32_t Conversion time in microseconds.
+ */
+static inline uint32_t ina226_get_conversion_time(const ina226_volt_conv_times_t conv_time) {
+    static const uint16_t conv_times_us[] = { 140, 204, 332, 588, 1100, 2116, 4156, 8244 };
+    return conv_times_us[conv_time & 0x07];
+}
+
+/**
+ * @brief Gets INA226 number of averaged samples from averaging mode setting.  See datasheet for details.
+ * 
+ * @param mode INA226 averaging mode setting.
+ * @return uint32_t Number of averaged samples.
+ */
+static inline uint32_t ina226_get_averaging_samples(const ina226_averaging_modes_t mode) {
+    static const uint16_t samples[] = { 1, 4, 16, 64, 128, 256, 512, 1024 };
+    return samples[mode & 0x07];
+}
+
 esp_err_t ina226_get_configuration_register(ina226_handle_t handle, ina226_config_register_t *const reg) {
     ina226_device_t* dev = (ina226_device_t*)handle;
 
@@ -513,7 +536,76 @@ esp_err_t ina226_get_power(ina226_handle_t handle, float *const power) {
     return ESP_OK;
 }
 
-esp_err_t ina226_get_mode(ina226_handle_t handle, ina226_operating_modes_t *const mode) {
+esp_err_t ina226_start_measurement(ina226_handle_t handle) {
+    ina226_config_register_t config = { 0 };
+    ina226_device_t* dev = (ina226_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev );
+
+    /* continuous modes are already converting */
+    if (dev->config.operating_mode >= INA226_OP_MODE_CONT_SHUNT_VOLT) return ESP_OK;
+    ESP_RETURN_ON_FALSE( dev->config.operating_mode != INA226_OP_MODE_SHUTDOWN, ESP_ERR_INVALID_STATE, TAG, "device is shutdown, start measurement failed" );
+
+    /* initialize configuration register from configuration params */
+    config.bits.operating_mode      = dev->config.operating_mode;
+    config.bits.averaging_mode      = dev->config.averaging_mode;
+    config.bits.bus_volt_conv_time  = dev->config.bus_voltage_conv_time;
+    config.bits.shun_volt_conv_time = dev->config.shunt_voltage_conv_time;
+    config.bits.reserved            = INA226_CONFIG_RESERVED;
+
+    /* attempt i2c write transaction, writing a triggered mode starts a single-shot conversion */
+    ESP_RETURN_ON_ERROR( ina226_i2c_write_word_to(dev, INA226_REG_CONFIG, config.reg), TAG, "write configuration register for start measurement failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t ina226_get_measurement_ready_time(ina226_handle_t handle, uint32_t *const ready_time_us) {
+    uint32_t conv_time_us = 0;
+    ina226_device_t* dev = (ina226_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && ready_time_us );
+
+    /* operating mode bit 0 enables the shunt and bit 1 enables the bus voltage conversion */
+    if (dev->config.operating_mode & 0x01) conv_time_us += ina226_get_conversion_time(dev->config.shunt_voltage_conv_time);
+    if (dev->config.operating_mode & 0x02) conv_time_us += ina226_get_conversion_time(dev->config.bus_voltage_conv_time);
+
+    /* each averaged sample is a full conversion cycle */
+    *ready_time_us = conv_time_us * ina226_get_averaging_samples(dev->config.averaging_mode);
+
+    return ESP_OK;
+}
+
+esp_err_t ina226_collect_measurement(ina226_handle_t handle, float *const bus_voltage, float *const current, float *const power) {
+    ina226_mask_enable_register_t mske;
+    uint16_t sig;
+    ina226_device_t* dev = (ina226_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && bus_voltage && current && power );
+
+    /* attempt i2c read transaction, reading the mask/enable register clears the conversion ready flag */
+    ESP_RETURN_ON_ERROR( ina226_i2c_read_word_from(dev, INA226_REG_MSK_ENA, &sig), TAG, "read mask-enable register for collect measurement failed" );
+    mske.reg = sig;
+
+    /* validate conversion completed */
+    if (mske.bits.conversion_ready_flag == false) return ESP_ERR_NOT_FINISHED;
+
+    /* attempt i2c read transactions */
+    ESP_RETURN_ON_ERROR( ina226_i2c_read_word_from(dev, INA226_REG_BUS_V, &sig), TAG, "read bus voltage for collect measurement failed" );
+    *bus_voltage = (float)sig * 0.00125f;
+
+    ESP_RETURN_ON_ERROR( ina226_i2c_read_word_from(dev, INA226_REG_CURRENT, &sig), TAG, "read current for collect measurement failed" );
+    *current = (float)sig * dev->current_lsb;
+
+    ESP_RETURN_ON_ERROR( ina226_i2c_read_word_from(dev, INA226_REG_POWER, &sig), TAG, "read power for collect measurement failed" );
+    *power = (float)sig * dev->current_lsb * 25;
+
+    return ESP_OK;
+}
+
+esp_err_t ina226_get_operating_mode(ina226_handle_t handle, ina226_operating_modes_t *const mode) {
     ina226_config_register_t config;
 
     /* validate arguments */
@@ -528,11 +620,12 @@ esp_err_t ina226_get_mode(ina226_handle_t handle, ina226_operating_modes_t *cons
     return ESP_OK;
 }
 
-esp_err_t ina226_set_mode(ina226_handle_t handle, const ina226_operating_modes_t mode) {
+esp_err_t ina226_set_operating_mode(ina226_handle_t handle, const ina226_operating_modes_t mode) {
     ina226_config_register_t config;
+    ina226_device_t* dev = (ina226_device_t*)handle;
 
     /* validate arguments */
-    ESP_ARG_CHECK( handle );
+    ESP_ARG_CHECK( dev );
 
     /* attempt to read configuration register */
     ESP_RETURN_ON_ERROR( ina226_get_configuration_register(handle, &config), TAG, "read configuration register failed" );
@@ -543,6 +636,9 @@ esp_err_t ina226_set_mode(ina226_handle_t handle, const ina226_operating_modes_t
     /* attempt to write configuration register */
     ESP_RETURN_ON_ERROR( ina226_set_configuration_register(handle, config), TAG, "write configuration register failed" );
 
+    /* set configuration */
+    dev->config.operating_mode = mode;
+
     return ESP_OK;
 }
 
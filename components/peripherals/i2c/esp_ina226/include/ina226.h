@@ -348,6 +348,40 @@ esp_err_t ina226_get_triggered_current(ina226_handle_t handle, float *const curr
  */
 esp_err_t ina226_get_power(ina226_handle_t handle, float *const power);
 
+/**
+ * @brief Starts an INA226 conversion without waiting for it to complete.  Triggered operating modes start a
+ * single-shot conversion, continuous operating modes are already converting and return immediately.
+ *
+ * @note Use `ina226_get_measurement_ready_time` to schedule the `ina226_collect_measurement` call.
+ *
+ * @param[in] handle INA226 device handle.
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE when the device is configured for shutdown.
+ */
+esp_err_t ina226_start_measurement(ina226_handle_t handle);
+
+/**
+ * @brief Gets the INA226 conversion time, in microseconds, computed from the configured operating mode,
+ * shunt and bus voltage conversion times, and averaging mode.
+ *
+ * @param[in] handle INA226 device handle.
+ * @param[out] ready_time_us Measurement conversion time in microseconds.
+ * @return ESP_OK on success.
+ */
+esp_err_t ina226_get_measurement_ready_time(ina226_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads bus voltage, current and power from INA226 after `ina226_start_measurement`.  This is a non-blocking function.
+ *
+ * @note Current and power are valid only after calibration.
+ *
+ * @param[in] handle INA226 device handle.
+ * @param[out] bus_voltage INA226 bus voltage, V.
+ * @param[out] current INA226 current, A.
+ * @param[out] power INA226 power, W.
+ * @return ESP_OK on success, ESP_ERR_NOT_FINISHED when the conversion ready flag is not set.
+ */
+esp_err_t ina226_collect_measurement(ina226_handle_t handle, float *const bus_voltage, float *const current, float *const power);
+
 /**
  * @brief Reads operating mode from the INA226.
  *
@@ -43,6 +43,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_trace.h>
 
 
 #define INA228_REG_CONFIG               (0x00)
@@ -111,7 +112,7 @@ static inline esp_err_t ina228_i2c_read_from(ina228_handle_t handle, const uint8
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_read_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_read_from failed" );
 
     return ESP_OK;
 }
@@ -131,7 +132,7 @@ static inline esp_err_t ina228_i2c_read_word_from(ina228_handle_t handle, const
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_read_word_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_read_word_from failed" );
 
     /* set output parameter */
     *word = ((uint16_t)rx[0] << 8) | (uint16_t)rx[1];
@@ -154,7 +155,7 @@ static inline esp_err_t ina228_i2c_write_word_to(ina228_handle_t handle, const u
     ESP_ARG_CHECK( handle );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle->i2c_handle, tx, BIT24_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_write_word_to, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(handle->i2c_handle, tx, BIT24_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "ina228_i2c_write_word_to, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -180,7 +181,7 @@ esp_err_t ina228_get_configuration_register(ina228_handle_t handle, ina228_confi
     reg->reg = cfg;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -197,7 +198,7 @@ esp_err_t ina228_set_configuration_register(ina228_handle_t handle, const ina228
     ESP_RETURN_ON_ERROR( ina228_i2c_write_word_to(handle, INA228_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -214,7 +215,7 @@ esp_err_t ina228_get_adc_configuration_register(ina228_handle_t handle, ina228_a
     reg->reg = cfg;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -229,7 +230,7 @@ esp_err_t ina228_set_adc_configuration_register(ina228_handle_t handle, const in
     ESP_RETURN_ON_ERROR( ina228_i2c_write_word_to(handle, INA228_REG_ADC_CONFIG, config.reg), TAG, "write adc configuration register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -246,7 +247,7 @@ esp_err_t ina228_get_shunt_calibration_register(ina228_handle_t handle, ina228_s
     reg->reg = cfg;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -259,7 +260,7 @@ esp_err_t ina228_set_shunt_calibration_register(ina228_handle_t handle, const in
     ESP_RETURN_ON_ERROR( ina228_i2c_write_word_to(handle, INA228_REG_SHUNT_CAL, reg.reg), TAG, "write shunt calibration register failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -276,7 +277,7 @@ esp_err_t ina228_get_diagnostic_alert_register(ina228_handle_t handle, ina228_di
     reg->reg = mske;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
     
     return ESP_OK;
 }
@@ -310,10 +311,11 @@ esp_err_t ina228_init(i2c_master_bus_handle_t master_handle, const ina228_config
     /* validate device handle */
     if (out_handle->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &out_handle->i2c_handle), err_handle, TAG, "i2c new bus failed");
+        I2C_TRACE_ADD_DEVICE(out_handle->i2c_handle, "ina228", i2c_dev_conf.device_address);
     }
 
     /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(100));
+    I2C_TRACE_DELAY(out_handle->i2c_handle, pdMS_TO_TICKS(100));
 
     /* attempt to soft-reset */
     ESP_GOTO_ON_ERROR(ina228_reset(out_handle), err_handle, TAG, "unable to soft-reset, init failed");
@@ -322,12 +324,13 @@ esp_err_t ina228_init(i2c_master_bus_handle_t master_handle, const ina228_config
     *ina228_handle = out_handle;
 
     /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_APPSTART_DELAY_MS));
+    I2C_TRACE_DELAY(out_handle->i2c_handle, pdMS_TO_TICKS(INA228_APPSTART_DELAY_MS));
 
     return ESP_OK;
 
     err_handle:
         if (out_handle && out_handle->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(out_handle->i2c_handle);
             i2c_master_bus_rm_device(out_handle->i2c_handle);
         }
         free(out_handle);
@@ -351,7 +354,7 @@ esp_err_t ina228_shunt_calibration(ina228_handle_t handle, const float max_curre
         shunt_cal *= 4;
     }
 
-    ina228_shunt_calibration_register_t shunt_cal_reg;
+    ina228_shunt_calibration_register_t shunt_cal_reg = { .reg = 0 };
     shunt_cal_reg.bits.shunt_calibration = (uint16_t)shunt_cal;
 
     ESP_RETURN_ON_ERROR( ina228_set_shunt_calibration_register(handle, shunt_cal_reg), TAG, "write shunt calibration register failed" );
@@ -378,7 +381,7 @@ esp_err_t ina228_get_shunt_voltage(ina228_handle_t handle, float *const voltage)
     *voltage =(float)sig * shunt_lsb;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -399,7 +402,7 @@ esp_err_t ina228_get_bus_voltage(ina228_handle_t handle, float *const voltage) {
     *voltage = (float)sig * bus_lsb; /* 195.3125 uV */
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -418,7 +421,7 @@ esp_err_t ina228_get_current(ina228_handle_t handle, float *const current) {
     *current = (float)sig * handle->current_lsb;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -435,7 +438,7 @@ esp_err_t ina228_get_power(ina228_handle_t handle, float *const power) {
     *power = (float)sig * handle->current_lsb * 3.2f;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -504,7 +507,7 @@ esp_err_t ina228_reset(ina228_handle_t handle) {
     ESP_RETURN_ON_ERROR(ina228_set_configuration_register(handle, config), TAG, "unable to write configuration register, reset failed");
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(INA228_RESET_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(INA228_RESET_DELAY_MS));
 
     /* attempt to configure device */
     ESP_RETURN_ON_ERROR(ina228_get_configuration_register(handle, &config), TAG, "unable to read configuration register, reset failed");
@@ -534,6 +537,7 @@ esp_err_t ina228_remove(ina228_handle_t handle) {
     ESP_ARG_CHECK( handle );
 
     /* remove device from i2c master bus */
+    I2C_TRACE_REMOVE_DEVICE(handle->i2c_handle);
     return i2c_master_bus_rm_device(handle->i2c_handle);
 }
 
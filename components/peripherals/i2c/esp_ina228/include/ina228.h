@@ -231,16 +231,16 @@ typedef union __attribute__((packed)) ina228_adc_config_register_u {
 
 typedef union __attribute__((packed)) ina228_shunt_calibration_register_u {
     struct {
-        uint8_t     reserved:1;
-        uint16_t    shunt_calibration:15;
+        uint16_t    shunt_calibration:15;       /*!< shunt calibration (bit:0-14) */
+        uint16_t    reserved:1;                 /*!< reserved (bit:15) */
     } bits;                  /*!< represents the 16-bit control register parts in bits. */
     uint16_t reg;           /*!< represents the 16-bit control register as `uint16_t` */
 } ina228_shunt_calibration_register_t;
 
 typedef union __attribute__((packed)) ina228_shunt_temperature_coefficient_register_u {
     struct {
-        uint8_t     reserved:2;
-        uint16_t    temperature_coefficient:14;
+        uint16_t    temperature_coefficient:14; /*!< shunt temperature coefficient (bit:0-13) */
+        uint16_t    reserved:2;                 /*!< reserved (bit:14-15) */
     } bits;                  /*!< represents the 16-bit control register parts in bits. */
     uint16_t reg;           /*!< represents the 16-bit control register as `uint16_t` */
 } ina228_shunt_temperature_coefficient_register_t;
@@ -214,6 +214,9 @@ typedef struct max30105_adc_channels_count_data_s {
     uint32_t ir_count[MAX30105_CH_SMP_MAX];
     uint32_t green_count[MAX30105_CH_SMP_MAX];
     uint8_t  sample_size;
+    uint8_t  overflow_count;    /*!< max30105 number of samples lost to a full FIFO before this read, saturates at 31 */
+    int64_t  timestamp;         /*!< max30105 time of the oldest sample (index 0) in micro-seconds, sample i is at timestamp + i * sample_period */
+    uint32_t sample_period;     /*!< max30105 time between FIFO samples in micro-seconds (sample rate and averaging) */
 } max30105_adc_channels_count_data_t;
 
 /**
@@ -276,6 +279,48 @@ esp_err_t max30105_init(i2c_master_bus_handle_t master_handle, const max30105_co
  */
 esp_err_t max30105_get_optical_counts(max30105_handle_t handle, max30105_adc_channels_count_data_t *const data);
 
+/**
+ * @brief Configures the FIFO almost full threshold, sample averaging and rollover on MAX30105, 
+ * and clears the FIFO pointers.
+ *
+ * @param handle MAX30105 device handle.
+ * @param almost_full_threshold MAX30105 FIFO almost full threshold, number of free samples (0 to 15) when the interrupt triggers.
+ * @param average MAX30105 FIFO sample averaging setting.
+ * @param rollover_enabled MAX30105 FIFO overwrites the oldest samples when full when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t max30105_configure_fifo(max30105_handle_t handle, const uint8_t almost_full_threshold, const max30105_sample_averages_t average, const bool rollover_enabled);
+
+/**
+ * @brief Clears the FIFO write, overflow counter and read pointers on MAX30105.
+ *
+ * @param handle MAX30105 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t max30105_clear_fifo(max30105_handle_t handle);
+
+/**
+ * @brief Reads the number of pending FIFO samples and lost samples from MAX30105 in one transaction.
+ *
+ * @param handle MAX30105 device handle.
+ * @param[out] count Number of samples pending in the FIFO (0 to 32).
+ * @param[out] overflow_count Number of samples lost to a full FIFO (0 to 31).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t max30105_get_fifo_count(max30105_handle_t handle, uint8_t *const count, uint8_t *const overflow_count);
+
+/**
+ * @brief Drains all pending FIFO samples from MAX30105.  The FIFO pointers are read once and 
+ * the pending 3 to 12-byte samples are burst-read in one transaction and unpacked into the 
+ * red, IR and green channel counts.  In multi-LED mode the channel of each sample position 
+ * follows the LED of its time slot.  Samples are timestamped from the sample period.
+ *
+ * @param handle MAX30105 device handle.
+ * @param[out] data Data structure that contains the Red, IR and Green LED counts, lost sample count and timestamps.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t max30105_read_fifo(max30105_handle_t handle, max30105_adc_channels_count_data_t *const data);
+
 /**
  * @brief Reads FIFO data status from MAX30105.
  *
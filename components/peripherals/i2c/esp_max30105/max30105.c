@@ -43,6 +43,7 @@
  */
 #include "include/max30105.h"
 #include <string.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 #include <esp_log.h>
@@ -95,6 +96,14 @@
 #define MAX30105_CMD_DELAY_MS               UINT16_C(5)     /*!< max30105 delay before attempting I2C transactions after a command is issued */
 #define MAX30105_TX_RX_DELAY_MS             UINT16_C(10)    /*!< max30105 delay after attempting an I2C transmit transaction and attempting an I2C receive transaction */
 
+#define MAX30105_FIFO_POINTER_MASK          UINT8_C(0x1f)   /*!< max30105 fifo write, overflow counter and read pointer mask */
+#define MAX30105_FIFO_DATA_MASK             UINT32_C(0x3ffff) /*!< max30105 fifo 18-bit left-justified adc count mask */
+#define MAX30105_FIFO_CHANNEL_SIZE          UINT8_C(3)      /*!< max30105 fifo bytes per LED channel */
+#define MAX30105_FIFO_CHANNEL_MAX           UINT8_C(3)      /*!< max30105 fifo LED channels unpacked (red, ir, green) */
+#define MAX30105_FIFO_SLOT_MAX              UINT8_C(4)      /*!< max30105 multi-LED mode time slots */
+#define MAX30105_FIFO_CHANNEL_SKIP          UINT8_C(0xff)   /*!< max30105 fifo sample position not unpacked */
+#define MAX30105_FIFO_BUFFER_SIZE           (MAX30105_CH_SMP_MAX * MAX30105_FIFO_CHANNEL_SIZE * MAX30105_FIFO_SLOT_MAX)
+
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
 /*
@@ -286,8 +295,15 @@ typedef union __attribute__((packed)) max30105_temperature_config_register_u {
  * @brief MAX30105 device descriptor structure definition.
  */
 typedef struct max30105_device_s {
-    max30105_config_t                      config;      /*!< max30105 device configuration */
-    i2c_master_dev_handle_t                i2c_handle;  /*!< max30105 I2C device handle */
+    max30105_config_t                      config;              /*!< max30105 device configuration */
+    i2c_master_dev_handle_t                i2c_handle;          /*!< max30105 I2C device handle */
+    uint8_t                                fifo_frame_size;     /*!< max30105 fifo bytes per sample, 3 per active LED channel */
+    uint8_t                                fifo_channels;       /*!< max30105 fifo LED channels per sample, one per active time slot */
+    uint8_t                                fifo_channel_map[MAX30105_FIFO_SLOT_MAX]; /*!< max30105 fifo LED channel (red, ir, green) of each sample position */
+    uint8_t                                fifo_data_shift;     /*!< max30105 fifo adc count right-shift by LED pulse width */
+    uint32_t                               fifo_sample_period;  /*!< max30105 fifo sample period in micro-seconds */
+    int64_t                                fifo_last_timestamp; /*!< max30105 fifo time of the newest sample read in micro-seconds, 0 when unknown */
+    uint8_t                                fifo_buffer[MAX30105_FIFO_BUFFER_SIZE]; /*!< max30105 fifo burst read buffer */
 } max30105_device_t;
 
 
@@ -318,6 +334,28 @@ static inline esp_err_t max30105_i2c_read_from(max30105_device_t *const device,
     return ESP_OK;
 }
 
+/**
+ * @brief MAX30105 I2C HAL burst read byte array from register address transaction, the register 
+ * address write and data read are issued as one transaction with a repeated start.
+ * 
+ * @param device MAX30105 device descriptor.
+ * @param reg_addr MAX30105 register address to read from.
+ * @param buffer MAX30105 read transaction return byte array.
+ * @param size MAX30105 number of bytes to read.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t max30105_i2c_burst_read_from(max30105_device_t *const device, const uint8_t reg_addr, uint8_t *const buffer, const uint16_t size) {
+    const bit8_uint8_buffer_t tx = { reg_addr };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt i2c write-read transaction */
+    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit_receive, i2c burst read from failed" );
+
+    return ESP_OK;
+}
+
 /**
  * @brief MAX30105 I2C HAL read byte from register address transaction.
  * 
@@ -1158,129 +1196,178 @@ static inline esp_err_t max30105_i2c_set_temperature_config_register(max30105_de
 }
 
 /**
- * @brief MAX30105 I2C HAL read FIFO data registers.
+ * @brief MAX30105 returns true when a multi-LED mode time slot is active.
+ * 
+ * @param mode MAX30105 multi-LED control mode of the time slot.
+ * @return true when the time slot writes a channel to the fifo.
+ */
+static inline bool max30105_is_multi_led_slot_active(const max30105_multi_led_control_modes_t mode) {
+    return (mode != MAX30105_MLCM_DISABLED && mode != MAX30105_MLCM_NONE);
+}
+
+/**
+ * @brief MAX30105 returns the unpacked LED channel (red 0, ir 1, green 2) of a multi-LED mode time slot.
+ * 
+ * @param mode MAX30105 multi-LED control mode of an active time slot.
+ * @return uint8_t LED channel of the time slot, pilot pulse amplitudes drive the same LED.
+ */
+static inline uint8_t max30105_get_multi_led_slot_channel(const max30105_multi_led_control_modes_t mode) {
+    switch(mode) {
+        case MAX30105_MLCM_RED_LED1_PA:
+        case MAX30105_MLCM_RED_LED1_PILOT_PA:
+            return 0;
+        case MAX30105_MLCM_IR_LED2_PA:
+        case MAX30105_MLCM_IR_LED2_PILOT_PA:
+            return 1;
+        case MAX30105_MLCM_GREEN_LED3_PA:
+        case MAX30105_MLCM_GREEN_LED3_PILOT_PA:
+            return 2;
+        default:
+            return MAX30105_FIFO_CHANNEL_SKIP;
+    }
+}
+
+/**
+ * @brief MAX30105 updates the fifo sample layout and sample period from the device configuration.  In 
+ * multi-LED mode each active time slot writes one channel in slot order, the LED of a fifo sample position 
+ * follows the slot control mode, a LED driven by more than one slot is unpacked from its first slot.
  * 
  * @param device MAX30105 device descriptor.
- * @param data 
+ */
+static inline void max30105_update_fifo_layout(max30105_device_t *const device) {
+    static const uint16_t sample_rates[] = { 50, 100, 200, 400, 800, 1000, 1600, 3200 };
+    const max30105_multi_led_control_modes_t slots[MAX30105_FIFO_SLOT_MAX] = { 
+        device->config.multi_led_mode_slot1, device->config.multi_led_mode_slot2, 
+        device->config.multi_led_mode_slot3, device->config.multi_led_mode_slot4 };
+    uint8_t channels = 0;
+    bool    unpacked[MAX30105_FIFO_CHANNEL_MAX] = { false };
+
+    memset(device->fifo_channel_map, MAX30105_FIFO_CHANNEL_SKIP, sizeof(device->fifo_channel_map));
+
+    /* determine LED channel of each fifo sample position */
+    switch(device->config.control_mode) {
+        case MAX30105_CM_RED_LED:
+            device->fifo_channel_map[channels++] = 0;
+            break;
+        case MAX30105_CM_RED_IR_LED:
+            device->fifo_channel_map[channels++] = 0;
+            device->fifo_channel_map[channels++] = 1;
+            break;
+        case MAX30105_CM_GREEN_RED_IR_LED:
+            for (uint8_t slot = 0; slot < MAX30105_FIFO_SLOT_MAX; slot++) {
+                if (!max30105_is_multi_led_slot_active(slots[slot])) continue;
+
+                const uint8_t channel = max30105_get_multi_led_slot_channel(slots[slot]);
+                if (channel != MAX30105_FIFO_CHANNEL_SKIP && !unpacked[channel]) {
+                    device->fifo_channel_map[channels] = channel;
+                    unpacked[channel] = true;
+                }
+                channels++;
+            }
+            break;
+    }
+
+    /* samples averaged in the fifo, averaging is capped at 32 */
+    const uint8_t average = (device->config.fifo_sample_average > MAX30105_SMP_AVG_32) ? MAX30105_SMP_AVG_32 : device->config.fifo_sample_average;
+
+    device->fifo_frame_size    = channels * MAX30105_FIFO_CHANNEL_SIZE;
+    device->fifo_channels      = channels;
+    device->fifo_data_shift    = MAX30105_LPWC_411US_18BITS - device->config.particle_led_pulse_width;
+    device->fifo_sample_period = (1000000UL << average) / sample_rates[device->config.particle_sample_rate & 0x07];
+}
+
+/**
+ * @brief MAX30105 I2C HAL read FIFO write pointer, overflow counter and read pointer registers in one transaction.
+ * 
+ * @param device MAX30105 device descriptor.
+ * @param count Number of samples pending in the fifo.
+ * @param overflow_count Number of samples lost to a full fifo.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t max30105_i2c_get_fifo_data_registers(max30105_device_t *const device, max30105_adc_channels_count_data_t *const data) {
-    max30105_mode_config_register_t             mode_config     = { 0 };
-    max30105_particle_sensing_config_register_t particle_config = { 0 };
-    max30105_fifo_read_pointer_register_t       fifo_read_ptr   = { 0 };
-    max30105_fifo_write_pointer_register_t      fifo_write_ptr  = { 0 };
-    uint8_t        *fifo_buffer = NULL;
-    uint8_t    fifo_sample_size = { 0 };
-    uint8_t    fifo_buffer_size = { 0 };
-    uint8_t     fifo_frame_size = { 0 };
-    uint8_t data_resolution_bit = { 0 };
+static inline esp_err_t max30105_i2c_get_fifo_pointers(max30105_device_t *const device, uint8_t *const count, uint8_t *const overflow_count) {
+    bit24_uint8_buffer_t rx = { 0 };
 
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* attempt fifo read pointer register read transaction */
-    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_read_pointer_register(device, &fifo_read_ptr), TAG, "read FIFO read pointer register failed" );
+    /* attempt fifo write pointer (0x04), overflow counter (0x05) and read pointer (0x06) burst read transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_burst_read_from(device, MAX30105_REG_FIFO_WR_PTR_RW, rx, BIT24_UINT8_BUFFER_SIZE), TAG, "read FIFO pointer registers failed" );
 
-    /* attempt fifo write pointer register read transaction */
-    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_write_pointer_register(device, &fifo_write_ptr), TAG, "read FIFO write pointer register failed" );
+    const uint8_t write_ptr = rx[0] & MAX30105_FIFO_POINTER_MASK;
+    const uint8_t overflow  = rx[1] & MAX30105_FIFO_POINTER_MASK;
+    const uint8_t read_ptr  = rx[2] & MAX30105_FIFO_POINTER_MASK;
 
-    /* determine pointer size of fifo data */
-    if(fifo_write_ptr.bits.fifo_write_pointer > fifo_read_ptr.bits.fifo_read_pointer) {
-        fifo_sample_size = fifo_write_ptr.bits.fifo_write_pointer - fifo_read_ptr.bits.fifo_read_pointer;
+    /* equal pointers is an empty fifo, unless samples were lost, then the fifo is full */
+    if (write_ptr == read_ptr) {
+        *count = (overflow > 0) ? MAX30105_CH_SMP_MAX : 0;
     } else {
-        fifo_sample_size = 32 + fifo_write_ptr.bits.fifo_write_pointer - fifo_read_ptr.bits.fifo_read_pointer;
+        *count = (write_ptr - read_ptr) & MAX30105_FIFO_POINTER_MASK;
     }
 
-    /* attempt mode configuration register read transaction */
-    ESP_RETURN_ON_ERROR( max30105_i2c_get_mode_config_register(device, &mode_config), TAG, "read mode configuration register failed" );
+    *overflow_count = overflow;
 
-    /* determine size of fifo frame */
-    switch(mode_config.bits.control_mode) {
-        case MAX30105_CM_RED_LED:
-            fifo_frame_size = 3;
-            break;
-        case MAX30105_CM_RED_IR_LED:
-            fifo_frame_size = 6;
-            break;
-        case MAX30105_CM_GREEN_RED_IR_LED:
-            fifo_frame_size = 9;
-            break;
-        default:
-            ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_RESPONSE, TAG, "unknown control mode in mode configuration register");
-    }
+    return ESP_OK;
+}
 
-    /* set fifo buffer size and attempt to allocate memory for fifo buffer */
-    fifo_buffer_size = fifo_frame_size * fifo_sample_size;
-    fifo_buffer      = malloc(fifo_buffer_size * sizeof(uint8_t));
-    ESP_RETURN_ON_FALSE(fifo_buffer != NULL, ESP_ERR_NO_MEM, TAG, "malloc for FIFO buffer failed");
+/**
+ * @brief MAX30105 I2C HAL read FIFO data registers.  The fifo pointers are read once and all 
+ * pending samples are burst-read in one transaction.
+ * 
+ * @param device MAX30105 device descriptor.
+ * @param data Red, IR and Green LED counts, lost sample count and timestamps.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t max30105_i2c_get_fifo_data_registers(max30105_device_t *const device, max30105_adc_channels_count_data_t *const data) {
+    uint8_t sample_size    = 0;
+    uint8_t overflow_count = 0;
 
-    /* attempt buffer sizes register read transaction */
-    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_data_register(device, fifo_buffer, fifo_buffer_size), TAG, "read fifo data register failed" );
+    /* validate arguments */
+    ESP_ARG_CHECK( device && data );
 
-    /* attempt to reset memory for red, ir, green count channel buffers and set sample size */
-    memset(data, 0, sizeof(max30105_adc_channels_count_data_t));
-    data->sample_size = fifo_sample_size;
+    uint32_t *const channels[MAX30105_FIFO_CHANNEL_MAX] = { data->red_count, data->ir_count, data->green_count };
 
-    /* attempt particle-sensing configuration register read transaction */
-    ESP_RETURN_ON_ERROR( max30105_i2c_get_particle_sensing_config_register(device, &particle_config), TAG, "read particle-sensing configuration register failed" );
+    /* attempt fifo pointer registers read transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_pointers(device, &sample_size, &overflow_count), TAG, "read FIFO pointer registers failed" );
 
-    /* determine adc resolution */
-    switch(particle_config.bits.led_pulse_width) {
-        case MAX30105_LPWC_69US_15BITS:
-            data_resolution_bit = 3;
-            break;
-        case MAX30105_LPWC_118US_16BITS:
-            data_resolution_bit = 2;
-            break;
-        case MAX30105_LPWC_215US_17BITS:
-            data_resolution_bit = 1;
-            break;
-        case MAX30105_LPWC_411US_18BITS:
-            data_resolution_bit = 0;
-            break;
-        default:
-            ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_RESPONSE, TAG, "unknown ADC resolution in particle-sensing configuration register");
+    const int64_t read_time = esp_timer_get_time();
+
+    /* reset memory for red, ir, green count channel buffers and set sample size */
+    memset(data, 0, sizeof(max30105_adc_channels_count_data_t));
+    data->sample_size    = sample_size;
+    data->overflow_count = overflow_count;
+    data->sample_period  = device->fifo_sample_period;
+
+    if (sample_size == 0 || device->fifo_frame_size == 0) {
+        data->sample_size = 0;
+        return ESP_OK;
     }
 
-    /* iterate through fifo buffer and concatenate counts by channel */
-    for(uint8_t i = 0; i < fifo_sample_size; i++) {
-        /* extract data by number of LED channels configured */
-        switch(mode_config.bits.control_mode) {
-            case MAX30105_CM_RED_LED:
-                data->red_count[i] = ((uint32_t)fifo_buffer[i * fifo_frame_size + 0] << 16) |                                            
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 1] << 8) |                                               
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 2] << 0);                                                
-                data->red_count[i] = data->red_count[i] >> data_resolution_bit;
-                break;
-            case MAX30105_CM_RED_IR_LED:
-                data->red_count[i] = ((uint32_t)fifo_buffer[i * fifo_frame_size + 0] << 16) |                                            
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 1] << 8) |                                               
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 2] << 0);                                                
-                data->red_count[i] = data->red_count[i] >> data_resolution_bit;
-                data->ir_count[i]  = ((uint32_t)fifo_buffer[i * fifo_frame_size + 3] << 16) |                                            
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 4] << 8) |                                               
-                                     ((uint32_t)fifo_buffer[i * fifo_frame_size + 5] << 0);                                                
-                data->ir_count[i]  = data->ir_count[i] >> data_resolution_bit;
-                break;
-            case MAX30105_CM_GREEN_RED_IR_LED:
-                data->red_count[i]   = ((uint32_t)fifo_buffer[i * fifo_frame_size + 0] << 16) |                                            
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 1] << 8) |                                               
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 2] << 0);                                                
-                data->red_count[i]   = data->red_count[i] >> data_resolution_bit;
-                data->ir_count[i]    = ((uint32_t)fifo_buffer[i * fifo_frame_size + 3] << 16) |                                            
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 4] << 8) |                                               
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 5] << 0);                                                
-                data->ir_count[i]    = data->ir_count[i] >> data_resolution_bit;
-                data->green_count[i] = ((uint32_t)fifo_buffer[i * fifo_frame_size + 6] << 16) |                                            
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 7] << 8) |                                               
-                                       ((uint32_t)fifo_buffer[i * fifo_frame_size + 8] << 0);                                                
-                data->green_count[i] = data->green_count[i] >> data_resolution_bit;
-                break;
+    /* attempt fifo data register burst read transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_burst_read_from(device, MAX30105_REG_FIFO_DATA_RW, device->fifo_buffer, (uint16_t)sample_size * device->fifo_frame_size), TAG, "read FIFO data register failed" );
+
+    /* iterate through fifo buffer and concatenate counts by the LED channel of each sample position */
+    for (uint8_t i = 0; i < sample_size; i++) {
+        const uint8_t *frame = &device->fifo_buffer[i * device->fifo_frame_size];
+
+        for (uint8_t c = 0; c < device->fifo_channels; c++) {
+            if (device->fifo_channel_map[c] == MAX30105_FIFO_CHANNEL_SKIP) continue;
+
+            const uint8_t *channel = &frame[c * MAX30105_FIFO_CHANNEL_SIZE];
+            const uint32_t count   = ((uint32_t)channel[0] << 16) | ((uint32_t)channel[1] << 8) | (uint32_t)channel[2];
+
+            channels[device->fifo_channel_map[c]][i] = (count & MAX30105_FIFO_DATA_MASK) >> device->fifo_data_shift;
         }
     }
 
-    /* free fifo buffer memory */
-    free(fifo_buffer);
+    /* the sample clock continues from the previous read, unless samples were lost or it drifted by more than a sample 
+       period, the first read anchors the newest sample at the read time and can be late by up to a sample period */
+    int64_t newest = read_time;
+    if (device->fifo_last_timestamp != 0 && overflow_count == 0) {
+        const int64_t predicted = device->fifo_last_timestamp + (int64_t)sample_size * device->fifo_sample_period;
+        if (llabs(read_time - predicted) < device->fifo_sample_period) newest = predicted;
+    }
+    device->fifo_last_timestamp = newest;
+    data->timestamp = newest - (int64_t)(sample_size - 1) * device->fifo_sample_period;
 
     return ESP_OK;
 }
@@ -1468,6 +1555,9 @@ esp_err_t max30105_init(i2c_master_bus_handle_t master_handle, const max30105_co
     /* attempt setup */
     ESP_RETURN_ON_ERROR( max30105_i2c_setup_registers(device), TAG, "setup for init failed" );
 
+    /* set fifo sample layout */
+    max30105_update_fifo_layout(device);
+
     /* set device handle */
     *max30105_handle = (max30105_handle_t)device;
 
@@ -1498,6 +1588,81 @@ esp_err_t max30105_get_optical_counts(max30105_handle_t handle, max30105_adc_cha
     return ESP_OK;
 }
 
+esp_err_t max30105_configure_fifo(max30105_handle_t handle, const uint8_t almost_full_threshold, const max30105_sample_averages_t average, const bool rollover_enabled) {
+    max30105_fifo_config_register_t reg = { 0 };
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && almost_full_threshold <= 0x0f && average <= MAX30105_SMP_AVG_32 );
+
+    /* set parameters */
+    reg.bits.fifo_almost_full_threshold = almost_full_threshold;
+    reg.bits.fifo_rollover_enabled      = rollover_enabled;
+    reg.bits.fifo_sample_averaging      = average;
+
+    /* attempt write fifo configuration register */
+    ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_config_register(device, reg), TAG, "write FIFO configuration register for configure FIFO failed" );
+
+    /* update configuration and fifo sample layout */
+    device->config.fifo_almost_full_threshold = almost_full_threshold;
+    device->config.fifo_rollover_enabled      = rollover_enabled;
+    device->config.fifo_sample_average        = average;
+    max30105_update_fifo_layout(device);
+
+    /* attempt to clear fifo */
+    ESP_RETURN_ON_ERROR( max30105_clear_fifo(handle), TAG, "clear FIFO for configure FIFO failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t max30105_clear_fifo(max30105_handle_t handle) {
+    const max30105_fifo_write_pointer_register_t    fifo_write_ptr   = { 0 };
+    const max30105_fifo_overflow_counter_register_t fifo_ovf_counter = { 0 };
+    const max30105_fifo_read_pointer_register_t     fifo_read_ptr    = { 0 };
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* attempt fifo write pointer register write transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_write_pointer_register(device, fifo_write_ptr), TAG, "write FIFO write pointer register for clear FIFO failed" );
+
+    /* attempt fifo overflow counter register write transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_overflow_counter_register(device, fifo_ovf_counter), TAG, "write FIFO overflow counter register for clear FIFO failed" );
+
+    /* attempt fifo read pointer register write transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_read_pointer_register(device, fifo_read_ptr), TAG, "write FIFO read pointer register for clear FIFO failed" );
+
+    /* sample clock restarts */
+    device->fifo_last_timestamp = 0;
+
+    return ESP_OK;
+}
+
+esp_err_t max30105_get_fifo_count(max30105_handle_t handle, uint8_t *const count, uint8_t *const overflow_count) {
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && count && overflow_count );
+
+    /* attempt fifo pointer registers read transaction */
+    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_pointers(device, count, overflow_count), TAG, "read FIFO pointer registers for read FIFO count failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t max30105_read_fifo(max30105_handle_t handle, max30105_adc_channels_count_data_t *const data) {
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device && data );
+
+    /* attempt read fifo data */
+    ESP_RETURN_ON_ERROR( max30105_i2c_get_fifo_data_registers(device, data), TAG, "read fifo data registers for read FIFO failed" );
+
+    return ESP_OK;
+}
+
 esp_err_t max30105_get_data_status(max30105_handle_t handle, bool *const ready) {
     max30105_interrupt_status1_register_t irq1;
     max30105_device_t* device = (max30105_device_t*)handle;
@@ -1587,6 +1752,10 @@ esp_err_t max30105_set_control_mode(max30105_handle_t handle, const max30105_con
     /* attempt write control mode register */
     ESP_RETURN_ON_ERROR( max30105_i2c_set_mode_config_register(device, reg), TAG, "write mode configuration register for read control mode failed" );
 
+    /* update configuration and fifo sample layout */
+    device->config.control_mode = mode;
+    max30105_update_fifo_layout(device);
+
     return ESP_OK;
 }
 
@@ -1720,6 +1889,7 @@ esp_err_t max30105_set_multi_led_mode(max30105_handle_t handle, const max30105_m
 
             /* attempt write multi-LED mode control 1 register */
             ESP_RETURN_ON_ERROR( max30105_i2c_set_multi_led_mode_control1_register(device, reg1), TAG, "write multi-LED mode control 1 register for write multi-LED mode failed" );
+            device->config.multi_led_mode_slot1 = mode;
             break;
         case MAX30105_MLM_SLOT_2:
             /* attempt read multi-LED mode control 1 register */
@@ -1730,6 +1900,7 @@ esp_err_t max30105_set_multi_led_mode(max30105_handle_t handle, const max30105_m
 
             /* attempt write multi-LED mode control 1 register */
             ESP_RETURN_ON_ERROR( max30105_i2c_set_multi_led_mode_control1_register(device, reg1), TAG, "write multi-LED mode control 1 register for write multi-LED mode failed" );
+            device->config.multi_led_mode_slot2 = mode;
             break;
         case MAX30105_MLM_SLOT_3:
             /* attempt read multi-LED mode control 2 register */
@@ -1740,6 +1911,7 @@ esp_err_t max30105_set_multi_led_mode(max30105_handle_t handle, const max30105_m
 
             /* attempt write multi-LED mode control 2 register */
             ESP_RETURN_ON_ERROR( max30105_i2c_set_multi_led_mode_control2_register(device, reg2), TAG, "write multi-LED mode control 2 register for write multi-LED mode failed" );
+            device->config.multi_led_mode_slot3 = mode;
             break;
         case MAX30105_MLM_SLOT_4:
             /* attempt read multi-LED mode control 2 register */
@@ -1750,11 +1922,15 @@ esp_err_t max30105_set_multi_led_mode(max30105_handle_t handle, const max30105_m
 
             /* attempt write multi-LED mode control 2 register */
             ESP_RETURN_ON_ERROR( max30105_i2c_set_multi_led_mode_control2_register(device, reg2), TAG, "write multi-LED mode control 2 register for write multi-LED mode failed" );
+            device->config.multi_led_mode_slot4 = mode;
             break;
         default:
             ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_RESPONSE, TAG, "unknown multi-LED mode slot for read multi-LED mode");
     }
 
+    /* update fifo sample layout */
+    max30105_update_fifo_layout(device);
+
     return ESP_OK;
 }
 
@@ -1790,6 +1966,10 @@ esp_err_t max30105_set_particle_led_pulse_width(max30105_handle_t handle, const
     /* attempt write particle sensing configuration register */
     ESP_RETURN_ON_ERROR( max30105_i2c_set_particle_sensing_config_register(device, reg), TAG, "write particle sensing configuration register for write particle LED pulse width failed" );
 
+    /* update configuration and fifo sample layout */
+    device->config.particle_led_pulse_width = pulse_width;
+    max30105_update_fifo_layout(device);
+
     return ESP_OK;
 }
 
@@ -1860,6 +2040,9 @@ esp_err_t max30105_set_particle_sample_rate(max30105_handle_t handle, const max3
     /* attempt write control mode register */
     ESP_RETURN_ON_ERROR( max30105_i2c_set_particle_sensing_config_register(device, reg), TAG, "write particle sensing configuration register for write particle sample rate failed" );
 
+    /* update configuration and fifo sample layout */
+    device->config.particle_sample_rate = rate;
+    max30105_update_fifo_layout(device);
 
     return ESP_OK;
 }
@@ -1896,6 +2079,10 @@ esp_err_t max30105_set_fifo_sample_averaging(max30105_handle_t handle, const max
     /* attempt write fifo configuration register */
     ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_config_register(device, reg), TAG, "write FIFO configuration register for write FIFO sample averaging failed" );
 
+    /* update configuration and fifo sample layout */
+    device->config.fifo_sample_average = average;
+    max30105_update_fifo_layout(device);
+
     return ESP_OK;
 }
 
@@ -2008,4 +2195,30 @@ esp_err_t max30105_disable_fifo_rollover(max30105_handle_t handle) {
     ESP_RETURN_ON_ERROR( max30105_i2c_set_fifo_config_register(device, reg), TAG, "write FIFO configuration register for disable FIFO rollover failed" );
 
     return ESP_OK;
-}
\ No newline at end of file
+}
+esp_err_t max30105_remove(max30105_handle_t handle) {
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* remove device from i2c master bus */
+    return i2c_master_bus_rm_device(device->i2c_handle);
+}
+
+esp_err_t max30105_delete(max30105_handle_t handle) {
+    max30105_device_t* device = (max30105_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( device );
+
+    /* remove device from master bus */
+    ESP_RETURN_ON_ERROR( max30105_remove(handle), TAG, "unable to remove device from i2c master bus, delete handle failed" );
+
+    /* validate handle instance and free handles */
+    if(device) {
+        free(device);
+    }
+
+    return ESP_OK;
+}
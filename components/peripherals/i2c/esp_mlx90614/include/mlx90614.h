@@ -61,7 +61,8 @@ extern "C" {
 */
 #define I2C_MLX90614_CONFIG_DEFAULT {                        \
         .i2c_address            = I2C_MLX90614_DEV_ADDR,     \
-        .i2c_clock_speed        = I2C_MLX90614_DEV_CLK_SPD }
+        .i2c_clock_speed        = I2C_MLX90614_DEV_CLK_SPD,  \
+        .conservative_timing    = false }
 
 /*
  * SHT4X enumerator and structure declarations
@@ -204,6 +205,7 @@ typedef union __attribute__((packed)) mlx90614_flags_register_u {
 typedef struct mlx90614_config_s {
     uint16_t                    i2c_address;        /*!< mlx90614 i2c device address */
     uint32_t                    i2c_clock_speed;    /*!< mlx90614 i2c device scl clock speed in hz */
+    bool                        conservative_timing; /*!< mlx90614 applies the legacy fixed delays after every transaction when true, otherwise only the application start delay and EEPROM write cycles are waited */
 } mlx90614_config_t;
 
 /**
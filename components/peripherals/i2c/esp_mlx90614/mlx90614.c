@@ -75,6 +75,7 @@
 #define MLX90614_CMD_DELAY_MS            UINT16_C(5)
 #define MLX90614_EEPROM_RDWR_DELAY_MS    UINT16_C(10)
 #define MLX90614_TX_RX_DELAY_MS          UINT16_C(10)
+#define MLX90614_EEPROM_WRITE_TIME_MS    UINT16_C(5)    //!< mlx90614 EEPROM erase or write cycle time, see datasheet for details
 
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
@@ -104,6 +105,18 @@ static const char *TAG = "mlx90614";
 * functions and subroutines
 */
 
+/**
+ * @brief Applies the fixed delay after a command or RAM access when conservative timing is configured.  RAM
+ * reads and commands need no settling time per the datasheet, so the delay is skipped otherwise.
+ * 
+ * @param device MLX90614 device descriptor.
+ */
+static inline void mlx90614_cmd_delay(mlx90614_device_t *const device) {
+    if (device->config.conservative_timing == true) {
+        vTaskDelay(pdMS_TO_TICKS(MLX90614_CMD_DELAY_MS));
+    }
+}
+
 /**
  * @brief Calculates mlx90614 crc8 value using a x^8+x^2+x^1+1 poly.  See datasheet for details.
  *
@@ -195,7 +208,7 @@ static inline esp_err_t mlx90614_i2c_read_word_from(mlx90614_device_t *const dev
     ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT24_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit_receive, i2c read from failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_CMD_DELAY_MS));
+    mlx90614_cmd_delay(device);
 
     /* compute and validate crc */
     uint8_t crc = mlx90614_calculate_crc8(0, (device->config.i2c_address << 1));
@@ -233,7 +246,7 @@ static inline esp_err_t mlx90614_i2c_write_command(mlx90614_device_t *const devi
     ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_mlx90614_write_command failed" );
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_CMD_DELAY_MS));
+    mlx90614_cmd_delay(device);
 
     return ESP_OK;
 }
@@ -267,8 +280,8 @@ static inline esp_err_t mlx90614_i2c_write_word_to(mlx90614_device_t *const devi
     /* attempt i2c write transaction */
     ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT32_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_mlx90614_write_word failed" );
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_CMD_DELAY_MS));
+    /* delay before next i2c transaction - words are written to EEPROM cells, wait for the write cycle */
+    vTaskDelay(pdMS_TO_TICKS(device->config.conservative_timing == true ? MLX90614_CMD_DELAY_MS : MLX90614_EEPROM_WRITE_TIME_MS));
 
     return ESP_OK;
 }
@@ -285,17 +298,17 @@ static inline esp_err_t mlx90614_i2c_write_eeprom_to(mlx90614_device_t *const de
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    // clear eeprom register
+    // clear eeprom register, write word waits for the erase cycle
     ESP_ERROR_CHECK( mlx90614_i2c_write_word_to(device, reg_addr, MLX90614_CMD_EEPROM_CLR_CELL) );
 
     // forced delay before next transaction - see datasheet for details
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_EEPROM_RDWR_DELAY_MS));
+    if (device->config.conservative_timing == true) vTaskDelay(pdMS_TO_TICKS(MLX90614_EEPROM_RDWR_DELAY_MS));
 
-    // write data to register
+    // write data to register, write word waits for the write cycle
     ESP_ERROR_CHECK( mlx90614_i2c_write_word_to(device, reg_addr, data) );
 
     // forced delay before next transaction - see datasheet for details
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_EEPROM_RDWR_DELAY_MS));
+    if (device->config.conservative_timing == true) vTaskDelay(pdMS_TO_TICKS(MLX90614_EEPROM_RDWR_DELAY_MS));
 
     return ESP_OK;
 }
@@ -423,7 +436,7 @@ esp_err_t mlx90614_init(i2c_master_bus_handle_t master_handle, const mlx90614_co
     }
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MLX90614_CMD_DELAY_MS));
+    mlx90614_cmd_delay(dev);
 
     /* mlx90614 attempt to read configured identification numbers */
     //ESP_GOTO_ON_ERROR(mlx90614_get_ident_numbers(out_handle, &out_handle->ident_number_hi, &out_handle->ident_number_lo), err_handle, TAG, "i2c mlx90614 read identification numbers failed");
@@ -431,7 +444,7 @@ esp_err_t mlx90614_init(i2c_master_bus_handle_t master_handle, const mlx90614_co
     /* set device handle */
     *mlx90614_handle = (mlx90614_handle_t)dev;
 
-    /* delay before next i2c transaction */
+    /* delay before next i2c transaction, the power-up and application start delays cover the power-on reset time */
     vTaskDelay(pdMS_TO_TICKS(MLX90614_APPSTART_DELAY_MS));
 
     return ESP_OK;
@@ -40,6 +40,8 @@
 #include <esp_err.h>
 #include <driver/gpio.h>
 #include <driver/i2c_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include <type_utils.h>
 #include "mpu6050_version.h"
 
@@ -55,6 +57,12 @@ extern "C" {
 #define I2C_MPU6050_DEV_ADDR_H                  UINT8_C(0x69)   //!< mpu6050 I2C address when AD0 = 1 or to vcc
 #define I2C_MPU6050_DEV_ADDR_L                  UINT8_C(0x68)   //!< mpu6050 I2C address when AD0 = 0 or to gnd
 
+#define MPU6050_FIFO_SIZE                       UINT16_C(1024)  //!< mpu6050 fifo buffer size in bytes
+
+#define MPU6050_PIPELINE_TASK_NAME              "mpu6050_pipeline"
+#define MPU6050_PIPELINE_TASK_STACK_SIZE        (configMINIMAL_STACK_SIZE * 5)
+#define MPU6050_PIPELINE_TASK_PRIORITY          (tskIDLE_PRIORITY + 5)
+
 
 /*
  * MPU6050 macro definitions
@@ -68,6 +76,20 @@ extern "C" {
     .accel_full_scale_range     = MPU6050_ACCEL_FS_RANGE_4G }
 
 
+/**
+ * @brief Macro that initializes `mpu6050_pipeline_config_t` to default configuration settings.
+ */
+#define MPU6050_PIPELINE_CONFIG_DEFAULT {                   \
+    .watermark              = 20,                           \
+    .motion_gating_enabled  = false,                        \
+    .motion_threshold       = 20,                           \
+    .motion_duration        = 1,                            \
+    .motion_hold_ms         = 2000,                         \
+    .queue_length           = 0,                            \
+    .callback               = NULL,                         \
+    .callback_arg           = NULL }
+
+
 /*
  * MPU6050 enumerator and structure declarations
 */
@@ -254,7 +276,9 @@ typedef union __attribute__((packed)) mpu6050_interrupt_enable_register_u {
         uint8_t                             reserved1:2;                /*!< mpu6050 reserved and set to 0              (bit:1-2) */
         bool                                i2c_master_enabled:1;       /*!< mpu6050 enables i2c master interrupt       (bit:3) */
         bool                                fifo_overflow_enabled:1;    /*!< mpu6050 enabled fifo overflow interrupt    (bit:4) */
-        uint8_t                             reserved2:3;                /*!< mpu6050 reserved and set to 0              (bit:5-7) */
+        uint8_t                             reserved2:1;                /*!< mpu6050 reserved and set to 0              (bit:5) */
+        bool                                motion_detect_enabled:1;    /*!< mpu6050 enables motion detection interrupt (bit:6) */
+        uint8_t                             reserved3:1;                /*!< mpu6050 reserved and set to 0              (bit:7) */
     } bits;
     uint8_t reg;
 } mpu6050_interrupt_enable_register_t;
@@ -288,7 +312,9 @@ typedef union __attribute__((packed)) mpu6050_interrupt_status_register_u {
         uint8_t                             reserved1:2;            /*!< mpu6050 reserved and set to 0                          (bit:1-2) */
         bool                                irq_i2c_master:1;       /*!< mpu6050 i2c master interrupt generated when true       (bit:3) */
         bool                                irq_fifo_overflow:1;    /*!< mpu6050 fifo overflow interrupt generated when true    (bit:4) */
-        uint8_t                             reserved2:3;            /*!< mpu6050 reserved and set to 0                          (bit:5-7) */
+        uint8_t                             reserved2:1;            /*!< mpu6050 reserved and set to 0                          (bit:5) */
+        bool                                irq_motion_detect:1;    /*!< mpu6050 motion detection interrupt generated when true (bit:6) */
+        uint8_t                             reserved3:1;            /*!< mpu6050 reserved and set to 0                          (bit:7) */
     } bits;
     uint8_t reg;
 } mpu6050_interrupt_status_register_t;
@@ -388,6 +414,34 @@ typedef struct mpu6050_accel_data_axes_s {
     float z_axis;    /*!< mpu6050 z-axis accelerometer measurement relative to standard gravity (±2g, ±4g, ±8g, ±16g) */
 } mpu6050_accel_data_axes_t;
 
+/**
+ * @brief MPU6050 fifo sample structure, sources not enabled in the fifo are set to 0.
+ */
+typedef struct mpu6050_fifo_sample_s {
+    mpu6050_gyro_data_axes_t    gyro;           /*!< mpu6050 gyroscope data axes measurements in degrees per second */
+    mpu6050_accel_data_axes_t   accel;          /*!< mpu6050 accelerometer data axes measurements relative to standard gravity (g) */
+    float                       temperature;    /*!< mpu6050 temperature measurement in degrees Celsius */
+} mpu6050_fifo_sample_t;
+
+/**
+ * @brief MPU6050 pipeline sample structure.
+ */
+typedef struct mpu6050_pipeline_sample_s {
+    int64_t                     timestamp;      /*!< mpu6050 sample time in micro-seconds since boot, back-computed from the interrupt time and sample rate */
+    mpu6050_fifo_sample_t       sample;         /*!< mpu6050 fifo sample */
+} mpu6050_pipeline_sample_t;
+
+/**
+ * @brief MPU6050 pipeline statistics structure.
+ */
+typedef struct mpu6050_pipeline_stats_s {
+    uint32_t                    batches;        /*!< mpu6050 number of batches published */
+    uint32_t                    samples;        /*!< mpu6050 number of samples published */
+    uint32_t                    overflows;      /*!< mpu6050 number of fifo overflows */
+    uint32_t                    dropped;        /*!< mpu6050 number of samples dropped because the queue was full */
+    uint32_t                    motion_events;  /*!< mpu6050 number of motion detection interrupts */
+} mpu6050_pipeline_stats_t;
+
 typedef struct mpu6050_attitude_s {
 	float x;
 	float y;
@@ -415,6 +469,31 @@ typedef struct mpu6050_config_s {
     mpu6050_irq_clear_t                 irq_clear_behavior;     /*!< Interrupt status clear behavior         */
 } mpu6050_config_t;
 
+/**
+ * @brief MPU6050 pipeline batch callback definition, invoked from the pipeline task 
+ * with samples ordered oldest first.
+ */
+typedef void (*mpu6050_pipeline_cb_t)(const mpu6050_pipeline_sample_t *samples, const uint16_t count, void *arg);
+
+/**
+ * @brief MPU6050 pipeline configuration structure definition.
+ */
+typedef struct mpu6050_pipeline_config_s {
+    uint16_t                            watermark;              /*!< mpu6050 number of samples per batch, 1 to 36, 1 wakes the pipeline task on every sample */
+    bool                                motion_gating_enabled;  /*!< mpu6050 samples are acquired only after motion is detected when true */
+    uint8_t                             motion_threshold;       /*!< mpu6050 motion detection threshold, 2mg per LSB */
+    uint8_t                             motion_duration;        /*!< mpu6050 motion detection duration in milli-seconds */
+    uint16_t                            motion_hold_ms;         /*!< mpu6050 acquisition stops after no motion is detected for this period in milli-seconds */
+    uint16_t                            queue_length;           /*!< mpu6050 length of the sample queue, 0 when samples are published to the callback only */
+    mpu6050_pipeline_cb_t               callback;               /*!< mpu6050 batch callback, optional and can be NULL */
+    void                               *callback_arg;           /*!< mpu6050 batch callback argument */
+} mpu6050_pipeline_config_t;
+
+/**
+ * @brief MPU6050 pipeline structure declaration.
+ */
+struct mpu6050_pipeline_s;
+
 /**
  * @brief MPU6050 context structure.
  */
@@ -423,6 +502,11 @@ struct mpu6050_context_t {
     i2c_master_dev_handle_t             i2c_handle;         /*!< mpu6050 I2C device handle */
     float                               accel_sensitivity;  /*!< mpu6050 accelerometer sensitivity value */
     float                               gyro_sensitivity;   /*!< mpu6050 gyroscope sensitivity value */
+    bool                                fifo_enabled;       /*!< mpu6050 fifo operation is enabled when true */
+    mpu6050_fifo_enable_register_t      fifo_enable_reg;    /*!< mpu6050 fifo sources */
+    uint8_t                             fifo_frame_size;    /*!< mpu6050 fifo frame size in bytes */
+    uint8_t                            *fifo_buffer;        /*!< mpu6050 fifo burst read buffer */
+    struct mpu6050_pipeline_s          *pipeline;           /*!< mpu6050 interrupt-driven pipeline, NULL when the pipeline is stopped */
 };
 
 /**
@@ -584,6 +668,24 @@ esp_err_t mpu6050_get_signal_path_reset_register(mpu6050_handle_t handle, mpu605
  */
 esp_err_t mpu6050_set_signal_path_reset_register(mpu6050_handle_t handle, const mpu6050_signal_path_reset_register_t reg);
 
+/**
+ * @brief Reads FIFO enable register from MPU6050.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] reg MPU6050 FIFO enable register.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_get_fifo_enable_register(mpu6050_handle_t handle, mpu6050_fifo_enable_register_t *const reg);
+
+/**
+ * @brief Writes FIFO enable register to MPU6050.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[in] reg MPU6050 FIFO enable register.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_set_fifo_enable_register(mpu6050_handle_t handle, const mpu6050_fifo_enable_register_t reg);
+
 /**
  * @brief Reads user control register from MPU6050.
  * 
@@ -709,10 +811,106 @@ esp_err_t mpu6050_get_temperature(mpu6050_handle_t handle, float *temperature);
 
 esp_err_t mpu6050_reset_signal_condition(mpu6050_handle_t handle);
 
+/**
+ * @brief Resets the MPU6050 FIFO buffer, FIFO operation is kept enabled when it was enabled 
+ * with `mpu6050_enable_fifo`.
+ * 
+ * @param handle MPU6050 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
 esp_err_t mpu6050_reset_fifo(mpu6050_handle_t handle);
 
+/**
+ * @brief Enables MPU6050 FIFO operation with the selected sources, the FIFO is reset and 
+ * frames are written at the sample rate.
+ * 
+ * @param handle MPU6050 device handle.
+ * @param accel_enabled Accelerometer axes are written to the FIFO when true.
+ * @param gyro_enabled Gyroscope axes are written to the FIFO when true.
+ * @param temp_enabled Temperature is written to the FIFO when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_enable_fifo(mpu6050_handle_t handle, const bool accel_enabled, const bool gyro_enabled, const bool temp_enabled);
+
+/**
+ * @brief Disables MPU6050 FIFO operation and clears FIFO sources.
+ * 
+ * @param handle MPU6050 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_disable_fifo(mpu6050_handle_t handle);
+
+/**
+ * @brief Reads the number of bytes in the MPU6050 FIFO buffer.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] count Number of bytes in the FIFO buffer.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_get_fifo_count(mpu6050_handle_t handle, uint16_t *const count);
+
+/**
+ * @brief Drains whole frames from the MPU6050 FIFO buffer in a single burst read and 
+ * scales them into samples, oldest sample first.  Frames beyond `max_samples` remain 
+ * in the FIFO for the next read.
+ * 
+ * @note A full FIFO, or a byte count that is not a multiple of the frame size, indicates 
+ * an overflow.  The FIFO is reset to resync frames, `overflow` is set, and no samples 
+ * are returned.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] samples Caller supplied array of samples.
+ * @param[in] max_samples Number of samples the array can hold.
+ * @param[out] sample_count Number of samples read.
+ * @param[out] overflow FIFO overflowed and was reset when true, optional and can be NULL.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_read_fifo(mpu6050_handle_t handle, mpu6050_fifo_sample_t *const samples, const uint16_t max_samples, uint16_t *const sample_count, bool *const overflow);
+
 esp_err_t mpu6050_reset_sensors(mpu6050_handle_t handle);
 
+/**
+ * @brief Starts the interrupt-driven acquisition pipeline.  The INT pin configured in the 
+ * device configuration wakes a pipeline task that drains the FIFO, timestamps samples, 
+ * and publishes batches to the callback and sample queue.
+ * 
+ * @note The GPIO ISR service must be installed (i.e. `gpio_install_isr_service`) and the 
+ * device configuration `irq_io_num` must be valid.  When motion gating is enabled, 
+ * data-ready interrupts and FIFO operation are disabled until motion is detected, there 
+ * is no i2c traffic while the device is at rest.
+ * 
+ * @param handle MPU6050 device handle.
+ * @param config MPU6050 pipeline configuration.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_start_pipeline(mpu6050_handle_t handle, const mpu6050_pipeline_config_t *config);
+
+/**
+ * @brief Stops the interrupt-driven acquisition pipeline and disables FIFO operation.
+ * 
+ * @param handle MPU6050 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_stop_pipeline(mpu6050_handle_t handle);
+
+/**
+ * @brief Gets the pipeline sample queue, items are `mpu6050_pipeline_sample_t`.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] queue Pipeline sample queue handle, NULL when the queue length is 0.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_get_pipeline_queue(mpu6050_handle_t handle, QueueHandle_t *const queue);
+
+/**
+ * @brief Gets pipeline statistics.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] stats Pipeline statistics.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t mpu6050_get_pipeline_stats(mpu6050_handle_t handle, mpu6050_pipeline_stats_t *const stats);
+
 /**
  * @brief Registers an Interrupt Service Routine to handle MPU6050 interrupts.
  * 
@@ -39,8 +39,12 @@
 #include <esp_log.h>
 #include <esp_check.h>
 #include <esp_timer.h>
+#include <esp_attr.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include <i2c_trace.h>
 
 /*
  * MPU6050 definitions
@@ -54,6 +58,8 @@
 #define MPU6050_REG_CONFIG_RW               UINT8_C(0x1a)
 #define MPU6050_REG_GYRO_CONFIG_RW          UINT8_C(0x1b)
 #define MPU6050_REG_ACCEL_CONFIG_RW         UINT8_C(0x1c)
+#define MPU6050_REG_MOT_THR_RW              UINT8_C(0x1f)
+#define MPU6050_REG_MOT_DUR_RW              UINT8_C(0x20)
 #define MPU6050_REG_FIFO_EN_RW              UINT8_C(0x23)
 
 #define MPU6050_REG_INT_PIN_CFG_RW          UINT8_C(0x37)
@@ -93,6 +99,14 @@
 #define MPU6050_CMD_DELAY_MS                UINT16_C(5)
 #define MPU6050_TX_RX_DELAY_MS              UINT16_C(10)
 
+#define MPU6050_FIFO_ACCEL_SIZE             UINT8_C(6)      //!< mpu6050 accelerometer bytes per fifo frame
+#define MPU6050_FIFO_TEMP_SIZE              UINT8_C(2)      //!< mpu6050 temperature bytes per fifo frame
+#define MPU6050_FIFO_GYRO_SIZE              UINT8_C(6)      //!< mpu6050 gyroscope bytes per fifo frame
+#define MPU6050_FIFO_FRAME_SIZE             (MPU6050_FIFO_ACCEL_SIZE + MPU6050_FIFO_TEMP_SIZE + MPU6050_FIFO_GYRO_SIZE)
+
+#define MPU6050_PIPELINE_BATCH_MAX          (MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME_SIZE)   //!< mpu6050 pipeline maximum frames per drain
+#define MPU6050_PIPELINE_WATERMARK_MAX      (MPU6050_PIPELINE_BATCH_MAX / 2)                //!< mpu6050 pipeline maximum watermark, half the fifo is kept as headroom
+
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
 /*
@@ -106,6 +120,27 @@
 */
 static const char *TAG = "mpu6050";
 
+/**
+ * @brief MPU6050 interrupt-driven pipeline structure definition.
+ */
+struct mpu6050_pipeline_s {
+    mpu6050_pipeline_config_t   config;             /*!< mpu6050 pipeline configuration */
+    TaskHandle_t                task_handle;        /*!< mpu6050 pipeline task handle */
+    QueueHandle_t               queue_handle;       /*!< mpu6050 pipeline sample queue handle */
+    SemaphoreHandle_t           stopped_handle;     /*!< mpu6050 pipeline task stopped semaphore handle */
+    portMUX_TYPE                spinlock;           /*!< mpu6050 pipeline isr and task shared state spinlock */
+    volatile bool               streaming;          /*!< mpu6050 fifo and data-ready interrupt are enabled when true */
+    volatile bool               stop_requested;     /*!< mpu6050 pipeline task stops when true */
+    uint32_t                    pending;            /*!< mpu6050 interrupts since the last drain, frames in the fifo unless motion gating shares the pin */
+    mpu6050_user_control_register_t user_control;   /*!< mpu6050 user control register with fifo operation bits cleared */
+    int64_t                     irq_time;           /*!< mpu6050 time of the last interrupt in micro-seconds */
+    int64_t                     sample_period;      /*!< mpu6050 sample period in micro-seconds */
+    int64_t                     last_motion_time;   /*!< mpu6050 time of the last motion detection in micro-seconds */
+    mpu6050_fifo_sample_t       fifo_samples[MPU6050_PIPELINE_BATCH_MAX]; /*!< mpu6050 fifo samples of a drain */
+    mpu6050_pipeline_sample_t   batch[MPU6050_PIPELINE_BATCH_MAX];        /*!< mpu6050 timestamped samples of a drain */
+    mpu6050_pipeline_stats_t    stats;              /*!< mpu6050 pipeline statistics */
+};
+
 
 /**
  * @brief MPU6050 I2C HAL read from register address transaction.  This is a write and then read process.
@@ -116,13 +151,13 @@ static const char *TAG = "mpu6050";
  * @param size Length of buffer to store results from read transaction.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t mpu6050_i2c_read_from(mpu6050_handle_t handle, const uint8_t reg_addr, uint8_t *buffer, const uint8_t size) {
+static inline esp_err_t mpu6050_i2c_read_from(mpu6050_handle_t handle, const uint8_t reg_addr, uint8_t *buffer, const uint16_t size) {
     const bit8_uint8_buffer_t tx = { reg_addr };
 
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_read_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_read_from failed" );
 
     return ESP_OK;
 }
@@ -142,7 +177,7 @@ static inline esp_err_t mpu6050_i2c_read_byte_from(mpu6050_handle_t handle, cons
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_read_byte_from failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT_RECEIVE(handle->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, rx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_read_byte_from failed" );
 
     /* set output parameter */
     *byte = rx[0];
@@ -165,7 +200,7 @@ static inline esp_err_t mpu6050_i2c_write_byte_to(mpu6050_handle_t handle, const
     ESP_ARG_CHECK( handle );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_write_byte_to, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(handle->i2c_handle, tx, BIT16_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "mpu6050_i2c_write_byte_to, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -229,7 +264,7 @@ esp_err_t mpu6050_get_sample_rate_divider_register(mpu6050_handle_t handle, uint
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_SMPLRT_DIV_RW, reg), TAG, "read sample rate divider register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -246,7 +281,7 @@ esp_err_t mpu6050_set_sample_rate_divider_register(mpu6050_handle_t handle, cons
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_SMPLRT_DIV_RW, reg), TAG, "write sample rate divider register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -259,7 +294,7 @@ esp_err_t mpu6050_get_config_register(mpu6050_handle_t handle, mpu6050_config_re
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_CONFIG_RW, &reg->reg), TAG, "read configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -276,7 +311,7 @@ esp_err_t mpu6050_set_config_register(mpu6050_handle_t handle, const mpu6050_con
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_CONFIG_RW, config.reg), TAG, "write configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -289,7 +324,7 @@ esp_err_t mpu6050_get_gyro_config_register(mpu6050_handle_t handle, mpu6050_gyro
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_GYRO_CONFIG_RW, &reg->reg), TAG, "read gyroscope configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -306,7 +341,7 @@ esp_err_t mpu6050_set_gyro_config_register(mpu6050_handle_t handle, const mpu605
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_GYRO_CONFIG_RW, gyro_config.reg), TAG, "write gyroscope configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     /* attempt to update gyroscope sensitivity */
     ESP_RETURN_ON_ERROR( mpu6050_get_gyro_sensitivity(handle), TAG, "gyroscope sensitivity update for write gyroscope configuration register failed" );
@@ -322,7 +357,7 @@ esp_err_t mpu6050_get_accel_config_register(mpu6050_handle_t handle, mpu6050_acc
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_ACCEL_CONFIG_RW, &reg->reg), TAG, "read accelerometer configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -339,7 +374,7 @@ esp_err_t mpu6050_set_accel_config_register(mpu6050_handle_t handle, const mpu60
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_ACCEL_CONFIG_RW, accel_config.reg), TAG, "write accelerometer configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     /* attempt to update accelerometer sensitivity */
     ESP_RETURN_ON_ERROR( mpu6050_get_accel_sensitivity(handle), TAG, "accelerometer sensitivity update for write accelerometer configuration register failed" );
@@ -355,7 +390,7 @@ esp_err_t mpu6050_get_interrupt_enable_register(mpu6050_handle_t handle, mpu6050
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_INT_ENABLE_RW, &reg->reg), TAG, "read interrupt enable register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -367,12 +402,13 @@ esp_err_t mpu6050_set_interrupt_enable_register(mpu6050_handle_t handle, const m
     mpu6050_interrupt_enable_register_t irq_enable = { .reg = reg.reg };
     irq_enable.bits.reserved1 = 0;
     irq_enable.bits.reserved2 = 0;
+    irq_enable.bits.reserved3 = 0;
 
     /* attempt i2c write transaction */
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_INT_ENABLE_RW, irq_enable.reg), TAG, "write interrupt enable register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -385,7 +421,7 @@ esp_err_t mpu6050_get_interrupt_pin_config_register(mpu6050_handle_t handle, mpu
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_INT_PIN_CFG_RW, &reg->reg), TAG, "read interrupt pin configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -403,7 +439,7 @@ esp_err_t mpu6050_set_interrupt_pin_config_register(mpu6050_handle_t handle, con
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_INT_PIN_CFG_RW, irq_pin_config.reg), TAG, "write interrupt pin configuration register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -416,7 +452,64 @@ esp_err_t mpu6050_get_interrupt_status_register(mpu6050_handle_t handle, mpu6050
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_INT_STATUS_R, &reg->reg), TAG, "read interrupt status register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_fifo_enable_register(mpu6050_handle_t handle, mpu6050_fifo_enable_register_t *const reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* attempt i2c read transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_FIFO_EN_RW, &reg->reg), TAG, "read fifo enable register failed" );
+
+    /* delay task before i2c transaction */
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_set_fifo_enable_register(mpu6050_handle_t handle, const mpu6050_fifo_enable_register_t reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_FIFO_EN_RW, reg.reg), TAG, "write fifo enable register failed" );
+
+    /* delay task before i2c transaction */
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_user_control_register(mpu6050_handle_t handle, mpu6050_user_control_register_t *const reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* attempt i2c read transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_USER_CTRL_RW, &reg->reg), TAG, "read user control register failed" );
+
+    /* delay task before i2c transaction */
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_set_user_control_register(mpu6050_handle_t handle, const mpu6050_user_control_register_t reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    mpu6050_user_control_register_t user_control = { .reg = reg.reg };
+
+    user_control.bits.reserved1 = 0;
+    user_control.bits.reserved2 = 0;
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_USER_CTRL_RW, user_control.reg), TAG, "write user control register failed" );
+
+    /* delay task before i2c transaction */
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -429,7 +522,7 @@ esp_err_t mpu6050_get_power_management1_register(mpu6050_handle_t handle, mpu605
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_PWR_MGMT_1_RW, &reg->reg), TAG, "read power management 1 register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -446,7 +539,7 @@ esp_err_t mpu6050_set_power_management1_register(mpu6050_handle_t handle, const
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_PWR_MGMT_1_RW, power_management1.reg), TAG, "write power management 1 register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -459,7 +552,7 @@ esp_err_t mpu6050_get_power_management2_register(mpu6050_handle_t handle, mpu605
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_PWR_MGMT_2_RW, &reg->reg), TAG, "read power management 2 register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -472,7 +565,7 @@ esp_err_t mpu6050_set_power_management2_register(mpu6050_handle_t handle, const
     ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_PWR_MGMT_2_RW, reg.reg), TAG, "write power management 2 register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -485,7 +578,7 @@ esp_err_t mpu6050_get_who_am_i_register(mpu6050_handle_t handle, mpu6050_who_am_
     ESP_RETURN_ON_ERROR( mpu6050_i2c_read_byte_from(handle, MPU6050_REG_WHO_AM_I_R, &reg->reg), TAG, "read who am i register failed" );
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -649,10 +742,11 @@ esp_err_t mpu6050_init(i2c_master_bus_handle_t master_handle, const mpu6050_conf
     /* validate device handle */
     if (out_handle->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &out_handle->i2c_handle), err_handle, TAG, "i2c new bus for init failed");
+        I2C_TRACE_ADD_DEVICE(out_handle->i2c_handle, "mpu6050", i2c_dev_conf.device_address);
     }
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(out_handle->i2c_handle, pdMS_TO_TICKS(MPU6050_CMD_DELAY_MS));
 
     /* attempt soft-reset and initialize registers */
     ESP_GOTO_ON_ERROR(mpu6050_reset(out_handle), err_handle, TAG, "soft-reset failed");
@@ -661,12 +755,13 @@ esp_err_t mpu6050_init(i2c_master_bus_handle_t master_handle, const mpu6050_conf
     *mpu6050_handle = out_handle;
 
     /* delay task before i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_APPSTART_DELAY_MS));
+    I2C_TRACE_DELAY(out_handle->i2c_handle, pdMS_TO_TICKS(MPU6050_APPSTART_DELAY_MS));
 
     return ESP_OK;
 
     err_handle:
         if (out_handle && out_handle->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(out_handle->i2c_handle);
             i2c_master_bus_rm_device(out_handle->i2c_handle);
         }
         free(out_handle);
@@ -724,7 +819,7 @@ static inline esp_err_t mpu6050_get_raw_motion(mpu6050_handle_t handle, mpu6050_
         ESP_GOTO_ON_ERROR( mpu6050_get_data_status(handle, &data_is_ready), err, TAG, "data ready read for get measurement failed." );
 
         /* delay task before next i2c transaction */
-        vTaskDelay(pdMS_TO_TICKS(MPU6050_DATA_READY_DELAY_MS));
+        I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_DATA_READY_DELAY_MS));
 
         /* validate timeout condition */
         if (ESP_TIMEOUT_CHECK(start_time, (MPU6050_DATA_POLL_TIMEOUT_MS * 1000)))
@@ -780,6 +875,579 @@ esp_err_t mpu6050_get_motion(mpu6050_handle_t handle, mpu6050_gyro_data_axes_t *
     return ESP_OK;
 }
 
+esp_err_t mpu6050_reset_fifo(mpu6050_handle_t handle) {
+    mpu6050_user_control_register_t user_control;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* attempt to read user control register */
+    ESP_RETURN_ON_ERROR( mpu6050_get_user_control_register(handle, &user_control), TAG, "unable to read user control register, reset fifo failed" );
+
+    /* fifo reset bit auto-clears, fifo operation is restored with the same write */
+    user_control.bits.fifo_reset   = true;
+    user_control.bits.fifo_enabled = handle->fifo_enabled;
+
+    /* attempt to write user control register */
+    ESP_RETURN_ON_ERROR( mpu6050_set_user_control_register(handle, user_control), TAG, "unable to write user control register, reset fifo failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_enable_fifo(mpu6050_handle_t handle, const bool accel_enabled, const bool gyro_enabled, const bool temp_enabled) {
+    mpu6050_user_control_register_t     user_control;
+    mpu6050_fifo_enable_register_t      fifo_enable     = { .reg = 0 };
+    mpu6050_interrupt_enable_register_t irq_enable;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && (accel_enabled || gyro_enabled || temp_enabled) );
+
+    /* allocate fifo burst buffer */
+    if (handle->fifo_buffer == NULL) {
+        handle->fifo_buffer = (uint8_t*)calloc(MPU6050_FIFO_SIZE, sizeof(uint8_t));
+        ESP_RETURN_ON_FALSE( handle->fifo_buffer, ESP_ERR_NO_MEM, TAG, "no memory for fifo buffer, enable fifo failed" );
+    }
+
+    /* attempt to stop fifo operation before changing sources */
+    ESP_RETURN_ON_ERROR( mpu6050_get_user_control_register(handle, &user_control), TAG, "unable to read user control register, enable fifo failed" );
+    user_control.bits.fifo_enabled = false;
+    ESP_RETURN_ON_ERROR( mpu6050_set_user_control_register(handle, user_control), TAG, "unable to write user control register, enable fifo failed" );
+
+    /* set fifo sources, frames are written in register order: accelerometer, temperature, gyroscope */
+    fifo_enable.bits.accel_fifo_enabled  = accel_enabled;
+    fifo_enable.bits.temp_fifo_enabled   = temp_enabled;
+    fifo_enable.bits.gyro_x_fifo_enabled = gyro_enabled;
+    fifo_enable.bits.gyro_y_fifo_enabled = gyro_enabled;
+    fifo_enable.bits.gyro_z_fifo_enabled = gyro_enabled;
+
+    ESP_RETURN_ON_ERROR( mpu6050_set_fifo_enable_register(handle, fifo_enable), TAG, "unable to write fifo enable register, enable fifo failed" );
+
+    /* attempt to enable fifo overflow interrupt */
+    ESP_RETURN_ON_ERROR( mpu6050_get_interrupt_enable_register(handle, &irq_enable), TAG, "unable to read interrupt enable register, enable fifo failed" );
+    irq_enable.bits.fifo_overflow_enabled = true;
+    ESP_RETURN_ON_ERROR( mpu6050_set_interrupt_enable_register(handle, irq_enable), TAG, "unable to write interrupt enable register, enable fifo failed" );
+
+    /* set fifo frame layout */
+    handle->fifo_enable_reg = fifo_enable;
+    handle->fifo_frame_size = (accel_enabled ? MPU6050_FIFO_ACCEL_SIZE : 0) +
+                              (temp_enabled  ? MPU6050_FIFO_TEMP_SIZE  : 0) +
+                              (gyro_enabled  ? MPU6050_FIFO_GYRO_SIZE  : 0);
+    handle->fifo_enabled    = true;
+
+    /* attempt to reset and start fifo operation */
+    ESP_RETURN_ON_ERROR( mpu6050_reset_fifo(handle), TAG, "unable to reset fifo, enable fifo failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_disable_fifo(mpu6050_handle_t handle) {
+    mpu6050_user_control_register_t user_control;
+    const mpu6050_fifo_enable_register_t fifo_enable = { .reg = 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    /* attempt to stop fifo operation */
+    ESP_RETURN_ON_ERROR( mpu6050_get_user_control_register(handle, &user_control), TAG, "unable to read user control register, disable fifo failed" );
+    user_control.bits.fifo_enabled = false;
+    user_control.bits.fifo_reset   = true;
+    ESP_RETURN_ON_ERROR( mpu6050_set_user_control_register(handle, user_control), TAG, "unable to write user control register, disable fifo failed" );
+
+    /* attempt to clear fifo sources */
+    ESP_RETURN_ON_ERROR( mpu6050_set_fifo_enable_register(handle, fifo_enable), TAG, "unable to write fifo enable register, disable fifo failed" );
+
+    handle->fifo_enabled    = false;
+    handle->fifo_frame_size = 0;
+    handle->fifo_enable_reg = fifo_enable;
+
+    /* free fifo burst buffer */
+    free(handle->fifo_buffer);
+    handle->fifo_buffer = NULL;
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_fifo_count(mpu6050_handle_t handle, uint16_t *const count) {
+    uint8_t rx[2] = { 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && count );
+
+    /* attempt i2c fifo count read transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_read_from(handle, MPU6050_REG_FIFO_COUNT_H_RW, rx, sizeof(rx)), TAG, "read fifo count registers failed" );
+
+    /* set fifo count parameter */
+    *count = (uint16_t)((rx[0] << 8) | rx[1]);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Reads whole frames from the MPU6050 FIFO and reports the number of frames that were 
+ * in the FIFO before the read.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] samples Caller supplied array of samples.
+ * @param[in] max_samples Number of samples the array can hold.
+ * @param[out] sample_count Number of samples read.
+ * @param[out] available Number of whole frames in the FIFO before the read, optional and can be NULL.
+ * @param[out] overflow FIFO overflowed and was reset when true, optional and can be NULL.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t mpu6050_read_fifo_frames(mpu6050_handle_t handle, mpu6050_fifo_sample_t *const samples, const uint16_t max_samples, uint16_t *const sample_count, uint16_t *const available, bool *const overflow) {
+    uint16_t fifo_count = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && samples && sample_count && max_samples > 0 );
+
+    /* validate fifo state */
+    if (handle->fifo_enabled == false || handle->fifo_buffer == NULL) return ESP_ERR_INVALID_STATE;
+
+    *sample_count = 0;
+    if (available) *available = 0;
+    if (overflow) *overflow = false;
+
+    /* attempt to read number of bytes in the fifo */
+    ESP_RETURN_ON_ERROR( mpu6050_get_fifo_count(handle, &fifo_count), TAG, "unable to read fifo count, read fifo failed" );
+
+    /* a full fifo overwrites the oldest bytes and a partial frame breaks frame alignment, resync by reset */
+    if (fifo_count >= MPU6050_FIFO_SIZE || (fifo_count % handle->fifo_frame_size) != 0) {
+        ESP_LOGW(TAG, "fifo overflow or frame misalignment (%u bytes), fifo reset", fifo_count);
+        if (overflow) *overflow = true;
+        ESP_RETURN_ON_ERROR( mpu6050_reset_fifo(handle), TAG, "unable to reset fifo, read fifo failed" );
+        return ESP_OK;
+    }
+
+    /* whole frames are drained, remaining frames stay in the fifo for the next read */
+    uint16_t frames = fifo_count / handle->fifo_frame_size;
+    if (available) *available = frames;
+    if (frames > max_samples) frames = max_samples;
+    if (frames == 0) return ESP_OK;
+
+    /* attempt i2c fifo burst read transaction */
+    ESP_RETURN_ON_ERROR( mpu6050_i2c_read_from(handle, MPU6050_REG_FIFO_R_W_RW, handle->fifo_buffer, frames * handle->fifo_frame_size), TAG, "read fifo data register failed" );
+
+    const bool accel_enabled = handle->fifo_enable_reg.bits.accel_fifo_enabled;
+    const bool temp_enabled  = handle->fifo_enable_reg.bits.temp_fifo_enabled;
+    const bool gyro_enabled  = handle->fifo_enable_reg.bits.gyro_x_fifo_enabled;
+    const float accel_scale  = 1.0f / handle->accel_sensitivity;
+    const float gyro_scale   = 1.0f / handle->gyro_sensitivity;
+
+    /* decode and scale frames */
+    const uint8_t *frame = handle->fifo_buffer;
+    for (uint16_t i = 0; i < frames; i++) {
+        mpu6050_fifo_sample_t *const sample = &samples[i];
+
+        if (accel_enabled) {
+            sample->accel.x_axis = (int16_t)((frame[0] << 8) | frame[1]) * accel_scale;
+            sample->accel.y_axis = (int16_t)((frame[2] << 8) | frame[3]) * accel_scale;
+            sample->accel.z_axis = (int16_t)((frame[4] << 8) | frame[5]) * accel_scale;
+            frame += MPU6050_FIFO_ACCEL_SIZE;
+        } else {
+            sample->accel.x_axis = sample->accel.y_axis = sample->accel.z_axis = 0.0f;
+        }
+
+        if (temp_enabled) {
+            sample->temperature = (int16_t)((frame[0] << 8) | frame[1]) / 340.0f + 36.53f;
+            frame += MPU6050_FIFO_TEMP_SIZE;
+        } else {
+            sample->temperature = 0.0f;
+        }
+
+        if (gyro_enabled) {
+            sample->gyro.x_axis = (int16_t)((frame[0] << 8) | frame[1]) * gyro_scale;
+            sample->gyro.y_axis = (int16_t)((frame[2] << 8) | frame[3]) * gyro_scale;
+            sample->gyro.z_axis = (int16_t)((frame[4] << 8) | frame[5]) * gyro_scale;
+            frame += MPU6050_FIFO_GYRO_SIZE;
+        } else {
+            sample->gyro.x_axis = sample->gyro.y_axis = sample->gyro.z_axis = 0.0f;
+        }
+    }
+
+    /* set output parameter */
+    *sample_count = frames;
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_read_fifo(mpu6050_handle_t handle, mpu6050_fifo_sample_t *const samples, const uint16_t max_samples, uint16_t *const sample_count, bool *const overflow) {
+    return mpu6050_read_fifo_frames(handle, samples, max_samples, sample_count, NULL, overflow);
+}
+
+/**
+ * @brief MPU6050 pipeline GPIO interrupt handler, counts interrupts and wakes the pipeline 
+ * task when the watermark is reached, or on any interrupt while the pipeline waits for motion.  
+ * With motion gating the count includes motion interrupts and only paces wake-ups, frames are 
+ * counted from the fifo when it is drained.
+ * 
+ * @param pvParameters MPU6050 device handle.
+ */
+static void IRAM_ATTR mpu6050_pipeline_isr_handler(void *pvParameters) {
+    mpu6050_handle_t handle = (mpu6050_handle_t)pvParameters;
+    struct mpu6050_pipeline_s *pipeline = handle->pipeline;
+    BaseType_t task_woken = pdFALSE;
+    bool wake;
+
+    portENTER_CRITICAL_ISR(&pipeline->spinlock);
+    pipeline->irq_time = esp_timer_get_time();
+    if (pipeline->streaming) pipeline->pending++;
+    wake = (pipeline->streaming == false) || (pipeline->pending >= pipeline->config.watermark);
+    portEXIT_CRITICAL_ISR(&pipeline->spinlock);
+
+    if (wake) vTaskNotifyGiveFromISR(pipeline->task_handle, &task_woken);
+    if (task_woken == pdTRUE) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Reads the MPU6050 sample period from the sample rate divider and low-pass filter configuration.
+ * 
+ * @param[in] handle MPU6050 device handle.
+ * @param[out] sample_period Sample period in micro-seconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t mpu6050_get_sample_period(mpu6050_handle_t handle, int64_t *const sample_period) {
+    uint8_t                     sample_rate_divider;
+    mpu6050_config_register_t   config;
+
+    ESP_RETURN_ON_ERROR( mpu6050_get_sample_rate_divider_register(handle, &sample_rate_divider), TAG, "unable to read sample rate divider register, get sample period failed" );
+    ESP_RETURN_ON_ERROR( mpu6050_get_config_register(handle, &config), TAG, "unable to read configuration register, get sample period failed" );
+
+    /* gyroscope output rate is 8khz when the low-pass filter is disabled, otherwise 1khz */
+    const int64_t gyro_output_rate = (config.bits.low_pass_filter == MPU6050_DIGITAL_LP_FILTER_ACCEL_260KHZ_GYRO_256KHZ ||
+                                      config.bits.low_pass_filter == MPU6050_DIGITAL_LP_FILTER_RESERVED) ? 8000 : 1000;
+
+    *sample_period = (1000000LL * (1 + sample_rate_divider)) / gyro_output_rate;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Starts or stops MPU6050 streaming, the fifo and data-ready interrupt are enabled 
+ * while streaming.  The motion detection interrupt is enabled when motion gating is enabled.  
+ * Fifo sources and the burst buffer are configured when the pipeline starts, streaming only 
+ * toggles fifo operation and interrupts with two register writes and no command delays, a 
+ * motion wake-up streams without the register helper delays.
+ * 
+ * @param handle MPU6050 device handle.
+ * @param streaming Streaming is started when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t mpu6050_pipeline_set_streaming(mpu6050_handle_t handle, const bool streaming) {
+    struct mpu6050_pipeline_s *pipeline = handle->pipeline;
+    mpu6050_interrupt_enable_register_t irq_enable   = { .reg = 0 };
+    mpu6050_user_control_register_t     user_control = pipeline->user_control;
+
+    irq_enable.bits.motion_detect_enabled = pipeline->config.motion_gating_enabled;
+
+    /* fifo reset bit auto-clears, the fifo is empty when operation starts or stops */
+    user_control.bits.fifo_reset   = true;
+    user_control.bits.fifo_enabled = streaming;
+
+    if (streaming) {
+        /* fifo is reset before data-ready interrupts are counted */
+        ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_USER_CTRL_RW, user_control.reg), TAG, "unable to write user control register, start streaming failed" );
+        handle->fifo_enabled = true;
+
+        portENTER_CRITICAL(&pipeline->spinlock);
+        pipeline->pending   = 0;
+        pipeline->streaming = true;
+        portEXIT_CRITICAL(&pipeline->spinlock);
+
+        irq_enable.bits.data_ready_enabled    = true;
+        irq_enable.bits.fifo_overflow_enabled = true;
+        ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_INT_ENABLE_RW, irq_enable.reg), TAG, "unable to write interrupt enable register, start streaming failed" );
+    } else {
+        ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_INT_ENABLE_RW, irq_enable.reg), TAG, "unable to write interrupt enable register, stop streaming failed" );
+
+        portENTER_CRITICAL(&pipeline->spinlock);
+        pipeline->pending   = 0;
+        pipeline->streaming = false;
+        portEXIT_CRITICAL(&pipeline->spinlock);
+
+        ESP_RETURN_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_USER_CTRL_RW, user_control.reg), TAG, "unable to write user control register, stop streaming failed" );
+        handle->fifo_enabled = false;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Publishes a batch of samples to the pipeline callback and sample queue.
+ * 
+ * @param pipeline MPU6050 pipeline.
+ * @param count Number of samples in the batch.
+ */
+static inline void mpu6050_pipeline_publish(struct mpu6050_pipeline_s *const pipeline, const uint16_t count) {
+    uint32_t dropped = 0;
+
+    if (pipeline->config.callback) pipeline->config.callback(pipeline->batch, count, pipeline->config.callback_arg);
+
+    if (pipeline->queue_handle) {
+        for (uint16_t i = 0; i < count; i++) {
+            if (xQueueSend(pipeline->queue_handle, &pipeline->batch[i], 0) != pdTRUE) dropped++;
+        }
+    }
+
+    portENTER_CRITICAL(&pipeline->spinlock);
+    pipeline->stats.batches++;
+    pipeline->stats.samples += count;
+    pipeline->stats.dropped += dropped;
+    portEXIT_CRITICAL(&pipeline->spinlock);
+}
+
+/**
+ * @brief Drains the pending frames from the MPU6050 fifo and publishes them.  The newest 
+ * pending frame was written at the last interrupt time, older frames are back-computed from 
+ * the sample period.  Without motion gating only the data-ready interrupt is enabled and the 
+ * frames are counted by the interrupt handler.  With motion gating, motion interrupts share 
+ * the pin and the frames are counted from the fifo instead.
+ * 
+ * @param handle MPU6050 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t mpu6050_pipeline_drain(mpu6050_handle_t handle) {
+    struct mpu6050_pipeline_s *pipeline = handle->pipeline;
+    const bool gating = pipeline->config.motion_gating_enabled;
+
+    for ( ;; ) {
+        uint16_t sample_count = 0;
+        uint16_t available    = 0;
+        bool     overflow     = false;
+
+        portENTER_CRITICAL(&pipeline->spinlock);
+        const uint32_t counted  = pipeline->pending;
+        const int64_t  irq_time = pipeline->irq_time;
+        portEXIT_CRITICAL(&pipeline->spinlock);
+
+        if (gating == false && counted == 0) return ESP_OK;
+
+        const uint16_t request = (gating || counted > MPU6050_PIPELINE_BATCH_MAX) ? MPU6050_PIPELINE_BATCH_MAX : counted;
+
+        ESP_RETURN_ON_ERROR( mpu6050_read_fifo_frames(handle, pipeline->fifo_samples, request, &sample_count, &available, &overflow), TAG, "unable to read fifo, pipeline drain failed" );
+
+        if (overflow) {
+            portENTER_CRITICAL(&pipeline->spinlock);
+            pipeline->pending = 0;
+            pipeline->stats.overflows++;
+            portEXIT_CRITICAL(&pipeline->spinlock);
+            return ESP_OK;
+        }
+
+        /* motion interrupts are not frames, the interrupt count only paced the wake-up */
+        const uint32_t pending = gating ? available : counted;
+
+        /* frame i of the pending frames was written at irq_time - (pending - 1 - i) * sample_period */
+        for (uint16_t i = 0; i < sample_count; i++) {
+            pipeline->batch[i].timestamp = irq_time - (int64_t)(pending - 1 - i) * pipeline->sample_period;
+            pipeline->batch[i].sample    = pipeline->fifo_samples[i];
+        }
+
+        /* fewer frames than counted, interrupts were not frame aligned, counted frames are resynced */
+        const uint32_t consumed = (gating || sample_count < request) ? counted : sample_count;
+
+        portENTER_CRITICAL(&pipeline->spinlock);
+        pipeline->pending = (pipeline->pending > consumed) ? pipeline->pending - consumed : 0;
+        portEXIT_CRITICAL(&pipeline->spinlock);
+
+        if (sample_count > 0) mpu6050_pipeline_publish(pipeline, sample_count);
+
+        if (sample_count < request || sample_count == pending) return ESP_OK;
+    }
+}
+
+/**
+ * @brief MPU6050 pipeline task entry, blocks until the interrupt handler notifies the task 
+ * and drains the fifo.  With motion gating, streaming starts on a motion interrupt and 
+ * stops when no motion is detected for the hold period.
+ * 
+ * @param pvParameters MPU6050 device handle.
+ */
+static void mpu6050_pipeline_task_entry(void *pvParameters) {
+    mpu6050_handle_t handle = (mpu6050_handle_t)pvParameters;
+    struct mpu6050_pipeline_s *pipeline = handle->pipeline;
+    const bool gating = pipeline->config.motion_gating_enabled;
+
+    for ( ;; ) {
+        const TickType_t wait = (gating && pipeline->streaming) ? pdMS_TO_TICKS(pipeline->config.motion_hold_ms) : portMAX_DELAY;
+
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        if (pipeline->stop_requested) break;
+
+        const int64_t now = esp_timer_get_time();
+
+        if (gating) {
+            mpu6050_interrupt_status_register_t irq_status = { .reg = 0 };
+
+            /* interrupt status is read before the fifo, any register read can clear it */
+            if (mpu6050_i2c_read_byte_from(handle, MPU6050_REG_INT_STATUS_R, &irq_status.reg) != ESP_OK) {
+                ESP_LOGE(TAG, "pipeline read interrupt status register failed");
+                continue;
+            }
+
+            if (irq_status.bits.irq_motion_detect) {
+                pipeline->last_motion_time = now;
+
+                portENTER_CRITICAL(&pipeline->spinlock);
+                pipeline->stats.motion_events++;
+                portEXIT_CRITICAL(&pipeline->spinlock);
+
+                if (pipeline->streaming == false && mpu6050_pipeline_set_streaming(handle, true) != ESP_OK) {
+                    ESP_LOGE(TAG, "pipeline start streaming failed");
+                }
+            }
+        }
+
+        if (pipeline->streaming && mpu6050_pipeline_drain(handle) != ESP_OK) {
+            ESP_LOGE(TAG, "pipeline drain failed");
+        }
+
+        /* no motion for the hold period, stop streaming until the next motion interrupt */
+        if (gating && pipeline->streaming && (now - pipeline->last_motion_time) >= ((int64_t)pipeline->config.motion_hold_ms * 1000)) {
+            if (mpu6050_pipeline_set_streaming(handle, false) != ESP_OK) {
+                ESP_LOGE(TAG, "pipeline stop streaming failed");
+            }
+        }
+    }
+
+    xSemaphoreGive(pipeline->stopped_handle);
+    vTaskDelete( NULL );
+}
+
+esp_err_t mpu6050_start_pipeline(mpu6050_handle_t handle, const mpu6050_pipeline_config_t *config) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && config && config->watermark > 0 && config->watermark <= MPU6050_PIPELINE_WATERMARK_MAX );
+
+    if (handle->pipeline) return ESP_ERR_INVALID_STATE;
+
+    /* validate memory availability for pipeline */
+    struct mpu6050_pipeline_s *pipeline = (struct mpu6050_pipeline_s*)calloc(1, sizeof(struct mpu6050_pipeline_s));
+    ESP_RETURN_ON_FALSE( pipeline, ESP_ERR_NO_MEM, TAG, "no memory for mpu6050 pipeline, start pipeline failed" );
+
+    pipeline->config = *config;
+    portMUX_INITIALIZE(&pipeline->spinlock);
+
+    /* attempt to read sample period for timestamps */
+    ESP_GOTO_ON_ERROR( mpu6050_get_sample_period(handle, &pipeline->sample_period), err, TAG, "unable to read sample period, start pipeline failed" );
+
+    pipeline->stopped_handle = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE( pipeline->stopped_handle, ESP_ERR_NO_MEM, err, TAG, "create pipeline stopped semaphore failed" );
+
+    if (config->queue_length > 0) {
+        pipeline->queue_handle = xQueueCreate(config->queue_length, sizeof(mpu6050_pipeline_sample_t));
+        ESP_GOTO_ON_FALSE( pipeline->queue_handle, ESP_ERR_NO_MEM, err_semaphore, TAG, "create pipeline sample queue failed" );
+    }
+
+    /* attempt to configure interrupt pin and gpio */
+    ESP_GOTO_ON_ERROR( mpu6050_configure_interrupts(handle, &handle->dev_config), err_queue, TAG, "unable to configure interrupts, start pipeline failed" );
+
+    if (config->motion_gating_enabled) {
+        ESP_GOTO_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_MOT_THR_RW, config->motion_threshold), err_queue, TAG, "unable to write motion threshold, start pipeline failed" );
+        ESP_GOTO_ON_ERROR( mpu6050_i2c_write_byte_to(handle, MPU6050_REG_MOT_DUR_RW, config->motion_duration), err_queue, TAG, "unable to write motion duration, start pipeline failed" );
+    }
+
+    handle->pipeline = pipeline;
+
+    BaseType_t task_err = xTaskCreatePinnedToCore( 
+        mpu6050_pipeline_task_entry, 
+        MPU6050_PIPELINE_TASK_NAME, 
+        MPU6050_PIPELINE_TASK_STACK_SIZE, 
+        handle, 
+        MPU6050_PIPELINE_TASK_PRIORITY,
+        &pipeline->task_handle, 
+        APP_CPU_NUM );
+    ESP_GOTO_ON_FALSE( task_err == pdPASS, ESP_ERR_NO_MEM, err_handle, TAG, "create mpu6050 pipeline task failed" );
+
+    /* attempt to register pipeline isr */
+    ESP_GOTO_ON_ERROR( mpu6050_register_isr(handle, mpu6050_pipeline_isr_handler), err_task, TAG, "unable to register isr, start pipeline failed" );
+
+    /* attempt to configure fifo sources and burst buffer once, streaming toggles fifo operation */
+    ESP_GOTO_ON_ERROR( mpu6050_enable_fifo(handle, true, true, true), err_isr, TAG, "unable to enable fifo, start pipeline failed" );
+    ESP_GOTO_ON_ERROR( mpu6050_get_user_control_register(handle, &pipeline->user_control), err_fifo, TAG, "unable to read user control register, start pipeline failed" );
+    pipeline->user_control.bits.fifo_enabled = false;
+    pipeline->user_control.bits.fifo_reset   = false;
+
+    /* streaming starts immediately or waits for motion */
+    ESP_GOTO_ON_ERROR( mpu6050_pipeline_set_streaming(handle, !config->motion_gating_enabled), err_fifo, TAG, "unable to set streaming, start pipeline failed" );
+
+    return ESP_OK;
+
+    err_fifo:
+        mpu6050_disable_fifo(handle);
+    err_isr:
+        gpio_isr_handler_remove(handle->dev_config.irq_io_num);
+    err_task:
+        pipeline->stop_requested = true;
+        xTaskNotifyGive(pipeline->task_handle);
+        xSemaphoreTake(pipeline->stopped_handle, portMAX_DELAY);
+    err_handle:
+        handle->pipeline = NULL;
+    err_queue:
+        if (pipeline->queue_handle) vQueueDelete(pipeline->queue_handle);
+    err_semaphore:
+        vSemaphoreDelete(pipeline->stopped_handle);
+    err:
+        free(pipeline);
+        return ret;
+}
+
+esp_err_t mpu6050_stop_pipeline(mpu6050_handle_t handle) {
+    mpu6050_interrupt_enable_register_t irq_enable = { .reg = 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handle );
+
+    struct mpu6050_pipeline_s *pipeline = handle->pipeline;
+    if (pipeline == NULL) return ESP_OK;
+
+    /* attempt to remove isr, interrupts no longer reach the pipeline */
+    gpio_intr_disable(handle->dev_config.irq_io_num);
+    gpio_isr_handler_remove(handle->dev_config.irq_io_num);
+
+    /* stop pipeline task */
+    pipeline->stop_requested = true;
+    xTaskNotifyGive(pipeline->task_handle);
+    xSemaphoreTake(pipeline->stopped_handle, portMAX_DELAY);
+
+    /* restore data-ready interrupt of the default setup */
+    irq_enable.bits.data_ready_enabled = true;
+    esp_err_t ret = mpu6050_set_interrupt_enable_register(handle, irq_enable);
+    if (ret == ESP_OK && handle->fifo_buffer) ret = mpu6050_disable_fifo(handle);
+
+    handle->pipeline = NULL;
+    if (pipeline->queue_handle) vQueueDelete(pipeline->queue_handle);
+    vSemaphoreDelete(pipeline->stopped_handle);
+    free(pipeline);
+
+    return ret;
+}
+
+esp_err_t mpu6050_get_pipeline_queue(mpu6050_handle_t handle, QueueHandle_t *const queue) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && queue );
+
+    if (handle->pipeline == NULL) return ESP_ERR_INVALID_STATE;
+
+    *queue = handle->pipeline->queue_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_pipeline_stats(mpu6050_handle_t handle, mpu6050_pipeline_stats_t *const stats) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && stats );
+
+    if (handle->pipeline == NULL) return ESP_ERR_INVALID_STATE;
+
+    portENTER_CRITICAL(&handle->pipeline->spinlock);
+    *stats = handle->pipeline->stats;
+    portEXIT_CRITICAL(&handle->pipeline->spinlock);
+
+    return ESP_OK;
+}
+
 esp_err_t mpu6050_register_isr(mpu6050_handle_t handle, const mpu6050_isr_t isr) {
     /* validate arguments */
     ESP_ARG_CHECK( handle );
@@ -809,7 +1477,12 @@ esp_err_t mpu6050_reset(mpu6050_handle_t handle) {
     ESP_RETURN_ON_ERROR( mpu6050_set_power_management1_register(handle, pwr_mgmnt), TAG, "unable to set power management 1 register, reset failed" );
 
     /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(MPU6050_RESET_DELAY_MS));
+    I2C_TRACE_DELAY(handle->i2c_handle, pdMS_TO_TICKS(MPU6050_RESET_DELAY_MS));
+
+    /* soft-reset clears fifo configuration */
+    handle->fifo_enabled    = false;
+    handle->fifo_frame_size = 0;
+    handle->fifo_enable_reg.reg = 0;
 
     /* reconfigure sensor */
     ESP_RETURN_ON_ERROR( mpu6050_setup(handle), TAG, "unable to setup device, reset failed" );
@@ -822,6 +1495,7 @@ esp_err_t mpu6050_remove(mpu6050_handle_t handle) {
     ESP_ARG_CHECK( handle );
 
     /* remove device from i2c master bus */
+    I2C_TRACE_REMOVE_DEVICE(handle->i2c_handle);
     return i2c_master_bus_rm_device(handle->i2c_handle);
 }
 
@@ -829,11 +1503,15 @@ esp_err_t mpu6050_delete(mpu6050_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
+    /* stop interrupt-driven pipeline */
+    ESP_RETURN_ON_ERROR( mpu6050_stop_pipeline(handle), TAG, "unable to stop pipeline, delete handle failed" );
+
     /* remove device from master bus */
     ESP_RETURN_ON_ERROR( mpu6050_remove(handle), TAG, "unable to remove device from i2c master bus, delete handle failed" );
 
     /* validate handle instance and free handles */
     if(handle) {
+        free(handle->fifo_buffer);
         free(handle);
     }
 
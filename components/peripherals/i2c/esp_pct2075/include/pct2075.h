@@ -117,6 +117,7 @@ typedef struct pct2075_config_s {
     float                           hys_temperature;    /*!< pct2075 hysteresis set-point temperature in degree Celsius (range is -55 to 125 degree Celsius), a temperature of 75.0 °C is set by default */
     bool                            configure_sampling; /*!< pct2075 sampling period is set when true, factory sampling period is used by default */
     uint16_t                        sampling_period;    /*!< pct2075 sampling period in milliseconds (range is 100 to 3,100 milliseconds), 100 ms is the sampling period by default */
+    bool                            conservative_timing;/*!< pct2075 applies the legacy fixed command delay during initialization when true, disabled by default */
 } pct2075_config_t;
 
 
@@ -347,16 +347,16 @@ static inline float pct2075_convert_11bit_signal_to_temperature(const bit16_uint
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t pct2075_i2c_get_config_register(pct2075_device_t *const device, pct2075_config_register_t *const reg) {
-    uint16_t cfg = { 0 };
+    bit8_uint8_buffer_t rx = { 0 };
 
     /* validate arguments */
     ESP_ARG_CHECK( device && reg );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( pct2075_i2c_read_word_from(device, PCT2075_REG_CONFIG, &cfg), TAG, "read configuration register failed" );
+    /* attempt i2c read transaction - the configuration register is 8-bit */
+    ESP_RETURN_ON_ERROR( pct2075_i2c_read_from(device, PCT2075_REG_CONFIG, rx, BIT8_UINT8_BUFFER_SIZE), TAG, "read configuration register failed" );
 
     /* convert to configuration register */
-    reg->reg = cfg;
+    reg->reg = rx[0];
     
     return ESP_OK;
 }
@@ -372,8 +372,8 @@ static inline esp_err_t pct2075_i2c_set_config_register(pct2075_device_t *const
     /* validate arguments */
     ESP_ARG_CHECK( device );
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( pct2075_i2c_write_word_to(device, PCT2075_REG_CONFIG, reg.reg), TAG, "write configuration register failed" );
+    /* attempt i2c write transaction - the configuration register is 8-bit */
+    ESP_RETURN_ON_ERROR( pct2075_i2c_write_byte_to(device, PCT2075_REG_CONFIG, reg.reg), TAG, "write configuration register failed" );
     
     return ESP_OK;
 }
@@ -637,8 +637,8 @@ esp_err_t pct2075_init(const i2c_master_bus_handle_t master_handle, const pct207
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &device->i2c_handle), err_handle, TAG, "i2c new bus failed");
     }
 
-    /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(PCT2075_CMD_DELAY_MS));
+    /* delay task before next i2c transaction, register accesses need no settling time per the datasheet */
+    if (device->config.conservative_timing == true) vTaskDelay(pdMS_TO_TICKS(PCT2075_CMD_DELAY_MS));
 
     /* setup device */
     ESP_RETURN_ON_ERROR( pct2075_i2c_setup(device), TAG, "setup device failed" );
@@ -646,7 +646,7 @@ esp_err_t pct2075_init(const i2c_master_bus_handle_t master_handle, const pct207
     /* set device handle */
     *pct2075_handle = (pct2075_handle_t)device;
 
-    /* delay task before next i2c transaction */
+    /* delay task before next i2c transaction, allows the first temperature conversion to complete */
     vTaskDelay(pdMS_TO_TICKS(PCT2075_APPSTART_DELAY_MS));
 
     return ESP_OK;
@@ -177,6 +177,36 @@ esp_err_t sht4x_get_measurement(sht4x_handle_t handle, float *const temperature,
  */
 esp_err_t sht4x_get_measurements(sht4x_handle_t handle, float *const temperature, float *const humidity, float *const dewpoint);
 
+/**
+ * @brief Issues a measurement command to SHT4X, from the configured repeatability and heater modes, without
+ * waiting for the conversion to complete.
+ *
+ * @note Use `sht4x_get_measurement_ready_time` to schedule the `sht4x_collect_measurement` call.
+ *
+ * @param[in] handle SHT4X device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t sht4x_start_measurement(sht4x_handle_t handle);
+
+/**
+ * @brief Gets the SHT4X conversion time, in microseconds, computed from the configured repeatability and heater modes.
+ *
+ * @param[in] handle SHT4X device handle.
+ * @param[out] ready_time_us Measurement conversion time in microseconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t sht4x_get_measurement_ready_time(sht4x_handle_t handle, uint32_t *const ready_time_us);
+
+/**
+ * @brief Reads temperature and relative humidity from SHT4X after `sht4x_start_measurement`.  This is a non-blocking function.
+ *
+ * @param[in] handle SHT4X device handle.
+ * @param[out] temperature Temperature in degree Celsius.
+ * @param[out] humidity Relative humidity in percentage.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FINISHED when the sensor is still converting (read is not acknowledged), other bus errors (i.e. ESP_ERR_TIMEOUT) are returned.
+ */
+esp_err_t sht4x_collect_measurement(sht4x_handle_t handle, float *const temperature, float *const humidity);
+
 /**
  * @brief Reads measurements from SHT4X into a `sht4x_data_t` structure.  This is a blocking function.
  * 
@@ -42,6 +42,7 @@
 #include <esp_check.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <i2c_trace.h>
 
 /*
  * SHT4X definitions
@@ -115,7 +116,7 @@ static inline esp_err_t sht4x_i2c_read(sht4x_device_t *const device, uint8_t *bu
     ESP_ARG_CHECK( device );
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_receive(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_RECEIVE(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, i2c read failed" );
 
     return ESP_OK;
 }
@@ -133,7 +134,7 @@ static inline esp_err_t sht4x_i2c_write(sht4x_device_t *const device, const uint
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -152,7 +153,7 @@ static inline esp_err_t sht4x_i2c_write_command(sht4x_device_t *const device, co
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, tx, BIT8_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
@@ -300,7 +301,7 @@ static inline esp_err_t sht4x_get_serial_number(sht4x_handle_t handle, uint32_t
     ESP_RETURN_ON_ERROR( sht4x_i2c_write(dev, tx, BIT8_UINT8_BUFFER_SIZE), TAG, "unable to write to i2c device handle, get serial number failed");
 	
     /* delay before attempting i2c read transaction */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_TX_RX_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_TX_RX_DELAY_MS));
 
     /* attempt i2c read transaction */
     ESP_RETURN_ON_ERROR( sht4x_i2c_read(dev, rx, BIT48_UINT8_BUFFER_SIZE), TAG, "unable to read to i2c device handle, get serial number failed");
@@ -309,7 +310,7 @@ static inline esp_err_t sht4x_get_serial_number(sht4x_handle_t handle, uint32_t
     *serial_number = ((uint32_t)rx[0] << 24) | ((uint32_t)rx[1] << 16) | ((uint32_t)rx[3] << 8) | rx[4];
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -342,10 +343,11 @@ esp_err_t sht4x_init(i2c_master_bus_handle_t master_handle, const sht4x_config_t
     /* validate device handle */
     if (dev->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &dev->i2c_handle), err_handle, TAG, "unable to add device to master bus, device handle initialization failed");
+        I2C_TRACE_ADD_DEVICE(dev->i2c_handle, "sht4x", i2c_dev_conf.device_address);
     }
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
 
     /* attempt to reset the device */
     ESP_GOTO_ON_ERROR(sht4x_reset((sht4x_handle_t)dev), err_handle, TAG, "unable to soft-reset device, device handle initialization failed");
@@ -354,12 +356,13 @@ esp_err_t sht4x_init(i2c_master_bus_handle_t master_handle, const sht4x_config_t
     *sht4x_handle = (sht4x_handle_t)dev;
 
     /* application start delay */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_APPSTART_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_APPSTART_DELAY_MS));
 
     return ESP_OK;
 
     err_handle:
         if (dev && dev->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(dev->i2c_handle);
             i2c_master_bus_rm_device(dev->i2c_handle);
         }
         free(dev);
@@ -387,7 +390,7 @@ esp_err_t sht4x_get_measurement(sht4x_handle_t handle, float *const temperature,
     ESP_RETURN_ON_ERROR( sht4x_i2c_write(dev, tx, BIT8_UINT8_BUFFER_SIZE), TAG, "unable to write to i2c device handle, get measurement failed");
 	
 	/* delay task - allow time for the sensor to process measurement request */
-    if(delay_ticks) vTaskDelay(delay_ticks);
+    if(delay_ticks) I2C_TRACE_DELAY(dev->i2c_handle, delay_ticks);
 
     /* retry needed - unexpected nack indicates that the sensor is still busy */
     do {
@@ -395,7 +398,7 @@ esp_err_t sht4x_get_measurement(sht4x_handle_t handle, float *const temperature,
         ret = sht4x_i2c_read(dev, rx, BIT48_UINT8_BUFFER_SIZE);
 
         /* delay before next retry attempt */
-        vTaskDelay(pdMS_TO_TICKS(SHT4X_RETRY_DELAY_MS));
+        I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_RETRY_DELAY_MS));
     } while (++rx_retry_count <= rx_retry_max && ret != ESP_OK );
 
     /* attempt i2c read transaction */
@@ -411,7 +414,7 @@ esp_err_t sht4x_get_measurement(sht4x_handle_t handle, float *const temperature,
     *humidity    = (float)((uint16_t)rx[3] << 8 | rx[4]) * 125.0f / 65535.0f - 6.0f;
 
     /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_CMD_DELAY_MS));
 
     return ESP_OK;
 }
@@ -427,6 +430,58 @@ esp_err_t sht4x_get_measurements(sht4x_handle_t handle, float *const temperature
     return ESP_OK;
 }
 
+esp_err_t sht4x_start_measurement(sht4x_handle_t handle) {
+    bit8_uint8_buffer_t tx = { 0 };
+    sht4x_device_t* dev    = (sht4x_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev );
+
+    /* get command from handle settings */
+    tx[0] = sht4x_get_command(dev);
+
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( sht4x_i2c_write(dev, tx, BIT8_UINT8_BUFFER_SIZE), TAG, "unable to write to i2c device handle, start measurement failed");
+
+    return ESP_OK;
+}
+
+esp_err_t sht4x_get_measurement_ready_time(sht4x_handle_t handle, uint32_t *const ready_time_us) {
+    sht4x_device_t* dev = (sht4x_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && ready_time_us );
+
+    /* get measurement duration from handle settings */
+    *ready_time_us = (uint32_t)sht4x_get_duration(dev) * 1000;
+
+    return ESP_OK;
+}
+
+esp_err_t sht4x_collect_measurement(sht4x_handle_t handle, float *const temperature, float *const humidity) {
+    bit48_uint8_buffer_t rx = { 0 };
+    sht4x_device_t* dev     = (sht4x_device_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( dev && temperature && humidity );
+
+    /* attempt i2c read transaction - a nack indicates that the sensor is still busy, bus errors are passed through */
+    const esp_err_t ret = I2C_TRACE_RECEIVE(dev->i2c_handle, rx, BIT48_UINT8_BUFFER_SIZE, I2C_XFR_TIMEOUT_MS);
+    if (ret == ESP_ERR_INVALID_STATE) return ESP_ERR_NOT_FINISHED;
+    ESP_RETURN_ON_ERROR( ret, TAG, "read measurement for collect measurement failed" );
+
+    /* validate crc values */
+    if (rx[2] != sht4x_calculate_crc8(rx, 2) || rx[5] != sht4x_calculate_crc8(rx + 3, 2)) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+	// convert sht4x results to engineering units of measure (C and %)
+    *temperature = (float)((uint16_t)rx[0] << 8 | rx[1]) * 175.0f / 65535.0f - 45.0f;
+    *humidity    = (float)((uint16_t)rx[3] << 8 | rx[4]) * 125.0f / 65535.0f - 6.0f;
+
+    return ESP_OK;
+}
+
 esp_err_t sht4x_get_repeat_mode(sht4x_handle_t handle, sht4x_repeat_modes_t *const mode) {
     sht4x_device_t* dev = (sht4x_device_t*)handle;
 
@@ -484,7 +539,7 @@ esp_err_t sht4x_reset(sht4x_handle_t handle) {
     ESP_RETURN_ON_ERROR( sht4x_i2c_write_command(dev, SHT4X_CMD_RESET), TAG, "unable to write to device handle, device reset failed");
 
     /* delay before next command - soft-reset */
-    vTaskDelay(pdMS_TO_TICKS(SHT4X_RESET_DELAY_MS));
+    I2C_TRACE_DELAY(dev->i2c_handle, pdMS_TO_TICKS(SHT4X_RESET_DELAY_MS));
 
     /* sht4x attempt to read device serial number */
     ESP_RETURN_ON_ERROR(sht4x_get_serial_number(handle, &dev->serial_number), TAG, "unable to read serial number, device reset failed");
@@ -498,6 +553,7 @@ esp_err_t sht4x_remove(sht4x_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
+    I2C_TRACE_REMOVE_DEVICE(dev->i2c_handle);
     return i2c_master_bus_rm_device(dev->i2c_handle);
 }
 
@@ -106,6 +106,13 @@ extern "C" {
     .offset_x                   = 0,						\
     .flip_enabled               = false }
 
+/**
+ * @brief Macro that initializes `ssd1306_flush_config_t` to default asynchronous flush settings.
+ */
+#define SSD1306_FLUSH_CONFIG_DEFAULT	{				\
+	.max_frame_rate				= 20,						\
+	.task_priority				= 1 }
+
 
 /*
  * enumerator and structure declarations
@@ -193,11 +200,37 @@ typedef struct ssd1306_config_s {
 	bool						display_enabled;/*!< ssd1306 display is on when true otherwise it is off and sleeping */
 } ssd1306_config_t;
 
+/**
+ * @brief SSD1306 asynchronous flush configuration structure definition.
+ */
+typedef struct ssd1306_flush_config_s {
+	uint16_t					max_frame_rate;	/*!< ssd1306 flush task maximum frame rate in hertz, swaps within a frame period are coalesced */
+	uint8_t						task_priority;	/*!< ssd1306 flush task priority, low priority is recommended */
+} ssd1306_flush_config_t;
+
+/**
+ * @brief SSD1306 flush statistics structure definition.
+ */
+typedef struct ssd1306_flush_stats_s {
+	uint32_t					frames;			/*!< ssd1306 number of frames written to the display panel */
+	uint32_t					swaps;			/*!< ssd1306 number of buffer swaps, swaps greater than frames indicates coalesced swaps */
+	uint32_t					windows;		/*!< ssd1306 number of page windows written */
+	uint64_t					bytes;			/*!< ssd1306 number of bytes written, including window headers */
+	float						last_frame_ms;	/*!< ssd1306 duration of the last frame in milli-seconds */
+	float						max_frame_ms;	/*!< ssd1306 maximum frame duration in milli-seconds */
+	float						average_frame_ms;/*!< ssd1306 average frame duration in milli-seconds */
+} ssd1306_flush_stats_t;
+
 /**
  * @brief SSD1306 opaque handle stucture definition.
  */
 typedef void* ssd1306_handle_t;
 
+/**
+ * @brief SSD1306 glyph cache opaque handle stucture definition.
+ */
+typedef void* ssd1306_glyph_cache_handle_t;
+
 
 
 /**
@@ -285,6 +318,69 @@ esp_err_t ssd1306_display_bdf_text(ssd1306_handle_t handle, const uint8_t *font,
  */
 esp_err_t ssd1306_display_bdf_code(ssd1306_handle_t handle, const uint8_t *font, int code, int xpos, int ypos);
 
+/**
+ * @brief Creates a glyph cache from a BDF font, glyphs are pre-rotated into the page-major 
+ * column byte format of the display panel so text is blitted with byte shifts and masks 
+ * instead of per-pixel writes.
+ * 
+ * @note Glyph cells are the font bounding box height by the glyph advance width, pixels 
+ * outside the cell are clipped.
+ * 
+ * @param[in] font BDF font bitmap data.
+ * @param[in] first_code First character code to cache.
+ * @param[in] last_code Last character code to cache.
+ * @param[out] cache_handle Glyph cache handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_create_glyph_cache(const uint8_t *font, uint8_t first_code, uint8_t last_code, ssd1306_glyph_cache_handle_t *const cache_handle);
+
+/**
+ * @brief Gets the glyph cache of the built-in 8x8 latin font, the cache is transposed at 
+ * compile time and is not allocated.
+ * 
+ * @param[out] cache_handle Glyph cache handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_get_latin_8x8_glyph_cache(ssd1306_glyph_cache_handle_t *const cache_handle);
+
+/**
+ * @brief Deletes a glyph cache and frees resources.
+ * 
+ * @param cache_handle Glyph cache handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_delete_glyph_cache(ssd1306_glyph_cache_handle_t cache_handle);
+
+/**
+ * @brief Sets text in the page buffer from a glyph cache at any pixel position, y-axis 
+ * positions are not required to be page aligned.  Glyph cells are opaque, they replace 
+ * the previous content, and only columns that changed are marked dirty.
+ * 
+ * @note Call `ssd1306_display_pages` to display the text.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param cache_handle Glyph cache handle.
+ * @param xpos X-axis position of the first glyph cell.
+ * @param ypos Y-axis position of the top of the glyph cells.
+ * @param text Text to set, glyphs beyond the panel width are clipped.
+ * @param invert Glyph cells are inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_set_glyph_text(ssd1306_handle_t handle, ssd1306_glyph_cache_handle_t cache_handle, uint8_t xpos, uint8_t ypos, const char *text, bool invert);
+
+/**
+ * @brief Displays text from a glyph cache at any pixel position, see `ssd1306_set_glyph_text`.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param cache_handle Glyph cache handle.
+ * @param xpos X-axis position of the first glyph cell.
+ * @param ypos Y-axis position of the top of the glyph cells.
+ * @param text Text to display, glyphs beyond the panel width are clipped.
+ * @param invert Glyph cells are inverted when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_display_glyph_text(ssd1306_handle_t handle, ssd1306_glyph_cache_handle_t cache_handle, uint8_t xpos, uint8_t ypos, const char *text, bool invert);
+
 /**
  * @brief Turns SSD1306 display panel on.
  * 
@@ -302,13 +398,77 @@ esp_err_t ssd1306_enable_display(ssd1306_handle_t handle);
 esp_err_t ssd1306_disable_display(ssd1306_handle_t handle);
 
 /**
- * @brief Displays segment data for each page supported by the SSD1306 display panel.
+ * @brief Displays segment data changed since the last call for each page supported by 
+ * the SSD1306 display panel.  Drawing functions track a dirty segment range per page, 
+ * only the dirty range of each page is written, as a single i2c transaction per page, 
+ * and clean pages are skipped.
  * 
  * @param handle SSD1306 device handle.
  * @return esp_err_t ESP_OK on success.
  */
 esp_err_t ssd1306_display_pages(ssd1306_handle_t handle);
 
+/**
+ * @brief Marks every page supported by the SSD1306 display panel as dirty, the next call 
+ * to `ssd1306_display_pages` refreshes the entire display panel (i.e. after the display 
+ * ram content was lost).
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_invalidate_pages(ssd1306_handle_t handle);
+
+/**
+ * @brief Enables asynchronous flush, a low priority task writes the dirty page windows 
+ * of a front buffer to the display panel while drawing functions continue to update 
+ * the back buffer.  While enabled, `ssd1306_display_pages` and `ssd1306_display_image` 
+ * swap buffers instead of writing the display panel, and return without waiting on i2c 
+ * transactions.
+ * 
+ * @note The back buffer keeps its content after a swap, drawing remains incremental.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param flush_config Asynchronous flush configuration.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_enable_async_flush(ssd1306_handle_t handle, const ssd1306_flush_config_t *flush_config);
+
+/**
+ * @brief Disables asynchronous flush, pending back buffer windows are written and the 
+ * flush task is stopped before returning.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_disable_async_flush(ssd1306_handle_t handle);
+
+/**
+ * @brief Copies the dirty page windows of the back buffer to the front buffer and notifies 
+ * the flush task.  Swaps within a frame period are coalesced into a single frame.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when asynchronous flush is disabled.
+ */
+esp_err_t ssd1306_swap_buffers(ssd1306_handle_t handle);
+
+/**
+ * @brief Gets flush statistics, frames written synchronously by `ssd1306_display_pages` 
+ * are included.
+ * 
+ * @param handle SSD1306 device handle.
+ * @param stats SSD1306 flush statistics.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_get_flush_stats(ssd1306_handle_t handle, ssd1306_flush_stats_t *const stats);
+
+/**
+ * @brief Resets flush statistics.
+ * 
+ * @param handle SSD1306 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ssd1306_reset_flush_stats(ssd1306_handle_t handle);
+
 /**
  * @brief Sets segment data for each page supported by the SSD1306 display panel.
  * 
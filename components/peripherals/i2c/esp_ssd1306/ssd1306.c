@@ -38,8 +38,11 @@
 #include <string.h>
 #include <esp_log.h>
 #include <esp_check.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <i2c_trace.h>
 
 // Following definitions are borrowed from 
 // http://robotcantalk.blogspot.com/2015/03/interfacing-arduino-with-ssd1306-driven.html
@@ -114,6 +117,12 @@ Usage:
 #define SSD1306_TEXT_X2_DISPLAY_MAX_LEN	   8
 #define SSD1306_TEXT_X3_DISPLAY_MAX_LEN	   5
 
+#define SSD1306_WINDOW_HEADER_SIZE	   7		// page and column addressing commands (3x control and command byte pairs) + data stream control byte
+#define SSD1306_PAGE_CLEAN			   0xFF		// dirty column start of a clean page
+
+#define SSD1306_FLUSH_TASK_NAME			"ssd1306_flush"
+#define SSD1306_FLUSH_TASK_STACK_SIZE	(configMINIMAL_STACK_SIZE * 3)
+
 #define I2C_XFR_TIMEOUT_MS      (500)          //!< I2C transaction timeout in milliseconds
 
 
@@ -137,11 +146,55 @@ typedef struct ssd1306_device_s {
 	int8_t			    scroll_direction;   /*!< ssd1306 scroll direction */
 	uint8_t				pages;				/*!< ssd1306 number of pages supported by display panel */
 	ssd1306_page_t	    page[16];			/*!< ssd1306 pages of segment data to display */
+	uint8_t				dirty_start[16];	/*!< ssd1306 first dirty segment by page, SSD1306_PAGE_CLEAN when the page is clean */
+	uint8_t				dirty_end[16];		/*!< ssd1306 last dirty segment by page */
+	uint8_t				tx_buffer[SSD1306_WINDOW_HEADER_SIZE + SSD1306_PAGE_SEGMENT_SIZE]; /*!< ssd1306 preallocated page window transaction buffer */
+	volatile bool		flush_enabled;		/*!< ssd1306 asynchronous flush task is running when true */
+	ssd1306_flush_config_t flush_config;	/*!< ssd1306 asynchronous flush configuration */
+	ssd1306_page_t*		front_page;			/*!< ssd1306 front buffer pages, written by the flush task */
+	uint8_t				front_dirty_start[16]; /*!< ssd1306 first dirty segment of the front buffer by page, SSD1306_PAGE_CLEAN when the page is clean */
+	uint8_t				front_dirty_end[16];/*!< ssd1306 last dirty segment of the front buffer by page */
+	SemaphoreHandle_t	front_mutex_handle;	/*!< ssd1306 front buffer mutex handle */
+	SemaphoreHandle_t	flush_stopped_handle; /*!< ssd1306 flush task stopped semaphore handle */
+	TaskHandle_t		flush_task_handle;	/*!< ssd1306 flush task handle */
+	portMUX_TYPE		stats_spinlock;		/*!< ssd1306 flush statistics spinlock */
+	ssd1306_flush_stats_t stats;			/*!< ssd1306 flush statistics */
+	uint64_t			stats_total_us;		/*!< ssd1306 accumulated flush time in micro-seconds */
 } ssd1306_device_t;
 
+/**
+ * @brief SSD1306 glyph cache structure definition.  Glyph columns are pre-rotated into 
+ * the page-major column byte format of the display panel, glyph `g` page `p` column `x` 
+ * is located at `columns[(g * pages + p) * max_width + x]`.
+ */
+typedef struct ssd1306_glyph_cache_s {
+	uint8_t				first_code;			/*!< ssd1306 glyph cache first character code */
+	uint16_t			count;				/*!< ssd1306 glyph cache number of glyphs */
+	uint8_t				height;				/*!< ssd1306 glyph cache cell height in pixels */
+	uint8_t				pages;				/*!< ssd1306 glyph cache cell height in pages */
+	uint8_t				max_width;			/*!< ssd1306 glyph cache maximum cell width in pixels */
+	const uint8_t*		advance;			/*!< ssd1306 glyph cell width by glyph, 0 when the glyph is missing, NULL for fixed width glyphs */
+	const uint8_t*		columns;			/*!< ssd1306 pre-rotated glyph columns */
+	bool				allocated;			/*!< ssd1306 glyph cache was allocated by `ssd1306_create_glyph_cache` when true */
+} ssd1306_glyph_cache_t;
+
 /*
 * static constant declarations
 */
+
+/**
+ * @brief Glyph cache of the built-in 8x8 latin font, the font map is transposed at compile time.
+ */
+static const ssd1306_glyph_cache_t ssd1306_latin_8x8_glyph_cache = {
+	.first_code	= 0,
+	.count		= FONT_LATIN_8x8_ROWS_SIZE,
+	.height		= 8,
+	.pages		= 1,
+	.max_width	= FONT_LATIN_8x8_COLS_SIZE,
+	.advance	= NULL,
+	.columns	= &font_latin_8x8_tr[0][0],
+	.allocated	= false
+};
 static const char *TAG = "ssd1306";
 
 /**
@@ -172,11 +225,226 @@ static inline esp_err_t ssd1306_i2c_write(ssd1306_device_t *const device, const
     ESP_ARG_CHECK( device );
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
+    ESP_RETURN_ON_ERROR( I2C_TRACE_TRANSMIT(device->i2c_handle, buffer, size, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, i2c write failed" );
                         
     return ESP_OK;
 }
 
+/**
+ * @brief Marks a segment range of a page as dirty, the dirty range of a page is 
+ * the union of all ranges marked since the page was last flushed.
+ * 
+ * @param device SSD1306 device descriptor.
+ * @param page Index of page.
+ * @param start First dirty segment.
+ * @param end Last dirty segment.
+ */
+static inline void ssd1306_mark_dirty(ssd1306_device_t *const device, const uint8_t page, const uint8_t start, const uint8_t end) {
+	if (device->dirty_start[page] == SSD1306_PAGE_CLEAN) {
+		device->dirty_start[page] = start;
+		device->dirty_end[page]   = end;
+	} else {
+		if (start < device->dirty_start[page]) device->dirty_start[page] = start;
+		if (end > device->dirty_end[page])     device->dirty_end[page]   = end;
+	}
+}
+
+/**
+ * @brief Marks every page of the display panel as dirty.
+ * 
+ * @param device SSD1306 device descriptor.
+ */
+static inline void ssd1306_mark_all_dirty(ssd1306_device_t *const device) {
+	for (uint8_t page = 0; page < device->pages; page++) {
+		device->dirty_start[page] = 0;
+		device->dirty_end[page]   = device->width - 1;
+	}
+}
+
+/**
+ * @brief Marks a segment range of a front buffer page as dirty.
+ * 
+ * @param device SSD1306 device descriptor.
+ * @param page Index of page.
+ * @param start First dirty segment.
+ * @param end Last dirty segment.
+ */
+static inline void ssd1306_mark_front_dirty(ssd1306_device_t *const device, const uint8_t page, const uint8_t start, const uint8_t end) {
+	if (device->front_dirty_start[page] == SSD1306_PAGE_CLEAN) {
+		device->front_dirty_start[page] = start;
+		device->front_dirty_end[page]   = end;
+	} else {
+		if (start < device->front_dirty_start[page]) device->front_dirty_start[page] = start;
+		if (end > device->front_dirty_end[page])     device->front_dirty_end[page]   = end;
+	}
+}
+
+/**
+ * @brief Writes segment data to a page window of the display RAM.  The page and 
+ * column addressing commands and the segment data are written in a single i2c 
+ * transaction from the preallocated transaction buffer.
+ * 
+ * @param device SSD1306 device descriptor.
+ * @param page Index of page.
+ * @param segment Index of first segment.
+ * @param data Segment data.
+ * @param width Number of segments.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ssd1306_write_window(ssd1306_device_t *const device, const uint8_t page, const uint8_t segment, const uint8_t *data, const uint8_t width) {
+	uint8_t _seg  = segment + device->config.offset_x;
+	uint8_t _page = page;
+	uint8_t out_index = 0;
+
+	if (device->config.flip_enabled) {
+		_page = (device->pages - page) - 1;
+	}
+
+	device->tx_buffer[out_index++] = SSD1306_CONTROL_BYTE_CMD_SINGLE;
+	// Set Lower Column Start Address for Page Addressing Mode
+	device->tx_buffer[out_index++] = (0x00 + (_seg & 0x0F));
+	device->tx_buffer[out_index++] = SSD1306_CONTROL_BYTE_CMD_SINGLE;
+	// Set Higher Column Start Address for Page Addressing Mode
+	device->tx_buffer[out_index++] = (0x10 + ((_seg >> 4) & 0x0F));
+	device->tx_buffer[out_index++] = SSD1306_CONTROL_BYTE_CMD_SINGLE;
+	// Set Page Start Address for Page Addressing Mode
+	device->tx_buffer[out_index++] = 0xB0 | _page;
+	device->tx_buffer[out_index++] = SSD1306_CONTROL_BYTE_DATA_STREAM;
+
+	memcpy(&device->tx_buffer[out_index], data, width);
+
+	return ssd1306_i2c_write(device, device->tx_buffer, out_index + width);
+}
+
+/**
+ * @brief Accumulates flush statistics for a frame.
+ * 
+ * @param device SSD1306 device descriptor.
+ * @param windows Number of page windows written.
+ * @param bytes Number of bytes written.
+ * @param elapsed_us Frame duration in micro-seconds.
+ */
+static inline void ssd1306_update_stats(ssd1306_device_t *const device, const uint32_t windows, const uint32_t bytes, const int64_t elapsed_us) {
+	if (windows == 0) return;
+
+	const float frame_ms = (float)elapsed_us / 1000.0f;
+
+	portENTER_CRITICAL(&device->stats_spinlock);
+	device->stats.frames++;
+	device->stats.windows += windows;
+	device->stats.bytes   += bytes;
+	device->stats_total_us += (uint64_t)elapsed_us;
+	device->stats.last_frame_ms    = frame_ms;
+	if (frame_ms > device->stats.max_frame_ms) device->stats.max_frame_ms = frame_ms;
+	device->stats.average_frame_ms = ((float)device->stats_total_us / 1000.0f) / (float)device->stats.frames;
+	portEXIT_CRITICAL(&device->stats_spinlock);
+}
+
+/**
+ * @brief Copies the dirty windows of the back buffer to the front buffer, dirty 
+ * ranges are merged with front buffer windows not yet flushed.
+ * 
+ * @param device SSD1306 device descriptor.
+ */
+static inline void ssd1306_copy_back_to_front(ssd1306_device_t *const device) {
+	xSemaphoreTake(device->front_mutex_handle, portMAX_DELAY);
+	for (uint8_t page = 0; page < device->pages; page++) {
+		if (device->dirty_start[page] == SSD1306_PAGE_CLEAN) continue;
+
+		const uint8_t start = device->dirty_start[page];
+		const uint8_t end   = device->dirty_end[page];
+
+		memcpy(&device->front_page[page].segment[start], &device->page[page].segment[start], end - start + 1);
+
+		ssd1306_mark_front_dirty(device, page, start, end);
+
+		device->dirty_start[page] = SSD1306_PAGE_CLEAN;
+	}
+	xSemaphoreGive(device->front_mutex_handle);
+}
+
+/**
+ * @brief Writes the dirty windows of the front buffer to the display panel.  The front 
+ * buffer is locked only while a window is copied to the transaction buffer, swaps are 
+ * not blocked by i2c transactions.
+ * 
+ * @param device SSD1306 device descriptor.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ssd1306_flush_front(ssd1306_device_t *const device) {
+	uint8_t  window[SSD1306_PAGE_SEGMENT_SIZE];
+	uint32_t windows = 0;
+	uint32_t bytes   = 0;
+	esp_err_t ret    = ESP_OK;
+	const int64_t start_time = esp_timer_get_time();
+
+	for (uint8_t page = 0; page < device->pages; page++) {
+		xSemaphoreTake(device->front_mutex_handle, portMAX_DELAY);
+		if (device->front_dirty_start[page] == SSD1306_PAGE_CLEAN) {
+			xSemaphoreGive(device->front_mutex_handle);
+			continue;
+		}
+		const uint8_t start = device->front_dirty_start[page];
+		const uint8_t width = device->front_dirty_end[page] - start + 1;
+		memcpy(window, &device->front_page[page].segment[start], width);
+		device->front_dirty_start[page] = SSD1306_PAGE_CLEAN;
+		xSemaphoreGive(device->front_mutex_handle);
+
+		ret = ssd1306_write_window(device, page, start, window, width);
+		if (ret != ESP_OK) {
+			/* window is written again with the next frame */
+			xSemaphoreTake(device->front_mutex_handle, portMAX_DELAY);
+			ssd1306_mark_front_dirty(device, page, start, start + width - 1);
+			xSemaphoreGive(device->front_mutex_handle);
+			break;
+		}
+
+		windows++;
+		bytes += SSD1306_WINDOW_HEADER_SIZE + width;
+	}
+
+	ssd1306_update_stats(device, windows, bytes, esp_timer_get_time() - start_time);
+
+	return ret;
+}
+
+/**
+ * @brief SSD1306 flush task entry, pushes the dirty windows of the front buffer when 
+ * notified by a swap, at most once per frame period.  Swaps notified while a frame 
+ * is pending are coalesced into the next frame.
+ * 
+ * @param pvParameters SSD1306 device descriptor.
+ */
+static void ssd1306_flush_task_entry(void *pvParameters) {
+	ssd1306_device_t *dev = (ssd1306_device_t*)pvParameters;
+	const int64_t frame_period_us = 1000000LL / dev->flush_config.max_frame_rate;
+	int64_t last_frame_time = esp_timer_get_time() - frame_period_us;
+
+	for ( ;; ) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		/* disable notifies after its final swap, the frame is flushed before stopping */
+		const bool stopping = (dev->flush_enabled == false);
+
+		/* limit frame rate, swaps during the delay are coalesced */
+		if (stopping == false) {
+			const int64_t wait_us = (last_frame_time + frame_period_us) - esp_timer_get_time();
+			if (wait_us > 0) vTaskDelay(pdMS_TO_TICKS((wait_us + 999) / 1000));
+		}
+
+		last_frame_time = esp_timer_get_time();
+
+		if (ssd1306_flush_front(dev) != ESP_OK) {
+			ESP_LOGE(TAG, "flush task failed to write front buffer");
+		}
+
+		if (stopping == true) break;
+	}
+
+	xSemaphoreGive(dev->flush_stopped_handle);
+	vTaskDelete( NULL );
+}
+
 esp_err_t ssd1306_get_panel_size(ssd1306_handle_t handle, ssd1306_panel_sizes_t *const panel_size) {
 	ssd1306_device_t *dev = (ssd1306_device_t*)handle;
 
@@ -334,6 +602,177 @@ esp_err_t ssd1306_display_bdf_code(ssd1306_handle_t handle, const uint8_t *font,
 	return ESP_OK;
 }
 
+esp_err_t ssd1306_create_glyph_cache(const uint8_t *font, uint8_t first_code, uint8_t last_code, ssd1306_glyph_cache_handle_t *const cache_handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( font && cache_handle && first_code <= last_code );
+
+	const uint8_t height = font[1];
+	if (height == 0 || height > SSD1306_PAGE_SEGMENT_SIZE) return ESP_ERR_INVALID_SIZE;
+
+	const uint16_t count = last_code - first_code + 1;
+	const uint8_t  pages = (height + 7) / 8;
+
+	/* cell width is the largest advance of the cached glyphs */
+	uint8_t max_width = 0;
+	for (int index = 2; font[index+6] != 0; index = index + font[index+6] + 9) {
+		if (font[index] < first_code || font[index] > last_code) continue;
+		if (font[index+1] > max_width) max_width = font[index+1];
+	}
+	if (max_width == 0) return ESP_ERR_NOT_FOUND;
+
+	ssd1306_glyph_cache_t *cache = (ssd1306_glyph_cache_t*)calloc(1, sizeof(ssd1306_glyph_cache_t));
+	if (cache == NULL) return ESP_ERR_NO_MEM;
+	uint8_t *advance = (uint8_t*)calloc(count, sizeof(uint8_t));
+	uint8_t *columns = (uint8_t*)calloc((size_t)count * pages * max_width, sizeof(uint8_t));
+	if (advance == NULL || columns == NULL) {
+		free(advance);
+		free(columns);
+		free(cache);
+		return ESP_ERR_NO_MEM;
+	}
+
+	/* pre-rotate bdf glyph rows (msb first) into page-major column bytes (lsb top) */
+	for (int index = 2; font[index+6] != 0; index = index + font[index+6] + 9) {
+		const uint8_t code = font[index];
+		if (code < first_code || code > last_code) continue;
+
+		const uint16_t glyph      = code - first_code;
+		const uint8_t  width      = font[index+1];
+		const uint8_t  y_start    = font[index+7];
+		const uint8_t  rows       = font[index+8] - y_start + 1;
+		const uint8_t  byte_width = font[index+6] / rows;
+		const uint8_t *bitmap     = &font[index+9];
+
+		advance[glyph] = width;
+
+		for (uint8_t row = 0; row < rows; row++) {
+			const uint8_t y = y_start + row;
+			if (y >= height) break;
+			uint8_t *const page_columns = &columns[((size_t)glyph * pages + (y / 8)) * max_width];
+			const uint8_t bit = 1 << (y % 8);
+			for (uint8_t x = 0; x < width && x < byte_width * 8; x++) {
+				if (bitmap[row * byte_width + x / 8] & (128 >> (x & 7))) page_columns[x] |= bit;
+			}
+		}
+	}
+
+	cache->first_code = first_code;
+	cache->count      = count;
+	cache->height     = height;
+	cache->pages      = pages;
+	cache->max_width  = max_width;
+	cache->advance    = advance;
+	cache->columns    = columns;
+	cache->allocated  = true;
+
+	*cache_handle = (ssd1306_glyph_cache_handle_t)cache;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_get_latin_8x8_glyph_cache(ssd1306_glyph_cache_handle_t *const cache_handle) {
+	/* validate parameters */
+	ESP_ARG_CHECK( cache_handle );
+
+	*cache_handle = (ssd1306_glyph_cache_handle_t)&ssd1306_latin_8x8_glyph_cache;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_delete_glyph_cache(ssd1306_glyph_cache_handle_t cache_handle) {
+	ssd1306_glyph_cache_t *cache = (ssd1306_glyph_cache_t*)cache_handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( cache );
+
+	/* built-in glyph caches are not allocated */
+	if (cache->allocated == false) return ESP_OK;
+
+	free((void*)cache->advance);
+	free((void*)cache->columns);
+	free(cache);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_set_glyph_text(ssd1306_handle_t handle, ssd1306_glyph_cache_handle_t cache_handle, uint8_t xpos, uint8_t ypos, const char *text, bool invert) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+	const ssd1306_glyph_cache_t *cache = (const ssd1306_glyph_cache_t*)cache_handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev && cache && text );
+
+	if (xpos >= dev->width || ypos >= dev->height) return ESP_ERR_INVALID_SIZE;
+
+	const uint8_t first_page = ypos / 8;
+	const uint8_t shift      = ypos % 8;
+	uint8_t dirty_start[16];
+	uint8_t dirty_end[16];
+	uint16_t x = xpos;
+
+	memset(dirty_start, SSD1306_PAGE_CLEAN, sizeof(dirty_start));
+
+	for (const char *ch = text; *ch != '\0' && x < dev->width; ch++) {
+		const uint16_t glyph = (uint8_t)*ch - cache->first_code;
+		if ((uint8_t)*ch < cache->first_code || glyph >= cache->count) continue;
+
+		uint8_t width = (cache->advance == NULL) ? cache->max_width : cache->advance[glyph];
+		if (width == 0) continue;
+		if (x + width > dev->width) width = dev->width - x;
+
+		for (uint8_t glyph_page = 0; glyph_page < cache->pages; glyph_page++) {
+			/* cell rows of the glyph page, shifted into the low and high destination pages */
+			const uint8_t rows = cache->height - glyph_page * 8;
+			const uint8_t mask = (rows >= 8) ? 0xff : (uint8_t)((1 << rows) - 1);
+			const uint8_t *const src = &cache->columns[((size_t)glyph * cache->pages + glyph_page) * cache->max_width];
+
+			for (uint8_t half = 0; half < ((shift == 0) ? 1 : 2); half++) {
+				const uint8_t page = first_page + glyph_page + half;
+				if (page >= dev->pages) break;
+
+				uint8_t dst_mask = (half == 0) ? (uint8_t)(mask << shift) : (uint8_t)(mask >> (8 - shift));
+				if (dst_mask == 0) continue;
+				if (dev->config.flip_enabled) dst_mask = ssd1306_rotate_byte(dst_mask);
+
+				uint8_t *const dst = &dev->page[page].segment[x];
+
+				for (uint8_t col = 0; col < width; col++) {
+					uint8_t bits = invert ? (uint8_t)~src[col] : src[col];
+					bits = (half == 0) ? (uint8_t)(bits << shift) : (uint8_t)(bits >> (8 - shift));
+					if (dev->config.flip_enabled) bits = ssd1306_rotate_byte(bits);
+
+					const uint8_t value = (dst[col] & ~dst_mask) | (bits & dst_mask);
+					if (dst[col] == value) continue;
+					dst[col] = value;
+
+					if (dirty_start[page] == SSD1306_PAGE_CLEAN) dirty_start[page] = x + col;
+					dirty_end[page] = x + col;
+				}
+			}
+		}
+
+		x = x + width;
+	}
+
+	/* only columns that changed are marked dirty */
+	for (uint8_t page = 0; page < dev->pages; page++) {
+		if (dirty_start[page] != SSD1306_PAGE_CLEAN) ssd1306_mark_dirty(dev, page, dirty_start[page], dirty_end[page]);
+	}
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_display_glyph_text(ssd1306_handle_t handle, ssd1306_glyph_cache_handle_t cache_handle, uint8_t xpos, uint8_t ypos, const char *text, bool invert) {
+	/* validate parameters */
+	ESP_ARG_CHECK( handle );
+
+	ESP_RETURN_ON_ERROR(ssd1306_set_glyph_text(handle, cache_handle, xpos, ypos, text, invert), TAG, "set glyph text for display glyph text failed");
+
+	ESP_RETURN_ON_ERROR(ssd1306_display_pages(handle), TAG, "display pages for display glyph text failed");
+
+	return ESP_OK;
+}
+
 esp_err_t ssd1306_set_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos, bool invert) {
 	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
 
@@ -368,7 +807,10 @@ esp_err_t ssd1306_set_pixel(ssd1306_handle_t handle, uint8_t xpos, uint8_t ypos,
 
 	ESP_LOGD(TAG, "wk0=0x%02x wk1=0x%02x", wk0, wk1);
 
-	dev->page[_page].segment[_seg] = wk0;
+	if (dev->page[_page].segment[_seg] != wk0) {
+		dev->page[_page].segment[_seg] = wk0;
+		ssd1306_mark_dirty(dev, _page, _seg, _seg);
+	}
 
 	return ESP_OK;
 }
@@ -674,16 +1116,166 @@ esp_err_t ssd1306_display_pages(ssd1306_handle_t handle) {
 	/* validate parameters */
 	ESP_ARG_CHECK( dev );
 
+	/* asynchronous flush, the flush task writes the display panel */
+	if (dev->flush_enabled == true) return ssd1306_swap_buffers(handle);
+
+	uint32_t windows = 0;
+	uint32_t bytes   = 0;
+	const int64_t start_time = esp_timer_get_time();
+
 	for (uint8_t page = 0; page < dev->pages; page++) {
-		ESP_RETURN_ON_ERROR(ssd1306_display_image(handle, page, 0, dev->page[page].segment, dev->width), TAG, "show buffer failed (page %d)", page);
+		if (dev->dirty_start[page] == SSD1306_PAGE_CLEAN) continue;
+
+		const uint8_t start = dev->dirty_start[page];
+		const uint8_t width = dev->dirty_end[page] - start + 1;
+
+		ESP_RETURN_ON_ERROR(ssd1306_write_window(dev, page, start, &dev->page[page].segment[start], width), TAG, "show buffer failed (page %d)", page);
+
+		dev->dirty_start[page] = SSD1306_PAGE_CLEAN;
+
+		windows++;
+		bytes += SSD1306_WINDOW_HEADER_SIZE + width;
 	}
 
+	ssd1306_update_stats(dev, windows, bytes, esp_timer_get_time() - start_time);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_enable_async_flush(ssd1306_handle_t handle, const ssd1306_flush_config_t *flush_config) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+	esp_err_t ret = ESP_OK;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev && flush_config && flush_config->max_frame_rate > 0 );
+
+	if (dev->flush_enabled == true) return ESP_ERR_INVALID_STATE;
+
+	dev->flush_config = *flush_config;
+
+	/* front buffer starts as a copy of the back buffer, pending back buffer windows are flushed with the first swap */
+	dev->front_page = (ssd1306_page_t*)calloc(dev->pages, sizeof(ssd1306_page_t));
+	ESP_GOTO_ON_FALSE(dev->front_page, ESP_ERR_NO_MEM, err, TAG, "no memory for ssd1306 front buffer, enable async flush failed");
+	memcpy(dev->front_page, dev->page, dev->pages * sizeof(ssd1306_page_t));
+	memset(dev->front_dirty_start, SSD1306_PAGE_CLEAN, sizeof(dev->front_dirty_start));
+
+	dev->front_mutex_handle = xSemaphoreCreateMutex();
+	ESP_GOTO_ON_FALSE(dev->front_mutex_handle, ESP_ERR_NO_MEM, err_front, TAG, "create front buffer mutex failed");
+
+	dev->flush_stopped_handle = xSemaphoreCreateBinary();
+	ESP_GOTO_ON_FALSE(dev->flush_stopped_handle, ESP_ERR_NO_MEM, err_mutex, TAG, "create flush stopped semaphore failed");
+
+	dev->flush_enabled = true;
+
+	BaseType_t task_err = xTaskCreatePinnedToCore( 
+        ssd1306_flush_task_entry, 
+        SSD1306_FLUSH_TASK_NAME, 
+        SSD1306_FLUSH_TASK_STACK_SIZE, 
+        dev, 
+        dev->flush_config.task_priority,
+        &dev->flush_task_handle, 
+        tskNO_AFFINITY );
+	ESP_GOTO_ON_FALSE(task_err == pdPASS, ESP_ERR_NO_MEM, err_task, TAG, "create ssd1306 flush task failed");
+
+	return ESP_OK;
+
+	err_task:
+		dev->flush_enabled = false;
+		vSemaphoreDelete(dev->flush_stopped_handle);
+	err_mutex:
+		vSemaphoreDelete(dev->front_mutex_handle);
+	err_front:
+		free(dev->front_page);
+		dev->front_page = NULL;
+	err:
+		return ret;
+}
+
+esp_err_t ssd1306_disable_async_flush(ssd1306_handle_t handle) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev );
+
+	if (dev->flush_enabled == false) return ESP_OK;
+
+	/* flush task writes pending windows and stops */
+	ssd1306_copy_back_to_front(dev);
+	dev->flush_enabled = false;
+	xTaskNotifyGive(dev->flush_task_handle);
+	xSemaphoreTake(dev->flush_stopped_handle, portMAX_DELAY);
+
+	vSemaphoreDelete(dev->flush_stopped_handle);
+	vSemaphoreDelete(dev->front_mutex_handle);
+	free(dev->front_page);
+	dev->flush_task_handle    = NULL;
+	dev->flush_stopped_handle = NULL;
+	dev->front_mutex_handle   = NULL;
+	dev->front_page           = NULL;
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_swap_buffers(ssd1306_handle_t handle) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev );
+
+	if (dev->flush_enabled == false) return ESP_ERR_INVALID_STATE;
+
+	ssd1306_copy_back_to_front(dev);
+
+	portENTER_CRITICAL(&dev->stats_spinlock);
+	dev->stats.swaps++;
+	portEXIT_CRITICAL(&dev->stats_spinlock);
+
+	xTaskNotifyGive(dev->flush_task_handle);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_get_flush_stats(ssd1306_handle_t handle, ssd1306_flush_stats_t *const stats) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev && stats );
+
+	portENTER_CRITICAL(&dev->stats_spinlock);
+	*stats = dev->stats;
+	portEXIT_CRITICAL(&dev->stats_spinlock);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_reset_flush_stats(ssd1306_handle_t handle) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev );
+
+	portENTER_CRITICAL(&dev->stats_spinlock);
+	memset(&dev->stats, 0, sizeof(ssd1306_flush_stats_t));
+	dev->stats_total_us = 0;
+	portEXIT_CRITICAL(&dev->stats_spinlock);
+
+	return ESP_OK;
+}
+
+esp_err_t ssd1306_invalidate_pages(ssd1306_handle_t handle) {
+	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
+
+	/* validate parameters */
+	ESP_ARG_CHECK( dev );
+
+	ssd1306_mark_all_dirty(dev);
+
 	return ESP_OK;
 }
 
 esp_err_t ssd1306_set_pages(ssd1306_handle_t handle, uint8_t *buffer) {
 	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
-	uint8_t index = 0;
+	uint16_t index = 0;
 
 	/* validate parameters */
 	ESP_ARG_CHECK( dev );
@@ -693,12 +1285,14 @@ esp_err_t ssd1306_set_pages(ssd1306_handle_t handle, uint8_t *buffer) {
 		index = index + 128;
 	}
 
+	ssd1306_mark_all_dirty(dev);
+
 	return ESP_OK;
 }
 
 esp_err_t ssd1306_get_pages(ssd1306_handle_t handle, uint8_t *buffer) {
 	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
-	uint8_t index = 0;
+	uint16_t index = 0;
 
 	/* validate parameters */
 	ESP_ARG_CHECK( dev );
@@ -786,6 +1380,7 @@ esp_err_t ssd1306_display_bitmap__(ssd1306_handle_t handle, uint8_t xpos, uint8_
 			}
 		}
 		vTaskDelay(1);
+		ssd1306_mark_dirty(dev, page, xpos, _seg - 1);
 		offset = offset + _width;
 		dstBits++;
 		_seg = xpos;
@@ -802,57 +1397,38 @@ esp_err_t ssd1306_display_bitmap__(ssd1306_handle_t handle, uint8_t xpos, uint8_
 
 esp_err_t ssd1306_display_image(ssd1306_handle_t handle, uint8_t page, uint8_t segment, const uint8_t *image, uint8_t width) {
 	ssd1306_device_t* dev = (ssd1306_device_t*)handle;
-	esp_err_t ret = ESP_OK;
 
 	/* validate parameters */
-	ESP_ARG_CHECK( dev );
+	ESP_ARG_CHECK( dev && image );
 
 	if (page >= dev->pages) return ESP_ERR_INVALID_SIZE;
 	if (segment >= dev->width) return ESP_ERR_INVALID_SIZE;
+	if ((uint16_t)segment + width > dev->width) return ESP_ERR_INVALID_SIZE;
+	if (width == 0) return ESP_OK;
 
-	uint8_t _seg = segment + dev->config.offset_x;
-	uint8_t columLow = _seg & 0x0F;
-	uint8_t columHigh = (_seg >> 4) & 0x0F;
-
-	uint8_t _page = page;
-	if (dev->config.flip_enabled) {
-		_page = (dev->pages - page) - 1;
+	/* asynchronous flush, image is written to the back buffer and swapped */
+	if (dev->flush_enabled == true) {
+		if (image != &dev->page[page].segment[segment]) {
+			memmove(&dev->page[page].segment[segment], image, width);
+		}
+		ssd1306_mark_dirty(dev, page, segment, segment + width - 1);
+		return ssd1306_swap_buffers(handle);
 	}
 
-	uint8_t *out_buf;
-	out_buf = malloc(width < 4 ? 4 : width + 1);
-	if (out_buf == NULL) {
-		ESP_LOGE(TAG, "malloc for image display failed");
-		return ESP_ERR_NO_MEM;
-	}
-
-	uint8_t out_index = 0;
-	out_buf[out_index++] = SSD1306_CONTROL_BYTE_CMD_STREAM;
-	// Set Lower Column Start Address for Page Addressing Mode
-	out_buf[out_index++] = (0x00 + columLow);
-	// Set Higher Column Start Address for Page Addressing Mode
-	out_buf[out_index++] = (0x10 + columHigh);
-	// Set Page Start Address for Page Addressing Mode
-	out_buf[out_index++] = 0xB0 | _page;
-
-	ESP_GOTO_ON_ERROR(ssd1306_i2c_write(dev, out_buf, out_index), err, TAG, "write page addressing mode for image display failed");
-
-	out_buf[0] = SSD1306_CONTROL_BYTE_DATA_STREAM;
-
-	memcpy(&out_buf[1], image, width);
-
-
-	ESP_GOTO_ON_ERROR(ssd1306_i2c_write(dev, out_buf, width + 1), err, TAG, "write image for image display failed");
-
-	free(out_buf);
+	ESP_RETURN_ON_ERROR(ssd1306_write_window(dev, page, segment, image, width), TAG, "write image for image display failed");
 
 	// Set to internal buffer
-	memcpy(&dev->page[page].segment[segment], image, width);
+	if (image != &dev->page[page].segment[segment]) {
+		memmove(&dev->page[page].segment[segment], image, width);
+	}
 
-	return ESP_OK;
+	// Window on display matches internal buffer, page is clean when the dirty range is inside the window
+	if (dev->dirty_start[page] != SSD1306_PAGE_CLEAN && 
+		dev->dirty_start[page] >= segment && dev->dirty_end[page] <= segment + width - 1) {
+		dev->dirty_start[page] = SSD1306_PAGE_CLEAN;
+	}
 
-	err:
-		return ret;
+	return ESP_OK;
 }
 
 esp_err_t ssd1306_display_text(ssd1306_handle_t handle, uint8_t page, const char *text, bool invert) {
@@ -1414,6 +1990,8 @@ esp_err_t ssd1306_display_wrap_around(ssd1306_handle_t handle, ssd1306_scroll_ty
 			ESP_RETURN_ON_ERROR(ssd1306_display_image(handle, page, 0, dev->page[page].segment, 128), TAG, "display image for wrap around failed");
 			if (delay) vTaskDelay(delay / portTICK_PERIOD_MS);;
 		}
+	} else {
+		ssd1306_mark_all_dirty(dev);
 	}
 
 	return ESP_OK;
@@ -1565,6 +2143,7 @@ esp_err_t ssd1306_init(i2c_master_bus_handle_t master_handle, const ssd1306_conf
 	/* validate device handle */
     if (dev->i2c_handle == NULL) {
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(master_handle, &i2c_dev_conf, &dev->i2c_handle), err_handle, TAG, "i2c new bus for init failed");
+        I2C_TRACE_ADD_DEVICE(dev->i2c_handle, "ssd1306", i2c_dev_conf.device_address);
     }
 
     /* set panel properties */
@@ -1572,10 +2151,14 @@ esp_err_t ssd1306_init(i2c_master_bus_handle_t master_handle, const ssd1306_conf
 	dev->height = ssd1306_panel_properties[dev->config.panel_size].height;
 	dev->pages  = ssd1306_panel_properties[dev->config.panel_size].pages;
 
-    /* initialize page and segment buffer */
+	/* initialize flush statistics spinlock */
+	portMUX_INITIALIZE(&dev->stats_spinlock);
+
+    /* initialize page and segment buffer, display ram content is undefined after power-up */
 	for (uint8_t i = 0; i < dev->pages; i++) {
 		memset(dev->page[i].segment, 0, SSD1306_PAGE_SEGMENT_SIZE);
 	}
+	ssd1306_mark_all_dirty(dev);
 
 	/* attempt to setup display */
 	ESP_GOTO_ON_ERROR(ssd1306_setup(dev), err_handle, TAG, "panel setup for init failed");
@@ -1587,6 +2170,7 @@ esp_err_t ssd1306_init(i2c_master_bus_handle_t master_handle, const ssd1306_conf
 
     err_handle:
         if (dev && dev->i2c_handle) {
+            I2C_TRACE_REMOVE_DEVICE(dev->i2c_handle);
             i2c_master_bus_rm_device(dev->i2c_handle);
         }
         free(dev);
@@ -1600,6 +2184,7 @@ esp_err_t ssd1306_remove(ssd1306_handle_t handle) {
 	/* validate parameters */
 	ESP_ARG_CHECK( dev );
 
+    I2C_TRACE_REMOVE_DEVICE(dev->i2c_handle);
     return i2c_master_bus_rm_device(dev->i2c_handle);
 }
 
@@ -1607,6 +2192,9 @@ esp_err_t ssd1306_delete(ssd1306_handle_t handle) {
 	/* validate arguments */
     ESP_ARG_CHECK( handle );
 
+	/* stop asynchronous flush task */
+	ESP_RETURN_ON_ERROR( ssd1306_disable_async_flush(handle), TAG, "unable to stop flush task, delete handle failed" );
+
     /* remove device from master bus */
     ESP_RETURN_ON_ERROR( ssd1306_remove(handle), TAG, "unable to remove device from i2c master bus, delete handle failed" );
 
@@ -41,6 +41,7 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <nvs.h>
 
 #include <onewire_cmd.h>
 #include <onewire_crc.h>
@@ -57,16 +58,20 @@
 #define DS18B20_CMD_POWER_SUPPLY_READ   UINT8_C(0xB4)   /*!< determine if a device is using parasitic power */
 
 #define DS18B20_DEVICE_MAX              UINT16_C(10)    /*!< maximum number of ds18b20 devices on the 1-wire bus */
+#define DS18B20_TX_DATA_SIZE_MAX        UINT8_C(3)      /*!< maximum size of command data written to the ds18b20, i.e. scratchpad write */
+#define DS18B20_NVS_NAMESPACE           "ds18b20"       /*!< nvs namespace of the cached ds18b20 rom ids */
 
 #define DS18B20_POWERUP_DELAY_MS        UINT16_C(20)
 #define DS18B20_RESET_DELAY_MS          UINT16_C(25)
 #define DS18B20_APPSTART_DELAY_MS       UINT16_C(10)    /*!< ds18b20 delay after initialization before application start-up */
 #define DS18B20_EEPROM_WRITE_DELAY_MS   UINT16_C(15)
+#define DS18B20_CONVERSION_POLL_DELAY_MS UINT16_C(10)   /*!< ds18b20 delay between read time slots while polling a temperature conversion */
 
 
 /*
  * macro definitions
 */
+#define ESP_TIMEOUT_CHECK(start, len) ((uint64_t)(esp_timer_get_time() - (start)) >= (len))
 #define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
 
 /**
@@ -76,6 +81,7 @@ typedef struct ds18b20_device_s {
     ds18b20_config_t          config;       /*!< ds18b20 device configuration */
     onewire_bus_handle_t      owb_handle;   /*!< ds18b20 1-wire bus handle */
     onewire_device_address_t  owb_address;  /*!< ds18b20 1-wire device address */
+    bool                      parasitic;    /*!< ds18b20 is parasitic-powered when true, read at initialization */
 } ds18b20_device_t;
 
 /*
@@ -83,6 +89,9 @@ typedef struct ds18b20_device_s {
 */
 static const char *TAG = "ds18b20";
 
+/* maximum temperature conversion times by resolution (9, 10, 11, 12 bit) */
+static const uint16_t ds18b20_conversion_times_ms[] = { 100, 200, 400, 800 };
+
 /**
  * @brief Checks scratchpad to determine if it is valid.
  * 
@@ -100,28 +109,125 @@ static inline bool ds18b20_validate_scratchpad(const ds18b20_scratchpad_t scratc
 }
 
 /**
- * @brief Writes command to DS18B20.
+ * @brief Resets the 1-wire bus and writes command, with optional command data, to DS18B20 (MATCH ROM) in a single 
+ * 1-wire bus transaction.  The response of the DS18B20 is read into the receive buffer when provided.
  * 
- * @param handle DS18B20 device handle.
+ * @param owb_handle 1-wire bus handle.
+ * @param address DS18B20 1-wire device address.
  * @param cmd DS18B20 command value.
+ * @param tx_data DS18B20 command data to write, can be NULL if tx_data_size is 0.
+ * @param tx_data_size DS18B20 command data size in bytes.
+ * @param rx_buf DS18B20 response buffer, can be NULL if rx_buf_size is 0.
+ * @param rx_buf_size DS18B20 response size in bytes.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t ds18b20_send_command(ds18b20_device_t *const device, const uint8_t cmd) {
+static inline esp_err_t ds18b20_transaction(onewire_bus_handle_t owb_handle, const onewire_device_address_t address, const uint8_t cmd, 
+                                            const uint8_t *tx_data, const uint8_t tx_data_size, uint8_t *rx_buf, const size_t rx_buf_size) {
     /* validate arguments */
-    ESP_ARG_CHECK( device );
+    ESP_ARG_CHECK( owb_handle && tx_data_size <= DS18B20_TX_DATA_SIZE_MAX );
 
-    // build command
-    uint8_t tx_buffer[10] = {0};
+    // build command: rom command, rom id, device command and command data
+    uint8_t tx_buffer[sizeof(address) + 2 + DS18B20_TX_DATA_SIZE_MAX] = {0};
     tx_buffer[0] = ONEWIRE_CMD_MATCH_ROM;
-    memcpy(&tx_buffer[1], &device->owb_address, sizeof(device->owb_address));
-    tx_buffer[sizeof(device->owb_address) + 1] = cmd;
+    memcpy(&tx_buffer[1], &address, sizeof(address));
+    tx_buffer[sizeof(address) + 1] = cmd;
+    if(tx_data_size > 0) memcpy(&tx_buffer[sizeof(address) + 2], tx_data, tx_data_size);
+
+    /* reset bus, write command and read response */
+    ESP_RETURN_ON_ERROR( onewire_bus_transaction(owb_handle, tx_buffer, sizeof(address) + 2 + tx_data_size, rx_buf, rx_buf_size), TAG, "unable to complete 1-wire transaction, transaction failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Reads scratchpad from DS18B20, reset, MATCH ROM, read scratchpad command and 9-byte scratchpad in a single
+ * 1-wire bus transaction.  The scratchpad crc is not validated.
+ * 
+ * @param owb_handle 1-wire bus handle.
+ * @param address DS18B20 1-wire device address.
+ * @param scratchpad DS18B20 scratchpad structure.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ds18b20_read_scratchpad(onewire_bus_handle_t owb_handle, const onewire_device_address_t address, ds18b20_scratchpad_t *const scratchpad) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scratchpad );
 
-    /* write command */
-    ESP_RETURN_ON_ERROR( onewire_bus_write_bytes(device->owb_handle, tx_buffer, sizeof(tx_buffer)), TAG, "unable to write bytes, send command failed" );
+    /* read scratchpad */
+    ESP_RETURN_ON_ERROR( ds18b20_transaction(owb_handle, address, DS18B20_CMD_SCRATCHPAD_READ, NULL, 0, (uint8_t *)scratchpad, sizeof(ds18b20_scratchpad_t)), TAG, "unable to read scratchpad, read scratchpad failed" );
 
     return ESP_OK;
 }
 
+/**
+ * @brief Checks scratchpad read from DS18B20 against its crc.
+ * 
+ * @param scratchpad DS18B20 scratchpad structure.
+ * @return bool DS18B20 scratchpad crc is valid when true.
+ */
+static inline bool ds18b20_validate_scratchpad_crc(const ds18b20_scratchpad_t *const scratchpad) {
+    return onewire_crc8(0, (uint8_t *)scratchpad, 8) == scratchpad->crc;
+}
+
+/**
+ * @brief Resets the 1-wire bus and writes command to all DS18B20 devices on the 1-wire bus (SKIP ROM) in a single 
+ * 1-wire bus transaction.
+ * 
+ * @param owb_handle 1-wire bus handle.
+ * @param cmd DS18B20 command value.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t ds18b20_send_bus_command(onewire_bus_handle_t owb_handle, const uint8_t cmd) {
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle );
+
+    // build command
+    const uint8_t tx_buffer[] = { ONEWIRE_CMD_SKIP_ROM, cmd };
+
+    /* reset bus and write command */
+    ESP_RETURN_ON_ERROR( onewire_bus_transaction(owb_handle, tx_buffer, sizeof(tx_buffer), NULL, 0), TAG, "unable to complete 1-wire transaction, send bus command failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Waits for the temperature conversion in progress to complete.  Read time slots are polled when the 
+ * devices are externally powered, converting devices hold the bus low during a read time slot and the bus reads 1
+ * once every addressed device has completed.  Parasitic-powered devices draw the conversion current from the bus, 
+ * a read time slot would pull the bus low and starve the conversion, the maximum conversion time is waited instead.
+ * 
+ * @param owb_handle 1-wire bus handle.
+ * @param resolution DS18B20 temperature conversion resolution setting, sets the conversion timeout.
+ * @param parasitic Addressed devices include a parasitic-powered device when true.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when the conversion did not complete in time.
+ */
+static inline esp_err_t ds18b20_wait_for_conversion(onewire_bus_handle_t owb_handle, const ds18b20_resolutions_t resolution, const bool parasitic) {
+    const uint64_t start_time = esp_timer_get_time();
+    uint8_t        completed  = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle );
+
+    /* delay for the maximum temperature conversion time when parasitic-powered - based on resolution setting */
+    if(parasitic == true) {
+        vTaskDelay(pdMS_TO_TICKS(ds18b20_conversion_times_ms[resolution]));
+
+        return ESP_OK;
+    }
+
+    /* poll read time slots until conversion completes or timeout */
+    do {
+        /* delay before next read time slot */
+        vTaskDelay(pdMS_TO_TICKS(DS18B20_CONVERSION_POLL_DELAY_MS));
+
+        /* attempt to read time slot */
+        ESP_RETURN_ON_ERROR( onewire_bus_read_bit(owb_handle, &completed), TAG, "unable to read bit, wait for conversion failed" );
+
+        if(completed) return ESP_OK;
+    } while(!ESP_TIMEOUT_CHECK(start_time, (uint64_t)ds18b20_conversion_times_ms[resolution] * 1000));
+
+    return ESP_ERR_TIMEOUT;
+}
+
 bool ds18b20_validate_address(const onewire_device_address_t address) {
     /* validate device address is a ds18b20, the family code of DS18B20 is 0x28 */
     if ((address & 0xFF) == 0x28) return true;
@@ -164,24 +270,101 @@ esp_err_t ds18b20_detect(onewire_bus_handle_t owb_handle, onewire_device_t *cons
     return ESP_OK;
 }
 
+esp_err_t ds18b20_detect_cached(onewire_bus_handle_t owb_handle, const char *nvs_key, onewire_device_t *const devices, const uint8_t device_size, uint8_t *const device_count) {
+    esp_err_t                ret = ESP_OK;
+    onewire_device_address_t addresses[DS18B20_DEVICE_MAX];
+    size_t                   addresses_size = sizeof(addresses);
+    nvs_handle_t             nvs_hdl;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle && nvs_key && devices && device_count );
+
+    /* validate size of array */
+    ESP_RETURN_ON_FALSE( device_size <= DS18B20_DEVICE_MAX, ESP_ERR_INVALID_SIZE, TAG, "maximum number of devices that can be detected is 10, ds18b20 device detect cached failed" );
+
+    /* open nvs namespace, detect devices without the rom id cache when nvs is not available */
+    if(nvs_open(DS18B20_NVS_NAMESPACE, NVS_READWRITE, &nvs_hdl) != ESP_OK) {
+        ESP_LOGW(TAG, "unable to open nvs namespace, ds18b20 rom id cache is disabled");
+        return ds18b20_detect(owb_handle, devices, device_size, device_count);
+    }
+
+    /* read cached rom ids */
+    if(nvs_get_blob(nvs_hdl, nvs_key, addresses, &addresses_size) == ESP_OK && addresses_size > 0 &&
+        addresses_size % sizeof(onewire_device_address_t) == 0 && addresses_size / sizeof(onewire_device_address_t) <= device_size) {
+        const uint8_t cached_count = addresses_size / sizeof(onewire_device_address_t);
+        uint8_t       index;
+
+        /* verify presence of each cached ds18b20, one scratchpad read transaction per device */
+        for(index = 0; index < cached_count; index++) {
+            ds18b20_scratchpad_t scratchpad;
+            if(ds18b20_validate_address(addresses[index]) == false ||
+                ds18b20_read_scratchpad(owb_handle, addresses[index], &scratchpad) != ESP_OK ||
+                ds18b20_validate_scratchpad(scratchpad) == false || ds18b20_validate_scratchpad_crc(&scratchpad) == false) {
+                ESP_LOGW(TAG, "cached ds18b20 %016llX is not present, ds18b20 rom id cache is invalid", addresses[index]);
+                break;
+            }
+            devices[index].bus     = owb_handle;
+            devices[index].address = addresses[index];
+        }
+
+        /* cache hit, every cached ds18b20 is present */
+        if(index == cached_count) {
+            *device_count = cached_count;
+            nvs_close(nvs_hdl);
+            return ESP_OK;
+        }
+    }
+
+    /* cache miss, search the 1-wire bus */
+    ESP_GOTO_ON_ERROR( ds18b20_detect(owb_handle, devices, device_size, device_count), err, TAG, "unable to detect devices, ds18b20 device detect cached failed" );
+
+    /* update cached rom ids, an update failure only costs a rom search on the next boot */
+    for(uint8_t i = 0; i < *device_count; i++) {
+        addresses[i] = devices[i].address;
+    }
+    if(*device_count == 0 || nvs_set_blob(nvs_hdl, nvs_key, addresses, *device_count * sizeof(onewire_device_address_t)) != ESP_OK || nvs_commit(nvs_hdl) != ESP_OK) {
+        ESP_LOGW(TAG, "unable to update ds18b20 rom id cache");
+    }
+
+    err:
+        nvs_close(nvs_hdl);
+        return ret;
+}
+
+esp_err_t ds18b20_clear_detect_cache(const char *nvs_key) {
+    nvs_handle_t nvs_hdl;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( nvs_key );
+
+    /* open nvs namespace */
+    ESP_RETURN_ON_ERROR( nvs_open(DS18B20_NVS_NAMESPACE, NVS_READWRITE, &nvs_hdl), TAG, "unable to open nvs namespace, clear detect cache failed" );
+
+    /* erase cached rom ids */
+    esp_err_t ret = nvs_erase_key(nvs_hdl, nvs_key);
+    if(ret == ESP_OK) {
+        ret = nvs_commit(nvs_hdl);
+    } else if(ret == ESP_ERR_NVS_NOT_FOUND) {
+        ret = ESP_OK;
+    }
+
+    nvs_close(nvs_hdl);
+
+    return ret;
+}
+
 esp_err_t ds18b20_connected(ds18b20_handle_t handle, bool *const connected) {
     ds18b20_device_t* dev = (ds18b20_device_t*)handle;
 
     /* validate arguments */
     ESP_ARG_CHECK( handle );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, connected failed" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "unable to send OWB_DS18B20_CMD_SCRATCHPAD_READ command, connected failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "unable to read scratchpad data, connected failed" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "unable to read scratchpad data, connected failed" );
 
     // validate scratchpad and crc
-    if(ds18b20_validate_scratchpad(scratchpad) == true && onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc) {
+    if(ds18b20_validate_scratchpad(scratchpad) == true && ds18b20_validate_scratchpad_crc(&scratchpad) == true) {
         *connected = true;
     } else {
         *connected = false;
@@ -206,6 +389,9 @@ esp_err_t ds18b20_init(onewire_device_t *device, const ds18b20_config_t *ds18b20
     dev->owb_address = device->address;
     dev->config      = *ds18b20_config;
 
+    /* read power supply mode, parasitic-powered devices can not be polled while converting */
+    ESP_RETURN_ON_ERROR( ds18b20_get_power_supply_mode((ds18b20_handle_t)dev, &dev->parasitic), TAG, "unable to read power supply mode, ds18b20 device handle initialization failed" );
+
     /* set temperature resolution */
     ESP_RETURN_ON_ERROR( ds18b20_set_resolution((ds18b20_handle_t)dev, dev->config.resolution), TAG, "unable to write temperature resolution, ds18b20 device handle initialization failed" );
 
@@ -242,18 +428,12 @@ esp_err_t ds18b20_get_measurement(ds18b20_handle_t handle, float *const temperat
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "reset bus error" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "send DS18B20_CMD_READ_SCRATCHPAD failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "error while reading scratchpad data" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "error while reading scratchpad data" );
 
     // validate crc
-    ESP_RETURN_ON_FALSE( onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
+    ESP_RETURN_ON_FALSE( ds18b20_validate_scratchpad_crc(&scratchpad), ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
 
     // combine the MSB and LSB into a signed 16-bit integer
     int16_t temperature_raw = (((int16_t)scratchpad.temp_msb) << 8) | scratchpad.temp_lsb;
@@ -286,17 +466,106 @@ esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, trigger temperature conversion failed" );
+    // send command: DS18B20_CMD_CONVERT_TEMP, the bus reset checks if the ds18b20 is present
+    ESP_RETURN_ON_ERROR( ds18b20_transaction(dev->owb_handle, dev->owb_address, DS18B20_CMD_TEMP_CONVERT, NULL, 0, NULL, 0), TAG, "unable to send DS18B20_CMD_CONVERT_TEMP command, trigger temperature conversion failed" );
+
+    // wait for temperature conversion - timeout based on resolution setting
+    ESP_RETURN_ON_ERROR( ds18b20_wait_for_conversion(dev->owb_handle, dev->config.resolution, dev->parasitic), TAG, "unable to wait for temperature conversion, trigger temperature conversion failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_trigger_bus_temperature_conversion(onewire_bus_handle_t owb_handle, const ds18b20_resolutions_t resolution) {
+    bool parasitic = false;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle );
+
+    // read power supply mode of the devices, a parasitic-powered device on the bus can not be polled while converting
+    ESP_RETURN_ON_ERROR( ds18b20_get_bus_power_supply_mode(owb_handle, &parasitic), TAG, "unable to read bus power supply mode, trigger bus temperature conversion failed" );
+
+    // broadcast command: DS18B20_CMD_CONVERT_TEMP, the bus reset checks if devices are present
+    ESP_RETURN_ON_ERROR( ds18b20_send_bus_command(owb_handle, DS18B20_CMD_TEMP_CONVERT), TAG, "unable to send DS18B20_CMD_CONVERT_TEMP command, trigger bus temperature conversion failed" );
+
+    // wait for temperature conversion of all devices - timeout based on resolution setting
+    ESP_RETURN_ON_ERROR( ds18b20_wait_for_conversion(owb_handle, resolution, parasitic), TAG, "unable to wait for temperature conversion, trigger bus temperature conversion failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_trigger_bus_temperature_conversion_parasitic(onewire_bus_handle_t owb_handle, const ds18b20_resolutions_t resolution, const ds18b20_strong_pullup_config_t *pullup_config) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle && pullup_config );
+
+    /* configure strong pull-up gpio, disabled */
+    if(pullup_config->gpio_num != GPIO_NUM_NC) {
+        const gpio_config_t io_conf = {
+            .intr_type    = GPIO_INTR_DISABLE,
+            .mode         = GPIO_MODE_OUTPUT,
+            .pin_bit_mask = (1ULL << pullup_config->gpio_num),
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .pull_up_en   = GPIO_PULLUP_DISABLE
+        };
+        ESP_RETURN_ON_ERROR( gpio_set_level(pullup_config->gpio_num, pullup_config->active_low ? 1 : 0), TAG, "unable to disable strong pull-up, trigger bus temperature conversion failed" );
+        ESP_RETURN_ON_ERROR( gpio_config(&io_conf), TAG, "unable to configure strong pull-up gpio, trigger bus temperature conversion failed" );
+    }
+
+    if(pullup_config->gpio_num != GPIO_NUM_NC) {
+        // build command
+        const uint8_t tx_buffer[] = { ONEWIRE_CMD_SKIP_ROM, DS18B20_CMD_TEMP_CONVERT };
+
+        // reset bus, the bus reset checks if devices are present
+        ESP_RETURN_ON_ERROR( onewire_bus_reset(owb_handle), TAG, "unable to reset 1-wire bus, trigger bus temperature conversion failed" );
+
+        /* broadcast command: DS18B20_CMD_CONVERT_TEMP and enable strong pull-up, the datasheet requires it within 10us of
+           the command.  The RMT bus drives the gpio from the transmit done interrupt at the end of the last time slot, a 
+           bus without strong pull-up support sets it from this task once the write returns, that delay is not bounded 
+           and a parasitic-powered device may brown out and reset instead of converting */
+        ESP_GOTO_ON_ERROR( onewire_bus_write_bytes_pullup(owb_handle, tx_buffer, sizeof(tx_buffer), pullup_config->gpio_num, pullup_config->active_low ? 0 : 1), err, TAG, "unable to send DS18B20_CMD_CONVERT_TEMP command and enable strong pull-up, trigger bus temperature conversion failed" );
+    } else {
+        // broadcast command: DS18B20_CMD_CONVERT_TEMP, the bus reset checks if devices are present
+        ESP_RETURN_ON_ERROR( ds18b20_send_bus_command(owb_handle, DS18B20_CMD_TEMP_CONVERT), TAG, "unable to send DS18B20_CMD_CONVERT_TEMP command, trigger bus temperature conversion failed" );
+    }
+
+    // hold the bus for the maximum temperature conversion time - based on resolution setting
+    vTaskDelay(pdMS_TO_TICKS(ds18b20_conversion_times_ms[resolution]));
+
+    err:
+        /* disable strong pull-up */
+        if(pullup_config->gpio_num != GPIO_NUM_NC) {
+            gpio_set_level(pullup_config->gpio_num, pullup_config->active_low ? 1 : 0);
+        }
+        return ret;
+}
+
+esp_err_t ds18b20_get_bus_temperatures(const ds18b20_handle_t *handles, const uint8_t handle_count, float *const temperatures) {
+    ds18b20_resolutions_t resolution = DS18B20_RESOLUTION_9BIT;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( handles && handle_count > 0 && temperatures );
 
-    // send command: DS18B20_CMD_CONVERT_TEMP
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_TEMP_CONVERT), TAG, "unable to send DS18B20_CMD_CONVERT_TEMP command, trigger temperature conversion failed" );
+    const ds18b20_device_t* first = (const ds18b20_device_t*)handles[0];
+    ESP_ARG_CHECK( first );
 
-    // temperature conversion delays by resolution (9, 10, 11, 12 bit)
-    const uint16_t delays_ms[] = { 100, 200, 400, 800 };
+    /* validate devices share the 1-wire bus and determine the highest resolution */
+    for(uint8_t i = 0; i < handle_count; i++) {
+        const ds18b20_device_t* dev = (const ds18b20_device_t*)handles[i];
 
-    // delay for temperature conversion - based on resolution setting
-    vTaskDelay(pdMS_TO_TICKS(delays_ms[dev->config.resolution]));
+        ESP_ARG_CHECK( dev );
+        ESP_RETURN_ON_FALSE( dev->owb_handle == first->owb_handle, ESP_ERR_INVALID_ARG, TAG, "devices must be on the same 1-wire bus, get bus temperatures failed" );
+
+        if(dev->config.resolution > resolution) resolution = dev->config.resolution;
+    }
+
+    /* trigger temperature conversion of all devices */
+    ESP_RETURN_ON_ERROR( ds18b20_trigger_bus_temperature_conversion(first->owb_handle, resolution), TAG, "unable to trigger bus temperature conversion, get bus temperatures failed" );
+
+    /* read temperature of each device by rom id */
+    for(uint8_t i = 0; i < handle_count; i++) {
+        ESP_RETURN_ON_ERROR( ds18b20_get_measurement(handles[i], &temperatures[i]), TAG, "unable to read temperature, get bus temperatures failed" );
+    }
 
     return ESP_OK;
 }
@@ -307,18 +576,12 @@ esp_err_t ds18b20_get_resolution(ds18b20_handle_t handle, ds18b20_resolutions_t
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "reset bus error" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "send DS18B20_CMD_READ_SCRATCHPAD failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "error while reading scratchpad data" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "error while reading scratchpad data" );
 
     // validate crc
-    ESP_RETURN_ON_FALSE( onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
+    ESP_RETURN_ON_FALSE( ds18b20_validate_scratchpad_crc(&scratchpad), ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
 
     // init configuration register
     const ds18b20_configuration_register_t cfg = { .reg = scratchpad.configuration };
@@ -337,33 +600,21 @@ esp_err_t ds18b20_set_resolution(ds18b20_handle_t handle, const ds18b20_resoluti
 
     /* ##### read existing configuration ##### */
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, set resolution failed" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "unable to send OWB_DS18B20_CMD_SCRATCHPAD_READ command, set resolution failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "unable to read scratchpad data, set resolution failed" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "unable to read scratchpad data, set resolution failed" );
 
     // validate crc
-    ESP_RETURN_ON_FALSE( onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, set resolution failed");
+    ESP_RETURN_ON_FALSE( ds18b20_validate_scratchpad_crc(&scratchpad), ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, set resolution failed");
 
     /* ##### write updated configuration ##### */
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, set resolution failed" );
-
-    // send command: DS18B20_CMD_WRITE_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_WRITE), TAG, "unable to send DS18B20_CMD_WRITE_SCRATCHPAD command, set resolution failed" );
-
     // init configuration register and buffer data
     const ds18b20_configuration_register_t cfg = { .bits.reserved1 = 1, .bits.reserved2 = 0, .bits.resolution = resolution };
     const uint8_t tx_buffer[] = { scratchpad.trigger_high, scratchpad.trigger_low, cfg.reg };
 
-    // write resolution data to scratchpad
-    ESP_RETURN_ON_ERROR( onewire_bus_write_bytes(dev->owb_handle, tx_buffer, sizeof(tx_buffer)), TAG, "unable to write resolution, set resolution failed" );
+    // send command: DS18B20_CMD_WRITE_SCRATCHPAD and write resolution data to scratchpad
+    ESP_RETURN_ON_ERROR( ds18b20_transaction(dev->owb_handle, dev->owb_address, DS18B20_CMD_SCRATCHPAD_WRITE, tx_buffer, sizeof(tx_buffer), NULL, 0), TAG, "unable to write resolution, set resolution failed" );
 
     // set handle resolution setting
     dev->config.resolution = resolution;
@@ -380,18 +631,12 @@ esp_err_t ds18b20_get_alarm_thresholds(ds18b20_handle_t handle, int8_t *const hi
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, get alarm thresholds failed" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "unable to send OWB_DS18B20_CMD_SCRATCHPAD_READ command, get alarm thresholds failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "unable to read scratchpad data, get alarm thresholds failed" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "unable to read scratchpad data, get alarm thresholds failed" );
 
     // validate crc
-    ESP_RETURN_ON_FALSE( onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, get alarm thresholds failed");
+    ESP_RETURN_ON_FALSE( ds18b20_validate_scratchpad_crc(&scratchpad), ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, get alarm thresholds failed");
 
     // set output parameters
     *high = scratchpad.trigger_high;
@@ -413,32 +658,20 @@ esp_err_t ds18b20_set_alarm_thresholds(ds18b20_handle_t handle, const int8_t hig
 
     /* ##### read existing configuration ##### */
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, set alarm thresholds failed" );
-
-    // send command: DS18B20_CMD_READ_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_READ), TAG, "unable to send OWB_DS18B20_CMD_SCRATCHPAD_READ command, set alarm thresholds failed" );
-
-    // read scratchpad data
+    // read scratchpad data, the bus reset checks if the ds18b20 is present
     ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR( onewire_bus_read_bytes(dev->owb_handle, (uint8_t *)&scratchpad, sizeof(scratchpad)), TAG, "unable to read scratchpad data, set alarm thresholds failed" );
+    ESP_RETURN_ON_ERROR( ds18b20_read_scratchpad(dev->owb_handle, dev->owb_address, &scratchpad), TAG, "unable to read scratchpad data, set alarm thresholds failed" );
 
     // validate crc
-    ESP_RETURN_ON_FALSE( onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, set alarm thresholds failed");
+    ESP_RETURN_ON_FALSE( ds18b20_validate_scratchpad_crc(&scratchpad), ESP_ERR_INVALID_CRC, TAG, "scratchpad crc is invalid, set alarm thresholds failed");
 
     /* ##### write updated configuration ##### */
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "unable to reset bus, set alarm thresholds failed" );
-
-    // send command: DS18B20_CMD_WRITE_SCRATCHPAD
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_SCRATCHPAD_WRITE), TAG, "unable to send DS18B20_CMD_WRITE_SCRATCHPAD command, set alarm thresholds failed" );
-
     // init resolution data
     const uint8_t tx_buffer[] = { (uint8_t)high, (uint8_t)low, scratchpad.configuration };
 
-    // write resolution data to scratchpad
-    ESP_RETURN_ON_ERROR( onewire_bus_write_bytes(dev->owb_handle, tx_buffer, sizeof(tx_buffer)), TAG, "unable to write thresholds, set alarm thresholds failed" );
+    // send command: DS18B20_CMD_WRITE_SCRATCHPAD and write resolution data to scratchpad
+    ESP_RETURN_ON_ERROR( ds18b20_transaction(dev->owb_handle, dev->owb_address, DS18B20_CMD_SCRATCHPAD_WRITE, tx_buffer, sizeof(tx_buffer), NULL, 0), TAG, "unable to write thresholds, set alarm thresholds failed" );
 
     // set handle parameters
     dev->config.trigger_high = high;
@@ -456,11 +689,8 @@ esp_err_t ds18b20_get_power_supply_mode(ds18b20_handle_t handle, bool *const par
     /* validate arguments */
     ESP_ARG_CHECK( dev );
 
-    // reset bus and check if the ds18b20 is present
-    ESP_RETURN_ON_ERROR( onewire_bus_reset(dev->owb_handle), TAG, "reset bus error" );
-
-    // send command: OWB_DS18B20_CMD_POWER_SUPPLY_READ
-    ESP_RETURN_ON_ERROR( ds18b20_send_command(dev, DS18B20_CMD_POWER_SUPPLY_READ), TAG, "send OWB_DS18B20_CMD_POWER_SUPPLY_READ failed" );
+    // send command: OWB_DS18B20_CMD_POWER_SUPPLY_READ, the bus reset checks if the ds18b20 is present
+    ESP_RETURN_ON_ERROR( ds18b20_transaction(dev->owb_handle, dev->owb_address, DS18B20_CMD_POWER_SUPPLY_READ, NULL, 0, NULL, 0), TAG, "send OWB_DS18B20_CMD_POWER_SUPPLY_READ failed" );
 
     // read power supply type
     uint8_t value = 0;
@@ -472,6 +702,23 @@ esp_err_t ds18b20_get_power_supply_mode(ds18b20_handle_t handle, bool *const par
     return ESP_OK;
 }
 
+esp_err_t ds18b20_get_bus_power_supply_mode(onewire_bus_handle_t owb_handle, bool *const parasitic) {
+    /* validate arguments */
+    ESP_ARG_CHECK( owb_handle && parasitic );
+
+    // broadcast command: OWB_DS18B20_CMD_POWER_SUPPLY_READ, the bus reset checks if devices are present
+    ESP_RETURN_ON_ERROR( ds18b20_send_bus_command(owb_handle, DS18B20_CMD_POWER_SUPPLY_READ), TAG, "unable to send OWB_DS18B20_CMD_POWER_SUPPLY_READ command, get bus power supply mode failed" );
+
+    // read power supply type, parasitic-powered devices pull the bus low
+    uint8_t value = 0;
+    ESP_RETURN_ON_ERROR( onewire_bus_read_bit(owb_handle, &value), TAG, "unable to read bit, get bus power supply mode failed" );
+
+    /* set output parameter */
+    *parasitic = !(bool)(value & 0x01u);
+
+    return ESP_OK;
+}
+
 esp_err_t ds18b20_delete(ds18b20_handle_t handle) {
     /* validate arguments */
     ESP_ARG_CHECK( handle );
@@ -44,6 +44,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <esp_err.h>
+#include <driver/gpio.h>
 #include <onewire_bus.h>
 #include <onewire_device.h>
 #include "ds18b20_version.h"
@@ -67,6 +68,10 @@ extern "C"
     .resolution      = DS18B20_RESOLUTION_10BIT,    \
     .trigger_enabled = false }
 
+#define DS18B20_STRONG_PULLUP_CONFIG_DEFAULT {  \
+    .gpio_num        = GPIO_NUM_NC,             \
+    .active_low      = true }
+
 
 /**
  * @brief DS18B20 supported resolutions enumerator.
@@ -115,6 +120,16 @@ typedef struct ds18b20_config_s {
     int8_t                    trigger_low;      /*!< ds18b20 low alarm trigger threshold */
 } ds18b20_config_t;
 
+/**
+ * @brief DS18B20 strong pull-up configuration structure definition.  Parasitic-powered devices draw their conversion
+ * current from the data line, the strong pull-up transistor (see datasheet Figure 6) holds the data line high while 
+ * the devices convert.
+ */
+typedef struct ds18b20_strong_pullup_config_s {
+    gpio_num_t                gpio_num;         /*!< ds18b20 strong pull-up transistor gpio, GPIO_NUM_NC when the data line is not switched */
+    bool                      active_low;       /*!< ds18b20 strong pull-up is enabled with a low level (i.e. p-channel mosfet) when true */
+} ds18b20_strong_pullup_config_t;
+
 /**
  * @brief DS18B20 opaque handle structure definition.
  */
@@ -140,6 +155,31 @@ bool ods18b20_validate_address(const onewire_device_address_t address);
  */
 esp_err_t ds18b20_detect(onewire_bus_handle_t owb_handle, onewire_device_t *const devices, const uint8_t device_size, uint8_t *const device_count);
 
+/**
+ * @brief Detects up to 10 DS18B20 devices on the 1-wire bus with ROM IDs cached in NVS.  Each cached DS18B20 is verified
+ * with a single scratchpad read transaction, the 1-wire bus is searched and the cache is updated when the cache is empty
+ * or a cached DS18B20 is not present.  DS18B20 devices added to the 1-wire bus are not detected while every cached DS18B20
+ * is present, use `ds18b20_clear_detect_cache` to force a 1-wire bus search.
+ *
+ * @note NVS must be initialized by the application (i.e. `nvs_flash_init`), the 1-wire bus is searched on every call otherwise.
+ *
+ * @param[in] owb_handle 1-wire bus handle.
+ * @param[in] nvs_key NVS key of the cached ROM IDs, one key per 1-wire bus (maximum 15 characters).
+ * @param[out] devices Array of DS18B20 devices detected on the 1-wire bus.
+ * @param[in] device_size Size of DS18B20 devices array.  The maximum number of detectable DS18B20 devices is 10.
+ * @param[out] device_count Number of DS18B20 devices detected.  The maximum number of detectable DS18B20 devices is 10.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ds18b20_detect_cached(onewire_bus_handle_t owb_handle, const char *nvs_key, onewire_device_t *const devices, const uint8_t device_size, uint8_t *const device_count);
+
+/**
+ * @brief Clears DS18B20 ROM IDs cached in NVS by `ds18b20_detect_cached`.
+ *
+ * @param[in] nvs_key NVS key of the cached ROM IDs.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ds18b20_clear_detect_cache(const char *nvs_key);
+
 /**
  * @brief Checks if the DS18B20 is connected to the 1-wire bus.
  * 
@@ -150,9 +190,10 @@ esp_err_t ds18b20_detect(onewire_bus_handle_t owb_handle, onewire_device_t *cons
 esp_err_t ds18b20_connected(ds18b20_handle_t handle, bool *const connected);
 
 /**
- * @brief Initializes an DS18B20 device onto the 1-wire master bus.
+ * @brief Initializes an DS18B20 device onto the 1-wire master bus.  The power supply mode of the device is read, 
+ * temperature conversions of a parasitic-powered device are waited out with the maximum conversion time.
  * 
- * @note Parasitic-powered devices are not supported at this time.
+ * @note The strong pull-up of parasitic-powered devices is only driven by `ds18b20_trigger_bus_temperature_conversion_parasitic`.
  *
  * @param[in] device 1-wire device.
  * @param[in] ds18b20_config DS18B20 device configuration.
@@ -183,12 +224,69 @@ esp_err_t ds18b20_get_measurement(ds18b20_handle_t handle, float *const temperat
 
 /**
  * @brief Triggers DS18B20 temperature conversion.  This function must be called before reading the temperature from DS18B20.
+ * Read time slots are polled until an externally powered device completes, a parasitic-powered device is given the 
+ * maximum conversion time of the resolution.
  * 
  * @param handle DS18B20 device handle. 
  * @return esp_err_t ESP_OK on success.
  */
 esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_handle_t handle);
 
+/**
+ * @brief Triggers temperature conversion of all DS18B20 devices on the 1-wire bus with a SKIP ROM and CONVERT T 
+ * broadcast and waits once for the conversions to complete.  Read time slots are polled until the devices release 
+ * the bus, the bus reads 0 until the slowest device completes.  The temperatures are then read from each device with
+ * `ds18b20_get_measurement`.
+ * 
+ * @note The power supply mode of the devices is read with a READ POWER SUPPLY broadcast first, the maximum conversion 
+ * time is waited instead of polling when a device on the bus is parasitic-powered.  A strong pull-up is driven by
+ * `ds18b20_trigger_bus_temperature_conversion_parasitic`.
+ *
+ * @param owb_handle 1-wire bus handle.
+ * @param resolution Highest DS18B20 temperature conversion resolution setting on the 1-wire bus, sets the conversion timeout.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when the conversions did not complete in time.
+ */
+esp_err_t ds18b20_trigger_bus_temperature_conversion(onewire_bus_handle_t owb_handle, const ds18b20_resolutions_t resolution);
+
+/**
+ * @brief Triggers temperature conversion of all parasitic-powered DS18B20 devices on the 1-wire bus with a SKIP ROM and
+ * CONVERT T broadcast.  The strong pull-up is enabled at the end of the command and held for the maximum conversion time
+ * of the resolution, the bus can not be polled while parasitic-powered devices convert.
+ * 
+ * @note The RMT 1-wire bus enables the strong pull-up from the RMT transmit done interrupt, within the 10us the datasheet
+ * allows.  With CONFIG_RMT_ISR_IRAM_SAFE enabled, CONFIG_GPIO_CTRL_FUNC_IN_IRAM must be enabled as well.  Other 1-wire
+ * buses enable it from the calling task after the command and a parasitic-powered device may brown out.
+ * 
+ * @param owb_handle 1-wire bus handle.
+ * @param resolution Highest DS18B20 temperature conversion resolution setting on the 1-wire bus.
+ * @param pullup_config DS18B20 strong pull-up configuration.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ds18b20_trigger_bus_temperature_conversion_parasitic(onewire_bus_handle_t owb_handle, const ds18b20_resolutions_t resolution, const ds18b20_strong_pullup_config_t *pullup_config);
+
+/**
+ * @brief Triggers temperature conversion of all DS18B20 devices on the 1-wire bus and reads the temperature of each 
+ * device by ROM id.  A sweep of the devices costs one conversion time of the highest resolution of the devices.
+ * 
+ * @note The devices must be on the same 1-wire bus, parasitic-powered devices on the bus are waited out with the
+ * maximum conversion time, see `ds18b20_trigger_bus_temperature_conversion`.
+ *
+ * @param[in] handles DS18B20 device handles.
+ * @param[in] handle_count Number of DS18B20 device handles.
+ * @param[out] temperatures Temperatures in degree Celsius, one per device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ds18b20_get_bus_temperatures(const ds18b20_handle_t *handles, const uint8_t handle_count, float *const temperatures);
+
+/**
+ * @brief Reads the power supply mode of the DS18B20 devices on the 1-wire bus with a SKIP ROM broadcast.
+ * 
+ * @param owb_handle 1-wire bus handle.
+ * @param parasitic At least one device on the 1-wire bus is parasitic-powered when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ds18b20_get_bus_power_supply_mode(onewire_bus_handle_t owb_handle, bool *const parasitic);
+
 /**
  * @brief Reads temperature conversion resolution from DS18B20.
  * 
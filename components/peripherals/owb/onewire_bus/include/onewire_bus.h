@@ -74,6 +74,47 @@ esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
  */
 esp_err_t onewire_bus_reset(onewire_bus_handle_t bus);
 
+/**
+ * @brief Send reset pulse, write bytes and read bytes in a single bus transaction, i.e. reset, MATCH ROM,
+ *        ROM id, function command and the read payload
+ *
+ * @note The RMT backend encodes the whole transaction into one RMT symbol sequence when tx_data_size + rx_buf_size
+ *       fits in max_rx_bytes, backends without transaction support fall back to reset, write and read calls
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] tx_data pointer to data to be sent after the reset pulse
+ * @param[in] tx_data_size size of data to be sent, in bytes
+ * @param[out] rx_buf pointer to buffer to store received data, can be NULL if rx_buf_size is 0
+ * @param[in] rx_buf_size size of buffer to store received data, in bytes
+ * @return
+ *      - ESP_OK: Transaction completed successfully and device presence detected
+ *      - ESP_ERR_NOT_FOUND: No device presence detected after the reset pulse
+ *      - ESP_ERR_INVALID_ARG: Transaction failed because of invalid argument
+ *      - ESP_FAIL: Transaction failed because of other errors
+ */
+esp_err_t onewire_bus_transaction(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, uint8_t *rx_buf, size_t rx_buf_size);
+
+/**
+ * @brief Write bytes to 1-wire bus and drive a strong pull-up GPIO to its active level when the last time slot
+ *        completes, i.e. to power parasitic-powered devices from the end of a CONVERT T or COPY SCRATCHPAD command
+ *
+ * @note The RMT backend drives the GPIO from the RMT transmit done callback.  With CONFIG_RMT_ISR_IRAM_SAFE the
+ *       callback runs from IRAM and CONFIG_GPIO_CTRL_FUNC_IN_IRAM must be enabled.  Backends without strong pull-up
+ *       support fall back to a write and a GPIO level set by the calling task once the write returns, the delay
+ *       then depends on task scheduling and may exceed the 10 us a parasitic-powered device tolerates
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] tx_data pointer to data to be sent
+ * @param[in] tx_data_size size of data to be sent, in bytes
+ * @param[in] pullup_gpio_num GPIO number of the strong pull-up, the GPIO must be configured as an output
+ * @param[in] pullup_level active level of the strong pull-up
+ * @return
+ *      - ESP_OK: Write bytes to 1-Wire bus and enable the strong pull-up successfully
+ *      - ESP_ERR_INVALID_ARG: Write bytes to 1-Wire bus failed because of invalid argument
+ *      - ESP_FAIL: Write bytes to 1-Wire bus failed because of other errors
+ */
+esp_err_t onewire_bus_write_bytes_pullup(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, int pullup_gpio_num, uint32_t pullup_level);
+
 /**
  * @brief Free 1-Wire bus resources
  *
@@ -18,7 +18,9 @@ extern "C" {
  */
 typedef struct {
     uint32_t max_rx_bytes; /*!< Set the largest possible single receive size,
-                                which determins the size of the internal buffer that used to save the receiving RMT symbols */
+                                which determins the size of the internal buffer that used to save the receiving RMT symbols.
+                                Transactions with more tx and rx bytes are split into reset, write and read calls.
+                                On ESP32 and ESP32-S2 the RX channel reserves (max_rx_bytes * 8 + 4) symbols of RMT memory */
 } onewire_bus_rmt_config_t;
 
 /**
@@ -80,6 +80,41 @@ struct onewire_bus_t {
      */
     esp_err_t (*reset)(onewire_bus_t *bus);
 
+    /**
+     * @brief Send reset pulse, write bytes and read bytes in a single bus transaction
+     *
+     * @note This member is optional, a NULL member is emulated with the reset, write_bytes and read_bytes members
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[in] tx_data pointer to data to be sent after the reset pulse, i.e. ROM command, ROM id and function command
+     * @param[in] tx_data_size size of data to be sent, in bytes
+     * @param[out] rx_buf pointer to buffer to store received data, can be NULL if rx_buf_size is 0
+     * @param[in] rx_buf_size size of buffer to store received data, in bytes
+     * @return
+     *      - ESP_OK: Transaction completed successfully and device presence detected
+     *      - ESP_ERR_NOT_FOUND: No device presence detected after the reset pulse
+     *      - ESP_ERR_INVALID_ARG: Transaction failed because of invalid argument
+     *      - ESP_FAIL: Transaction failed because of other errors
+     */
+    esp_err_t (*transaction)(onewire_bus_t *bus, const uint8_t *tx_data, uint8_t tx_data_size, uint8_t *rx_buf, size_t rx_buf_size);
+
+    /**
+     * @brief Write bytes to 1-wire bus and drive a strong pull-up GPIO to its active level when the last time slot completes
+     *
+     * @note This member is optional, a NULL member is emulated with the write_bytes member and a GPIO level set by the calling task
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[in] tx_data pointer to data to be sent, i.e. SKIP ROM and CONVERT T commands
+     * @param[in] tx_data_size size of data to be sent, in bytes
+     * @param[in] pullup_gpio_num GPIO number of the strong pull-up, the GPIO must be configured as an output
+     * @param[in] pullup_level active level of the strong pull-up
+     * @return
+     *      - ESP_OK: Write bytes to 1-Wire bus and enable the strong pull-up successfully
+     *      - ESP_ERR_INVALID_ARG: Write bytes to 1-Wire bus failed because of invalid argument
+     *      - ESP_FAIL: Write bytes to 1-Wire bus failed because of other errors
+     */
+    esp_err_t (*write_bytes_pullup)(onewire_bus_t *bus, const uint8_t *tx_data, uint8_t tx_data_size, int pullup_gpio_num, uint32_t pullup_level);
+
     /**
      * @brief Free 1-Wire bus resources
      *
@@ -5,6 +5,7 @@
  */
 #include "esp_log.h"
 #include "esp_check.h"
+#include "driver/gpio.h"
 #include "onewire_types.h"
 #include "onewire_bus_interface.h"
 
@@ -40,6 +41,32 @@ esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit)
     return bus->read_bit(bus, rx_bit);
 }
 
+esp_err_t onewire_bus_transaction(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, uint8_t *rx_buf, size_t rx_buf_size)
+{
+    ESP_RETURN_ON_FALSE(bus && tx_data && tx_data_size && (rx_buf || !rx_buf_size), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (bus->transaction) {
+        return bus->transaction(bus, tx_data, tx_data_size, rx_buf, rx_buf_size);
+    }
+    // emulate the transaction for backends without transaction support
+    ESP_RETURN_ON_ERROR(bus->reset(bus), TAG, "reset bus failed");
+    ESP_RETURN_ON_ERROR(bus->write_bytes(bus, tx_data, tx_data_size), TAG, "write bytes failed");
+    if (rx_buf_size) {
+        ESP_RETURN_ON_ERROR(bus->read_bytes(bus, rx_buf, rx_buf_size), TAG, "read bytes failed");
+    }
+    return ESP_OK;
+}
+
+esp_err_t onewire_bus_write_bytes_pullup(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, int pullup_gpio_num, uint32_t pullup_level)
+{
+    ESP_RETURN_ON_FALSE(bus && tx_data && tx_data_size && GPIO_IS_VALID_OUTPUT_GPIO(pullup_gpio_num), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (bus->write_bytes_pullup) {
+        return bus->write_bytes_pullup(bus, tx_data, tx_data_size, pullup_gpio_num, pullup_level);
+    }
+    // emulate for backends without strong pull-up support, the pull-up follows the write by the task scheduling latency
+    ESP_RETURN_ON_ERROR(bus->write_bytes(bus, tx_data, tx_data_size), TAG, "write bytes failed");
+    return gpio_set_level(pullup_gpio_num, pullup_level);
+}
+
 esp_err_t onewire_bus_del(onewire_bus_handle_t bus)
 {
     ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -12,6 +12,7 @@
 #include "esp_attr.h"
 #include "driver/rmt_tx.h"
 #include "driver/rmt_rx.h"
+#include "driver/gpio.h"
 #include "onewire_bus_impl_rmt.h"
 #include "onewire_bus_interface.h"
 
@@ -19,6 +20,7 @@ static const char *TAG = "1-wire.rmt";
 
 #define ONEWIRE_RMT_RESOLUTION_HZ               1000000 // RMT channel default resolution for 1-wire bus, 1MHz, 1tick = 1us
 #define ONEWIRE_RMT_DEFAULT_TRANS_QUEUE_SIZE    4
+#define ONEWIRE_RMT_TRANSACTION_RESET_SYMBOLS   4 // RMT symbols received for the reset and presence pulses of a transaction, rounded up to keep the size even
 
 // the memory size of each RMT channel, in words (4 bytes)
 #if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
@@ -30,7 +32,7 @@ static const char *TAG = "1-wire.rmt";
 // for chips whose RMT RX channel doesn't support ping-pong, we need the user to tell the maximum number of bytes will be received
 #if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
 // one RMT symbol represents one bit, so x8
-#define ONEWIRE_RMT_RX_MEM_BLOCK_SIZE           (rmt_config->max_rx_bytes * 8)
+#define ONEWIRE_RMT_RX_MEM_BLOCK_SIZE           (rmt_config->max_rx_bytes * 8 + ONEWIRE_RMT_TRANSACTION_RESET_SYMBOLS)
 #else // otherwise, we just use one memory block, to save resources
 #define ONEWIRE_RMT_RX_MEM_BLOCK_SIZE           ONEWIRE_RMT_DEFAULT_MEM_BLOCK_SYMBOLS
 #endif
@@ -54,6 +56,8 @@ Reset Pulse:
 #define ONEWIRE_RESET_WAIT_DURATION             200 // how long should master wait for device to show its presence
 #define ONEWIRE_RESET_PRESENCE_WAIT_DURATION_MIN 15 // minimum duration for master to wait device to show its presence
 #define ONEWIRE_RESET_PRESENCE_DURATION_MIN      60 // minimum duration for master to recognize device as present
+#define ONEWIRE_RESET_PRESENCE_DURATION_MAX      240 // maximum duration of the device presence pulse
+#define ONEWIRE_TRANSACTION_RESET_WAIT_DURATION  480 // how long should master wait after the reset pulse when data follows in the same transaction
 
 /*
 Write 1 bit:
@@ -118,11 +122,15 @@ typedef struct {
     rmt_encoder_handle_t tx_copy_encoder; /*!< used to encode reset pulse and bits */
 
     rmt_symbol_word_t *rx_symbols_buf; /*!< hold rmt raw symbols */
+    rmt_symbol_word_t *tx_symbols_buf; /*!< hold rmt symbols of a transaction */
 
     size_t max_rx_bytes; /*!< buffer size in byte for single receive transaction */
 
     QueueHandle_t receive_queue;
     SemaphoreHandle_t bus_mutex;
+
+    volatile int pullup_gpio_num; /*!< strong pull-up gpio armed for the transmit done callback, -1 when not armed */
+    uint32_t pullup_level; /*!< active level of the armed strong pull-up */
 } onewire_bus_rmt_obj_t;
 
 static rmt_symbol_word_t onewire_reset_pulse_symbol = {
@@ -132,6 +140,13 @@ static rmt_symbol_word_t onewire_reset_pulse_symbol = {
     .duration1 = ONEWIRE_RESET_WAIT_DURATION
 };
 
+static rmt_symbol_word_t onewire_transaction_reset_symbol = {
+    .level0 = 0,
+    .duration0 = ONEWIRE_RESET_PULSE_DURATION,
+    .level1 = 1,
+    .duration1 = ONEWIRE_TRANSACTION_RESET_WAIT_DURATION
+};
+
 static rmt_symbol_word_t onewire_bit0_symbol = {
     .level0 = 0,
     .duration0 = ONEWIRE_SLOT_START_DURATION + ONEWIRE_SLOT_BIT_DURATION,
@@ -160,7 +175,9 @@ static esp_err_t onewire_bus_rmt_read_bit(onewire_bus_handle_t bus, uint8_t *rx_
 static esp_err_t onewire_bus_rmt_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit);
 static esp_err_t onewire_bus_rmt_read_bytes(onewire_bus_handle_t bus, uint8_t *rx_buf, size_t rx_buf_size);
 static esp_err_t onewire_bus_rmt_write_bytes(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size);
+static esp_err_t onewire_bus_rmt_write_bytes_pullup(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, int pullup_gpio_num, uint32_t pullup_level);
 static esp_err_t onewire_bus_rmt_reset(onewire_bus_handle_t bus);
+static esp_err_t onewire_bus_rmt_transaction(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, uint8_t *rx_buf, size_t rx_buf_size);
 static esp_err_t onewire_bus_rmt_del(onewire_bus_handle_t bus);
 static esp_err_t onewire_bus_rmt_destroy(onewire_bus_rmt_obj_t *bus_rmt);
 
@@ -175,6 +192,20 @@ bool onewire_rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_don
     return task_woken;
 }
 
+IRAM_ATTR
+bool onewire_rmt_tx_done_callback(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_data)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = (onewire_bus_rmt_obj_t *)user_data;
+
+    // enable the armed strong pull-up as soon as the last time slot completes, without waiting for the task
+    if (bus_rmt->pullup_gpio_num >= 0) {
+        gpio_set_level(bus_rmt->pullup_gpio_num, bus_rmt->pullup_level);
+        bus_rmt->pullup_gpio_num = -1;
+    }
+
+    return false;
+}
+
 /*
 [0].0 means symbol[0].duration0
 
@@ -245,6 +276,59 @@ static void onewire_rmt_decode_data(rmt_symbol_word_t *rmt_symbols, size_t symbo
     }
 }
 
+/*
+Transaction:
+
+The reset pulse, the written bits and the read slots are received as one RMT symbol sequence. Every bit slot
+is one low level of the bus, so the levels are walked in order instead of by symbol index:
+
+    reset pulse (> RESET_PRESENCE_DURATION_MAX, not received when the bus is low before the reset pulse)
+    presence pulse (low level after a high level shorter than RESET_WAIT_DURATION)
+    tx bit slots (skipped)
+    rx bit slots (decoded as read bits, LSB first)
+*/
+static bool onewire_rmt_decode_transaction(rmt_symbol_word_t *rmt_symbols, size_t symbol_num, size_t tx_bits, uint8_t *rx_buf, size_t rx_buf_size)
+{
+    bool presence = false;
+    uint32_t high_duration = 0;
+    size_t slot = 0;
+    for (size_t i = 0; i < symbol_num * 2; i ++) {
+        uint32_t level = (i & 0x01) ? rmt_symbols[i / 2].level1 : rmt_symbols[i / 2].level0;
+        uint32_t duration = (i & 0x01) ? rmt_symbols[i / 2].duration1 : rmt_symbols[i / 2].duration0;
+        if (duration == 0) { // end marker
+            break;
+        }
+        if (level) {
+            high_duration = duration;
+            continue;
+        }
+        if (!presence) {
+            if (duration > ONEWIRE_RESET_PRESENCE_DURATION_MAX) { // reset pulse
+                continue;
+            }
+            if (high_duration > ONEWIRE_RESET_PRESENCE_WAIT_DURATION_MIN && high_duration < ONEWIRE_RESET_WAIT_DURATION &&
+                    duration > ONEWIRE_RESET_PRESENCE_DURATION_MIN) {
+                presence = true;
+                continue;
+            }
+            return false;
+        }
+        if (slot >= tx_bits) {
+            size_t rx_bit = slot - tx_bits;
+            if (rx_bit / 8 >= rx_buf_size) {
+                break;
+            }
+            if (duration > ONEWIRE_SLOT_BIT_SAMPLE_TIME) { // 0 bit
+                rx_buf[rx_bit / 8] &= ~(1 << (rx_bit % 8)); // LSB first
+            } else { // 1 bit
+                rx_buf[rx_bit / 8] |= 1 << (rx_bit % 8);
+            }
+        }
+        slot ++;
+    }
+    return presence;
+}
+
 esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onewire_bus_rmt_config_t *rmt_config, onewire_bus_handle_t *ret_bus)
 {
     esp_err_t ret = ESP_OK;
@@ -292,9 +376,14 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
                       err, TAG, "create rmt tx channel failed");
 
     // allocate rmt rx symbol buffer, one RMT symbol represents one bit, so x8
-    bus_rmt->rx_symbols_buf = malloc(rmt_config->max_rx_bytes * sizeof(rmt_symbol_word_t) * 8);
+    bus_rmt->rx_symbols_buf = malloc((rmt_config->max_rx_bytes * 8 + ONEWIRE_RMT_TRANSACTION_RESET_SYMBOLS) * sizeof(rmt_symbol_word_t));
     ESP_GOTO_ON_FALSE(bus_rmt->rx_symbols_buf, ESP_ERR_NO_MEM, err, TAG, "no mem to store received RMT symbols");
+
+    // allocate rmt tx symbol buffer for transactions, reset pulse followed by one RMT symbol per bit
+    bus_rmt->tx_symbols_buf = malloc((rmt_config->max_rx_bytes * 8 + 1) * sizeof(rmt_symbol_word_t));
+    ESP_GOTO_ON_FALSE(bus_rmt->tx_symbols_buf, ESP_ERR_NO_MEM, err, TAG, "no mem to store transaction RMT symbols");
     bus_rmt->max_rx_bytes = rmt_config->max_rx_bytes;
+    bus_rmt->pullup_gpio_num = -1;
 
     bus_rmt->receive_queue = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
     ESP_GOTO_ON_FALSE(bus_rmt->receive_queue, ESP_ERR_NO_MEM, err, TAG, "receive queue creation failed");
@@ -309,6 +398,13 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     ESP_GOTO_ON_ERROR(rmt_rx_register_event_callbacks(bus_rmt->rx_channel, &cbs, bus_rmt),
                       err, TAG, "enable rmt rx channel failed");
 
+    // register rmt tx done callback
+    rmt_tx_event_callbacks_t tx_cbs = {
+        .on_trans_done = onewire_rmt_tx_done_callback
+    };
+    ESP_GOTO_ON_ERROR(rmt_tx_register_event_callbacks(bus_rmt->tx_channel, &tx_cbs, bus_rmt),
+                      err, TAG, "register rmt tx done callback failed");
+
     // enable rmt channels
     ESP_GOTO_ON_ERROR(rmt_enable(bus_rmt->rx_channel), err, TAG, "enable rmt rx channel failed");
     ESP_GOTO_ON_ERROR(rmt_enable(bus_rmt->tx_channel), err, TAG, "enable rmt tx channel failed");
@@ -327,8 +423,10 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     bus_rmt->base.reset = onewire_bus_rmt_reset;
     bus_rmt->base.write_bit = onewire_bus_rmt_write_bit;
     bus_rmt->base.write_bytes = onewire_bus_rmt_write_bytes;
+    bus_rmt->base.write_bytes_pullup = onewire_bus_rmt_write_bytes_pullup;
     bus_rmt->base.read_bit = onewire_bus_rmt_read_bit;
     bus_rmt->base.read_bytes = onewire_bus_rmt_read_bytes;
+    bus_rmt->base.transaction = onewire_bus_rmt_transaction;
     *ret_bus = &bus_rmt->base;
 
     return ret;
@@ -366,6 +464,9 @@ static esp_err_t onewire_bus_rmt_destroy(onewire_bus_rmt_obj_t *bus_rmt)
     if (bus_rmt->rx_symbols_buf) {
         free(bus_rmt->rx_symbols_buf);
     }
+    if (bus_rmt->tx_symbols_buf) {
+        free(bus_rmt->tx_symbols_buf);
+    }
     free(bus_rmt);
     return ESP_OK;
 }
@@ -418,6 +519,29 @@ err:
     return ret;
 }
 
+static esp_err_t onewire_bus_rmt_write_bytes_pullup(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, int pullup_gpio_num, uint32_t pullup_level)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    esp_err_t ret = ESP_OK;
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    // arm the strong pull-up once earlier transmissions are done, the tx done callback of this transmission drives it
+    ESP_GOTO_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), err, TAG, "wait for 1-wire transmit failed");
+    bus_rmt->pullup_level = pullup_level;
+    bus_rmt->pullup_gpio_num = pullup_gpio_num;
+    // transmit data with the bytes encoder
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_bytes_encoder, tx_data, tx_data_size, &onewire_rmt_tx_config),
+                      err, TAG, "1-wire data transmit failed");
+    // wait the transmission to complete
+    ESP_GOTO_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), err, TAG, "wait for 1-wire data transmit failed");
+
+err:
+    // disarm, the pull-up is not driven when the transmission failed
+    bus_rmt->pullup_gpio_num = -1;
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ret;
+}
+
 // While receiving data, we use rmt transmit channel to send 0xFF to generate read pulse,
 // at the same time, receive channel is used to record weather the bus is pulled down by device.
 static esp_err_t onewire_bus_rmt_read_bytes(onewire_bus_handle_t bus, uint8_t *rx_buf, size_t rx_buf_size)
@@ -493,3 +617,54 @@ err:
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
+
+// The reset pulse, the written bytes and the read clock are encoded into one RMT symbol sequence and transmitted
+// with the copy encoder, while the receive channel records the presence pulse and the bits pulled down by device.
+static esp_err_t onewire_bus_rmt_transaction(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size, uint8_t *rx_buf, size_t rx_buf_size)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    esp_err_t ret = ESP_OK;
+
+    // the symbol buffers hold max_rx_bytes, split larger transactions
+    if (tx_data_size + rx_buf_size > bus_rmt->max_rx_bytes) {
+        ESP_RETURN_ON_ERROR(onewire_bus_rmt_reset(bus), TAG, "1-wire transaction reset failed");
+        ESP_RETURN_ON_ERROR(onewire_bus_rmt_write_bytes(bus, tx_data, tx_data_size), TAG, "1-wire transaction write failed");
+        if (rx_buf_size) {
+            ESP_RETURN_ON_ERROR(onewire_bus_rmt_read_bytes(bus, rx_buf, rx_buf_size), TAG, "1-wire transaction read failed");
+        }
+        return ESP_OK;
+    }
+    if (rx_buf_size) {
+        memset(rx_buf, 0, rx_buf_size);
+    }
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+
+    // encode reset pulse, tx bits (LSB first) and read clock (1 bits)
+    size_t symbol_num = 0;
+    bus_rmt->tx_symbols_buf[symbol_num ++] = onewire_transaction_reset_symbol;
+    for (size_t i = 0; i < tx_data_size * 8; i ++) {
+        bus_rmt->tx_symbols_buf[symbol_num ++] = (tx_data[i / 8] & (1 << (i % 8))) ? onewire_bit1_symbol : onewire_bit0_symbol;
+    }
+    for (size_t i = 0; i < rx_buf_size * 8; i ++) {
+        bus_rmt->tx_symbols_buf[symbol_num ++] = onewire_bit1_symbol;
+    }
+
+    // transmit the sequence while receiving
+    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, (bus_rmt->max_rx_bytes * 8 + ONEWIRE_RMT_TRANSACTION_RESET_SYMBOLS) * sizeof(rmt_symbol_word_t), &onewire_rmt_rx_config),
+                      err, TAG, "1-wire transaction receive failed");
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, bus_rmt->tx_symbols_buf, symbol_num * sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
+                      err, TAG, "1-wire transaction transmit failed");
+
+    // wait the transaction finishes, check presence pulse and decode data
+    rmt_rx_done_event_data_t rmt_rx_evt_data;
+    ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
+                      err, TAG, "1-wire transaction receive timeout");
+    if (onewire_rmt_decode_transaction(rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols, tx_data_size * 8, rx_buf, rx_buf_size) == false) {
+        ret = ESP_ERR_NOT_FOUND;
+    }
+
+err:
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ret;
+}
@@ -6,7 +6,9 @@
 
 #include "onewire_crc.h"
 
-#define FAST_CRC 1 // define this to use the fast CRC table
+#ifndef FAST_CRC
+#define FAST_CRC 1 // define this to use the fast CRC table, set to 0 to use the bitwise CRC
+#endif
 
 #if FAST_CRC
 
@@ -28,8 +28,6 @@
  * 
  * https://github.com/UncleRus/esp-idf-lib/blob/master/components/max31865/max31865.c
  * 
- * https://github.com/espressif/esp-idf/blob/v5.3.2/examples/peripherals/spi_master/hd_eeprom/components/eeprom/spi_eeprom.h
- *
  * Ported from esp-open-rtos
  *
  * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
@@ -43,8 +41,11 @@
 #include <esp_log.h>
 #include <esp_check.h>
 #include <esp_timer.h>
+#include <esp_attr.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
 
 /*
  * MAX31865 definitions
@@ -56,14 +57,18 @@
 #define SPI_MAX31865_REG_LOW_FAULT_MSB      UINT8_C(0x05)
 #define SPI_MAX31865_REG_FAULT_STATUS       UINT8_C(0x07)
 
-#define SPI_MAX31865_DATA_POLL_TIMEOUT_MS  UINT16_C(100)
-#define SPI_MAX31865_DATA_READY_DELAY_MS   UINT16_C(2)
-#define SPI_MAX31865_POWERUP_DELAY_MS      UINT16_C(120)
-#define SPI_MAX31865_RESET_DELAY_MS        UINT16_C(25)
-#define SPI_MAX31865_SETUP_DELAY_MS        UINT16_C(15)
-#define SPI_MAX31865_APPSTART_DELAY_MS     UINT16_C(10)    /*!< max31865 delay after initialization before application start-up */
-#define SPI_MAX31865_CMD_DELAY_MS          UINT16_C(5)     /*!< max31865 delay before attempting SPI transactions after a command is issued */
-#define SPI_MAX31865_TX_RX_DELAY_MS        UINT16_C(10)    /*!< max31865 delay after attempting an SPI transmit transaction and attempting an SPI receive transaction */
+#define SPI_MAX31865_REG_WRITE_FLAG         UINT8_C(0x80)   /*!< max31865 register address bit set for write transactions */
+#define SPI_MAX31865_SPI_MODE               (1)             /*!< max31865 SPI mode, CPHA = 1 (mode 1 or 3) */
+#define SPI_MAX31865_CLOCK_SPEED_MAX_HZ     INT32_C(5000000)
+
+#define SPI_MAX31865_DATA_POLL_TIMEOUT_MS   UINT16_C(100)
+#define SPI_MAX31865_DATA_POLL_DELAY_MS     UINT16_C(1)
+#define SPI_MAX31865_CONVERSION_60HZ_MS     UINT16_C(55)    /*!< max31865 1-shot conversion time with the 60Hz filter, 52ms maximum */
+#define SPI_MAX31865_CONVERSION_50HZ_MS     UINT16_C(65)    /*!< max31865 1-shot conversion time with the 50Hz filter, 62.5ms maximum */
+#define SPI_MAX31865_BIAS_SETTLE_DELAY_MS   UINT16_C(10)    /*!< max31865 delay after the bias voltage is enabled, 10.5 RTD input filter time constants plus 1ms */
+#define SPI_MAX31865_FAULT_CYCLE_DELAY_MS   UINT16_C(10)    /*!< max31865 manual fault detection cycle 1 delay, 5 RTD input filter time constants */
+#define SPI_MAX31865_FAULT_TIMEOUT_MS       UINT16_C(10)    /*!< max31865 fault detection timeout, automatic delay detection takes about 550us */
+#define SPI_MAX31865_POWERUP_DELAY_MS       UINT16_C(10)
 
 
 /*
@@ -77,47 +82,793 @@
 */
 static const char *TAG = "max31865";
 
+/**
+ * @brief Callendar-Van Dusen coefficients structure, R(T) = R0 (1 + A T + B T^2 + C (T - 100) T^3) 
+ * where C applies below 0 degrees Celsius.
+ */
 typedef struct {
-    float a, b;
+    float a, b, c;
 } spi_rtd_coeff_t;
 
-/*
 static const spi_rtd_coeff_t spi_rtd_coeff[] = {
-     [SPI_MAX31865_ITS90]         = { .a = 3.9083e-3f, .b = -5.775e-7f },
-     [SPI_MAX31865_DIN43760]      = { .a = 3.9848e-3f, .b = -5.8019e-7f },
-     [SPI_MAX31865_US_INDUSTRIAL] = { .a = 3.9692e-3f, .b = -5.8495e-7f },
+     [SPI_MAX31865_ITS90]         = { .a = 3.9083e-3f, .b = -5.775e-7f,  .c = -4.183e-12f },
+     [SPI_MAX31865_DIN43760]      = { .a = 3.9848e-3f, .b = -5.8019e-7f, .c = -4.0e-12f },
+     [SPI_MAX31865_US_INDUSTRIAL] = { .a = 3.9692e-3f, .b = -5.8495e-7f, .c = -4.2325e-12f },
 };
-*/
 
+/**
+ * @brief MAX31865 pipeline structure definition.
+ */
+struct spi_max31865_pipeline_s {
+    spi_max31865_pipeline_config_t  config;             /*!< max31865 pipeline configuration */
+    TaskHandle_t                    task_handle;        /*!< max31865 pipeline task handle */
+    QueueHandle_t                   queue_handle;       /*!< max31865 pipeline sample queue handle */
+    SemaphoreHandle_t               stopped_handle;     /*!< max31865 pipeline task stopped semaphore handle */
+    portMUX_TYPE                    spinlock;           /*!< max31865 pipeline isr and task shared state spinlock */
+    volatile bool                   stop_requested;     /*!< max31865 pipeline task stops when true */
+    int64_t                         irq_time;           /*!< max31865 time of the last DRDY interrupt in micro-seconds */
+    spi_max31865_pipeline_stats_t   stats;              /*!< max31865 pipeline statistics */
+};
+
+
+/**
+ * @brief MAX31865 SPI HAL read from register address transaction, registers auto-increment.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param reg_addr MAX31865 register address to read from.
+ * @param buffer Buffer to store results from read transaction.
+ * @param size Length of buffer to store results from read transaction, 1 to 4 bytes.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_read_from(spi_max31865_handle_t handle, const uint8_t reg_addr, uint8_t *buffer, const uint8_t size) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && buffer && size > 0 && size <= 4 );
+
+    spi_transaction_t trans = {
+        .flags      = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA,
+        .addr       = reg_addr & ~SPI_MAX31865_REG_WRITE_FLAG,
+        .length     = size * 8,
+        .rxlength   = size * 8,
+    };
 
-static inline void spi_max31865_cs_high(spi_transaction_t* t) {
-    ESP_EARLY_LOGV(TAG, "cs high %d.", ((spi_max31865_handle_t)t->user)->spi_dev_config.cs_io_num);
-    gpio_set_level(((spi_max31865_handle_t)t->user)->spi_dev_config.cs_io_num, 1);
+    ESP_RETURN_ON_ERROR( spi_device_polling_transmit(handle->spi_dev_handle, &trans), TAG, "spi_device_polling_transmit, read from failed" );
+
+    memcpy(buffer, trans.rx_data, size);
+
+    return ESP_OK;
 }
 
-static inline void spi_max31865_cs_low(spi_transaction_t* t) {
-    gpio_set_level(((spi_max31865_handle_t)t->user)->spi_dev_config.cs_io_num, 0);
-    ESP_EARLY_LOGV(TAG, "cs low %d.", ((spi_max31865_handle_t)t->user)->spi_dev_config.cs_io_num);
+/**
+ * @brief MAX31865 SPI HAL write to register address transaction, registers auto-increment.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param reg_addr MAX31865 register address to write to.
+ * @param buffer Buffer to write.
+ * @param size Length of buffer to write, 1 to 4 bytes.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_write_to(spi_max31865_handle_t handle, const uint8_t reg_addr, const uint8_t *buffer, const uint8_t size) {
+    /* validate arguments */
+    ESP_ARG_CHECK( handle && buffer && size > 0 && size <= 4 );
+
+    spi_transaction_t trans = {
+        .flags      = SPI_TRANS_USE_TXDATA,
+        .addr       = reg_addr | SPI_MAX31865_REG_WRITE_FLAG,
+        .length     = size * 8,
+    };
+
+    memcpy(trans.tx_data, buffer, size);
+
+    ESP_RETURN_ON_ERROR( spi_device_polling_transmit(handle->spi_dev_handle, &trans), TAG, "spi_device_polling_transmit, write to failed" );
+
+    return ESP_OK;
 }
 
-void spi_max31865_ready_rising_isr(void* arg) {
-    spi_max31865_handle_t handle = (spi_max31865_handle_t)arg;
-    xSemaphoreGive(handle->spi_ready_sem);
-    ESP_EARLY_LOGV(TAG, "ready detected.");
+/**
+ * @brief Callendar-Van Dusen resistance ratio R(T) / R0 at a temperature.
+ * 
+ * @param coeff Callendar-Van Dusen coefficients.
+ * @param temperature Temperature in degrees Celsius.
+ * @return double Resistance ratio.
+ */
+static inline double spi_max31865_cvd_ratio(const spi_rtd_coeff_t *coeff, const double temperature) {
+    const double t = temperature;
+    double ratio = 1.0 + coeff->a * t + coeff->b * t * t;
+
+    if (t < 0.0) ratio += coeff->c * (t - 100.0) * t * t * t;
+
+    return ratio;
 }
 
+/**
+ * @brief Converts a resistance ratio to temperature with the inverse Callendar-Van Dusen equation.  
+ * At and above 0 degrees Celsius the quadratic is solved in closed form, the root is written in 
+ * its conjugate form to avoid cancellation near 0 degrees Celsius.  Below 0 degrees Celsius the 
+ * quadratic root seeds two Newton iterations on the full equation including the C term.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param ratio Resistance ratio R(T) / R0.
+ * @return float Temperature in degrees Celsius.
+ */
+static inline float spi_max31865_polynomial_temperature(spi_max31865_handle_t handle, const float ratio) {
+    const float a = handle->rtd_a;
+    const float b = handle->rtd_b;
+    const float c = handle->rtd_c;
 
-esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_max31865_handle_t *max31865_handle) {
+    /* t = (-a + sqrt(a^2 - 4b(1 - ratio))) / 2b = 2(ratio - 1) / (a + sqrt(a^2 - 4b(1 - ratio))) */
+    float t = 2.0f * (ratio - 1.0f) / (a + sqrtf(a * a - 4.0f * b * (1.0f - ratio)));
+
+    if (t >= 0.0f) return t;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        const float t2 = t * t;
+        const float f  = 1.0f + a * t + b * t2 + c * (t - 100.0f) * t2 * t - ratio;
+        const float df = a + 2.0f * b * t + c * (4.0f * t - 300.0f) * t2;
+        t -= f / df;
+    }
+
+    return t;
+}
+
+/**
+ * @brief Converts a resistance ratio to temperature with the lookup-table, the table is uniform in 
+ * temperature and searched by bisection on the resistance ratio.  Ratios outside of the table 
+ * are converted with the polynomial inverse.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param ratio Resistance ratio R(T) / R0.
+ * @return float Temperature in degrees Celsius.
+ */
+static inline float spi_max31865_lut_temperature(spi_max31865_handle_t handle, const float ratio) {
+    const float *lut = handle->rtd_lut;
+    uint16_t low = 0;
+    uint16_t high = SPI_MAX31865_LUT_SIZE - 1;
+
+    if (ratio < lut[low] || ratio > lut[high]) return spi_max31865_polynomial_temperature(handle, ratio);
+
+    while (high - low > 1) {
+        const uint16_t middle = low + (high - low) / 2;
+        if (lut[middle] <= ratio) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    const float fraction = (ratio - lut[low]) / (lut[high] - lut[low]);
+
+    return SPI_MAX31865_LUT_TEMPERATURE_MIN + ((float)low + fraction) * SPI_MAX31865_LUT_TEMPERATURE_STEP;
+}
+
+/**
+ * @brief Builds the MAX31865 lookup-table of resistance ratios from the forward Callendar-Van Dusen equation.
+ * 
+ * @param handle MAX31865 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_build_lut(spi_max31865_handle_t handle) {
+    const spi_rtd_coeff_t *coeff = &spi_rtd_coeff[handle->spi_dev_config.standard];
+
+    handle->rtd_lut = (float*)calloc(SPI_MAX31865_LUT_SIZE, sizeof(float));
+    ESP_RETURN_ON_FALSE( handle->rtd_lut, ESP_ERR_NO_MEM, TAG, "no memory for lookup-table, build lookup-table failed" );
+
+    for (uint16_t i = 0; i < SPI_MAX31865_LUT_SIZE; i++) {
+        const double temperature = (double)SPI_MAX31865_LUT_TEMPERATURE_MIN + (double)i * (double)SPI_MAX31865_LUT_TEMPERATURE_STEP;
+        handle->rtd_lut[i] = (float)spi_max31865_cvd_ratio(coeff, temperature);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Converts a resistance in Ohms to a 15-bit code of the reference resistance.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param resistance Resistance in Ohms.
+ * @return uint16_t 15-bit code.
+ */
+static inline uint16_t spi_max31865_resistance_to_code(spi_max31865_handle_t handle, const float resistance) {
+    const float code = resistance / handle->spi_dev_config.r_ref * 32768.0f;
+
+    if (code <= 0.0f) return 0;
+    if (code >= (float)SPI_MAX31865_RTD_CODE_MAX) return SPI_MAX31865_RTD_CODE_MAX;
+
+    return (uint16_t)lroundf(code);
+}
+
+/**
+ * @brief Converts a 15-bit code of the reference resistance to a resistance in Ohms.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param code 15-bit code.
+ * @return float Resistance in Ohms.
+ */
+static inline float spi_max31865_code_to_resistance(spi_max31865_handle_t handle, const uint16_t code) {
+    return (float)code * handle->spi_dev_config.r_ref / 32768.0f;
+}
+
+/**
+ * @brief Reads the MAX31865 RTD registers, reading the RTD registers returns DRDY high.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param[out] rtd_code 15-bit RTD conversion code.
+ * @param[out] fault RTD fault flag.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_read_rtd(spi_max31865_handle_t handle, uint16_t *const rtd_code, bool *const fault) {
+    uint8_t rx[2] = { 0 };
+
+    ESP_RETURN_ON_ERROR( spi_max31865_read_from(handle, SPI_MAX31865_REG_RTD_MSB, rx, sizeof(rx)), TAG, "read rtd registers failed" );
+
+    const uint16_t raw = ((uint16_t)rx[0] << 8) | rx[1];
+
+    *rtd_code = raw >> 1;
+    *fault    = (raw & 0x0001) != 0;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Waits for a MAX31865 conversion, the DRDY pin is polled when it is connected.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param delay_ms Delay before DRDY is polled, or the full conversion delay when DRDY is not connected.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_wait_for_data(spi_max31865_handle_t handle, const uint16_t delay_ms) {
+    if (delay_ms > 0) vTaskDelay(pdMS_TO_TICKS(delay_ms));
+
+    if (handle->spi_dev_config.irq_io_num == GPIO_NUM_NC) return ESP_OK;
+
+    const int64_t start_time = esp_timer_get_time();
+
+    /* DRDY is active low */
+    while (gpio_get_level(handle->spi_dev_config.irq_io_num) != 0) {
+        if (ESP_TIMEOUT_CHECK(start_time, (SPI_MAX31865_DATA_POLL_TIMEOUT_MS * 1000)))
+            return ESP_ERR_TIMEOUT;
+
+        vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_DATA_POLL_DELAY_MS));
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Triggers a MAX31865 1-shot conversion and waits for it.  The bias voltage is enabled for 
+ * the conversion when it is disabled.
+ * 
+ * @param handle MAX31865 device handle.
+ * @param[out] rtd_code 15-bit RTD conversion code.
+ * @param[out] fault RTD fault flag.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_single_conversion(spi_max31865_handle_t handle, uint16_t *const rtd_code, bool *const fault) {
+    esp_err_t ret = ESP_OK;
+    const bool bias_enabled = handle->config_reg.bits.v_bias_enabled;
+
+    if (bias_enabled == false) {
+        /* attempt to enable bias voltage and wait for the rtd input filter to settle */
+        ESP_RETURN_ON_ERROR( spi_max31865_set_bias(handle, true), TAG, "unable to enable bias voltage, single conversion failed" );
+
+        vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_BIAS_SETTLE_DELAY_MS));
+    }
+
+    /* attempt to trigger 1-shot conversion */
+    spi_max31865_configuration_register_t config_reg = handle->config_reg;
+    config_reg.bits.one_shot_enabled = true;
+    ESP_GOTO_ON_ERROR( spi_max31865_write_to(handle, SPI_MAX31865_REG_CONFIG, &config_reg.reg, 1), err, TAG, "unable to write configuration register, single conversion failed" );
+
+    const uint16_t delay_ms = (handle->config_reg.bits.filter == SPI_MAX31865_FILTER_50HZ) ? SPI_MAX31865_CONVERSION_50HZ_MS : SPI_MAX31865_CONVERSION_60HZ_MS;
+
+    ESP_GOTO_ON_ERROR( spi_max31865_wait_for_data(handle, delay_ms), err, TAG, "data ready timeout, single conversion failed" );
+
+    ESP_GOTO_ON_ERROR( spi_max31865_read_rtd(handle, rtd_code, fault), err, TAG, "unable to read rtd, single conversion failed" );
+
+    err:
+        /* bias voltage is disabled between conversions to reduce self-heating */
+        if (bias_enabled == false) {
+            esp_err_t bias_ret = spi_max31865_set_bias(handle, false);
+            if (ret == ESP_OK) ret = bias_ret;
+        }
+        return ret;
+}
+
+/**
+ * @brief Waits for a MAX31865 fault detection cycle to finish.
+ * 
+ * @param handle MAX31865 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t spi_max31865_wait_for_fault_detection(spi_max31865_handle_t handle) {
+    spi_max31865_configuration_register_t config_reg;
+    const int64_t start_time = esp_timer_get_time();
+
+    do {
+        vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_DATA_POLL_DELAY_MS));
+
+        ESP_RETURN_ON_ERROR( spi_max31865_get_configuration_register(handle, &config_reg), TAG, "unable to read configuration register, wait for fault detection failed" );
+
+        if (config_reg.bits.fault_detection == SPI_MAX31865_FAULT_DETECT_FINISHED) return ESP_OK;
+    } while (!ESP_TIMEOUT_CHECK(start_time, (SPI_MAX31865_FAULT_TIMEOUT_MS * 1000)));
+
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t spi_max31865_get_configuration_register(spi_max31865_handle_t max31865_handle, spi_max31865_configuration_register_t *const config_reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && config_reg );
+
+    /* attempt to read configuration register */
+    ESP_RETURN_ON_ERROR( spi_max31865_read_from(max31865_handle, SPI_MAX31865_REG_CONFIG, &config_reg->reg, 1), TAG, "read configuration register failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_set_configuration_register(spi_max31865_handle_t max31865_handle, const spi_max31865_configuration_register_t config_reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    /* attempt to write configuration register */
+    ESP_RETURN_ON_ERROR( spi_max31865_write_to(max31865_handle, SPI_MAX31865_REG_CONFIG, &config_reg.reg, 1), TAG, "write configuration register failed" );
+
+    /* self-clearing bits are not retained */
+    max31865_handle->config_reg = config_reg;
+    max31865_handle->config_reg.bits.clear_fault_status = false;
+    max31865_handle->config_reg.bits.one_shot_enabled   = false;
+    max31865_handle->config_reg.bits.fault_detection    = SPI_MAX31865_FAULT_DETECT_FINISHED;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_fault_status_register(spi_max31865_handle_t max31865_handle, spi_max31865_fault_status_register_t *const fault_status_reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && fault_status_reg );
+
+    /* attempt to read fault status register */
+    ESP_RETURN_ON_ERROR( spi_max31865_read_from(max31865_handle, SPI_MAX31865_REG_FAULT_STATUS, &fault_status_reg->reg, 1), TAG, "read fault status register failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_clear_fault_status(spi_max31865_handle_t max31865_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    /* fault status clear is written with the 1-shot and fault detection bits cleared */
+    spi_max31865_configuration_register_t config_reg = max31865_handle->config_reg;
+    config_reg.bits.clear_fault_status = true;
+
+    /* attempt to write configuration register */
+    ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to write configuration register, clear fault status failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_fault_thresholds(spi_max31865_handle_t max31865_handle, float *const low_resistance, float *const high_resistance) {
+    uint8_t rx[4] = { 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && low_resistance && high_resistance );
+
+    /* attempt to read high and low fault threshold registers */
+    ESP_RETURN_ON_ERROR( spi_max31865_read_from(max31865_handle, SPI_MAX31865_REG_HIGH_FAULT_MSB, rx, sizeof(rx)), TAG, "read fault threshold registers failed" );
+
+    const uint16_t high_code = (((uint16_t)rx[0] << 8) | rx[1]) >> 1;
+    const uint16_t low_code  = (((uint16_t)rx[2] << 8) | rx[3]) >> 1;
+
+    *high_resistance = spi_max31865_code_to_resistance(max31865_handle, high_code);
+    *low_resistance  = spi_max31865_code_to_resistance(max31865_handle, low_code);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_set_fault_thresholds(spi_max31865_handle_t max31865_handle, const float low_resistance, const float high_resistance) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && low_resistance >= 0.0f && low_resistance < high_resistance );
+
+    const uint16_t high_code = spi_max31865_resistance_to_code(max31865_handle, high_resistance) << 1;
+    const uint16_t low_code  = spi_max31865_resistance_to_code(max31865_handle, low_resistance) << 1;
+    const uint8_t  tx[4]     = { (uint8_t)(high_code >> 8), (uint8_t)high_code, (uint8_t)(low_code >> 8), (uint8_t)low_code };
+
+    /* attempt to write high and low fault threshold registers */
+    ESP_RETURN_ON_ERROR( spi_max31865_write_to(max31865_handle, SPI_MAX31865_REG_HIGH_FAULT_MSB, tx, sizeof(tx)), TAG, "write fault threshold registers failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_run_fault_detection(spi_max31865_handle_t max31865_handle, const spi_max31865_fault_detection_methods_t method, spi_max31865_fault_status_register_t *const fault_status_reg) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && fault_status_reg );
+
+    if (max31865_handle->pipeline) return ESP_ERR_INVALID_STATE;
+
+    const spi_max31865_configuration_register_t restore_reg = max31865_handle->config_reg;
+    spi_max31865_configuration_register_t config_reg = { .reg = 0 };
+
+    /* fault detection is written as 100X010X (automatic) or 100X100X then 100X110X (manual), X is retained */
+    config_reg.bits.v_bias_enabled = true;
+    config_reg.bits.connection     = restore_reg.bits.connection;
+    config_reg.bits.filter         = restore_reg.bits.filter;
+
+    if (method == SPI_MAX31865_FAULT_DETECTION_AUTOMATIC) {
+        config_reg.bits.fault_detection = SPI_MAX31865_FAULT_DETECT_STILL_RUNNING;
+        ESP_RETURN_ON_ERROR( spi_max31865_write_to(max31865_handle, SPI_MAX31865_REG_CONFIG, &config_reg.reg, 1), TAG, "unable to write configuration register, run fault detection failed" );
+    } else {
+        config_reg.bits.fault_detection = SPI_MAX31865_FAULT_DETECT_CYCLE1_RUNNING;
+        ESP_RETURN_ON_ERROR( spi_max31865_write_to(max31865_handle, SPI_MAX31865_REG_CONFIG, &config_reg.reg, 1), TAG, "unable to write configuration register, run fault detection failed" );
+
+        /* rtd input filter settles for 5 time constants before cycle 2 */
+        vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_FAULT_CYCLE_DELAY_MS));
+
+        config_reg.bits.fault_detection = SPI_MAX31865_FAULT_DETECT_CYCLE2_RUNNING;
+        ESP_GOTO_ON_ERROR( spi_max31865_write_to(max31865_handle, SPI_MAX31865_REG_CONFIG, &config_reg.reg, 1), err, TAG, "unable to write configuration register, run fault detection failed" );
+    }
+
+    ESP_GOTO_ON_ERROR( spi_max31865_wait_for_fault_detection(max31865_handle), err, TAG, "fault detection timeout, run fault detection failed" );
+
+    ESP_GOTO_ON_ERROR( spi_max31865_get_fault_status_register(max31865_handle, fault_status_reg), err, TAG, "unable to read fault status register, run fault detection failed" );
+
+    err:
+        /* restore conversion mode and bias voltage */
+        if (spi_max31865_set_configuration_register(max31865_handle, restore_reg) != ESP_OK && ret == ESP_OK) {
+            ret = ESP_FAIL;
+        }
+        return ret;
+}
+
+esp_err_t spi_max31865_set_mode(spi_max31865_handle_t max31865_handle, const spi_max31865_modes_t mode) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    spi_max31865_configuration_register_t config_reg = max31865_handle->config_reg;
+
+    /* automatic conversions require the bias voltage */
+    config_reg.bits.mode = mode;
+    if (mode == SPI_MAX31865_MODE_AUTO) {
+        config_reg.bits.v_bias_enabled = true;
+    } else {
+        config_reg.bits.v_bias_enabled = max31865_handle->spi_dev_config.v_bias_enabled;
+    }
+
+    /* attempt to write configuration register */
+    ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to write configuration register, set mode failed" );
+
+    max31865_handle->spi_dev_config.mode = mode;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_set_filter(spi_max31865_handle_t max31865_handle, const spi_max31865_filters_t filter) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    spi_max31865_configuration_register_t config_reg = max31865_handle->config_reg;
+    const bool automatic = (config_reg.bits.mode == SPI_MAX31865_MODE_AUTO);
+
+    /* notch frequency is not changed while automatic conversions are running */
+    if (automatic) {
+        config_reg.bits.mode = SPI_MAX31865_MODE_SINGLE;
+        ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to suspend automatic conversions, set filter failed" );
+    }
+
+    /* attempt to write configuration register */
+    config_reg.bits.filter = filter;
+    ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to write configuration register, set filter failed" );
+
+    if (automatic) {
+        config_reg.bits.mode = SPI_MAX31865_MODE_AUTO;
+        ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to resume automatic conversions, set filter failed" );
+    }
+
+    max31865_handle->spi_dev_config.filter = filter;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_set_bias(spi_max31865_handle_t max31865_handle, const bool enabled) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    spi_max31865_configuration_register_t config_reg = max31865_handle->config_reg;
+
+    /* automatic conversions require the bias voltage */
+    if (enabled == false && config_reg.bits.mode == SPI_MAX31865_MODE_AUTO) return ESP_ERR_INVALID_STATE;
+
+    /* attempt to write configuration register */
+    config_reg.bits.v_bias_enabled = enabled;
+    ESP_RETURN_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), TAG, "unable to write configuration register, set bias failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_rtd_code(spi_max31865_handle_t max31865_handle, uint16_t *const rtd_code) {
+    bool fault = false;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && rtd_code );
+
+    /* conversions are read by the pipeline task while the pipeline is running */
+    if (max31865_handle->pipeline) return ESP_ERR_INVALID_STATE;
+
+    if (max31865_handle->config_reg.bits.mode == SPI_MAX31865_MODE_SINGLE) {
+        /* attempt 1-shot conversion */
+        ESP_RETURN_ON_ERROR( spi_max31865_single_conversion(max31865_handle, rtd_code, &fault), TAG, "unable to convert, get rtd code failed" );
+    } else {
+        /* attempt to wait for the next automatic conversion, the latest is read without DRDY */
+        ESP_RETURN_ON_ERROR( spi_max31865_wait_for_data(max31865_handle, 0), TAG, "data ready timeout, get rtd code failed" );
+
+        ESP_RETURN_ON_ERROR( spi_max31865_read_rtd(max31865_handle, rtd_code, &fault), TAG, "unable to read rtd, get rtd code failed" );
+    }
+
+    if (fault) {
+        spi_max31865_fault_status_register_t fault_status_reg = { .reg = 0 };
+
+        spi_max31865_get_fault_status_register(max31865_handle, &fault_status_reg);
+
+        ESP_LOGW(TAG, "rtd fault detected (fault status 0x%02x)", fault_status_reg.reg);
+
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_resistance(spi_max31865_handle_t max31865_handle, float *const resistance) {
+    uint16_t rtd_code;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && resistance );
+
+    /* attempt to read rtd code */
+    ESP_RETURN_ON_ERROR( spi_max31865_get_rtd_code(max31865_handle, &rtd_code), TAG, "unable to read rtd code, get resistance failed" );
+
+    *resistance = spi_max31865_code_to_resistance(max31865_handle, rtd_code);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_measurement(spi_max31865_handle_t max31865_handle, float *const temperature) {
+    float resistance;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && temperature );
+
+    /* attempt to read rtd resistance */
+    ESP_RETURN_ON_ERROR( spi_max31865_get_resistance(max31865_handle, &resistance), TAG, "unable to read resistance, get measurement failed" );
+
+    return spi_max31865_convert_temperature(max31865_handle, resistance, temperature);
+}
+
+esp_err_t spi_max31865_convert_temperature(spi_max31865_handle_t max31865_handle, const float resistance, float *const temperature) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && temperature );
+
+    const float ratio = resistance / max31865_handle->spi_dev_config.rtd_nominal;
+
+    if (max31865_handle->rtd_lut) {
+        *temperature = spi_max31865_lut_temperature(max31865_handle, ratio);
+    } else {
+        *temperature = spi_max31865_polynomial_temperature(max31865_handle, ratio);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief MAX31865 pipeline GPIO interrupt handler, timestamps the DRDY falling edge and wakes the pipeline task.
+ * 
+ * @param pvParameters MAX31865 device handle.
+ */
+static void IRAM_ATTR spi_max31865_pipeline_isr_handler(void *pvParameters) {
+    spi_max31865_handle_t handle = (spi_max31865_handle_t)pvParameters;
+    struct spi_max31865_pipeline_s *pipeline = handle->pipeline;
+    BaseType_t task_woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&pipeline->spinlock);
+    pipeline->irq_time = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&pipeline->spinlock);
+
+    vTaskNotifyGiveFromISR(pipeline->task_handle, &task_woken);
+    if (task_woken == pdTRUE) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Publishes a sample to the pipeline callback and sample queue.
+ * 
+ * @param pipeline MAX31865 pipeline.
+ * @param sample MAX31865 pipeline sample.
+ */
+static inline void spi_max31865_pipeline_publish(struct spi_max31865_pipeline_s *const pipeline, const spi_max31865_pipeline_sample_t *sample) {
+    uint32_t dropped = 0;
+
+    if (pipeline->config.callback) pipeline->config.callback(sample, pipeline->config.callback_arg);
+
+    if (pipeline->queue_handle && xQueueSend(pipeline->queue_handle, sample, 0) != pdTRUE) dropped++;
+
+    portENTER_CRITICAL(&pipeline->spinlock);
+    pipeline->stats.samples++;
+    pipeline->stats.dropped += dropped;
+    if (sample->fault) pipeline->stats.faults++;
+    portEXIT_CRITICAL(&pipeline->spinlock);
+}
+
+/**
+ * @brief MAX31865 pipeline task entry, blocks until the interrupt handler notifies the task, 
+ * reads the conversion which returns DRDY high, and publishes a timestamped sample.
+ * 
+ * @param pvParameters MAX31865 device handle.
+ */
+static void spi_max31865_pipeline_task_entry(void *pvParameters) {
+    spi_max31865_handle_t handle = (spi_max31865_handle_t)pvParameters;
+    struct spi_max31865_pipeline_s *pipeline = handle->pipeline;
+
+    for ( ;; ) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (pipeline->stop_requested) break;
+
+        /* DRDY high, the start-up notification found no unread conversion */
+        if (gpio_get_level(handle->spi_dev_config.irq_io_num) != 0) continue;
+
+        spi_max31865_pipeline_sample_t sample = { 0 };
+
+        portENTER_CRITICAL(&pipeline->spinlock);
+        sample.timestamp = pipeline->irq_time;
+        portEXIT_CRITICAL(&pipeline->spinlock);
+
+        if (spi_max31865_read_rtd(handle, &sample.rtd_code, &sample.fault) != ESP_OK ||
+            (sample.fault && spi_max31865_get_fault_status_register(handle, &sample.fault_status) != ESP_OK)) {
+            ESP_LOGE(TAG, "pipeline read rtd failed");
+
+            portENTER_CRITICAL(&pipeline->spinlock);
+            pipeline->stats.errors++;
+            portEXIT_CRITICAL(&pipeline->spinlock);
+            continue;
+        }
+
+        if (sample.fault == false) {
+            sample.resistance = spi_max31865_code_to_resistance(handle, sample.rtd_code);
+            spi_max31865_convert_temperature(handle, sample.resistance, &sample.temperature);
+        }
+
+        spi_max31865_pipeline_publish(pipeline, &sample);
+    }
+
+    xSemaphoreGive(pipeline->stopped_handle);
+    vTaskDelete( NULL );
+}
+
+esp_err_t spi_max31865_start_pipeline(spi_max31865_handle_t max31865_handle, const spi_max31865_pipeline_config_t *config) {
     esp_err_t ret = ESP_OK;
 
     /* validate arguments */
-    ESP_ARG_CHECK( max31865_config );
+    ESP_ARG_CHECK( max31865_handle && config );
 
-    /* validate host and interrupt */
-    if (max31865_config->irq_enabled == true && max31865_config->host == SPI1_HOST) {
-        ESP_GOTO_ON_FALSE(false, ESP_ERR_INVALID_ARG, err, TAG, "interrupt cannot be used on SPI1 host, init failed");
+    /* pipeline is driven by the DRDY pin */
+    if (max31865_handle->spi_dev_config.irq_io_num == GPIO_NUM_NC || max31865_handle->pipeline) return ESP_ERR_INVALID_STATE;
+
+    /* validate memory availability for pipeline */
+    struct spi_max31865_pipeline_s *pipeline = (struct spi_max31865_pipeline_s*)calloc(1, sizeof(struct spi_max31865_pipeline_s));
+    ESP_RETURN_ON_FALSE( pipeline, ESP_ERR_NO_MEM, TAG, "no memory for max31865 pipeline, start pipeline failed" );
+
+    pipeline->config = *config;
+    portMUX_INITIALIZE(&pipeline->spinlock);
+
+    pipeline->stopped_handle = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE( pipeline->stopped_handle, ESP_ERR_NO_MEM, err, TAG, "create pipeline stopped semaphore failed" );
+
+    if (config->queue_length > 0) {
+        pipeline->queue_handle = xQueueCreate(config->queue_length, sizeof(spi_max31865_pipeline_sample_t));
+        ESP_GOTO_ON_FALSE( pipeline->queue_handle, ESP_ERR_NO_MEM, err_semaphore, TAG, "create pipeline sample queue failed" );
     }
 
+    /* attempt to configure DRDY interrupt on the falling edge */
+    ESP_GOTO_ON_ERROR( gpio_set_intr_type(max31865_handle->spi_dev_config.irq_io_num, GPIO_INTR_NEGEDGE), err_queue, TAG, "unable to configure DRDY interrupt, start pipeline failed" );
+
+    max31865_handle->pipeline = pipeline;
+
+    BaseType_t task_err = xTaskCreatePinnedToCore( 
+        spi_max31865_pipeline_task_entry, 
+        SPI_MAX31865_PIPELINE_TASK_NAME, 
+        SPI_MAX31865_PIPELINE_TASK_STACK_SIZE, 
+        max31865_handle, 
+        SPI_MAX31865_PIPELINE_TASK_PRIORITY,
+        &pipeline->task_handle, 
+        APP_CPU_NUM );
+    ESP_GOTO_ON_FALSE( task_err == pdPASS, ESP_ERR_NO_MEM, err_handle, TAG, "create max31865 pipeline task failed" );
+
+    /* attempt to register pipeline isr */
+    ESP_GOTO_ON_ERROR( gpio_isr_handler_add(max31865_handle->spi_dev_config.irq_io_num, spi_max31865_pipeline_isr_handler, max31865_handle), err_task, TAG, "unable to register isr, start pipeline failed" );
+    ESP_GOTO_ON_ERROR( gpio_intr_enable(max31865_handle->spi_dev_config.irq_io_num), err_isr, TAG, "unable to enable interrupt, start pipeline failed" );
+
+    /* attempt to start automatic conversions, the configured mode is restored when the pipeline stops */
+    spi_max31865_configuration_register_t config_reg = max31865_handle->config_reg;
+    config_reg.bits.mode           = SPI_MAX31865_MODE_AUTO;
+    config_reg.bits.v_bias_enabled = true;
+    ESP_GOTO_ON_ERROR( spi_max31865_set_configuration_register(max31865_handle, config_reg), err_isr, TAG, "unable to start automatic conversions, start pipeline failed" );
+
+    /* DRDY may already be low from an unread conversion, there is no falling edge until it is read */
+    xTaskNotifyGive(pipeline->task_handle);
+
+    return ESP_OK;
+
+    err_isr:
+        gpio_intr_disable(max31865_handle->spi_dev_config.irq_io_num);
+        gpio_isr_handler_remove(max31865_handle->spi_dev_config.irq_io_num);
+    err_task:
+        pipeline->stop_requested = true;
+        xTaskNotifyGive(pipeline->task_handle);
+        xSemaphoreTake(pipeline->stopped_handle, portMAX_DELAY);
+    err_handle:
+        max31865_handle->pipeline = NULL;
+    err_queue:
+        if (pipeline->queue_handle) vQueueDelete(pipeline->queue_handle);
+    err_semaphore:
+        vSemaphoreDelete(pipeline->stopped_handle);
+    err:
+        free(pipeline);
+        return ret;
+}
+
+esp_err_t spi_max31865_stop_pipeline(spi_max31865_handle_t max31865_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle );
+
+    struct spi_max31865_pipeline_s *pipeline = max31865_handle->pipeline;
+    if (pipeline == NULL) return ESP_OK;
+
+    /* attempt to remove isr, interrupts no longer reach the pipeline */
+    gpio_intr_disable(max31865_handle->spi_dev_config.irq_io_num);
+    gpio_isr_handler_remove(max31865_handle->spi_dev_config.irq_io_num);
+
+    /* stop pipeline task */
+    pipeline->stop_requested = true;
+    xTaskNotifyGive(pipeline->task_handle);
+    xSemaphoreTake(pipeline->stopped_handle, portMAX_DELAY);
+
+    max31865_handle->pipeline = NULL;
+    if (pipeline->queue_handle) vQueueDelete(pipeline->queue_handle);
+    vSemaphoreDelete(pipeline->stopped_handle);
+    free(pipeline);
+
+    /* restore configured conversion mode */
+    return spi_max31865_set_mode(max31865_handle, max31865_handle->spi_dev_config.mode);
+}
+
+esp_err_t spi_max31865_get_pipeline_queue(spi_max31865_handle_t max31865_handle, QueueHandle_t *const queue) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && queue );
+
+    if (max31865_handle->pipeline == NULL) return ESP_ERR_INVALID_STATE;
+
+    *queue = max31865_handle->pipeline->queue_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_get_pipeline_stats(spi_max31865_handle_t max31865_handle, spi_max31865_pipeline_stats_t *const stats) {
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_handle && stats );
+
+    if (max31865_handle->pipeline == NULL) return ESP_ERR_INVALID_STATE;
+
+    portENTER_CRITICAL(&max31865_handle->pipeline->spinlock);
+    *stats = max31865_handle->pipeline->stats;
+    portEXIT_CRITICAL(&max31865_handle->pipeline->spinlock);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_max31865_handle_t *max31865_handle) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( max31865_config && max31865_handle );
+    ESP_ARG_CHECK( max31865_config->standard <= SPI_MAX31865_US_INDUSTRIAL && max31865_config->rtd_nominal > 0.0f && max31865_config->r_ref > 0.0f );
+    ESP_ARG_CHECK( max31865_config->clock_speed_hz > 0 && max31865_config->clock_speed_hz <= SPI_MAX31865_CLOCK_SPEED_MAX_HZ );
+
     /* validate memory availability for handle */
     spi_max31865_handle_t out_handle = (spi_max31865_handle_t)calloc(1, sizeof(spi_max31865_t));
     ESP_GOTO_ON_FALSE(out_handle, ESP_ERR_NO_MEM, err, TAG, "no memory for spi max31865 device, init failed");
@@ -125,44 +876,57 @@ esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_ma
     /* copy configuration to device handle */
     out_handle->spi_dev_config = *max31865_config;
 
-    /* set device configuration */
-    spi_device_interface_config_t spi_dev_conf = {
-        .command_bits = 10,
+    /* copy Callendar-Van Dusen coefficients of the standard */
+    out_handle->rtd_a = spi_rtd_coeff[out_handle->spi_dev_config.standard].a;
+    out_handle->rtd_b = spi_rtd_coeff[out_handle->spi_dev_config.standard].b;
+    out_handle->rtd_c = spi_rtd_coeff[out_handle->spi_dev_config.standard].c;
+
+    if (out_handle->spi_dev_config.conversion == SPI_MAX31865_CONVERSION_LOOKUP_TABLE) {
+        ESP_GOTO_ON_ERROR( spi_max31865_build_lut(out_handle), err_handle, TAG, "unable to build lookup-table, init failed" );
+    }
+
+    /* set device configuration, the register address is sent in the address phase */
+    const spi_device_interface_config_t spi_dev_conf = {
+        .address_bits   = 8,
         .clock_speed_hz = out_handle->spi_dev_config.clock_speed_hz,
-        .mode = 0,          //SPI mode 0
-        /*
-         * The timing requirements to read the busy signal from the EEPROM cannot be easily emulated
-         * by SPI transactions. We need to control CS pin by SW to check the busy signal manually.
-         */
-        .spics_io_num = -1,
-        .queue_size = 1,
-        .flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_POSITIVE_CS,
-        .pre_cb = spi_max31865_cs_high,
-        .post_cb = spi_max31865_cs_low,
-        .input_delay_ns = out_handle->spi_dev_config.input_delay_ns,  //the EEPROM output the data half a SPI clock behind.
+        .mode           = SPI_MAX31865_SPI_MODE,
+        .spics_io_num   = out_handle->spi_dev_config.cs_io_num,
+        .queue_size     = 1,
+        .input_delay_ns = out_handle->spi_dev_config.input_delay_ns,
     };
 
-    /* validate device handle */
-    if (out_handle->spi_dev_handle == NULL) {
-        ESP_GOTO_ON_ERROR(spi_bus_add_device(out_handle->spi_dev_config.host, &spi_dev_conf, &out_handle->spi_dev_handle), err_handle, TAG, "spi new bus for init failed");
+    /* attempt to add device to spi bus */
+    ESP_GOTO_ON_ERROR( spi_bus_add_device(out_handle->spi_dev_config.host, &spi_dev_conf, &out_handle->spi_dev_handle), err_handle, TAG, "spi bus add device for init failed" );
+
+    /* configure DRDY io, the interrupt is enabled by the pipeline */
+    if (out_handle->spi_dev_config.irq_io_num != GPIO_NUM_NC) {
+        const gpio_config_t irq_gpio_config = {
+            .mode           = GPIO_MODE_INPUT,
+            .intr_type      = GPIO_INTR_DISABLE,
+            .pin_bit_mask   = (BIT64(out_handle->spi_dev_config.irq_io_num))
+        };
+        ESP_GOTO_ON_ERROR( gpio_config(&irq_gpio_config), err_device, TAG, "unable to configure DRDY gpio, init failed" );
     }
 
-    /* configure cs io */
-    gpio_config_t cs_gpio_cfg = {
-        .pin_bit_mask = BIT64(out_handle->spi_dev_config.cs_io_num),
-        .mode = GPIO_MODE_OUTPUT,
-    };
-    gpio_set_level(out_handle->spi_dev_config.cs_io_num, 0);
-    gpio_config(&cs_gpio_cfg);
+    vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_POWERUP_DELAY_MS));
+
+    /* attempt to write configuration register, faults latched before init are cleared */
+    spi_max31865_configuration_register_t config_reg = { .reg = 0 };
+    config_reg.bits.filter              = out_handle->spi_dev_config.filter;
+    config_reg.bits.connection          = out_handle->spi_dev_config.connection;
+    config_reg.bits.mode                = out_handle->spi_dev_config.mode;
+    config_reg.bits.v_bias_enabled      = out_handle->spi_dev_config.v_bias_enabled || (out_handle->spi_dev_config.mode == SPI_MAX31865_MODE_AUTO);
+    config_reg.bits.clear_fault_status  = true;
+    ESP_GOTO_ON_ERROR( spi_max31865_set_configuration_register(out_handle, config_reg), err_device, TAG, "unable to write configuration register, init failed" );
 
-    /* configure isr handler */
-    if (out_handle->spi_dev_config.irq_enabled == true) {
-        out_handle->spi_ready_sem = xSemaphoreCreateBinary();
-        ESP_GOTO_ON_FALSE(out_handle->spi_ready_sem, ESP_ERR_NO_MEM, err_handle, TAG, "no memory for spi ready semaphore, init failed");
+    /* attempt to read back configuration register, validates the device is responding */
+    ESP_GOTO_ON_ERROR( spi_max31865_get_configuration_register(out_handle, &config_reg), err_device, TAG, "unable to read configuration register, init failed" );
+    config_reg.bits.clear_fault_status = false;
+    config_reg.bits.one_shot_enabled   = false;
+    ESP_GOTO_ON_FALSE( config_reg.reg == out_handle->config_reg.reg, ESP_ERR_INVALID_RESPONSE, err_device, TAG, "configuration register mismatch (0x%02x), init failed", config_reg.reg );
 
-        gpio_set_intr_type(out_handle->spi_dev_config.miso_io_num, GPIO_INTR_POSEDGE);
-        ESP_GOTO_ON_ERROR(gpio_isr_handler_add(out_handle->spi_dev_config.miso_io_num, spi_max31865_ready_rising_isr, out_handle), err_handle, TAG, "add gpio isr handler for init failed");
-        gpio_intr_disable(out_handle->spi_dev_config.miso_io_num);
+    if (out_handle->config_reg.bits.v_bias_enabled) {
+        vTaskDelay(pdMS_TO_TICKS(SPI_MAX31865_BIAS_SETTLE_DELAY_MS));
     }
 
     /* set device handle */
@@ -170,13 +934,10 @@ esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_ma
 
     return ESP_OK;
 
+    err_device:
+        spi_bus_remove_device(out_handle->spi_dev_handle);
     err_handle:
-        if (out_handle && out_handle->spi_dev_handle) {
-            spi_bus_remove_device(out_handle->spi_dev_handle);
-        }
-        if (out_handle && out_handle->spi_ready_sem) {
-            vSemaphoreDelete(out_handle->spi_ready_sem);
-        }
+        free(out_handle->rtd_lut);
         free(out_handle);
     err:
         return ret;
@@ -186,6 +947,15 @@ esp_err_t spi_max31865_remove(spi_max31865_handle_t max31865_handle) {
     /* validate arguments */
     ESP_ARG_CHECK( max31865_handle );
 
+    /* attempt to stop pipeline */
+    ESP_RETURN_ON_ERROR( spi_max31865_stop_pipeline(max31865_handle), TAG, "unable to stop pipeline, remove failed" );
+
+    /* attempt to remove device from spi bus */
+    if (max31865_handle->spi_dev_handle) {
+        ESP_RETURN_ON_ERROR( spi_bus_remove_device(max31865_handle->spi_dev_handle), TAG, "unable to remove device from spi bus, remove failed" );
+        max31865_handle->spi_dev_handle = NULL;
+    }
+
     return ESP_OK;
 }
 
@@ -193,5 +963,12 @@ esp_err_t spi_max31865_delete(spi_max31865_handle_t max31865_handle) {
     /* validate arguments */
     ESP_ARG_CHECK( max31865_handle );
 
+    /* remove device from spi bus */
+    ESP_RETURN_ON_ERROR( spi_max31865_remove(max31865_handle), TAG, "unable to remove device from spi bus, delete failed" );
+
+    /* free handles */
+    free(max31865_handle->rtd_lut);
+    free(max31865_handle);
+
     return ESP_OK;
-}
\ No newline at end of file
+}
@@ -26,7 +26,7 @@
  * @defgroup drivers max31865
  * @{
  *
- * ESP-IDF driver for max31865 sensor
+ * ESP-IDF driver for max31865 RTD-to-digital converter
  *
  * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
  *
@@ -41,6 +41,8 @@
 #include <driver/gpio.h>
 #include <driver/spi_common.h>
 #include <driver/spi_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
 
 #ifdef __cplusplus
@@ -51,30 +53,75 @@ extern "C"
 /*
  * MAX31865 definitions
  */
-#define I2C_MAX31865_SCL_SPEED_HZ          UINT32_C(100000) //!< max31865 I2C default clock frequency (100KHz)
+#define SPI_MAX31865_CLOCK_SPEED_HZ         INT32_C(1000000)    //!< max31865 SPI default clock frequency (1MHz), 5MHz maximum
+#define SPI_MAX31865_RTD_CODE_MAX           UINT16_C(32767)     //!< max31865 15-bit RTD conversion code full-scale
+#define SPI_MAX31865_PT100_RTD_NOMINAL      (100.0f)            //!< max31865 PT100 nominal resistance at 0 degrees Celsius, Ohms
+#define SPI_MAX31865_PT100_R_REF            (430.0f)            //!< max31865 PT100 typical reference resistance, Ohms
+#define SPI_MAX31865_PT1000_RTD_NOMINAL     (1000.0f)           //!< max31865 PT1000 nominal resistance at 0 degrees Celsius, Ohms
+#define SPI_MAX31865_PT1000_R_REF           (4300.0f)           //!< max31865 PT1000 typical reference resistance, Ohms
 
-#define SPI_MAX31865_DEV_ADDR              UINT8_C(0x38) //!< max31865 I2C address
+#define SPI_MAX31865_LUT_TEMPERATURE_MIN    (-200.0f)           //!< max31865 lookup-table lowest temperature in degrees Celsius
+#define SPI_MAX31865_LUT_TEMPERATURE_MAX    (850.0f)            //!< max31865 lookup-table highest temperature in degrees Celsius
+#define SPI_MAX31865_LUT_TEMPERATURE_STEP   (5.0f)              //!< max31865 lookup-table temperature step in degrees Celsius
+#define SPI_MAX31865_LUT_SIZE               UINT16_C(211)       //!< max31865 lookup-table number of entries, (max - min) / step + 1
+
+#define SPI_MAX31865_PIPELINE_TASK_NAME         "max31865_pipeline"
+#define SPI_MAX31865_PIPELINE_TASK_STACK_SIZE   (configMINIMAL_STACK_SIZE * 4)
+#define SPI_MAX31865_PIPELINE_TASK_PRIORITY     (tskIDLE_PRIORITY + 5)
 
 
 /*
  * MAX31865 macro definitions
  */
+#define SPI_MAX31865_CONFIG_DEFAULT {                           \
+    .host               = SPI2_HOST,                            \
+    .cs_io_num          = GPIO_NUM_NC,                          \
+    .irq_io_num         = GPIO_NUM_NC,                          \
+    .clock_speed_hz     = SPI_MAX31865_CLOCK_SPEED_HZ,          \
+    .input_delay_ns     = 0,                                    \
+    .mode               = SPI_MAX31865_MODE_SINGLE,             \
+    .connection         = SPI_MAX31865_2WIRE_OR_4WIRE,          \
+    .v_bias_enabled     = false,                                \
+    .filter             = SPI_MAX31865_FILTER_60HZ,             \
+    .standard           = SPI_MAX31865_ITS90,                   \
+    .conversion         = SPI_MAX31865_CONVERSION_POLYNOMIAL,   \
+    .rtd_nominal        = SPI_MAX31865_PT100_RTD_NOMINAL,       \
+    .r_ref              = SPI_MAX31865_PT100_R_REF }
+
+/**
+ * @brief Macro that initializes `spi_max31865_pipeline_config_t` to default configuration settings.
+ */
+#define SPI_MAX31865_PIPELINE_CONFIG_DEFAULT {                  \
+    .queue_length       = 10,                                   \
+    .callback           = NULL,                                 \
+    .callback_arg       = NULL }
+
+
 /*
-#define I2C_MAX31865_CONFIG_DEFAULT {                      \
-    .dev_config.device_address = I2C_MAX31865_DEV_ADDR,    \
-    .dev_config.scl_speed_hz   = I2C_MAX31865_SCL_SPEED_HZ,\
-    .aht_type = I2C_AHTXX_AHT2X }
-*/
+ * MAX31865 enumerator and structure declarations
+ */
 
+/**
+ * @brief MAX31865 fault detection cycle status enumerator, fault detection bits (D3:D2) of 
+ * the configuration register when read.
+ */
 typedef enum {
-    SPI_MAX31865_FAULT_DETECT_FINISHED       = (0b00), /**<  */
-    SPI_MAX31865_FAULT_DETECT_STILL_RUNNING  = (0b01),  /**<  */
-    SPI_MAX31865_FAULT_DETECT_CYCLE1_RUNNING = (0b10),
-    SPI_MAX31865_FAULT_DETECT_CYCLE2_RUNNING = (0b11)
+    SPI_MAX31865_FAULT_DETECT_FINISHED       = (0b00), /**< fault detection finished */
+    SPI_MAX31865_FAULT_DETECT_STILL_RUNNING  = (0b01), /**< automatic delay fault detection still running */
+    SPI_MAX31865_FAULT_DETECT_CYCLE1_RUNNING = (0b10), /**< manual delay fault detection cycle 1 still running */
+    SPI_MAX31865_FAULT_DETECT_CYCLE2_RUNNING = (0b11)  /**< manual delay fault detection cycle 2 still running */
 } spi_max31865_fault_detection_cycles_t;
 
+/**
+ * @brief MAX31865 fault detection method enumerator.
+ */
+typedef enum {
+    SPI_MAX31865_FAULT_DETECTION_AUTOMATIC = 0, /**< fault detection with automatic delay, about 550us */
+    SPI_MAX31865_FAULT_DETECTION_MANUAL         /**< fault detection with manual delay, cycle 1 waits for the RTD input filter to settle */
+} spi_max31865_fault_detection_methods_t;
+
 typedef enum {
-    SPI_MAX31865_MODE_SINGLE = 0, /**< Single consersion mode, default */
+    SPI_MAX31865_MODE_SINGLE = 0, /**< Single conversion mode, default */
     SPI_MAX31865_MODE_AUTO        /**< Automatic conversion mode at 50/60Hz rate */
 } spi_max31865_modes_t;
 
@@ -94,6 +141,14 @@ typedef enum {
     SPI_MAX31865_US_INDUSTRIAL /**< US INDUSTRIAL */
 } spi_max31865_standards_t;
 
+/**
+ * @brief MAX31865 resistance to temperature conversion method enumerator.
+ */
+typedef enum {
+    SPI_MAX31865_CONVERSION_POLYNOMIAL = 0,  /**< Callendar-Van Dusen inverse, closed-form quadratic above 0 degrees Celsius and Newton refined below */
+    SPI_MAX31865_CONVERSION_LOOKUP_TABLE     /**< Callendar-Van Dusen lookup-table from -200 to 850 degrees Celsius with linear interpolation */
+} spi_max31865_conversion_methods_t;
+
 
 /**
  * @brief MAX31865 SPI configuration register structure.
@@ -102,12 +157,12 @@ typedef enum {
 typedef union __attribute__((packed)) {
     struct {
         spi_max31865_filters_t                  filter:1;               /*!< filter  (bit:0)  */
-        bool                                    clear_fault_status:1;   /*!<   (bit:1) */
-        spi_max31865_fault_detection_cycles_t   fault_detection:2;      /*!<   (bit:2-3) */
-        spi_max31865_connection_types_t         connection:1;           /*!<   (bit:4) */
-        bool                                    one_shot_enabled:1;     /*!<   (bit:5) */
-        spi_max31865_modes_t                    mode:1;                 /*!<   (bit:6) */
-        bool                                    v_bias_enabled:1;       /*!<   (bit:7) */
+        bool                                    clear_fault_status:1;   /*!< fault status clear, self-clearing (bit:1) */
+        spi_max31865_fault_detection_cycles_t   fault_detection:2;      /*!< fault detection cycle control (bit:2-3) */
+        spi_max31865_connection_types_t         connection:1;           /*!< 2/4-wire or 3-wire connection (bit:4) */
+        bool                                    one_shot_enabled:1;     /*!< 1-shot conversion, self-clearing (bit:5) */
+        spi_max31865_modes_t                    mode:1;                 /*!< conversion mode (bit:6) */
+        bool                                    v_bias_enabled:1;       /*!< RTD bias voltage (bit:7) */
     } bits;
     uint8_t reg;
 } spi_max31865_configuration_register_t;
@@ -119,12 +174,12 @@ typedef union __attribute__((packed)) {
 typedef union __attribute__((packed)) {
     struct {
         uint8_t reserved:2;                 /*!< reserved  (bit:0-1)  */
-        bool voltage_fault:1;               /*!<  (bit:2) */
-        bool rtdin_open_fault:1;            /*!<  (bit:3) */
-        bool refin_open_fault:1;            /*!<  (bit:4) */
-        bool refin_fault:1;                 /*!<  (bit:5) */
-        bool rtd_low_threshold_fault:1;     /*!<  (bit:6) */
-        bool rtd_high_threshold_fault:1;    /*!<  (bit:7) */
+        bool voltage_fault:1;               /*!< over or under voltage fault (bit:2) */
+        bool rtdin_open_fault:1;            /*!< RTDIN- less than 0.85 x VBIAS, FORCE- open (bit:3) */
+        bool refin_open_fault:1;            /*!< REFIN- less than 0.85 x VBIAS, FORCE- open (bit:4) */
+        bool refin_fault:1;                 /*!< REFIN- greater than 0.85 x VBIAS (bit:5) */
+        bool rtd_low_threshold_fault:1;     /*!< RTD below low fault threshold (bit:6) */
+        bool rtd_high_threshold_fault:1;    /*!< RTD above high fault threshold (bit:7) */
     } bits;
     uint8_t reg;
 } spi_max31865_fault_status_register_t;
@@ -133,30 +188,74 @@ typedef union __attribute__((packed)) {
  * @brief MAX31865 SPI device configuration structure.
  */
 typedef struct {
-    int                                     clock_speed_hz;
-    int                                     input_delay_ns;
-    spi_max31865_modes_t                    mode;
-    spi_max31865_connection_types_t         connection;
-    bool                                    v_bias_enabled;
-    spi_max31865_filters_t                  filter;
-    spi_host_device_t                       host;           /*!< The SPI host used, set before calling `spi_eeprom_init()` */
-    gpio_num_t                              cs_io_num;      /*!< CS gpio number, set before calling `spi_eeprom_init()` */
-    gpio_num_t                              miso_io_num;    /*!< MISO gpio number, set before calling `spi_eeprom_init()` */
-    bool                                    irq_enabled;    /*!< Whether to use polling or interrupt when waiting for write to be done. Set before calling `spi_eeprom_init()`. */
-    gpio_num_t                              irq_io_num;     /*!< interrupt gpio number */
+    spi_host_device_t                       host;           /*!< max31865 SPI host, the bus is initialized before `spi_max31865_init()` */
+    gpio_num_t                              cs_io_num;      /*!< max31865 CS gpio number */
+    gpio_num_t                              irq_io_num;     /*!< max31865 DRDY gpio number, GPIO_NUM_NC when not connected */
+    int                                     clock_speed_hz; /*!< max31865 SPI clock frequency in hz, 5MHz maximum */
+    int                                     input_delay_ns; /*!< max31865 SPI MISO input delay in nano-seconds */
+    spi_max31865_modes_t                    mode;           /*!< max31865 conversion mode */
+    spi_max31865_connection_types_t         connection;     /*!< max31865 RTD connection type */
+    bool                                    v_bias_enabled; /*!< max31865 bias voltage stays enabled between single conversions when true */
+    spi_max31865_filters_t                  filter;         /*!< max31865 notch filter frequency */
+    spi_max31865_standards_t                standard;       /*!< max31865 Callendar-Van Dusen coefficients standard */
+    spi_max31865_conversion_methods_t       conversion;     /*!< max31865 resistance to temperature conversion method */
+    float                                   rtd_nominal;    /*!< max31865 RTD nominal resistance at 0 degrees Celsius, Ohms (PT100 - 100 Ohms, PT1000 - 1000 Ohms) */
+    float                                   r_ref;          /*!< max31865 reference resistor value, Ohms */
 } spi_max31865_config_t;
 
+/**
+ * @brief MAX31865 pipeline sample structure.
+ */
+typedef struct spi_max31865_pipeline_sample_s {
+    int64_t                                 timestamp;      /*!< max31865 DRDY interrupt time in micro-seconds since boot */
+    uint16_t                                rtd_code;       /*!< max31865 15-bit RTD conversion code */
+    float                                   resistance;     /*!< max31865 RTD resistance in Ohms */
+    float                                   temperature;    /*!< max31865 RTD temperature in degrees Celsius */
+    bool                                    fault;          /*!< max31865 RTD fault flag of the conversion, the resistance and temperature are not valid when true */
+    spi_max31865_fault_status_register_t    fault_status;   /*!< max31865 fault status register when the fault flag is set */
+} spi_max31865_pipeline_sample_t;
+
+/**
+ * @brief MAX31865 pipeline statistics structure.
+ */
+typedef struct spi_max31865_pipeline_stats_s {
+    uint32_t                                samples;        /*!< max31865 number of samples published */
+    uint32_t                                faults;         /*!< max31865 number of samples published with the fault flag set */
+    uint32_t                                dropped;        /*!< max31865 number of samples dropped because the queue was full */
+    uint32_t                                errors;         /*!< max31865 number of failed SPI reads */
+} spi_max31865_pipeline_stats_t;
+
+/**
+ * @brief MAX31865 pipeline sample callback definition, invoked from the pipeline task.
+ */
+typedef void (*spi_max31865_pipeline_cb_t)(const spi_max31865_pipeline_sample_t *sample, void *arg);
+
+/**
+ * @brief MAX31865 pipeline configuration structure definition.
+ */
+typedef struct spi_max31865_pipeline_config_s {
+    uint16_t                                queue_length;   /*!< max31865 length of the sample queue, 0 when samples are published to the callback only */
+    spi_max31865_pipeline_cb_t              callback;       /*!< max31865 sample callback, optional and can be NULL */
+    void                                   *callback_arg;   /*!< max31865 sample callback argument */
+} spi_max31865_pipeline_config_t;
+
+/**
+ * @brief MAX31865 pipeline structure declaration.
+ */
+struct spi_max31865_pipeline_s;
+
 /**
  * @brief MAX31865 SPI device structure.
  */
 struct spi_max31865_t {
-    SemaphoreHandle_t                       spi_ready_sem;  /*!< SPI semaphore for ready signal */
-    spi_max31865_config_t                   spi_dev_config; /*!< SPI device configuration */
-    spi_device_handle_t                     spi_dev_handle; /*!< SPI device handle */
-    spi_max31865_configuration_register_t   config_reg;     /*!< status register */
-    spi_max31865_standards_t                standard;       /*!< Temperature scale standard */
-    float                                   r_ref;          /*!< Reference resistor value, Ohms */
-    float                                   rtd_nominal;    /*!< RTD nominal resistance at 0 deg. C, Ohms (PT100 - 100 Ohms, PT1000 - 1000 Ohms) */
+    spi_max31865_config_t                   spi_dev_config; /*!< max31865 SPI device configuration */
+    spi_device_handle_t                     spi_dev_handle; /*!< max31865 SPI device handle */
+    spi_max31865_configuration_register_t   config_reg;     /*!< max31865 configuration register without self-clearing bits */
+    float                                   rtd_a;          /*!< max31865 Callendar-Van Dusen A coefficient */
+    float                                   rtd_b;          /*!< max31865 Callendar-Van Dusen B coefficient */
+    float                                   rtd_c;          /*!< max31865 Callendar-Van Dusen C coefficient, below 0 degrees Celsius */
+    float                                  *rtd_lut;        /*!< max31865 resistance ratio lookup-table, NULL with polynomial conversion */
+    struct spi_max31865_pipeline_s         *pipeline;       /*!< max31865 DRDY interrupt-driven pipeline, NULL when the pipeline is stopped */
 };
 
 /**
@@ -170,37 +269,189 @@ typedef struct spi_max31865_t spi_max31865_t;
 typedef struct spi_max31865_t *spi_max31865_handle_t;
 
 
+/**
+ * @brief Reads configuration register from MAX31865.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] config_reg MAX31865 configuration register.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_get_configuration_register(spi_max31865_handle_t max31865_handle, spi_max31865_configuration_register_t *const config_reg);
 
-esp_err_t spi_max31865_get_configuration_register(spi_max31865_handle_t max31865_handle);
+/**
+ * @brief Writes configuration register to MAX31865.  The self-clearing bits (1-shot, fault 
+ * status clear and fault detection) are written as set but are not retained in the handle.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param config_reg MAX31865 configuration register.
+ * @return esp_err_t ESP_OK on success.
+ */
 esp_err_t spi_max31865_set_configuration_register(spi_max31865_handle_t max31865_handle, const spi_max31865_configuration_register_t config_reg);
 
+/**
+ * @brief Reads fault status register from MAX31865.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] fault_status_reg MAX31865 fault status register.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_get_fault_status_register(spi_max31865_handle_t max31865_handle, spi_max31865_fault_status_register_t *const fault_status_reg);
 
 /**
- * @brief Read fault status register from MAX31865.
+ * @brief Clears the MAX31865 fault status register.
  *
  * @param max31865_handle MAX31865 device handle.
  * @return esp_err_t ESP_OK on success.
  */
-esp_err_t spi_max31865_get_fault_status_register(spi_max31865_handle_t max31865_handle);
+esp_err_t spi_max31865_clear_fault_status(spi_max31865_handle_t max31865_handle);
 
 /**
- * @brief Initializes an MAX31865 device onto the I2C master bus.
+ * @brief Reads the MAX31865 RTD low and high fault thresholds.
  *
- * @param[in] max31865_config Configuration of MAX31865 device.
- * @param[out] max31865_handle MAX31865 device handle.
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] low_resistance RTD low fault threshold in Ohms.
+ * @param[out] high_resistance RTD high fault threshold in Ohms.
  * @return esp_err_t ESP_OK on success.
  */
-esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_max31865_handle_t *max31865_handle);
+esp_err_t spi_max31865_get_fault_thresholds(spi_max31865_handle_t max31865_handle, float *const low_resistance, float *const high_resistance);
 
 /**
- * @brief Reads temperature from MAX31865.
+ * @brief Writes the MAX31865 RTD low and high fault thresholds, conversions outside the 
+ * thresholds set the RTD fault flag and the threshold fault status bits.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param low_resistance RTD low fault threshold in Ohms, 0 to the reference resistance.
+ * @param high_resistance RTD high fault threshold in Ohms, 0 to the reference resistance.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_set_fault_thresholds(spi_max31865_handle_t max31865_handle, const float low_resistance, const float high_resistance);
+
+/**
+ * @brief Runs a MAX31865 fault detection cycle and reads the fault status register.  The 
+ * conversion mode is suspended while the cycle runs and restored afterwards.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param method Fault detection with automatic or manual delay.
+ * @param[out] fault_status_reg MAX31865 fault status register after the cycle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_run_fault_detection(spi_max31865_handle_t max31865_handle, const spi_max31865_fault_detection_methods_t method, spi_max31865_fault_status_register_t *const fault_status_reg);
+
+/**
+ * @brief Sets the MAX31865 conversion mode, the bias voltage is enabled in automatic mode.
  *
  * @param max31865_handle MAX31865 device handle.
- * @param temperature Temperature in degree Celsius.
+ * @param mode Single or automatic conversion mode.
  * @return esp_err_t ESP_OK on success.
  */
+esp_err_t spi_max31865_set_mode(spi_max31865_handle_t max31865_handle, const spi_max31865_modes_t mode);
+
+/**
+ * @brief Sets the MAX31865 notch filter frequency.  Automatic conversions are suspended 
+ * while the filter is changed.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param filter 50Hz or 60Hz notch filter.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_set_filter(spi_max31865_handle_t max31865_handle, const spi_max31865_filters_t filter);
+
+/**
+ * @brief Enables or disables the MAX31865 bias voltage.  Disabling the bias voltage between 
+ * single conversions reduces self-heating.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param enabled Bias voltage is enabled when true.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_set_bias(spi_max31865_handle_t max31865_handle, const bool enabled);
+
+/**
+ * @brief Reads the MAX31865 15-bit RTD conversion code.  A single conversion is triggered in 
+ * single mode.  In automatic mode the next conversion is awaited when the DRDY pin is 
+ * connected, otherwise the latest conversion is read.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] rtd_code RTD conversion code.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when the RTD fault flag is set.
+ */
+esp_err_t spi_max31865_get_rtd_code(spi_max31865_handle_t max31865_handle, uint16_t *const rtd_code);
+
+/**
+ * @brief Reads RTD resistance from MAX31865.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] resistance RTD resistance in Ohms.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when the RTD fault flag is set.
+ */
+esp_err_t spi_max31865_get_resistance(spi_max31865_handle_t max31865_handle, float *const resistance);
+
+/**
+ * @brief Reads temperature from MAX31865.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] temperature Temperature in degree Celsius.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when the RTD fault flag is set.
+ */
 esp_err_t spi_max31865_get_measurement(spi_max31865_handle_t max31865_handle, float *const temperature);
 
+/**
+ * @brief Converts RTD resistance to temperature with the Callendar-Van Dusen equation of the 
+ * configured standard and conversion method.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param resistance RTD resistance in Ohms.
+ * @param[out] temperature Temperature in degree Celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_convert_temperature(spi_max31865_handle_t max31865_handle, const float resistance, float *const temperature);
+
+/**
+ * @brief Starts the DRDY interrupt-driven acquisition pipeline.  Automatic conversion mode is 
+ * enabled and the DRDY falling edge wakes a pipeline task that reads the conversion and 
+ * publishes a timestamped sample to the callback and sample queue.  The DRDY pin is required.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param config MAX31865 pipeline configuration.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_start_pipeline(spi_max31865_handle_t max31865_handle, const spi_max31865_pipeline_config_t *config);
+
+/**
+ * @brief Stops the DRDY interrupt-driven acquisition pipeline and restores the configured 
+ * conversion mode.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_stop_pipeline(spi_max31865_handle_t max31865_handle);
+
+/**
+ * @brief Gets the pipeline sample queue, items are `spi_max31865_pipeline_sample_t`.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] queue Sample queue handle, NULL when the pipeline has no queue.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the pipeline is stopped.
+ */
+esp_err_t spi_max31865_get_pipeline_queue(spi_max31865_handle_t max31865_handle, QueueHandle_t *const queue);
+
+/**
+ * @brief Gets pipeline statistics.
+ *
+ * @param max31865_handle MAX31865 device handle.
+ * @param[out] stats Pipeline statistics.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the pipeline is stopped.
+ */
+esp_err_t spi_max31865_get_pipeline_stats(spi_max31865_handle_t max31865_handle, spi_max31865_pipeline_stats_t *const stats);
+
+/**
+ * @brief Initializes an MAX31865 device onto the SPI master bus.
+ *
+ * @param[in] max31865_config Configuration of MAX31865 device.
+ * @param[out] max31865_handle MAX31865 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t spi_max31865_init(const spi_max31865_config_t *max31865_config, spi_max31865_handle_t *max31865_handle);
 
 /**
  * @brief Removes an MAX31865 device from master bus.
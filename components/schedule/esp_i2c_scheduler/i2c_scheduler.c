@@ -0,0 +1,552 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_scheduler.c
+ *
+ * ESP-IDF I2C master bus scheduler
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "include/i2c_scheduler.h"
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#define I2C_SCHEDULER_TASK_NAME         "i2c_sch_tsk"
+#define I2C_SCHEDULER_MAX_SLEEP_MS      UINT32_C(60000)     //!< upper bound of a task sleep, keeps the tick conversion in range
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/**
+ * @brief I2C scheduler job descriptor structure definition.
+ */
+typedef struct i2c_scheduler_job_s {
+    bool                            in_use;             /*!< i2c scheduler job, slot is allocated when true */
+    bool                            converting;         /*!< i2c scheduler job, start phase completed and collect phase is pending when true */
+    i2c_scheduler_job_config_t      config;             /*!< i2c scheduler job, configuration */
+    int64_t                         release_time;       /*!< i2c scheduler job, clock time of the current release in microseconds */
+    int64_t                         ready_time;         /*!< i2c scheduler job, clock time the conversion is complete in microseconds */
+    uint32_t                        wait_us;            /*!< i2c scheduler job, conversion wait of the last start phase in microseconds */
+    uint64_t                        jitter_sum;         /*!< i2c scheduler job, sum of start delays for the average */
+    uint32_t                        jitter_count;       /*!< i2c scheduler job, number of start delays in the sum */
+    i2c_scheduler_job_stats_t       stats;              /*!< i2c scheduler job, statistics */
+} i2c_scheduler_job_t;
+
+/**
+ * @brief I2C scheduler context structure definition.
+ */
+typedef struct i2c_scheduler_context_s {
+    i2c_scheduler_config_t          config;             /*!< i2c scheduler, configuration */
+    i2c_scheduler_job_t*            jobs;               /*!< i2c scheduler, job slots */
+    SemaphoreHandle_t               mutex_handle;       /*!< i2c scheduler, recursive bus mutex, held while a phase is dispatched */
+    SemaphoreHandle_t               stopped_handle;     /*!< i2c scheduler, given by the task when it exits */
+    TaskHandle_t                    task_handle;        /*!< i2c scheduler, task handle, NULL when stopped */
+    volatile bool                   stop_requested;     /*!< i2c scheduler, task exits when true */
+    int64_t                         stats_time;         /*!< i2c scheduler, clock time the statistics were reset */
+    uint64_t                        busy_time;          /*!< i2c scheduler, time spent in job phases in microseconds */
+    uint32_t                        phase_count;        /*!< i2c scheduler, number of dispatched phases */
+} i2c_scheduler_context_t;
+
+/*
+* static constant declarations
+*/
+static const char *TAG = "i2c_scheduler";
+
+
+/**
+ * @brief Resets the statistics of an I2C scheduler job.
+ * 
+ * @param job I2C scheduler job descriptor.
+ */
+static inline void i2c_scheduler_reset_job_stats(i2c_scheduler_job_t *const job) {
+    memset(&job->stats, 0, sizeof(i2c_scheduler_job_stats_t));
+    job->stats.jitter_min_us = UINT32_MAX;
+    job->jitter_sum          = 0;
+    job->jitter_count        = 0;
+}
+
+/**
+ * @brief Gets the clock time of the next phase of an I2C scheduler job.
+ * 
+ * @param job I2C scheduler job descriptor.
+ * @return int64_t Clock time of the next phase in microseconds.
+ */
+static inline int64_t i2c_scheduler_get_event_time(const i2c_scheduler_job_t *const job) {
+    return job->converting ? job->ready_time : job->release_time;
+}
+
+/**
+ * @brief Gets the absolute deadline of the current release of an I2C scheduler job.
+ * 
+ * @param job I2C scheduler job descriptor.
+ * @return int64_t Clock time of the deadline in microseconds.
+ */
+static inline int64_t i2c_scheduler_get_deadline_time(const i2c_scheduler_job_t *const job) {
+    return job->release_time + job->config.deadline_us;
+}
+
+/**
+ * @brief Selects the ready I2C scheduler job phase with the highest priority and then the earliest deadline.
+ * 
+ * @param scheduler I2C scheduler context.
+ * @param now Clock time in microseconds.
+ * @return i2c_scheduler_job_t* Selected job or NULL when no phase is ready.
+ */
+static inline i2c_scheduler_job_t* i2c_scheduler_select_job(i2c_scheduler_context_t *const scheduler, const int64_t now) {
+    i2c_scheduler_job_t *selected = NULL;
+
+    for (uint8_t i = 0; i < scheduler->config.max_jobs; i++) {
+        i2c_scheduler_job_t *job = &scheduler->jobs[i];
+
+        if (job->in_use == false || i2c_scheduler_get_event_time(job) > now) continue;
+
+        if (selected == NULL ||
+            job->config.priority > selected->config.priority ||
+            (job->config.priority == selected->config.priority && i2c_scheduler_get_deadline_time(job) < i2c_scheduler_get_deadline_time(selected))) {
+            selected = job;
+        }
+    }
+
+    return selected;
+}
+
+/**
+ * @brief Gets the clock time of the earliest I2C scheduler job phase.
+ * 
+ * @param scheduler I2C scheduler context.
+ * @return int64_t Clock time of the next event in microseconds, INT64_MAX when there are no jobs.
+ */
+static inline int64_t i2c_scheduler_get_next_time(i2c_scheduler_context_t *const scheduler) {
+    int64_t next_time = INT64_MAX;
+
+    for (uint8_t i = 0; i < scheduler->config.max_jobs; i++) {
+        const i2c_scheduler_job_t *job = &scheduler->jobs[i];
+
+        if (job->in_use == false) continue;
+
+        const int64_t event_time = i2c_scheduler_get_event_time(job);
+        if (event_time < next_time) next_time = event_time;
+    }
+
+    return next_time;
+}
+
+/**
+ * @brief Completes the current release of an I2C scheduler job and schedules the next release.
+ * 
+ * @param job I2C scheduler job descriptor.
+ */
+static inline void i2c_scheduler_complete_release(i2c_scheduler_job_t *const job) {
+    job->converting    = false;
+    job->release_time += job->config.period_us;
+}
+
+/**
+ * @brief Runs the start phase of an I2C scheduler job, single phase jobs are collected immediately.
+ * 
+ * @param scheduler I2C scheduler context.
+ * @param job I2C scheduler job descriptor.
+ * @param now Clock time in microseconds.
+ */
+static inline void i2c_scheduler_run_start(i2c_scheduler_context_t *const scheduler, i2c_scheduler_job_t *const job, const int64_t now) {
+    /* releases missed by a full period are skipped, the job keeps its phase */
+    if (now - job->release_time >= (int64_t)job->config.period_us) {
+        const uint32_t missed = (uint32_t)((now - job->release_time) / job->config.period_us);
+
+        job->stats.overrun_count += missed;
+        job->release_time        += (int64_t)missed * job->config.period_us;
+    }
+
+    /* start delay from release */
+    const uint32_t jitter = (uint32_t)(now - job->release_time);
+
+    if (jitter < job->stats.jitter_min_us) job->stats.jitter_min_us = jitter;
+    if (jitter > job->stats.jitter_max_us) job->stats.jitter_max_us = jitter;
+    job->jitter_sum += jitter;
+    job->jitter_count++;
+    job->stats.jitter_avg_us = (uint32_t)(job->jitter_sum / job->jitter_count);
+
+    if (job->config.start == NULL) {
+        job->converting = true;
+        job->ready_time = now;
+        job->wait_us    = 0;
+        return;
+    }
+
+    uint32_t wait_us = 0;
+    const int64_t start_time = scheduler->config.clock();
+    const esp_err_t ret = job->config.start(job->config.device_handle, job->config.context, &wait_us);
+    const int64_t end_time = scheduler->config.clock();
+
+    scheduler->busy_time += end_time - start_time;
+    scheduler->phase_count++;
+    job->stats.busy_us += end_time - start_time;
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "job %s start phase failed (%s)", job->config.name, esp_err_to_name(ret));
+        job->stats.error_count++;
+        i2c_scheduler_complete_release(job);
+        return;
+    }
+
+    job->converting = true;
+    job->ready_time = end_time + wait_us;
+    job->wait_us    = wait_us;
+}
+
+/**
+ * @brief Runs the collect phase of an I2C scheduler job.
+ * 
+ * @param scheduler I2C scheduler context.
+ * @param job I2C scheduler job descriptor.
+ */
+static inline void i2c_scheduler_run_collect(i2c_scheduler_context_t *const scheduler, i2c_scheduler_job_t *const job) {
+    const int64_t start_time = scheduler->config.clock();
+    const esp_err_t ret = job->config.collect(job->config.device_handle, job->config.context);
+    const int64_t end_time = scheduler->config.clock();
+
+    scheduler->busy_time += end_time - start_time;
+    scheduler->phase_count++;
+    job->stats.busy_us += end_time - start_time;
+
+    /* a conversion in progress (i.e. the second smux phase) is collected again after the start phase wait, within the period */
+    if (ret == ESP_ERR_NOT_FINISHED && job->wait_us > 0 &&
+        end_time + job->wait_us < job->release_time + (int64_t)job->config.period_us) {
+        job->stats.not_finished_count++;
+        job->ready_time = end_time + job->wait_us;
+        return;
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "job %s collect phase failed (%s)", job->config.name, esp_err_to_name(ret));
+        job->stats.error_count++;
+    } else {
+        const uint32_t response = (uint32_t)(end_time - job->release_time);
+
+        job->stats.run_count++;
+        if (response > job->stats.response_max_us) job->stats.response_max_us = response;
+        if (end_time > i2c_scheduler_get_deadline_time(job)) job->stats.deadline_miss_count++;
+    }
+
+    i2c_scheduler_complete_release(job);
+}
+
+/**
+ * @brief I2C scheduler task, dispatches ready phases and sleeps until the next event.
+ * 
+ * @param pvParameters I2C scheduler context.
+ */
+static void i2c_scheduler_task_entry(void *pvParameters) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)pvParameters;
+
+    while (scheduler->stop_requested == false) {
+        int64_t next_time = INT64_MAX;
+
+        if (i2c_scheduler_dispatch(scheduler, &next_time) != ESP_OK) {
+            ESP_LOGE(TAG, "dispatch failed");
+        }
+
+        const int64_t now = scheduler->config.clock();
+        if (next_time <= now) continue;
+
+        /* sleep until the next event, a job change or stop request notifies the task */
+        TickType_t wait = portMAX_DELAY;
+        if (next_time != INT64_MAX) {
+            int64_t wait_ms = (next_time - now + 999) / 1000;
+            if (wait_ms > I2C_SCHEDULER_MAX_SLEEP_MS) wait_ms = I2C_SCHEDULER_MAX_SLEEP_MS;
+            wait = pdMS_TO_TICKS((uint32_t)wait_ms);
+            if (wait == 0) wait = 1;
+        }
+
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+
+    xSemaphoreGive(scheduler->stopped_handle);
+    vTaskDelete( NULL );
+}
+
+esp_err_t i2c_scheduler_init(const i2c_scheduler_config_t *config, i2c_scheduler_handle_t *handle) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( config && handle && config->max_jobs > 0 );
+
+    /* validate memory availability for handle */
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)calloc(1, sizeof(i2c_scheduler_context_t));
+    ESP_RETURN_ON_FALSE( scheduler, ESP_ERR_NO_MEM, TAG, "no memory for i2c scheduler handle, init failed" );
+
+    /* copy configuration */
+    scheduler->config = *config;
+    if (scheduler->config.clock == NULL) scheduler->config.clock = esp_timer_get_time;
+
+    /* validate memory availability for job slots */
+    scheduler->jobs = (i2c_scheduler_job_t*)calloc(config->max_jobs, sizeof(i2c_scheduler_job_t));
+    ESP_GOTO_ON_FALSE( scheduler->jobs, ESP_ERR_NO_MEM, err, TAG, "no memory for i2c scheduler jobs, init failed" );
+
+    scheduler->mutex_handle = xSemaphoreCreateRecursiveMutex();
+    ESP_GOTO_ON_FALSE( scheduler->mutex_handle, ESP_ERR_NO_MEM, err_jobs, TAG, "create i2c scheduler mutex failed" );
+
+    scheduler->stopped_handle = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE( scheduler->stopped_handle, ESP_ERR_NO_MEM, err_mutex, TAG, "create i2c scheduler stopped semaphore failed" );
+
+    scheduler->stats_time = scheduler->config.clock();
+
+    /* set output parameter */
+    *handle = (i2c_scheduler_handle_t)scheduler;
+
+    return ESP_OK;
+
+    err_mutex:
+        vSemaphoreDelete(scheduler->mutex_handle);
+    err_jobs:
+        free(scheduler->jobs);
+    err:
+        free(scheduler);
+        return ret;
+}
+
+esp_err_t i2c_scheduler_add_job(i2c_scheduler_handle_t handle, const i2c_scheduler_job_config_t *job_config, i2c_scheduler_job_handle_t *job_handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+    i2c_scheduler_job_t *job = NULL;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler && job_config && job_handle && job_config->collect && job_config->period_us > 0 );
+    ESP_RETURN_ON_FALSE( job_config->deadline_us <= job_config->period_us, ESP_ERR_INVALID_ARG, TAG, "job %s deadline is longer than the period", job_config->name );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+
+    /* find a free job slot */
+    for (uint8_t i = 0; i < scheduler->config.max_jobs; i++) {
+        if (scheduler->jobs[i].in_use == false) {
+            job = &scheduler->jobs[i];
+            break;
+        }
+    }
+
+    if (job) {
+        memset(job, 0, sizeof(i2c_scheduler_job_t));
+        job->config = *job_config;
+        if (job->config.deadline_us == 0) job->config.deadline_us = job->config.period_us;
+        job->release_time = scheduler->config.clock() + job->config.offset_us;
+        job->in_use       = true;
+        i2c_scheduler_reset_job_stats(job);
+    }
+
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    ESP_RETURN_ON_FALSE( job, ESP_ERR_NO_MEM, TAG, "no free job slot for job %s, add job failed", job_config->name );
+
+    /* wake the task to account for the new job */
+    if (scheduler->task_handle) xTaskNotifyGive(scheduler->task_handle);
+
+    /* set output parameter */
+    *job_handle = (i2c_scheduler_job_handle_t)job;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_remove_job(i2c_scheduler_handle_t handle, i2c_scheduler_job_handle_t job_handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+    i2c_scheduler_job_t *job = (i2c_scheduler_job_t*)job_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler && job );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+    job->in_use = false;
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_dispatch(i2c_scheduler_handle_t handle, int64_t *const next_time) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler && next_time );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+
+    const int64_t now = scheduler->config.clock();
+    i2c_scheduler_job_t *job = i2c_scheduler_select_job(scheduler, now);
+
+    if (job) {
+        if (job->converting) {
+            i2c_scheduler_run_collect(scheduler, job);
+        } else {
+            i2c_scheduler_run_start(scheduler, job, now);
+        }
+    }
+
+    *next_time = i2c_scheduler_get_next_time(scheduler);
+
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_start(i2c_scheduler_handle_t handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    if (scheduler->task_handle) return ESP_ERR_INVALID_STATE;
+
+    scheduler->stop_requested = false;
+
+    BaseType_t task_err = xTaskCreatePinnedToCore( 
+        i2c_scheduler_task_entry, 
+        I2C_SCHEDULER_TASK_NAME, 
+        scheduler->config.task_stack_size, 
+        scheduler, 
+        scheduler->config.task_priority,
+        &scheduler->task_handle, 
+        APP_CPU_NUM );
+    if (task_err != pdPASS) {
+        scheduler->task_handle = NULL;
+        ESP_RETURN_ON_FALSE( false, ESP_ERR_NO_MEM, TAG, "create i2c scheduler task failed" );
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_stop(i2c_scheduler_handle_t handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    if (scheduler->task_handle == NULL) return ESP_OK;
+
+    /* stop scheduler task */
+    scheduler->stop_requested = true;
+    xTaskNotifyGive(scheduler->task_handle);
+    xSemaphoreTake(scheduler->stopped_handle, portMAX_DELAY);
+
+    scheduler->task_handle = NULL;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_lock_bus(i2c_scheduler_handle_t handle, const uint32_t timeout_ms) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    if (xSemaphoreTakeRecursive(scheduler->mutex_handle, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) return ESP_ERR_TIMEOUT;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_unlock_bus(i2c_scheduler_handle_t handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    /* wake the task, phases may have become ready while the bus was locked */
+    if (scheduler->task_handle) xTaskNotifyGive(scheduler->task_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_get_job_stats(i2c_scheduler_handle_t handle, i2c_scheduler_job_handle_t job_handle, i2c_scheduler_job_stats_t *const stats) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+    i2c_scheduler_job_t *job = (i2c_scheduler_job_t*)job_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler && job && stats );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+    *stats = job->stats;
+    if (job->jitter_count == 0) stats->jitter_min_us = 0;
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_get_stats(i2c_scheduler_handle_t handle, i2c_scheduler_stats_t *const stats) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler && stats );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+    stats->elapsed_us  = (uint64_t)(scheduler->config.clock() - scheduler->stats_time);
+    stats->busy_us     = scheduler->busy_time;
+    stats->phase_count = scheduler->phase_count;
+    stats->utilization = (stats->elapsed_us > 0) ? (float)stats->busy_us * 100.0f / (float)stats->elapsed_us : 0.0f;
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_reset_stats(i2c_scheduler_handle_t handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    xSemaphoreTakeRecursive(scheduler->mutex_handle, portMAX_DELAY);
+    scheduler->stats_time  = scheduler->config.clock();
+    scheduler->busy_time   = 0;
+    scheduler->phase_count = 0;
+    for (uint8_t i = 0; i < scheduler->config.max_jobs; i++) {
+        i2c_scheduler_reset_job_stats(&scheduler->jobs[i]);
+    }
+    xSemaphoreGiveRecursive(scheduler->mutex_handle);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_scheduler_delete(i2c_scheduler_handle_t handle) {
+    i2c_scheduler_context_t *scheduler = (i2c_scheduler_context_t*)handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler );
+
+    /* attempt to stop scheduler task */
+    ESP_RETURN_ON_ERROR( i2c_scheduler_stop(handle), TAG, "unable to stop i2c scheduler task, delete failed" );
+
+    vSemaphoreDelete(scheduler->stopped_handle);
+    vSemaphoreDelete(scheduler->mutex_handle);
+    free(scheduler->jobs);
+    free(scheduler);
+
+    return ESP_OK;
+}
@@ -0,0 +1,269 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_scheduler.h
+ * @defgroup schedule i2c_scheduler
+ * @{
+ *
+ * ESP-IDF I2C master bus scheduler
+ *
+ * Runs periodic measurement jobs for many device handles on one I2C master 
+ * bus from a single task.  A job is a start phase (i.e. trigger a conversion) 
+ * that returns the expected conversion wait, and a collect phase that reads the 
+ * result once the wait has elapsed.  Transactions are serialized because only 
+ * the scheduler touches the bus, while one device converts other devices are 
+ * started or collected.  Ready jobs are dispatched by priority and then by 
+ * earliest deadline.  Start jitter, response time, deadline misses, and bus 
+ * utilization are recorded.
+ * 
+ * The dispatcher does not sleep, it is driven by the configured clock and 
+ * returns the time of the next event.  This allows the scheduler to be run on 
+ * the host with a mock clock and bus.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_SCHEDULER_H__
+#define __I2C_SCHEDULER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * I2C scheduler macros
+*/
+#define I2C_SCHEDULER_CONFIG_DEFAULT {                  \
+        .max_jobs                   = 16,               \
+        .clock                      = NULL,             \
+        .task_stack_size            = 4096,             \
+        .task_priority              = 5 }
+
+/*
+ * I2C scheduler enumerator and structure declarations
+*/
+
+/**
+ * @brief I2C scheduler clock function signature, returns a monotonic time in microseconds.
+ */
+typedef int64_t (*i2c_scheduler_clock_t)(void);
+
+/**
+ * @brief I2C scheduler job start phase function signature.  The start phase issues the
+ * transactions that trigger a conversion and sets the conversion wait in microseconds.
+ */
+typedef esp_err_t (*i2c_scheduler_start_t)(void *device_handle, void *context, uint32_t *const wait_us);
+
+/**
+ * @brief I2C scheduler job collect phase function signature.  The collect phase reads the
+ * result of the conversion and hands it to the application through the context.  A collect
+ * phase that returns ESP_ERR_NOT_FINISHED (i.e. the AS7341 started its second SMUX phase) 
+ * is collected again after the conversion wait of the start phase, within the period.
+ */
+typedef esp_err_t (*i2c_scheduler_collect_t)(void *device_handle, void *context);
+
+/**
+ * @brief I2C scheduler configuration structure.
+ */
+typedef struct i2c_scheduler_config_s {
+    uint8_t                     max_jobs;           /*!< i2c scheduler, maximum number of jobs */
+    i2c_scheduler_clock_t       clock;              /*!< i2c scheduler, clock in microseconds, esp_timer_get_time when NULL */
+    uint32_t                    task_stack_size;    /*!< i2c scheduler, task stack size in bytes */
+    uint8_t                     task_priority;      /*!< i2c scheduler, task priority */
+} i2c_scheduler_config_t;
+
+/**
+ * @brief I2C scheduler job configuration structure.
+ */
+typedef struct i2c_scheduler_job_config_s {
+    const char*                 name;               /*!< i2c scheduler job, name */
+    void*                       device_handle;      /*!< i2c scheduler job, device driver handle passed to the phases */
+    void*                       context;            /*!< i2c scheduler job, user context passed to the phases */
+    i2c_scheduler_start_t       start;              /*!< i2c scheduler job, start phase, NULL for single phase jobs */
+    i2c_scheduler_collect_t     collect;            /*!< i2c scheduler job, collect phase */
+    uint32_t                    period_us;          /*!< i2c scheduler job, release period in microseconds */
+    uint32_t                    deadline_us;        /*!< i2c scheduler job, relative deadline in microseconds, the period when 0 */
+    uint32_t                    offset_us;          /*!< i2c scheduler job, first release offset in microseconds */
+    uint8_t                     priority;           /*!< i2c scheduler job, priority, higher values are dispatched first */
+} i2c_scheduler_job_config_t;
+
+/**
+ * @brief I2C scheduler job statistics structure.
+ */
+typedef struct i2c_scheduler_job_stats_s {
+    uint32_t                    run_count;          /*!< i2c scheduler job, number of completed runs */
+    uint32_t                    error_count;        /*!< i2c scheduler job, number of failed start or collect phases */
+    uint32_t                    not_finished_count; /*!< i2c scheduler job, number of collect phases re-armed because the conversion was not finished */
+    uint32_t                    deadline_miss_count;/*!< i2c scheduler job, number of runs completed after the deadline */
+    uint32_t                    overrun_count;      /*!< i2c scheduler job, number of releases skipped because the job was a period late */
+    uint32_t                    jitter_min_us;      /*!< i2c scheduler job, minimum start delay from release in microseconds */
+    uint32_t                    jitter_max_us;      /*!< i2c scheduler job, maximum start delay from release in microseconds */
+    uint32_t                    jitter_avg_us;      /*!< i2c scheduler job, average start delay from release in microseconds */
+    uint32_t                    response_max_us;    /*!< i2c scheduler job, maximum time from release to collect completion in microseconds */
+    uint64_t                    busy_us;            /*!< i2c scheduler job, time spent in start and collect phases in microseconds */
+} i2c_scheduler_job_stats_t;
+
+/**
+ * @brief I2C scheduler bus statistics structure.
+ */
+typedef struct i2c_scheduler_stats_s {
+    uint64_t                    elapsed_us;         /*!< i2c scheduler, time since the statistics were reset in microseconds */
+    uint64_t                    busy_us;            /*!< i2c scheduler, time spent in job phases in microseconds */
+    uint32_t                    phase_count;        /*!< i2c scheduler, number of start and collect phases dispatched */
+    float                       utilization;        /*!< i2c scheduler, bus utilization in percent */
+} i2c_scheduler_stats_t;
+
+/**
+ * @brief I2C scheduler opaque handle structure definition.
+ */
+typedef void* i2c_scheduler_handle_t;
+
+/**
+ * @brief I2C scheduler job opaque handle structure definition.
+ */
+typedef void* i2c_scheduler_job_handle_t;
+
+/**
+ * @brief Initializes an I2C scheduler.  Jobs are not dispatched until the scheduler
+ * task is started or `i2c_scheduler_dispatch` is called.
+ *
+ * @param[in] config I2C scheduler configuration.
+ * @param[out] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_init(const i2c_scheduler_config_t *config, i2c_scheduler_handle_t *handle);
+
+/**
+ * @brief Adds a periodic job to the I2C scheduler, the first release is the current time plus the offset.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[in] job_config I2C scheduler job configuration.
+ * @param[out] job_handle I2C scheduler job handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when the maximum number of jobs is reached.
+ */
+esp_err_t i2c_scheduler_add_job(i2c_scheduler_handle_t handle, const i2c_scheduler_job_config_t *job_config, i2c_scheduler_job_handle_t *job_handle);
+
+/**
+ * @brief Removes a job from the I2C scheduler, a conversion in progress is abandoned.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[in] job_handle I2C scheduler job handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_remove_job(i2c_scheduler_handle_t handle, i2c_scheduler_job_handle_t job_handle);
+
+/**
+ * @brief Dispatches at most one ready job phase and returns the time of the next event.  Ready
+ * phases are selected by priority and then by earliest absolute deadline.  This is called by
+ * the scheduler task and can be called directly with a mock clock for host testing.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[out] next_time Clock time of the next event in microseconds, INT64_MAX when there are no jobs.
+ * @return esp_err_t ESP_OK on success, job phase errors are recorded in the job statistics.
+ */
+esp_err_t i2c_scheduler_dispatch(i2c_scheduler_handle_t handle, int64_t *const next_time);
+
+/**
+ * @brief Starts the I2C scheduler task pinned to the application core.  The task sleeps
+ * until the next event, so events are resolved to the FreeRTOS tick period.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_start(i2c_scheduler_handle_t handle);
+
+/**
+ * @brief Stops the I2C scheduler task, the call returns after the current phase completes.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_stop(i2c_scheduler_handle_t handle);
+
+/**
+ * @brief Locks the I2C master bus for transactions outside of the scheduler (i.e. a display
+ * update).  Jobs are not dispatched while the bus is locked.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[in] timeout_ms Lock timeout in milliseconds.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT when the bus could not be locked.
+ */
+esp_err_t i2c_scheduler_lock_bus(i2c_scheduler_handle_t handle, const uint32_t timeout_ms);
+
+/**
+ * @brief Unlocks the I2C master bus.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_unlock_bus(i2c_scheduler_handle_t handle);
+
+/**
+ * @brief Gets the statistics of an I2C scheduler job.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[in] job_handle I2C scheduler job handle.
+ * @param[out] stats I2C scheduler job statistics.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_get_job_stats(i2c_scheduler_handle_t handle, i2c_scheduler_job_handle_t job_handle, i2c_scheduler_job_stats_t *const stats);
+
+/**
+ * @brief Gets the I2C scheduler bus statistics.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @param[out] stats I2C scheduler bus statistics.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_get_stats(i2c_scheduler_handle_t handle, i2c_scheduler_stats_t *const stats);
+
+/**
+ * @brief Resets the I2C scheduler bus and job statistics.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_reset_stats(i2c_scheduler_handle_t handle);
+
+/**
+ * @brief Stops the I2C scheduler task when running and frees the I2C scheduler handle.
+ *
+ * @param[in] handle I2C scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_scheduler_delete(i2c_scheduler_handle_t handle);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __I2C_SCHEDULER_H__
@@ -0,0 +1,491 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ahrs.c
+ *
+ * ESP-IDF attitude and heading reference system (AHRS) library
+ *
+ * Madgwick and Mahony orientation filters, ported from the x-io technologies
+ * open-source IMU and AHRS algorithms.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "ahrs.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <esp_check.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+ * AHRS definitions
+*/
+#define AHRS_BETA_DEFAULT       (0.1f)                  //!< default Madgwick gain
+#define AHRS_KP_DEFAULT         (1.0f)                  //!< default Mahony proportional gain
+#define AHRS_KI_DEFAULT         (0.0f)                  //!< default Mahony integral gain
+#define AHRS_DEG_TO_RAD         (0.01745329252f)        //!< degrees to radians
+#define AHRS_RAD_TO_DEG         (57.2957795131f)        //!< radians to degrees
+
+/*
+* static constant declerations
+*/
+static const char *TAG = "ahrs";
+
+
+/**
+ * @brief Calculates the inverse square root, returns 0 when the argument is zero.
+ * 
+ * @param x Argument.
+ * @return float Inverse square root of x.
+ */
+static inline float ahrs_inv_sqrt(const float x) {
+    return (x > 0.0f) ? 1.0f / sqrtf(x) : 0.0f;
+}
+
+/**
+ * @brief Normalizes the orientation quaternion of the AHRS filter.
+ * 
+ * @param q Quaternion to normalize.
+ */
+static inline void ahrs_normalize_quaternion(quaternion_t *const q) {
+    const float recip_norm = ahrs_inv_sqrt(q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z);
+
+    q->w *= recip_norm;
+    q->x *= recip_norm;
+    q->y *= recip_norm;
+    q->z *= recip_norm;
+}
+
+/**
+ * @brief Integrates the rate of change of the quaternion.
+ * 
+ * @param q Quaternion to integrate.
+ * @param q_dot Rate of change of the quaternion.
+ * @param dt Delta time in seconds.
+ */
+static inline void ahrs_integrate_quaternion(quaternion_t *const q, const quaternion_t q_dot, const float dt) {
+    q->w += q_dot.w * dt;
+    q->x += q_dot.x * dt;
+    q->y += q_dot.y * dt;
+    q->z += q_dot.z * dt;
+
+    ahrs_normalize_quaternion(q);
+}
+
+/**
+ * @brief Calculates the rate of change of the quaternion from the gyroscope (q_dot = 0.5 * q * ω).
+ * 
+ * @param q Orientation quaternion.
+ * @param gx Gyroscope x-axis in radians per second.
+ * @param gy Gyroscope y-axis in radians per second.
+ * @param gz Gyroscope z-axis in radians per second.
+ * @return quaternion_t Rate of change of the quaternion.
+ */
+static inline quaternion_t ahrs_gyro_q_dot(const quaternion_t q, const float gx, const float gy, const float gz) {
+    return (quaternion_t) {
+        .w = 0.5f * (-q.x * gx - q.y * gy - q.z * gz),
+        .x = 0.5f * ( q.w * gx + q.y * gz - q.z * gy),
+        .y = 0.5f * ( q.w * gy - q.x * gz + q.z * gx),
+        .z = 0.5f * ( q.w * gz + q.x * gy - q.y * gx)
+    };
+}
+
+/**
+ * @brief Madgwick 6-DOF update (gyroscope and accelerometer).
+ */
+static inline void ahrs_madgwick_update_imu(ahrs_handle_t handle, float gx, float gy, float gz, float ax, float ay, float az, const float dt) {
+    quaternion_t *const q = &handle->q;
+    quaternion_t q_dot = ahrs_gyro_q_dot(*q, gx, gy, gz);
+
+    /* compute feedback only if accelerometer measurement is valid (avoids NaN in accelerometer normalisation) */
+    float recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+    if(recip_norm > 0.0f) {
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* auxiliary variables to avoid repeated arithmetic */
+        const float _2q0 = 2.0f * q->w;
+        const float _2q1 = 2.0f * q->x;
+        const float _2q2 = 2.0f * q->y;
+        const float _2q3 = 2.0f * q->z;
+        const float _4q0 = 4.0f * q->w;
+        const float _4q1 = 4.0f * q->x;
+        const float _4q2 = 4.0f * q->y;
+        const float _8q1 = 8.0f * q->x;
+        const float _8q2 = 8.0f * q->y;
+        const float q0q0 = q->w * q->w;
+        const float q1q1 = q->x * q->x;
+        const float q2q2 = q->y * q->y;
+        const float q3q3 = q->z * q->z;
+
+        /* gradient decent algorithm corrective step */
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q->x - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4.0f * q0q0 * q->y + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4.0f * q1q1 * q->z - _2q1 * ax + 4.0f * q2q2 * q->z - _2q2 * ay;
+
+        recip_norm = ahrs_inv_sqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+
+        /* apply feedback step */
+        q_dot.w -= handle->beta * s0 * recip_norm;
+        q_dot.x -= handle->beta * s1 * recip_norm;
+        q_dot.y -= handle->beta * s2 * recip_norm;
+        q_dot.z -= handle->beta * s3 * recip_norm;
+    }
+
+    ahrs_integrate_quaternion(q, q_dot, dt);
+}
+
+/**
+ * @brief Madgwick 9-DOF update (gyroscope, accelerometer and magnetometer).
+ */
+static inline void ahrs_madgwick_update(ahrs_handle_t handle, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz, const float dt) {
+    quaternion_t *const q = &handle->q;
+
+    /* use 6-DOF algorithm if magnetometer measurement is invalid (avoids NaN in magnetometer normalisation) */
+    float recip_norm = ahrs_inv_sqrt(mx * mx + my * my + mz * mz);
+    if(recip_norm == 0.0f) {
+        ahrs_madgwick_update_imu(handle, gx, gy, gz, ax, ay, az, dt);
+        return;
+    }
+    mx *= recip_norm;
+    my *= recip_norm;
+    mz *= recip_norm;
+
+    quaternion_t q_dot = ahrs_gyro_q_dot(*q, gx, gy, gz);
+
+    /* compute feedback only if accelerometer measurement is valid (avoids NaN in accelerometer normalisation) */
+    recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+    if(recip_norm > 0.0f) {
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* auxiliary variables to avoid repeated arithmetic */
+        const float _2q0mx = 2.0f * q->w * mx;
+        const float _2q0my = 2.0f * q->w * my;
+        const float _2q0mz = 2.0f * q->w * mz;
+        const float _2q1mx = 2.0f * q->x * mx;
+        const float _2q0 = 2.0f * q->w;
+        const float _2q1 = 2.0f * q->x;
+        const float _2q2 = 2.0f * q->y;
+        const float _2q3 = 2.0f * q->z;
+        const float _2q0q2 = 2.0f * q->w * q->y;
+        const float _2q2q3 = 2.0f * q->y * q->z;
+        const float q0q0 = q->w * q->w;
+        const float q0q1 = q->w * q->x;
+        const float q0q2 = q->w * q->y;
+        const float q0q3 = q->w * q->z;
+        const float q1q1 = q->x * q->x;
+        const float q1q2 = q->x * q->y;
+        const float q1q3 = q->x * q->z;
+        const float q2q2 = q->y * q->y;
+        const float q2q3 = q->y * q->z;
+        const float q3q3 = q->z * q->z;
+
+        /* reference direction of earth's magnetic field */
+        const float hx = mx * q0q0 - _2q0my * q->z + _2q0mz * q->y + mx * q1q1 + _2q1 * my * q->y + _2q1 * mz * q->z - mx * q2q2 - mx * q3q3;
+        const float hy = _2q0mx * q->z + my * q0q0 - _2q0mz * q->x + _2q1mx * q->y - my * q1q1 + my * q2q2 + _2q2 * mz * q->z - my * q3q3;
+        const float _2bx = sqrtf(hx * hx + hy * hy);
+        const float _2bz = -_2q0mx * q->y + _2q0my * q->x + mz * q0q0 + _2q1mx * q->z - mz * q1q1 + _2q2 * my * q->z - mz * q2q2 + mz * q3q3;
+        const float _4bx = 2.0f * _2bx;
+        const float _4bz = 2.0f * _2bz;
+
+        /* gradient decent algorithm corrective step */
+        float s0 = -_2q2 * (2.0f * q1q3 - _2q0q2 - ax) + _2q1 * (2.0f * q0q1 + _2q2q3 - ay) - _2bz * q->y * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (-_2bx * q->z + _2bz * q->x) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + _2bx * q->y * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+        float s1 = _2q3 * (2.0f * q1q3 - _2q0q2 - ax) + _2q0 * (2.0f * q0q1 + _2q2q3 - ay) - 4.0f * q->x * (1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az) + _2bz * q->z * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (_2bx * q->y + _2bz * q->w) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + (_2bx * q->z - _4bz * q->x) * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+        float s2 = -_2q0 * (2.0f * q1q3 - _2q0q2 - ax) + _2q3 * (2.0f * q0q1 + _2q2q3 - ay) - 4.0f * q->y * (1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az) + (-_4bx * q->y - _2bz * q->w) * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (_2bx * q->x + _2bz * q->z) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + (_2bx * q->w - _4bz * q->y) * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+        float s3 = _2q1 * (2.0f * q1q3 - _2q0q2 - ax) + _2q2 * (2.0f * q0q1 + _2q2q3 - ay) + (-_4bx * q->z + _2bz * q->x) * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (-_2bx * q->w + _2bz * q->y) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + _2bx * q->x * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+
+        recip_norm = ahrs_inv_sqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+
+        /* apply feedback step */
+        q_dot.w -= handle->beta * s0 * recip_norm;
+        q_dot.x -= handle->beta * s1 * recip_norm;
+        q_dot.y -= handle->beta * s2 * recip_norm;
+        q_dot.z -= handle->beta * s3 * recip_norm;
+    }
+
+    ahrs_integrate_quaternion(q, q_dot, dt);
+}
+
+/**
+ * @brief Mahony feedback step, applies the proportional and integral error terms to the gyroscope rates.
+ */
+static inline void ahrs_mahony_feedback(ahrs_handle_t handle, float *const gx, float *const gy, float *const gz, const float ex, const float ey, const float ez, const float dt) {
+    /* compute and apply integral feedback if enabled */
+    if(handle->ki > 0.0f) {
+        handle->integral_fb.x += handle->ki * ex * dt;
+        handle->integral_fb.y += handle->ki * ey * dt;
+        handle->integral_fb.z += handle->ki * ez * dt;
+        *gx += handle->integral_fb.x;
+        *gy += handle->integral_fb.y;
+        *gz += handle->integral_fb.z;
+    } else {
+        /* prevent integral windup */
+        handle->integral_fb = (vector_float_t){ .x = 0.0f, .y = 0.0f, .z = 0.0f };
+    }
+
+    /* apply proportional feedback */
+    *gx += handle->kp * ex;
+    *gy += handle->kp * ey;
+    *gz += handle->kp * ez;
+}
+
+/**
+ * @brief Mahony 6-DOF update (gyroscope and accelerometer).
+ */
+static inline void ahrs_mahony_update_imu(ahrs_handle_t handle, float gx, float gy, float gz, float ax, float ay, float az, const float dt) {
+    quaternion_t *const q = &handle->q;
+
+    /* compute feedback only if accelerometer measurement is valid (avoids NaN in accelerometer normalisation) */
+    const float recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+    if(recip_norm > 0.0f) {
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* estimated direction of gravity */
+        const float vx = q->x * q->z - q->w * q->y;
+        const float vy = q->w * q->x + q->y * q->z;
+        const float vz = q->w * q->w - 0.5f + q->z * q->z;
+
+        /* error is sum of cross product between estimated and measured direction of gravity */
+        ahrs_mahony_feedback(handle, &gx, &gy, &gz, (ay * vz - az * vy), (az * vx - ax * vz), (ax * vy - ay * vx), dt);
+    }
+
+    ahrs_integrate_quaternion(q, ahrs_gyro_q_dot(*q, gx, gy, gz), dt);
+}
+
+/**
+ * @brief Mahony 9-DOF update (gyroscope, accelerometer and magnetometer).
+ */
+static inline void ahrs_mahony_update(ahrs_handle_t handle, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz, const float dt) {
+    quaternion_t *const q = &handle->q;
+
+    /* use 6-DOF algorithm if magnetometer measurement is invalid (avoids NaN in magnetometer normalisation) */
+    float recip_norm = ahrs_inv_sqrt(mx * mx + my * my + mz * mz);
+    if(recip_norm == 0.0f) {
+        ahrs_mahony_update_imu(handle, gx, gy, gz, ax, ay, az, dt);
+        return;
+    }
+    mx *= recip_norm;
+    my *= recip_norm;
+    mz *= recip_norm;
+
+    /* compute feedback only if accelerometer measurement is valid (avoids NaN in accelerometer normalisation) */
+    recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+    if(recip_norm > 0.0f) {
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* auxiliary variables to avoid repeated arithmetic */
+        const float q0q0 = q->w * q->w;
+        const float q0q1 = q->w * q->x;
+        const float q0q2 = q->w * q->y;
+        const float q0q3 = q->w * q->z;
+        const float q1q1 = q->x * q->x;
+        const float q1q2 = q->x * q->y;
+        const float q1q3 = q->x * q->z;
+        const float q2q2 = q->y * q->y;
+        const float q2q3 = q->y * q->z;
+        const float q3q3 = q->z * q->z;
+
+        /* reference direction of earth's magnetic field */
+        const float hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+        const float hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
+        const float bx = sqrtf(hx * hx + hy * hy);
+        const float bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
+
+        /* estimated direction of gravity and magnetic field */
+        const float vx = q1q3 - q0q2;
+        const float vy = q0q1 + q2q3;
+        const float vz = q0q0 - 0.5f + q3q3;
+        const float wx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+        const float wy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+        const float wz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+
+        /* error is sum of cross product between estimated direction and measured direction of field vectors */
+        ahrs_mahony_feedback(handle, &gx, &gy, &gz,
+                            (ay * vz - az * vy) + (my * wz - mz * wy),
+                            (az * vx - ax * vz) + (mz * wx - mx * wz),
+                            (ax * vy - ay * vx) + (mx * wy - my * wx), dt);
+    }
+
+    ahrs_integrate_quaternion(q, ahrs_gyro_q_dot(*q, gx, gy, gz), dt);
+}
+
+esp_err_t ahrs_init(const ahrs_algorithms_t algorithm, ahrs_handle_t *ahrs_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+    ESP_RETURN_ON_FALSE( algorithm == AHRS_ALGORITHM_MADGWICK || algorithm == AHRS_ALGORITHM_MAHONY, ESP_ERR_INVALID_ARG, TAG, "invalid algorithm, init failed");
+
+    /* validate memory availability for handle */
+    ahrs_handle_t out_handle = (ahrs_handle_t)calloc(1, sizeof(ahrs_t));
+    ESP_RETURN_ON_FALSE(out_handle, ESP_ERR_NO_MEM, TAG, "no memory for ahrs handle, init failed");
+
+    /* We will set the variables like so, these can also be tuned by the user */
+    out_handle->algorithm = algorithm;
+    out_handle->beta      = AHRS_BETA_DEFAULT;
+    out_handle->kp        = AHRS_KP_DEFAULT;
+    out_handle->ki        = AHRS_KI_DEFAULT;
+
+    /* set identity orientation */
+    out_handle->q         = (quaternion_t){ .w = 1.0f, .x = 0.0f, .y = 0.0f, .z = 0.0f };
+
+    /* set handle */
+    *ahrs_handle = out_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_update(ahrs_handle_t ahrs_handle, const vector_float_t *const gyro, const vector_float_t *const accel, const vector_float_t *const mag, const float delta_time) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle && gyro && accel );
+    ESP_ARG_CHECK( delta_time > 0.0f );
+
+    /* convert gyroscope degrees/sec to radians/sec */
+    const float gx = gyro->x * AHRS_DEG_TO_RAD;
+    const float gy = gyro->y * AHRS_DEG_TO_RAD;
+    const float gz = gyro->z * AHRS_DEG_TO_RAD;
+
+    if(ahrs_handle->algorithm == AHRS_ALGORITHM_MADGWICK) {
+        if(mag) {
+            ahrs_madgwick_update(ahrs_handle, gx, gy, gz, accel->x, accel->y, accel->z, mag->x, mag->y, mag->z, delta_time);
+        } else {
+            ahrs_madgwick_update_imu(ahrs_handle, gx, gy, gz, accel->x, accel->y, accel->z, delta_time);
+        }
+    } else {
+        if(mag) {
+            ahrs_mahony_update(ahrs_handle, gx, gy, gz, accel->x, accel->y, accel->z, mag->x, mag->y, mag->z, delta_time);
+        } else {
+            ahrs_mahony_update_imu(ahrs_handle, gx, gy, gz, accel->x, accel->y, accel->z, delta_time);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_quaternion(ahrs_handle_t ahrs_handle, quaternion_t *const quaternion) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle && quaternion );
+
+    *quaternion = ahrs_handle->q;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_euler_angles(ahrs_handle_t ahrs_handle, ahrs_euler_angles_t *const angles) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle && angles );
+
+    const quaternion_t q = ahrs_handle->q;
+
+    /* clamp pitch argument to avoid NaN at gimbal lock due to rounding */
+    float sin_pitch = 2.0f * (q.w * q.y - q.z * q.x);
+    if(sin_pitch > 1.0f) sin_pitch = 1.0f;
+    if(sin_pitch < -1.0f) sin_pitch = -1.0f;
+
+    angles->roll  = atan2f(2.0f * (q.w * q.x + q.y * q.z), 1.0f - 2.0f * (q.x * q.x + q.y * q.y)) * AHRS_RAD_TO_DEG;
+    angles->pitch = asinf(sin_pitch) * AHRS_RAD_TO_DEG;
+    angles->yaw   = atan2f(2.0f * (q.w * q.z + q.x * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z)) * AHRS_RAD_TO_DEG;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_set_quaternion(ahrs_handle_t ahrs_handle, const quaternion_t quaternion) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+
+    ahrs_handle->q = quaternion;
+    ahrs_normalize_quaternion(&ahrs_handle->q);
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_set_beta(ahrs_handle_t ahrs_handle, const float beta) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+
+    ahrs_handle->beta = beta;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_beta(ahrs_handle_t ahrs_handle, float *const beta) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle && beta );
+
+    *beta = ahrs_handle->beta;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_set_gains(ahrs_handle_t ahrs_handle, const float kp, const float ki) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+
+    ahrs_handle->kp = kp;
+    ahrs_handle->ki = ki;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_gains(ahrs_handle_t ahrs_handle, float *const kp, float *const ki) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle && kp && ki );
+
+    *kp = ahrs_handle->kp;
+    *ki = ahrs_handle->ki;
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_reset(ahrs_handle_t ahrs_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+
+    ahrs_handle->q           = (quaternion_t){ .w = 1.0f, .x = 0.0f, .y = 0.0f, .z = 0.0f };
+    ahrs_handle->integral_fb = (vector_float_t){ .x = 0.0f, .y = 0.0f, .z = 0.0f };
+
+    return ESP_OK;
+}
+
+esp_err_t ahrs_delete(ahrs_handle_t ahrs_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahrs_handle );
+
+    free(ahrs_handle);
+
+    return ESP_OK;
+}
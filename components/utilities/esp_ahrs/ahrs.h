@@ -0,0 +1,205 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file ahrs.h
+ * @defgroup math ahrs
+ * @{
+ *
+ * ESP-IDF attitude and heading reference system (AHRS) library
+ * 
+ * Quaternion based 6-DOF (gyroscope and accelerometer) and 9-DOF (gyroscope,
+ * accelerometer and magnetometer) orientation filters.
+ * 
+ * https://x-io.co.uk/open-source-imu-and-ahrs-algorithms/
+ * https://courses.cs.washington.edu/courses/cse466/14au/labs/l4/madgwick_internal_report.pdf
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __AHRS_H__
+#define __AHRS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <quaternion.h>
+#include <vector_float.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief AHRS orientation filter algorithms enumerator.
+ */
+typedef enum ahrs_algorithms_e {
+    AHRS_ALGORITHM_MADGWICK = 0, /*!< gradient descent orientation filter */
+    AHRS_ALGORITHM_MAHONY   = 1  /*!< explicit complementary (proportional-integral) orientation filter */
+} ahrs_algorithms_t;
+
+/**
+ * @brief AHRS euler angles structure.
+ */
+typedef struct ahrs_euler_angles_s {
+    float roll;     /*!< rotation about the x-axis in degrees (-180 to 180) */
+    float pitch;    /*!< rotation about the y-axis in degrees (-90 to 90) */
+    float yaw;      /*!< rotation about the z-axis in degrees (-180 to 180) */
+} ahrs_euler_angles_t;
+
+/**
+ * @brief AHRS state structure.
+ */
+struct ahrs_t {
+    ahrs_algorithms_t algorithm;    // Orientation filter algorithm
+    float             beta;         // Madgwick algorithm gain (gyroscope measurement error in rad/s)
+    float             kp;           // Mahony algorithm proportional gain
+    float             ki;           // Mahony algorithm integral gain
+    vector_float_t    integral_fb;  // Mahony algorithm integral error terms scaled by ki
+    quaternion_t      q;            // Orientation of the sensor frame relative to the earth frame
+};
+
+/**
+ * @brief AHRS definition.
+ */
+typedef struct ahrs_t ahrs_t;
+
+/**
+ * @brief AHRS handle definition.
+ */
+typedef struct ahrs_t *ahrs_handle_t;
+
+/**
+ * @brief Initializes an AHRS handle instance to fuse data from a gyroscope, accelerometer and optional
+ * magnetometer.  The handle is allocated once, updates are allocation free.
+ * 
+ * @param[in] algorithm Orientation filter algorithm.
+ * @param[out] ahrs_handle AHRS handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_init(const ahrs_algorithms_t algorithm, ahrs_handle_t *ahrs_handle);
+
+/**
+ * @brief Updates the orientation of the AHRS filter from a gyroscope, accelerometer and optional
+ * magnetometer sample.  The heading is not corrected when the magnetometer sample is NULL (6-DOF).
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[in] gyro Gyroscope sample in degrees per second.
+ * @param[in] accel Accelerometer sample in any unit (i.e. relative to standard gravity), the sample is normalized.
+ * @param[in] mag Magnetometer sample in any unit (i.e. micro-tesla), the sample is normalized, NULL when unavailable.
+ * @param[in] delta_time Delta time in seconds since the last update.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_update(ahrs_handle_t ahrs_handle, const vector_float_t *const gyro, const vector_float_t *const accel, const vector_float_t *const mag, const float delta_time);
+
+/**
+ * @brief Gets the orientation quaternion of the AHRS filter.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[out] quaternion Orientation quaternion (w, x, y, z).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_get_quaternion(ahrs_handle_t ahrs_handle, quaternion_t *const quaternion);
+
+/**
+ * @brief Gets the orientation of the AHRS filter as euler angles (aerospace z-y-x sequence).
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[out] angles Roll, pitch and yaw in degrees.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_get_euler_angles(ahrs_handle_t ahrs_handle, ahrs_euler_angles_t *const angles);
+
+/**
+ * @brief Sets the orientation quaternion and should be used to set the starting orientation.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[in] quaternion Orientation quaternion (w, x, y, z), the quaternion is normalized.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_set_quaternion(ahrs_handle_t ahrs_handle, const quaternion_t quaternion);
+
+/**
+ * @brief Sets the Madgwick algorithm gain.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[in] beta Madgwick algorithm gain (default 0.1).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_set_beta(ahrs_handle_t ahrs_handle, const float beta);
+
+/**
+ * @brief Gets the Madgwick algorithm gain.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[out] beta Madgwick algorithm gain.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_get_beta(ahrs_handle_t ahrs_handle, float *const beta);
+
+/**
+ * @brief Sets the Mahony algorithm proportional and integral gains.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[in] kp Mahony algorithm proportional gain (default 1.0).
+ * @param[in] ki Mahony algorithm integral gain (default 0.0).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_set_gains(ahrs_handle_t ahrs_handle, const float kp, const float ki);
+
+/**
+ * @brief Gets the Mahony algorithm proportional and integral gains.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @param[out] kp Mahony algorithm proportional gain.
+ * @param[out] ki Mahony algorithm integral gain.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_get_gains(ahrs_handle_t ahrs_handle, float *const kp, float *const ki);
+
+/**
+ * @brief Resets the orientation to the identity quaternion and clears the integral error terms.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_reset(ahrs_handle_t ahrs_handle);
+
+/**
+ * @brief Frees AHRS handle.
+ * 
+ * @param[in] ahrs_handle AHRS handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t ahrs_delete(ahrs_handle_t ahrs_handle);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __AHRS_H__
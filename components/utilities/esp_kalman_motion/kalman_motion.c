@@ -206,4 +206,144 @@ esp_err_t kalman_motion_delete(kalman_motion_handle_t kalman_handle) {
     if(kalman_handle) free(kalman_handle);
 
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Updates all axes of a multi-axis Kalman motion filter with one sample.  The 
+ * arithmetic is identical to `kalman_motion_get_angle` but runs over struct-of-arrays.
+ * 
+ * @param handle Multi-axis Kalman motion state handle.
+ * @param new_angles New angles in degrees, one per axis.
+ * @param new_rates New rates in degrees per second, one per axis.
+ * @param dt Delta time in seconds.
+ * @param angles Calculated angles, one per axis, or NULL.
+ */
+static inline void kalman_motion_axes_update(kalman_motion_axes_handle_t handle, const float *const new_angles, const float *const new_rates, const float dt, float *const angles) {
+    for(uint8_t i = 0; i < handle->axes_count; i++) {
+        /* Step 1 - project the state ahead */
+        handle->rate[i]   = new_rates[i] - handle->bias[i];
+        handle->angle[i] += dt * handle->rate[i];
+
+        /* Step 2 - project the error covariance ahead */
+        const float p11 = handle->p11[i];
+        handle->p00[i] += dt * (dt * p11 - handle->p01[i] - handle->p10[i] + handle->q_angle[i]);
+        handle->p01[i] -= dt * p11;
+        handle->p10[i] -= dt * p11;
+        handle->p11[i] += handle->q_bias[i] * dt;
+
+        /* Step 3 - angle difference */
+        const float y = new_angles[i] - handle->angle[i];
+
+        /* Step 4 & 5 - estimate error and Kalman gain */
+        const float s  = handle->p00[i] + handle->r_measure[i];
+        const float k0 = handle->p00[i] / s;
+        const float k1 = handle->p10[i] / s;
+
+        /* Step 6 - update estimate with measurement */
+        handle->angle[i] += k0 * y;
+        handle->bias[i]  += k1 * y;
+
+        /* Step 7 - update the error covariance */
+        const float p00_temp = handle->p00[i];
+        const float p01_temp = handle->p01[i];
+
+        handle->p00[i] -= k0 * p00_temp;
+        handle->p01[i] -= k0 * p01_temp;
+        handle->p10[i] -= k1 * p00_temp;
+        handle->p11[i] -= k1 * p01_temp;
+
+        if(angles) angles[i] = handle->angle[i];
+    }
+}
+
+esp_err_t kalman_motion_axes_init(const uint8_t axes_count, kalman_motion_axes_handle_t *kalman_axes_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle );
+    ESP_RETURN_ON_FALSE( axes_count > 0 && axes_count <= KALMAN_MOTION_AXES_MAX, ESP_ERR_INVALID_ARG, TAG, "axes count is out of range, init failed");
+
+    /* validate memory availability for handle */
+    kalman_motion_axes_handle_t out_handle = (kalman_motion_axes_handle_t)calloc(1, sizeof(kalman_motion_axes_t));
+    ESP_RETURN_ON_FALSE(out_handle, ESP_ERR_NO_MEM, TAG, "no memory for kalman axes handle, init failed");
+
+    out_handle->axes_count = axes_count;
+
+    /* same defaults as the single axis filter, angle, bias and covariance are zeroed by calloc */
+    for(uint8_t i = 0; i < axes_count; i++) {
+        out_handle->q_angle[i]   = 0.001f;
+        out_handle->q_bias[i]    = 0.003f;
+        out_handle->r_measure[i] = 0.03f;
+    }
+
+    /* set handle */
+    *kalman_axes_handle = out_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_get_angles(kalman_motion_axes_handle_t kalman_axes_handle, const float *const new_angles, const float *const new_rates, const float delta_time, float *const angles) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle && new_angles && new_rates && angles );
+
+    kalman_motion_axes_update(kalman_axes_handle, new_angles, new_rates, delta_time, angles);
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_process_batch(kalman_motion_axes_handle_t kalman_axes_handle, const float *const new_angles, const float *const new_rates, const float *const delta_times, const uint16_t samples_count, float *const angles) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle && new_angles && new_rates && delta_times );
+
+    const uint8_t axes_count = kalman_axes_handle->axes_count;
+
+    for(uint16_t n = 0; n < samples_count; n++) {
+        const size_t offset = (size_t)n * axes_count;
+
+        kalman_motion_axes_update(kalman_axes_handle, &new_angles[offset], &new_rates[offset], delta_times[n], angles ? &angles[offset] : NULL);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_get_state(kalman_motion_axes_handle_t kalman_axes_handle, float *const angles, float *const rates) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle && angles );
+
+    for(uint8_t i = 0; i < kalman_axes_handle->axes_count; i++) {
+        angles[i] = kalman_axes_handle->angle[i];
+        if(rates) rates[i] = kalman_axes_handle->rate[i];
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_set_angles(kalman_motion_axes_handle_t kalman_axes_handle, const float *const angles) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle && angles );
+
+    for(uint8_t i = 0; i < kalman_axes_handle->axes_count; i++) {
+        kalman_axes_handle->angle[i] = angles[i];
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_set_noise(kalman_motion_axes_handle_t kalman_axes_handle, const uint8_t axis, const float q_angle, const float q_bias, const float r_measure) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle );
+    ESP_ARG_CHECK( axis < kalman_axes_handle->axes_count );
+
+    kalman_axes_handle->q_angle[axis]   = q_angle;
+    kalman_axes_handle->q_bias[axis]    = q_bias;
+    kalman_axes_handle->r_measure[axis] = r_measure;
+
+    return ESP_OK;
+}
+
+esp_err_t kalman_motion_axes_delete(kalman_motion_axes_handle_t kalman_axes_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( kalman_axes_handle );
+
+    free(kalman_axes_handle);
+
+    return ESP_OK;
+}
@@ -62,6 +62,29 @@ struct kalman_motion_t {
     float p[2][2];     // Error covariance matrix - This is a 2x2 matrix
 };
 
+/**
+ * @brief Maximum number of axes of a multi-axis Kalman motion filter.
+ */
+#define KALMAN_MOTION_AXES_MAX  (6)
+
+/**
+ * @brief Multi-axis Kalman motion state structure.  Holds independent 2-state filters in 
+ * struct-of-arrays form so that all axes are updated in one pass.
+ */
+struct kalman_motion_axes_t {
+    uint8_t axes_count;                     // Number of axes in use
+    float q_angle[KALMAN_MOTION_AXES_MAX];   // Process noise variance for the accelerometer per axis
+    float q_bias[KALMAN_MOTION_AXES_MAX];    // Process noise variance for the gyro bias per axis
+    float r_measure[KALMAN_MOTION_AXES_MAX]; // Measurement noise variance per axis
+    float angle[KALMAN_MOTION_AXES_MAX];     // The angle calculated by the Kalman filter per axis
+    float bias[KALMAN_MOTION_AXES_MAX];      // The gyro bias calculated by the Kalman filter per axis
+    float rate[KALMAN_MOTION_AXES_MAX];      // Unbiased rate calculated from the rate and the calculated bias per axis
+    float p00[KALMAN_MOTION_AXES_MAX];       // Error covariance matrix element [0][0] per axis
+    float p01[KALMAN_MOTION_AXES_MAX];       // Error covariance matrix element [0][1] per axis
+    float p10[KALMAN_MOTION_AXES_MAX];       // Error covariance matrix element [1][0] per axis
+    float p11[KALMAN_MOTION_AXES_MAX];       // Error covariance matrix element [1][1] per axis
+};
+
 /**
  * @brief Kalman motion definition.
  */
@@ -72,6 +95,16 @@ typedef struct kalman_motion_t kalman_motion_t;
  */
 typedef struct kalman_motion_t *kalman_motion_handle_t;
 
+/**
+ * @brief Multi-axis Kalman motion definition.
+ */
+typedef struct kalman_motion_axes_t kalman_motion_axes_t;
+
+/**
+ * @brief Multi-axis Kalman motion handle definition.
+ */
+typedef struct kalman_motion_axes_t *kalman_motion_axes_handle_t;
+
 /**
  * @brief Initializes a kalman motion handle instance to filter data from a gyroscope and/or accelerometer.
  * 
@@ -172,6 +205,82 @@ esp_err_t kalman_motion_get_r_measure(kalman_motion_handle_t kalman_handle, floa
  */
 esp_err_t kalman_motion_delete(kalman_motion_handle_t kalman_handle);
 
+/**
+ * @brief Initializes a multi-axis Kalman motion handle instance to filter data from a gyroscope and/or 
+ * accelerometer (i.e. roll, pitch and yaw) with a single handle.
+ * 
+ * @param[in] axes_count Number of axes to filter (1 to `KALMAN_MOTION_AXES_MAX`).
+ * @param[out] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_init(const uint8_t axes_count, kalman_motion_axes_handle_t *kalman_axes_handle);
+
+/**
+ * @brief Calculates angles of all axes using a Kalman motion filter per axis.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @param[in] new_angles New angles in degrees to process, one per axis.
+ * @param[in] new_rates New rates in degrees per second to process, one per axis.
+ * @param[in] delta_time Delta time in seconds.
+ * @param[out] angles Calculated angles using Kalman filter, one per axis.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_get_angles(kalman_motion_axes_handle_t kalman_axes_handle, const float *const new_angles, const float *const new_rates, const float delta_time, float *const angles);
+
+/**
+ * @brief Calculates angles of all axes for a batch of samples (i.e. drained from a FIFO) with a delta 
+ * time per sample.  Samples are interleaved by axis, sample `n` of axis `a` is at index `n * axes_count + a`.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @param[in] new_angles New angles in degrees to process, `samples_count * axes_count` values.
+ * @param[in] new_rates New rates in degrees per second to process, `samples_count * axes_count` values.
+ * @param[in] delta_times Delta time in seconds per sample, `samples_count` values.
+ * @param[in] samples_count Number of samples in the batch.
+ * @param[out] angles Calculated angles using Kalman filter, `samples_count * axes_count` values, or NULL when 
+ * only the last state is of interest (see `kalman_motion_axes_get_state`).
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_process_batch(kalman_motion_axes_handle_t kalman_axes_handle, const float *const new_angles, const float *const new_rates, const float *const delta_times, const uint16_t samples_count, float *const angles);
+
+/**
+ * @brief Gets the current angles and unbiased rates of all axes.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @param[out] angles Angles in degrees, one per axis.
+ * @param[out] rates Unbiased rates in degrees per second, one per axis, or NULL.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_get_state(kalman_motion_axes_handle_t kalman_axes_handle, float *const angles, float *const rates);
+
+/**
+ * @brief Sets the angles and should be used to set the starting angles.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @param[in] angles Angles in degrees, one per axis.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_set_angles(kalman_motion_axes_handle_t kalman_axes_handle, const float *const angles);
+
+/**
+ * @brief Sets q_angle, q_bias and r_measure noise variances of an axis.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @param[in] axis Axis index (0 to `axes_count - 1`).
+ * @param[in] q_angle Angle noise variance in degrees.
+ * @param[in] q_bias Bias noise variance.
+ * @param[in] r_measure Measurement noise variance.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_set_noise(kalman_motion_axes_handle_t kalman_axes_handle, const uint8_t axis, const float q_angle, const float q_bias, const float r_measure);
+
+/**
+ * @brief Frees multi-axis Kalman motion handle.
+ * 
+ * @param[in] kalman_axes_handle Multi-axis Kalman motion state handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t kalman_motion_axes_delete(kalman_motion_axes_handle_t kalman_axes_handle);
+
 
 
 #ifdef __cplusplus
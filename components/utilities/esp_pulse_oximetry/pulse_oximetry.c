@@ -0,0 +1,345 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file pulse_oximetry.c
+ *
+ * ESP-IDF pulse oximetry (heart-rate and SpO2) library
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "pulse_oximetry.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <esp_check.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+ * pulse oximetry definitions
+*/
+#define PULSE_OXIMETRY_PI                   (3.14159265359f)
+#define PULSE_OXIMETRY_BUTTERWORTH_Q        (0.70710678118f)
+#define PULSE_OXIMETRY_DC_BAND_RATIO        (0.25f)     //!< DC tracking cut-off frequency as a ratio of the band-pass lower cut-off frequency
+#define PULSE_OXIMETRY_ENVELOPE_TIME        (1.0f)      //!< pulse envelope decay time constant in seconds
+#define PULSE_OXIMETRY_SETTLE_TIME          (2.0f)      //!< filter settling time in seconds before beats are detected
+#define PULSE_OXIMETRY_AVERAGE_WEIGHT       (0.25f)     //!< weight of a new beat in the heart-rate and SpO2 averages
+#define PULSE_OXIMETRY_INTERVAL_RATIO       (0.5f)      //!< minimum beat interval as a ratio of the averaged beat interval, rejects dicrotic notch peaks
+
+/*
+* static constant declerations
+*/
+static const char *TAG = "pulse_oximetry";
+
+
+/**
+ * @brief Designs a second-order Butterworth high-pass or low-pass filter section.
+ * 
+ * @param biquad Filter section.
+ * @param fc Cut-off frequency in hz.
+ * @param fs Sample rate in hz.
+ * @param high_pass High-pass filter when true, otherwise low-pass filter.
+ */
+static inline void pulse_oximetry_design_butterworth(pulse_oximetry_biquad_t *const biquad, const float fc, const float fs, const bool high_pass) {
+    const float w0    = 2.0f * PULSE_OXIMETRY_PI * fc / fs;
+    const float cw0   = cosf(w0);
+    const float alpha = sinf(w0) / (2.0f * PULSE_OXIMETRY_BUTTERWORTH_Q);
+    const float a0    = 1.0f + alpha;
+    const float k     = high_pass ? (1.0f + cw0) : (1.0f - cw0);
+
+    biquad->b0 = 0.5f * k / a0;
+    biquad->b1 = (high_pass ? -k : k) / a0;
+    biquad->b2 = 0.5f * k / a0;
+    biquad->a1 = -2.0f * cw0 / a0;
+    biquad->a2 = (1.0f - alpha) / a0;
+    biquad->z1 = 0.0f;
+    biquad->z2 = 0.0f;
+}
+
+/**
+ * @brief Filters a sample through a filter section (transposed direct form II).
+ * 
+ * @param biquad Filter section.
+ * @param x Input sample.
+ * @return float Filtered sample.
+ */
+static inline float pulse_oximetry_filter(pulse_oximetry_biquad_t *const biquad, const float x) {
+    const float y = biquad->b0 * x + biquad->z1;
+
+    biquad->z1 = biquad->b1 * x - biquad->a1 * y + biquad->z2;
+    biquad->z2 = biquad->b2 * x - biquad->a2 * y;
+
+    return y;
+}
+
+/**
+ * @brief Restarts a channel from a sample, the DC level starts at the sample to shorten settling.
+ * 
+ * @param channel Channel state.
+ * @param x Sample.
+ */
+static inline void pulse_oximetry_restart_channel(pulse_oximetry_channel_t *const channel, const float x) {
+    channel->dc = x;
+    for (uint8_t i = 0; i < PULSE_OXIMETRY_BAND_SECTIONS; i++) {
+        channel->band[i].z1 = 0.0f;
+        channel->band[i].z2 = 0.0f;
+    }
+    channel->max     = 0.0f;
+    channel->min     = 0.0f;
+}
+
+/**
+ * @brief Removes the DC level of a channel sample, band-pass filters the AC component and tracks 
+ * its range since the last beat.
+ * 
+ * @param handle Pulse oximetry handle.
+ * @param channel Channel state.
+ * @param x Sample.
+ * @return float Filtered AC component.
+ */
+static inline float pulse_oximetry_process_channel(pulse_oximetry_handle_t handle, pulse_oximetry_channel_t *const channel, const float x) {
+    channel->dc += handle->dc_alpha * (x - channel->dc);
+
+    float ac = x - channel->dc;
+    for (uint8_t i = 0; i < PULSE_OXIMETRY_BAND_SECTIONS; i++) {
+        ac = pulse_oximetry_filter(&channel->band[i], ac);
+    }
+
+    if (ac > channel->max) channel->max = ac;
+    if (ac < channel->min) channel->min = ac;
+
+    return ac;
+}
+
+/**
+ * @brief Records a peak and restarts the channel ranges for the next beat.
+ * 
+ * @param handle Pulse oximetry handle.
+ * @param index Sample index of the peak.
+ * @param offset Fractional sample offset of the peak.
+ */
+static inline void pulse_oximetry_record_peak(pulse_oximetry_handle_t handle, const uint32_t index, const float offset) {
+    handle->peak_valid       = true;
+    handle->last_peak_index  = index;
+    handle->last_peak_offset = offset;
+    handle->red.max = handle->red.min = 0.0f;
+    handle->ir.max  = handle->ir.min  = 0.0f;
+}
+
+/**
+ * @brief Computes the beat result from the beat interval and the channel ranges since the last beat.
+ * 
+ * @param handle Pulse oximetry handle.
+ * @param index Sample index of the peak.
+ * @param interval Beat interval in seconds.
+ * @param beat Beat result.
+ */
+static inline void pulse_oximetry_compute_beat(pulse_oximetry_handle_t handle, const uint32_t index, const float interval, pulse_oximetry_beat_t *const beat) {
+    const float ac_red = handle->red.max - handle->red.min;
+    const float ac_ir  = handle->ir.max - handle->ir.min;
+    const float heart_rate = 60.0f / interval;
+    float ratio = 0.0f;
+    float spo2  = 0.0f;
+
+    /* ratio of ratios, the filter gain cancels as both channels are filtered alike */
+    if (ac_ir > 0.0f && handle->red.dc > 0.0f && handle->ir.dc > 0.0f) {
+        ratio = (ac_red / handle->red.dc) / (ac_ir / handle->ir.dc);
+        spo2  = handle->config.spo2_coefficient_a * ratio * ratio + handle->config.spo2_coefficient_b * ratio + handle->config.spo2_coefficient_c;
+        spo2  = fminf(fmaxf(spo2, 0.0f), 100.0f);
+    }
+
+    if (handle->heart_rate_average == 0.0f) {
+        handle->heart_rate_average = heart_rate;
+        handle->spo2_average       = spo2;
+    } else {
+        handle->heart_rate_average += PULSE_OXIMETRY_AVERAGE_WEIGHT * (heart_rate - handle->heart_rate_average);
+        handle->spo2_average       += PULSE_OXIMETRY_AVERAGE_WEIGHT * (spo2 - handle->spo2_average);
+    }
+
+    beat->sample_index       = index;
+    beat->interval           = interval;
+    beat->heart_rate         = heart_rate;
+    beat->heart_rate_average = handle->heart_rate_average;
+    beat->ratio              = ratio;
+    beat->spo2               = spo2;
+    beat->spo2_average       = handle->spo2_average;
+    beat->perfusion_index    = (handle->ir.dc > 0.0f) ? 100.0f * ac_ir / handle->ir.dc : 0.0f;
+}
+
+esp_err_t pulse_oximetry_init(const pulse_oximetry_config_t *const config, pulse_oximetry_handle_t *pulse_oximetry_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( config && pulse_oximetry_handle );
+    ESP_RETURN_ON_FALSE( config->sample_rate > 0.0f && config->band_low_frequency > 0.0f &&
+                         config->band_high_frequency > config->band_low_frequency &&
+                         config->band_high_frequency < 0.5f * config->sample_rate, ESP_ERR_INVALID_ARG, TAG, "invalid band-pass frequencies, init failed");
+    ESP_RETURN_ON_FALSE( config->min_heart_rate > 0.0f && config->max_heart_rate > config->min_heart_rate, ESP_ERR_INVALID_ARG, TAG, "invalid heart-rate range, init failed");
+    ESP_RETURN_ON_FALSE( config->threshold_ratio > 0.0f && config->threshold_ratio < 1.0f, ESP_ERR_INVALID_ARG, TAG, "invalid threshold ratio, init failed");
+
+    /* validate memory availability for handle */
+    pulse_oximetry_handle_t out_handle = (pulse_oximetry_handle_t)calloc(1, sizeof(pulse_oximetry_t));
+    ESP_RETURN_ON_FALSE(out_handle, ESP_ERR_NO_MEM, TAG, "no memory for pulse oximetry handle, init failed");
+
+    /* copy configuration and derive filter coefficients */
+    out_handle->config         = *config;
+    out_handle->dc_alpha       = 1.0f - expf(-2.0f * PULSE_OXIMETRY_PI * PULSE_OXIMETRY_DC_BAND_RATIO * config->band_low_frequency / config->sample_rate);
+    out_handle->envelope_decay = expf(-1.0f / (PULSE_OXIMETRY_ENVELOPE_TIME * config->sample_rate));
+    out_handle->refractory     = (uint32_t)(60.0f * config->sample_rate / config->max_heart_rate);
+    out_handle->max_interval   = (uint32_t)(60.0f * config->sample_rate / config->min_heart_rate);
+    out_handle->settle_samples = (uint32_t)(PULSE_OXIMETRY_SETTLE_TIME * config->sample_rate);
+
+    /* band-pass filter is a high-pass and low-pass butterworth section cascade */
+    pulse_oximetry_design_butterworth(&out_handle->red.band[0], config->band_low_frequency, config->sample_rate, true);
+    pulse_oximetry_design_butterworth(&out_handle->red.band[1], config->band_high_frequency, config->sample_rate, false);
+    memcpy(out_handle->ir.band, out_handle->red.band, sizeof(out_handle->ir.band));
+
+    /* set handle */
+    *pulse_oximetry_handle = out_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t pulse_oximetry_update(pulse_oximetry_handle_t pulse_oximetry_handle, const uint32_t red, const uint32_t ir, pulse_oximetry_beat_t *const beat, bool *const beat_detected) {
+    /* validate arguments */
+    ESP_ARG_CHECK( pulse_oximetry_handle && beat && beat_detected );
+
+    pulse_oximetry_handle_t handle = pulse_oximetry_handle;
+    const uint32_t index = handle->sample_index++;
+
+    *beat_detected = false;
+
+    /* no finger, detection restarts when the infrared level returns */
+    if (ir < handle->config.presence_threshold) {
+        handle->primed = false;
+        return ESP_OK;
+    }
+
+    if (handle->primed == false) {
+        pulse_oximetry_restart_channel(&handle->red, (float)red);
+        pulse_oximetry_restart_channel(&handle->ir, (float)ir);
+        handle->settle_index = index + handle->settle_samples;
+        handle->envelope     = 0.0f;
+        handle->pulse[0]     = 0.0f;
+        handle->pulse[1]     = 0.0f;
+        handle->peak_valid   = false;
+        handle->primed       = true;
+    }
+
+    pulse_oximetry_process_channel(handle, &handle->red, (float)red);
+
+    /* absorption, and the pulse, peaks when the infrared count is lowest */
+    const float pulse = -pulse_oximetry_process_channel(handle, &handle->ir, (float)ir);
+    const float y0 = handle->pulse[0];
+    const float y1 = handle->pulse[1];
+
+    handle->envelope = fmaxf(handle->envelope * handle->envelope_decay, pulse);
+
+    /* local maximum at the previous sample above the adaptive threshold */
+    if (index >= handle->settle_index && y1 > 0.0f && y1 > y0 && y1 >= pulse && y1 > handle->config.threshold_ratio * handle->envelope) {
+        const uint32_t peak_index = index - 1;
+        const float    curvature  = y0 - 2.0f * y1 + pulse;
+        const float    offset     = (curvature < 0.0f) ? 0.5f * (y0 - pulse) / curvature : 0.0f;
+
+        if (handle->peak_valid == false) {
+            pulse_oximetry_record_peak(handle, peak_index, offset);
+        } else {
+            const uint32_t samples = peak_index - handle->last_peak_index;
+
+            if (samples > handle->max_interval) {
+                /* beat was missed, the peak starts a new interval */
+                pulse_oximetry_record_peak(handle, peak_index, offset);
+            } else if (samples >= handle->refractory && (handle->heart_rate_average == 0.0f ||
+                       (float)samples >= PULSE_OXIMETRY_INTERVAL_RATIO * 60.0f * handle->config.sample_rate / handle->heart_rate_average)) {
+                const float interval = ((float)samples + offset - handle->last_peak_offset) / handle->config.sample_rate;
+
+                pulse_oximetry_compute_beat(handle, peak_index, interval, beat);
+                pulse_oximetry_record_peak(handle, peak_index, offset);
+                *beat_detected = true;
+            }
+        }
+    }
+
+    handle->pulse[0] = y1;
+    handle->pulse[1] = pulse;
+
+    return ESP_OK;
+}
+
+esp_err_t pulse_oximetry_update_samples(pulse_oximetry_handle_t pulse_oximetry_handle, const uint32_t *const red, const uint32_t *const ir, const uint16_t count, pulse_oximetry_beat_t *const beats, const uint16_t max_beats, uint16_t *const beat_count) {
+    pulse_oximetry_beat_t beat;
+    bool                  beat_detected;
+    uint16_t              dropped = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( pulse_oximetry_handle && red && ir && beat_count && (beats || max_beats == 0) );
+
+    *beat_count = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_ERROR( pulse_oximetry_update(pulse_oximetry_handle, red[i], ir[i], &beat, &beat_detected), TAG, "unable to update sample, update samples failed" );
+
+        if (!beat_detected) continue;
+
+        if (*beat_count < max_beats) {
+            beats[(*beat_count)++] = beat;
+        } else {
+            dropped++;
+        }
+    }
+
+    /* all samples are processed, the beats past max beats are not returned */
+    if (dropped > 0) {
+        ESP_LOGW(TAG, "%u beat results dropped, max beats of %u exceeded", (unsigned)dropped, (unsigned)max_beats);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t pulse_oximetry_reset(pulse_oximetry_handle_t pulse_oximetry_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( pulse_oximetry_handle );
+
+    pulse_oximetry_handle->sample_index       = 0;
+    pulse_oximetry_handle->primed             = false;
+    pulse_oximetry_handle->peak_valid         = false;
+    pulse_oximetry_handle->heart_rate_average = 0.0f;
+    pulse_oximetry_handle->spo2_average       = 0.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t pulse_oximetry_delete(pulse_oximetry_handle_t pulse_oximetry_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( pulse_oximetry_handle );
+
+    free(pulse_oximetry_handle);
+
+    return ESP_OK;
+}
@@ -0,0 +1,215 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file pulse_oximetry.h
+ * @defgroup math pulse_oximetry
+ * @{
+ *
+ * ESP-IDF pulse oximetry (heart-rate and SpO2) library
+ * 
+ * Streaming photoplethysmogram (PPG) processing of red and infrared optical 
+ * counts (i.e. MAX30105 FIFO samples).  Each sample is processed in constant 
+ * time with fixed memory: DC removal, band-pass IIR filter, peak detection 
+ * with an adaptive threshold and an R-ratio based SpO2 estimate.  One result 
+ * is produced per detected beat.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __PULSE_OXIMETRY_H__
+#define __PULSE_OXIMETRY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PULSE_OXIMETRY_BAND_SECTIONS    (2)     //!< band-pass filter sections, a high-pass and a low-pass section
+
+/**
+ * @brief Pulse oximetry default configuration, the sample rate is the FIFO 
+ * output rate (sample rate divided by sample averaging).  The SpO2 calibration 
+ * is the empirical quadratic of the Maxim reference design, SpO2 = a * R^2 + b * R + c.
+ */
+#define PULSE_OXIMETRY_CONFIG_DEFAULT {         \
+    .sample_rate            = 100.0f,           \
+    .band_low_frequency     = 0.5f,             \
+    .band_high_frequency    = 4.0f,             \
+    .min_heart_rate         = 30.0f,            \
+    .max_heart_rate         = 220.0f,           \
+    .threshold_ratio        = 0.5f,             \
+    .presence_threshold     = 50000,            \
+    .spo2_coefficient_a     = -45.060f,         \
+    .spo2_coefficient_b     = 30.354f,          \
+    .spo2_coefficient_c     = 94.845f }
+
+/**
+ * @brief Pulse oximetry configuration structure.
+ */
+typedef struct pulse_oximetry_config_s {
+    float    sample_rate;           /*!< sample rate of the red and infrared counts in hz */
+    float    band_low_frequency;    /*!< band-pass filter lower cut-off frequency in hz */
+    float    band_high_frequency;   /*!< band-pass filter upper cut-off frequency in hz */
+    float    min_heart_rate;        /*!< minimum heart-rate in beats per minute, longer beat intervals restart detection */
+    float    max_heart_rate;        /*!< maximum heart-rate in beats per minute, sets the peak detection refractory period */
+    float    threshold_ratio;       /*!< peak detection threshold as a ratio (0 to 1) of the decaying pulse envelope */
+    uint32_t presence_threshold;    /*!< minimum infrared DC count, detection is suspended below the threshold (no finger) */
+    float    spo2_coefficient_a;    /*!< SpO2 calibration coefficient of R^2 */
+    float    spo2_coefficient_b;    /*!< SpO2 calibration coefficient of R */
+    float    spo2_coefficient_c;    /*!< SpO2 calibration constant */
+} pulse_oximetry_config_t;
+
+/**
+ * @brief Pulse oximetry beat result structure.
+ */
+typedef struct pulse_oximetry_beat_s {
+    uint32_t sample_index;          /*!< sample index of the beat peak since initialization or reset */
+    float    interval;              /*!< beat-to-beat interval in seconds */
+    float    heart_rate;            /*!< beat-to-beat heart-rate in beats per minute */
+    float    heart_rate_average;    /*!< averaged heart-rate in beats per minute */
+    float    ratio;                 /*!< red to infrared ratio of ratios (AC/DC) of the beat */
+    float    spo2;                  /*!< beat SpO2 estimate in percent */
+    float    spo2_average;          /*!< averaged SpO2 estimate in percent */
+    float    perfusion_index;       /*!< infrared perfusion index (AC/DC) in percent */
+} pulse_oximetry_beat_t;
+
+/**
+ * @brief Pulse oximetry second-order IIR filter section structure.
+ */
+typedef struct pulse_oximetry_biquad_s {
+    float b0, b1, b2;   // Feed-forward coefficients
+    float a1, a2;       // Feed-back coefficients, a0 normalized to 1
+    float z1, z2;       // Transposed direct form II state
+} pulse_oximetry_biquad_t;
+
+/**
+ * @brief Pulse oximetry channel (red or infrared) state structure.
+ */
+typedef struct pulse_oximetry_channel_s {
+    float                   dc;     // DC level tracked by a one-pole low-pass filter
+    pulse_oximetry_biquad_t band[PULSE_OXIMETRY_BAND_SECTIONS]; // Band-pass filter sections of the AC component
+    float                   max;    // Maximum of the filtered AC component since the last beat
+    float                   min;    // Minimum of the filtered AC component since the last beat
+} pulse_oximetry_channel_t;
+
+/**
+ * @brief Pulse oximetry state structure.
+ */
+struct pulse_oximetry_t {
+    pulse_oximetry_config_t  config;            // Configuration
+    float                    dc_alpha;          // DC tracking filter coefficient
+    float                    envelope_decay;    // Pulse envelope decay per sample
+    uint32_t                 refractory;        // Minimum samples between beats
+    uint32_t                 max_interval;      // Maximum samples between beats
+    pulse_oximetry_channel_t red;               // Red channel state
+    pulse_oximetry_channel_t ir;                // Infrared channel state
+    uint32_t                 settle_samples;    // Samples for the filters to settle after a (re)start
+    uint32_t                 sample_index;      // Samples processed
+    uint32_t                 settle_index;      // Sample index when the filters are settled
+    bool                     primed;            // Filters are initialized from the first sample
+    float                    envelope;          // Decaying pulse envelope
+    float                    pulse[2];          // Previous two pulse samples
+    bool                     peak_valid;        // Last peak is valid
+    uint32_t                 last_peak_index;   // Sample index of the last peak
+    float                    last_peak_offset;  // Fractional sample offset of the last peak
+    float                    heart_rate_average;// Averaged heart-rate, 0 until the first beat
+    float                    spo2_average;      // Averaged SpO2, 0 until the first beat
+};
+
+/**
+ * @brief Pulse oximetry definition.
+ */
+typedef struct pulse_oximetry_t pulse_oximetry_t;
+
+/**
+ * @brief Pulse oximetry handle definition.
+ */
+typedef struct pulse_oximetry_t *pulse_oximetry_handle_t;
+
+/**
+ * @brief Initializes a pulse oximetry handle instance.  The handle is allocated once, 
+ * updates are allocation free.
+ * 
+ * @param[in] config Pulse oximetry configuration.
+ * @param[out] pulse_oximetry_handle Pulse oximetry handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t pulse_oximetry_init(const pulse_oximetry_config_t *const config, pulse_oximetry_handle_t *pulse_oximetry_handle);
+
+/**
+ * @brief Processes a red and infrared sample pair.
+ * 
+ * @param[in] pulse_oximetry_handle Pulse oximetry handle.
+ * @param[in] red Red LED optical count.
+ * @param[in] ir Infrared LED optical count.
+ * @param[out] beat Beat result, updated when a beat is detected.
+ * @param[out] beat_detected True when a beat was detected and the beat result is updated.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t pulse_oximetry_update(pulse_oximetry_handle_t pulse_oximetry_handle, const uint32_t red, const uint32_t ir, pulse_oximetry_beat_t *const beat, bool *const beat_detected);
+
+/**
+ * @brief Processes a batch of red and infrared sample pairs (i.e. a MAX30105 FIFO read).
+ * 
+ * @param[in] pulse_oximetry_handle Pulse oximetry handle.
+ * @param[in] red Red LED optical counts.
+ * @param[in] ir Infrared LED optical counts.
+ * @param[in] count Number of sample pairs.
+ * @param[out] beats Beat results, one per detected beat.
+ * @param[in] max_beats Maximum number of beat results, further beats are processed but not returned.
+ * @param[out] beat_count Number of beat results.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE when all samples were processed but more 
+ * than `max_beats` beats were detected and the beats past `max_beats` were dropped.
+ */
+esp_err_t pulse_oximetry_update_samples(pulse_oximetry_handle_t pulse_oximetry_handle, const uint32_t *const red, const uint32_t *const ir, const uint16_t count, pulse_oximetry_beat_t *const beats, const uint16_t max_beats, uint16_t *const beat_count);
+
+/**
+ * @brief Resets the filters, peak detection and averages.
+ * 
+ * @param[in] pulse_oximetry_handle Pulse oximetry handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t pulse_oximetry_reset(pulse_oximetry_handle_t pulse_oximetry_handle);
+
+/**
+ * @brief Frees pulse oximetry handle.
+ * 
+ * @param[in] pulse_oximetry_handle Pulse oximetry handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t pulse_oximetry_delete(pulse_oximetry_handle_t pulse_oximetry_handle);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __PULSE_OXIMETRY_H__
@@ -37,6 +37,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <esp_mac.h>
 #include "type_utils_version.h"
 
@@ -95,6 +96,19 @@ typedef char bin64_char_buffer_t[BIN64_CHAR_BUFFER_SIZE];       // 65 char sized
  * type utilities enumerator and structure declarations
 */
 
+/**
+ * @brief Packed register field widths enumerator definition for bulk decoders.  16-bit 
+ * and 32-bit fields occupy 2 and 4 bytes.  20-bit and 24-bit fields occupy 3 bytes, 20-bit 
+ * fields are the upper 20-bits of the 24-bit word (i.e. msb, lsb, xlsb[7:4] as used by 
+ * Bosch sensors) in either byte order.
+ */
+typedef enum type_utils_field_widths_e {
+    TYPE_UTILS_FIELD_WIDTH_16BIT = 16,  /*!< 16-bit field, 2 bytes */
+    TYPE_UTILS_FIELD_WIDTH_20BIT = 20,  /*!< 20-bit field, 3 bytes (left justified) */
+    TYPE_UTILS_FIELD_WIDTH_24BIT = 24,  /*!< 24-bit field, 3 bytes */
+    TYPE_UTILS_FIELD_WIDTH_32BIT = 32   /*!< 32-bit field, 4 bytes */
+} type_utils_field_widths_t;
+
 /* 4-byte conversion to float IEEE754 (little endian) */
 typedef union {
     bit32_uint8_buffer_t bytes;
@@ -177,7 +191,7 @@ uint64_t get_efuse_mac(void);
  * @brief Converts `uint8_t` type to binary as a string.
  * 
  * @param value `uint8_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* uint8_to_binary(const uint8_t value);
 
@@ -185,7 +199,7 @@ const char* uint8_to_binary(const uint8_t value);
  * @brief Converts `int8_t` type to binary as a string.
  * 
  * @param value `int8_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* int8_to_binary(const int8_t value);
 
@@ -193,7 +207,7 @@ const char* int8_to_binary(const int8_t value);
  * @brief Converts `uint16_t` type to binary as a string.
  * 
  * @param value `uint16_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* uint16_to_binary(const uint16_t value);
 
@@ -201,7 +215,7 @@ const char* uint16_to_binary(const uint16_t value);
  * @brief Converts `int16_t` type to binary as a string.
  * 
  * @param value `int16_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* int16_to_binary(const int16_t value);
 
@@ -209,7 +223,7 @@ const char* int16_to_binary(const int16_t value);
  * @brief Converts `uint32_t` type to binary as a string.
  * 
  * @param value `uint32_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* uint32_to_binary(const uint32_t value);
 
@@ -217,7 +231,7 @@ const char* uint32_to_binary(const uint32_t value);
  * @brief Converts `int32_t` type to binary as a string.
  * 
  * @param value `int32_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* int32_to_binary(const int32_t value);
 
@@ -225,7 +239,7 @@ const char* int32_to_binary(const int32_t value);
  * @brief Converts `uint64_t` type to binary as a string.
  * 
  * @param value `uint64_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* uint64_to_binary(const uint64_t value);
 
@@ -233,10 +247,82 @@ const char* uint64_to_binary(const uint64_t value);
  * @brief Converts `int64_t` type to binary as a string.
  * 
  * @param value `int64_t` to transform to binary string.
- * @return char* binary string representation.
+ * @return const char* binary string representation.
  */
 const char* int64_to_binary(const int64_t value);
 
+/**
+ * @brief Converts `uint8_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `uint8_t` to transform to binary string.
+ * @param buffer Caller supplied `bin8_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* uint8_to_binary_r(const uint8_t value, bin8_char_buffer_t buffer);
+
+/**
+ * @brief Converts `int8_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `int8_t` to transform to binary string.
+ * @param buffer Caller supplied `bin8_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* int8_to_binary_r(const int8_t value, bin8_char_buffer_t buffer);
+
+/**
+ * @brief Converts `uint16_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `uint16_t` to transform to binary string.
+ * @param buffer Caller supplied `bin16_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* uint16_to_binary_r(const uint16_t value, bin16_char_buffer_t buffer);
+
+/**
+ * @brief Converts `int16_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `int16_t` to transform to binary string.
+ * @param buffer Caller supplied `bin16_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* int16_to_binary_r(const int16_t value, bin16_char_buffer_t buffer);
+
+/**
+ * @brief Converts `uint32_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `uint32_t` to transform to binary string.
+ * @param buffer Caller supplied `bin32_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* uint32_to_binary_r(const uint32_t value, bin32_char_buffer_t buffer);
+
+/**
+ * @brief Converts `int32_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `int32_t` to transform to binary string.
+ * @param buffer Caller supplied `bin32_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* int32_to_binary_r(const int32_t value, bin32_char_buffer_t buffer);
+
+/**
+ * @brief Converts `uint64_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `uint64_t` to transform to binary string.
+ * @param buffer Caller supplied `bin64_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* uint64_to_binary_r(const uint64_t value, bin64_char_buffer_t buffer);
+
+/**
+ * @brief Converts `int64_t` type to binary as a string into a caller supplied buffer (reentrant).
+ * 
+ * @param value `int64_t` to transform to binary string.
+ * @param buffer Caller supplied `bin64_char_buffer_t` buffer that receives the binary string.
+ * @return const char* binary string representation (i.e. buffer).
+ */
+const char* int64_to_binary_r(const int64_t value, bin64_char_buffer_t buffer);
+
 /**
  * @brief Converts byte array to `uint16_t` data-type.
  * 
@@ -372,10 +458,56 @@ void double_to_bytes(const double value, uint8_t* bytes, const bool little_endia
  */
 void copy_bytes(const uint8_t* source, uint8_t* destination, const size_t size);
 
+/**
+ * @brief Gets the size in bytes of a packed register field.
+ * 
+ * @param width Packed register field width.
+ * @return size_t Size of the packed register field in bytes, 0 when the width is not supported.
+ */
+size_t type_utils_field_size(const type_utils_field_widths_t width);
+
+/**
+ * @brief Decodes an array of packed unsigned register fields (i.e. from an i2c burst or 
+ * fifo read) to `uint32_t` data-types.
+ * 
+ * @param bytes Byte array of packed register fields, `count` * `type_utils_field_size(width)` bytes.
+ * @param values Decoded `uint32_t` data-type array, `count` values.
+ * @param count Number of fields to decode.
+ * @param width Packed register field width.
+ * @param little_endian Little endian byte order when true, otherwise, big endian byte order when false.
+ */
+void bytes_to_uint32_array(const uint8_t* bytes, uint32_t* values, const size_t count, const type_utils_field_widths_t width, const bool little_endian);
+
+/**
+ * @brief Decodes an array of packed two's complement register fields (i.e. from an i2c 
+ * burst or fifo read) to sign extended `int32_t` data-types.
+ * 
+ * @param bytes Byte array of packed register fields, `count` * `type_utils_field_size(width)` bytes.
+ * @param values Decoded `int32_t` data-type array, `count` values.
+ * @param count Number of fields to decode.
+ * @param width Packed register field width.
+ * @param little_endian Little endian byte order when true, otherwise, big endian byte order when false.
+ */
+void bytes_to_int32_array(const uint8_t* bytes, int32_t* values, const size_t count, const type_utils_field_widths_t width, const bool little_endian);
+
+/**
+ * @brief Decodes an array of packed register fields (i.e. from an i2c burst or fifo read) 
+ * to scaled `float` data-types (i.e. raw counts multiplied by a sensitivity).
+ * 
+ * @param bytes Byte array of packed register fields, `count` * `type_utils_field_size(width)` bytes.
+ * @param values Decoded and scaled `float` data-type array, `count` values.
+ * @param count Number of fields to decode.
+ * @param width Packed register field width.
+ * @param is_signed Fields are two's complement when true, otherwise, unsigned when false.
+ * @param little_endian Little endian byte order when true, otherwise, big endian byte order when false.
+ * @param scale Scale factor applied to every decoded field.
+ */
+void bytes_to_float_array(const uint8_t* bytes, float* values, const size_t count, const type_utils_field_widths_t width, const bool is_signed, const bool little_endian, const float scale);
+
 /**
  * @brief Converts `type_utils` firmware version numbers (major, minor, patch) into a string.
  * 
- * @return char* `type_utils` firmware version as a string that is formatted as X.X.X (e.g. 4.0.0).
+ * @return const char* `type_utils` firmware version as a string that is formatted as X.X.X (e.g. 4.0.0).
  */
 const char* type_utils_get_fw_version(void);
 
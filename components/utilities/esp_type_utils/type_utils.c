@@ -81,8 +81,7 @@ uint64_t get_efuse_mac(void) {
     return chipmacid;
 }
 
-const char* uint8_to_binary(const uint8_t value) {
-    static bin8_char_buffer_t buffer;
+const char* uint8_to_binary_r(const uint8_t value, bin8_char_buffer_t buffer) {
     buffer[8] = '\0';
     uint8_t n = value;
 
@@ -94,8 +93,12 @@ const char* uint8_to_binary(const uint8_t value) {
     return buffer;
 }
 
-const char* int8_to_binary(const int8_t value) {
+const char* uint8_to_binary(const uint8_t value) {
     static bin8_char_buffer_t buffer;
+    return uint8_to_binary_r(value, buffer);
+}
+
+const char* int8_to_binary_r(const int8_t value, bin8_char_buffer_t buffer) {
     buffer[8] = '\0';
     int8_t n = value;
 
@@ -107,8 +110,12 @@ const char* int8_to_binary(const int8_t value) {
     return buffer;
 }
 
-const char* uint16_to_binary(const uint16_t value) {
-    static bin16_char_buffer_t buffer;
+const char* int8_to_binary(const int8_t value) {
+    static bin8_char_buffer_t buffer;
+    return int8_to_binary_r(value, buffer);
+}
+
+const char* uint16_to_binary_r(const uint16_t value, bin16_char_buffer_t buffer) {
     buffer[16] = '\0';
     uint16_t n = value;
 
@@ -120,8 +127,12 @@ const char* uint16_to_binary(const uint16_t value) {
     return buffer;
 }
 
-const char* int16_to_binary(const int16_t value) {
+const char* uint16_to_binary(const uint16_t value) {
     static bin16_char_buffer_t buffer;
+    return uint16_to_binary_r(value, buffer);
+}
+
+const char* int16_to_binary_r(const int16_t value, bin16_char_buffer_t buffer) {
     buffer[16] = '\0';
     int16_t n = value;
 
@@ -133,8 +144,12 @@ const char* int16_to_binary(const int16_t value) {
     return buffer;
 }
 
-const char* uint32_to_binary(const uint32_t value) {
-    static bin32_char_buffer_t buffer;
+const char* int16_to_binary(const int16_t value) {
+    static bin16_char_buffer_t buffer;
+    return int16_to_binary_r(value, buffer);
+}
+
+const char* uint32_to_binary_r(const uint32_t value, bin32_char_buffer_t buffer) {
     buffer[32] = '\0';
     uint32_t n = value;
 
@@ -146,8 +161,12 @@ const char* uint32_to_binary(const uint32_t value) {
     return buffer;
 }
 
-const char* int32_to_binary(const int32_t value) {
+const char* uint32_to_binary(const uint32_t value) {
     static bin32_char_buffer_t buffer;
+    return uint32_to_binary_r(value, buffer);
+}
+
+const char* int32_to_binary_r(const int32_t value, bin32_char_buffer_t buffer) {
     buffer[32] = '\0';
     int32_t n = value;
 
@@ -159,8 +178,12 @@ const char* int32_to_binary(const int32_t value) {
     return buffer;
 }
 
-const char* uint64_to_binary(const uint64_t value) {
-    static bin64_char_buffer_t buffer;
+const char* int32_to_binary(const int32_t value) {
+    static bin32_char_buffer_t buffer;
+    return int32_to_binary_r(value, buffer);
+}
+
+const char* uint64_to_binary_r(const uint64_t value, bin64_char_buffer_t buffer) {
     buffer[64] = '\0';
     uint64_t n = value;
 
@@ -172,8 +195,12 @@ const char* uint64_to_binary(const uint64_t value) {
     return buffer;
 }
 
-const char* int64_to_binary(const int64_t value) {
+const char* uint64_to_binary(const uint64_t value) {
     static bin64_char_buffer_t buffer;
+    return uint64_to_binary_r(value, buffer);
+}
+
+const char* int64_to_binary_r(const int64_t value, bin64_char_buffer_t buffer) {
     buffer[64] = '\0';
     int64_t n = value;
 
@@ -185,6 +212,11 @@ const char* int64_to_binary(const int64_t value) {
     return buffer;
 }
 
+const char* int64_to_binary(const int64_t value) {
+    static bin64_char_buffer_t buffer;
+    return int64_to_binary_r(value, buffer);
+}
+
 uint16_t bytes_to_uint16(const uint8_t* bytes, const bool little_endian) {
     if(little_endian == true) {
         return  (uint16_t)(bytes[0] | 
@@ -390,6 +422,132 @@ void copy_bytes(const uint8_t* source, uint8_t* destination, const size_t size)
     memcpy(destination, source, size);
 }
 
+size_t type_utils_field_size(const type_utils_field_widths_t width) {
+    switch(width) {
+        case TYPE_UTILS_FIELD_WIDTH_16BIT:
+            return BIT16_UINT8_BUFFER_SIZE;
+        case TYPE_UTILS_FIELD_WIDTH_20BIT:
+        case TYPE_UTILS_FIELD_WIDTH_24BIT:
+            return BIT24_UINT8_BUFFER_SIZE;
+        case TYPE_UTILS_FIELD_WIDTH_32BIT:
+            return BIT32_UINT8_BUFFER_SIZE;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * field decoder loop, `SHIFT` is a compile-time constant so that the sign extension 
+ * (arithmetic shift pair) folds into the loop body, 0 decodes unsigned fields.
+*/
+#define TYPE_UTILS_DECODE_LOOP(STRIDE, WORD, SHIFT) \
+    for(size_t i = 0; i < count; i++, src += (STRIDE)) { values[i] = (uint32_t)((int32_t)((uint32_t)(WORD) << (SHIFT)) >> (SHIFT)); }
+
+#define TYPE_UTILS_DECODE_FIELDS(STRIDE, WORD, WIDTH) \
+    if(is_signed == true) { TYPE_UTILS_DECODE_LOOP(STRIDE, WORD, 32 - (WIDTH)) } else { TYPE_UTILS_DECODE_LOOP(STRIDE, WORD, 0) }
+
+/*
+ * float field decoder loop, the sign extended field is converted and scaled in the same 
+ * pass so that the `float` array is only ever written as `float`.
+*/
+#define TYPE_UTILS_DECODE_FLOAT_LOOP(STRIDE, WORD, SHIFT) \
+    for(size_t i = 0; i < count; i++, src += (STRIDE)) { values[i] = (float)((int32_t)((uint32_t)(WORD) << (SHIFT)) >> (SHIFT)) * scale; }
+
+#define TYPE_UTILS_DECODE_FLOAT_FIELDS(STRIDE, WORD, WIDTH) \
+    if(is_signed == true) { TYPE_UTILS_DECODE_FLOAT_LOOP(STRIDE, WORD, 32 - (WIDTH)) } else { TYPE_UTILS_DECODE_FLOAT_LOOP(STRIDE, WORD, 0) }
+
+#define TYPE_UTILS_BE16(P)  (((uint32_t)(P)[0] << 8) | (uint32_t)(P)[1])
+#define TYPE_UTILS_LE16(P)  ((uint32_t)(P)[0] | ((uint32_t)(P)[1] << 8))
+#define TYPE_UTILS_BE24(P)  (((uint32_t)(P)[0] << 16) | ((uint32_t)(P)[1] << 8) | (uint32_t)(P)[2])
+#define TYPE_UTILS_LE24(P)  ((uint32_t)(P)[0] | ((uint32_t)(P)[1] << 8) | ((uint32_t)(P)[2] << 16))
+#define TYPE_UTILS_BE32(P)  (((uint32_t)(P)[0] << 24) | ((uint32_t)(P)[1] << 16) | ((uint32_t)(P)[2] << 8) | (uint32_t)(P)[3])
+#define TYPE_UTILS_LE32(P)  ((uint32_t)(P)[0] | ((uint32_t)(P)[1] << 8) | ((uint32_t)(P)[2] << 16) | ((uint32_t)(P)[3] << 24))
+
+/**
+ * @brief Decodes an array of packed register fields to 32-bit words, two's complement 
+ * fields are sign extended.  The width, byte order and signedness are resolved once per 
+ * call, the inner loops are branch-free.
+ * 
+ * @param bytes Byte array of packed register fields.
+ * @param values Decoded fields as 32-bit words.
+ * @param count Number of fields to decode.
+ * @param width Packed register field width.
+ * @param is_signed Fields are two's complement when true, otherwise, unsigned when false.
+ * @param little_endian Little endian byte order when true, otherwise, big endian byte order when false.
+ */
+static inline void type_utils_decode_fields(const uint8_t* restrict bytes, uint32_t* restrict values, const size_t count, const type_utils_field_widths_t width, const bool is_signed, const bool little_endian) {
+    const uint8_t* src = bytes;
+    switch(width) {
+        case TYPE_UTILS_FIELD_WIDTH_16BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FIELDS(2, TYPE_UTILS_LE16(src), 16) } else { TYPE_UTILS_DECODE_FIELDS(2, TYPE_UTILS_BE16(src), 16) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_20BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FIELDS(3, TYPE_UTILS_LE24(src) >> 4, 20) } else { TYPE_UTILS_DECODE_FIELDS(3, TYPE_UTILS_BE24(src) >> 4, 20) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_24BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FIELDS(3, TYPE_UTILS_LE24(src), 24) } else { TYPE_UTILS_DECODE_FIELDS(3, TYPE_UTILS_BE24(src), 24) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_32BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_LOOP(4, TYPE_UTILS_LE32(src), 0) } else { TYPE_UTILS_DECODE_LOOP(4, TYPE_UTILS_BE32(src), 0) }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Decodes an array of packed register fields to scaled `float` values, see 
+ * `type_utils_decode_fields`.  32-bit unsigned fields are converted from `uint32_t`.
+ * 
+ * @param bytes Byte array of packed register fields.
+ * @param values Decoded and scaled fields.
+ * @param count Number of fields to decode.
+ * @param width Packed register field width.
+ * @param is_signed Fields are two's complement when true, otherwise, unsigned when false.
+ * @param little_endian Little endian byte order when true, otherwise, big endian byte order when false.
+ * @param scale Scale factor applied to every decoded field.
+ */
+static inline void type_utils_decode_float_fields(const uint8_t* restrict bytes, float* restrict values, const size_t count, const type_utils_field_widths_t width, const bool is_signed, const bool little_endian, const float scale) {
+    const uint8_t* src = bytes;
+    switch(width) {
+        case TYPE_UTILS_FIELD_WIDTH_16BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FLOAT_FIELDS(2, TYPE_UTILS_LE16(src), 16) } else { TYPE_UTILS_DECODE_FLOAT_FIELDS(2, TYPE_UTILS_BE16(src), 16) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_20BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FLOAT_FIELDS(3, TYPE_UTILS_LE24(src) >> 4, 20) } else { TYPE_UTILS_DECODE_FLOAT_FIELDS(3, TYPE_UTILS_BE24(src) >> 4, 20) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_24BIT:
+            if(little_endian == true) { TYPE_UTILS_DECODE_FLOAT_FIELDS(3, TYPE_UTILS_LE24(src), 24) } else { TYPE_UTILS_DECODE_FLOAT_FIELDS(3, TYPE_UTILS_BE24(src), 24) }
+            break;
+        case TYPE_UTILS_FIELD_WIDTH_32BIT:
+            if(is_signed == true) {
+                if(little_endian == true) { TYPE_UTILS_DECODE_FLOAT_LOOP(4, TYPE_UTILS_LE32(src), 0) } else { TYPE_UTILS_DECODE_FLOAT_LOOP(4, TYPE_UTILS_BE32(src), 0) }
+            } else {
+                /* the whole word is the unsigned value, converting through int32_t would wrap it */
+                if(little_endian == true) {
+                    for(size_t i = 0; i < count; i++, src += 4) { values[i] = (float)TYPE_UTILS_LE32(src) * scale; }
+                } else {
+                    for(size_t i = 0; i < count; i++, src += 4) { values[i] = (float)TYPE_UTILS_BE32(src) * scale; }
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void bytes_to_uint32_array(const uint8_t* bytes, uint32_t* values, const size_t count, const type_utils_field_widths_t width, const bool little_endian) {
+    type_utils_decode_fields(bytes, values, count, width, false, little_endian);
+}
+
+void bytes_to_int32_array(const uint8_t* bytes, int32_t* values, const size_t count, const type_utils_field_widths_t width, const bool little_endian) {
+    type_utils_decode_fields(bytes, (uint32_t*)values, count, width, true, little_endian);
+}
+
+void bytes_to_float_array(const uint8_t* bytes, float* values, const size_t count, const type_utils_field_widths_t width, const bool is_signed, const bool little_endian, const float scale) {
+    type_utils_decode_float_fields(bytes, values, count, width, is_signed, little_endian, scale);
+}
+
 const char* type_utils_get_fw_version(void) {
     return (const char*)TYPE_UTILS_FW_VERSION_STR;
 }
@@ -37,20 +37,44 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "uuid_version.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief UUID string buffer size including the null terminator.
+ */
+#define UUID_STRING_SIZE    (37)
+
+/**
+ * @brief UUID binary buffer size in bytes.
+ */
+#define UUID_BINARY_SIZE    (16)
+
 /**
  * @brief UUID modes enumerator definition.
  */
 typedef enum uuid_modes_e {
     UUID_MODE_VARIANT4 = 0,  /*!< Variant-4 UUID */
     UUID_MODE_RANDOM   = 1,  /*!< Random UUID */
+    UUID_MODE_VERSION7 = 2,  /*!< Version-7 UUID, unix epoch millisecond timestamp ordered (RFC-9562) */
 } uuid_modes_t;
 
+/**
+ * @brief UUID generator state structure definition.  Each task owns its generator state, 
+ * generators are not shared between tasks and the reentrant functions do not lock.
+ */
+typedef struct uuid_generator_s {
+    uint32_t     m_w;           /*!< Marsaglia MWC state */
+    uint32_t     m_z;           /*!< Marsaglia MWC state */
+    uuid_modes_t mode;          /*!< UUID mode */
+    uint64_t     v7_last_ms;    /*!< last version-7 unix epoch timestamp in milliseconds */
+    uint16_t     v7_counter;    /*!< version-7 12-bit monotonic counter within the same millisecond */
+} uuid_generator_t;
+
 /**
  * @brief Initialize UUID generator with default seed values from hash algorithm.
  */
@@ -68,25 +92,86 @@ void uuid_seed(uint8_t size, ...);
 
 /**
  * @brief Generate a UUID (i.e. d29b226d-04b5-e3ae-cd63-e6ec0d5611ab).
+ * 
+ * @note The generator state is guarded, but the returned string is a shared static 
+ * buffer that is overwritten by the next call.  Use `uuid_generate_r` when more than 
+ * one task generates UUIDs.
  *
  * @return const char* Pointer to the UUID string.
  */
 const char* uuid_generate(void);
 
 /**
- * @brief Set the UUID mode to either variant-4 or random.
+ * @brief Set the UUID mode of the default generator, variant-4, random or version-7.
  *
  * @param mode The UUID mode to set.
  */
 void uuid_set_mode(const uuid_modes_t mode);
 
 /**
- * @brief Get the current UUID mode.
+ * @brief Get the UUID mode of the default generator.
  *
  * @return uuid_modes_t The current UUID mode.
  */
 uuid_modes_t uuid_get_mode(void);
 
+/**
+ * @brief Initialize a UUID generator state.  The generator is seeded from the hardware 
+ * random number generator (`esp_random`) or, when `hw_seed` is false, from the same 
+ * compile-time hash and timer seed as `uuid_init`.
+ *
+ * @param[out] generator UUID generator state.
+ * @param[in] mode UUID mode of the generator.
+ * @param[in] hw_seed Seed from the hardware random number generator when true.
+ */
+void uuid_generator_init(uuid_generator_t *const generator, const uuid_modes_t mode, const bool hw_seed);
+
+/**
+ * @brief Seed a UUID generator state, a seed of 0 is replaced by the default seed values (1 and 2).
+ *
+ * @param[in,out] generator UUID generator state.
+ * @param[in] seed1 First seed.
+ * @param[in] seed2 Second seed.
+ */
+void uuid_generator_seed(uuid_generator_t *const generator, const uint32_t seed1, const uint32_t seed2);
+
+/**
+ * @brief Generate a 16-byte binary UUID into a caller buffer (reentrant).
+ *
+ * @param[in,out] generator UUID generator state.
+ * @param[out] uuid UUID buffer of `UUID_BINARY_SIZE` bytes.
+ */
+void uuid_generate_binary_r(uuid_generator_t *const generator, uint8_t uuid[UUID_BINARY_SIZE]);
+
+/**
+ * @brief Generate a UUID string into a caller buffer (reentrant).
+ *
+ * @param[in,out] generator UUID generator state.
+ * @param[out] buffer UUID string buffer of `UUID_STRING_SIZE` characters.
+ * @return char* Pointer to the UUID string buffer.
+ */
+char* uuid_generate_r(uuid_generator_t *const generator, char buffer[UUID_STRING_SIZE]);
+
+/**
+ * @brief Generate a batch of 16-byte binary UUIDs into a caller buffer (reentrant).  Version-7 UUIDs 
+ * of a batch are strictly increasing, the system time is read once per batch and the timestamps of 
+ * a batch advance by the counter overflow only (one millisecond per 2048 to 4096 UUIDs).
+ *
+ * @param[in,out] generator UUID generator state.
+ * @param[out] uuids UUID buffer of `count * UUID_BINARY_SIZE` bytes.
+ * @param[in] count Number of UUIDs to generate.
+ */
+void uuid_generate_bulk(uuid_generator_t *const generator, uint8_t *const uuids, const size_t count);
+
+/**
+ * @brief Convert a 16-byte binary UUID to a UUID string.
+ *
+ * @param[in] uuid UUID buffer of `UUID_BINARY_SIZE` bytes.
+ * @param[out] buffer UUID string buffer of `UUID_STRING_SIZE` characters.
+ * @return char* Pointer to the UUID string buffer.
+ */
+char* uuid_to_string(const uint8_t uuid[UUID_BINARY_SIZE], char buffer[UUID_STRING_SIZE]);
+
 /**
  * @brief Converts `uuid` firmware version numbers (major, minor, patch) into a string.
  *
@@ -35,29 +35,35 @@
  #include <string.h>
  #include <stdio.h>
  #include <stdarg.h>
+ #include <sys/time.h>
  #include <esp_timer.h>
+ #include <esp_random.h>
+ #include <freertos/FreeRTOS.h>
  
  /* constant definitions */
  #define UUID_RANDOM_SIZE    4
- #define UUID_BUFFER_SIZE    37
+ #define UUID_BUFFER_SIZE    UUID_STRING_SIZE
  #define UUID_HASH_MAX_SIZE  60
  #define UUID_ARGS_SIZE      2
+ #define UUID_V7_COUNTER_MAX 0x0FFF
  
- /* Marsaglia initializer 'constants' */
- static uint32_t uuid_m_w = 0;
- static uint32_t uuid_m_z = 0;
- /* uuid mode - variant-4 (default) */
- static uuid_modes_t uuid_mode = UUID_MODE_VARIANT4;
+ /* default generator state of the non-reentrant api, variant-4 (default) */
+ static uuid_generator_t uuid_default_generator = { .m_w = 1, .m_z = 2, .mode = UUID_MODE_VARIANT4 };
+ /* default generator state guard */
+ static portMUX_TYPE uuid_default_generator_mux = portMUX_INITIALIZER_UNLOCKED;
+ /* nibble to hexadecimal character lookup table */
+ static const char uuid_hex_chars[] = "0123456789abcdef";
  
  /**
   * @brief Pseudo-random number generator (PRNG) using Marsaglia's MWC.
   *
+  * @param generator UUID generator state.
   * @return uint32_t Random generated number.
   */
- static uint32_t uuid_random(void) {
-     uuid_m_z = 36969 * (uuid_m_z & 65535) + (uuid_m_z >> 16);
-     uuid_m_w = 18000 * (uuid_m_w & 65535) + (uuid_m_w >> 16);
-     return (uuid_m_z << 16) + uuid_m_w;
+ static inline uint32_t uuid_random(uuid_generator_t *const generator) {
+     generator->m_z = 36969 * (generator->m_z & 65535) + (generator->m_z >> 16);
+     generator->m_w = 18000 * (generator->m_w & 65535) + (generator->m_w >> 16);
+     return (generator->m_z << 16) + generator->m_w;
  }
  
  /**
@@ -75,6 +81,104 @@
      return hash;
  }
  
+ /**
+  * @brief Unix epoch time in milliseconds from the system time.
+  *
+  * @return uint64_t Unix epoch time in milliseconds.
+  */
+ static inline uint64_t uuid_unix_time_ms(void) {
+     struct timeval tv;
+     gettimeofday(&tv, NULL);
+     return (uint64_t)tv.tv_sec * 1000U + (uint64_t)(tv.tv_usec / 1000);
+ }
+ 
+ /**
+  * @brief Generate a variant-4 or random binary UUID.
+  *
+  * @param generator UUID generator state.
+  * @param uuid UUID buffer of `UUID_BINARY_SIZE` bytes.
+  */
+ static inline void uuid_generate_random_binary(uuid_generator_t *const generator, uint8_t *const uuid) {
+     uint32_t ar[UUID_RANDOM_SIZE];
+ 
+     // Generate 4 random numbers
+     for (int32_t i = 0; i < UUID_RANDOM_SIZE; i++) {
+         ar[i] = uuid_random(generator);
+     }
+ 
+     for (int i = 0; i < UUID_BINARY_SIZE; i++) {
+         uuid[i] = (ar[i / 4] >> ((i % 4) * 8)) & 0xFF;
+     }
+ 
+     // Apply RFC-4122 version and variant bits
+     if (generator->mode == UUID_MODE_VARIANT4) {
+         uuid[6] = (uuid[6] & 0x0F) | 0x40; // Version 4
+         uuid[8] = (uuid[8] & 0x3F) | 0x80; // Variant 10xx
+     }
+ }
+ 
+ /**
+  * @brief Generate a version-7 binary UUID (RFC-9562).  The 12-bit rand_a field is a 
+  * monotonic counter within the same millisecond so that UUIDs of a generator sort by time.
+  *
+  * @param generator UUID generator state.
+  * @param ms Unix epoch time in milliseconds, read by the caller before a lock is taken.
+  * @param uuid UUID buffer of `UUID_BINARY_SIZE` bytes.
+  */
+ static inline void uuid_generate_v7_binary(uuid_generator_t *const generator, uint64_t ms, uint8_t *const uuid) {
+     if (ms > generator->v7_last_ms) {
+         // New millisecond, start the counter at a random value in the lower half
+         generator->v7_last_ms = ms;
+         generator->v7_counter = uuid_random(generator) & (UUID_V7_COUNTER_MAX >> 1);
+     } else if (generator->v7_counter < UUID_V7_COUNTER_MAX) {
+         // Same millisecond or clock stepped back, keep the last timestamp and bump the counter
+         generator->v7_counter++;
+     } else {
+         // Counter overflow, borrow the next millisecond
+         generator->v7_last_ms++;
+         generator->v7_counter = 0;
+     }
+     ms = generator->v7_last_ms;
+ 
+     const uint32_t r0 = uuid_random(generator);
+     const uint32_t r1 = uuid_random(generator);
+ 
+     // 48-bit big-endian unix epoch timestamp in milliseconds
+     uuid[0]  = (uint8_t)(ms >> 40);
+     uuid[1]  = (uint8_t)(ms >> 32);
+     uuid[2]  = (uint8_t)(ms >> 24);
+     uuid[3]  = (uint8_t)(ms >> 16);
+     uuid[4]  = (uint8_t)(ms >> 8);
+     uuid[5]  = (uint8_t)(ms);
+     // Version 7 and 12-bit counter
+     uuid[6]  = (uint8_t)(0x70 | ((generator->v7_counter >> 8) & 0x0F));
+     uuid[7]  = (uint8_t)(generator->v7_counter);
+     // Variant 10xx and 62 random bits
+     uuid[8]  = (uint8_t)(0x80 | ((r0 >> 24) & 0x3F));
+     uuid[9]  = (uint8_t)(r0 >> 16);
+     uuid[10] = (uint8_t)(r0 >> 8);
+     uuid[11] = (uint8_t)(r0);
+     uuid[12] = (uint8_t)(r1 >> 24);
+     uuid[13] = (uint8_t)(r1 >> 16);
+     uuid[14] = (uint8_t)(r1 >> 8);
+     uuid[15] = (uint8_t)(r1);
+ }
+ 
+ /**
+  * @brief Generate a binary UUID in the mode of the generator.
+  *
+  * @param generator UUID generator state.
+  * @param now_ms Unix epoch time in milliseconds, used in version-7 mode.
+  * @param uuid UUID buffer of `UUID_BINARY_SIZE` bytes.
+  */
+ static inline void uuid_generate_binary(uuid_generator_t *const generator, const uint64_t now_ms, uint8_t *const uuid) {
+     if (generator->mode == UUID_MODE_VERSION7) {
+         uuid_generate_v7_binary(generator, now_ms, uuid);
+     } else {
+         uuid_generate_random_binary(generator, uuid);
+     }
+ }
+ 
  void uuid_init(void) {
      // Seed with compile-time constants and esp_timer_get_time()
      uint32_t s2 = uuid_hash(__TIME__) * (uint32_t)esp_timer_get_time();
@@ -85,64 +189,102 @@
  }
  
  void uuid_seed(uint8_t size, ...) {
+     uint32_t seed1 = 1;
+     uint32_t seed2 = 2;
      va_list args;
      va_start(args, size);
      if (size == 1) {
-         uint32_t seed1 = va_arg(args, uint32_t);
-         // Prevent 0 as seed value
-         uuid_m_w = seed1 == 0 ? 1 : seed1;
-         uuid_m_z = 2;
+         seed1 = va_arg(args, uint32_t);
      } else if (size >= 2) {
-         uint32_t seed1 = va_arg(args, uint32_t);
-         uint32_t seed2 = va_arg(args, uint32_t);
-         // Prevent 0 as seed value
-         uuid_m_w = seed1 == 0 ? 1 : seed1;
-         uuid_m_z = seed2 == 0 ? 2 : seed2;
-     } else {
-         // Default seed values
-         uuid_m_w = 1;
-         uuid_m_z = 2;
+         seed1 = va_arg(args, uint32_t);
+         seed2 = va_arg(args, uint32_t);
      }
      va_end(args);
+     portENTER_CRITICAL(&uuid_default_generator_mux);
+     uuid_generator_seed(&uuid_default_generator, seed1, seed2);
+     portEXIT_CRITICAL(&uuid_default_generator_mux);
  }
  
  const char *uuid_generate(void) {
      static char uuid_buffer[UUID_BUFFER_SIZE];
-     uint32_t ar[UUID_RANDOM_SIZE];
+     uint8_t uuid[UUID_BINARY_SIZE];
+     // Read the system time outside the critical section, gettimeofday may block
+     const uint64_t now_ms = uuid_unix_time_ms();
  
-     // Generate 4 random numbers
-     for (int32_t i = 0; i < UUID_RANDOM_SIZE; i++) {
-         ar[i] = uuid_random();
+     portENTER_CRITICAL(&uuid_default_generator_mux);
+     uuid_generate_binary(&uuid_default_generator, now_ms, uuid);
+     portEXIT_CRITICAL(&uuid_default_generator_mux);
+ 
+     return (const char *)uuid_to_string(uuid, uuid_buffer);
+ }
+ 
+ void uuid_set_mode(const uuid_modes_t mode) {
+     portENTER_CRITICAL(&uuid_default_generator_mux);
+     uuid_default_generator.mode = mode;
+     portEXIT_CRITICAL(&uuid_default_generator_mux);
+ }
+ 
+ uuid_modes_t uuid_get_mode(void) {
+     portENTER_CRITICAL(&uuid_default_generator_mux);
+     const uuid_modes_t mode = uuid_default_generator.mode;
+     portEXIT_CRITICAL(&uuid_default_generator_mux);
+     return mode;
+ }
+ 
+ void uuid_generator_init(uuid_generator_t *const generator, const uuid_modes_t mode, const bool hw_seed) {
+     uint32_t s1, s2;
+     if (hw_seed) {
+         // Seed from the hardware random number generator
+         s1 = esp_random();
+         s2 = esp_random();
+     } else {
+         // Seed with compile-time constants and esp_timer_get_time()
+         s2 = uuid_hash(__TIME__) * (uint32_t)esp_timer_get_time();
+         s1 = s2 ^ uuid_hash(__DATE__);
+         s2 ^= uuid_hash(__FILE__);
      }
+     memset(generator, 0, sizeof(uuid_generator_t));
+     generator->mode = mode;
+     uuid_generator_seed(generator, s1, s2);
+ }
  
-     // Apply RFC-4122 version and variant bits
-     if (uuid_mode == UUID_MODE_VARIANT4) {
-         ar[1] = (ar[1] & 0xFFF0FFFF) | 0x00040000; // Version 4
-         ar[2] = (ar[2] & 0x3FFFFFFF) | 0x80000000; // Variant 10xx
+ void uuid_generator_seed(uuid_generator_t *const generator, const uint32_t seed1, const uint32_t seed2) {
+     // Prevent 0 as seed value
+     generator->m_w = seed1 == 0 ? 1 : seed1;
+     generator->m_z = seed2 == 0 ? 2 : seed2;
+ }
+ 
+ void uuid_generate_binary_r(uuid_generator_t *const generator, uint8_t uuid[UUID_BINARY_SIZE]) {
+     uuid_generate_binary(generator, uuid_unix_time_ms(), uuid);
+ }
+ 
+ char *uuid_generate_r(uuid_generator_t *const generator, char buffer[UUID_STRING_SIZE]) {
+     uint8_t uuid[UUID_BINARY_SIZE];
+     uuid_generate_binary_r(generator, uuid);
+     return uuid_to_string(uuid, buffer);
+ }
+ 
+ void uuid_generate_bulk(uuid_generator_t *const generator, uint8_t *const uuids, const size_t count) {
+     // Read the system time once per batch, the version-7 counter orders UUIDs within the millisecond 
+     // and borrows the next millisecond on overflow
+     const uint64_t now_ms = generator->mode == UUID_MODE_VERSION7 ? uuid_unix_time_ms() : 0;
+     for (size_t i = 0; i < count; i++) {
+         uuid_generate_binary(generator, now_ms, &uuids[i * UUID_BINARY_SIZE]);
      }
+ }
  
+ char *uuid_to_string(const uint8_t uuid[UUID_BINARY_SIZE], char buffer[UUID_STRING_SIZE]) {
      // Build the UUID string
      int j = 0;
-     for (int i = 0; i < 16; i++) {
+     for (int i = 0; i < UUID_BINARY_SIZE; i++) {
          if (i == 4 || i == 6 || i == 8 || i == 10) {
-             uuid_buffer[j++] = '-';
+             buffer[j++] = '-';
          }
-         uint8_t byte_index = i / 4;
-         uint8_t byte = (ar[byte_index] >> ((i % 4) * 8)) & 0xFF;
-         uuid_buffer[j++] = "0123456789abcdef"[(byte >> 4) & 0x0F];
-         uuid_buffer[j++] = "0123456789abcdef"[byte & 0x0F];
+         buffer[j++] = uuid_hex_chars[(uuid[i] >> 4) & 0x0F];
+         buffer[j++] = uuid_hex_chars[uuid[i] & 0x0F];
      }
- 
-     uuid_buffer[UUID_BUFFER_SIZE - 1] = '\0';
-     return (const char *)uuid_buffer;
- }
- 
- void uuid_set_mode(const uuid_modes_t mode) {
-     uuid_mode = mode;
- }
- 
- uuid_modes_t uuid_get_mode(void) {
-     return uuid_mode;
+     buffer[UUID_STRING_SIZE - 1] = '\0';
+     return buffer;
  }
  
  const char *uuid_get_fw_version(void) {
@@ -152,4 +294,3 @@
  int32_t uuid_get_fw_version_number(void) {
      return (int32_t)UUID_FW_VERSION_INT32;
  }
- 
\ No newline at end of file
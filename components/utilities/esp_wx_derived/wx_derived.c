@@ -0,0 +1,264 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file wx_derived.c
+ *
+ * ESP-IDF derived weather quantities pipeline
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "wx_derived.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <wx_utils.h>
+
+/*
+ * derived weather quantities definitions
+*/
+
+#define WX_DERIVED_PRESSURE_DEFAULT     (1013.25f)  //!< standard sea level pressure in hecto-pascal, used when the sample has no pressure
+#define WX_DERIVED_PSYCHROMETER_COEF    (0.000662f) //!< psychrometer coefficient per degree Celsius (ventilated)
+#define WX_DERIVED_WETBULB_ITERATIONS   (8)         //!< maximum newton iterations of the wetbulb solver
+#define WX_DERIVED_WETBULB_TOLERANCE    (0.001f)    //!< wetbulb solver tolerance in degrees Celsius
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/**
+ * @brief Derived weather quantities pipeline context descriptor structure definition.
+ */
+typedef struct wx_derived_context_s {
+    wx_derived_config_t         config;             /*!< pipeline configuration */
+    pressure_tendency_handle_t  pressure_tendency;  /*!< station pressure tendency handle, NULL when disabled */
+    scalar_trend_handle_t       temperature_trend;  /*!< air temperature trend handle, NULL when disabled */
+    scalar_trend_handle_t       humidity_trend;     /*!< relative humidity trend handle, NULL when disabled */
+    scalar_trend_handle_t       pressure_trend;     /*!< station pressure trend handle, NULL when disabled */
+} wx_derived_context_t;
+
+/*
+* static constant declarations
+*/
+static const char *TAG = "wx_derived";
+
+
+/**
+ * @brief Solves the psychrometric equation, pws(tw) - A * pa * (ta - tw) = e, for the 
+ * wetbulb temperature with newton iterations bracketed by the dewpoint and air temperature.
+ * 
+ * @param ta Air temperature in degrees Celsius.
+ * @param td Dewpoint temperature in degrees Celsius.
+ * @param e Vapour pressure in hecto-pascal.
+ * @param pa Air pressure in hecto-pascal.
+ * @return float Wetbulb temperature in degrees Celsius.
+ */
+static inline float wx_derived_wetbulb(const float ta, const float td, const float e, const float pa) {
+    const float a_pa = WX_DERIVED_PSYCHROMETER_COEF * pa;
+    float tw = td;
+
+    for(uint8_t i = 0; i < WX_DERIVED_WETBULB_ITERATIONS; i++) {
+        const float pws_tw = wx_pws_fast(tw + 273.15f);
+        const float f      = pws_tw - a_pa * (ta - tw) - e;
+
+        /* derivative of the magnus approximation of ln(pws) */
+        const float d      = 243.12f + tw;
+        const float df     = pws_tw * (17.62f * 243.12f) / (d * d) + a_pa;
+
+        const float step   = f / df;
+        tw -= step;
+
+        /* keep the solution between the dewpoint and air temperature */
+        if(tw > ta) tw = ta;
+        if(tw < td) tw = td;
+
+        if(fabsf(step) < WX_DERIVED_WETBULB_TOLERANCE) break;
+    }
+
+    return tw;
+}
+
+/**
+ * @brief Frees the trend and tendency handles of the pipeline context.
+ * 
+ * @param ctxt Pipeline context.
+ */
+static inline void wx_derived_free_analyzers(wx_derived_context_t *const ctxt) {
+    if(ctxt->pressure_tendency) pressure_tendency_delete(ctxt->pressure_tendency);
+    if(ctxt->temperature_trend) scalar_trend_delete(ctxt->temperature_trend);
+    if(ctxt->humidity_trend)    scalar_trend_delete(ctxt->humidity_trend);
+    if(ctxt->pressure_trend)    scalar_trend_delete(ctxt->pressure_trend);
+}
+
+esp_err_t wx_derived_init(const wx_derived_config_t *wx_derived_config, wx_derived_handle_t *wx_derived_handle) {
+    esp_err_t ret = ESP_OK;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( wx_derived_config && wx_derived_handle );
+
+    /* validate memory availability for pipeline handle */
+    wx_derived_context_t* ctxt = (wx_derived_context_t*)calloc(1, sizeof(wx_derived_context_t));
+    ESP_RETURN_ON_FALSE( ctxt, ESP_ERR_NO_MEM, TAG, "no memory for wx derived handle, wx derived handle initialization failed" );
+
+    /* copy configuration */
+    ctxt->config = *wx_derived_config;
+
+    /* attempt to instantiate pressure tendency analyzer */
+    if(ctxt->config.sampling_interval > 0) {
+        ESP_GOTO_ON_ERROR( pressure_tendency_init(ctxt->config.sampling_interval, ctxt->config.tendency_period, &ctxt->pressure_tendency), 
+                            err, TAG, "unable to initialize pressure tendency, wx derived handle initialization failed" );
+    }
+
+    /* attempt to instantiate scalar trend analyzers */
+    if(ctxt->config.trend_samples_size > 0) {
+        ESP_GOTO_ON_ERROR( scalar_trend_init(ctxt->config.trend_samples_size, &ctxt->temperature_trend), 
+                            err, TAG, "unable to initialize temperature trend, wx derived handle initialization failed" );
+        ESP_GOTO_ON_ERROR( scalar_trend_init(ctxt->config.trend_samples_size, &ctxt->humidity_trend), 
+                            err, TAG, "unable to initialize humidity trend, wx derived handle initialization failed" );
+        ESP_GOTO_ON_ERROR( scalar_trend_init(ctxt->config.trend_samples_size, &ctxt->pressure_trend), 
+                            err, TAG, "unable to initialize pressure trend, wx derived handle initialization failed" );
+    }
+
+    /* set output instance */
+    *wx_derived_handle = (wx_derived_handle_t)ctxt;
+
+    return ESP_OK;
+
+    err:
+        wx_derived_free_analyzers(ctxt);
+        free(ctxt);
+        return ret;
+}
+
+esp_err_t wx_derived_process(wx_derived_handle_t wx_derived_handle, const wx_derived_sample_t *const sample, wx_derived_data_t *const data) {
+    wx_derived_context_t* ctxt = (wx_derived_context_t*)wx_derived_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctxt && sample && data );
+
+    const float ta = sample->temperature;
+    const float hr = sample->humidity;
+    const float pa = sample->pressure;
+    const bool  has_ta = !isnan(ta);
+    const bool  has_hr = !isnan(hr) && hr > 0.0f;
+    const bool  has_pa = !isnan(pa) && pa > 0.0f;
+
+    /* default all derived quantities to not available */
+    *data = (wx_derived_data_t) {
+        .temperature                = ta,
+        .humidity                   = hr,
+        .pressure                   = pa,
+        .saturation_vapour_pressure = NAN,
+        .vapour_pressure            = NAN,
+        .dewpoint                   = NAN,
+        .wetbulb                    = NAN,
+        .heat_index                 = NAN,
+        .mixing_ratio               = NAN,
+        .sea_level_pressure         = NAN,
+        .qnh                        = NAN,
+        .pressure_tendency_change   = NAN,
+        .pressure_tendency_code     = PRESSURE_TENDENCY_CODE_UNKNOWN,
+        .temperature_trend_code     = SCALAR_TREND_CODE_UNKNOWN,
+        .humidity_trend_code        = SCALAR_TREND_CODE_UNKNOWN,
+        .pressure_trend_code        = SCALAR_TREND_CODE_UNKNOWN
+    };
+
+    /* saturation vapour pressure is shared by the vapour pressure, mixing ratio and wetbulb */
+    if(has_ta) {
+        data->saturation_vapour_pressure = wx_pws_fast(ta + 273.15f);
+    }
+
+    /* humidity derived quantities */
+    if(has_ta && has_hr) {
+        const float e  = data->saturation_vapour_pressure * hr * 0.01f;
+        const float pr = has_pa ? pa : WX_DERIVED_PRESSURE_DEFAULT;
+
+        data->vapour_pressure = e;
+        data->dewpoint        = wx_td_fast(ta, hr);
+        data->wetbulb         = wx_derived_wetbulb(ta, data->dewpoint, e, pr);
+        data->heat_index      = wx_hi_fast(ta, hr);
+        data->mixing_ratio    = 621.97f * e / (pr - e);
+    }
+
+    /* pressure derived quantities */
+    if(has_pa) {
+        if(has_ta) {
+            data->sea_level_pressure = (float)wx_pressure_at_sea_level(pa, ctxt->config.altitude, ta);
+        }
+        /* the ICAO reduction depends on the barometer elevation only, the station altitude argument is unused */
+        data->qnh = (float)wx_qnh(pa, ctxt->config.altitude, 0.0);
+    }
+
+    /* trend and tendency analysis */
+    if(has_pa && ctxt->pressure_tendency) {
+        ESP_RETURN_ON_ERROR( pressure_tendency_analysis(ctxt->pressure_tendency, pa, &data->pressure_tendency_code, &data->pressure_tendency_change), 
+                            TAG, "unable to analyze pressure tendency, wx derived process failed" );
+    }
+    if(has_ta && ctxt->temperature_trend) {
+        ESP_RETURN_ON_ERROR( scalar_trend_analysis(ctxt->temperature_trend, ta, &data->temperature_trend_code), 
+                            TAG, "unable to analyze temperature trend, wx derived process failed" );
+    }
+    if(has_hr && ctxt->humidity_trend) {
+        ESP_RETURN_ON_ERROR( scalar_trend_analysis(ctxt->humidity_trend, hr, &data->humidity_trend_code), 
+                            TAG, "unable to analyze humidity trend, wx derived process failed" );
+    }
+    if(has_pa && ctxt->pressure_trend) {
+        ESP_RETURN_ON_ERROR( scalar_trend_analysis(ctxt->pressure_trend, pa, &data->pressure_trend_code), 
+                            TAG, "unable to analyze pressure trend, wx derived process failed" );
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wx_derived_reset(wx_derived_handle_t wx_derived_handle) {
+    wx_derived_context_t* ctxt = (wx_derived_context_t*)wx_derived_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctxt );
+
+    if(ctxt->pressure_tendency) ESP_RETURN_ON_ERROR( pressure_tendency_reset(ctxt->pressure_tendency), TAG, "unable to reset pressure tendency, wx derived reset failed" );
+    if(ctxt->temperature_trend) ESP_RETURN_ON_ERROR( scalar_trend_reset(ctxt->temperature_trend), TAG, "unable to reset temperature trend, wx derived reset failed" );
+    if(ctxt->humidity_trend)    ESP_RETURN_ON_ERROR( scalar_trend_reset(ctxt->humidity_trend), TAG, "unable to reset humidity trend, wx derived reset failed" );
+    if(ctxt->pressure_trend)    ESP_RETURN_ON_ERROR( scalar_trend_reset(ctxt->pressure_trend), TAG, "unable to reset pressure trend, wx derived reset failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t wx_derived_delete(wx_derived_handle_t wx_derived_handle) {
+    wx_derived_context_t* ctxt = (wx_derived_context_t*)wx_derived_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ctxt );
+
+    wx_derived_free_analyzers(ctxt);
+    free(ctxt);
+
+    return ESP_OK;
+}
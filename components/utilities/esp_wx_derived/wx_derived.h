@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file wx_derived.h
+ * @defgroup wx_derived
+ * @{
+ *
+ * ESP-IDF derived weather quantities pipeline
+ * 
+ * Computes derived meteorological quantities and trends from a temperature, 
+ * humidity and pressure sample in one pass, intermediate values shared by 
+ * several quantities (i.e. saturation vapour pressure) are computed once per 
+ * sample.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __WX_DERIVED_H__
+#define __WX_DERIVED_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <scalar_trend.h>
+#include <pressure_tendency.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Derived weather quantities pipeline configuration structure.
+ */
+typedef struct wx_derived_config_s {
+    float                       altitude;               /*!< station altitude in meters, used for sea level pressure reductions */
+    uint16_t                    sampling_interval;      /*!< sampling interval in seconds, used for the pressure tendency, 0 disables the pressure tendency */
+    pressure_tendency_periods_t tendency_period;        /*!< pressure tendency period (3-hr or 6-hr) */
+    uint16_t                    trend_samples_size;     /*!< scalar trend samples size (1-hr of samples), 0 disables the scalar trends */
+} wx_derived_config_t;
+
+/**
+ * @brief Derived weather quantities pipeline sample structure, unavailable 
+ * measurements (i.e. a sensor without pressure) are set to NAN.
+ */
+typedef struct wx_derived_sample_s {
+    float temperature;  /*!< air temperature in degrees Celsius */
+    float humidity;     /*!< relative humidity in percent */
+    float pressure;     /*!< station air pressure in hecto-pascal */
+} wx_derived_sample_t;
+
+/**
+ * @brief Derived weather quantities pipeline data structure, quantities that 
+ * cannot be derived from the sample are set to NAN.  All values are floats 
+ * or trend codes and map directly onto datatable float and int16 columns.
+ */
+typedef struct wx_derived_data_s {
+    float                       temperature;                /*!< air temperature in degrees Celsius */
+    float                       humidity;                   /*!< relative humidity in percent */
+    float                       pressure;                   /*!< station air pressure in hecto-pascal */
+    float                       saturation_vapour_pressure; /*!< saturation vapour pressure over water in hecto-pascal */
+    float                       vapour_pressure;            /*!< vapour pressure in hecto-pascal */
+    float                       dewpoint;                   /*!< dewpoint temperature in degrees Celsius */
+    float                       wetbulb;                    /*!< wetbulb temperature in degrees Celsius */
+    float                       heat_index;                 /*!< heat index in degrees Celsius */
+    float                       mixing_ratio;               /*!< mixing ratio in grams per kilogram */
+    float                       sea_level_pressure;         /*!< air pressure reduced to sea level (QFF) in hecto-pascal */
+    float                       qnh;                        /*!< air pressure reduced to sea level by the ICAO standard atmosphere (QNH) in hecto-pascal */
+    float                       pressure_tendency_change;   /*!< pressure change over the pressure tendency period in hecto-pascal */
+    pressure_tendency_codes_t   pressure_tendency_code;     /*!< pressure tendency code */
+    scalar_trend_codes_t        temperature_trend_code;     /*!< air temperature 1-hr trend code */
+    scalar_trend_codes_t        humidity_trend_code;        /*!< relative humidity 1-hr trend code */
+    scalar_trend_codes_t        pressure_trend_code;        /*!< station air pressure 1-hr trend code */
+} wx_derived_data_t;
+
+/**
+ * @brief Derived weather quantities pipeline opaque handle structure definition.
+ */
+typedef void* wx_derived_handle_t;
+
+/**
+ * @brief Initializes a derived weather quantities pipeline handle.
+ * 
+ * @param[in] wx_derived_config Derived weather quantities pipeline configuration.
+ * @param[out] wx_derived_handle Derived weather quantities pipeline handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_derived_init(const wx_derived_config_t *wx_derived_config, wx_derived_handle_t *wx_derived_handle);
+
+/**
+ * @brief Processes a sample through the pipeline, computes all derived quantities and 
+ * pushes the sample onto the trend and tendency analyzers.  Call once per sampling interval.
+ * 
+ * @param[in] wx_derived_handle Derived weather quantities pipeline handle.
+ * @param[in] sample Temperature, humidity and pressure sample.
+ * @param[out] data Derived weather quantities and trends.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_derived_process(wx_derived_handle_t wx_derived_handle, const wx_derived_sample_t *const sample, wx_derived_data_t *const data);
+
+/**
+ * @brief Purges the trend and tendency samples of the pipeline.
+ * 
+ * @param[in] wx_derived_handle Derived weather quantities pipeline handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_derived_reset(wx_derived_handle_t wx_derived_handle);
+
+/**
+ * @brief Frees derived weather quantities pipeline handle.
+ * 
+ * @param[in] wx_derived_handle Derived weather quantities pipeline handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_derived_delete(wx_derived_handle_t wx_derived_handle);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif // __WX_DERIVED_H__
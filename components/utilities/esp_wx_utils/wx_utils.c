@@ -53,6 +53,11 @@
 #define WX_HUMIDITY_MAX          (float)(100.0)  //!< maximum humidity range
 #define WX_HUMIDITY_MIN          (float)(0.0)    //!< minimum humidity range
 
+#define WX_PWS_TABLE_TEMPERATURE_MIN    (-40)   //!< first entry of the ln(pws) table in degrees Celsius
+#define WX_PWS_TABLE_SIZE               (166)   //!< ln(pws) table entries, -40 to 125 degrees Celsius in 1 degree steps
+#define WX_PWI_TABLE_TEMPERATURE_MIN    (-40)   //!< first entry of the ln(pwi) table in degrees Celsius
+#define WX_PWI_TABLE_SIZE               (41)    //!< ln(pwi) table entries, -40 to 0 degrees Celsius in 1 degree steps
+
 
 /*
  * macro definitions
@@ -81,6 +86,45 @@ static inline wx_scalar_range_t wx_humidity_range = { .maximum = WX_HUMIDITY_MAX
 
 static const char *TAG = "wx_utils";
 
+/**
+ * @brief Natural logarithm of `wx_pws` (hecto-pascal) from -40 to 125 degrees Celsius in 1 degree steps.
+ */
+static const float wx_ln_pws_table[WX_PWS_TABLE_SIZE] = {
+    -1.6585524e+00f, -1.5557482e+00f, -1.4539054e+00f, -1.3530114e+00f, -1.2530542e+00f, -1.1540216e+00f, -1.0559017e+00f, -9.5868301e-01f,
+    -8.6235398e-01f, -7.6690337e-01f, -6.7232009e-01f, -5.7859323e-01f, -4.8571207e-01f, -3.9366604e-01f, -3.0244476e-01f, -2.1203800e-01f,
+    -1.2243571e-01f, -3.3627985e-02f, 5.4394920e-02f, 1.4164260e-01f, 2.2812449e-01f, 3.1384989e-01f, 3.9882795e-01f, 4.8306767e-01f,
+    5.6657794e-01f, 6.4936748e-01f, 7.3144489e-01f, 8.1281865e-01f, 8.9349710e-01f, 9.7348845e-01f, 1.0528008e+00f, 1.1314421e+00f,
+    1.2094202e+00f, 1.2867429e+00f, 1.3634177e+00f, 1.4394522e+00f, 1.5148538e+00f, 1.5896298e+00f, 1.6637873e+00f, 1.7373334e+00f,
+    1.8102752e+00f, 1.8826193e+00f, 1.9543728e+00f, 2.0255421e+00f, 2.0961340e+00f, 2.1661549e+00f, 2.2356111e+00f, 2.3045090e+00f,
+    2.3728549e+00f, 2.4406548e+00f, 2.5079147e+00f, 2.5746407e+00f, 2.6408387e+00f, 2.7065143e+00f, 2.7716733e+00f, 2.8363215e+00f,
+    2.9004642e+00f, 2.9641070e+00f, 3.0272553e+00f, 3.0899145e+00f, 3.1520898e+00f, 3.2137863e+00f, 3.2750093e+00f, 3.3357638e+00f,
+    3.3960546e+00f, 3.4558869e+00f, 3.5152653e+00f, 3.5741948e+00f, 3.6326800e+00f, 3.6907256e+00f, 3.7483362e+00f, 3.8055163e+00f,
+    3.8622704e+00f, 3.9186030e+00f, 3.9745183e+00f, 4.0300208e+00f, 4.0851147e+00f, 4.1398041e+00f, 4.1940932e+00f, 4.2479861e+00f,
+    4.3014869e+00f, 4.3545996e+00f, 4.4073280e+00f, 4.4596760e+00f, 4.5116476e+00f, 4.5632465e+00f, 4.6144764e+00f, 4.6653411e+00f,
+    4.7158441e+00f, 4.7659892e+00f, 4.8157798e+00f, 4.8652195e+00f, 4.9143118e+00f, 4.9630600e+00f, 5.0114677e+00f, 5.0595380e+00f,
+    5.1072745e+00f, 5.1546802e+00f, 5.2017584e+00f, 5.2485124e+00f, 5.2949453e+00f, 5.3410601e+00f, 5.3868601e+00f, 5.4323481e+00f,
+    5.4775273e+00f, 5.5224005e+00f, 5.5669708e+00f, 5.6112410e+00f, 5.6552139e+00f, 5.6988925e+00f, 5.7422795e+00f, 5.7853777e+00f,
+    5.8281897e+00f, 5.8707184e+00f, 5.9129664e+00f, 5.9549363e+00f, 5.9966307e+00f, 6.0380523e+00f, 6.0792035e+00f, 6.1200869e+00f,
+    6.1607049e+00f, 6.2010602e+00f, 6.2411549e+00f, 6.2809917e+00f, 6.3205728e+00f, 6.3599006e+00f, 6.3989775e+00f, 6.4378058e+00f,
+    6.4763876e+00f, 6.5147253e+00f, 6.5528212e+00f, 6.5906773e+00f, 6.6282959e+00f, 6.6656791e+00f, 6.7028291e+00f, 6.7397480e+00f,
+    6.7764378e+00f, 6.8129006e+00f, 6.8491384e+00f, 6.8851533e+00f, 6.9209473e+00f, 6.9565223e+00f, 6.9918802e+00f, 7.0270231e+00f,
+    7.0619528e+00f, 7.0966712e+00f, 7.1311801e+00f, 7.1654814e+00f, 7.1995770e+00f, 7.2334687e+00f, 7.2671582e+00f, 7.3006473e+00f,
+    7.3339378e+00f, 7.3670313e+00f, 7.3999297e+00f, 7.4326346e+00f, 7.4651477e+00f, 7.4974706e+00f, 7.5296050e+00f, 7.5615526e+00f,
+    7.5933149e+00f, 7.6248935e+00f, 7.6562900e+00f, 7.6875060e+00f, 7.7185430e+00f, 7.7494025e+00f
+};
+
+/**
+ * @brief Natural logarithm of `wx_pwi` (hecto-pascal) from -40 to 0 degrees Celsius in 1 degree steps.
+ */
+static const float wx_ln_pwi_table[WX_PWI_TABLE_SIZE] = {
+    -2.0521961e+00f, -1.9395281e+00f, -1.8278165e+00f, -1.7170495e+00f, -1.6072155e+00f, -1.4983028e+00f, -1.3903003e+00f, -1.2831967e+00f,
+    -1.1769812e+00f, -1.0716430e+00f, -9.6717155e-01f, -8.6355640e-01f, -7.6078731e-01f, -6.5885422e-01f, -5.5774719e-01f, -4.5745646e-01f,
+    -3.5797244e-01f, -2.5928566e-01f, -1.6138682e-01f, -6.4266752e-02f, 3.2083560e-02f, 1.2767300e-01f, 2.2251030e-01f, 3.1660407e-01f,
+    4.0996280e-01f, 5.0259482e-01f, 5.9450836e-01f, 6.8571151e-01f, 7.7621225e-01f, 8.6601843e-01f, 9.5513778e-01f, 1.0435779e+00f,
+    1.1313464e+00f, 1.2184505e+00f, 1.3048977e+00f, 1.3906950e+00f, 1.4758495e+00f, 1.5603683e+00f, 1.6442581e+00f, 1.7275258e+00f,
+    1.8101781e+00f
+};
+
 
 /*
 * functions and subroutines
@@ -187,6 +231,16 @@ const double wx_pressure_at_sea_level(const double ph, const double a, const dou
     return ph / pow(1.0-hl/(t+hl+273.15),5.257);
 }
 
+const double wx_qnh(const double qfe, const double h, const double a) {
+    // see https://www.weather.gov/media/epz/wxcalc/altimeterSetting.pdf
+    const double n  = 0.190263;                         // R * L / g
+    const double k  = pow(1013.25, n) * 0.0065 / 288.15; // p0^n * L / T0
+
+    (void)a;
+
+    return pow(pow(qfe, n) + k * h, 1.0 / n);
+}
+
 const double wx_td(const double ta, const double hr) {
     const double a1 = 243.12;
     const double a2 = 17.62;
@@ -210,4 +264,176 @@ const double wx_tw(const double ta, const double hr, const double td, const doub
 
     double twet_init = 243.12 * ( log(pws_td / 6.112) / (17.62 - log(pws_td / 6.112)) );
     return NAN;
-}
\ No newline at end of file
+}
+
+const double wx_hi(const double ta, const double hr) {
+    // see https://www.wpc.ncep.noaa.gov/html/heatindex_equation.shtml
+    const double tf = ta * 1.8 + 32.0;
+
+    /* simple formula, used when the heat index is below 80 degrees Fahrenheit */
+    double hi = 0.5 * (tf + 61.0 + ((tf - 68.0) * 1.2) + (hr * 0.094));
+
+    if((hi + tf) / 2.0 >= 80.0) {
+        /* Rothfusz regression */
+        hi = -42.379 + 2.04901523 * tf + 10.14333127 * hr - 0.22475541 * tf * hr 
+            - 0.00683783 * tf * tf - 0.05481717 * hr * hr + 0.00122874 * tf * tf * hr 
+            + 0.00085282 * tf * hr * hr - 0.00000199 * tf * tf * hr * hr;
+
+        /* low and high humidity adjustments */
+        if(hr < 13.0 && tf >= 80.0 && tf <= 112.0) {
+            hi -= ((13.0 - hr) / 4.0) * sqrt((17.0 - fabs(tf - 95.0)) / 17.0);
+        } else if(hr > 85.0 && tf >= 80.0 && tf <= 87.0) {
+            hi += ((hr - 85.0) / 10.0) * ((87.0 - tf) / 5.0);
+        }
+    }
+
+    return (hi - 32.0) / 1.8;
+}
+
+const double wx_mr(const double ta, const double hr, const double pa) {
+    const double e = wx_pws(wx_c_to_k(ta)) * hr / 100.0;
+
+    return 621.97 * e / (pa - e);
+}
+
+/**
+ * @brief Linear interpolation of a natural logarithm table by temperature.
+ * 
+ * @param table Table of natural logarithms in 1 degree Celsius steps.
+ * @param table_size Number of table entries.
+ * @param table_min Temperature of the first table entry in degrees Celsius.
+ * @param t Temperature in kelvin.
+ * @param ln_value Interpolated natural logarithm.
+ * @return true Temperature is within the table range.
+ * @return false Temperature is outside the table range.
+ */
+static inline bool wx_table_lerp(const float *const table, const int table_size, const int table_min, const float t, float *const ln_value) {
+    const float pos = (t - 273.15f) - (float)table_min;
+
+    /* validate temperature is within table range (negated to catch NaN) */
+    if(!(pos >= 0.0f && pos <= (float)(table_size - 1))) return false;
+
+    int index = (int)pos;
+    if(index > table_size - 2) index = table_size - 2;
+    const float fraction = pos - (float)index;
+
+    *ln_value = table[index] + (table[index + 1] - table[index]) * fraction;
+
+    return true;
+}
+
+float wx_v_fast(const float t) {
+    const float c0 = 0.4931358f;
+    const float c1 = -0.0046094296f;
+    const float c2 = 0.000013746454f;
+    const float c3 = -0.000000012743214f;
+
+    return t - (c0 + t * (c1 + t * (c2 + t * c3)));
+}
+
+float wx_pwi_fast(const float t) {
+    float ln_pwi;
+
+    if(!wx_table_lerp(wx_ln_pwi_table, WX_PWI_TABLE_SIZE, WX_PWI_TABLE_TEMPERATURE_MIN, t, &ln_pwi)) {
+        return (float)wx_pwi(t);
+    }
+
+    return expf(ln_pwi);
+}
+
+float wx_pws_fast(const float t) {
+    float ln_pws;
+
+    if(!wx_table_lerp(wx_ln_pws_table, WX_PWS_TABLE_SIZE, WX_PWS_TABLE_TEMPERATURE_MIN, t, &ln_pws)) {
+        return (float)wx_pws(t);
+    }
+
+    return expf(ln_pws);
+}
+
+float wx_td_fast(const float ta, const float hr) {
+    const float a1 = 243.12f;
+    const float a2 = 17.62f;
+    const float H = logf(hr / 100.0f) + (a2 * ta) / (a1 + ta);
+
+    return (a1 * H) / (a2 - H);
+}
+
+float wx_tw_fast(const float ta, const float hr) {
+    // see https://doi.org/10.1175/JAMC-D-11-0143.1
+    return ta * atanf(0.151977f * sqrtf(hr + 8.313659f)) + atanf(ta + hr) - atanf(hr - 1.676331f)
+        + 0.00391838f * hr * sqrtf(hr) * atanf(0.023101f * hr) - 4.686035f;
+}
+
+float wx_hi_fast(const float ta, const float hr) {
+    const float tf = ta * 1.8f + 32.0f;
+
+    /* simple formula, used when the heat index is below 80 degrees Fahrenheit */
+    float hi = 0.5f * (tf + 61.0f + ((tf - 68.0f) * 1.2f) + (hr * 0.094f));
+
+    if((hi + tf) * 0.5f >= 80.0f) {
+        /* Rothfusz regression (horner form) */
+        hi = -42.379f + tf * (2.04901523f - 0.00683783f * tf)
+            + hr * (10.14333127f - 0.05481717f * hr)
+            + tf * hr * (-0.22475541f + 0.00122874f * tf + 0.00085282f * hr - 0.00000199f * tf * hr);
+
+        /* low and high humidity adjustments */
+        if(hr < 13.0f && tf >= 80.0f && tf <= 112.0f) {
+            hi -= ((13.0f - hr) * 0.25f) * sqrtf((17.0f - fabsf(tf - 95.0f)) / 17.0f);
+        } else if(hr > 85.0f && tf >= 80.0f && tf <= 87.0f) {
+            hi += ((hr - 85.0f) * 0.1f) * ((87.0f - tf) * 0.2f);
+        }
+    }
+
+    return (hi - 32.0f) / 1.8f;
+}
+
+float wx_mr_fast(const float ta, const float hr, const float pa) {
+    const float e = wx_pws_fast(ta + 273.15f) * hr * 0.01f;
+
+    return 621.97f * e / (pa - e);
+}
+
+esp_err_t wx_td_batch(const float *const ta, const float *const hr, const size_t count, float *const td) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ta && hr && td );
+
+    for(size_t i = 0; i < count; i++) {
+        td[i] = wx_td_fast(ta[i], hr[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wx_tw_batch(const float *const ta, const float *const hr, const size_t count, float *const tw) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ta && hr && tw );
+
+    for(size_t i = 0; i < count; i++) {
+        tw[i] = wx_tw_fast(ta[i], hr[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wx_hi_batch(const float *const ta, const float *const hr, const size_t count, float *const hi) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ta && hr && hi );
+
+    for(size_t i = 0; i < count; i++) {
+        hi[i] = wx_hi_fast(ta[i], hr[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wx_mr_batch(const float *const ta, const float *const hr, const float *const pa, const size_t count, float *const mr) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ta && hr && pa && mr );
+
+    for(size_t i = 0; i < count; i++) {
+        mr[i] = wx_mr_fast(ta[i], hr[i], pa[i]);
+    }
+
+    return ESP_OK;
+}
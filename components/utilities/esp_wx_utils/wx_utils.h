@@ -180,6 +180,10 @@ const double wx_qff(const double qfe, const double l, const double ta);
  * @brief Calculates the reduced air pressure QNH (pressure at sea 
  * level according to ICAO standard atmospheric).
  * 
+ * @note The reduction is made from the elevation of the QFE level (`h`) 
+ * through the ICAO standard atmosphere and does not depend on the air 
+ * temperature, the station altitude (`a`) is not used by the reduction.
+ * 
  * @param qfe Staion level air pressure in hecto-pascal.
  * @param h Elevation of pressure QFE in International Standard Atmosphere (ISA).
  * @param a Station altitude in meters.
@@ -211,6 +215,157 @@ const double wx_tw(const double ta, const double hr, const double td, const doub
 
 
 
+/**
+ * @brief Calculates heat index (apparent temperature) from air temperature and relative humidity 
+ * using the NWS Rothfusz regression with its low and high humidity adjustments.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @return double Heat index in degrees celsius.
+ */
+const double wx_hi(const double ta, const double hr);
+
+/**
+ * @brief Calculates mixing ratio from air temperature, relative humidity and air pressure.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @param pa Air pressure in hecto-pascal.
+ * @return double Mixing ratio in grams of water vapour per kilogram of dry air.
+ */
+const double wx_mr(const double ta, const double hr, const double pa);
+
+
+
+/*
+ * single-precision fast-path functions
+ *
+ * The ESP32-S3 FPU is single-precision, the double-precision functions above are software emulated.
+ * The fast-path functions below are evaluated in single-precision with lookup tables and are intended
+ * for high-rate or batch processing.  Maximum errors against the double-precision functions over the
+ * default `wx_temperature_range` (-40 to 125 degrees Celsius) and `wx_humidity_range` (1 to 100 percent):
+ *
+ *   wx_v_fast      relative error < 1e-7
+ *   wx_pws_fast    relative error < 1.3e-4   (ln(pws) table, 1 degree Celsius steps, linear interpolation)
+ *   wx_pwi_fast    relative error < 1.3e-4   (ln(pwi) table, 1 degree Celsius steps, -40 to 0 degrees Celsius)
+ *   wx_td_fast     absolute error < 0.0001 degrees Celsius
+ *   wx_hi_fast     absolute error < 0.001 degrees Celsius
+ *   wx_mr_fast     relative error < 1.3e-4   (air pressure 300 to 1100 hecto-pascal, vapour pressure below half the air pressure)
+ *
+ * The table based functions fall back to the double-precision functions outside the table range.
+*/
+
+/**
+ * @brief Calculates v at temperature in single-precision.
+ * 
+ * @param t Temperature in kelvin.
+ * @return float v at temperature.
+ */
+float wx_v_fast(const float t);
+
+/**
+ * @brief Calculates aqueous vapor pressure of ice at temperature in single-precision.
+ * 
+ * @param t Temperature in kelvin.
+ * @return float Aqueous vapor pressure of ice in hecto-pascal.
+ */
+float wx_pwi_fast(const float t);
+
+/**
+ * @brief Calculates aqueous vapor pressure of water at temperature in single-precision.
+ * 
+ * @param t Temperature in kelvin.
+ * @return float Aqueous vapor pressure of water in hecto-pascal.
+ */
+float wx_pws_fast(const float t);
+
+/**
+ * @brief Calculates dewpoint temperature from air temperature and relative humidity in single-precision.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @return float Dewpoint temperature in degrees celsius.
+ */
+float wx_td_fast(const float ta, const float hr);
+
+/**
+ * @brief Calculates wetbulb temperature from air temperature and relative humidity in single-precision
+ * with the Stull (2011) empirical formula at standard sea level pressure.
+ * 
+ * @note The formula is valid for relative humidity from 5 to 99 percent and air temperature from -20 to 
+ * 50 degrees Celsius, the error is within -1 to +0.65 degrees Celsius of the psychrometric wetbulb temperature.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @return float Wetbulb temperature in degrees celsius.
+ */
+float wx_tw_fast(const float ta, const float hr);
+
+/**
+ * @brief Calculates heat index from air temperature and relative humidity in single-precision.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @return float Heat index in degrees celsius.
+ */
+float wx_hi_fast(const float ta, const float hr);
+
+/**
+ * @brief Calculates mixing ratio from air temperature, relative humidity and air pressure in single-precision.
+ * 
+ * @param ta Air temperature in degrees celsius.
+ * @param hr Relative humidity in percent.
+ * @param pa Air pressure in hecto-pascal.
+ * @return float Mixing ratio in grams of water vapour per kilogram of dry air.
+ */
+float wx_mr_fast(const float ta, const float hr, const float pa);
+
+/**
+ * @brief Calculates dewpoint temperatures for an array of samples in single-precision.
+ * 
+ * @param[in] ta Air temperatures in degrees celsius.
+ * @param[in] hr Relative humidities in percent.
+ * @param[in] count Number of samples.
+ * @param[out] td Dewpoint temperatures in degrees celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_td_batch(const float *const ta, const float *const hr, const size_t count, float *const td);
+
+/**
+ * @brief Calculates wetbulb temperatures for an array of samples in single-precision.
+ * 
+ * @param[in] ta Air temperatures in degrees celsius.
+ * @param[in] hr Relative humidities in percent.
+ * @param[in] count Number of samples.
+ * @param[out] tw Wetbulb temperatures in degrees celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_tw_batch(const float *const ta, const float *const hr, const size_t count, float *const tw);
+
+/**
+ * @brief Calculates heat indexes for an array of samples in single-precision.
+ * 
+ * @param[in] ta Air temperatures in degrees celsius.
+ * @param[in] hr Relative humidities in percent.
+ * @param[in] count Number of samples.
+ * @param[out] hi Heat indexes in degrees celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_hi_batch(const float *const ta, const float *const hr, const size_t count, float *const hi);
+
+/**
+ * @brief Calculates mixing ratios for an array of samples in single-precision.
+ * 
+ * @param[in] ta Air temperatures in degrees celsius.
+ * @param[in] hr Relative humidities in percent.
+ * @param[in] pa Air pressures in hecto-pascal.
+ * @param[in] count Number of samples.
+ * @param[out] mr Mixing ratios in grams of water vapour per kilogram of dry air.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t wx_mr_batch(const float *const ta, const float *const hr, const float *const pa, const size_t count, float *const mr);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,160 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file gas_index_engine.c
+ *
+ * ESP-IDF multi-instance gas index engine
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "gas_index_engine.h"
+#include <string.h>
+#include <stdbool.h>
+#include <esp_rom_crc.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+
+/**
+ * @brief Calculates the crc32 of a state blob, excluding the crc field.
+ * 
+ * @param blob Gas index state blob.
+ * @return uint32_t Calculated crc32.
+ */
+static inline uint32_t gas_index_state_blob_crc(const gas_index_state_blob_t *const blob) {
+    return esp_rom_crc32_le(0, (const uint8_t *)blob, offsetof(gas_index_state_blob_t, crc));
+}
+
+esp_err_t gas_index_init_batch(GasIndexAlgorithmParams *params, const int32_t *algorithm_types, const float sampling_interval, const size_t instances_count) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && algorithm_types && instances_count > 0 && sampling_interval > 0.0f );
+
+    for(size_t i = 0; i < instances_count; i++) {
+        GasIndexAlgorithm_init_with_sampling_interval(&params[i], algorithm_types[i], sampling_interval);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_process_batch(GasIndexAlgorithmParams *params, const int32_t *sraws, int32_t *gas_indexes, const size_t instances_count) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && sraws && gas_indexes && instances_count > 0 );
+
+    for(size_t i = 0; i < instances_count; i++) {
+        GasIndexAlgorithm_process(&params[i], sraws[i], &gas_indexes[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_export_state(const GasIndexAlgorithmParams *params, gas_index_state_blob_t *const blob) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && blob );
+
+    memset(blob, 0, sizeof(gas_index_state_blob_t));
+
+    blob->magic   = GAS_INDEX_STATE_BLOB_MAGIC;
+    blob->version = GAS_INDEX_STATE_BLOB_VERSION;
+    if(params->mAlgorithm_Type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX)  blob->flags |= GAS_INDEX_STATE_FLAG_NOX;
+    if(params->m_Mean_Variance_Estimator___Initialized == true)          blob->flags |= GAS_INDEX_STATE_FLAG_MVE_INIT;
+    if(params->m_Adaptive_Lowpass___Initialized == true)                 blob->flags |= GAS_INDEX_STATE_FLAG_LOWPASS_INIT;
+
+    blob->sampling_interval             = params->mSamplingInterval;
+    blob->index_offset                  = params->mIndex_Offset;
+    blob->tau_mean_hours                = params->mTau_Mean_Hours;
+    blob->tau_variance_hours            = params->mTau_Variance_Hours;
+    blob->gating_max_duration_minutes   = params->mGating_Max_Duration_Minutes;
+    blob->sraw_std_initial              = params->mSraw_Std_Initial;
+    blob->index_gain                    = params->mIndex_Gain;
+    blob->uptime                        = params->mUptime;
+    blob->sraw                          = params->mSraw;
+    blob->gas_index                     = params->mGas_Index;
+    blob->mve_mean                      = params->m_Mean_Variance_Estimator___Mean;
+    blob->mve_sraw_offset               = params->m_Mean_Variance_Estimator___Sraw_Offset;
+    blob->mve_std                       = params->m_Mean_Variance_Estimator___Std;
+    blob->mve_gamma_mean                = params->m_Mean_Variance_Estimator__Gamma_Mean;
+    blob->mve_gamma_variance            = params->m_Mean_Variance_Estimator__Gamma_Variance;
+    blob->mve_uptime_gamma              = params->m_Mean_Variance_Estimator___Uptime_Gamma;
+    blob->mve_uptime_gating             = params->m_Mean_Variance_Estimator___Uptime_Gating;
+    blob->mve_gating_duration_minutes   = params->m_Mean_Variance_Estimator___Gating_Duration_Minutes;
+    blob->lowpass_x1                    = params->m_Adaptive_Lowpass___X1;
+    blob->lowpass_x2                    = params->m_Adaptive_Lowpass___X2;
+    blob->lowpass_x3                    = params->m_Adaptive_Lowpass___X3;
+
+    blob->crc = gas_index_state_blob_crc(blob);
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_import_state(GasIndexAlgorithmParams *params, const gas_index_state_blob_t *const blob) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && blob );
+
+    /* validate blob */
+    if(blob->magic != GAS_INDEX_STATE_BLOB_MAGIC || blob->version != GAS_INDEX_STATE_BLOB_VERSION) return ESP_ERR_INVALID_VERSION;
+    if(blob->crc != gas_index_state_blob_crc(blob)) return ESP_ERR_INVALID_CRC;
+    ESP_ARG_CHECK( blob->sampling_interval > 0.0f );
+
+    /* re-initialize instance, derived coefficients are recomputed from the tuning */
+    const int32_t algorithm_type = (blob->flags & GAS_INDEX_STATE_FLAG_NOX) ? GasIndexAlgorithm_ALGORITHM_TYPE_NOX : GasIndexAlgorithm_ALGORITHM_TYPE_VOC;
+    GasIndexAlgorithm_init_with_sampling_interval(params, algorithm_type, blob->sampling_interval);
+
+    params->mIndex_Offset                   = blob->index_offset;
+    params->mTau_Mean_Hours                 = blob->tau_mean_hours;
+    params->mTau_Variance_Hours             = blob->tau_variance_hours;
+    params->mGating_Max_Duration_Minutes    = blob->gating_max_duration_minutes;
+    params->mSraw_Std_Initial               = blob->sraw_std_initial;
+    params->mIndex_Gain                     = blob->index_gain;
+    GasIndexAlgorithm_reset(params);
+
+    /* restore dynamic states */
+    params->mUptime                                             = blob->uptime;
+    params->mSraw                                               = blob->sraw;
+    params->mGas_Index                                          = blob->gas_index;
+    params->m_Mean_Variance_Estimator___Initialized             = (blob->flags & GAS_INDEX_STATE_FLAG_MVE_INIT) ? true : false;
+    params->m_Mean_Variance_Estimator___Mean                    = blob->mve_mean;
+    params->m_Mean_Variance_Estimator___Sraw_Offset             = blob->mve_sraw_offset;
+    params->m_Mean_Variance_Estimator___Std                     = blob->mve_std;
+    params->m_Mean_Variance_Estimator__Gamma_Mean               = blob->mve_gamma_mean;
+    params->m_Mean_Variance_Estimator__Gamma_Variance           = blob->mve_gamma_variance;
+    params->m_Mean_Variance_Estimator___Uptime_Gamma            = blob->mve_uptime_gamma;
+    params->m_Mean_Variance_Estimator___Uptime_Gating           = blob->mve_uptime_gating;
+    params->m_Mean_Variance_Estimator___Gating_Duration_Minutes = blob->mve_gating_duration_minutes;
+    params->m_Adaptive_Lowpass___Initialized                    = (blob->flags & GAS_INDEX_STATE_FLAG_LOWPASS_INIT) ? true : false;
+    params->m_Adaptive_Lowpass___X1                             = blob->lowpass_x1;
+    params->m_Adaptive_Lowpass___X2                             = blob->lowpass_x2;
+    params->m_Adaptive_Lowpass___X3                             = blob->lowpass_x3;
+
+    /* mox model tracks the mean-variance estimator */
+    params->m_Mox_Model__Sraw_Std   = params->m_Mean_Variance_Estimator___Std;
+    params->m_Mox_Model__Sraw_Mean  = params->m_Mean_Variance_Estimator___Mean + params->m_Mean_Variance_Estimator___Sraw_Offset;
+
+    return ESP_OK;
+}
@@ -0,0 +1,151 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file gas_index_engine.h
+ * @defgroup gas_index_engine
+ * @{
+ *
+ * ESP-IDF multi-instance gas index engine
+ * 
+ * Batched processing of several Sensirion gas index algorithm instances (i.e.
+ * VOC and NOx instances of one or more SGP4x sensors) per call, and a compact 
+ * versioned learning state blob that can be persisted with `nvs_write_struct`
+ * from `esp_nvs_ext` to warm start the algorithm after a reboot.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __GAS_INDEX_ENGINE_H__
+#define __GAS_INDEX_ENGINE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include "sensirion_gas_index_algorithm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * public constant definitions
+ */
+#define GAS_INDEX_STATE_BLOB_MAGIC          UINT16_C(0x4749)    /*!< "GI" */
+#define GAS_INDEX_STATE_BLOB_VERSION        UINT8_C(1)
+
+#define GAS_INDEX_STATE_FLAG_NOX            UINT8_C(0x01)   /*!< algorithm type is nox, voc otherwise */
+#define GAS_INDEX_STATE_FLAG_MVE_INIT       UINT8_C(0x02)   /*!< mean-variance estimator is initialized */
+#define GAS_INDEX_STATE_FLAG_LOWPASS_INIT   UINT8_C(0x04)   /*!< adaptive lowpass filter is initialized */
+
+/**
+ * @brief Gas index algorithm learning state blob structure.  The blob holds 
+ * the complete dynamic state and tuning of an algorithm instance, importing 
+ * it resumes the instance exactly where it was exported, without the initial 
+ * blackout and learning phase.  Derived coefficients are not stored and are 
+ * recomputed on import.
+ * 
+ * @note Sensirion recommends restoring learned states only when the sensor 
+ * was powered down for less than 10 minutes, it is up to the application to 
+ * discard stale blobs.
+ */
+typedef struct __attribute__((packed)) gas_index_state_blob_s {
+    uint16_t    magic;                      /*!< blob magic, GAS_INDEX_STATE_BLOB_MAGIC */
+    uint8_t     version;                    /*!< blob layout version, GAS_INDEX_STATE_BLOB_VERSION */
+    uint8_t     flags;                      /*!< GAS_INDEX_STATE_FLAG_* bits */
+    float       sampling_interval;          /*!< sampling interval in seconds */
+    float       index_offset;               /*!< tuning: index offset */
+    float       tau_mean_hours;             /*!< tuning: learning time offset in hours */
+    float       tau_variance_hours;         /*!< tuning: learning time gain in hours */
+    float       gating_max_duration_minutes;/*!< tuning: gating maximum duration in minutes */
+    float       sraw_std_initial;           /*!< tuning: initial sraw standard deviation */
+    float       index_gain;                 /*!< tuning: index gain factor */
+    float       uptime;                     /*!< algorithm uptime in seconds (saturates after the initial blackout) */
+    float       sraw;                       /*!< last valid sraw less the sraw minimum */
+    float       gas_index;                  /*!< last unrounded gas index */
+    float       mve_mean;                   /*!< mean-variance estimator mean */
+    float       mve_sraw_offset;            /*!< mean-variance estimator sraw offset */
+    float       mve_std;                    /*!< mean-variance estimator standard deviation */
+    float       mve_gamma_mean;             /*!< mean-variance estimator gated mean gamma */
+    float       mve_gamma_variance;         /*!< mean-variance estimator gated variance gamma */
+    float       mve_uptime_gamma;           /*!< mean-variance estimator gamma uptime in seconds */
+    float       mve_uptime_gating;          /*!< mean-variance estimator gating uptime in seconds */
+    float       mve_gating_duration_minutes;/*!< mean-variance estimator gating duration in minutes */
+    float       lowpass_x1;                 /*!< adaptive lowpass fast state */
+    float       lowpass_x2;                 /*!< adaptive lowpass slow state */
+    float       lowpass_x3;                 /*!< adaptive lowpass output state */
+    uint32_t    crc;                        /*!< crc32 (little endian) of all preceding fields */
+} gas_index_state_blob_t;
+
+/**
+ * @brief Initializes an array of gas index algorithm instances.
+ * 
+ * @param[out] params Array of gas index algorithm instances to initialize.
+ * @param[in] algorithm_types Array of algorithm types (GasIndexAlgorithm_ALGORITHM_TYPE_VOC or _NOX), one per instance.
+ * @param[in] sampling_interval Sampling interval in seconds shared by all instances.
+ * @param[in] instances_count Number of instances.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_init_batch(GasIndexAlgorithmParams *params, const int32_t *algorithm_types, const float sampling_interval, const size_t instances_count);
+
+/**
+ * @brief Processes one raw tick sample per gas index algorithm instance, i.e. 
+ * every VOC and NOx instance of all SGP4x sensors sampled in the same period.
+ * 
+ * @param[in,out] params Array of gas index algorithm instances.
+ * @param[in] sraws Array of raw ticks, one per instance.
+ * @param[out] gas_indexes Array of gas indexes, one per instance.
+ * @param[in] instances_count Number of instances.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_process_batch(GasIndexAlgorithmParams *params, const int32_t *sraws, int32_t *gas_indexes, const size_t instances_count);
+
+/**
+ * @brief Exports the learning state of a gas index algorithm instance to a state blob.
+ * 
+ * @param[in] params Gas index algorithm instance.
+ * @param[out] blob Gas index state blob.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_export_state(const GasIndexAlgorithmParams *params, gas_index_state_blob_t *const blob);
+
+/**
+ * @brief Imports the learning state of a gas index algorithm instance from a 
+ * state blob.  The instance is re-initialized with the algorithm type, sampling 
+ * interval and tuning of the blob, the instance is left untouched when the blob 
+ * is rejected.
+ * 
+ * @param[out] params Gas index algorithm instance.
+ * @param[in] blob Gas index state blob.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_VERSION when the magic or version does not match, ESP_ERR_INVALID_CRC when the blob is corrupted.
+ */
+esp_err_t gas_index_import_state(GasIndexAlgorithmParams *params, const gas_index_state_blob_t *const blob);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __GAS_INDEX_ENGINE_H__
@@ -0,0 +1,590 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file gas_index_fix16.c
+ *
+ * ESP-IDF fixed-point gas index algorithm
+ * 
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+
+#include "gas_index_fix16.h"
+#include "gas_index_engine.h"
+#include <string.h>
+#include <esp_rom_crc.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/* converts a constant to Q16.16, evaluated at compile time */
+#define F16(x)  ((gas_index_fix16_t)(((x) >= 0) ? ((x) * 65536.0 + 0.5) : ((x) * 65536.0 - 0.5)))
+
+/*
+ * fixed-point definitions
+*/
+#define FIX16_ONE               ((gas_index_fix16_t)0x00010000)
+#define FIX16_MAXIMUM           ((gas_index_fix16_t)0x7fffffff)
+#define FIX16_MINIMUM           ((gas_index_fix16_t)0x80000001)
+#define FIX16_EXP_MAX           F16(10.3972)    //!< ln(32767), exp saturates above
+#define FIX16_EXP_MIN           F16(-11.7835)   //!< ln(2^-17), exp is 0 below
+#define FIX16_LOG2_E            F16(1.44269504)
+#define FIX16_Q30_ONE           (INT64_C(1) << 30)
+
+
+/**
+ * @brief Saturates a 64-bit intermediate to the Q16.16 range.
+ */
+static inline gas_index_fix16_t gas_index_fix16_saturate(const int64_t value) {
+    if(value > FIX16_MAXIMUM) return FIX16_MAXIMUM;
+    if(value < FIX16_MINIMUM) return FIX16_MINIMUM;
+    return (gas_index_fix16_t)value;
+}
+
+/**
+ * @brief Adds two Q16.16 numbers with saturation.
+ */
+static inline gas_index_fix16_t gas_index_fix16_add(const gas_index_fix16_t a, const gas_index_fix16_t b) {
+    return gas_index_fix16_saturate((int64_t)a + b);
+}
+
+/**
+ * @brief Multiplies two Q16.16 numbers with rounding and saturation.
+ */
+static inline gas_index_fix16_t gas_index_fix16_mul(const gas_index_fix16_t a, const gas_index_fix16_t b) {
+    const int64_t product = (int64_t)a * b;
+    return gas_index_fix16_saturate((product + 0x8000) >> 16);
+}
+
+/**
+ * @brief Divides two Q16.16 numbers with rounding and saturation, a division by 
+ * zero saturates to the sign of the dividend.
+ */
+static inline gas_index_fix16_t gas_index_fix16_div(const gas_index_fix16_t a, const gas_index_fix16_t b) {
+    if(b == 0) return (a >= 0) ? FIX16_MAXIMUM : FIX16_MINIMUM;
+    int64_t dividend = (int64_t)a * 65536;
+    /* round half away from zero */
+    const int64_t half = (b > 0) ? (b / 2) : (-(int64_t)b / 2);
+    dividend += ((dividend >= 0) == (b > 0)) ? half : -half;
+    return gas_index_fix16_saturate(dividend / b);
+}
+
+/**
+ * @brief Calculates the ratio of two Q16.16 scaled 64-bit values as a Q16.16 number, 
+ * used for the derived coefficients whose operands exceed the Q16.16 range.
+ */
+static inline gas_index_fix16_t gas_index_fix16_ratio(const int64_t numerator, const int64_t denominator) {
+    if(denominator <= 0) return FIX16_MAXIMUM;
+    return gas_index_fix16_saturate((numerator * 65536 + denominator / 2) / denominator);
+}
+
+/**
+ * @brief Calculates the rounded integer square root of a 64-bit number.
+ */
+static inline uint64_t gas_index_fix16_isqrt64(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = UINT64_C(1) << 62;
+    while(bit > value) bit >>= 2;
+    while(bit != 0) {
+        if(value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    /* round to nearest */
+    if(value > result) result++;
+    return result;
+}
+
+/**
+ * @brief Calculates the exponential of a Q16.16 number in Q2.30, exp(x) = 2^(x * log2(e)) 
+ * with the fractional power of two evaluated as a 6th order polynomial, valid for x 
+ * below FIX16_EXP_MAX.
+ */
+static inline int64_t gas_index_fix16_exp_q30(const gas_index_fix16_t x) {
+    /* ln(2)^n / n! in Q2.30 */
+    static const int64_t coefficients[] = { 
+        INT64_C(744261118), INT64_C(257941248), INT64_C(59597083), 
+        INT64_C(10327387), INT64_C(1431680), INT64_C(165394) };
+
+    const int64_t y = ((int64_t)x * FIX16_LOG2_E) >> 16;
+    const int32_t n = (int32_t)(y >> 16);                   // floor
+    const int64_t f = (y & 0xffff) << 14;                   // fraction in Q2.30
+
+    int64_t acc = coefficients[5];
+    for(int i = 4; i >= 0; i--) {
+        acc = coefficients[i] + ((acc * f) >> 30);
+    }
+    acc = FIX16_Q30_ONE + ((acc * f) >> 30);                // 2^f in Q2.30
+
+    if(n >= 0) return acc << n;
+    if(n <= -62) return 0;
+    return (acc + (INT64_C(1) << (-n - 1))) >> -n;
+}
+
+/**
+ * @brief Calculates the exponential of a Q16.16 number, the result saturates at 32767.
+ */
+static inline gas_index_fix16_t gas_index_fix16_exp(const gas_index_fix16_t x) {
+    if(x >= FIX16_EXP_MAX) return FIX16_MAXIMUM;
+    if(x <= FIX16_EXP_MIN) return 0;
+    return (gas_index_fix16_t)((gas_index_fix16_exp_q30(x) + (1 << 13)) >> 14);
+}
+
+/**
+ * @brief Sets the mean-variance estimator sigmoid parameters.
+ */
+static inline void gas_index_fix16_mve_sigmoid_set_parameters(gas_index_fix16_params_t *const params, const gas_index_fix16_t x0, const gas_index_fix16_t k) {
+    params->mve_sigmoid_k  = k;
+    params->mve_sigmoid_x0 = x0;
+}
+
+/**
+ * @brief Evaluates the mean-variance estimator sigmoid in Q2.30, the sigmoid tails 
+ * scale the learning gammas and Q16.16 would truncate them to a few counts.
+ */
+static inline int64_t gas_index_fix16_mve_sigmoid_process(gas_index_fix16_params_t *const params, const gas_index_fix16_t sample) {
+    const gas_index_fix16_t x = gas_index_fix16_mul(params->mve_sigmoid_k, sample - params->mve_sigmoid_x0);
+    if(x < F16(-50.0)) return FIX16_Q30_ONE;
+    if(x > F16(50.0)) return 0;
+    /* 1 / (1 + exp(x)) = exp(-x) / (1 + exp(-x)), the exponential is kept at or below 1 */
+    if(x >= 0) {
+        const int64_t e = gas_index_fix16_exp_q30(-x);
+        return ((e << 30) + (FIX16_Q30_ONE + e) / 2) / (FIX16_Q30_ONE + e);
+    }
+    const int64_t e = gas_index_fix16_exp_q30(x);
+    return ((INT64_C(1) << 60) + (FIX16_Q30_ONE + e) / 2) / (FIX16_Q30_ONE + e);
+}
+
+/**
+ * @brief Multiplies a Q16.16 number by a Q2.30 number with rounding.
+ */
+static inline gas_index_fix16_t gas_index_fix16_mul_q30(const gas_index_fix16_t a, const int64_t b) {
+    return gas_index_fix16_saturate(((int64_t)a * b + (INT64_C(1) << 29)) >> 30);
+}
+
+/**
+ * @brief Initializes the mean-variance estimator and its derived coefficients.
+ */
+static inline void gas_index_fix16_mve_set_parameters(gas_index_fix16_params_t *const params) {
+    const int64_t si = params->sampling_interval;
+    const gas_index_fix16_t tau_initial_mean = (params->algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX) ? 
+        F16(GasIndexAlgorithm_TAU_INITIAL_MEAN_NOX) : F16(GasIndexAlgorithm_TAU_INITIAL_MEAN_VOC);
+
+    params->mve_initialized  = false;
+    params->mve_mean         = 0;
+    params->mve_sraw_offset  = 0;
+    params->mve_std          = params->sraw_std_initial;
+    /* gamma = scaling * (si / 3600) / (tau_hours + si / 3600) = scaling * si / (3600 * tau_hours + si) */
+    params->mve_gamma_mean              = gas_index_fix16_ratio(8 * 64 * si, 3600 * (int64_t)params->tau_mean_hours + si);
+    params->mve_gamma_variance          = gas_index_fix16_ratio(64 * si, 3600 * (int64_t)params->tau_variance_hours + si);
+    params->mve_gamma_initial_mean      = gas_index_fix16_ratio(8 * 64 * si, tau_initial_mean + si);
+    params->mve_gamma_initial_variance  = gas_index_fix16_ratio(64 * si, F16(GasIndexAlgorithm_TAU_INITIAL_VARIANCE) + si);
+    params->mve_gated_gamma_mean        = 0;
+    params->mve_gated_gamma_variance    = 0;
+    params->mve_uptime_gamma            = 0;
+    params->mve_uptime_gating           = 0;
+    params->mve_gating_duration_minutes = 0;
+}
+
+/**
+ * @brief Calculates the gated mean and variance gammas of the mean-variance estimator.
+ */
+static inline void gas_index_fix16_mve_calculate_gamma(gas_index_fix16_params_t *const params) {
+    const gas_index_fix16_t uptime_limit = F16(GasIndexAlgorithm_MEAN_VARIANCE_ESTIMATOR__FIX16_MAX) - params->sampling_interval;
+
+    if(params->mve_uptime_gamma < uptime_limit) {
+        params->mve_uptime_gamma += params->sampling_interval;
+    }
+    if(params->mve_uptime_gating < uptime_limit) {
+        params->mve_uptime_gating += params->sampling_interval;
+    }
+
+    gas_index_fix16_mve_sigmoid_set_parameters(params, params->init_duration_mean, F16(GasIndexAlgorithm_INIT_TRANSITION_MEAN));
+    const int64_t sigmoid_gamma_mean = gas_index_fix16_mve_sigmoid_process(params, params->mve_uptime_gamma);
+    const gas_index_fix16_t gamma_mean = params->mve_gamma_mean + 
+        gas_index_fix16_mul_q30(params->mve_gamma_initial_mean - params->mve_gamma_mean, sigmoid_gamma_mean);
+    const gas_index_fix16_t gating_threshold_mean = params->gating_threshold + 
+        gas_index_fix16_mul_q30(F16(GasIndexAlgorithm_GATING_THRESHOLD_INITIAL) - params->gating_threshold, 
+                                gas_index_fix16_mve_sigmoid_process(params, params->mve_uptime_gating));
+    gas_index_fix16_mve_sigmoid_set_parameters(params, gating_threshold_mean, F16(GasIndexAlgorithm_GATING_THRESHOLD_TRANSITION));
+    const int64_t sigmoid_gating_mean = gas_index_fix16_mve_sigmoid_process(params, params->gas_index);
+    params->mve_gated_gamma_mean = gas_index_fix16_mul_q30(gamma_mean, sigmoid_gating_mean);
+
+    gas_index_fix16_mve_sigmoid_set_parameters(params, params->init_duration_variance, F16(GasIndexAlgorithm_INIT_TRANSITION_VARIANCE));
+    const int64_t sigmoid_gamma_variance = gas_index_fix16_mve_sigmoid_process(params, params->mve_uptime_gamma);
+    const gas_index_fix16_t gamma_variance = params->mve_gamma_variance + 
+        gas_index_fix16_mul_q30(params->mve_gamma_initial_variance - params->mve_gamma_variance, sigmoid_gamma_variance - sigmoid_gamma_mean);
+    const gas_index_fix16_t gating_threshold_variance = params->gating_threshold + 
+        gas_index_fix16_mul_q30(F16(GasIndexAlgorithm_GATING_THRESHOLD_INITIAL) - params->gating_threshold, 
+                                gas_index_fix16_mve_sigmoid_process(params, params->mve_uptime_gating));
+    gas_index_fix16_mve_sigmoid_set_parameters(params, gating_threshold_variance, F16(GasIndexAlgorithm_GATING_THRESHOLD_TRANSITION));
+    const int64_t sigmoid_gating_variance = gas_index_fix16_mve_sigmoid_process(params, params->gas_index);
+    params->mve_gated_gamma_variance = gas_index_fix16_mul_q30(gamma_variance, sigmoid_gating_variance);
+
+    params->mve_gating_duration_minutes += gas_index_fix16_mul(gas_index_fix16_div(params->sampling_interval, F16(60.0)),
+        gas_index_fix16_mul_q30(F16(1.0 + GasIndexAlgorithm_GATING_MAX_RATIO), FIX16_Q30_ONE - sigmoid_gating_mean) - F16(GasIndexAlgorithm_GATING_MAX_RATIO));
+    if(params->mve_gating_duration_minutes < 0) {
+        params->mve_gating_duration_minutes = 0;
+    }
+    if(params->mve_gating_duration_minutes > params->gating_max_duration_minutes) {
+        params->mve_uptime_gating = 0;
+    }
+}
+
+/**
+ * @brief Updates the mean-variance estimator with a sraw sample.
+ */
+static inline void gas_index_fix16_mve_process(gas_index_fix16_params_t *const params, gas_index_fix16_t sraw) {
+    if(params->mve_initialized == false) {
+        params->mve_initialized = true;
+        params->mve_sraw_offset = sraw;
+        params->mve_mean        = 0;
+        return;
+    }
+
+    if(params->mve_mean >= F16(100.0) || params->mve_mean <= F16(-100.0)) {
+        params->mve_sraw_offset += params->mve_mean;
+        params->mve_mean = 0;
+    }
+    sraw -= params->mve_sraw_offset;
+    gas_index_fix16_mve_calculate_gamma(params);
+
+    /* the float reference rescales the variance terms to stay within the Q16.16 range, the terms are 
+       kept in 64 bits instead and the gated variance gamma, a few hundred counts, holds its precision */
+    const gas_index_fix16_t delta_sgp = (sraw - params->mve_mean + 32) >> 6;                     // / gamma scaling
+    const int64_t gamma_delta    = ((int64_t)params->mve_gated_gamma_variance * delta_sgp + 0x80) >> 8;  // Q8.24
+    const int64_t variance_delta = (gamma_delta * delta_sgp + (INT64_C(1) << 23)) >> 24;
+    const int64_t variance_std   = (((int64_t)params->mve_std * params->mve_std + (INT64_C(1) << 15)) >> 16) / 64;
+    int64_t variance = variance_std + variance_delta;
+    if(variance > (INT64_C(1) << 40)) variance = INT64_C(1) << 40;
+    /* std = sqrt((gamma_scaling - gamma_variance) * variance) = 8 * sqrt(variance * (1 - gamma_variance / gamma_scaling)) */
+    variance = (variance * (F16(GasIndexAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING) - params->mve_gated_gamma_variance) + (INT64_C(1) << 21)) >> 22;
+    params->mve_std = gas_index_fix16_saturate(8 * (int64_t)gas_index_fix16_isqrt64((uint64_t)variance << 16));
+
+    /* mean += gamma_mean * (sraw - mean) / (gamma_scaling * additional_gamma_mean_scaling), in one 64-bit product 
+       because the gated gamma is a few counts while gating and the rounded quotients bias the learned mean */
+    const int64_t mean_delta = (int64_t)params->mve_gated_gamma_mean * (sraw - params->mve_mean);
+    params->mve_mean += (gas_index_fix16_t)((mean_delta + (INT64_C(1) << 24)) >> 25);
+}
+
+/**
+ * @brief Evaluates the mox model, the sraw deviation from the learned mean scaled by the index gain.
+ */
+static inline gas_index_fix16_t gas_index_fix16_mox_process(gas_index_fix16_params_t *const params, const gas_index_fix16_t sraw) {
+    if(params->algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX) {
+        return gas_index_fix16_mul(gas_index_fix16_div(sraw - params->mox_sraw_mean, F16(GasIndexAlgorithm_SRAW_STD_NOX)), params->index_gain);
+    }
+    return gas_index_fix16_mul(gas_index_fix16_div(sraw - params->mox_sraw_mean, 
+                               -(params->mox_sraw_std + F16(GasIndexAlgorithm_SRAW_STD_BONUS_VOC))), params->index_gain);
+}
+
+/**
+ * @brief Evaluates the scaled sigmoid that maps the mox model output to the gas index.
+ */
+static inline gas_index_fix16_t gas_index_fix16_sigmoid_scaled_process(gas_index_fix16_params_t *const params, const gas_index_fix16_t sample) {
+    const gas_index_fix16_t x = gas_index_fix16_mul(params->sigmoid_scaled_k, sample - params->sigmoid_scaled_x0);
+    if(x < F16(-50.0)) return F16(GasIndexAlgorithm_SIGMOID_L);
+    if(x > F16(50.0)) return 0;
+
+    const gas_index_fix16_t denominator = gas_index_fix16_add(FIX16_ONE, gas_index_fix16_exp(x));
+    if(sample >= 0) {
+        gas_index_fix16_t shift;
+        if(params->sigmoid_scaled_offset_default == FIX16_ONE) {
+            shift = gas_index_fix16_mul(F16(500.0 / 499.0), FIX16_ONE - params->index_offset);
+        } else {
+            shift = gas_index_fix16_div(F16(GasIndexAlgorithm_SIGMOID_L) - gas_index_fix16_mul(F16(5.0), params->index_offset), F16(4.0));
+        }
+        return gas_index_fix16_div(F16(GasIndexAlgorithm_SIGMOID_L) + shift, denominator) - shift;
+    }
+    return gas_index_fix16_mul(gas_index_fix16_div(params->index_offset, params->sigmoid_scaled_offset_default),
+                               gas_index_fix16_div(F16(GasIndexAlgorithm_SIGMOID_L), denominator));
+}
+
+/**
+ * @brief Evaluates the adaptive lowpass filter of the gas index.
+ */
+static inline gas_index_fix16_t gas_index_fix16_lowpass_process(gas_index_fix16_params_t *const params, const gas_index_fix16_t sample) {
+    if(params->lowpass_initialized == false) {
+        params->lowpass_x1 = sample;
+        params->lowpass_x2 = sample;
+        params->lowpass_x3 = sample;
+        params->lowpass_initialized = true;
+    }
+    params->lowpass_x1 = gas_index_fix16_mul(FIX16_ONE - params->lowpass_a1, params->lowpass_x1) + gas_index_fix16_mul(params->lowpass_a1, sample);
+    params->lowpass_x2 = gas_index_fix16_mul(FIX16_ONE - params->lowpass_a2, params->lowpass_x2) + gas_index_fix16_mul(params->lowpass_a2, sample);
+    gas_index_fix16_t abs_delta = params->lowpass_x1 - params->lowpass_x2;
+    if(abs_delta < 0) abs_delta = -abs_delta;
+    const gas_index_fix16_t f1 = gas_index_fix16_exp(gas_index_fix16_mul(F16(GasIndexAlgorithm_LP_ALPHA), abs_delta));
+    const gas_index_fix16_t tau_a = gas_index_fix16_mul(F16(GasIndexAlgorithm_LP_TAU_SLOW - GasIndexAlgorithm_LP_TAU_FAST), f1) + F16(GasIndexAlgorithm_LP_TAU_FAST);
+    const gas_index_fix16_t a3 = gas_index_fix16_div(params->sampling_interval, params->sampling_interval + tau_a);
+    params->lowpass_x3 = gas_index_fix16_mul(FIX16_ONE - a3, params->lowpass_x3) + gas_index_fix16_mul(a3, sample);
+    return params->lowpass_x3;
+}
+
+/**
+ * @brief Initializes the algorithm stages from the tuning.
+ */
+static inline void gas_index_fix16_init_instances(gas_index_fix16_params_t *const params) {
+    const int64_t si = params->sampling_interval;
+
+    gas_index_fix16_mve_set_parameters(params);
+    params->mox_sraw_std  = params->mve_std;
+    params->mox_sraw_mean = params->mve_mean + params->mve_sraw_offset;
+    if(params->algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX) {
+        params->sigmoid_scaled_k              = F16(GasIndexAlgorithm_SIGMOID_K_NOX);
+        params->sigmoid_scaled_x0             = F16(GasIndexAlgorithm_SIGMOID_X0_NOX);
+        params->sigmoid_scaled_offset_default = F16(GasIndexAlgorithm_NOX_INDEX_OFFSET_DEFAULT);
+    } else {
+        params->sigmoid_scaled_k              = F16(GasIndexAlgorithm_SIGMOID_K_VOC);
+        params->sigmoid_scaled_x0             = F16(GasIndexAlgorithm_SIGMOID_X0_VOC);
+        params->sigmoid_scaled_offset_default = F16(GasIndexAlgorithm_VOC_INDEX_OFFSET_DEFAULT);
+    }
+    params->lowpass_a1          = gas_index_fix16_ratio(si, F16(GasIndexAlgorithm_LP_TAU_FAST) + si);
+    params->lowpass_a2          = gas_index_fix16_ratio(si, F16(GasIndexAlgorithm_LP_TAU_SLOW) + si);
+    params->lowpass_initialized = false;
+}
+
+/**
+ * @brief Calculates the crc32 of a state blob, excluding the crc field.
+ */
+static inline uint32_t gas_index_fix16_state_blob_crc(const gas_index_fix16_state_blob_t *const blob) {
+    return esp_rom_crc32_le(0, (const uint8_t *)blob, offsetof(gas_index_fix16_state_blob_t, crc));
+}
+
+/**
+ * @brief Sets the default tuning of the algorithm type and initializes the algorithm stages.
+ */
+static inline void gas_index_fix16_init_defaults(gas_index_fix16_params_t *const params, const int32_t algorithm_type, const gas_index_fix16_t sampling_interval) {
+    memset(params, 0, sizeof(gas_index_fix16_params_t));
+
+    params->algorithm_type    = algorithm_type;
+    params->sampling_interval = sampling_interval;
+    if(algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX) {
+        params->index_offset                = F16(GasIndexAlgorithm_NOX_INDEX_OFFSET_DEFAULT);
+        params->sraw_minimum                = GasIndexAlgorithm_NOX_SRAW_MINIMUM;
+        params->gating_max_duration_minutes = F16(GasIndexAlgorithm_GATING_NOX_MAX_DURATION_MINUTES);
+        params->init_duration_mean          = F16(GasIndexAlgorithm_INIT_DURATION_MEAN_NOX);
+        params->init_duration_variance      = F16(GasIndexAlgorithm_INIT_DURATION_VARIANCE_NOX);
+        params->gating_threshold            = F16(GasIndexAlgorithm_GATING_THRESHOLD_NOX);
+    } else {
+        params->index_offset                = F16(GasIndexAlgorithm_VOC_INDEX_OFFSET_DEFAULT);
+        params->sraw_minimum                = GasIndexAlgorithm_VOC_SRAW_MINIMUM;
+        params->gating_max_duration_minutes = F16(GasIndexAlgorithm_GATING_VOC_MAX_DURATION_MINUTES);
+        params->init_duration_mean          = F16(GasIndexAlgorithm_INIT_DURATION_MEAN_VOC);
+        params->init_duration_variance      = F16(GasIndexAlgorithm_INIT_DURATION_VARIANCE_VOC);
+        params->gating_threshold            = F16(GasIndexAlgorithm_GATING_THRESHOLD_VOC);
+    }
+    params->index_gain          = F16(GasIndexAlgorithm_INDEX_GAIN);
+    params->tau_mean_hours      = F16(GasIndexAlgorithm_TAU_MEAN_HOURS);
+    params->tau_variance_hours  = F16(GasIndexAlgorithm_TAU_VARIANCE_HOURS);
+    params->sraw_std_initial    = F16(GasIndexAlgorithm_SRAW_STD_INITIAL);
+    gas_index_fix16_init_instances(params);
+}
+
+esp_err_t gas_index_fix16_init(gas_index_fix16_params_t *const params, const int32_t algorithm_type, const float sampling_interval) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && sampling_interval >= 1.0f && sampling_interval <= 32.0f );
+    ESP_ARG_CHECK( algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_VOC || algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX );
+
+    gas_index_fix16_init_defaults(params, algorithm_type, (gas_index_fix16_t)(sampling_interval * 65536.0f + 0.5f));
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_reset(gas_index_fix16_params_t *const params) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params );
+
+    params->uptime    = 0;
+    params->sraw      = 0;
+    params->gas_index = 0;
+    gas_index_fix16_init_instances(params);
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_set_tuning_parameters(gas_index_fix16_params_t *const params, const int32_t index_offset, 
+                                                const int32_t learning_time_offset_hours, const int32_t learning_time_gain_hours,
+                                                const int32_t gating_max_duration_minutes, const int32_t std_initial,
+                                                const int32_t gain_factor) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params );
+    ESP_ARG_CHECK( index_offset >= GasIndexAlgorithm_TUNING_INDEX_OFFSET_MIN && index_offset <= GasIndexAlgorithm_TUNING_INDEX_OFFSET_MAX );
+    ESP_ARG_CHECK( learning_time_offset_hours >= GasIndexAlgorithm_TUNING_LEARNING_TIME_OFFSET_HOURS_MIN && learning_time_offset_hours <= GasIndexAlgorithm_TUNING_LEARNING_TIME_OFFSET_HOURS_MAX );
+    ESP_ARG_CHECK( learning_time_gain_hours >= GasIndexAlgorithm_TUNING_LEARNING_TIME_GAIN_HOURS_MIN && learning_time_gain_hours <= GasIndexAlgorithm_TUNING_LEARNING_TIME_GAIN_HOURS_MAX );
+    ESP_ARG_CHECK( gating_max_duration_minutes >= GasIndexAlgorithm_TUNING_GATING_MAX_DURATION_MINUTES_MIN && gating_max_duration_minutes <= GasIndexAlgorithm_TUNING_GATING_MAX_DURATION_MINUTES_MAX );
+    ESP_ARG_CHECK( std_initial >= GasIndexAlgorithm_TUNING_STD_INITIAL_MIN && std_initial <= GasIndexAlgorithm_TUNING_STD_INITIAL_MAX );
+    ESP_ARG_CHECK( gain_factor >= GasIndexAlgorithm_TUNING_GAIN_FACTOR_MIN && gain_factor <= GasIndexAlgorithm_TUNING_GAIN_FACTOR_MAX );
+
+    params->index_offset                = index_offset * FIX16_ONE;
+    params->tau_mean_hours              = learning_time_offset_hours * FIX16_ONE;
+    params->tau_variance_hours          = learning_time_gain_hours * FIX16_ONE;
+    params->gating_max_duration_minutes = gating_max_duration_minutes * FIX16_ONE;
+    params->sraw_std_initial            = std_initial * FIX16_ONE;
+    params->index_gain                  = gain_factor * FIX16_ONE;
+    gas_index_fix16_init_instances(params);
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_process(gas_index_fix16_params_t *const params, const int32_t sraw, int32_t *const gas_index) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && gas_index );
+
+    if(params->uptime <= F16(GasIndexAlgorithm_INITIAL_BLACKOUT)) {
+        params->uptime += params->sampling_interval;
+    } else {
+        if(sraw > 0 && sraw < 65000) {
+            int32_t ticks = sraw;
+            if(ticks < params->sraw_minimum + 1) {
+                ticks = params->sraw_minimum + 1;
+            } else if(ticks > params->sraw_minimum + 32767) {
+                ticks = params->sraw_minimum + 32767;
+            }
+            params->sraw = (ticks - params->sraw_minimum) * FIX16_ONE;
+        }
+        if(params->algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_VOC || params->mve_initialized) {
+            params->gas_index = gas_index_fix16_mox_process(params, params->sraw);
+            params->gas_index = gas_index_fix16_sigmoid_scaled_process(params, params->gas_index);
+        } else {
+            params->gas_index = params->index_offset;
+        }
+        params->gas_index = gas_index_fix16_lowpass_process(params, params->gas_index);
+        if(params->gas_index < F16(0.5)) {
+            params->gas_index = F16(0.5);
+        }
+        if(params->sraw > 0) {
+            gas_index_fix16_mve_process(params, params->sraw);
+            params->mox_sraw_std  = params->mve_std;
+            params->mox_sraw_mean = params->mve_mean + params->mve_sraw_offset;
+        }
+    }
+
+    *gas_index = (params->gas_index + F16(0.5)) >> 16;
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_process_batch(gas_index_fix16_params_t *params, const int32_t *sraws, int32_t *gas_indexes, const size_t instances_count) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && sraws && gas_indexes && instances_count > 0 );
+
+    for(size_t i = 0; i < instances_count; i++) {
+        gas_index_fix16_process(&params[i], sraws[i], &gas_indexes[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_export_state(const gas_index_fix16_params_t *const params, gas_index_fix16_state_blob_t *const blob) {
+    /* validate arguments */
+    ESP_ARG_CHECK( params && blob );
+
+    memset(blob, 0, sizeof(gas_index_fix16_state_blob_t));
+
+    blob->magic   = GAS_INDEX_FIX16_STATE_BLOB_MAGIC;
+    blob->version = GAS_INDEX_FIX16_STATE_BLOB_VERSION;
+    if(params->algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX) blob->flags |= GAS_INDEX_STATE_FLAG_NOX;
+    if(params->mve_initialized == true)                                 blob->flags |= GAS_INDEX_STATE_FLAG_MVE_INIT;
+    if(params->lowpass_initialized == true)                             blob->flags |= GAS_INDEX_STATE_FLAG_LOWPASS_INIT;
+
+    blob->sampling_interval             = params->sampling_interval;
+    blob->index_offset                  = params->index_offset;
+    blob->tau_mean_hours                = params->tau_mean_hours;
+    blob->tau_variance_hours            = params->tau_variance_hours;
+    blob->gating_max_duration_minutes   = params->gating_max_duration_minutes;
+    blob->sraw_std_initial              = params->sraw_std_initial;
+    blob->index_gain                    = params->index_gain;
+    blob->uptime                        = params->uptime;
+    blob->sraw                          = params->sraw;
+    blob->gas_index                     = params->gas_index;
+    blob->mve_mean                      = params->mve_mean;
+    blob->mve_sraw_offset               = params->mve_sraw_offset;
+    blob->mve_std                       = params->mve_std;
+    blob->mve_uptime_gamma              = params->mve_uptime_gamma;
+    blob->mve_uptime_gating             = params->mve_uptime_gating;
+    blob->mve_gating_duration_minutes   = params->mve_gating_duration_minutes;
+    blob->lowpass_x1                    = params->lowpass_x1;
+    blob->lowpass_x2                    = params->lowpass_x2;
+    blob->lowpass_x3                    = params->lowpass_x3;
+
+    blob->crc = gas_index_fix16_state_blob_crc(blob);
+
+    return ESP_OK;
+}
+
+esp_err_t gas_index_fix16_import_state(gas_index_fix16_params_t *const params, const gas_index_fix16_state_blob_t *const blob) {
+    gas_index_fix16_params_t restored;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( params && blob );
+
+    /* validate blob */
+    if(blob->magic != GAS_INDEX_FIX16_STATE_BLOB_MAGIC || blob->version != GAS_INDEX_FIX16_STATE_BLOB_VERSION) return ESP_ERR_INVALID_VERSION;
+    if(blob->crc != gas_index_fix16_state_blob_crc(blob)) return ESP_ERR_INVALID_CRC;
+    ESP_ARG_CHECK( blob->sampling_interval >= F16(1.0) && blob->sampling_interval <= F16(32.0) );
+
+    /* re-initialize instance, derived coefficients are recomputed from the tuning */
+    const int32_t algorithm_type = (blob->flags & GAS_INDEX_STATE_FLAG_NOX) ? GasIndexAlgorithm_ALGORITHM_TYPE_NOX : GasIndexAlgorithm_ALGORITHM_TYPE_VOC;
+    gas_index_fix16_init_defaults(&restored, algorithm_type, blob->sampling_interval);
+
+    restored.index_offset                   = blob->index_offset;
+    restored.tau_mean_hours                 = blob->tau_mean_hours;
+    restored.tau_variance_hours             = blob->tau_variance_hours;
+    restored.gating_max_duration_minutes    = blob->gating_max_duration_minutes;
+    restored.sraw_std_initial               = blob->sraw_std_initial;
+    restored.index_gain                     = blob->index_gain;
+    gas_index_fix16_init_instances(&restored);
+
+    /* restore dynamic states */
+    restored.uptime                         = blob->uptime;
+    restored.sraw                           = blob->sraw;
+    restored.gas_index                      = blob->gas_index;
+    restored.mve_initialized                = (blob->flags & GAS_INDEX_STATE_FLAG_MVE_INIT) ? true : false;
+    restored.mve_mean                       = blob->mve_mean;
+    restored.mve_sraw_offset                = blob->mve_sraw_offset;
+    restored.mve_std                        = blob->mve_std;
+    restored.mve_uptime_gamma               = blob->mve_uptime_gamma;
+    restored.mve_uptime_gating              = blob->mve_uptime_gating;
+    restored.mve_gating_duration_minutes    = blob->mve_gating_duration_minutes;
+    restored.lowpass_initialized            = (blob->flags & GAS_INDEX_STATE_FLAG_LOWPASS_INIT) ? true : false;
+    restored.lowpass_x1                     = blob->lowpass_x1;
+    restored.lowpass_x2                     = blob->lowpass_x2;
+    restored.lowpass_x3                     = blob->lowpass_x3;
+
+    /* mox model tracks the mean-variance estimator */
+    restored.mox_sraw_std   = restored.mve_std;
+    restored.mox_sraw_mean  = restored.mve_mean + restored.mve_sraw_offset;
+
+    *params = restored;
+
+    return ESP_OK;
+}
@@ -0,0 +1,246 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file gas_index_fix16.h
+ * @defgroup gas_index_fix16
+ * @{
+ *
+ * ESP-IDF fixed-point gas index algorithm
+ * 
+ * Q16.16 fixed-point port of the Sensirion gas index algorithm for targets 
+ * without a floating-point unit (i.e. ESP32-C2, ESP32-C3 and ESP32-C6), the 
+ * ESP32-S3 single-precision FPU runs the float reference faster.  Floating-point 
+ * arithmetic is only used to convert the sampling interval at initialization.
+ * 
+ * The gas index differs from the float reference (`GasIndexAlgorithm_process`) 
+ * by at most 1 index point and by less than 0.1 index point on average, VOC and 
+ * NOx, over 3 days of 1 second samples with drift and events, see 
+ * `test/host/test_gas_index_fix16.c`.  The learning gammas and sigmoid tails are 
+ * evaluated in Q2.30 and the variance in 64 bits, Q16.16 alone would bias the 
+ * learned mean and standard deviation.
+ * 
+ * The learning state is exported to a Q16.16 state blob, the counterpart of 
+ * the float `gas_index_state_blob_t` of `gas_index_engine.h`, so an instance 
+ * resumes after a reboot without relearning.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __GAS_INDEX_FIX16_H__
+#define __GAS_INDEX_FIX16_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include "sensirion_gas_index_algorithm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Q16.16 fixed-point number definition.
+ */
+typedef int32_t gas_index_fix16_t;
+
+/**
+ * @brief Fixed-point gas index algorithm instance structure, the fields follow 
+ * `GasIndexAlgorithmParams`.
+ */
+typedef struct gas_index_fix16_params_s {
+    int32_t             algorithm_type;                 /*!< GasIndexAlgorithm_ALGORITHM_TYPE_VOC or _NOX */
+    gas_index_fix16_t   sampling_interval;              /*!< sampling interval in seconds */
+    gas_index_fix16_t   index_offset;                   /*!< tuning: index offset */
+    int32_t             sraw_minimum;                   /*!< sraw minimum in ticks */
+    gas_index_fix16_t   gating_max_duration_minutes;    /*!< tuning: gating maximum duration in minutes */
+    gas_index_fix16_t   init_duration_mean;             /*!< initial mean learning duration in seconds */
+    gas_index_fix16_t   init_duration_variance;         /*!< initial variance learning duration in seconds */
+    gas_index_fix16_t   gating_threshold;               /*!< gating threshold */
+    gas_index_fix16_t   index_gain;                     /*!< tuning: index gain factor */
+    gas_index_fix16_t   tau_mean_hours;                 /*!< tuning: learning time offset in hours */
+    gas_index_fix16_t   tau_variance_hours;             /*!< tuning: learning time gain in hours */
+    gas_index_fix16_t   sraw_std_initial;               /*!< tuning: initial sraw standard deviation */
+    gas_index_fix16_t   uptime;                         /*!< algorithm uptime in seconds (saturates after the initial blackout) */
+    gas_index_fix16_t   sraw;                           /*!< last valid sraw less the sraw minimum */
+    gas_index_fix16_t   gas_index;                      /*!< last unrounded gas index */
+    bool                mve_initialized;                /*!< mean-variance estimator is initialized */
+    gas_index_fix16_t   mve_mean;                       /*!< mean-variance estimator mean */
+    gas_index_fix16_t   mve_sraw_offset;                /*!< mean-variance estimator sraw offset */
+    gas_index_fix16_t   mve_std;                        /*!< mean-variance estimator standard deviation */
+    gas_index_fix16_t   mve_gamma_mean;                 /*!< mean-variance estimator mean gamma */
+    gas_index_fix16_t   mve_gamma_variance;             /*!< mean-variance estimator variance gamma */
+    gas_index_fix16_t   mve_gamma_initial_mean;         /*!< mean-variance estimator initial mean gamma */
+    gas_index_fix16_t   mve_gamma_initial_variance;     /*!< mean-variance estimator initial variance gamma */
+    gas_index_fix16_t   mve_gated_gamma_mean;           /*!< mean-variance estimator gated mean gamma */
+    gas_index_fix16_t   mve_gated_gamma_variance;       /*!< mean-variance estimator gated variance gamma */
+    gas_index_fix16_t   mve_uptime_gamma;               /*!< mean-variance estimator gamma uptime in seconds */
+    gas_index_fix16_t   mve_uptime_gating;              /*!< mean-variance estimator gating uptime in seconds */
+    gas_index_fix16_t   mve_gating_duration_minutes;    /*!< mean-variance estimator gating duration in minutes */
+    gas_index_fix16_t   mve_sigmoid_k;                  /*!< mean-variance estimator sigmoid slope */
+    gas_index_fix16_t   mve_sigmoid_x0;                 /*!< mean-variance estimator sigmoid midpoint */
+    gas_index_fix16_t   mox_sraw_std;                   /*!< mox model sraw standard deviation */
+    gas_index_fix16_t   mox_sraw_mean;                  /*!< mox model sraw mean */
+    gas_index_fix16_t   sigmoid_scaled_k;               /*!< scaled sigmoid slope */
+    gas_index_fix16_t   sigmoid_scaled_x0;              /*!< scaled sigmoid midpoint */
+    gas_index_fix16_t   sigmoid_scaled_offset_default;  /*!< scaled sigmoid default index offset */
+    gas_index_fix16_t   lowpass_a1;                     /*!< adaptive lowpass fast coefficient */
+    gas_index_fix16_t   lowpass_a2;                     /*!< adaptive lowpass slow coefficient */
+    bool                lowpass_initialized;            /*!< adaptive lowpass is initialized */
+    gas_index_fix16_t   lowpass_x1;                     /*!< adaptive lowpass fast state */
+    gas_index_fix16_t   lowpass_x2;                     /*!< adaptive lowpass slow state */
+    gas_index_fix16_t   lowpass_x3;                     /*!< adaptive lowpass output state */
+} gas_index_fix16_params_t;
+
+/**
+ * public constant definitions
+ */
+#define GAS_INDEX_FIX16_STATE_BLOB_MAGIC    UINT16_C(0x4746)    /*!< "GF" */
+#define GAS_INDEX_FIX16_STATE_BLOB_VERSION  UINT8_C(1)
+
+/**
+ * @brief Fixed-point gas index algorithm learning state blob structure, the 
+ * Q16.16 counterpart of `gas_index_state_blob_t` with the same flags.  The 
+ * blob holds the complete dynamic state and tuning of an instance, importing 
+ * it resumes the instance exactly where it was exported, without the initial 
+ * blackout and the 12 hour learning phase.  Derived coefficients are not 
+ * stored and are recomputed on import.
+ * 
+ * @note Sensirion recommends restoring learned states only when the sensor 
+ * was powered down for less than 10 minutes, it is up to the application to 
+ * discard stale blobs.
+ */
+typedef struct __attribute__((packed)) gas_index_fix16_state_blob_s {
+    uint16_t            magic;                          /*!< blob magic, GAS_INDEX_FIX16_STATE_BLOB_MAGIC */
+    uint8_t             version;                        /*!< blob layout version, GAS_INDEX_FIX16_STATE_BLOB_VERSION */
+    uint8_t             flags;                          /*!< GAS_INDEX_STATE_FLAG_* bits of `gas_index_engine.h` */
+    gas_index_fix16_t   sampling_interval;              /*!< sampling interval in seconds */
+    gas_index_fix16_t   index_offset;                   /*!< tuning: index offset */
+    gas_index_fix16_t   tau_mean_hours;                 /*!< tuning: learning time offset in hours */
+    gas_index_fix16_t   tau_variance_hours;             /*!< tuning: learning time gain in hours */
+    gas_index_fix16_t   gating_max_duration_minutes;    /*!< tuning: gating maximum duration in minutes */
+    gas_index_fix16_t   sraw_std_initial;               /*!< tuning: initial sraw standard deviation */
+    gas_index_fix16_t   index_gain;                     /*!< tuning: index gain factor */
+    gas_index_fix16_t   uptime;                         /*!< algorithm uptime in seconds (saturates after the initial blackout) */
+    gas_index_fix16_t   sraw;                           /*!< last valid sraw less the sraw minimum */
+    gas_index_fix16_t   gas_index;                      /*!< last unrounded gas index */
+    gas_index_fix16_t   mve_mean;                       /*!< mean-variance estimator mean */
+    gas_index_fix16_t   mve_sraw_offset;                /*!< mean-variance estimator sraw offset */
+    gas_index_fix16_t   mve_std;                        /*!< mean-variance estimator standard deviation */
+    gas_index_fix16_t   mve_uptime_gamma;               /*!< mean-variance estimator gamma uptime in seconds */
+    gas_index_fix16_t   mve_uptime_gating;              /*!< mean-variance estimator gating uptime in seconds */
+    gas_index_fix16_t   mve_gating_duration_minutes;    /*!< mean-variance estimator gating duration in minutes */
+    gas_index_fix16_t   lowpass_x1;                     /*!< adaptive lowpass fast state */
+    gas_index_fix16_t   lowpass_x2;                     /*!< adaptive lowpass slow state */
+    gas_index_fix16_t   lowpass_x3;                     /*!< adaptive lowpass output state */
+    uint32_t            crc;                            /*!< crc32 (little endian) of all preceding fields */
+} gas_index_fix16_state_blob_t;
+
+/**
+ * @brief Initializes a fixed-point gas index algorithm instance.
+ * 
+ * @param[out] params Fixed-point gas index algorithm instance.
+ * @param[in] algorithm_type Algorithm type, GasIndexAlgorithm_ALGORITHM_TYPE_VOC or _NOX.
+ * @param[in] sampling_interval Sampling interval in seconds, 1 to 32 seconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_init(gas_index_fix16_params_t *const params, const int32_t algorithm_type, const float sampling_interval);
+
+/**
+ * @brief Resets the learned states of a fixed-point gas index algorithm instance, 
+ * the tuning is kept.
+ * 
+ * @param[in,out] params Fixed-point gas index algorithm instance.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_reset(gas_index_fix16_params_t *const params);
+
+/**
+ * @brief Sets the tuning parameters of a fixed-point gas index algorithm instance 
+ * and resets the learned states, see `GasIndexAlgorithm_set_tuning_parameters`.
+ * 
+ * @param[in,out] params Fixed-point gas index algorithm instance.
+ * @param[in] index_offset Gas index representing typical conditions.
+ * @param[in] learning_time_offset_hours Time constant of the offset learning in hours.
+ * @param[in] learning_time_gain_hours Time constant of the gain learning in hours.
+ * @param[in] gating_max_duration_minutes Maximum duration of gating in minutes.
+ * @param[in] std_initial Initial estimate of the standard deviation.
+ * @param[in] gain_factor Gain factor of the gas index.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_set_tuning_parameters(gas_index_fix16_params_t *const params, const int32_t index_offset, 
+                                                const int32_t learning_time_offset_hours, const int32_t learning_time_gain_hours,
+                                                const int32_t gating_max_duration_minutes, const int32_t std_initial,
+                                                const int32_t gain_factor);
+
+/**
+ * @brief Processes a raw tick sample, see `GasIndexAlgorithm_process`.
+ * 
+ * @param[in,out] params Fixed-point gas index algorithm instance.
+ * @param[in] sraw Raw ticks, a value outside 1 to 64999 holds the last sample.
+ * @param[out] gas_index Gas index, 0 during the initial blackout.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_process(gas_index_fix16_params_t *const params, const int32_t sraw, int32_t *const gas_index);
+
+/**
+ * @brief Processes one raw tick sample per fixed-point gas index algorithm instance.
+ * 
+ * @param[in,out] params Array of fixed-point gas index algorithm instances.
+ * @param[in] sraws Array of raw ticks, one per instance.
+ * @param[out] gas_indexes Array of gas indexes, one per instance.
+ * @param[in] instances_count Number of instances.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_process_batch(gas_index_fix16_params_t *params, const int32_t *sraws, int32_t *gas_indexes, const size_t instances_count);
+
+/**
+ * @brief Exports the learning state of a fixed-point gas index algorithm instance to a state blob.
+ * 
+ * @param[in] params Fixed-point gas index algorithm instance.
+ * @param[out] blob Fixed-point gas index state blob.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t gas_index_fix16_export_state(const gas_index_fix16_params_t *const params, gas_index_fix16_state_blob_t *const blob);
+
+/**
+ * @brief Imports the learning state of a fixed-point gas index algorithm instance 
+ * from a state blob.  The instance is re-initialized with the algorithm type, sampling 
+ * interval and tuning of the blob, the instance is left untouched when the blob is 
+ * rejected.  The import is integer only.
+ * 
+ * @param[out] params Fixed-point gas index algorithm instance.
+ * @param[in] blob Fixed-point gas index state blob.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_VERSION when the magic or version does not match, ESP_ERR_INVALID_CRC when the blob is corrupted.
+ */
+esp_err_t gas_index_fix16_import_state(gas_index_fix16_params_t *const params, const gas_index_fix16_state_blob_t *const blob);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __GAS_INDEX_FIX16_H__
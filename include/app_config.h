@@ -62,6 +62,7 @@ extern "C" {
 #define OWB0_MASTER_DQ_IO              GPIO_NUM_47
 
 #define OWB0_TASK_SAMPLING_RATE        (10) // seconds
+#define OWB0_TASK_DETECT_RATE          (3600) // seconds, full rom search for ds18b20 devices added to the bus
 #define OWB0_TASK_STACK_SIZE           (TSK_MINIMAL_STACK_SIZE * 8)
 #define OWB0_TASK_PRIORITY             (tskIDLE_PRIORITY + 2)
 
@@ -94,7 +95,12 @@ extern "C" {
         .glitch_ignore_cnt              = 7,                        \
         .flags.enable_internal_pullup   = true, }
 
-#define OW0_RMT_CONFIG_DEFAULT { .max_rx_bytes = 10 } // 1-byte ROM command + 8-byte ROM number + 1-byte device command
+// max_rx_bytes is sized to the largest ds18b20 transaction, a scratchpad read: 1-byte ROM command + 8-byte ROM number +
+// 1-byte device command + 9-byte scratchpad.  The transaction buffers are (19 * 8 + 4) + (19 * 8 + 1) RMT symbols, 1236 bytes
+// of heap.  On the ESP32-S3 the RX channel uses one 48-symbol memory block (ping-pong), on the ESP32 and ESP32-S2 the RX
+// channel reserves the whole 156 symbols, 3 of the 64-symbol memory blocks (192 symbols).  A smaller value (e.g. 10) frees
+// RMT memory blocks, transactions larger than max_rx_bytes are split into a reset, a write and a read at similar bus time.
+#define OW0_RMT_CONFIG_DEFAULT { .max_rx_bytes = 19 }
 
 #define OW0_MASTER_CONFIG_DEFAULT { .bus_gpio_num = OWB0_MASTER_DQ_IO }
 
@@ -36,47 +36,60 @@
 
 
 
+/**
+ * @brief Detects the ds18b20 devices on the 1-wire bus, the rom ids are cached in nvs.  A full
+ * rom search clears the cache first, the cached detection only verifies the cached devices and
+ * does not find devices added to the bus.
+ */
+static inline uint8_t owb0_ds18b20_detect(onewire_device_t *const devs, const uint8_t devs_size, const bool full_search) {
+    uint8_t devs_count = 0;
+
+    /* clear the rom id cache, the detection searches the 1-wire bus */
+    if(full_search == true) {
+        esp_err_t ret = ds18b20_clear_detect_cache("owb0");
+        if(ret != ESP_OK) {
+            ESP_LOGW(APP_TAG, "ds18b20 detect cache clear failed (%s)", esp_err_to_name(ret));
+        }
+    }
+
+    /* detect ds18b20 devices on 1-wire bus */
+    esp_err_t ret = ds18b20_detect_cached(owb0_bus_hdl, "owb0", devs, devs_size, &devs_count);
+    if(ret == ESP_OK) {
+        ESP_LOGW(APP_TAG, "ds18b20 devices detected: %u", devs_count);
+        for(uint8_t i = 0; i < devs_count; i++) {
+            ESP_LOGI(APP_TAG, "ds18b20(%u), address: %016llX", i, devs[i].address);
+        }
+    } else {
+        ESP_LOGE(APP_TAG, "ds18b20 device detect failed (%s)", esp_err_to_name(ret));
+    }
+
+    return devs_count;
+}
+
 void owb0_ds18b20_task( void *pvParameters ) {
     // initialize the xLastWakeTime variable with the current time.
     TickType_t                   last_wake_time = xTaskGetTickCount ();
     //
     // initialize owb device configuration
     ds18b20_config_t             dev_cfg = DS18B20_CONFIG_DEFAULT;
-    ds18b20_handle_t             dev_hdl;
-    onewire_device_iter_handle_t dev_iter_hdl;
-    onewire_device_t             dev;
+    ds18b20_handle_t             dev_hdl = NULL;
     // owb ds18b20 device detection
     onewire_device_t             devs[5];
     uint8_t                      devs_size = sizeof(devs) / sizeof(devs[0]);
     uint8_t                      devs_count = 0;
+    uint32_t                     detect_samples = 0;
     
-    /* detect ds18b20 devices on 1-wire bus */
-    esp_err_t ret = ds18b20_detect(owb0_bus_hdl, devs, devs_size, &devs_count);
-    if(ret == ESP_OK) {
-        ESP_LOGW(APP_TAG, "ds18b20 devices detected: %u", devs_count);
-        for(uint8_t i = 0; i < devs_count; i++) {
-            ESP_LOGI(APP_TAG, "ds18b20(%u), address: %016llX", i, devs[i].address);
-        }
-    } else {
-        ESP_LOGE(APP_TAG, "ds18b20 device detect failed (%s)", esp_err_to_name(ret));
-    }
-    
-    /* instantiate 1-wire device iterator handle */
-    ESP_ERROR_CHECK( onewire_new_device_iter(owb0_bus_hdl, &dev_iter_hdl) );
+    /* detect ds18b20 devices on 1-wire bus, the cached rom ids avoid a rom search at boot */
+    devs_count = owb0_ds18b20_detect(devs, devs_size, false);
     
-    /* get 1-wire device - assumes there is only one ds18b20 device on the bus */
-    if (onewire_device_iter_get_next(dev_iter_hdl, &dev) == ESP_OK) { // found a new device, let's check if we can upgrade it to a DS18B20
-        // check if the device is a ds18b20, if so, return the ds18b20 handle
-        if (ds18b20_init(&dev, &dev_cfg, &dev_hdl) == ESP_OK) {
-            ESP_LOGI(APP_TAG, "found a ds18b20, address: %016llX", dev.address);
+    /* init the first detected ds18b20 device */
+    if(devs_count > 0) {
+        if (ds18b20_init(&devs[0], &dev_cfg, &dev_hdl) == ESP_OK) {
+            ESP_LOGI(APP_TAG, "found a ds18b20, address: %016llX", devs[0].address);
         } else {
-            ESP_LOGI(APP_TAG, "found an unknown device, address: %016llX", dev.address);
-            assert(dev.address);
+            ESP_LOGI(APP_TAG, "found an unknown device, address: %016llX", devs[0].address);
         }
     }
-
-    /* free device iter handle */
-    ESP_ERROR_CHECK( onewire_del_device_iter(dev_iter_hdl) );
     
     // validate device handle
     if(dev_hdl == NULL) {
@@ -96,6 +109,16 @@ void owb0_ds18b20_task( void *pvParameters ) {
         } else {
             ESP_LOGI(APP_TAG, "temperature:     %.2f°C", temperature);
         }
+        
+        /* periodic full rom search, finds ds18b20 devices added to the bus since the rom ids were cached */
+        if(++detect_samples >= OWB0_TASK_DETECT_RATE / OWB0_TASK_SAMPLING_RATE) {
+            const uint8_t prev_devs_count = devs_count;
+            detect_samples = 0;
+            devs_count = owb0_ds18b20_detect(devs, devs_size, true);
+            if(devs_count != prev_devs_count) {
+                ESP_LOGW(APP_TAG, "ds18b20 device count changed: %u -> %u", prev_devs_count, devs_count);
+            }
+        }
         //
         ESP_LOGI(APP_TAG, "######################## DS18B20 - END ###########################");
         //
@@ -73,6 +73,7 @@
 
 /* components */
 //#include <i2c_master_ext.h>
+#include <i2c_discovery.h>
 #include <nvs_ext.h>
 
 /* i2c component tasks */
@@ -182,6 +183,7 @@ typedef enum sch_components_tag {
 // initialize master i2c 0 bus configuration
 i2c_master_bus_config_t  i2c0_bus_cfg = I2C0_MASTER_CONFIG_DEFAULT;
 i2c_master_bus_handle_t  i2c0_bus_hdl;
+i2c_discovery_result_t   i2c0_discovery;
 bool                     i2c0_component_tasked = false;
 
 // initialize master owb 0 bus configuration
@@ -198,36 +200,6 @@ bool                     spi1_component_tasked = false;
 bool                     sch_component_tasked = false;
 bool                     utils_component_tasked = false;
 
-esp_err_t i2c_master_bus_detect_devices(i2c_master_bus_handle_t handle) {
-    const uint16_t probe_timeout_ms = 50; // timeout in milliseconds
-    uint8_t address;
-
-    printf("     0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f\r\n");
-
-    for (int i = 0; i < 128; i += 16) {
-        printf("%02x: ", i);
-
-        for (int j = 0; j < 16; j++) {
-            fflush(stdout);
-            
-            address = i + j;
-
-            esp_err_t ret = i2c_master_probe(handle, address, probe_timeout_ms);
-
-            if (ret == ESP_OK) {
-                printf("%02x ", address);
-            } else if (ret == ESP_ERR_TIMEOUT) {
-                printf("UU ");
-            } else {
-                printf("-- ");
-            }
-        }
-        printf("\r\n");
-    }
-
-    return ESP_OK; 
-}
-
 /**
  * @brief Creates a task pinned to the application core (1) by task function
  * and task name to run an schedule component example.
@@ -543,11 +515,58 @@ static inline void i2c0_component_example_start(const i2c_components_t component
 
 
 /**
- * @brief Scans I2C master bus 0 for i2c devices and prints each device address when detected.
+ * @brief Scans I2C master bus 0 for i2c devices, identifies the devices by chip identifier 
+ * or address, and prints the address map and device table.
  */
 static inline esp_err_t i2c0_device_scan(void) {
+    const i2c_discovery_config_t discovery_cfg = I2C_DISCOVERY_CONFIG_DEFAULT;
+    esp_err_t ret;
+
     ESP_LOGI(APP_TAG, "Scanning I2C master bus 0 for I2C devices..");
-    return i2c_master_bus_detect_devices(i2c0_bus_hdl);
+    ret = i2c_discovery_scan(i2c0_bus_hdl, &discovery_cfg, &i2c0_discovery);
+    i2c_discovery_print(&i2c0_discovery);
+    return ret;
+}
+
+/**
+ * @brief Starts the component example of the first device identified on I2C master bus 0
+ * by `i2c0_device_scan`.
+ */
+static inline void i2c0_component_example_discover(void) {
+    for (uint8_t i = 0; i < i2c0_discovery.device_count; i++) {
+        switch (i2c0_discovery.devices[i].type) {
+            case I2C_DISCOVERY_DEVICE_AHTXX:    i2c0_component_example_start(I2C_COMPONENT_AHTXX);    return;
+            case I2C_DISCOVERY_DEVICE_AK8975:   i2c0_component_example_start(I2C_COMPONENT_AK8975);   return;
+            case I2C_DISCOVERY_DEVICE_AS3935:   i2c0_component_example_start(I2C_COMPONENT_AS3935);   return;
+            case I2C_DISCOVERY_DEVICE_AS7341:   i2c0_component_example_start(I2C_COMPONENT_AS7341);   return;
+            case I2C_DISCOVERY_DEVICE_AT24CXXX: i2c0_component_example_start(I2C_COMPONENT_AT24CXXX); return;
+            case I2C_DISCOVERY_DEVICE_BH1750:   i2c0_component_example_start(I2C_COMPONENT_BH1750);   return;
+            case I2C_DISCOVERY_DEVICE_BME680:   i2c0_component_example_start(I2C_COMPONENT_BME680);   return;
+            case I2C_DISCOVERY_DEVICE_BMP280:   i2c0_component_example_start(I2C_COMPONENT_BMP280);   return;
+            case I2C_DISCOVERY_DEVICE_BMP390:   i2c0_component_example_start(I2C_COMPONENT_BMP390);   return;
+            case I2C_DISCOVERY_DEVICE_CCS811:   i2c0_component_example_start(I2C_COMPONENT_CCS811);   return;
+            case I2C_DISCOVERY_DEVICE_ENS160:   i2c0_component_example_start(I2C_COMPONENT_ENS160);   return;
+            case I2C_DISCOVERY_DEVICE_HDC1080:  i2c0_component_example_start(I2C_COMPONENT_HDC1080);  return;
+            case I2C_DISCOVERY_DEVICE_HMC5883L: i2c0_component_example_start(I2C_COMPONENT_HMC5883L); return;
+            case I2C_DISCOVERY_DEVICE_INA226:   i2c0_component_example_start(I2C_COMPONENT_INA226);   return;
+            case I2C_DISCOVERY_DEVICE_INA228:   i2c0_component_example_start(I2C_COMPONENT_INA228);   return;
+            case I2C_DISCOVERY_DEVICE_LTR390UV: i2c0_component_example_start(I2C_COMPONENT_LTR390UV); return;
+            case I2C_DISCOVERY_DEVICE_MAX30105: i2c0_component_example_start(I2C_COMPONENT_MAX30105); return;
+            case I2C_DISCOVERY_DEVICE_MLX90614: i2c0_component_example_start(I2C_COMPONENT_MLX90614); return;
+            case I2C_DISCOVERY_DEVICE_MMC56X3:  i2c0_component_example_start(I2C_COMPONENT_MMC56X3);  return;
+            case I2C_DISCOVERY_DEVICE_MPU6050:  i2c0_component_example_start(I2C_COMPONENT_MPU6050);  return;
+            case I2C_DISCOVERY_DEVICE_PCT2075:  i2c0_component_example_start(I2C_COMPONENT_PCT2075);  return;
+            case I2C_DISCOVERY_DEVICE_SGP4X:    i2c0_component_example_start(I2C_COMPONENT_SGP4X);    return;
+            case I2C_DISCOVERY_DEVICE_SHT4X:    i2c0_component_example_start(I2C_COMPONENT_SHT4X);    return;
+            case I2C_DISCOVERY_DEVICE_SSD1306:  i2c0_component_example_start(I2C_COMPONENT_SSD1306);  return;
+            case I2C_DISCOVERY_DEVICE_TCS3472:  i2c0_component_example_start(I2C_COMPONENT_TCS3472);  return;
+            case I2C_DISCOVERY_DEVICE_TLV493D:  i2c0_component_example_start(I2C_COMPONENT_TLV493D);  return;
+            case I2C_DISCOVERY_DEVICE_VEML6040: i2c0_component_example_start(I2C_COMPONENT_VEML6040); return;
+            case I2C_DISCOVERY_DEVICE_VEML7700: i2c0_component_example_start(I2C_COMPONENT_VEML7700); return;
+            default: break;
+        }
+    }
+    ESP_LOGW(APP_TAG, "No I2C device with a component example identified on I2C master bus 0");
 }
 
 /**
@@ -610,6 +629,7 @@ void app_main( void ) {
     //i2c0_component_example_start(I2C_COMPONENT_TLV493D);
     //i2c0_component_example_start(I2C_COMPONENT_VEML6040);
     //i2c0_component_example_start(I2C_COMPONENT_VEML7700);
+    //i2c0_component_example_discover();  /* requires i2c0_device_scan */
 
     //owb0_component_example_start(OWB_COMPONENT_DS18B20);
 
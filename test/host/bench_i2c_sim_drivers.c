@@ -0,0 +1,225 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_i2c_sim_drivers.c
+ *
+ * Driver benchmark on the I2C bus simulator, the steady state bus cost of a
+ * measurement read is reported per driver and checked against a regression
+ * bound, a driver change that adds transactions or bus time fails the test
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <bmp280.h>
+#include <bmp390.h>
+#include <sht4x.h>
+#include <ahtxx.h>
+#include <ina228.h>
+#include <mpu6050.h>
+#include <ssd1306.h>
+#include "host_test.h"
+
+#define BENCH_READS         (100)
+
+/**
+ * @brief Regression bound of a measurement read, the bounds are the figures
+ * measured when the benchmark was added.
+ */
+typedef struct bench_bound_s {
+    const char *name;
+    float       transactions;   /*!< transactions per read */
+    uint32_t    bus_time_us;    /*!< simulated bus time per read */
+    uint32_t    elapsed_us;     /*!< virtual time per read, bus time and task delays */
+} bench_bound_t;
+
+static i2c_master_bus_handle_t bench_bus_handle;
+static int64_t bench_start_us;
+
+static void bench_setup(const uint16_t address, i2c_sim_model_t *const model) {
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bench_bus_handle) );
+}
+
+static void bench_start(void) {
+    i2c_sim_reset_stats();
+    bench_start_us = i2c_sim_get_time_us();
+}
+
+static void bench_report(const bench_bound_t *const bound) {
+    i2c_sim_stats_t stats;
+    i2c_sim_get_stats(&stats);
+    const double transactions = (double)stats.transactions / BENCH_READS;
+    const double bus_time_us  = (double)stats.bus_time_us / BENCH_READS;
+    const double elapsed_us   = (double)(i2c_sim_get_time_us() - bench_start_us) / BENCH_READS;
+    printf("%-8s %6.2f tx/read %8.1f bus us/read %10.1f us/read\n", bound->name, transactions, bus_time_us, elapsed_us);
+    HOST_TEST_ASSERT(stats.nacks == 0);
+    HOST_TEST_ASSERT(transactions <= bound->transactions + 0.005);
+    HOST_TEST_ASSERT(bus_time_us <= bound->bus_time_us);
+    HOST_TEST_ASSERT(elapsed_us <= bound->elapsed_us);
+}
+
+static void bench_bmp280(const bench_bound_t *const bound) {
+    bmp280_config_t dev_config = BMP280_CONFIG_DEFAULT;
+    bmp280_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    float temperature, pressure;
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( bmp280_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( bmp280_get_measurements(dev_handle, &temperature, &pressure) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( bmp280_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_bmp390(const bench_bound_t *const bound) {
+    bmp390_config_t dev_config = BMP390_CONFIG_DEFAULT;
+    bmp390_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    float temperature, pressure;
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( bmp390_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( bmp390_get_measurements(dev_handle, &temperature, &pressure) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( bmp390_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_sht4x(const bench_bound_t *const bound) {
+    sht4x_config_t dev_config = I2C_SHT4X_CONFIG_DEFAULT;
+    sht4x_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    float temperature, humidity, dewpoint;
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( sht4x_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( sht4x_get_measurements(dev_handle, &temperature, &humidity, &dewpoint) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( sht4x_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_ahtxx(const bench_bound_t *const bound) {
+    ahtxx_config_t dev_config = AHT20_CONFIG_DEFAULT;
+    ahtxx_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    float temperature, humidity, dewpoint;
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( ahtxx_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( ahtxx_get_measurements(dev_handle, &temperature, &humidity, &dewpoint) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( ahtxx_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_ina228(const bench_bound_t *const bound) {
+    ina228_config_t dev_config = INA228_CONFIG_DEFAULT;
+    ina228_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    float current;
+    HOST_TEST_ESP_OK( i2c_sim_ina228_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( ina228_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( ina228_get_current(dev_handle, &current) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( ina228_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_mpu6050(const bench_bound_t *const bound) {
+    mpu6050_config_t dev_config = I2C_MPU6050_CONFIG_DEFAULT;
+    mpu6050_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    mpu6050_gyro_data_axes_t gyro_data;
+    mpu6050_accel_data_axes_t accel_data;
+    float temperature;
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_create(&model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( mpu6050_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( mpu6050_get_motion(dev_handle, &gyro_data, &accel_data, &temperature) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( mpu6050_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+static void bench_ssd1306(const bench_bound_t *const bound) {
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    ssd1306_handle_t dev_handle = NULL;
+    i2c_sim_model_t *model;
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &model) );
+    bench_setup(dev_config.i2c_address, model);
+    HOST_TEST_ESP_OK( ssd1306_init(bench_bus_handle, &dev_config, &dev_handle) );
+    bench_start();
+    for(int i = 0; i < BENCH_READS; i++) {
+        HOST_TEST_ESP_OK( ssd1306_display_text(dev_handle, i % 8, "benchmark", false) );
+    }
+    bench_report(bound);
+    HOST_TEST_ESP_OK( ssd1306_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bench_bus_handle) );
+}
+
+int main(void) {
+    static const bench_bound_t bounds[] = {
+        { "bmp280",   1.1f,  1400,   1500 },
+        { "bmp390",  28.0f, 11900,  38100 },
+        { "sht4x",    2.0f,   900,  18800 },
+        { "ahtxx",    4.0f,  1600, 108700 },
+        { "ina228",   1.0f,   600,  11100 },
+        { "mpu6050",  2.0f,  2050,   8400 },
+        { "ssd1306",  9.0f, 13800,  13800 },
+    };
+    bench_bmp280(&bounds[0]);
+    bench_bmp390(&bounds[1]);
+    bench_sht4x(&bounds[2]);
+    bench_ahtxx(&bounds[3]);
+    bench_ina228(&bounds[4]);
+    bench_mpu6050(&bounds[5]);
+    bench_ssd1306(&bounds[6]);
+    HOST_TEST_END();
+}
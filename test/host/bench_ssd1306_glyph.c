@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_ssd1306_glyph.c
+ *
+ * SSD1306 text rendering benchmark, a status field is drawn into the page 
+ * buffer with the per-pixel font paths and with the glyph cache blitter, 
+ * at a y-axis position that is not page aligned
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <time.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <ssd1306.h>
+#include <font_latin_8x8.h>
+#include <bdf_font_nenr12_21x26.h>
+#include "host_test.h"
+
+#define BENCH_ROUNDS        (2000)
+#define BENCH_LATIN_TEXT    "Temp 23.4 C"
+#define BENCH_BDF_TEXT      "23.45"
+#define BENCH_SPEEDUP       (2.0)   /* minimum glyph cache speed-up, regression bound (about 4x measured on the host) */
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* current latin path, every font bit through ssd1306_set_pixel */
+static double bench_latin_pixels(ssd1306_handle_t handle) {
+    const char *text = BENCH_LATIN_TEXT;
+    const double start = bench_now_ns();
+    for(int i = 0; i < BENCH_ROUNDS; i++) {
+        for(int k = 0; text[k] != '\0'; k++) {
+            for(int x = 0; x < 8; x++) {
+                for(int r = 0; r < 8; r++) {
+                    if(font_latin_8x8_tr[(uint8_t)text[k]][x] & (1 << r)) {
+                        ssd1306_set_pixel(handle, (uint8_t)(k * 8 + x), (uint8_t)(19 + r), (i & 1));
+                    }
+                }
+            }
+        }
+    }
+    return (bench_now_ns() - start) / BENCH_ROUNDS / 1e3;
+}
+
+/* current BDF path, bitmap loader and ssd1306_set_bitmap */
+static double bench_bdf_pixels(ssd1306_handle_t handle) {
+    const char *text = BENCH_BDF_TEXT;
+    const double start = bench_now_ns();
+    for(int i = 0; i < BENCH_ROUNDS; i++) {
+        int x = 0;
+        for(int k = 0; text[k] != '\0'; k++) {
+            ssd1306_bdf_font_t bdf_font;
+            uint8_t bitmap[256] = { 0 };
+            ssd1306_load_bitmap_font(bdf_font_nenr12_21x26, (uint8_t)text[k], bitmap, &bdf_font);
+            const int height = bdf_font.y_end - bdf_font.y_start + 1;
+            const int byte_width = bdf_font.num_data / height;
+            ssd1306_set_bitmap(handle, (uint8_t)x, (uint8_t)(13 + bdf_font.y_start), bitmap, (uint8_t)(byte_width * 8), (uint8_t)height, (i & 1));
+            x += bdf_font.width;
+        }
+    }
+    return (bench_now_ns() - start) / BENCH_ROUNDS / 1e3;
+}
+
+static double bench_glyphs(ssd1306_handle_t handle, ssd1306_glyph_cache_handle_t cache, const uint8_t ypos, const char *text) {
+    const double start = bench_now_ns();
+    for(int i = 0; i < BENCH_ROUNDS; i++) {
+        ssd1306_set_glyph_text(handle, cache, 0, ypos, text, (i & 1));
+    }
+    return (bench_now_ns() - start) / BENCH_ROUNDS / 1e3;
+}
+
+int main(void) {
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    i2c_sim_model_t *model = NULL;
+    ssd1306_handle_t handle = NULL;
+    ssd1306_glyph_cache_handle_t latin = NULL, bdf = NULL;
+
+    /* the bitmap font loader logs every glyph */
+    esp_log_level_set("*", ESP_LOG_WARN);
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( ssd1306_init(bus_handle, &dev_config, &handle) );
+    HOST_TEST_ESP_OK( ssd1306_get_latin_8x8_glyph_cache(&latin) );
+    HOST_TEST_ESP_OK( ssd1306_create_glyph_cache(bdf_font_nenr12_21x26, 32, 126, &bdf) );
+
+    /* warm up */
+    bench_latin_pixels(handle); bench_glyphs(handle, latin, 19, BENCH_LATIN_TEXT);
+
+    const double latin_pixels = bench_latin_pixels(handle);
+    const double latin_glyphs = bench_glyphs(handle, latin, 19, BENCH_LATIN_TEXT);
+    const double bdf_pixels   = bench_bdf_pixels(handle);
+    const double bdf_glyphs   = bench_glyphs(handle, bdf, 13, BENCH_BDF_TEXT);
+
+    printf("latin 8x8, 11 glyphs at y 19: per-pixel %.2f us, glyph cache %.2f us, %.1fx\n", latin_pixels, latin_glyphs, latin_pixels / latin_glyphs);
+    printf("nenr12 21x26, 5 glyphs at y 13: per-pixel %.2f us, glyph cache %.2f us, %.1fx\n", bdf_pixels, bdf_glyphs, bdf_pixels / bdf_glyphs);
+    HOST_TEST_ASSERT( latin_pixels / latin_glyphs >= BENCH_SPEEDUP );
+    HOST_TEST_ASSERT( bdf_pixels / bdf_glyphs >= BENCH_SPEEDUP );
+
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(bdf) );
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(latin) );
+    HOST_TEST_ESP_OK( ssd1306_delete(handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+    HOST_TEST_END();
+}
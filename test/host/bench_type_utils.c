@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_type_utils.c
+ *
+ * Type utilities field decoder benchmark, a burst of big endian 16-bit and 
+ * 24-bit signed fields (i.e. an accelerometer FIFO) is decoded and scaled with 
+ * the scalar byte conversions and with `bytes_to_float_array`
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <time.h>
+#include <type_utils.h>
+#include "host_test.h"
+
+#define BENCH_FIELDS    (1024)
+#define BENCH_ROUNDS    (2000)
+#define BENCH_SCALE     (0.061f)    /* mg per count */
+
+static uint8_t bytes[BENCH_FIELDS * 3];
+static float   values[BENCH_FIELDS];
+static volatile float sink;
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* per-field decode with the scalar conversions, 24-bit fields are assembled and sign extended by hand */
+static double bench_scalar(const type_utils_field_widths_t width) {
+    const double start = bench_now_ns();
+    for(int r = 0; r < BENCH_ROUNDS; r++) {
+        if(width == TYPE_UTILS_FIELD_WIDTH_16BIT) {
+            for(int i = 0; i < BENCH_FIELDS; i++) values[i] = (float)bytes_to_int16(&bytes[i * 2], false) * BENCH_SCALE;
+        } else {
+            for(int i = 0; i < BENCH_FIELDS; i++) {
+                const uint8_t *const p = &bytes[i * 3];
+                const int32_t raw = (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8)) >> 8;
+                values[i] = (float)raw * BENCH_SCALE;
+            }
+        }
+        sink = values[r % BENCH_FIELDS];
+    }
+    return (bench_now_ns() - start) / ((double)BENCH_ROUNDS * BENCH_FIELDS);
+}
+
+static double bench_array(const type_utils_field_widths_t width) {
+    const double start = bench_now_ns();
+    for(int r = 0; r < BENCH_ROUNDS; r++) {
+        bytes_to_float_array(bytes, values, BENCH_FIELDS, width, true, false, BENCH_SCALE);
+        sink = values[r % BENCH_FIELDS];
+    }
+    return (bench_now_ns() - start) / ((double)BENCH_ROUNDS * BENCH_FIELDS);
+}
+
+int main(void) {
+    uint32_t seed = 32;
+    for(size_t i = 0; i < sizeof(bytes); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        bytes[i] = (uint8_t)(seed >> 24);
+    }
+
+    const type_utils_field_widths_t widths[] = { TYPE_UTILS_FIELD_WIDTH_16BIT, TYPE_UTILS_FIELD_WIDTH_24BIT };
+    for(size_t w = 0; w < 2; w++) {
+        /* warm up, then take the best of three to reject scheduler noise */
+        bench_scalar(widths[w]); bench_array(widths[w]);
+        double scalar = 1e9, array = 1e9;
+        for(int k = 0; k < 3; k++) {
+            const double s = bench_scalar(widths[w]);
+            const double a = bench_array(widths[w]);
+            if(s < scalar) scalar = s;
+            if(a < array) array = a;
+        }
+        printf("%d-bit fields: scalar %.2f ns, bytes_to_float_array %.2f ns per field, %.1f Mfields/s\n",
+               (int)widths[w], scalar, array, 1e3 / array);
+        /* regression bound, the array decoder must keep up with the open-coded scalar loop */
+        HOST_TEST_ASSERT( array <= scalar * 1.5 );
+    }
+    HOST_TEST_END();
+}
@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_wx_utils_fast.c
+ *
+ * Weather utilities fast-path benchmark, the dewpoint, heat index and mixing
+ * ratio of a sample array are computed with the double-precision functions
+ * and with the single-precision batch functions.  The host FPU is double
+ * precision, so the speed-up is checked for the table based dewpoint and
+ * mixing ratio only, the heat index polynomial gains on the target where
+ * double-precision arithmetic is software emulated
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdbool.h>
+#include <time.h>
+#include <wx_utils.h>
+#include "host_test.h"
+
+#define BENCH_SAMPLES   (4096)
+#define BENCH_ROUNDS    (50)
+
+static float ta[BENCH_SAMPLES], hr[BENCH_SAMPLES], pa[BENCH_SAMPLES], out[BENCH_SAMPLES];
+static volatile double sink;
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_reference(const int function) {
+    const double start = bench_now_ns();
+    for(int r = 0; r < BENCH_ROUNDS; r++) {
+        double sum = 0;
+        for(int i = 0; i < BENCH_SAMPLES; i++) {
+            switch(function) {
+                case 0: sum += wx_td(ta[i], hr[i]); break;
+                case 1: sum += wx_hi(ta[i], hr[i]); break;
+                default: sum += wx_mr(ta[i], hr[i], pa[i]); break;
+            }
+        }
+        sink = sum;
+    }
+    return (bench_now_ns() - start) / ((double)BENCH_ROUNDS * BENCH_SAMPLES);
+}
+
+static double bench_batch(const int function) {
+    const double start = bench_now_ns();
+    for(int r = 0; r < BENCH_ROUNDS; r++) {
+        switch(function) {
+            case 0: HOST_TEST_ESP_OK( wx_td_batch(ta, hr, BENCH_SAMPLES, out) ); break;
+            case 1: HOST_TEST_ESP_OK( wx_hi_batch(ta, hr, BENCH_SAMPLES, out) ); break;
+            default: HOST_TEST_ESP_OK( wx_mr_batch(ta, hr, pa, BENCH_SAMPLES, out) ); break;
+        }
+        sink = out[r % BENCH_SAMPLES];
+    }
+    return (bench_now_ns() - start) / ((double)BENCH_ROUNDS * BENCH_SAMPLES);
+}
+
+int main(void) {
+    static const char *names[] = { "dewpoint", "heat index", "mixing ratio" };
+    static const bool table_based[] = { true, false, true };
+    for(int i = 0; i < BENCH_SAMPLES; i++) {
+        ta[i] = -30.0f + (float)(i % 700) * 0.1f;
+        hr[i] = 5.0f + (float)(i % 95);
+        pa[i] = 900.0f + (float)(i % 150);
+    }
+    for(int f = 0; f < 3; f++) {
+        const double reference = bench_reference(f);
+        const double batch = bench_batch(f);
+        printf("%-12s reference %7.1f ns/sample, batch %7.1f ns/sample, speed-up %.2fx\n",
+               names[f], reference, batch, reference / batch);
+        if(table_based[f]) HOST_TEST_ASSERT(batch <= reference);
+    }
+    HOST_TEST_END();
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#
+# Generates the ahrs replay recording, ahrs_replay.csv.
+#
+# The recording is an IMU sampled at 100 Hz while the sensor tumbles about all
+# three axes from an initial roll of 20, pitch of -10 and yaw of 30 degrees.
+# The reference orientation is integrated exactly from the body rates, the
+# gyroscope samples carry a constant bias and white noise, and the
+# accelerometer and magnetometer samples are the earth gravity and field
+# vectors rotated into the sensor frame with white noise.
+#
+# Earth frame: x magnetic north, y west, z up.  Sensor units: gyroscope deg/s,
+# accelerometer g, magnetometer uT.  Reference quaternion: sensor to earth.
+#
+#   python3 ahrs_replay_gen.py > ahrs_replay.csv
+#
+import math
+import random
+
+RATE_HZ     = 100
+DURATION_S  = 12
+GYRO_BIAS   = (0.3, -0.2, 0.25)     # deg/s
+GYRO_NOISE  = 0.2                   # deg/s rms
+ACCEL_NOISE = 0.005                 # g rms
+MAG_NOISE   = 0.3                   # uT rms
+FIELD_UT    = 50.0
+INCLINATION = math.radians(60.0)
+
+def q_mul(a, b):
+    aw, ax, ay, az = a
+    bw, bx, by, bz = b
+    return (aw * bw - ax * bx - ay * by - az * bz,
+            aw * bx + ax * bw + ay * bz - az * by,
+            aw * by - ax * bz + ay * bw + az * bx,
+            aw * bz + ax * by - ay * bx + az * bw)
+
+def q_normalize(q):
+    n = math.sqrt(sum(c * c for c in q))
+    return tuple(c / n for c in q)
+
+def q_from_euler(roll, pitch, yaw):
+    cr, sr = math.cos(roll / 2), math.sin(roll / 2)
+    cp, sp = math.cos(pitch / 2), math.sin(pitch / 2)
+    cy, sy = math.cos(yaw / 2), math.sin(yaw / 2)
+    return (cr * cp * cy + sr * sp * sy,
+            sr * cp * cy - cr * sp * sy,
+            cr * sp * cy + sr * cp * sy,
+            cr * cp * sy - sr * sp * cy)
+
+def earth_to_sensor(q, v):
+    # v_sensor = q* (x) v (x) q
+    w, x, y, z = q
+    conj = (w, -x, -y, -z)
+    r = q_mul(q_mul(conj, (0.0, v[0], v[1], v[2])), q)
+    return r[1:]
+
+def body_rate(t):
+    # deg/s
+    return (60.0 * math.sin(2 * math.pi * 0.25 * t),
+            45.0 * math.sin(2 * math.pi * 0.15 * t + 1.0),
+            80.0 * math.sin(2 * math.pi * 0.10 * t + 0.5))
+
+def main():
+    rng = random.Random(26)
+    dt = 1.0 / RATE_HZ
+    gravity = (0.0, 0.0, 1.0)
+    field = (FIELD_UT * math.cos(INCLINATION), 0.0, -FIELD_UT * math.sin(INCLINATION))
+    q = q_from_euler(math.radians(20.0), math.radians(-10.0), math.radians(30.0))
+    print("time,gx,gy,gz,ax,ay,az,mx,my,mz,qw,qx,qy,qz")
+    for k in range(RATE_HZ * DURATION_S):
+        t = k * dt
+        # orientation at the end of the sample interval, rate held over the interval
+        rate = body_rate(t + dt / 2)
+        angle = math.radians(math.sqrt(sum(c * c for c in rate))) * dt
+        if angle > 0.0:
+            axis = tuple(math.radians(c) * dt / angle for c in rate)
+            dq = (math.cos(angle / 2),) + tuple(c * math.sin(angle / 2) for c in axis)
+            q = q_normalize(q_mul(q, dq))
+        gyro = tuple(r + b + rng.gauss(0.0, GYRO_NOISE) for r, b in zip(rate, GYRO_BIAS))
+        accel = tuple(c + rng.gauss(0.0, ACCEL_NOISE) for c in earth_to_sensor(q, gravity))
+        mag = tuple(c + rng.gauss(0.0, MAG_NOISE) for c in earth_to_sensor(q, field))
+        print("%.2f,%.3f,%.3f,%.3f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f,%.5f,%.5f,%.5f,%.5f" %
+              ((t + dt,) + gyro + accel + mag + q))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+# Generates the synthetic pulse oximetry replay data, ppg_replay.csv.
+#
+# The data is not a recording, it holds several synthetic takes of a MAX30105
+# red and infrared photoplethysmogram sampled at 100 Hz.  Each pulse is a systolic peak followed
+# by a smaller dicrotic wave, the infrared pulse amplitude is 2 % of the DC
+# count and the red pulse amplitude is scaled by the ratio of ratios R of the
+# take.  The counts carry a respiratory baseline wander and white noise, and
+# the heart-rate of a take is constant or ramps.
+#
+# The reference heart-rate is the instantaneous pulse rate in beats per minute
+# and the reference ratio is the ratio of ratios R the red pulse is synthesized
+# with.  No SpO2 is generated, the SpO2 of a take depends on the calibration
+# applied to R and is not a property of the synthetic signal.
+#
+#   python3 ppg_replay_gen.py > ppg_replay.csv
+#
+import math
+import random
+
+RATE_HZ     = 100
+IR_DC       = 100000.0
+RED_DC      = 80000.0
+PULSE_RATIO = 0.02          # infrared pulse amplitude as a ratio of the DC count
+
+# take: duration s, start heart-rate bpm, end heart-rate bpm, R, noise counts rms, wander ratio
+TAKES = (
+    (30, 60.0,  60.0,  0.50, 0.0,  0.000),
+    (30, 75.0,  75.0,  0.70, 30.0, 0.010),
+    (30, 120.0, 120.0, 0.90, 60.0, 0.020),
+    (30, 70.0,  100.0, 0.60, 30.0, 0.010),
+)
+
+def shape(phase):
+    # systolic peak and dicrotic wave over one beat, phase 0 to 1
+    return math.exp(-((phase - 0.15) / 0.07) ** 2) + 0.4 * math.exp(-((phase - 0.45) / 0.08) ** 2)
+
+def main():
+    random.seed(39)
+    print("take,time,red,ir,heart_rate,ratio")
+    for take, (duration, hr_start, hr_end, r, noise, wander) in enumerate(TAKES):
+        phase = random.random()
+        samples = duration * RATE_HZ
+        for n in range(samples):
+            t = n / RATE_HZ
+            hr = hr_start + (hr_end - hr_start) * n / samples
+            s = shape(phase)
+            w = wander * math.sin(2 * math.pi * 0.2 * t)
+            ir = IR_DC * (1 + w) * (1 - PULSE_RATIO * s) + random.gauss(0.0, noise)
+            red = RED_DC * (1 + w) * (1 - PULSE_RATIO * r * s) + random.gauss(0.0, noise)
+            print("%d,%.2f,%d,%d,%.2f,%.3f" % (take, t, round(red), round(ir), hr, r))
+            phase += hr / 60.0 / RATE_HZ
+            if phase >= 1.0:
+                phase -= 1.0
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file host_test.h
+ * @defgroup host_test host_test
+ * @{
+ *
+ * Assertion macros for the host test and benchmark executables.  A failed
+ * check prints the source location and marks the executable as failed, the
+ * remaining checks still run and `HOST_TEST_END` returns the exit code ctest
+ * evaluates.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int host_test_failures = 0;
+
+/**
+ * @brief Checks that the condition is true.
+ */
+#define HOST_TEST_ASSERT(cond) do { \
+        if(!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++; \
+        } \
+    } while(0)
+
+/**
+ * @brief Checks that the esp-idf call returns `ESP_OK`.
+ */
+#define HOST_TEST_ESP_OK(call) do { \
+        esp_err_t host_test_err = (call); \
+        if(host_test_err != ESP_OK) { \
+            printf("FAIL %s:%d: %s returned %s\n", __FILE__, __LINE__, #call, esp_err_to_name(host_test_err)); \
+            host_test_failures++; \
+        } \
+    } while(0)
+
+/**
+ * @brief Checks that the esp-idf call returns the expected error code.
+ */
+#define HOST_TEST_ESP_ERR(expected, call) do { \
+        esp_err_t host_test_err = (call); \
+        if(host_test_err != (expected)) { \
+            printf("FAIL %s:%d: %s returned %s, expected %s\n", __FILE__, __LINE__, #call, \
+                   esp_err_to_name(host_test_err), esp_err_to_name(expected)); \
+            host_test_failures++; \
+        } \
+    } while(0)
+
+/**
+ * @brief Checks that the value is within the absolute tolerance of the expected value.
+ */
+#define HOST_TEST_NEAR(expected, actual, tolerance) do { \
+        double host_test_e = (double)(expected); \
+        double host_test_a = (double)(actual); \
+        if(!(fabs(host_test_e - host_test_a) <= (double)(tolerance))) { \
+            printf("FAIL %s:%d: %s = %.9g, expected %.9g +/- %.9g\n", __FILE__, __LINE__, #actual, \
+                   host_test_a, host_test_e, (double)(tolerance)); \
+            host_test_failures++; \
+        } \
+    } while(0)
+
+/**
+ * @brief Prints the test summary and returns the executable exit code.
+ */
+#define HOST_TEST_END() do { \
+        printf("%s: %d failure(s)\n", host_test_failures ? "FAILED" : "PASSED", host_test_failures); \
+        return host_test_failures ? EXIT_FAILURE : EXIT_SUCCESS; \
+    } while(0)
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __HOST_TEST_H__
@@ -0,0 +1,292 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file max31865_mock.c
+ *
+ * MAX31865 SPI device model for the host tests, see max31865_mock.h
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "max31865_mock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <i2c_sim.h>
+
+#define MAX31865_MOCK_REG_RTD_MSB       UINT8_C(0x01)
+#define MAX31865_MOCK_REG_RTD_LSB       UINT8_C(0x02)
+#define MAX31865_MOCK_REG_HIGH_MSB      UINT8_C(0x03)
+#define MAX31865_MOCK_REG_LOW_LSB       UINT8_C(0x06)
+#define MAX31865_MOCK_REG_WRITE_FLAG    UINT8_C(0x80)
+
+#define MAX31865_MOCK_CONFIG_BIAS       UINT8_C(0x80)
+#define MAX31865_MOCK_CONFIG_AUTO       UINT8_C(0x40)
+#define MAX31865_MOCK_CONFIG_ONESHOT    UINT8_C(0x20)
+#define MAX31865_MOCK_CONFIG_FAULT_CYCLE UINT8_C(0x0C)
+#define MAX31865_MOCK_CONFIG_FAULT_CLEAR UINT8_C(0x02)
+#define MAX31865_MOCK_CONFIG_FILTER_50HZ UINT8_C(0x01)
+
+#define MAX31865_MOCK_FAULT_HIGH        UINT8_C(0x80)
+#define MAX31865_MOCK_FAULT_LOW         UINT8_C(0x40)
+#define MAX31865_MOCK_FAULT_RTDIN       UINT8_C(0x08)
+#define MAX31865_MOCK_FAULT_VOLTAGE     UINT8_C(0x04)
+
+#define MAX31865_MOCK_AUTO_60HZ_US      (16667) /* automatic conversion period, 60 Hz filter */
+#define MAX31865_MOCK_AUTO_50HZ_US      (20000) /* automatic conversion period, 50 Hz filter */
+#define MAX31865_MOCK_ONESHOT_60HZ_US   (52000) /* one-shot conversion time, 60 Hz filter */
+#define MAX31865_MOCK_ONESHOT_50HZ_US   (62500) /* one-shot conversion time, 50 Hz filter */
+#define MAX31865_MOCK_AUTO_FIRST_PERIODS (3)    /* the first automatic conversion takes longer */
+#define MAX31865_MOCK_FAULT_AUTO_US     (550)   /* automatic fault detection cycle time */
+#define MAX31865_MOCK_FAULT_MANUAL_US   (100)   /* manual fault detection cycle finish time */
+
+/**
+ * @brief MAX31865 mock state structure.
+ */
+typedef struct max31865_mock_s {
+    pthread_mutex_t         mutex;
+    uint8_t                 regs[MAX31865_MOCK_REG_COUNT];
+    float                   resistance;
+    float                   r_ref;
+    bool                    rtd_open;
+    gpio_num_t              drdy_io_num;
+    bool                    drdy_level;
+    int64_t                 oneshot_done;   /* -1 when no one-shot conversion is in progress */
+    int64_t                 next_auto;      /* -1 when automatic conversions are stopped */
+    int64_t                 fault_done;     /* -1 when no fault detection cycle is in progress */
+    uint8_t                 fault_pending;
+    max31865_mock_stats_t   stats;
+} max31865_mock_t;
+
+static inline void max31865_mock_set_drdy(max31865_mock_t *const mock, const bool level) {
+    mock->drdy_level = level;
+    if (mock->drdy_io_num != GPIO_NUM_NC) gpio_set_level(mock->drdy_io_num, level);
+}
+
+static void max31865_mock_convert(max31865_mock_t *const mock) {
+    uint16_t code = (uint16_t)fminf(lroundf(mock->resistance / mock->r_ref * 32768.0f), 32767.0f);
+    const uint16_t high = (uint16_t)((mock->regs[3] << 8) | mock->regs[4]) >> 1;
+    const uint16_t low  = (uint16_t)((mock->regs[5] << 8) | mock->regs[6]) >> 1;
+
+    if (mock->rtd_open) {
+        code = 32767;
+        mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] |= MAX31865_MOCK_FAULT_RTDIN | MAX31865_MOCK_FAULT_HIGH;
+    }
+    if (code >= high) mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] |= MAX31865_MOCK_FAULT_HIGH;
+    if (code <= low)  mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] |= MAX31865_MOCK_FAULT_LOW;
+
+    const uint16_t raw = (uint16_t)(code << 1) | (mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] ? 1 : 0);
+    mock->regs[MAX31865_MOCK_REG_RTD_MSB] = (uint8_t)(raw >> 8);
+    mock->regs[MAX31865_MOCK_REG_RTD_LSB] = (uint8_t)(raw & 0xff);
+    mock->stats.conversions++;
+
+    /* DRDY falls when a conversion completes and the previous result was read */
+    if (mock->drdy_level) {
+        max31865_mock_set_drdy(mock, false);
+        mock->stats.drdy_edges++;
+        if (mock->drdy_io_num != GPIO_NUM_NC) i2c_sim_gpio_trigger(mock->drdy_io_num);
+    }
+}
+
+/* completes the conversions and the fault detection cycle due at the virtual time, the mutex must be held */
+static void max31865_mock_update_locked(max31865_mock_t *const mock) {
+    const int64_t now = i2c_sim_get_time_us();
+
+    if (mock->oneshot_done >= 0 && now >= mock->oneshot_done) {
+        mock->oneshot_done = -1;
+        mock->regs[MAX31865_MOCK_REG_CONFIG] &= ~MAX31865_MOCK_CONFIG_ONESHOT;
+        max31865_mock_convert(mock);
+    }
+    while (mock->next_auto >= 0 && now >= mock->next_auto) {
+        mock->next_auto += (mock->regs[MAX31865_MOCK_REG_CONFIG] & MAX31865_MOCK_CONFIG_FILTER_50HZ) ? MAX31865_MOCK_AUTO_50HZ_US : MAX31865_MOCK_AUTO_60HZ_US;
+        max31865_mock_convert(mock);
+    }
+    if (mock->fault_done >= 0 && now >= mock->fault_done) {
+        mock->fault_done = -1;
+        mock->regs[MAX31865_MOCK_REG_CONFIG] &= ~MAX31865_MOCK_CONFIG_FAULT_CYCLE;
+        mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] |= mock->fault_pending;
+    }
+}
+
+/* gpio line update, DRDY is read by the driver */
+static void max31865_mock_update(void *context) {
+    max31865_mock_t *const mock = (max31865_mock_t *)context;
+
+    pthread_mutex_lock(&mock->mutex);
+    max31865_mock_update_locked(mock);
+    pthread_mutex_unlock(&mock->mutex);
+}
+
+static void max31865_mock_write_config(max31865_mock_t *const mock, uint8_t value) {
+    const int64_t now   = i2c_sim_get_time_us();
+    const uint8_t old   = mock->regs[MAX31865_MOCK_REG_CONFIG];
+    const uint8_t cycle = (value & MAX31865_MOCK_CONFIG_FAULT_CYCLE) >> 2;
+
+    /* fault status clear requires the one-shot and fault detection cycle bits cleared */
+    if (value & MAX31865_MOCK_CONFIG_FAULT_CLEAR) {
+        if (value & (MAX31865_MOCK_CONFIG_ONESHOT | MAX31865_MOCK_CONFIG_FAULT_CYCLE)) mock->stats.bad_config_writes++;
+        mock->regs[MAX31865_MOCK_REG_FAULT_STATUS] = 0;
+        value &= ~MAX31865_MOCK_CONFIG_FAULT_CLEAR;
+    }
+
+    /* fault detection cycle requires the bias voltage on with automatic mode and one-shot off */
+    if (cycle != 0) {
+        if ((value & (MAX31865_MOCK_CONFIG_BIAS | MAX31865_MOCK_CONFIG_AUTO | MAX31865_MOCK_CONFIG_ONESHOT | MAX31865_MOCK_CONFIG_FAULT_CLEAR)) != MAX31865_MOCK_CONFIG_BIAS) {
+            mock->stats.bad_config_writes++;
+        }
+        if (cycle == 1) {
+            mock->fault_done = now + MAX31865_MOCK_FAULT_AUTO_US;
+        } else if (cycle == 2) {
+            mock->fault_done = -1;
+        } else {
+            /* manual cycle finish follows the manual cycle start */
+            if (((old & MAX31865_MOCK_CONFIG_FAULT_CYCLE) >> 2) != 2) mock->stats.bad_config_writes++;
+            mock->fault_done = now + MAX31865_MOCK_FAULT_MANUAL_US;
+        }
+        mock->fault_pending = mock->rtd_open ? (MAX31865_MOCK_FAULT_RTDIN | MAX31865_MOCK_FAULT_VOLTAGE) : 0;
+    }
+
+    /* one-shot and automatic conversions require the bias voltage */
+    if (value & MAX31865_MOCK_CONFIG_ONESHOT) {
+        if (!(value & MAX31865_MOCK_CONFIG_BIAS)) mock->stats.bad_config_writes++;
+        mock->oneshot_done = now + ((value & MAX31865_MOCK_CONFIG_FILTER_50HZ) ? MAX31865_MOCK_ONESHOT_50HZ_US : MAX31865_MOCK_ONESHOT_60HZ_US);
+    }
+    if ((value & MAX31865_MOCK_CONFIG_AUTO) && !(old & MAX31865_MOCK_CONFIG_AUTO)) {
+        if (!(value & MAX31865_MOCK_CONFIG_BIAS)) mock->stats.bad_config_writes++;
+        mock->next_auto = now + MAX31865_MOCK_AUTO_FIRST_PERIODS * ((value & MAX31865_MOCK_CONFIG_FILTER_50HZ) ? MAX31865_MOCK_AUTO_50HZ_US : MAX31865_MOCK_AUTO_60HZ_US);
+    } else if (!(value & MAX31865_MOCK_CONFIG_AUTO)) {
+        mock->next_auto = -1;
+    }
+
+    mock->regs[MAX31865_MOCK_REG_CONFIG] = value;
+}
+
+static esp_err_t max31865_mock_transfer(void *context, const spi_device_interface_config_t *config, const uint16_t command,
+                                        const uint64_t address, const uint8_t *tx_buffer, uint8_t *rx_buffer, const size_t size) {
+    max31865_mock_t *const mock = (max31865_mock_t *)context;
+
+    /* the device samples on the falling edge in spi mode 1 or 3 with an 8-bit address phase */
+    if (config->address_bits != 8 || (config->mode != 1 && config->mode != 3)) return ESP_ERR_INVALID_STATE;
+
+    pthread_mutex_lock(&mock->mutex);
+    max31865_mock_update_locked(mock);
+    mock->stats.transactions++;
+    mock->stats.spi_mode     = config->mode;
+    mock->stats.address_bits = config->address_bits;
+
+    /* registers auto-increment */
+    for (size_t i = 0; i < size; i++) {
+        const uint8_t reg = (uint8_t)((address & ~MAX31865_MOCK_REG_WRITE_FLAG) + i);
+        if (address & MAX31865_MOCK_REG_WRITE_FLAG) {
+            if (tx_buffer == NULL) break;
+            if (reg == MAX31865_MOCK_REG_CONFIG) {
+                max31865_mock_write_config(mock, tx_buffer[i]);
+            } else if (reg >= MAX31865_MOCK_REG_HIGH_MSB && reg <= MAX31865_MOCK_REG_LOW_LSB) {
+                mock->regs[reg] = tx_buffer[i];
+            }
+        } else {
+            if (rx_buffer) rx_buffer[i] = (reg < MAX31865_MOCK_REG_COUNT) ? mock->regs[reg] : 0;
+            if (reg == MAX31865_MOCK_REG_RTD_LSB) max31865_mock_set_drdy(mock, true);
+        }
+    }
+    pthread_mutex_unlock(&mock->mutex);
+
+    return ESP_OK;
+}
+
+static void max31865_mock_destroy(void *context) {
+    max31865_mock_t *const mock = (max31865_mock_t *)context;
+
+    if (mock->drdy_io_num != GPIO_NUM_NC) i2c_sim_gpio_set_update(mock->drdy_io_num, NULL, NULL);
+    pthread_mutex_destroy(&mock->mutex);
+    free(mock);
+}
+
+esp_err_t max31865_mock_create(const float r_ref, const gpio_num_t drdy_io_num, spi_sim_model_t **const model) {
+    if (model == NULL || r_ref <= 0) return ESP_ERR_INVALID_ARG;
+
+    max31865_mock_t *mock = (max31865_mock_t *)calloc(1, sizeof(max31865_mock_t));
+    spi_sim_model_t *out_model = (spi_sim_model_t *)calloc(1, sizeof(spi_sim_model_t));
+    if (mock == NULL || out_model == NULL) {
+        free(mock);
+        free(out_model);
+        return ESP_ERR_NO_MEM;
+    }
+
+    pthread_mutex_init(&mock->mutex, NULL);
+    mock->r_ref        = r_ref;
+    mock->resistance   = r_ref / 4;
+    mock->drdy_io_num  = drdy_io_num;
+    mock->oneshot_done = mock->next_auto = mock->fault_done = -1;
+
+    /* high fault threshold power-on value */
+    mock->regs[3] = 0xff;
+    mock->regs[4] = 0xff;
+    max31865_mock_set_drdy(mock, true);
+    if (drdy_io_num != GPIO_NUM_NC) i2c_sim_gpio_set_update(drdy_io_num, max31865_mock_update, mock);
+
+    out_model->name     = "max31865";
+    out_model->context  = mock;
+    out_model->transfer = max31865_mock_transfer;
+    out_model->destroy  = max31865_mock_destroy;
+    *model = out_model;
+
+    return ESP_OK;
+}
+
+void max31865_mock_set_resistance(spi_sim_model_t *const model, const float resistance) {
+    max31865_mock_t *const mock = (max31865_mock_t *)model->context;
+
+    pthread_mutex_lock(&mock->mutex);
+    mock->resistance = resistance;
+    pthread_mutex_unlock(&mock->mutex);
+}
+
+void max31865_mock_set_rtd_open(spi_sim_model_t *const model, const bool open) {
+    max31865_mock_t *const mock = (max31865_mock_t *)model->context;
+
+    pthread_mutex_lock(&mock->mutex);
+    mock->rtd_open = open;
+    pthread_mutex_unlock(&mock->mutex);
+}
+
+uint8_t max31865_mock_get_register(spi_sim_model_t *const model, const uint8_t reg) {
+    max31865_mock_t *const mock = (max31865_mock_t *)model->context;
+
+    pthread_mutex_lock(&mock->mutex);
+    const uint8_t value = reg < MAX31865_MOCK_REG_COUNT ? mock->regs[reg] : 0;
+    pthread_mutex_unlock(&mock->mutex);
+
+    return value;
+}
+
+void max31865_mock_get_stats(spi_sim_model_t *const model, max31865_mock_stats_t *const stats) {
+    max31865_mock_t *const mock = (max31865_mock_t *)model->context;
+
+    pthread_mutex_lock(&mock->mutex);
+    *stats = mock->stats;
+    pthread_mutex_unlock(&mock->mutex);
+}
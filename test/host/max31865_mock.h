@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file max31865_mock.h
+ * @defgroup max31865_mock max31865_mock
+ * @{
+ *
+ * MAX31865 SPI device model for the host tests, the model is attached to the
+ * SPI simulator and implements the register map, one-shot and automatic
+ * conversions at the 50 and 60 Hz filter conversion times, the fault detection
+ * cycle and the fault threshold comparison.  The DRDY line is driven low when a
+ * conversion completes and high when the RTD LSB register is read, the line is
+ * brought up to the virtual time when the driver reads it.
+ *
+ * Configuration register writes that the datasheet does not allow, i.e. a
+ * one-shot conversion without the bias voltage or a fault detection cycle in
+ * automatic mode, are counted as bad configuration writes.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __MAX31865_MOCK_H__
+#define __MAX31865_MOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <driver/gpio.h>
+#include <spi_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX31865_MOCK_REG_CONFIG        UINT8_C(0x00)   //!< max31865 mock, configuration register
+#define MAX31865_MOCK_REG_FAULT_STATUS  UINT8_C(0x07)   //!< max31865 mock, fault status register
+#define MAX31865_MOCK_REG_COUNT         (8)             //!< max31865 mock, number of registers
+
+/**
+ * @brief MAX31865 mock statistics structure.
+ */
+typedef struct max31865_mock_stats_s {
+    uint32_t    transactions;       /*!< max31865 mock, spi transactions */
+    uint32_t    conversions;        /*!< max31865 mock, completed conversions */
+    uint32_t    drdy_edges;         /*!< max31865 mock, DRDY falling edges */
+    uint32_t    bad_config_writes;  /*!< max31865 mock, configuration register writes not allowed by the datasheet */
+    uint8_t     spi_mode;           /*!< max31865 mock, spi mode of the last transaction */
+    uint8_t     address_bits;       /*!< max31865 mock, address phase bits of the last transaction */
+} max31865_mock_stats_t;
+
+/**
+ * @brief Creates a MAX31865 model, the model is attached with `spi_sim_add_device` which takes ownership.
+ * 
+ * @param r_ref Reference resistor in ohms.
+ * @param drdy_io_num DRDY gpio number, GPIO_NUM_NC when not connected.
+ * @param[out] model Created model.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t max31865_mock_create(const float r_ref, const gpio_num_t drdy_io_num, spi_sim_model_t **const model);
+
+/**
+ * @brief Sets the RTD resistance measured by a MAX31865 model.
+ * 
+ * @param model MAX31865 model.
+ * @param resistance RTD resistance in ohms.
+ */
+void max31865_mock_set_resistance(spi_sim_model_t *const model, const float resistance);
+
+/**
+ * @brief Opens or closes the RTD of a MAX31865 model, an open RTD reads full scale and fails the fault detection.
+ * 
+ * @param model MAX31865 model.
+ * @param open RTD is open when true.
+ */
+void max31865_mock_set_rtd_open(spi_sim_model_t *const model, const bool open);
+
+/**
+ * @brief Gets a register of a MAX31865 model without a transaction.
+ * 
+ * @param model MAX31865 model.
+ * @param reg Register address.
+ * @return uint8_t Register value.
+ */
+uint8_t max31865_mock_get_register(spi_sim_model_t *const model, const uint8_t reg);
+
+/**
+ * @brief Gets the statistics of a MAX31865 model.
+ */
+void max31865_mock_get_stats(spi_sim_model_t *const model, max31865_mock_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif // __MAX31865_MOCK_H__
@@ -0,0 +1,428 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file onewire_mock.c
+ *
+ * 1-wire bus mock with DS18B20 device models for the host tests
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "onewire_mock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <i2c_sim.h>
+#include <onewire_bus.h>
+#include <onewire_bus_interface.h>
+#include <onewire_cmd.h>
+#include <onewire_crc.h>
+
+#define ONEWIRE_MOCK_CMD_CONVERT        UINT8_C(0x44)
+#define ONEWIRE_MOCK_CMD_WRITE          UINT8_C(0x4E)
+#define ONEWIRE_MOCK_CMD_READ           UINT8_C(0xBE)
+#define ONEWIRE_MOCK_CMD_COPY           UINT8_C(0x48)
+#define ONEWIRE_MOCK_CMD_RECALL         UINT8_C(0xB8)
+#define ONEWIRE_MOCK_CMD_POWER_SUPPLY   UINT8_C(0xB4)
+
+/* datasheet maximum conversion times by resolution in microseconds */
+static const uint32_t onewire_mock_conversion_max_us[] = { 93750, 187500, 375000, 750000 };
+
+/**
+ * bus state, decoded from the bytes and bits written after a reset pulse
+ */
+typedef enum onewire_mock_state_e {
+    ONEWIRE_MOCK_STATE_ROM,             /* rom command expected */
+    ONEWIRE_MOCK_STATE_MATCH,           /* match rom id bytes */
+    ONEWIRE_MOCK_STATE_SEARCH,          /* search bit, complement and direction time slots */
+    ONEWIRE_MOCK_STATE_FUNCTION,        /* function command expected */
+    ONEWIRE_MOCK_STATE_WRITE,           /* scratchpad write bytes */
+    ONEWIRE_MOCK_STATE_READ,            /* scratchpad read bytes */
+    ONEWIRE_MOCK_STATE_CONVERT,         /* read time slots return the conversion status */
+    ONEWIRE_MOCK_STATE_POWER_SUPPLY,    /* read time slots return the power supply mode */
+    ONEWIRE_MOCK_STATE_IDLE,            /* no device responds until the next reset */
+} onewire_mock_state_t;
+
+typedef struct onewire_mock_device_s {
+    onewire_device_address_t address;
+    bool        parasitic;
+    float       temperature;
+    uint8_t     scratchpad[9];
+    uint8_t     eeprom[3];
+    bool        converting;
+    int64_t     conversion_done_us;
+    bool        selected;
+} onewire_mock_device_t;
+
+typedef struct onewire_mock_bus_s {
+    onewire_bus_t           base;       /* must be first, the bus handle is the base */
+    onewire_mock_device_t   devices[ONEWIRE_MOCK_DEVICE_MAX];
+    uint8_t                 device_count;
+    onewire_mock_state_t    state;
+    uint8_t                 index;      /* byte or bit index of the state */
+    uint8_t                 match[sizeof(onewire_device_address_t)];
+    uint8_t                 search_slot;
+    onewire_mock_stats_t    stats;
+} onewire_mock_bus_t;
+
+static void onewire_mock_advance(onewire_mock_bus_t *const mock, const uint32_t time_us) {
+    i2c_sim_advance_time_us(time_us);
+    mock->stats.bus_time_us += time_us;
+}
+
+static void onewire_mock_update_crc(onewire_mock_device_t *const device) {
+    device->scratchpad[8] = onewire_crc8(0, device->scratchpad, 8);
+}
+
+static void onewire_mock_set_temperature_register(onewire_mock_device_t *const device, const float temperature) {
+    const uint8_t resolution = (device->scratchpad[4] >> 5) & 0x03;
+    int16_t raw = (int16_t)lrintf(temperature * 16.0f);
+    raw &= (int16_t)~((1 << (3 - resolution)) - 1);
+    device->scratchpad[0] = (uint8_t)(raw & 0xff);
+    device->scratchpad[1] = (uint8_t)((uint16_t)raw >> 8);
+    onewire_mock_update_crc(device);
+}
+
+/* completes the conversions in progress that are due */
+static void onewire_mock_update(onewire_mock_bus_t *const mock) {
+    const int64_t now = i2c_sim_get_time_us();
+
+    for (uint8_t i = 0; i < mock->device_count; i++) {
+        onewire_mock_device_t *const device = &mock->devices[i];
+        if (device->converting && now >= device->conversion_done_us) {
+            device->converting = false;
+            onewire_mock_set_temperature_register(device, device->temperature);
+        }
+    }
+}
+
+/* a read time slot pulls the bus low, parasitic-powered devices in conversion brown out */
+static void onewire_mock_read_slot(onewire_mock_bus_t *const mock) {
+    onewire_mock_update(mock);
+
+    bool polled = false;
+    for (uint8_t i = 0; i < mock->device_count; i++) {
+        onewire_mock_device_t *const device = &mock->devices[i];
+        if (!device->converting) continue;
+
+        polled = true;
+        if (device->parasitic) {
+            device->converting = false;
+            memcpy(&device->scratchpad[2], device->eeprom, sizeof(device->eeprom));
+            onewire_mock_set_temperature_register(device, ONEWIRE_MOCK_POWER_ON_TEMP);
+            mock->stats.browned_out++;
+        }
+    }
+    if (polled) mock->stats.conversion_polls++;
+}
+
+static void onewire_mock_write_byte(onewire_mock_bus_t *const mock, const uint8_t value) {
+    switch (mock->state) {
+        case ONEWIRE_MOCK_STATE_ROM:
+            if (value == ONEWIRE_CMD_SKIP_ROM) {
+                for (uint8_t i = 0; i < mock->device_count; i++) mock->devices[i].selected = true;
+                mock->state = ONEWIRE_MOCK_STATE_FUNCTION;
+            } else if (value == ONEWIRE_CMD_MATCH_ROM) {
+                mock->state = ONEWIRE_MOCK_STATE_MATCH;
+                mock->index = 0;
+            } else if (value == ONEWIRE_CMD_SEARCH_NORMAL) {
+                for (uint8_t i = 0; i < mock->device_count; i++) mock->devices[i].selected = true;
+                mock->state = ONEWIRE_MOCK_STATE_SEARCH;
+                mock->index = 0;
+                mock->search_slot = 0;
+            } else {
+                mock->state = ONEWIRE_MOCK_STATE_IDLE;
+            }
+            break;
+        case ONEWIRE_MOCK_STATE_MATCH:
+            mock->match[mock->index++] = value;
+            if (mock->index == sizeof(mock->match)) {
+                onewire_device_address_t address;
+                memcpy(&address, mock->match, sizeof(address));
+                for (uint8_t i = 0; i < mock->device_count; i++) mock->devices[i].selected = (mock->devices[i].address == address);
+                mock->state = ONEWIRE_MOCK_STATE_FUNCTION;
+            }
+            break;
+        case ONEWIRE_MOCK_STATE_FUNCTION:
+            mock->index = 0;
+            mock->state = ONEWIRE_MOCK_STATE_IDLE;
+            for (uint8_t i = 0; i < mock->device_count; i++) {
+                onewire_mock_device_t *const device = &mock->devices[i];
+                if (!device->selected) continue;
+
+                switch (value) {
+                    case ONEWIRE_MOCK_CMD_CONVERT:
+                        device->converting = true;
+                        device->conversion_done_us = i2c_sim_get_time_us() + onewire_mock_conversion_time_us((device->scratchpad[4] >> 5) & 0x03);
+                        mock->stats.conversions++;
+                        mock->state = ONEWIRE_MOCK_STATE_CONVERT;
+                        break;
+                    case ONEWIRE_MOCK_CMD_WRITE:
+                        mock->state = ONEWIRE_MOCK_STATE_WRITE;
+                        break;
+                    case ONEWIRE_MOCK_CMD_READ:
+                        mock->state = ONEWIRE_MOCK_STATE_READ;
+                        break;
+                    case ONEWIRE_MOCK_CMD_COPY:
+                        memcpy(device->eeprom, &device->scratchpad[2], sizeof(device->eeprom));
+                        break;
+                    case ONEWIRE_MOCK_CMD_RECALL:
+                        memcpy(&device->scratchpad[2], device->eeprom, sizeof(device->eeprom));
+                        onewire_mock_update_crc(device);
+                        break;
+                    case ONEWIRE_MOCK_CMD_POWER_SUPPLY:
+                        mock->state = ONEWIRE_MOCK_STATE_POWER_SUPPLY;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            break;
+        case ONEWIRE_MOCK_STATE_WRITE:
+            for (uint8_t i = 0; i < mock->device_count; i++) {
+                onewire_mock_device_t *const device = &mock->devices[i];
+                if (!device->selected) continue;
+
+                /* the reserved bits of the configuration register read back as set */
+                device->scratchpad[2 + mock->index] = (mock->index == 2) ? ((value & 0x60) | 0x1f) : value;
+                onewire_mock_update_crc(device);
+            }
+            if (++mock->index == 3) mock->state = ONEWIRE_MOCK_STATE_IDLE;
+            break;
+        default:
+            break;
+    }
+}
+
+static uint8_t onewire_mock_read_byte(onewire_mock_bus_t *const mock) {
+    uint8_t value = 0xff;
+
+    if (mock->state == ONEWIRE_MOCK_STATE_READ && mock->index < 9) {
+        for (uint8_t i = 0; i < mock->device_count; i++) {
+            if (mock->devices[i].selected) value &= mock->devices[i].scratchpad[mock->index];
+        }
+        mock->index++;
+    }
+
+    return value;
+}
+
+static esp_err_t onewire_mock_reset(onewire_bus_t *bus) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+
+    onewire_mock_update(mock);
+    onewire_mock_advance(mock, ONEWIRE_MOCK_RESET_US);
+    mock->stats.resets++;
+    mock->state = ONEWIRE_MOCK_STATE_ROM;
+    mock->index = 0;
+    for (uint8_t i = 0; i < mock->device_count; i++) mock->devices[i].selected = false;
+
+    return mock->device_count ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+static esp_err_t onewire_mock_write_bytes(onewire_bus_t *bus, const uint8_t *tx_data, uint8_t tx_data_size) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+
+    if (tx_data == NULL) return ESP_ERR_INVALID_ARG;
+
+    onewire_mock_update(mock);
+    for (uint8_t i = 0; i < tx_data_size; i++) onewire_mock_write_byte(mock, tx_data[i]);
+    onewire_mock_advance(mock, tx_data_size * 8 * ONEWIRE_MOCK_SLOT_US);
+    mock->stats.bytes_written += tx_data_size;
+
+    return ESP_OK;
+}
+
+static esp_err_t onewire_mock_read_bytes(onewire_bus_t *bus, uint8_t *rx_buf, size_t rx_buf_size) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+
+    if (rx_buf == NULL) return ESP_ERR_INVALID_ARG;
+
+    for (size_t i = 0; i < rx_buf_size; i++) {
+        onewire_mock_read_slot(mock);
+        rx_buf[i] = onewire_mock_read_byte(mock);
+    }
+    onewire_mock_advance(mock, rx_buf_size * 8 * ONEWIRE_MOCK_SLOT_US);
+    mock->stats.bytes_read += rx_buf_size;
+
+    return ESP_OK;
+}
+
+static esp_err_t onewire_mock_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+
+    /* search direction, devices with the other rom bit leave the search */
+    if (mock->state == ONEWIRE_MOCK_STATE_SEARCH && mock->search_slot == 2) {
+        for (uint8_t i = 0; i < mock->device_count; i++) {
+            if (((mock->devices[i].address >> mock->index) & 0x01) != (tx_bit ? 1u : 0u)) mock->devices[i].selected = false;
+        }
+        mock->search_slot = 0;
+        if (++mock->index == 64) mock->state = ONEWIRE_MOCK_STATE_FUNCTION;
+    }
+    onewire_mock_advance(mock, ONEWIRE_MOCK_SLOT_US);
+    mock->stats.bits_written++;
+
+    return ESP_OK;
+}
+
+static esp_err_t onewire_mock_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+    uint8_t value = 1;
+
+    if (rx_bit == NULL) return ESP_ERR_INVALID_ARG;
+
+    onewire_mock_read_slot(mock);
+    for (uint8_t i = 0; i < mock->device_count; i++) {
+        const onewire_mock_device_t *const device = &mock->devices[i];
+        if (!device->selected) continue;
+
+        switch (mock->state) {
+            case ONEWIRE_MOCK_STATE_SEARCH: {
+                /* rom bit then its complement */
+                const uint8_t bit = (uint8_t)((device->address >> mock->index) & 0x01);
+                value &= (mock->search_slot == 0) ? bit : (uint8_t)!bit;
+                break;
+            }
+            case ONEWIRE_MOCK_STATE_CONVERT:
+                value &= device->converting ? 0 : 1;
+                break;
+            case ONEWIRE_MOCK_STATE_POWER_SUPPLY:
+                value &= device->parasitic ? 0 : 1;
+                break;
+            default:
+                break;
+        }
+    }
+    if (mock->state == ONEWIRE_MOCK_STATE_SEARCH && mock->search_slot < 2) mock->search_slot++;
+    onewire_mock_advance(mock, ONEWIRE_MOCK_SLOT_US);
+    mock->stats.bits_read++;
+
+    *rx_bit = value;
+
+    return ESP_OK;
+}
+
+static esp_err_t onewire_mock_del(onewire_bus_t *bus) {
+    free(bus);
+
+    return ESP_OK;
+}
+
+static onewire_mock_device_t *onewire_mock_find(onewire_mock_bus_t *const mock, const onewire_device_address_t address) {
+    for (uint8_t i = 0; i < mock->device_count; i++) {
+        if (mock->devices[i].address == address) return &mock->devices[i];
+    }
+
+    return NULL;
+}
+
+esp_err_t onewire_mock_new_bus(onewire_bus_handle_t *ret_bus) {
+    if (ret_bus == NULL) return ESP_ERR_INVALID_ARG;
+
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)calloc(1, sizeof(onewire_mock_bus_t));
+    if (mock == NULL) return ESP_ERR_NO_MEM;
+
+    /* the transaction member is left NULL, transactions are emulated with reset, write and read bytes */
+    mock->base.reset       = onewire_mock_reset;
+    mock->base.write_bytes = onewire_mock_write_bytes;
+    mock->base.read_bytes  = onewire_mock_read_bytes;
+    mock->base.write_bit   = onewire_mock_write_bit;
+    mock->base.read_bit    = onewire_mock_read_bit;
+    mock->base.del         = onewire_mock_del;
+    mock->state            = ONEWIRE_MOCK_STATE_IDLE;
+
+    *ret_bus = &mock->base;
+
+    return ESP_OK;
+}
+
+onewire_device_address_t onewire_mock_address(const uint8_t family, const uint64_t serial) {
+    uint8_t rom[sizeof(onewire_device_address_t)];
+    onewire_device_address_t address;
+
+    rom[0] = family;
+    for (uint8_t i = 0; i < 6; i++) rom[1 + i] = (uint8_t)(serial >> (8 * i));
+    rom[7] = onewire_crc8(0, rom, 7);
+    memcpy(&address, rom, sizeof(address));
+
+    return address;
+}
+
+esp_err_t onewire_mock_add_ds18b20(onewire_bus_handle_t bus, const onewire_device_address_t address, const bool parasitic, const float temperature) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+
+    if (mock == NULL || onewire_mock_find(mock, address)) return ESP_ERR_INVALID_ARG;
+    if (mock->device_count == ONEWIRE_MOCK_DEVICE_MAX) return ESP_ERR_NO_MEM;
+
+    onewire_mock_device_t *const device = &mock->devices[mock->device_count++];
+    memset(device, 0, sizeof(onewire_mock_device_t));
+    device->address     = address;
+    device->parasitic   = parasitic;
+    device->temperature = temperature;
+
+    /* power-on scratchpad, 12-bit resolution */
+    const uint8_t scratchpad[] = { 0x50, 0x05, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10, 0x00 };
+    memcpy(device->scratchpad, scratchpad, sizeof(scratchpad));
+    memcpy(device->eeprom, &scratchpad[2], sizeof(device->eeprom));
+    onewire_mock_update_crc(device);
+
+    return ESP_OK;
+}
+
+esp_err_t onewire_mock_remove_device(onewire_bus_handle_t bus, const onewire_device_address_t address) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+    onewire_mock_device_t *const device = mock ? onewire_mock_find(mock, address) : NULL;
+
+    if (device == NULL) return ESP_ERR_NOT_FOUND;
+
+    const size_t index = (size_t)(device - mock->devices);
+    memmove(device, device + 1, (mock->device_count - index - 1) * sizeof(onewire_mock_device_t));
+    mock->device_count--;
+
+    return ESP_OK;
+}
+
+esp_err_t onewire_mock_set_temperature(onewire_bus_handle_t bus, const onewire_device_address_t address, const float temperature) {
+    onewire_mock_bus_t *const mock = (onewire_mock_bus_t *)bus;
+    onewire_mock_device_t *const device = mock ? onewire_mock_find(mock, address) : NULL;
+
+    if (device == NULL) return ESP_ERR_NOT_FOUND;
+
+    device->temperature = temperature;
+
+    return ESP_OK;
+}
+
+uint32_t onewire_mock_conversion_time_us(const uint8_t resolution) {
+    return onewire_mock_conversion_max_us[resolution & 0x03] * 3 / 4;
+}
+
+void onewire_mock_get_stats(onewire_bus_handle_t bus, onewire_mock_stats_t *const stats) {
+    *stats = ((onewire_mock_bus_t *)bus)->stats;
+}
+
+void onewire_mock_reset_stats(onewire_bus_handle_t bus) {
+    memset(&((onewire_mock_bus_t *)bus)->stats, 0, sizeof(onewire_mock_stats_t));
+}
@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file onewire_mock.h
+ * @defgroup onewire_mock onewire_mock
+ * @{
+ *
+ * 1-wire bus mock for the host tests, the mock implements the onewire_bus
+ * interface with DS18B20 device models.  ROM commands, the ROM search, the
+ * scratchpad, power supply and conversion function commands are decoded from
+ * the bytes and bits written, read time slots return the wired-AND of the
+ * selected devices and every reset, byte and bit advances the simulation
+ * virtual time by its standard speed time slot.
+ *
+ * A parasitic-powered device draws its conversion current from the bus, a
+ * read time slot while it converts pulls the bus low, the device browns out,
+ * the conversion is lost and its temperature register reads the power-on
+ * 85 degree Celsius value.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __ONEWIRE_MOCK_H__
+#define __ONEWIRE_MOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <onewire_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ONEWIRE_MOCK_DEVICE_MAX         (16)        //!< onewire mock, maximum number of devices on a bus
+#define ONEWIRE_MOCK_RESET_US           (960)       //!< onewire mock, reset and presence detect time in microseconds
+#define ONEWIRE_MOCK_SLOT_US            (70)        //!< onewire mock, read or write time slot time in microseconds
+#define ONEWIRE_MOCK_POWER_ON_TEMP      (85.0f)     //!< onewire mock, ds18b20 power-on reset temperature in degree Celsius
+
+/**
+ * @brief 1-wire bus mock statistics structure.
+ */
+typedef struct onewire_mock_stats_s {
+    uint32_t    resets;             /*!< onewire mock, reset pulses */
+    uint32_t    bytes_written;      /*!< onewire mock, bytes written */
+    uint32_t    bytes_read;         /*!< onewire mock, bytes read */
+    uint32_t    bits_written;       /*!< onewire mock, single bit write time slots */
+    uint32_t    bits_read;          /*!< onewire mock, single bit read time slots */
+    uint32_t    conversions;        /*!< onewire mock, temperature conversions started per device */
+    uint32_t    conversion_polls;   /*!< onewire mock, read time slots while a conversion was in progress */
+    uint32_t    browned_out;        /*!< onewire mock, parasitic-powered conversions lost to a read time slot */
+    uint64_t    bus_time_us;        /*!< onewire mock, bus time in microseconds */
+} onewire_mock_stats_t;
+
+/**
+ * @brief Creates a 1-wire bus mock without devices, the bus is deleted with `onewire_bus_del`.
+ * 
+ * @param[out] ret_bus 1-wire bus handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t onewire_mock_new_bus(onewire_bus_handle_t *ret_bus);
+
+/**
+ * @brief Builds a 1-wire ROM id from the family code and 48-bit serial number with its crc.
+ * 
+ * @param family Family code, 0x28 for the DS18B20.
+ * @param serial 48-bit serial number.
+ * @return onewire_device_address_t ROM id.
+ */
+onewire_device_address_t onewire_mock_address(const uint8_t family, const uint64_t serial);
+
+/**
+ * @brief Attaches a DS18B20 model to the bus mock, the model starts with the 12-bit power-on configuration.
+ * 
+ * @param bus 1-wire bus mock handle.
+ * @param address ROM id of the device, the family code may differ from a DS18B20 to emulate another device.
+ * @param parasitic Device is parasitic-powered when true.
+ * @param temperature Temperature measured by a conversion in degree Celsius.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t onewire_mock_add_ds18b20(onewire_bus_handle_t bus, const onewire_device_address_t address, const bool parasitic, const float temperature);
+
+/**
+ * @brief Detaches a device from the bus mock.
+ * 
+ * @param bus 1-wire bus mock handle.
+ * @param address ROM id of the device.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the device is not attached.
+ */
+esp_err_t onewire_mock_remove_device(onewire_bus_handle_t bus, const onewire_device_address_t address);
+
+/**
+ * @brief Sets the temperature measured by the next conversion of a device.
+ * 
+ * @param bus 1-wire bus mock handle.
+ * @param address ROM id of the device.
+ * @param temperature Temperature in degree Celsius.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the device is not attached.
+ */
+esp_err_t onewire_mock_set_temperature(onewire_bus_handle_t bus, const onewire_device_address_t address, const float temperature);
+
+/**
+ * @brief Gets the conversion time of a device model at a resolution, the typical time is 
+ * three quarters of the datasheet maximum.
+ * 
+ * @param resolution Resolution bits of the configuration register, 0 for 9-bit to 3 for 12-bit.
+ * @return uint32_t Conversion time in microseconds.
+ */
+uint32_t onewire_mock_conversion_time_us(const uint8_t resolution);
+
+/**
+ * @brief Gets the bus mock statistics.
+ */
+void onewire_mock_get_stats(onewire_bus_handle_t bus, onewire_mock_stats_t *const stats);
+
+/**
+ * @brief Clears the bus mock statistics.
+ */
+void onewire_mock_reset_stats(onewire_bus_handle_t bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __ONEWIRE_MOCK_H__
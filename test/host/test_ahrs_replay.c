@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ahrs_replay.c
+ *
+ * AHRS replay test, the recorded gyroscope, accelerometer and magnetometer
+ * samples of `data/ahrs_replay.csv` are fused by the Madgwick and Mahony
+ * filters and the estimated orientation is checked against the reference
+ * orientation of the recording, tracking from the initial orientation and
+ * convergence from the identity orientation
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <ahrs.h>
+#include "host_test.h"
+
+#define REPLAY_FILE         HOST_TEST_DATA_DIR "/ahrs_replay.csv"
+#define REPLAY_MAX_SAMPLES  (2000)
+#define RAD_TO_DEG          (57.2957795131)
+
+typedef struct replay_sample_s {
+    float           time;
+    vector_float_t  gyro;
+    vector_float_t  accel;
+    vector_float_t  mag;
+    quaternion_t    reference;
+} replay_sample_t;
+
+typedef struct replay_error_s {
+    double rms;     /*!< rms error over the recording */
+    double max;     /*!< maximum error over the recording */
+    double first;   /*!< mean error over the first second */
+    double last;    /*!< mean error over the last second */
+} replay_error_t;
+
+static replay_sample_t samples[REPLAY_MAX_SAMPLES];
+static size_t sample_count;
+
+static bool replay_load(void) {
+    char line[256];
+    FILE *file = fopen(REPLAY_FILE, "r");
+    if(file == NULL) {
+        printf("FAIL unable to open %s\n", REPLAY_FILE);
+        return false;
+    }
+    /* skip header */
+    if(fgets(line, sizeof(line), file) == NULL) {
+        fclose(file);
+        return false;
+    }
+    while(sample_count < REPLAY_MAX_SAMPLES && fgets(line, sizeof(line), file) != NULL) {
+        replay_sample_t *s = &samples[sample_count];
+        int n = sscanf(line, "%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f", &s->time,
+                       &s->gyro.x, &s->gyro.y, &s->gyro.z, &s->accel.x, &s->accel.y, &s->accel.z,
+                       &s->mag.x, &s->mag.y, &s->mag.z,
+                       &s->reference.w, &s->reference.x, &s->reference.y, &s->reference.z);
+        if(n == 14) sample_count++;
+    }
+    fclose(file);
+    return sample_count > 0;
+}
+
+/* rotation angle between two orientations in degrees */
+static double attitude_error(const quaternion_t a, const quaternion_t b) {
+    double dot = fabs((double)a.w * b.w + (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z);
+    if(dot > 1.0) dot = 1.0;
+    return 2.0 * acos(dot) * RAD_TO_DEG;
+}
+
+/* angle between the earth z-axis of two orientations, expressed in the sensor frame, in degrees */
+static double tilt_error(const quaternion_t a, const quaternion_t b) {
+    const double ax = 2.0 * ((double)a.x * a.z - (double)a.w * a.y);
+    const double ay = 2.0 * ((double)a.w * a.x + (double)a.y * a.z);
+    const double az = (double)a.w * a.w - (double)a.x * a.x - (double)a.y * a.y + (double)a.z * a.z;
+    const double bx = 2.0 * ((double)b.x * b.z - (double)b.w * b.y);
+    const double by = 2.0 * ((double)b.w * b.x + (double)b.y * b.z);
+    const double bz = (double)b.w * b.w - (double)b.x * b.x - (double)b.y * b.y + (double)b.z * b.z;
+    double cosine = (ax * bx + ay * by + az * bz) / sqrt((ax * ax + ay * ay + az * az) * (bx * bx + by * by + bz * bz));
+    if(cosine > 1.0) cosine = 1.0;
+    return acos(cosine) * RAD_TO_DEG;
+}
+
+static replay_error_t replay_run(ahrs_handle_t handle, const bool use_mag) {
+    replay_error_t error = { 0 };
+    size_t first_count = 0, last_count = 0;
+    float previous_time = 0.0f;
+    const float end_time = samples[sample_count - 1].time;
+    for(size_t i = 0; i < sample_count; i++) {
+        const replay_sample_t *s = &samples[i];
+        quaternion_t q;
+        HOST_TEST_ESP_OK( ahrs_update(handle, &s->gyro, &s->accel, use_mag ? &s->mag : NULL, s->time - previous_time) );
+        HOST_TEST_ESP_OK( ahrs_get_quaternion(handle, &q) );
+        previous_time = s->time;
+        const double e = use_mag ? attitude_error(q, s->reference) : tilt_error(q, s->reference);
+        error.rms += e * e;
+        if(e > error.max) error.max = e;
+        if(s->time <= 1.0f) {
+            error.first += e;
+            first_count++;
+        }
+        if(s->time > end_time - 1.0f) {
+            error.last += e;
+            last_count++;
+        }
+    }
+    error.rms   = sqrt(error.rms / sample_count);
+    error.first = first_count ? error.first / first_count : 0.0;
+    error.last  = last_count ? error.last / last_count : 0.0;
+    return error;
+}
+
+/* tracking from the initial orientation of the recording */
+static void test_tracking(const ahrs_algorithms_t algorithm, const char *name, const bool use_mag,
+                          const double max_rms, const double max_error) {
+    ahrs_handle_t handle = NULL;
+    HOST_TEST_ESP_OK( ahrs_init(algorithm, &handle) );
+    if(handle == NULL) return;
+    HOST_TEST_ESP_OK( ahrs_set_quaternion(handle, samples[0].reference) );
+    const replay_error_t error = replay_run(handle, use_mag);
+    printf("%-8s %s tracking: rms %.2f deg, max %.2f deg\n", name, use_mag ? "9-dof attitude" : "6-dof tilt", error.rms, error.max);
+    HOST_TEST_ASSERT(error.rms <= max_rms);
+    HOST_TEST_ASSERT(error.max <= max_error);
+    HOST_TEST_ESP_OK( ahrs_delete(handle) );
+}
+
+/* convergence from the identity orientation, the initial roll, pitch and yaw errors are 20, 10 and 30 degrees */
+static void test_convergence(const ahrs_algorithms_t algorithm, const char *name, const double max_last) {
+    ahrs_handle_t handle = NULL;
+    HOST_TEST_ESP_OK( ahrs_init(algorithm, &handle) );
+    if(handle == NULL) return;
+    const replay_error_t error = replay_run(handle, true);
+    printf("%-8s 9-dof attitude convergence: first second %.2f deg, last second %.2f deg\n", name, error.first, error.last);
+    HOST_TEST_ASSERT(error.last <= max_last);
+    HOST_TEST_ASSERT(error.last < 0.5 * error.first);
+    HOST_TEST_ESP_OK( ahrs_delete(handle) );
+}
+
+int main(void) {
+    HOST_TEST_ASSERT(replay_load());
+    printf("replayed %zu samples, %.2f s\n", sample_count, sample_count ? samples[sample_count - 1].time : 0.0f);
+
+    if(sample_count == 0) HOST_TEST_END();
+
+    test_tracking(AHRS_ALGORITHM_MADGWICK, "madgwick", true,  2.0, 3.0);
+    test_tracking(AHRS_ALGORITHM_MADGWICK, "madgwick", false, 1.5, 2.0);
+    test_tracking(AHRS_ALGORITHM_MAHONY,   "mahony",   true,  2.0, 3.0);
+    test_tracking(AHRS_ALGORITHM_MAHONY,   "mahony",   false, 1.5, 2.0);
+
+    test_convergence(AHRS_ALGORITHM_MADGWICK, "madgwick", 15.0);
+    test_convergence(AHRS_ALGORITHM_MAHONY,   "mahony",   15.0);
+
+    HOST_TEST_END();
+}
@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_bmp280_latency.c
+ *
+ * BMP280 timing test, the initialization and measurement latency of the datasheet 
+ * derived waits is checked against the conservative fixed delays, the first normal 
+ * mode measurement after initialization is valid and the status polls back off
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <bmp280.h>
+#include "host_test.h"
+
+#define TEST_TEMPERATURE        (21.5f)
+#define TEST_PRESSURE           (101325.0f)
+#define MEAS_TIME_4X_4X_US      (1250 + 2300 * 4 + 2300 * 4 + 575)    /* datasheet maximum conversion time of 4x oversampling */
+
+typedef struct test_latency_s {
+    int64_t         init_time_us;
+    i2c_sim_stats_t init_stats;
+    int64_t         meas_time_us;
+    i2c_sim_stats_t meas_stats;
+} test_latency_t;
+
+/* initializes the device and takes the first measurement, the virtual time and bus statistics of both are returned */
+static test_latency_t test_first_measurement(const bmp280_power_modes_t power_mode, const bool conservative_timing) {
+    test_latency_t latency = { 0 };
+    i2c_sim_model_t *model;
+    bmp280_config_t dev_config = BMP280_CONFIG_DEFAULT;
+    dev_config.power_mode          = power_mode;
+    dev_config.conservative_timing = conservative_timing;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_set_environment(model, TEST_TEMPERATURE, TEST_PRESSURE) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+
+    bmp280_handle_t dev_handle = NULL;
+    int64_t start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( bmp280_init(bus_handle, &dev_config, &dev_handle) );
+    latency.init_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.init_stats);
+
+    /* the first measurement carries the model environment, not the data register reset values */
+    float temperature = 0, pressure = 0;
+    start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( bmp280_get_measurements(dev_handle, &temperature, &pressure) );
+    latency.meas_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.meas_stats);
+    HOST_TEST_NEAR( TEST_TEMPERATURE, temperature, 0.05f );
+    HOST_TEST_NEAR( TEST_PRESSURE, pressure, 5.0f );
+
+    printf("%-6s %-12s init %6lld us %2lu transactions %2lu delays, first measurement %6lld us %2lu transactions %2lu delays\n",
+           power_mode == BMP280_POWER_MODE_NORMAL ? "normal" : "forced", conservative_timing ? "conservative" : "datasheet",
+           (long long)latency.init_time_us, (unsigned long)latency.init_stats.transactions, (unsigned long)latency.init_stats.delays,
+           (long long)latency.meas_time_us, (unsigned long)latency.meas_stats.transactions, (unsigned long)latency.meas_stats.delays);
+
+    HOST_TEST_ESP_OK( bmp280_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+    return latency;
+}
+
+/* normal mode, the datasheet timing waits for the first conversion in init and the first collect is ready */
+static void test_normal_mode(void) {
+    const test_latency_t conservative = test_first_measurement(BMP280_POWER_MODE_NORMAL, true);
+    const test_latency_t datasheet    = test_first_measurement(BMP280_POWER_MODE_NORMAL, false);
+
+    HOST_TEST_ASSERT( datasheet.init_time_us < conservative.init_time_us );
+    HOST_TEST_ASSERT( datasheet.meas_time_us < conservative.meas_time_us );
+
+    /* the first conversion is completed in init, the measurement is read without polling */
+    HOST_TEST_ASSERT( datasheet.meas_stats.delays == 0 );
+    HOST_TEST_ASSERT( datasheet.meas_stats.transactions <= 2 );
+
+    /* the reset and conversion status polls back off, the init bus traffic stays bounded */
+    HOST_TEST_ASSERT( datasheet.init_stats.transactions <= 16 );
+}
+
+/* forced mode, the datasheet timing waits the conversion time of the configured oversampling */
+static void test_forced_mode(void) {
+    const test_latency_t conservative = test_first_measurement(BMP280_POWER_MODE_FORCED, true);
+    const test_latency_t datasheet    = test_first_measurement(BMP280_POWER_MODE_FORCED, false);
+
+    HOST_TEST_ASSERT( datasheet.init_time_us < conservative.init_time_us );
+    HOST_TEST_ASSERT( datasheet.meas_time_us < conservative.meas_time_us );
+    HOST_TEST_ASSERT( datasheet.meas_time_us >= MEAS_TIME_4X_4X_US );
+    HOST_TEST_ASSERT( datasheet.meas_stats.transactions <= 6 );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_normal_mode();
+    test_forced_mode();
+    HOST_TEST_END();
+}
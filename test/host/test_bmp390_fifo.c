@@ -0,0 +1,174 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_bmp390_fifo.c
+ *
+ * BMP390 FIFO drain test, frames written by the simulator barometer model in 
+ * normal mode are drained with one status read and one burst read, the parsed 
+ * pressure and temperature samples, sensor time, configuration change frames, 
+ * subsampling and overwrite on full are checked
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <math.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <bmp390.h>
+#include "host_test.h"
+
+#define ODR_PERIOD_US           (40000)     /* BMP390_ODR_40MS */
+#define SENSOR_TIME_HZ          (25600)
+#define PRESS_TEMP_FRAMES_MAX   (512 / 7)
+
+static bmp390_fifo_data_t fifo_data;
+
+/* drains the fifo and returns the bus statistics of the drain */
+static i2c_sim_stats_t fifo_read(bmp390_handle_t dev_handle, const char *const name) {
+    i2c_sim_stats_t stats;
+
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( bmp390_read_fifo(dev_handle, &fifo_data) );
+    i2c_sim_get_stats(&stats);
+    printf("%-26s %3u samples %u config changes full %d %lu transactions %4llu bytes %5llu us bus time\n", name, fifo_data.sample_count, 
+           fifo_data.config_change_count, fifo_data.full, (unsigned long)stats.transactions, (unsigned long long)stats.bytes_read, 
+           (unsigned long long)stats.bus_time_us);
+    return stats;
+}
+
+/* every sample carries the model environment, a channel that is not stored is NAN */
+static void fifo_check_samples(const float temperature, const float pressure) {
+    for(uint16_t i = 0; i < fifo_data.sample_count; i++) {
+        if(isnan(temperature)) {
+            HOST_TEST_ASSERT( isnan(fifo_data.samples[i].temperature) );
+        } else {
+            HOST_TEST_NEAR( temperature, fifo_data.samples[i].temperature, 0.01f );
+        }
+        if(isnan(pressure)) {
+            HOST_TEST_ASSERT( isnan(fifo_data.samples[i].pressure) );
+        } else {
+            HOST_TEST_NEAR( pressure, fifo_data.samples[i].pressure, 1.0f );
+        }
+    }
+}
+
+/* the sample count of a drain is the elapsed output data rate ticks, the bus time of a drain can add a tick */
+static bool fifo_count_near(const uint16_t expected) {
+    return fifo_data.sample_count == expected || fifo_data.sample_count == expected + 1;
+}
+
+static void test_fifo(void) {
+    i2c_sim_model_t *model;
+    bmp390_config_t dev_config = BMP390_CONFIG_DEFAULT;
+    bmp390_fifo_config_t fifo_config = BMP390_FIFO_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    bmp390_handle_t dev_handle = NULL;
+
+    dev_config.i2c_clock_speed  = 400000;
+    dev_config.power_mode       = BMP390_POWER_MODE_NORMAL;
+    dev_config.output_data_rate = BMP390_ODR_40MS;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_set_environment(model, 12.5f, 98000.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( bmp390_init(bus_handle, &dev_config, &dev_handle) );
+    if(dev_handle == NULL) return;
+
+    /* the fifo must be enabled before it is drained, the watermark fits the 511-byte register */
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_STATE, bmp390_read_fifo(dev_handle, &fifo_data) );
+    fifo_config.watermark = 74;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, bmp390_enable_fifo(dev_handle, &fifo_config) );
+    fifo_config.watermark = 0;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, bmp390_enable_fifo(dev_handle, &fifo_config) );
+    fifo_config.watermark = 64;
+    HOST_TEST_ESP_OK( bmp390_enable_fifo(dev_handle, &fifo_config) );
+
+    /* pending frames are drained with a status and length read and one burst of 7-byte frames and the sensor time frame */
+    i2c_sim_advance_time_us(20 * ODR_PERIOD_US);
+    i2c_sim_stats_t stats = fifo_read(dev_handle, "20 frames, press + temp");
+    HOST_TEST_ASSERT( fifo_count_near(20) );
+    HOST_TEST_ASSERT( stats.transactions == 2 && stats.bytes_read == 3 + fifo_data.sample_count * 7 + 4u );
+    HOST_TEST_ASSERT( fifo_data.full == false && fifo_data.config_change_count == 0 );
+    fifo_check_samples(12.5f, 98000.0f);
+
+    /* the sensor time frame follows the last frame and carries the 25.6 kHz sensor time of the read */
+    const int64_t sensor_time = (int64_t)i2c_sim_get_time_us() * SENSOR_TIME_HZ / 1000000;
+    printf("sensor time %lu, virtual sensor time %lld\n", (unsigned long)fifo_data.sensor_time, (long long)sensor_time);
+    HOST_TEST_ASSERT( fifo_data.sensor_time_valid );
+    HOST_TEST_ASSERT( fifo_data.sensor_time <= (uint32_t)sensor_time && fifo_data.sensor_time + SENSOR_TIME_HZ / 100 >= (uint32_t)sensor_time );
+
+    /* an empty fifo is a single status and length read */
+    stats = fifo_read(dev_handle, "empty");
+    HOST_TEST_ASSERT( fifo_data.sample_count == 0 && fifo_data.sensor_time_valid == false );
+    HOST_TEST_ASSERT( stats.transactions == 1 );
+
+    /* an output data rate change while the fifo runs writes a configuration change frame */
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_set_environment(model, 30.0f, 101000.0f) );
+    HOST_TEST_ESP_OK( bmp390_set_output_data_rate(dev_handle, BMP390_ODR_80MS) );
+    HOST_TEST_ESP_OK( bmp390_set_output_data_rate(dev_handle, BMP390_ODR_40MS) );
+    i2c_sim_advance_time_us(10 * ODR_PERIOD_US);
+    fifo_read(dev_handle, "config change");
+    HOST_TEST_ASSERT( fifo_data.config_change_count == 2 );
+    HOST_TEST_ASSERT( fifo_count_near(10) );
+    fifo_check_samples(30.0f, 101000.0f);
+
+    /* without stop on full the oldest frames are overwritten, the newest 73 frames are kept */
+    i2c_sim_advance_time_us(100 * ODR_PERIOD_US);
+    stats = fifo_read(dev_handle, "100 frames, overwrite");
+    HOST_TEST_ASSERT( fifo_data.full == true );
+    HOST_TEST_ASSERT( fifo_data.sample_count == PRESS_TEMP_FRAMES_MAX );
+    HOST_TEST_ASSERT( stats.transactions == 2 );
+    fifo_check_samples(30.0f, 101000.0f);
+
+    /* subsampling by 4 stores every 4th measurement, a temperature only frame is 4 bytes */
+    fifo_config.pressure_enabled = false;
+    fifo_config.subsampling      = BMP390_FIFO_SUBSAMPLING_4;
+    HOST_TEST_ESP_OK( bmp390_enable_fifo(dev_handle, &fifo_config) );
+    HOST_TEST_ESP_OK( bmp390_set_power_mode(dev_handle, BMP390_POWER_MODE_NORMAL) );
+    i2c_sim_advance_time_us(40 * ODR_PERIOD_US);
+    stats = fifo_read(dev_handle, "40 ticks, temp, 1 in 4");
+    HOST_TEST_ASSERT( fifo_count_near(10) );
+    HOST_TEST_ASSERT( stats.bytes_read == 3 + fifo_data.sample_count * 4 + 4u );
+    fifo_check_samples(30.0f, NAN);
+
+    /* the disabled fifo is not drained */
+    HOST_TEST_ESP_OK( bmp390_disable_fifo(dev_handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_STATE, bmp390_read_fifo(dev_handle, &fifo_data) );
+
+    HOST_TEST_ESP_OK( bmp390_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    test_fifo();
+
+    HOST_TEST_END();
+}
@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ds18b20_detect_cached.c
+ *
+ * DS18B20 rom id cache test against the 1-wire bus mock and the simulator nvs, 
+ * a cache hit verifies each cached device with one transaction instead of a rom 
+ * search, a missing device searches the bus again and a device added to the bus 
+ * is only detected after the cache is cleared by the periodic full search
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <nvs_flash.h>
+#include <i2c_sim.h>
+#include <onewire_bus.h>
+#include <ds18b20.h>
+#include "onewire_mock.h"
+#include "host_test.h"
+
+#define DS18B20_FAMILY          UINT8_C(0x28)
+#define TEST_NVS_KEY            "owb0"
+#define TEST_DEVICE_SIZE        (5)
+
+/* detects the devices and returns the bus mock statistics of the detection */
+static uint8_t test_detect(onewire_bus_handle_t bus, onewire_device_t *const devices, onewire_mock_stats_t *const stats) {
+    uint8_t count = 0;
+
+    onewire_mock_reset_stats(bus);
+    HOST_TEST_ESP_OK(ds18b20_detect_cached(bus, TEST_NVS_KEY, devices, TEST_DEVICE_SIZE, &count));
+    onewire_mock_get_stats(bus, stats);
+
+    return count;
+}
+
+static bool test_detected(const onewire_device_t *const devices, const uint8_t count, const onewire_device_address_t address) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (devices[i].address == address) return true;
+    }
+    return false;
+}
+
+int main(void) {
+    onewire_bus_handle_t bus;
+    onewire_device_t     devices[TEST_DEVICE_SIZE];
+    onewire_mock_stats_t stats;
+    uint8_t              count;
+
+    esp_log_level_set("*", ESP_LOG_ERROR);
+    HOST_TEST_ESP_OK(nvs_flash_erase());
+    HOST_TEST_ESP_OK(nvs_flash_init());
+
+    HOST_TEST_ESP_OK(onewire_mock_new_bus(&bus));
+    const onewire_device_address_t address1 = onewire_mock_address(DS18B20_FAMILY, 0x000001);
+    const onewire_device_address_t address2 = onewire_mock_address(DS18B20_FAMILY, 0x000002);
+    const onewire_device_address_t address3 = onewire_mock_address(DS18B20_FAMILY, 0x000003);
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, address1, false, 21.5f));
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, address2, false, 22.5f));
+
+    /* cache miss, the bus is searched with bit time slots and the rom ids are cached */
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 2);
+    HOST_TEST_ASSERT(test_detected(devices, count, address1) && test_detected(devices, count, address2));
+    HOST_TEST_ASSERT(stats.bits_read > 0);
+    const uint64_t search_time_us = stats.bus_time_us;
+
+    /* cache hit, one reset and scratchpad read per cached device without a rom search */
+    memset(devices, 0, sizeof(devices));
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 2);
+    HOST_TEST_ASSERT(test_detected(devices, count, address1) && test_detected(devices, count, address2));
+    HOST_TEST_ASSERT(devices[0].bus == bus && devices[1].bus == bus);
+    HOST_TEST_ASSERT(stats.resets == 2);
+    HOST_TEST_ASSERT(stats.bits_written == 0 && stats.bits_read == 0);
+    HOST_TEST_ASSERT(stats.bus_time_us < search_time_us);
+
+    /* device added to the bus, the cache hit does not search and misses the new device */
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, address3, false, 23.5f));
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 2);
+    HOST_TEST_ASSERT(test_detected(devices, count, address3) == false);
+    HOST_TEST_ASSERT(stats.bits_read == 0);
+
+    /* periodic full search, clearing the cache searches the bus and caches the new device */
+    HOST_TEST_ESP_OK(ds18b20_clear_detect_cache(TEST_NVS_KEY));
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 3);
+    HOST_TEST_ASSERT(test_detected(devices, count, address3));
+    HOST_TEST_ASSERT(stats.bits_read > 0);
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 3);
+    HOST_TEST_ASSERT(stats.resets == 3 && stats.bits_read == 0);
+
+    /* cached device removed from the bus, the cache is invalid and the bus is searched again */
+    HOST_TEST_ESP_OK(onewire_mock_remove_device(bus, address2));
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 2);
+    HOST_TEST_ASSERT(test_detected(devices, count, address2) == false);
+    HOST_TEST_ASSERT(stats.bits_read > 0);
+    count = test_detect(bus, devices, &stats);
+    HOST_TEST_ASSERT(count == 2);
+    HOST_TEST_ASSERT(stats.resets == 2 && stats.bits_read == 0);
+
+    /* clearing a missing key is not an error */
+    HOST_TEST_ESP_OK(ds18b20_clear_detect_cache("owb1"));
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+    HOST_TEST_END();
+}
@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ds18b20_parasitic.c
+ *
+ * DS18B20 conversion wait test against the 1-wire bus mock, externally powered 
+ * devices are polled with read time slots and complete before the maximum 
+ * conversion time, parasitic-powered devices are never polled while converting 
+ * and return the converted temperature instead of the power-on value
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <i2c_sim.h>
+#include <onewire_bus.h>
+#include <ds18b20.h>
+#include "onewire_mock.h"
+#include "host_test.h"
+
+#define DS18B20_FAMILY          UINT8_C(0x28)
+#define CONVERSION_12BIT_US     (800000)    /* driver maximum conversion time at 12-bit */
+#define CONVERSION_10BIT_US     (200000)    /* driver maximum conversion time at 10-bit */
+
+static ds18b20_handle_t test_init(onewire_bus_handle_t bus, const onewire_device_address_t address, const ds18b20_resolutions_t resolution) {
+    onewire_device_t       device  = { .bus = bus, .address = address };
+    ds18b20_config_t       config  = DS18B20_CONFIG_DEFAULT;
+    ds18b20_handle_t       handle  = NULL;
+
+    config.resolution = resolution;
+    HOST_TEST_ESP_OK(ds18b20_init(&device, &config, &handle));
+
+    return handle;
+}
+
+/* externally powered, the conversion is polled and completes before the maximum conversion time */
+static void test_external(void) {
+    onewire_bus_handle_t bus;
+    onewire_mock_stats_t stats;
+    bool                 parasitic = true;
+    float                temperature = 0;
+
+    HOST_TEST_ESP_OK(onewire_mock_new_bus(&bus));
+    const onewire_device_address_t address = onewire_mock_address(DS18B20_FAMILY, 0x000001);
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, address, false, 21.5f));
+
+    ds18b20_handle_t handle = test_init(bus, address, DS18B20_RESOLUTION_12BIT);
+    HOST_TEST_ESP_OK(ds18b20_get_power_supply_mode(handle, &parasitic));
+    HOST_TEST_ASSERT(parasitic == false);
+
+    onewire_mock_reset_stats(bus);
+    const int64_t start = esp_timer_get_time();
+    HOST_TEST_ESP_OK(ds18b20_get_temperature(handle, &temperature));
+    const int64_t elapsed = esp_timer_get_time() - start;
+    onewire_mock_get_stats(bus, &stats);
+
+    HOST_TEST_NEAR(21.5f, temperature, 0.0625f);
+    HOST_TEST_ASSERT(stats.conversions == 1);
+    HOST_TEST_ASSERT(stats.conversion_polls > 0);
+    HOST_TEST_ASSERT(stats.browned_out == 0);
+    HOST_TEST_ASSERT(elapsed >= (int64_t)onewire_mock_conversion_time_us(DS18B20_RESOLUTION_12BIT));
+    HOST_TEST_ASSERT(elapsed < CONVERSION_12BIT_US);
+
+    HOST_TEST_ESP_OK(ds18b20_delete(handle));
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* parasitic-powered, the maximum conversion time is waited without read time slots */
+static void test_parasitic(void) {
+    onewire_bus_handle_t bus;
+    onewire_mock_stats_t stats;
+    bool                 parasitic = false;
+    float                temperature = 0;
+
+    HOST_TEST_ESP_OK(onewire_mock_new_bus(&bus));
+    const onewire_device_address_t address = onewire_mock_address(DS18B20_FAMILY, 0x000002);
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, address, true, -10.25f));
+
+    ds18b20_handle_t handle = test_init(bus, address, DS18B20_RESOLUTION_12BIT);
+    HOST_TEST_ESP_OK(ds18b20_get_power_supply_mode(handle, &parasitic));
+    HOST_TEST_ASSERT(parasitic == true);
+
+    for (int i = 0; i < 3; i++) {
+        HOST_TEST_ESP_OK(onewire_mock_set_temperature(bus, address, -10.25f + (float)i));
+
+        onewire_mock_reset_stats(bus);
+        const int64_t start = esp_timer_get_time();
+        HOST_TEST_ESP_OK(ds18b20_get_temperature(handle, &temperature));
+        const int64_t elapsed = esp_timer_get_time() - start;
+        onewire_mock_get_stats(bus, &stats);
+
+        HOST_TEST_NEAR(-10.25f + (float)i, temperature, 0.0625f);
+        HOST_TEST_ASSERT(stats.conversions == 1);
+        HOST_TEST_ASSERT(stats.conversion_polls == 0);
+        HOST_TEST_ASSERT(stats.browned_out == 0);
+        HOST_TEST_ASSERT(elapsed >= CONVERSION_12BIT_US);
+    }
+
+    /* the wait follows the resolution */
+    HOST_TEST_ESP_OK(ds18b20_set_resolution(handle, DS18B20_RESOLUTION_10BIT));
+    const int64_t start = esp_timer_get_time();
+    HOST_TEST_ESP_OK(ds18b20_trigger_temperature_conversion(handle));
+    const int64_t elapsed = esp_timer_get_time() - start;
+    HOST_TEST_ESP_OK(ds18b20_get_measurement(handle, &temperature));
+    HOST_TEST_NEAR(-8.25f, temperature, 0.25f);
+    HOST_TEST_ASSERT(elapsed >= CONVERSION_10BIT_US && elapsed < CONVERSION_12BIT_US);
+
+    HOST_TEST_ESP_OK(ds18b20_delete(handle));
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* bus conversions, a parasitic-powered device on the bus turns the poll into the maximum conversion time */
+static void test_bus(void) {
+    onewire_bus_handle_t     bus;
+    onewire_mock_stats_t     stats;
+    onewire_device_address_t addresses[3];
+    ds18b20_handle_t         handles[3];
+    float                    temperatures[3];
+    const float              expected[3] = { 18.0f, 22.5f, 30.125f };
+    bool                     parasitic = true;
+
+    /* externally powered devices are polled */
+    HOST_TEST_ESP_OK(onewire_mock_new_bus(&bus));
+    for (int i = 0; i < 2; i++) {
+        addresses[i] = onewire_mock_address(DS18B20_FAMILY, 0x000010 + i);
+        HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, addresses[i], false, expected[i]));
+        handles[i] = test_init(bus, addresses[i], DS18B20_RESOLUTION_12BIT);
+    }
+    HOST_TEST_ESP_OK(ds18b20_get_bus_power_supply_mode(bus, &parasitic));
+    HOST_TEST_ASSERT(parasitic == false);
+
+    onewire_mock_reset_stats(bus);
+    int64_t start = esp_timer_get_time();
+    HOST_TEST_ESP_OK(ds18b20_get_bus_temperatures(handles, 2, temperatures));
+    int64_t elapsed = esp_timer_get_time() - start;
+    onewire_mock_get_stats(bus, &stats);
+
+    for (int i = 0; i < 2; i++) HOST_TEST_NEAR(expected[i], temperatures[i], 0.0625f);
+    HOST_TEST_ASSERT(stats.conversions == 2);
+    HOST_TEST_ASSERT(stats.conversion_polls > 0);
+    HOST_TEST_ASSERT(stats.browned_out == 0);
+    HOST_TEST_ASSERT(elapsed < CONVERSION_12BIT_US);
+
+    /* a parasitic-powered device joins the bus, including one without a handle */
+    addresses[2] = onewire_mock_address(DS18B20_FAMILY, 0x000012);
+    HOST_TEST_ESP_OK(onewire_mock_add_ds18b20(bus, addresses[2], true, expected[2]));
+    handles[2] = test_init(bus, addresses[2], DS18B20_RESOLUTION_12BIT);
+    HOST_TEST_ESP_OK(ds18b20_get_bus_power_supply_mode(bus, &parasitic));
+    HOST_TEST_ASSERT(parasitic == true);
+
+    for (uint8_t count = 2; count <= 3; count++) {
+        onewire_mock_reset_stats(bus);
+        start = esp_timer_get_time();
+        HOST_TEST_ESP_OK(ds18b20_get_bus_temperatures(&handles[3 - count], count, &temperatures[3 - count]));
+        elapsed = esp_timer_get_time() - start;
+        onewire_mock_get_stats(bus, &stats);
+
+        for (int i = 3 - count; i < 3; i++) HOST_TEST_NEAR(expected[i], temperatures[i], 0.0625f);
+        HOST_TEST_ASSERT(stats.conversions == 3);
+        HOST_TEST_ASSERT(stats.conversion_polls == 0);
+        HOST_TEST_ASSERT(stats.browned_out == 0);
+        HOST_TEST_ASSERT(elapsed >= CONVERSION_12BIT_US);
+    }
+
+    /* strong pull-up conversion, not connected pull-up gpio */
+    const ds18b20_strong_pullup_config_t pullup_config = DS18B20_STRONG_PULLUP_CONFIG_DEFAULT;
+    onewire_mock_reset_stats(bus);
+    HOST_TEST_ESP_OK(ds18b20_trigger_bus_temperature_conversion_parasitic(bus, DS18B20_RESOLUTION_12BIT, &pullup_config));
+    HOST_TEST_ESP_OK(ds18b20_get_measurement(handles[2], &temperatures[2]));
+    onewire_mock_get_stats(bus, &stats);
+    HOST_TEST_NEAR(expected[2], temperatures[2], 0.0625f);
+    HOST_TEST_ASSERT(stats.conversion_polls == 0 && stats.browned_out == 0);
+
+    for (int i = 0; i < 3; i++) HOST_TEST_ESP_OK(ds18b20_delete(handles[i]));
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_external();
+    test_parasitic();
+    test_bus();
+    HOST_TEST_END();
+}
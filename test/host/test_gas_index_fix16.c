@@ -0,0 +1,147 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_gas_index_fix16.c
+ *
+ * Fixed-point gas index algorithm error-bound test, 3 days of synthetic VOC 
+ * and NOx raw ticks at 1 second samples, drift, noise and events included, 
+ * are processed by the fixed-point and float algorithms and the gas index 
+ * differences are checked against the bound documented in `gas_index_fix16.h`
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <math.h>
+#include <sensirion_gas_index_algorithm.h>
+#include <gas_index_fix16.h>
+#include "host_test.h"
+
+#define GI_SAMPLES              (3 * 24 * 3600)     /* 3 days at 1 second */
+#define GI_EVENT_PERIOD         (5 * 3600 + 1234)   /* seconds between events */
+#define GI_EVENT_DURATION       (40 * 60)           /* event duration in seconds */
+#define GI_MAX_ERROR            (1)                 /* index points, see gas_index_fix16.h */
+#define GI_MEAN_ERROR           (0.1)               /* index points, see gas_index_fix16.h */
+
+static uint32_t gi_rng_state = 31;
+
+/* uniform noise in -1 to 1 */
+static double gi_noise(void) {
+    gi_rng_state = gi_rng_state * 1664525u + 1013904223u;
+    return (double)(gi_rng_state >> 8) / (double)(1u << 23) - 1.0;
+}
+
+/* raw ticks with a daily drift, noise and a raised-cosine event every GI_EVENT_PERIOD */
+static int32_t gi_sraw(const int algorithm_type, const int32_t t) {
+    const bool   nox       = (algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX);
+    const double baseline  = nox ? 16000.0 : 30000.0;
+    const double drift     = (nox ? 150.0 : 800.0) * sin(2.0 * M_PI * t / 86400.0);
+    const double amplitude = nox ? 5000.0 : -2500.0;
+    const int32_t phase    = t % GI_EVENT_PERIOD;
+    double event = 0.0;
+    if(t > 3600 && phase < GI_EVENT_DURATION) {
+        event = amplitude * 0.5 * (1.0 - cos(2.0 * M_PI * phase / GI_EVENT_DURATION));
+    }
+    return (int32_t)lround(baseline + drift + event + (nox ? 10.0 : 40.0) * gi_noise());
+}
+
+static void test_error_bound(const int algorithm_type, const char *const name) {
+    GasIndexAlgorithmParams  reference;
+    gas_index_fix16_params_t fixed;
+    int32_t max_error = 0, max_index = 0, mismatches = 0;
+    int64_t sum_error = 0;
+
+    GasIndexAlgorithm_init(&reference, algorithm_type);
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&fixed, algorithm_type, GasIndexAlgorithm_DEFAULT_SAMPLING_INTERVAL) );
+
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < GI_SAMPLES; t++) {
+        const int32_t sraw = gi_sraw(algorithm_type, t);
+        int32_t expected = 0, actual = 0;
+        GasIndexAlgorithm_process(&reference, sraw, &expected);
+        HOST_TEST_ESP_OK( gas_index_fix16_process(&fixed, sraw, &actual) );
+        const int32_t error = abs(actual - expected);
+        if(error > max_error) max_error = error;
+        if(error != 0) mismatches++;
+        if(expected > max_index) max_index = expected;
+        sum_error += error;
+    }
+
+    const double mean_error = (double)sum_error / GI_SAMPLES;
+    printf("%s max error %ld, mean error %.4f, %ld of %d samples differ, max index %ld\n", 
+           name, (long)max_error, mean_error, (long)mismatches, GI_SAMPLES, (long)max_index);
+    HOST_TEST_ASSERT( max_error <= GI_MAX_ERROR );
+    HOST_TEST_ASSERT( mean_error <= GI_MEAN_ERROR );
+    /* the events must move the index well away from the offset for the bound to mean anything */
+    HOST_TEST_ASSERT( max_index > (algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 50 : 250) );
+}
+
+static void test_batch(void) {
+    gas_index_fix16_params_t scalar[2], batch[2];
+    const int32_t types[2] = { GasIndexAlgorithm_ALGORITHM_TYPE_VOC, GasIndexAlgorithm_ALGORITHM_TYPE_NOX };
+
+    for(int i = 0; i < 2; i++) {
+        HOST_TEST_ESP_OK( gas_index_fix16_init(&scalar[i], types[i], 1.0f) );
+        HOST_TEST_ESP_OK( gas_index_fix16_init(&batch[i], types[i], 1.0f) );
+    }
+
+    gi_rng_state = 31;
+    bool equal = true;
+    for(int32_t t = 0; t < 6 * 3600; t++) {
+        int32_t sraws[2], scalar_indexes[2], batch_indexes[2];
+        for(int i = 0; i < 2; i++) {
+            sraws[i] = gi_sraw(types[i], t);
+            HOST_TEST_ESP_OK( gas_index_fix16_process(&scalar[i], sraws[i], &scalar_indexes[i]) );
+        }
+        HOST_TEST_ESP_OK( gas_index_fix16_process_batch(batch, sraws, batch_indexes, 2) );
+        for(int i = 0; i < 2; i++) {
+            if(batch_indexes[i] != scalar_indexes[i]) equal = false;
+        }
+    }
+    HOST_TEST_ASSERT( equal );
+}
+
+static void test_arguments(void) {
+    gas_index_fix16_params_t params;
+    int32_t gas_index;
+
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_init(NULL, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 1.0f) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_init(&params, 2, 1.0f) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_init(&params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 0.5f) );
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 1.0f) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_set_tuning_parameters(&params, 0, 12, 12, 180, 50, 230) );
+    HOST_TEST_ESP_OK( gas_index_fix16_set_tuning_parameters(&params, 100, 12, 12, 180, 50, 230) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_process(&params, 30000, NULL) );
+    HOST_TEST_ESP_OK( gas_index_fix16_process(&params, 30000, &gas_index) );
+    HOST_TEST_ASSERT( gas_index == 0 );     // initial blackout
+}
+
+int main(void) {
+    test_error_bound(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, "voc");
+    test_error_bound(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, "nox");
+    test_batch();
+    test_arguments();
+    HOST_TEST_END();
+}
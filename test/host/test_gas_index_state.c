@@ -0,0 +1,307 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_gas_index_state.c
+ *
+ * Gas index learning state blob test, the float and fixed-point instances 
+ * are exported after about a day of synthetic VOC and NOx raw ticks, imported 
+ * into fresh instances and must continue with bit-identical gas indexes, 
+ * blobs with a bad magic, version or crc are rejected without touching the 
+ * instance, and the batch engine is checked against per-instance processing
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sensirion_gas_index_algorithm.h>
+#include <gas_index_engine.h>
+#include <gas_index_fix16.h>
+#include <esp_rom_crc.h>
+#include "host_test.h"
+
+#define GI_EVENT_PERIOD         (5 * 3600 + 1234)   /* seconds between events */
+#define GI_EVENT_DURATION       (40 * 60)           /* event duration in seconds */
+#define GI_LEARN_SAMPLES        (4 * GI_EVENT_PERIOD + GI_EVENT_DURATION / 2)  /* about a day at 1 second, exported in the middle of an event */
+#define GI_RESUME_SAMPLES       (6 * 3600)          /* samples after the import */
+
+static uint32_t gi_rng_state = 31;
+
+/* uniform noise in -1 to 1 */
+static double gi_noise(void) {
+    gi_rng_state = gi_rng_state * 1664525u + 1013904223u;
+    return (double)(gi_rng_state >> 8) / (double)(1u << 23) - 1.0;
+}
+
+/* raw ticks with a daily drift, noise and a raised-cosine event every GI_EVENT_PERIOD */
+static int32_t gi_sraw(const int algorithm_type, const int32_t t) {
+    const bool   nox       = (algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX);
+    const double baseline  = nox ? 16000.0 : 30000.0;
+    const double drift     = (nox ? 150.0 : 800.0) * sin(2.0 * M_PI * t / 86400.0);
+    const double amplitude = nox ? 5000.0 : -2500.0;
+    const int32_t phase    = t % GI_EVENT_PERIOD;
+    double event = 0.0;
+    if(t > 3600 && phase < GI_EVENT_DURATION) {
+        event = amplitude * 0.5 * (1.0 - cos(2.0 * M_PI * phase / GI_EVENT_DURATION));
+    }
+    return (int32_t)lround(baseline + drift + event + (nox ? 10.0 : 40.0) * gi_noise());
+}
+
+static void test_state_roundtrip(const int algorithm_type, const char *const name) {
+    GasIndexAlgorithmParams learned, restored, cold;
+    gas_index_state_blob_t  blob, resumed_blob, restored_blob;
+    int32_t mismatches = 0, cold_mismatches = 0;
+
+    GasIndexAlgorithm_init(&learned, algorithm_type);
+    /* non-default tuning, the tuning travels with the blob */
+    GasIndexAlgorithm_set_tuning_parameters(&learned, algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 1 : 120, 
+                                            12, 10, algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 720 : 120, 50, 230);
+
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < GI_LEARN_SAMPLES; t++) {
+        int32_t gas_index;
+        GasIndexAlgorithm_process(&learned, gi_sraw(algorithm_type, t), &gas_index);
+    }
+
+    HOST_TEST_ESP_OK( gas_index_export_state(&learned, &blob) );
+    HOST_TEST_ASSERT( blob.magic == GAS_INDEX_STATE_BLOB_MAGIC && blob.version == GAS_INDEX_STATE_BLOB_VERSION );
+    HOST_TEST_ASSERT( (blob.flags & GAS_INDEX_STATE_FLAG_MVE_INIT) && (blob.flags & GAS_INDEX_STATE_FLAG_LOWPASS_INIT) );
+
+    /* a fresh instance of the other type takes the type of the blob */
+    GasIndexAlgorithm_init(&restored, algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 
+                           GasIndexAlgorithm_ALGORITHM_TYPE_VOC : GasIndexAlgorithm_ALGORITHM_TYPE_NOX);
+    HOST_TEST_ESP_OK( gas_index_import_state(&restored, &blob) );
+    HOST_TEST_ASSERT( restored.mAlgorithm_Type == algorithm_type );
+    GasIndexAlgorithm_init(&cold, algorithm_type);
+
+    for(int32_t t = GI_LEARN_SAMPLES; t < GI_LEARN_SAMPLES + GI_RESUME_SAMPLES; t++) {
+        const int32_t sraw = gi_sraw(algorithm_type, t);
+        int32_t expected, actual, relearned;
+        GasIndexAlgorithm_process(&learned, sraw, &expected);
+        GasIndexAlgorithm_process(&restored, sraw, &actual);
+        GasIndexAlgorithm_process(&cold, sraw, &relearned);
+        if(actual != expected) mismatches++;
+        if(relearned != expected) cold_mismatches++;
+    }
+
+    /* the resumed states are bit-identical, not only the rounded indexes */
+    HOST_TEST_ESP_OK( gas_index_export_state(&learned, &resumed_blob) );
+    HOST_TEST_ESP_OK( gas_index_export_state(&restored, &restored_blob) );
+    printf("%s float state: %ld of %d resumed samples differ, %ld without the import\n", 
+           name, (long)mismatches, GI_RESUME_SAMPLES, (long)cold_mismatches);
+    HOST_TEST_ASSERT( mismatches == 0 );
+    HOST_TEST_ASSERT( memcmp(&resumed_blob, &restored_blob, sizeof(gas_index_state_blob_t)) == 0 );
+    HOST_TEST_ASSERT( cold_mismatches > 0 );
+}
+
+static void test_fix16_state_roundtrip(const int algorithm_type, const char *const name) {
+    gas_index_fix16_params_t     learned, restored;
+    gas_index_fix16_state_blob_t blob;
+    int32_t mismatches = 0;
+
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&learned, algorithm_type, 1.0f) );
+    HOST_TEST_ESP_OK( gas_index_fix16_set_tuning_parameters(&learned, algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 1 : 120, 
+                                                            12, 10, algorithm_type == GasIndexAlgorithm_ALGORITHM_TYPE_NOX ? 720 : 120, 50, 230) );
+
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < GI_LEARN_SAMPLES; t++) {
+        int32_t gas_index;
+        HOST_TEST_ESP_OK( gas_index_fix16_process(&learned, gi_sraw(algorithm_type, t), &gas_index) );
+    }
+
+    HOST_TEST_ESP_OK( gas_index_fix16_export_state(&learned, &blob) );
+    HOST_TEST_ASSERT( blob.magic == GAS_INDEX_FIX16_STATE_BLOB_MAGIC && blob.version == GAS_INDEX_FIX16_STATE_BLOB_VERSION );
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&restored, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 10.0f) );
+    HOST_TEST_ESP_OK( gas_index_fix16_import_state(&restored, &blob) );
+
+    /* every field, derived coefficients included, matches the exporting instance, the sigmoid 
+       parameters and gated gammas are scratch values recomputed before use by every sample */
+    gas_index_fix16_params_t scratch = restored;
+    scratch.mve_sigmoid_k            = learned.mve_sigmoid_k;
+    scratch.mve_sigmoid_x0           = learned.mve_sigmoid_x0;
+    scratch.mve_gated_gamma_mean     = learned.mve_gated_gamma_mean;
+    scratch.mve_gated_gamma_variance = learned.mve_gated_gamma_variance;
+    HOST_TEST_ASSERT( memcmp(&learned, &scratch, sizeof(gas_index_fix16_params_t)) == 0 );
+    HOST_TEST_ASSERT( restored.mve_initialized && restored.lowpass_initialized );
+    HOST_TEST_ASSERT( restored.mve_gating_duration_minutes > 0 );
+
+    for(int32_t t = GI_LEARN_SAMPLES; t < GI_LEARN_SAMPLES + GI_RESUME_SAMPLES; t++) {
+        const int32_t sraw = gi_sraw(algorithm_type, t);
+        int32_t expected, actual;
+        HOST_TEST_ESP_OK( gas_index_fix16_process(&learned, sraw, &expected) );
+        HOST_TEST_ESP_OK( gas_index_fix16_process(&restored, sraw, &actual) );
+        if(actual != expected) mismatches++;
+    }
+
+    gas_index_fix16_state_blob_t resumed_blob, restored_blob;
+    HOST_TEST_ESP_OK( gas_index_fix16_export_state(&learned, &resumed_blob) );
+    HOST_TEST_ESP_OK( gas_index_fix16_export_state(&restored, &restored_blob) );
+    printf("%s fix16 state: %ld of %d resumed samples differ\n", name, (long)mismatches, GI_RESUME_SAMPLES);
+    HOST_TEST_ASSERT( mismatches == 0 );
+    HOST_TEST_ASSERT( memcmp(&resumed_blob, &restored_blob, sizeof(gas_index_fix16_state_blob_t)) == 0 );
+}
+
+/* re-seals a modified blob so that only the intended field is wrong */
+static void test_reseal(gas_index_state_blob_t *const blob) {
+    blob->crc = esp_rom_crc32_le(0, (const uint8_t *)blob, offsetof(gas_index_state_blob_t, crc));
+}
+
+static void test_state_rejected(void) {
+    GasIndexAlgorithmParams learned, target, untouched;
+    gas_index_state_blob_t  blob, bad;
+
+    GasIndexAlgorithm_init(&learned, GasIndexAlgorithm_ALGORITHM_TYPE_VOC);
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < 3600; t++) {
+        int32_t gas_index;
+        GasIndexAlgorithm_process(&learned, gi_sraw(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, t), &gas_index);
+    }
+    HOST_TEST_ESP_OK( gas_index_export_state(&learned, &blob) );
+
+    /* the blob crc is the zlib crc32 */
+    HOST_TEST_ASSERT( esp_rom_crc32_le(0, (const uint8_t *)"123456789", 9) == 0xcbf43926u );
+    memcpy(&bad, &blob, sizeof(bad));
+    test_reseal(&bad);
+    HOST_TEST_ASSERT( bad.crc == blob.crc );
+
+    GasIndexAlgorithm_init(&target, GasIndexAlgorithm_ALGORITHM_TYPE_NOX);
+    memcpy(&untouched, &target, sizeof(untouched));
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.magic ^= 0x0100;
+    test_reseal(&bad);
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_VERSION, gas_index_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.version = GAS_INDEX_STATE_BLOB_VERSION + 1;
+    test_reseal(&bad);
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_VERSION, gas_index_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    /* a flipped bit in the learned mean */
+    memcpy(&bad, &blob, sizeof(bad));
+    ((uint8_t *)&bad)[offsetof(gas_index_state_blob_t, mve_mean)] ^= 0x01;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_CRC, gas_index_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.crc ^= 0x80000000u;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_CRC, gas_index_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.sampling_interval = 0.0f;
+    test_reseal(&bad);
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_export_state(NULL, &blob) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_import_state(&target, NULL) );
+}
+
+static void test_fix16_state_rejected(void) {
+    gas_index_fix16_params_t     learned, target, untouched;
+    gas_index_fix16_state_blob_t blob, bad;
+
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&learned, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, 1.0f) );
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < 3600; t++) {
+        int32_t gas_index;
+        HOST_TEST_ESP_OK( gas_index_fix16_process(&learned, gi_sraw(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, t), &gas_index) );
+    }
+    HOST_TEST_ESP_OK( gas_index_fix16_export_state(&learned, &blob) );
+
+    HOST_TEST_ESP_OK( gas_index_fix16_init(&target, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 1.0f) );
+    memcpy(&untouched, &target, sizeof(untouched));
+
+    /* a float blob is not a fixed-point blob */
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.magic = GAS_INDEX_STATE_BLOB_MAGIC;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_VERSION, gas_index_fix16_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.version = 0;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_VERSION, gas_index_fix16_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    memcpy(&bad, &blob, sizeof(bad));
+    bad.mve_std += 1;
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_CRC, gas_index_fix16_import_state(&target, &bad) );
+    HOST_TEST_ASSERT( memcmp(&target, &untouched, sizeof(target)) == 0 );
+
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_export_state(&learned, NULL) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_fix16_import_state(NULL, &blob) );
+}
+
+static void test_process_batch(void) {
+    /* VOC and NOx instances of two sensors */
+    const int32_t types[4] = { GasIndexAlgorithm_ALGORITHM_TYPE_VOC, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, 
+                               GasIndexAlgorithm_ALGORITHM_TYPE_VOC, GasIndexAlgorithm_ALGORITHM_TYPE_NOX };
+    GasIndexAlgorithmParams scalar[4], batch[4];
+    int32_t mismatches = 0, max_index = 0;
+
+    HOST_TEST_ESP_OK( gas_index_init_batch(batch, types, GasIndexAlgorithm_DEFAULT_SAMPLING_INTERVAL, 4) );
+    for(int i = 0; i < 4; i++) {
+        GasIndexAlgorithm_init(&scalar[i], types[i]);
+        HOST_TEST_ASSERT( batch[i].mAlgorithm_Type == types[i] );
+    }
+
+    gi_rng_state = 31;
+    for(int32_t t = 0; t < 6 * 3600; t++) {
+        int32_t sraws[4], scalar_indexes[4], batch_indexes[4];
+        for(int i = 0; i < 4; i++) {
+            /* the second sensor reads a little higher */
+            sraws[i] = gi_sraw(types[i], t) + (i >= 2 ? 150 : 0);
+            GasIndexAlgorithm_process(&scalar[i], sraws[i], &scalar_indexes[i]);
+        }
+        HOST_TEST_ESP_OK( gas_index_process_batch(batch, sraws, batch_indexes, 4) );
+        for(int i = 0; i < 4; i++) {
+            if(batch_indexes[i] != scalar_indexes[i]) mismatches++;
+            if(batch_indexes[i] > max_index) max_index = batch_indexes[i];
+        }
+    }
+    HOST_TEST_ASSERT( mismatches == 0 );
+    HOST_TEST_ASSERT( max_index > 100 );
+
+    int32_t sraws[4] = { 0 }, indexes[4];
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_init_batch(batch, types, 0.0f, 4) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_init_batch(batch, NULL, 1.0f, 4) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_process_batch(batch, sraws, indexes, 0) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, gas_index_process_batch(batch, NULL, indexes, 4) );
+}
+
+int main(void) {
+    test_state_roundtrip(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, "voc");
+    test_state_roundtrip(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, "nox");
+    test_fix16_state_roundtrip(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, "voc");
+    test_fix16_state_roundtrip(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, "nox");
+    test_state_rejected();
+    test_fix16_state_rejected();
+    test_process_batch();
+    HOST_TEST_END();
+}
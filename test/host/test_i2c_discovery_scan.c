@@ -0,0 +1,218 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_i2c_discovery_scan.c
+ *
+ * I2C discovery test, a simulated bus with the device models is scanned and the 
+ * devices found, their fingerprinted types, the adapted probe timeout, driver 
+ * instantiation, a slow device and a bus fault are checked
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <i2c_discovery.h>
+#include <bmp280.h>
+#include "host_test.h"
+
+#define TEST_ADDRESS_COUNT      (I2C_DISCOVERY_ADDRESS_MAX - I2C_DISCOVERY_ADDRESS_MIN + 1)
+
+typedef struct test_device_s {
+    uint8_t                         address;
+    i2c_discovery_device_types_t    type;
+} test_device_t;
+
+static const test_device_t test_devices[] = {
+    { I2C_SIM_AHTXX_ADDRESS,    I2C_DISCOVERY_DEVICE_AHTXX },
+    { I2C_SIM_SSD1306_ADDRESS,  I2C_DISCOVERY_DEVICE_SSD1306 },
+    { I2C_SIM_INA228_ADDRESS,   I2C_DISCOVERY_DEVICE_INA228 },
+    { I2C_SIM_SHT4X_ADDRESS,    I2C_DISCOVERY_DEVICE_SHT4X },
+    { I2C_SIM_MPU6050_ADDRESS,  I2C_DISCOVERY_DEVICE_MPU6050 },
+    { I2C_SIM_BMP280_ADDRESS,   I2C_DISCOVERY_DEVICE_BMP280 },
+    { I2C_SIM_BMP390_ADDRESS,   I2C_DISCOVERY_DEVICE_BMP390 },
+};
+
+#define TEST_DEVICE_COUNT       (sizeof(test_devices) / sizeof(test_devices[0]))
+
+static i2c_discovery_result_t result;
+static uint32_t               full_scan_us;
+
+/* attaches the device models in address order and opens the bus */
+static i2c_master_bus_handle_t test_bus_init(void) {
+    i2c_sim_model_t *model;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_AHTXX_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_SSD1306_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_ina228_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_INA228_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_SHT4X_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_MPU6050_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_set_environment(model, 21.5f, 101325.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_BMP280_ADDRESS, model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, I2C_SIM_BMP390_ADDRESS, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    return bus_handle;
+}
+
+static bool test_is_timed_out(const uint8_t address) {
+    return (result.timed_out[address / 8] & (1u << (address % 8))) != 0;
+}
+
+static void test_print(const char *const name, const esp_err_t ret) {
+    printf("%-16s %-14s %u devices %3u probes %u timeouts bus fault %d probe timeout %2u ms %6lu us\n", name, esp_err_to_name(ret), 
+           result.device_count, result.probes, result.timeouts, result.bus_fault, result.probe_timeout_ms, (unsigned long)result.elapsed_us);
+}
+
+static esp_err_t test_bmp280_init(i2c_master_bus_handle_t bus_handle, const i2c_discovery_device_t *const device, void **const handle) {
+    bmp280_config_t dev_config = BMP280_CONFIG_DEFAULT;
+    dev_config.i2c_address = device->address;
+    return bmp280_init(bus_handle, &dev_config, (bmp280_handle_t *)handle);
+}
+
+/* every model is found in address order and identified by its chip identifier where it has one */
+static void test_full_scan(void) {
+    const i2c_discovery_config_t config = I2C_DISCOVERY_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    const esp_err_t ret = i2c_discovery_scan(bus_handle, &config, &result);
+    test_print("full scan", ret);
+    HOST_TEST_ESP_OK( ret );
+    HOST_TEST_ASSERT( result.probes >= TEST_ADDRESS_COUNT );
+    HOST_TEST_ASSERT( result.timeouts == 0 && result.bus_fault == false );
+    HOST_TEST_ASSERT( result.device_count == TEST_DEVICE_COUNT );
+    full_scan_us = result.elapsed_us;
+    for(size_t i = 0; i < TEST_DEVICE_COUNT && i < result.device_count; i++) {
+        i2c_sim_stats_t stats;
+        HOST_TEST_ESP_OK( i2c_sim_get_device_stats(I2C_NUM_0, test_devices[i].address, &stats) );
+        HOST_TEST_ASSERT( stats.probes == 1 );
+        HOST_TEST_ASSERT( result.devices[i].address == test_devices[i].address );
+        HOST_TEST_ASSERT( result.devices[i].type == test_devices[i].type );
+        HOST_TEST_ASSERT( i2c_discovery_is_present(&result, test_devices[i].address) );
+    }
+    HOST_TEST_ASSERT( !i2c_discovery_is_present(&result, I2C_SIM_MAX30105_ADDRESS) );
+
+    /* the probe timeout adapts to the completed probes */
+    HOST_TEST_ASSERT( result.probe_timeout_ms == config.probe_timeout_min_ms );
+
+    /* a discovered device is instantiated with its driver */
+    const i2c_discovery_driver_t drivers[] = { { I2C_DISCOVERY_DEVICE_BMP280, test_bmp280_init } };
+    const i2c_discovery_device_t *device = NULL;
+    float temperature = 0, pressure = 0;
+    HOST_TEST_ESP_OK( i2c_discovery_instantiate(bus_handle, &result, drivers, 1) );
+    HOST_TEST_ESP_OK( i2c_discovery_find_device(&result, I2C_DISCOVERY_DEVICE_BMP280, &device) );
+    HOST_TEST_ASSERT( device && device->handle );
+    if(device && device->handle) {
+        HOST_TEST_ESP_OK( bmp280_get_measurements((bmp280_handle_t)device->handle, &temperature, &pressure) );
+        HOST_TEST_NEAR( 21.5f, temperature, 0.05f );
+        HOST_TEST_ESP_OK( bmp280_delete((bmp280_handle_t)device->handle) );
+    }
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FOUND, i2c_discovery_find_device(&result, I2C_DISCOVERY_DEVICE_VEML7700, &device) );
+
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* only the addresses of the repository drivers are probed */
+static void test_known_addresses(void) {
+    i2c_discovery_config_t config = I2C_DISCOVERY_CONFIG_DEFAULT;
+    config.known_addresses_only = true;
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    const esp_err_t ret = i2c_discovery_scan(bus_handle, &config, &result);
+    test_print("known addresses", ret);
+    HOST_TEST_ESP_OK( ret );
+    HOST_TEST_ASSERT( result.probes < TEST_ADDRESS_COUNT );
+    HOST_TEST_ASSERT( result.device_count == TEST_DEVICE_COUNT );
+
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* a device that times out or does not acknowledge is skipped, the scan completes */
+static void test_slow_device(void) {
+    const i2c_discovery_config_t config = I2C_DISCOVERY_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    HOST_TEST_ESP_OK( i2c_sim_inject_timeouts(I2C_NUM_0, I2C_SIM_SHT4X_ADDRESS, 1) );
+    HOST_TEST_ESP_OK( i2c_sim_inject_nacks(I2C_NUM_0, I2C_SIM_MPU6050_ADDRESS, 1) );
+    const esp_err_t ret = i2c_discovery_scan(bus_handle, &config, &result);
+    test_print("slow device", ret);
+    HOST_TEST_ESP_OK( ret );
+    HOST_TEST_ASSERT( result.probes >= TEST_ADDRESS_COUNT );
+    HOST_TEST_ASSERT( result.timeouts == 1 && result.bus_fault == false );
+    HOST_TEST_ASSERT( result.device_count == TEST_DEVICE_COUNT - 2 );
+    HOST_TEST_ASSERT( test_is_timed_out(I2C_SIM_SHT4X_ADDRESS) );
+    HOST_TEST_ASSERT( !i2c_discovery_is_present(&result, I2C_SIM_SHT4X_ADDRESS) );
+    HOST_TEST_ASSERT( !i2c_discovery_is_present(&result, I2C_SIM_MPU6050_ADDRESS) );
+
+    /* the adapted timeout bounds the wait on the slow device */
+    HOST_TEST_ASSERT( result.elapsed_us <= full_scan_us + (uint32_t)config.probe_timeout_min_ms * 1000 );
+
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* consecutive probe timeouts stop the scan as a bus fault without waiting the full timeout on every address */
+static void test_bus_fault(void) {
+    const i2c_discovery_config_t config = I2C_DISCOVERY_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    HOST_TEST_ESP_OK( i2c_sim_set_bus_fault(I2C_NUM_0, true) );
+    esp_err_t ret = i2c_discovery_scan(bus_handle, &config, &result);
+    test_print("bus fault", ret);
+    HOST_TEST_ESP_ERR( ESP_ERR_TIMEOUT, ret );
+    HOST_TEST_ASSERT( result.bus_fault == true );
+    HOST_TEST_ASSERT( result.probes == config.bus_fault_timeouts );
+    HOST_TEST_ASSERT( result.timeouts == config.bus_fault_timeouts );
+    HOST_TEST_ASSERT( result.device_count == 0 );
+    HOST_TEST_ASSERT( result.elapsed_us <= (uint32_t)(config.probe_timeout_ms + (config.bus_fault_timeouts - 1) * config.probe_timeout_min_ms) * 1000 + 1000 );
+
+    /* the bus recovers */
+    HOST_TEST_ESP_OK( i2c_sim_set_bus_fault(I2C_NUM_0, false) );
+    ret = i2c_discovery_scan(bus_handle, &config, &result);
+    test_print("recovered", ret);
+    HOST_TEST_ESP_OK( ret );
+    HOST_TEST_ASSERT( result.device_count == TEST_DEVICE_COUNT );
+
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_NONE);
+    test_full_scan();
+    test_known_addresses();
+    test_slow_device();
+    test_bus_fault();
+    HOST_TEST_END();
+}
@@ -0,0 +1,384 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_i2c_regcache_drivers.c
+ *
+ * I2C register cache test, the cache hits, volatile registers, pair and burst 
+ * writes and invalidation are checked against a register file model, and the 
+ * transactions of the cached BMP280, BME680 and AS7341 driver settings are counted
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <i2c_regcache.h>
+#include <bmp280.h>
+#include <bme680.h>
+#include <as7341.h>
+#include "host_test.h"
+
+#define REGFILE_ADDRESS         UINT8_C(0x50)
+#define REGFILE_WINDOW          UINT8_C(0x10)
+#define REGFILE_WINDOW_SIZE     UINT8_C(8)
+#define REGFILE_VOLATILE        UINT8_C(0x12)
+
+#define BME680_CONVERSION_US    (320000)
+
+/**
+ * register file model, auto-increment reads and either auto-increment or register and value pair writes
+ */
+typedef struct test_regfile_s {
+    uint8_t     regs[256];
+    uint8_t     pointer;
+    bool        pair_writes;
+    int64_t     start_time;     /* bme680 forced conversion start */
+} test_regfile_t;
+
+static esp_err_t test_regfile_write(void *const context, const uint8_t *const buffer, const size_t size) {
+    test_regfile_t *const regfile = (test_regfile_t *)context;
+    regfile->pointer = buffer[0];
+    if (regfile->pair_writes) {
+        for(size_t i = 1; i < size; i += 2) regfile->regs[buffer[i - 1]] = buffer[i];
+    } else {
+        for(size_t i = 1; i < size; i++) regfile->regs[regfile->pointer++] = buffer[i];
+    }
+    return ESP_OK;
+}
+
+static esp_err_t test_regfile_read(void *const context, uint8_t *const buffer, const size_t size) {
+    test_regfile_t *const regfile = (test_regfile_t *)context;
+    for(size_t i = 0; i < size; i++) buffer[i] = regfile->regs[regfile->pointer++];
+    return ESP_OK;
+}
+
+/* bme680, register and value pair writes, a forced conversion completes after the conversion time */
+static void test_bme680_update(test_regfile_t *const regfile) {
+    if ((regfile->regs[0x74] & 0x03) == 0x01 && i2c_sim_get_time_us() - regfile->start_time >= BME680_CONVERSION_US) {
+        regfile->regs[0x74] &= ~0x03;
+        regfile->regs[0x1d] |= 0x80;
+    }
+}
+
+static esp_err_t test_bme680_write(void *const context, const uint8_t *const buffer, const size_t size) {
+    test_regfile_t *const regfile = (test_regfile_t *)context;
+    test_bme680_update(regfile);
+    for(size_t i = 1; i < size; i += 2) {
+        if (buffer[i - 1] == 0xe0 && buffer[i] == 0xb6) memset(&regfile->regs[0x70], 0, 6);
+        if (buffer[i - 1] == 0x74 && (buffer[i] & 0x03) == 0x01) {
+            regfile->start_time = i2c_sim_get_time_us();
+            regfile->regs[0x1d] &= ~0x80;
+        }
+    }
+    return test_regfile_write(context, buffer, size);
+}
+
+static esp_err_t test_bme680_read(void *const context, uint8_t *const buffer, const size_t size) {
+    test_bme680_update((test_regfile_t *)context);
+    return test_regfile_read(context, buffer, size);
+}
+
+/* as7341, auto-increment writes, the SMUX enable bit clears itself */
+static esp_err_t test_as7341_write(void *const context, const uint8_t *const buffer, const size_t size) {
+    test_regfile_t *const regfile = (test_regfile_t *)context;
+    const esp_err_t ret = test_regfile_write(context, buffer, size);
+    regfile->regs[0x80] &= ~0x10;
+    return ret;
+}
+
+static test_regfile_t *test_add_regfile(const uint16_t address, const bool pair_writes, 
+                                        esp_err_t (*write)(void *const, const uint8_t *const, const size_t), 
+                                        esp_err_t (*read)(void *const, uint8_t *const, const size_t)) {
+    static test_regfile_t regfiles[2];
+    static uint8_t count = 0;
+    test_regfile_t *const regfile = &regfiles[count++ % 2];
+    i2c_sim_model_t *const model = (i2c_sim_model_t *)calloc(1, sizeof(i2c_sim_model_t));
+
+    memset(regfile, 0, sizeof(test_regfile_t));
+    regfile->pair_writes = pair_writes;
+    model->name    = "regfile";
+    model->context = regfile;
+    model->write   = write;
+    model->read    = read;
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, address, model) );
+    return regfile;
+}
+
+static i2c_master_bus_handle_t test_bus_init(void) {
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    return bus_handle;
+}
+
+/* gets the transactions and bytes since the last call */
+static i2c_sim_stats_t test_phase(const char *const name) {
+    i2c_sim_stats_t stats;
+    i2c_sim_get_stats(&stats);
+    printf("%-30s %3lu transactions %4llu bytes written %4llu bytes read\n", name, (unsigned long)stats.transactions, 
+           (unsigned long long)stats.bytes_written, (unsigned long long)stats.bytes_read);
+    i2c_sim_reset_stats();
+    return stats;
+}
+
+static void test_regcache(void) {
+    uint8_t values[REGFILE_WINDOW_SIZE];
+    uint8_t value;
+
+    i2c_sim_reset();
+    test_regfile_t *regfile = test_add_regfile(REGFILE_ADDRESS, false, test_regfile_write, test_regfile_read);
+    for(uint8_t i = 0; i < REGFILE_WINDOW_SIZE; i++) regfile->regs[REGFILE_WINDOW + i] = (uint8_t)(0xa0 + i);
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    const i2c_device_config_t dev_config = { .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = REGFILE_ADDRESS, .scl_speed_hz = 100000 };
+    i2c_master_dev_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_master_bus_add_device(bus_handle, &dev_config, &dev_handle) );
+
+    i2c_regcache_t cache;
+    i2c_regcache_config_t config = I2C_REGCACHE_CONFIG_DEFAULT;
+    config.first_register = REGFILE_WINDOW;
+    config.size           = REGFILE_WINDOW_SIZE;
+    config.volatile_mask  = 1u << (REGFILE_VOLATILE - REGFILE_WINDOW);
+    HOST_TEST_ESP_OK( i2c_regcache_init(&cache, dev_handle, &config) );
+    i2c_sim_reset_stats();
+
+    /* the first read fills the cache in one transaction */
+    HOST_TEST_ESP_OK( i2c_regcache_read(&cache, REGFILE_WINDOW, values, REGFILE_WINDOW_SIZE) );
+    i2c_sim_stats_t stats = test_phase("regcache cold read");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_read == REGFILE_WINDOW_SIZE );
+    HOST_TEST_ASSERT( values[0] == 0xa0 && values[REGFILE_WINDOW_SIZE - 1] == 0xa0 + REGFILE_WINDOW_SIZE - 1 );
+
+    /* only the volatile register is read again */
+    regfile->regs[REGFILE_VOLATILE] = 0x5a;
+    HOST_TEST_ESP_OK( i2c_regcache_read(&cache, REGFILE_WINDOW, values, REGFILE_WINDOW_SIZE) );
+    stats = test_phase("regcache warm read");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_read == 1 );
+    HOST_TEST_ASSERT( values[REGFILE_VOLATILE - REGFILE_WINDOW] == 0x5a );
+    HOST_TEST_ESP_OK( i2c_regcache_read_byte(&cache, REGFILE_WINDOW, &value) );
+    stats = test_phase("regcache cached byte read");
+    HOST_TEST_ASSERT( stats.transactions == 0 && value == 0xa0 );
+
+    /* writes are always sent, the written value is served from the cache */
+    HOST_TEST_ESP_OK( i2c_regcache_write_byte(&cache, REGFILE_WINDOW, 0x11) );
+    HOST_TEST_ESP_OK( i2c_regcache_write_byte(&cache, REGFILE_WINDOW, 0x11) );
+    HOST_TEST_ESP_OK( i2c_regcache_read_byte(&cache, REGFILE_WINDOW, &value) );
+    stats = test_phase("regcache 2 writes + read");
+    HOST_TEST_ASSERT( stats.transactions == 2 && value == 0x11 && regfile->regs[REGFILE_WINDOW] == 0x11 );
+
+    /* a read-modify-write of a cached register is a single write */
+    HOST_TEST_ESP_OK( i2c_regcache_update_bits(&cache, REGFILE_WINDOW + 1, 0x0f, 0x05) );
+    stats = test_phase("regcache update bits");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_read == 0 );
+    HOST_TEST_ASSERT( regfile->regs[REGFILE_WINDOW + 1] == 0xa5 );
+
+    /* a burst write is the register and the values */
+    const uint8_t burst[3] = { 0x21, 0x22, 0x23 };
+    HOST_TEST_ESP_OK( i2c_regcache_write(&cache, REGFILE_WINDOW + 4, burst, sizeof(burst)) );
+    stats = test_phase("regcache burst write");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_written == 1 + sizeof(burst) );
+    HOST_TEST_ASSERT( regfile->regs[REGFILE_WINDOW + 6] == 0x23 );
+
+    /* a stored value changes the cache without a transaction, an invalidated register is read from the device */
+    HOST_TEST_ESP_OK( i2c_regcache_store(&cache, REGFILE_WINDOW + 3, 0x77) );
+    HOST_TEST_ESP_OK( i2c_regcache_read_byte(&cache, REGFILE_WINDOW + 3, &value) );
+    HOST_TEST_ASSERT( value == 0x77 );
+    HOST_TEST_ESP_OK( i2c_regcache_invalidate_range(&cache, REGFILE_WINDOW + 3, 1) );
+    HOST_TEST_ESP_OK( i2c_regcache_read_byte(&cache, REGFILE_WINDOW + 3, &value) );
+    stats = test_phase("regcache store + invalidate");
+    HOST_TEST_ASSERT( stats.transactions == 1 && value == regfile->regs[REGFILE_WINDOW + 3] );
+
+    /* a full invalidation reads the window from the device again */
+    HOST_TEST_ESP_OK( i2c_regcache_invalidate(&cache) );
+    HOST_TEST_ESP_OK( i2c_regcache_read(&cache, REGFILE_WINDOW, values, REGFILE_WINDOW_SIZE) );
+    stats = test_phase("regcache invalidate + read");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_read == REGFILE_WINDOW_SIZE );
+
+    HOST_TEST_ESP_OK( i2c_master_bus_rm_device(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+
+    /* pair writes send a register and value pair per register */
+    i2c_sim_reset();
+    regfile = test_add_regfile(REGFILE_ADDRESS, true, test_regfile_write, test_regfile_read);
+    bus_handle = test_bus_init();
+    HOST_TEST_ESP_OK( i2c_master_bus_add_device(bus_handle, &dev_config, &dev_handle) );
+    config.pair_writes = true;
+    HOST_TEST_ESP_OK( i2c_regcache_init(&cache, dev_handle, &config) );
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( i2c_regcache_write(&cache, REGFILE_WINDOW, burst, sizeof(burst)) );
+    stats = test_phase("regcache pair write");
+    HOST_TEST_ASSERT( stats.transactions == 1 && stats.bytes_written == 2 * sizeof(burst) );
+    HOST_TEST_ASSERT( regfile->regs[REGFILE_WINDOW] == 0x21 && regfile->regs[REGFILE_WINDOW + 2] == 0x23 );
+
+    HOST_TEST_ESP_OK( i2c_master_bus_rm_device(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* bmp280 settings are served from the cache, a reset invalidates it */
+static void test_bmp280(void) {
+    i2c_sim_model_t *model;
+    bmp280_config_t dev_config = BMP280_CONFIG_DEFAULT;
+    bmp280_pressure_oversampling_t pressure_oversampling;
+    bmp280_temperature_oversampling_t temperature_oversampling;
+    bmp280_iir_filters_t iir_filter;
+    bmp280_standby_times_t standby_time;
+    bmp280_power_modes_t power_mode;
+    float temperature, pressure;
+
+    dev_config.power_mode = BMP280_POWER_MODE_FORCED;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_set_environment(model, 21.5f, 101325.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    bmp280_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( bmp280_init(bus_handle, &dev_config, &dev_handle) );
+    test_phase("bmp280 init");
+
+    /* a forced measurement writes the cached control register without reading it */
+    HOST_TEST_ESP_OK( bmp280_get_measurements(dev_handle, &temperature, &pressure) );
+    i2c_sim_stats_t stats = test_phase("bmp280 forced measurement");
+    HOST_TEST_ASSERT( stats.transactions == 2 );
+    HOST_TEST_NEAR( 21.5f, temperature, 0.05f );
+
+    /* a setting is one write, reading the settings back is served from the cache */
+    HOST_TEST_ESP_OK( bmp280_set_pressure_oversampling(dev_handle, BMP280_PRESSURE_OVERSAMPLING_4X) );
+    HOST_TEST_ESP_OK( bmp280_set_temperature_oversampling(dev_handle, BMP280_TEMPERATURE_OVERSAMPLING_2X) );
+    HOST_TEST_ESP_OK( bmp280_set_iir_filter(dev_handle, BMP280_IIR_FILTER_4) );
+    HOST_TEST_ESP_OK( bmp280_set_standby_time(dev_handle, BMP280_STANDBY_TIME_250MS) );
+    stats = test_phase("bmp280 4 settings");
+    HOST_TEST_ASSERT( stats.transactions == 4 && stats.bytes_read == 0 );
+    HOST_TEST_ESP_OK( bmp280_get_pressure_oversampling(dev_handle, &pressure_oversampling) );
+    HOST_TEST_ESP_OK( bmp280_get_temperature_oversampling(dev_handle, &temperature_oversampling) );
+    HOST_TEST_ESP_OK( bmp280_get_iir_filter(dev_handle, &iir_filter) );
+    HOST_TEST_ESP_OK( bmp280_get_standby_time(dev_handle, &standby_time) );
+    HOST_TEST_ESP_OK( bmp280_get_power_mode(dev_handle, &power_mode) );
+    stats = test_phase("bmp280 5 settings read back");
+    HOST_TEST_ASSERT( stats.transactions == 0 );
+    HOST_TEST_ASSERT( pressure_oversampling == BMP280_PRESSURE_OVERSAMPLING_4X );
+    HOST_TEST_ASSERT( temperature_oversampling == BMP280_TEMPERATURE_OVERSAMPLING_2X );
+    HOST_TEST_ASSERT( iir_filter == BMP280_IIR_FILTER_4 );
+    HOST_TEST_ASSERT( standby_time == BMP280_STANDBY_TIME_250MS );
+
+    /* a reset invalidates the cache and the setup writes the configured settings again */
+    HOST_TEST_ESP_OK( bmp280_reset(dev_handle) );
+    test_phase("bmp280 reset");
+    HOST_TEST_ESP_OK( bmp280_get_pressure_oversampling(dev_handle, &pressure_oversampling) );
+    HOST_TEST_ESP_OK( bmp280_get_iir_filter(dev_handle, &iir_filter) );
+    stats = test_phase("bmp280 2 settings after reset");
+    HOST_TEST_ASSERT( stats.transactions == 0 );
+    HOST_TEST_ASSERT( pressure_oversampling == dev_config.pressure_oversampling );
+    HOST_TEST_ASSERT( iir_filter == dev_config.iir_filter );
+
+    HOST_TEST_ESP_OK( bmp280_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* bme680 control registers are served from the cache, the register and value pairs reach the device */
+static void test_bme680(void) {
+    bme680_config_t dev_config = BME680_CONFIG_DEFAULT;
+    bme680_adc_data_t adc_data;
+    bme680_power_modes_t power_mode;
+    bme680_iir_filters_t iir_filter;
+
+    i2c_sim_reset();
+    test_regfile_t *regfile = test_add_regfile(dev_config.i2c_address, true, test_bme680_write, test_bme680_read);
+    for(int i = 0x8a; i <= 0xee; i++) regfile->regs[i] = (uint8_t)(i * 7 + 3);
+    for(int i = 0x1f; i <= 0x2b; i++) regfile->regs[i] = (uint8_t)(i * 13);
+    regfile->regs[0xd0] = 0x61;
+    regfile->regs[0x1d] = 0x05;
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    bme680_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( bme680_init(bus_handle, &dev_config, &dev_handle) );
+    test_phase("bme680 init");
+
+    HOST_TEST_ESP_OK( bme680_get_adc_signals(dev_handle, &adc_data) );
+    i2c_sim_stats_t stats = test_phase("bme680 forced adc read");
+    HOST_TEST_ASSERT( stats.transactions == 2 );
+
+    HOST_TEST_ESP_OK( bme680_set_iir_filter(dev_handle, BME680_IIR_FILTER_3) );
+    HOST_TEST_ESP_OK( bme680_set_humidity_oversampling(dev_handle, BME680_HUMIDITY_OVERSAMPLING_2X) );
+    stats = test_phase("bme680 2 settings");
+    HOST_TEST_ASSERT( stats.transactions == 2 && stats.bytes_read == 0 );
+    HOST_TEST_ASSERT( (regfile->regs[0x75] >> 2 & 0x07) == BME680_IIR_FILTER_3 );
+    HOST_TEST_ASSERT( (regfile->regs[0x72] & 0x07) == BME680_HUMIDITY_OVERSAMPLING_2X );
+
+    HOST_TEST_ESP_OK( bme680_get_iir_filter(dev_handle, &iir_filter) );
+    HOST_TEST_ESP_OK( bme680_get_power_mode(dev_handle, &power_mode) );
+    stats = test_phase("bme680 2 settings read back");
+    HOST_TEST_ASSERT( stats.transactions == 0 );
+    HOST_TEST_ASSERT( iir_filter == BME680_IIR_FILTER_3 );
+
+    HOST_TEST_ESP_OK( bme680_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+/* as7341 enable and integration time registers are served from the cache */
+static void test_as7341(void) {
+    as7341_config_t dev_config = AS7341_CONFIG_DEFAULT;
+    as7341_channels_spectral_data_t spectral_data;
+    uint8_t atime;
+
+    i2c_sim_reset();
+    test_regfile_t *regfile = test_add_regfile(dev_config.i2c_address, false, test_as7341_write, test_regfile_read);
+    regfile->regs[0x92] = 0x09 << 2;
+    regfile->regs[0xcb] = 0x02;
+    regfile->regs[0xa3] = 0x41;
+    for(int i = 0x95; i <= 0xa0; i++) regfile->regs[i] = (uint8_t)(i * 11);
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    as7341_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( as7341_init(bus_handle, &dev_config, &dev_handle) );
+    test_phase("as7341 init");
+
+    HOST_TEST_ESP_OK( as7341_get_atime(dev_handle, &atime) );
+    i2c_sim_stats_t stats = test_phase("as7341 atime read back");
+    HOST_TEST_ASSERT( stats.transactions == 0 );
+    HOST_TEST_ASSERT( atime == dev_config.atime && regfile->regs[0x81] == dev_config.atime );
+
+    HOST_TEST_ESP_OK( as7341_get_spectral_measurements(dev_handle, &spectral_data) );
+    test_phase("as7341 spectral measurement");
+
+    HOST_TEST_ESP_OK( as7341_set_atime(dev_handle, 50) );
+    HOST_TEST_ESP_OK( as7341_get_atime(dev_handle, &atime) );
+    stats = test_phase("as7341 atime write + read");
+    HOST_TEST_ASSERT( stats.transactions == 1 && atime == 50 && regfile->regs[0x81] == 50 );
+
+    HOST_TEST_ESP_OK( as7341_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_regcache();
+    test_bmp280();
+    test_bme680();
+    test_as7341();
+    HOST_TEST_END();
+}
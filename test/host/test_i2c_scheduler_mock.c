@@ -0,0 +1,231 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_i2c_scheduler_mock.c
+ *
+ * I2C scheduler dispatch test, jobs with mock device phases are dispatched 
+ * against a mock clock that advances by the bus time of each phase, the 
+ * dispatch order, fixed-rate releases, re-armed collect phases of a two 
+ * phase (SMUX) conversion, overruns, deadline misses and bus utilization are 
+ * checked
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <esp_log.h>
+#include <i2c_scheduler.h>
+#include "host_test.h"
+
+#define MOCK_LOG_MAX        (64)
+
+/* mock device, a phase occupies the bus for its bus time and is logged */
+typedef struct mock_device_s {
+    const char  *name;
+    uint32_t    start_bus_us;       /* bus time of the start phase */
+    uint32_t    collect_bus_us;     /* bus time of the collect phase */
+    uint32_t    wait_us;            /* conversion wait returned by the start phase */
+    uint8_t     phases;             /* collect phases per conversion, the earlier collects return not finished */
+    uint8_t     phase;              /* collect phase of the current conversion */
+    uint32_t    collect_count;      /* completed conversions */
+} mock_device_t;
+
+static int64_t mock_time;
+static const char *mock_log[MOCK_LOG_MAX];
+static int mock_log_count;
+
+static int64_t mock_clock(void) {
+    return mock_time;
+}
+
+static void mock_bus(const char *name, const uint32_t bus_us) {
+    if(mock_log_count < MOCK_LOG_MAX) mock_log[mock_log_count++] = name;
+    mock_time += bus_us;
+}
+
+static esp_err_t mock_start(void *device_handle, void *context, uint32_t *const wait_us) {
+    mock_device_t *device = (mock_device_t*)device_handle;
+    mock_bus(device->name, device->start_bus_us);
+    device->phase = 0;
+    *wait_us = device->wait_us;
+    return ESP_OK;
+}
+
+static esp_err_t mock_collect(void *device_handle, void *context) {
+    mock_device_t *device = (mock_device_t*)device_handle;
+    mock_bus(device->name, device->collect_bus_us);
+    if(++device->phase < device->phases) return ESP_ERR_NOT_FINISHED;
+    device->collect_count++;
+    return ESP_OK;
+}
+
+/* dispatches until the mock clock reaches the end time, the clock jumps to the next event when idle */
+static void mock_run(i2c_scheduler_handle_t handle, const int64_t end_time) {
+    while(mock_time < end_time) {
+        int64_t next_time = INT64_MAX;
+        HOST_TEST_ESP_OK( i2c_scheduler_dispatch(handle, &next_time) );
+        if(next_time > mock_time) mock_time = next_time < end_time ? next_time : end_time;
+    }
+}
+
+static i2c_scheduler_handle_t mock_init(void) {
+    i2c_scheduler_config_t config = I2C_SCHEDULER_CONFIG_DEFAULT;
+    i2c_scheduler_handle_t handle = NULL;
+
+    mock_time      = 1000000;
+    mock_log_count = 0;
+    config.clock   = mock_clock;
+    HOST_TEST_ESP_OK( i2c_scheduler_init(&config, &handle) );
+    return handle;
+}
+
+static i2c_scheduler_job_handle_t mock_add_job(i2c_scheduler_handle_t handle, mock_device_t *device, const uint32_t period_us,
+                                               const uint32_t deadline_us, const uint8_t priority, const bool two_phase) {
+    const i2c_scheduler_job_config_t job_config = {
+        .name           = device->name,
+        .device_handle  = device,
+        .start          = two_phase ? mock_start : NULL,
+        .collect        = mock_collect,
+        .period_us      = period_us,
+        .deadline_us    = deadline_us,
+        .priority       = priority };
+    i2c_scheduler_job_handle_t job_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_scheduler_add_job(handle, &job_config, &job_handle) );
+    return job_handle;
+}
+
+/* a conversion of one device overlaps the phases of the others, higher priority phases are dispatched first */
+static void test_dispatch(void) {
+    mock_device_t bmp = { .name = "bmp", .start_bus_us = 200, .collect_bus_us = 600, .wait_us = 40000, .phases = 1 };
+    mock_device_t ina = { .name = "ina", .collect_bus_us = 300, .phases = 1 };
+    i2c_scheduler_job_stats_t stats;
+    i2c_scheduler_stats_t bus_stats;
+
+    i2c_scheduler_handle_t handle = mock_init();
+    if(handle == NULL) return;
+    i2c_scheduler_job_handle_t bmp_job = mock_add_job(handle, &bmp, 100000, 0, 1, true);
+    i2c_scheduler_job_handle_t ina_job = mock_add_job(handle, &ina, 10000, 2000, 2, false);
+
+    mock_run(handle, mock_time + 1000000);
+
+    /* both are released together, the higher priority single phase job goes first */
+    HOST_TEST_ASSERT( mock_log_count > 2 && strcmp(mock_log[0], "ina") == 0 && strcmp(mock_log[1], "bmp") == 0 );
+    HOST_TEST_ASSERT( bmp.collect_count == 10 && ina.collect_count == 100 );
+
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, ina_job, &stats) );
+    printf("ina: %lu runs, jitter %lu..%lu us, response max %lu us, %lu deadline misses\n", (unsigned long)stats.run_count, 
+           (unsigned long)stats.jitter_min_us, (unsigned long)stats.jitter_max_us, (unsigned long)stats.response_max_us, (unsigned long)stats.deadline_miss_count);
+    HOST_TEST_ASSERT( stats.run_count == 100 && stats.error_count == 0 && stats.overrun_count == 0 );
+    HOST_TEST_ASSERT( stats.jitter_max_us <= 600 && stats.deadline_miss_count == 0 );
+
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, bmp_job, &stats) );
+    printf("bmp: %lu runs, jitter %lu..%lu us, response max %lu us\n", (unsigned long)stats.run_count, 
+           (unsigned long)stats.jitter_min_us, (unsigned long)stats.jitter_max_us, (unsigned long)stats.response_max_us);
+    HOST_TEST_ASSERT( stats.run_count == 10 && stats.error_count == 0 && stats.not_finished_count == 0 );
+    HOST_TEST_ASSERT( stats.response_max_us >= 40800 && stats.response_max_us <= 40800 + 2 * 300 + 300 );
+
+    /* the bus is busy for the phases only, the conversion waits are free for other jobs */
+    HOST_TEST_ESP_OK( i2c_scheduler_get_stats(handle, &bus_stats) );
+    printf("bus: %lu phases, %llu us busy, %.2f %% utilization\n", (unsigned long)bus_stats.phase_count, 
+           (unsigned long long)bus_stats.busy_us, bus_stats.utilization);
+    HOST_TEST_ASSERT( bus_stats.phase_count == 120 );
+    HOST_TEST_ASSERT( bus_stats.busy_us == 10 * 800 + 100 * 300 );
+    HOST_TEST_NEAR( 3.8f, bus_stats.utilization, 0.01f );
+
+    HOST_TEST_ESP_OK( i2c_scheduler_delete(handle) );
+}
+
+/* a second smux phase is collected again after the start phase wait, it is not an error */
+static void test_not_finished(void) {
+    mock_device_t as = { .name = "as7341", .start_bus_us = 300, .collect_bus_us = 1500, .wait_us = 50000, .phases = 2 };
+    i2c_scheduler_job_stats_t stats;
+
+    i2c_scheduler_handle_t handle = mock_init();
+    if(handle == NULL) return;
+    i2c_scheduler_job_handle_t as_job = mock_add_job(handle, &as, 200000, 0, 1, true);
+
+    mock_run(handle, mock_time + 1000000);
+
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, as_job, &stats) );
+    printf("as7341: %lu runs, %lu not finished, %lu errors, response max %lu us\n", (unsigned long)stats.run_count, 
+           (unsigned long)stats.not_finished_count, (unsigned long)stats.error_count, (unsigned long)stats.response_max_us);
+    HOST_TEST_ASSERT( as.collect_count == 5 && stats.run_count == 5 );
+    HOST_TEST_ASSERT( stats.not_finished_count == 5 && stats.error_count == 0 );
+    HOST_TEST_ASSERT( stats.response_max_us == 300 + 50000 + 1500 + 50000 + 1500 );
+
+    /* a conversion that is not finished within the period is an error and the next release starts over */
+    as.phases = 4;
+    HOST_TEST_ESP_OK( i2c_scheduler_reset_stats(handle) );
+    mock_run(handle, mock_time + 1000000);
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, as_job, &stats) );
+    printf("as7341 4 phases: %lu runs, %lu not finished, %lu errors\n", (unsigned long)stats.run_count, 
+           (unsigned long)stats.not_finished_count, (unsigned long)stats.error_count);
+    HOST_TEST_ASSERT( stats.run_count == 0 && stats.error_count == 5 && stats.not_finished_count == 10 );
+    HOST_TEST_ASSERT( stats.overrun_count == 0 );
+
+    HOST_TEST_ESP_OK( i2c_scheduler_delete(handle) );
+}
+
+/* a blocking phase of a low priority job delays a high priority job past its deadline, a stalled clock skips releases */
+static void test_overrun(void) {
+    mock_device_t slow = { .name = "slow", .collect_bus_us = 8000, .phases = 1 };
+    mock_device_t fast = { .name = "fast", .collect_bus_us = 100, .phases = 1 };
+    i2c_scheduler_job_stats_t stats;
+
+    i2c_scheduler_handle_t handle = mock_init();
+    if(handle == NULL) return;
+    mock_add_job(handle, &slow, 50000, 0, 1, false);
+    mock_time += 1;
+    i2c_scheduler_job_handle_t fast_job = mock_add_job(handle, &fast, 10000, 5000, 2, false);
+    mock_time -= 1;
+
+    mock_run(handle, mock_time + 100000);
+
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, fast_job, &stats) );
+    printf("fast: %lu runs, %lu deadline misses, jitter max %lu us\n", (unsigned long)stats.run_count, 
+           (unsigned long)stats.deadline_miss_count, (unsigned long)stats.jitter_max_us);
+    HOST_TEST_ASSERT( stats.run_count == 10 && stats.deadline_miss_count == 2 );
+    HOST_TEST_ASSERT( stats.jitter_max_us == 8000 - 1 );
+
+    /* the clock jumps 3.5 periods without a dispatch, the missed releases are skipped and the phase is kept */
+    HOST_TEST_ESP_OK( i2c_scheduler_reset_stats(handle) );
+    mock_time += 35000;
+    mock_run(handle, mock_time + 5000);
+    HOST_TEST_ESP_OK( i2c_scheduler_get_job_stats(handle, fast_job, &stats) );
+    printf("fast stalled: %lu runs, %lu overruns\n", (unsigned long)stats.run_count, (unsigned long)stats.overrun_count);
+    HOST_TEST_ASSERT( stats.overrun_count == 3 && stats.run_count == 1 );
+
+    HOST_TEST_ESP_OK( i2c_scheduler_delete(handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    test_dispatch();
+    test_not_finished();
+    test_overrun();
+
+    HOST_TEST_END();
+}
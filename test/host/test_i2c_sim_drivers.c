@@ -0,0 +1,345 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_i2c_sim_drivers.c
+ *
+ * Driver regression test on the I2C bus simulator, every simulated driver is
+ * initialized and its measurements are checked against the device model inputs
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <bmp280.h>
+#include <bmp390.h>
+#include <sht4x.h>
+#include <ahtxx.h>
+#include <ina228.h>
+#include <ina226.h>
+#include <hdc1080.h>
+#include <mpu6050.h>
+#include <ssd1306.h>
+#include "host_test.h"
+
+static i2c_master_bus_handle_t test_bus_init(void) {
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    return bus_handle;
+}
+
+static void test_bmp280(void) {
+    i2c_sim_model_t *model;
+    bmp280_config_t dev_config = BMP280_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_set_environment(model, 21.5f, 101325.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    bmp280_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( bmp280_init(bus_handle, &dev_config, &dev_handle) );
+
+    for(int i = 0; i < 3; i++) {
+        float temperature = 0, pressure = 0;
+        HOST_TEST_ESP_OK( bmp280_get_measurements(dev_handle, &temperature, &pressure) );
+        HOST_TEST_NEAR(21.5, temperature, 0.05);
+        HOST_TEST_NEAR(101325.0, pressure, 5.0);
+    }
+
+    /* environment changes are tracked */
+    HOST_TEST_ESP_OK( i2c_sim_bmp280_set_environment(model, -10.0f, 90000.0f) );
+    float temperature = 0, pressure = 0;
+    HOST_TEST_ESP_OK( bmp280_get_measurements(dev_handle, &temperature, &pressure) );
+    HOST_TEST_NEAR(-10.0, temperature, 0.05);
+    HOST_TEST_NEAR(90000.0, pressure, 5.0);
+
+    HOST_TEST_ESP_OK( bmp280_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_bmp390(void) {
+    i2c_sim_model_t *model;
+    bmp390_config_t dev_config = BMP390_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_bmp390_set_environment(model, -5.25f, 95000.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    bmp390_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( bmp390_init(bus_handle, &dev_config, &dev_handle) );
+
+    float temperature = 0, pressure = 0;
+    HOST_TEST_ESP_OK( bmp390_get_measurements(dev_handle, &temperature, &pressure) );
+    HOST_TEST_NEAR(-5.25, temperature, 0.05);
+    HOST_TEST_NEAR(95000.0, pressure, 5.0);
+
+    HOST_TEST_ESP_OK( bmp390_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_sht4x(void) {
+    i2c_sim_model_t *model;
+    sht4x_config_t dev_config = I2C_SHT4X_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_set_environment(model, 23.4f, 45.6f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    sht4x_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( sht4x_init(bus_handle, &dev_config, &dev_handle) );
+
+    float temperature = 0, humidity = 0, dewpoint = 0;
+    HOST_TEST_ESP_OK( sht4x_get_measurements(dev_handle, &temperature, &humidity, &dewpoint) );
+    HOST_TEST_NEAR(23.4, temperature, 0.05);
+    HOST_TEST_NEAR(45.6, humidity, 0.05);
+    HOST_TEST_ASSERT(dewpoint < temperature);
+
+    /* a collect while converting is not acknowledged, a bus timeout is passed through */
+    uint32_t ready_time_us = 0;
+    HOST_TEST_ESP_OK( sht4x_start_measurement(dev_handle) );
+    HOST_TEST_ESP_OK( sht4x_get_measurement_ready_time(dev_handle, &ready_time_us) );
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FINISHED, sht4x_collect_measurement(dev_handle, &temperature, &humidity) );
+    i2c_sim_advance_time_us(ready_time_us);
+    HOST_TEST_ESP_OK( i2c_sim_inject_timeouts(I2C_NUM_0, dev_config.i2c_address, 1) );
+    HOST_TEST_ESP_ERR( ESP_ERR_TIMEOUT, sht4x_collect_measurement(dev_handle, &temperature, &humidity) );
+    HOST_TEST_ESP_OK( sht4x_collect_measurement(dev_handle, &temperature, &humidity) );
+    HOST_TEST_NEAR(23.4, temperature, 0.05);
+
+    HOST_TEST_ESP_OK( sht4x_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_ahtxx(void) {
+    i2c_sim_model_t *model;
+    ahtxx_config_t dev_config = AHT20_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_set_environment(model, 19.8f, 61.2f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    ahtxx_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( ahtxx_init(bus_handle, &dev_config, &dev_handle) );
+
+    float temperature = 0, humidity = 0, dewpoint = 0;
+    HOST_TEST_ESP_OK( ahtxx_get_measurements(dev_handle, &temperature, &humidity, &dewpoint) );
+    HOST_TEST_NEAR(19.8, temperature, 0.05);
+    HOST_TEST_NEAR(61.2, humidity, 0.05);
+
+    HOST_TEST_ESP_OK( ahtxx_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_ina228(void) {
+    i2c_sim_model_t *model;
+    ina228_config_t dev_config = INA228_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ina228_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_ina228_set_inputs(model, 12.3f, 0.0045f, 31.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    ina228_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( ina228_init(bus_handle, &dev_config, &dev_handle) );
+
+    float bus_voltage = 0, shunt_voltage = 0, current = 0, temperature = 0;
+    HOST_TEST_ESP_OK( ina228_get_bus_voltage(dev_handle, &bus_voltage) );
+    HOST_TEST_ESP_OK( ina228_get_shunt_voltage(dev_handle, &shunt_voltage) );
+    HOST_TEST_ESP_OK( ina228_get_current(dev_handle, &current) );
+    HOST_TEST_ESP_OK( ina228_get_temperature(dev_handle, &temperature) );
+    HOST_TEST_NEAR(12.3, bus_voltage, 0.001);
+    HOST_TEST_NEAR(0.0045, shunt_voltage, 0.000001);
+    HOST_TEST_NEAR(31.0, temperature, 0.01);
+
+    /* the current register follows SHUNT_CAL, the calibration value sits in bits 0-14 */
+    HOST_TEST_NEAR(0.0045 / dev_config.shunt_resistance, current, 0.001);
+    ina228_shunt_calibration_register_t shunt_cal_reg = { .reg = 0 };
+    HOST_TEST_ESP_OK( ina228_get_shunt_calibration_register(dev_handle, &shunt_cal_reg) );
+    HOST_TEST_ASSERT(shunt_cal_reg.bits.reserved == 0);
+    HOST_TEST_ASSERT(shunt_cal_reg.bits.shunt_calibration == (shunt_cal_reg.reg & 0x7fff));
+    HOST_TEST_ASSERT(shunt_cal_reg.bits.shunt_calibration != 0);
+
+    HOST_TEST_ESP_OK( ina228_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_ina226(void) {
+    i2c_sim_model_t *model;
+    ina226_config_t dev_config = INA226_CONFIG_DEFAULT;
+    dev_config.operating_mode = INA226_OP_MODE_TRIG_SHUNT_BUS;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ina226_create(&model) );
+    /* 0.25 A through the 2 milli-ohm shunt */
+    HOST_TEST_ESP_OK( i2c_sim_ina226_set_inputs(model, 12.0f, 0.25f * 0.002f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    ina226_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( ina226_init(bus_handle, &dev_config, &dev_handle) );
+
+    /* a collect before the conversion ready flag is set is not finished, the flag clears on collect */
+    float bus_voltage = 0, current = 0, power = 0;
+    uint32_t ready_time_us = 0;
+    HOST_TEST_ESP_OK( ina226_start_measurement(dev_handle) );
+    HOST_TEST_ESP_OK( ina226_get_measurement_ready_time(dev_handle, &ready_time_us) );
+    HOST_TEST_ASSERT( ready_time_us == 1100 + 1100 );
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FINISHED, ina226_collect_measurement(dev_handle, &bus_voltage, &current, &power) );
+    i2c_sim_advance_time_us(ready_time_us);
+    HOST_TEST_ESP_OK( ina226_collect_measurement(dev_handle, &bus_voltage, &current, &power) );
+    HOST_TEST_NEAR(12.0, bus_voltage, 0.002);
+    HOST_TEST_NEAR(0.25, current, 0.001);
+    HOST_TEST_NEAR(3.0, power, 0.01);
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FINISHED, ina226_collect_measurement(dev_handle, &bus_voltage, &current, &power) );
+
+    /* a triggered conversion with averaging takes the averaged conversion time */
+    HOST_TEST_ESP_OK( ina226_delete(dev_handle) );
+    dev_config.averaging_mode = INA226_AVG_MODE_16;
+    HOST_TEST_ESP_OK( ina226_init(bus_handle, &dev_config, &dev_handle) );
+    HOST_TEST_ESP_OK( i2c_sim_ina226_set_inputs(model, 5.0f, -0.1f * 0.002f) );
+    HOST_TEST_ESP_OK( ina226_start_measurement(dev_handle) );
+    HOST_TEST_ESP_OK( ina226_get_measurement_ready_time(dev_handle, &ready_time_us) );
+    HOST_TEST_ASSERT( ready_time_us == 16 * (1100 + 1100) );
+    i2c_sim_advance_time_us(ready_time_us - 1000);
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FINISHED, ina226_collect_measurement(dev_handle, &bus_voltage, &current, &power) );
+    i2c_sim_advance_time_us(1000);
+    HOST_TEST_ESP_OK( ina226_collect_measurement(dev_handle, &bus_voltage, &current, &power) );
+    HOST_TEST_NEAR(5.0, bus_voltage, 0.002);
+
+    HOST_TEST_ESP_OK( ina226_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_hdc1080(void) {
+    i2c_sim_model_t *model;
+    hdc1080_config_t dev_config = HDC1080_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_hdc1080_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_hdc1080_set_environment(model, 22.6f, 38.4f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    hdc1080_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( hdc1080_init(bus_handle, &dev_config, &dev_handle) );
+
+    float temperature = 0, humidity = 0;
+    HOST_TEST_ESP_OK( hdc1080_get_measurement(dev_handle, &temperature, &humidity) );
+    HOST_TEST_NEAR(22.6, temperature, 0.05);
+
+    /* a collect while converting is not acknowledged, a bus timeout is passed through */
+    uint32_t ready_time_us = 0;
+    i2c_sim_stats_t stats;
+    HOST_TEST_ESP_OK( hdc1080_start_measurement(dev_handle) );
+    HOST_TEST_ESP_OK( hdc1080_get_measurement_ready_time(dev_handle, &ready_time_us) );
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_ERR( ESP_ERR_NOT_FINISHED, hdc1080_collect_measurement(dev_handle, &temperature, &humidity) );
+    i2c_sim_get_stats(&stats);
+    HOST_TEST_ASSERT( stats.nacks == 1 );
+    i2c_sim_advance_time_us(ready_time_us);
+    HOST_TEST_ESP_OK( i2c_sim_inject_timeouts(I2C_NUM_0, dev_config.i2c_address, 1) );
+    HOST_TEST_ESP_ERR( ESP_ERR_TIMEOUT, hdc1080_collect_measurement(dev_handle, &temperature, &humidity) );
+    HOST_TEST_ESP_OK( hdc1080_collect_measurement(dev_handle, &temperature, &humidity) );
+    HOST_TEST_NEAR(22.6, temperature, 0.05);
+    HOST_TEST_NEAR(38.4, humidity, 0.05);
+
+    HOST_TEST_ESP_OK( hdc1080_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_mpu6050(void) {
+    i2c_sim_model_t *model;
+    const float accel[3] = { 0.1f, -0.2f, 1.0f };
+    const float gyro[3]  = { 10.0f, -20.0f, 30.0f };
+    mpu6050_config_t dev_config = I2C_MPU6050_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_set_motion(model, accel, gyro, 27.0f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    mpu6050_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( mpu6050_init(bus_handle, &dev_config, &dev_handle) );
+
+    mpu6050_gyro_data_axes_t gyro_data;
+    mpu6050_accel_data_axes_t accel_data;
+    float temperature = 0;
+    HOST_TEST_ESP_OK( mpu6050_get_motion(dev_handle, &gyro_data, &accel_data, &temperature) );
+    HOST_TEST_NEAR(0.1, accel_data.x_axis, 0.001);
+    HOST_TEST_NEAR(-0.2, accel_data.y_axis, 0.001);
+    HOST_TEST_NEAR(1.0, accel_data.z_axis, 0.001);
+    HOST_TEST_NEAR(10.0, gyro_data.x_axis, 0.05);
+    HOST_TEST_NEAR(-20.0, gyro_data.y_axis, 0.05);
+    HOST_TEST_NEAR(30.0, gyro_data.z_axis, 0.05);
+    HOST_TEST_NEAR(27.0, temperature, 0.01);
+
+    HOST_TEST_ESP_OK( mpu6050_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_ssd1306(void) {
+    i2c_sim_model_t *model;
+    uint8_t ram[128 * 64 / 8];
+    bool display_on = false;
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    i2c_master_bus_handle_t bus_handle = test_bus_init();
+
+    ssd1306_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( ssd1306_init(bus_handle, &dev_config, &dev_handle) );
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_get_display_on(model, &display_on) );
+    HOST_TEST_ASSERT(display_on);
+
+    HOST_TEST_ESP_OK( ssd1306_display_text(dev_handle, 0, "Hello", false) );
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_get_ram(model, ram, sizeof(ram)) );
+    int page0 = 0, others = 0;
+    for(size_t i = 0; i < sizeof(ram); i++) {
+        if(ram[i] == 0) continue;
+        if(i < 128) page0++; else others++;
+    }
+    HOST_TEST_ASSERT(page0 > 0);
+    HOST_TEST_ASSERT(others == 0);
+
+    HOST_TEST_ESP_OK( ssd1306_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    test_bmp280();
+    test_bmp390();
+    test_sht4x();
+    test_ahtxx();
+    test_ina228();
+    test_ina226();
+    test_hdc1080();
+    test_mpu6050();
+    test_ssd1306();
+    HOST_TEST_END();
+}
@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_i2c_trace_drivers.c
+ *
+ * I2C trace test, the SHT4x and AHTxx drivers are built with the trace enabled 
+ * and the recorded device, register and sleep statistics and transaction records 
+ * are checked against the bus statistics of the simulator
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <i2c_trace.h>
+#include <sht4x.h>
+#include <ahtxx.h>
+#include "host_test.h"
+
+#define TEST_MEASUREMENTS       (10)
+#define TEST_RECORDS            (16)
+
+static i2c_trace_snapshot_t snapshot;
+
+/* finds the device statistics of a traced device by name */
+static const i2c_trace_device_stats_t *test_find_device(const char *const name) {
+    for(uint8_t i = 0; i < snapshot.device_count; i++) {
+        if(strcmp(snapshot.devices[i].name, name) == 0) return &snapshot.devices[i];
+    }
+    return NULL;
+}
+
+/* the traced device statistics match the simulator bus statistics of the device */
+static void test_check_device(const i2c_trace_device_stats_t *const device, const uint16_t address) {
+    i2c_sim_stats_t stats;
+
+    HOST_TEST_ESP_OK( i2c_sim_get_device_stats(I2C_NUM_0, address, &stats) );
+    printf("%-6s 0x%02x %3lu transactions %2lu nacks %lu timeouts %4lu bytes written %4lu bytes read %7llu us latency %3lu delays %8llu us\n",
+           device->name, device->address, (unsigned long)device->transactions, (unsigned long)device->nacks, (unsigned long)device->timeouts,
+           (unsigned long)device->bytes_written, (unsigned long)device->bytes_read, (unsigned long long)device->latency_total_us,
+           (unsigned long)device->delays, (unsigned long long)device->delay_total_us);
+
+    HOST_TEST_ASSERT( device->address == address );
+    HOST_TEST_ASSERT( device->transactions == stats.transactions );
+    HOST_TEST_ASSERT( device->bytes_written == stats.bytes_written );
+    HOST_TEST_ASSERT( device->bytes_read == stats.bytes_read );
+
+    /* virtual time only advances on the bus during a transaction */
+    HOST_TEST_ASSERT( device->latency_total_us == stats.bus_time_us );
+
+    /* the register statistics add up to the device statistics */
+    uint32_t transactions = 0, bytes_read = 0;
+    for(uint8_t i = 0; i < device->register_count; i++) {
+        transactions += device->registers[i].transactions;
+        bytes_read   += device->registers[i].bytes_read;
+    }
+    HOST_TEST_ASSERT( transactions == device->transactions );
+    HOST_TEST_ASSERT( bytes_read == device->bytes_read );
+}
+
+static void test_trace_drivers(void) {
+    i2c_sim_model_t *model;
+    sht4x_config_t sht4x_config = I2C_SHT4X_CONFIG_DEFAULT;
+    ahtxx_config_t ahtxx_config = AHT20_CONFIG_DEFAULT;
+    i2c_sim_stats_t stats;
+    float temperature, humidity, dewpoint;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_sht4x_set_environment(model, 23.4f, 45.6f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, sht4x_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_ahtxx_set_environment(model, 19.8f, 61.2f) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, ahtxx_config.i2c_address, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+
+    sht4x_handle_t sht4x_handle = NULL;
+    ahtxx_handle_t ahtxx_handle = NULL;
+    HOST_TEST_ESP_OK( sht4x_init(bus_handle, &sht4x_config, &sht4x_handle) );
+    HOST_TEST_ESP_OK( ahtxx_init(bus_handle, &ahtxx_config, &ahtxx_handle) );
+
+    /* the trace covers the measurements from here on */
+    HOST_TEST_ESP_OK( i2c_trace_reset() );
+    i2c_sim_reset_stats();
+
+    for(int i = 0; i < TEST_MEASUREMENTS; i++) {
+        HOST_TEST_ESP_OK( sht4x_get_measurement(sht4x_handle, &temperature, &humidity) );
+        HOST_TEST_NEAR( 23.4f, temperature, 0.05f );
+        HOST_TEST_ESP_OK( ahtxx_get_measurements(ahtxx_handle, &temperature, &humidity, &dewpoint) );
+        HOST_TEST_NEAR( 19.8f, temperature, 0.05f );
+    }
+
+    HOST_TEST_ESP_OK( i2c_trace_get_snapshot(&snapshot) );
+    HOST_TEST_ASSERT( snapshot.device_count == 2 );
+    HOST_TEST_ASSERT( snapshot.dropped_devices == 0 );
+
+    const i2c_trace_device_stats_t *sht4x_stats = test_find_device("sht4x");
+    const i2c_trace_device_stats_t *ahtxx_stats = test_find_device("ahtxx");
+    HOST_TEST_ASSERT( sht4x_stats && ahtxx_stats );
+    if(!sht4x_stats || !ahtxx_stats) return;
+    test_check_device(sht4x_stats, sht4x_config.i2c_address);
+    test_check_device(ahtxx_stats, ahtxx_config.i2c_address);
+    HOST_TEST_ASSERT( sht4x_stats->nacks == 0 && sht4x_stats->timeouts == 0 );
+    HOST_TEST_ASSERT( ahtxx_stats->nacks == 0 && ahtxx_stats->timeouts == 0 );
+
+    /* a not acknowledged and a timed out transaction are recorded against the device */
+    const uint32_t sht4x_transactions = sht4x_stats->transactions;
+    HOST_TEST_ESP_OK( i2c_sim_inject_nacks(I2C_NUM_0, sht4x_config.i2c_address, 1) );
+    HOST_TEST_ASSERT( sht4x_get_measurement(sht4x_handle, &temperature, &humidity) != ESP_OK );
+    HOST_TEST_ESP_OK( i2c_sim_inject_timeouts(I2C_NUM_0, sht4x_config.i2c_address, 1) );
+    HOST_TEST_ASSERT( sht4x_get_measurement(sht4x_handle, &temperature, &humidity) != ESP_OK );
+    HOST_TEST_ESP_OK( sht4x_get_measurement(sht4x_handle, &temperature, &humidity) );
+
+    HOST_TEST_ESP_OK( i2c_trace_get_snapshot(&snapshot) );
+    HOST_TEST_ESP_OK( i2c_sim_get_device_stats(I2C_NUM_0, sht4x_config.i2c_address, &stats) );
+    HOST_TEST_ASSERT( sht4x_stats->transactions == stats.transactions );
+    HOST_TEST_ASSERT( sht4x_stats->transactions > sht4x_transactions );
+    HOST_TEST_ASSERT( sht4x_stats->nacks == 1 && stats.nacks == 1 );
+    HOST_TEST_ASSERT( sht4x_stats->timeouts == 1 && stats.timeouts == 1 );
+    HOST_TEST_ASSERT( sht4x_stats->latency_total_us == stats.bus_time_us );
+
+    /* every driver sleep is recorded */
+    i2c_sim_get_stats(&stats);
+    HOST_TEST_ASSERT( sht4x_stats->delays + ahtxx_stats->delays == stats.delays );
+    HOST_TEST_ASSERT( sht4x_stats->delay_total_us + ahtxx_stats->delay_total_us == stats.delay_time_us );
+    HOST_TEST_ASSERT( snapshot.records == stats.transactions + stats.delays );
+
+    /* the ring holds the latest records in sequence order */
+    i2c_trace_record_t records[TEST_RECORDS];
+    size_t count = 0;
+    HOST_TEST_ESP_OK( i2c_trace_get_records(records, TEST_RECORDS, &count) );
+    HOST_TEST_ASSERT( count == TEST_RECORDS );
+    for(size_t i = 1; i < count; i++) {
+        HOST_TEST_ASSERT( records[i].sequence == records[i - 1].sequence + 1 );
+        HOST_TEST_ASSERT( records[i].timestamp_us >= records[i - 1].timestamp_us );
+    }
+    HOST_TEST_ASSERT( records[count - 1].sequence == snapshot.records - 1 );
+    HOST_TEST_ASSERT( records[count - 1].operation == I2C_TRACE_OP_RECEIVE || records[count - 1].operation == I2C_TRACE_OP_DELAY );
+
+    /* a reset clears the statistics and the ring */
+    HOST_TEST_ESP_OK( i2c_trace_reset() );
+    HOST_TEST_ESP_OK( i2c_trace_get_snapshot(&snapshot) );
+    HOST_TEST_ASSERT( snapshot.records == 0 );
+    HOST_TEST_ESP_OK( i2c_trace_get_records(records, TEST_RECORDS, &count) );
+    HOST_TEST_ASSERT( count == 0 );
+
+    HOST_TEST_ESP_OK( sht4x_delete(sht4x_handle) );
+    HOST_TEST_ESP_OK( ahtxx_delete(ahtxx_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_NONE);
+    test_trace_drivers();
+    HOST_TEST_END();
+}
@@ -0,0 +1,213 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_max30105_fifo.c
+ *
+ * MAX30105 FIFO burst read test, samples written by the simulator particle 
+ * sensor model are drained with one pointer read and one data burst, the 
+ * unpacked counts, lost sample counts and sample timestamps are checked, and 
+ * multi-LED samples are unpacked by the LED of each time slot
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <max30105.h>
+#include "host_test.h"
+
+#define FIFO_PERIOD_US          (10000)     /* 800 samples per second averaged by 8 */
+#define FIFO_DEPTH              (32)
+
+static max30105_adc_channels_count_data_t fifo_data;
+
+/* drains the fifo and returns the bus statistics of the drain */
+static i2c_sim_stats_t fifo_read(max30105_handle_t dev_handle, const char *const name) {
+    i2c_sim_stats_t stats;
+
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( max30105_read_fifo(dev_handle, &fifo_data) );
+    i2c_sim_get_stats(&stats);
+    printf("%-22s %2u samples %2u lost %lu transactions %4llu bytes %5llu us bus time\n", name, fifo_data.sample_size, fifo_data.overflow_count, 
+           (unsigned long)stats.transactions, (unsigned long long)stats.bytes_read, (unsigned long long)stats.bus_time_us);
+    return stats;
+}
+
+/* the model ramps the counts by one per sample, channels are offset by their set counts */
+static void fifo_check_counts(const uint32_t first_red, const bool ir, const bool green) {
+    for(uint8_t i = 0; i < fifo_data.sample_size; i++) {
+        HOST_TEST_ASSERT( fifo_data.red_count[i] == first_red + i );
+        HOST_TEST_ASSERT( fifo_data.ir_count[i] == (ir ? first_red + i + 1000 : 0) );
+        HOST_TEST_ASSERT( fifo_data.green_count[i] == (green ? first_red + i + 2000 : 0) );
+    }
+}
+
+/* the counts of each LED are unpacked into its channel whatever its time slot, the sample numbers agree */
+static void fifo_check_slot_counts(const bool red, const bool ir, const bool green) {
+    const uint32_t *first = red ? fifo_data.red_count : ir ? fifo_data.ir_count : fifo_data.green_count;
+    const uint32_t  sequence = first[0] - (red ? 1000 : ir ? 2000 : 3000);
+
+    HOST_TEST_ASSERT( fifo_data.sample_size > 0 );
+    for(uint8_t i = 0; i < fifo_data.sample_size; i++) {
+        HOST_TEST_ASSERT( fifo_data.red_count[i] == (red ? 1000 + sequence + i : 0) );
+        HOST_TEST_ASSERT( fifo_data.ir_count[i] == (ir ? 2000 + sequence + i : 0) );
+        HOST_TEST_ASSERT( fifo_data.green_count[i] == (green ? 3000 + sequence + i : 0) );
+    }
+}
+
+static void test_fifo(void) {
+    i2c_sim_model_t *model;
+    max30105_config_t dev_config = MAX30105_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    max30105_handle_t dev_handle = NULL;
+
+    dev_config.i2c_clock_speed = 400000;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_max30105_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_max30105_set_counts(model, 1000, 2000, 3000) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( max30105_init(bus_handle, &dev_config, &dev_handle) );
+
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, max30105_configure_fifo(dev_handle, 16, MAX30105_SMP_AVG_8, true) );
+    HOST_TEST_ESP_OK( max30105_configure_fifo(dev_handle, 4, MAX30105_SMP_AVG_8, true) );
+    HOST_TEST_ESP_OK( max30105_read_fifo(dev_handle, &fifo_data) );
+    HOST_TEST_ASSERT( fifo_data.sample_period == FIFO_PERIOD_US );
+
+    /* pending samples are drained with a pointer read and one data burst of 9-byte samples */
+    i2c_sim_advance_time_us(20 * FIFO_PERIOD_US);
+    i2c_sim_stats_t stats = fifo_read(dev_handle, "20 samples, 3 LEDs");
+    HOST_TEST_ASSERT( fifo_data.sample_size == 20 && fifo_data.overflow_count == 0 );
+    HOST_TEST_ASSERT( stats.transactions == 2 && stats.bytes_read == 3 + 20 * 9 );
+    HOST_TEST_ASSERT( fifo_data.red_count[0] >= 1000 );
+    uint32_t next_red = fifo_data.red_count[0];
+    fifo_check_counts(next_red, true, true);
+    next_red += fifo_data.sample_size;
+    int64_t newest = fifo_data.timestamp + (int64_t)(fifo_data.sample_size - 1) * fifo_data.sample_period;
+
+    /* the sample clock continues from the previous read, a late read does not shift the timestamps, 
+       the bus time of the previous burst can add a sample */
+    i2c_sim_advance_time_us(10 * FIFO_PERIOD_US + 300);
+    fifo_read(dev_handle, "10 samples, late read");
+    HOST_TEST_ASSERT( (fifo_data.sample_size == 10 || fifo_data.sample_size == 11) && fifo_data.overflow_count == 0 );
+    HOST_TEST_ASSERT( fifo_data.timestamp == newest + FIFO_PERIOD_US );
+    fifo_check_counts(next_red, true, true);
+    next_red += fifo_data.sample_size;
+    newest = fifo_data.timestamp + (int64_t)(fifo_data.sample_size - 1) * fifo_data.sample_period;
+
+    /* a read without new samples keeps the sample clock */
+    i2c_sim_advance_time_us(FIFO_PERIOD_US);
+    fifo_read(dev_handle, "1 sample");
+    HOST_TEST_ASSERT( fifo_data.sample_size >= 1 && fifo_data.timestamp == newest + FIFO_PERIOD_US );
+    fifo_check_counts(next_red, true, true);
+    next_red += fifo_data.sample_size;
+
+    /* a full fifo rolls over, the newest samples are kept and the lost samples are counted */
+    i2c_sim_advance_time_us(40 * FIFO_PERIOD_US);
+    fifo_read(dev_handle, "rollover");
+    HOST_TEST_ASSERT( fifo_data.sample_size == FIFO_DEPTH );
+    HOST_TEST_ASSERT( fifo_data.overflow_count >= 40 - FIFO_DEPTH && fifo_data.overflow_count <= 41 - FIFO_DEPTH );
+    fifo_check_counts(next_red + fifo_data.overflow_count, true, true);
+
+    /* an empty fifo is one pointer read */
+    stats = fifo_read(dev_handle, "empty");
+    HOST_TEST_ASSERT( fifo_data.sample_size == 0 && stats.transactions == 1 );
+
+    /* red and IR with a 15-bit pulse width are 6-byte samples, counts are right-aligned */
+    HOST_TEST_ESP_OK( max30105_set_control_mode(dev_handle, MAX30105_CM_RED_IR_LED) );
+    HOST_TEST_ESP_OK( max30105_set_particle_led_pulse_width(dev_handle, MAX30105_LPWC_69US_15BITS) );
+    HOST_TEST_ESP_OK( max30105_clear_fifo(dev_handle) );
+    i2c_sim_advance_time_us(3 * FIFO_PERIOD_US);
+    stats = fifo_read(dev_handle, "3 samples, 2 LEDs");
+    HOST_TEST_ASSERT( (fifo_data.sample_size == 3 || fifo_data.sample_size == 4) && stats.bytes_read == 3 + fifo_data.sample_size * 6u );
+    fifo_check_counts(fifo_data.red_count[0], true, false);
+
+    HOST_TEST_ESP_OK( max30105_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+static void test_slot_order(void) {
+    i2c_sim_model_t *model;
+    max30105_config_t dev_config = MAX30105_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    max30105_handle_t dev_handle = NULL;
+    i2c_sim_stats_t stats;
+
+    /* green, red and IR slot order, the default configuration is red, IR and green */
+    dev_config.multi_led_mode_slot1 = MAX30105_MLCM_GREEN_LED3_PA;
+    dev_config.multi_led_mode_slot2 = MAX30105_MLCM_RED_LED1_PA;
+    dev_config.multi_led_mode_slot3 = MAX30105_MLCM_IR_LED2_PA;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_max30105_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_max30105_set_counts(model, 1000, 2000, 3000) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( max30105_init(bus_handle, &dev_config, &dev_handle) );
+    HOST_TEST_ESP_OK( max30105_configure_fifo(dev_handle, 4, MAX30105_SMP_AVG_8, true) );
+    HOST_TEST_ESP_OK( max30105_clear_fifo(dev_handle) );
+
+    i2c_sim_advance_time_us(5 * FIFO_PERIOD_US);
+    stats = fifo_read(dev_handle, "green, red, IR slots");
+    HOST_TEST_ASSERT( stats.bytes_read == 3 + fifo_data.sample_size * 9u );
+    fifo_check_slot_counts(true, true, true);
+
+    /* IR and green in the first two slots, red is not sampled */
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_1, MAX30105_MLCM_IR_LED2_PA) );
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_2, MAX30105_MLCM_GREEN_LED3_PA) );
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_3, MAX30105_MLCM_DISABLED) );
+    HOST_TEST_ESP_OK( max30105_clear_fifo(dev_handle) );
+    i2c_sim_advance_time_us(5 * FIFO_PERIOD_US);
+    stats = fifo_read(dev_handle, "IR, green slots");
+    HOST_TEST_ASSERT( stats.bytes_read == 3 + fifo_data.sample_size * 6u );
+    fifo_check_slot_counts(false, true, true);
+
+    /* four slots with the IR LED in two of them are 12-byte samples, IR is unpacked from its first slot */
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_1, MAX30105_MLCM_GREEN_LED3_PILOT_PA) );
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_2, MAX30105_MLCM_IR_LED2_PA) );
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_3, MAX30105_MLCM_RED_LED1_PA) );
+    HOST_TEST_ESP_OK( max30105_set_multi_led_mode(dev_handle, MAX30105_MLM_SLOT_4, MAX30105_MLCM_IR_LED2_PILOT_PA) );
+    HOST_TEST_ESP_OK( max30105_clear_fifo(dev_handle) );
+    i2c_sim_advance_time_us(5 * FIFO_PERIOD_US);
+    stats = fifo_read(dev_handle, "4 slots, IR twice");
+    HOST_TEST_ASSERT( stats.bytes_read == 3 + fifo_data.sample_size * 12u );
+    fifo_check_slot_counts(true, true, true);
+
+    HOST_TEST_ESP_OK( max30105_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    test_fifo();
+    test_slot_order();
+
+    HOST_TEST_END();
+}
@@ -0,0 +1,320 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_max31865_spi.c
+ *
+ * MAX31865 driver test against the SPI simulator and the MAX31865 device model, 
+ * Callendar-Van Dusen conversion accuracy of the polynomial and lookup table 
+ * conversions, single-shot reads with and without DRDY, automatic mode, fault 
+ * detection and thresholds, and the DRDY interrupt pipeline with a full queue
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <spi_sim.h>
+#include <max31865.h>
+#include "max31865_mock.h"
+#include "host_test.h"
+
+#define TEST_CS_IO              GPIO_NUM_5
+#define TEST_DRDY_IO            GPIO_NUM_4
+#define TEST_R_REF              (430.0f)    /* PT100 reference resistor */
+#define TEST_R_NOMINAL          (100.0)     /* PT100 nominal resistance */
+#define TEST_AUTO_PERIOD_US     (16667)     /* automatic conversion period, 60 Hz filter */
+#define TEST_PIPELINE_QUEUE     (10)        /* SPI_MAX31865_PIPELINE_CONFIG_DEFAULT queue length */
+
+/* Callendar-Van Dusen A, B and C coefficients of the IEC 60751, US and JIS standards */
+static const double test_cvd_coefficients[3][3] = {
+    { 3.9083e-3, -5.775e-7,  -4.183e-12  },
+    { 3.9848e-3, -5.8019e-7, -4.0e-12    },
+    { 3.9692e-3, -5.8495e-7, -4.2325e-12 } };
+
+static spi_sim_model_t *test_model;
+static uint32_t         test_callbacks;
+
+/* RTD resistance at a temperature in degrees Celsius */
+static float test_resistance(const int standard, const double temperature) {
+    const double *const c = test_cvd_coefficients[standard];
+    double ratio = 1 + c[0] * temperature + c[1] * temperature * temperature;
+    if (temperature < 0) ratio += c[2] * (temperature - 100) * temperature * temperature * temperature;
+    return (float)(ratio * TEST_R_NOMINAL);
+}
+
+static spi_max31865_handle_t test_init(spi_max31865_config_t *const config, const float resistance) {
+    spi_max31865_handle_t handle = NULL;
+
+    HOST_TEST_ESP_OK(max31865_mock_create(TEST_R_REF, TEST_DRDY_IO, &test_model));
+    max31865_mock_set_resistance(test_model, resistance);
+    HOST_TEST_ESP_OK(spi_sim_add_device(config->host, config->cs_io_num, test_model));
+    HOST_TEST_ESP_OK(spi_max31865_init(config, &handle));
+
+    return handle;
+}
+
+static void test_delete(spi_max31865_handle_t handle, const spi_max31865_config_t *const config) {
+    max31865_mock_stats_t stats;
+
+    max31865_mock_get_stats(test_model, &stats);
+    HOST_TEST_ASSERT(stats.bad_config_writes == 0);
+    HOST_TEST_ESP_OK(spi_max31865_delete(handle));
+    HOST_TEST_ESP_OK(spi_sim_remove_device(config->host, config->cs_io_num));
+    test_model = NULL;
+}
+
+/* conversion accuracy from -200 to 850 degrees Celsius for each standard and conversion */
+static void test_cvd(void) {
+    for (int standard = 0; standard < 3; standard++) {
+        for (int conversion = 0; conversion < 2; conversion++) {
+            spi_max31865_config_t config = SPI_MAX31865_CONFIG_DEFAULT;
+            config.cs_io_num  = TEST_CS_IO;
+            config.standard   = standard;
+            config.conversion = conversion;
+            spi_max31865_handle_t handle = test_init(&config, (float)TEST_R_NOMINAL);
+
+            double max_error = 0;
+            for (double t = -200; t <= 850; t += 0.01) {
+                float temperature;
+                spi_max31865_convert_temperature(handle, test_resistance(standard, t), &temperature);
+                if (fabs(temperature - t) > max_error) max_error = fabs(temperature - t);
+            }
+            HOST_TEST_NEAR(0.0, max_error, 0.01);
+
+            test_delete(handle, &config);
+        }
+    }
+}
+
+/* single-shot conversion, the bias voltage is switched off after the read */
+static void test_single(const bool drdy) {
+    spi_max31865_config_t config = SPI_MAX31865_CONFIG_DEFAULT;
+    max31865_mock_stats_t stats;
+    float                 temperature = 0;
+
+    config.cs_io_num  = TEST_CS_IO;
+    config.irq_io_num = drdy ? TEST_DRDY_IO : GPIO_NUM_NC;
+    spi_max31865_handle_t handle = test_init(&config, test_resistance(0, 100.0));
+
+    max31865_mock_get_stats(test_model, &stats);
+    HOST_TEST_ASSERT(stats.spi_mode == 1 && stats.address_bits == 8);
+
+    HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_NEAR(100.0f, temperature, 0.05f);
+    HOST_TEST_ASSERT((max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0x80) == 0);
+
+    max31865_mock_set_resistance(test_model, test_resistance(0, -150.0));
+    HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_NEAR(-150.0f, temperature, 0.05f);
+
+    /* 50 Hz filter, the one-shot conversion takes longer */
+    HOST_TEST_ESP_OK(spi_max31865_set_filter(handle, SPI_MAX31865_FILTER_50HZ));
+    HOST_TEST_ASSERT(max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0x01);
+    const int64_t start = i2c_sim_get_time_us();
+    HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_ASSERT(i2c_sim_get_time_us() - start >= 62500);
+    HOST_TEST_NEAR(-150.0f, temperature, 0.05f);
+
+    test_delete(handle, &config);
+}
+
+/* automatic conversions, reads follow the conversion period */
+static void test_auto(void) {
+    spi_max31865_config_t config = SPI_MAX31865_CONFIG_DEFAULT;
+    float                 temperature = 0;
+
+    config.cs_io_num  = TEST_CS_IO;
+    config.irq_io_num = TEST_DRDY_IO;
+    config.mode       = SPI_MAX31865_MODE_AUTO;
+    spi_max31865_handle_t handle = test_init(&config, test_resistance(0, 25.0));
+    HOST_TEST_ASSERT((max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0xc0) == 0xc0);
+
+    for (int i = 0; i < 3; i++) {
+        HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+        HOST_TEST_NEAR(25.0f, temperature, 0.05f);
+    }
+
+    HOST_TEST_ESP_OK(spi_max31865_set_filter(handle, SPI_MAX31865_FILTER_50HZ));
+    HOST_TEST_ASSERT((max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0xc1) == 0xc1);
+    HOST_TEST_ESP_ERR(ESP_ERR_INVALID_STATE, spi_max31865_set_bias(handle, false));
+    HOST_TEST_ESP_OK(spi_max31865_set_mode(handle, SPI_MAX31865_MODE_SINGLE));
+    HOST_TEST_ASSERT((max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0xc0) == 0);
+
+    test_delete(handle, &config);
+}
+
+/* automatic and manual fault detection cycles and the fault thresholds */
+static void test_faults(void) {
+    spi_max31865_config_t                config = SPI_MAX31865_CONFIG_DEFAULT;
+    spi_max31865_fault_status_register_t fault_status;
+    float                                low = 0, high = 0, temperature = 0;
+
+    config.cs_io_num  = TEST_CS_IO;
+    config.connection = SPI_MAX31865_3WIRE;
+    config.filter     = SPI_MAX31865_FILTER_50HZ;
+    spi_max31865_handle_t handle = test_init(&config, 110.0f);
+    const uint8_t config_reg = max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG);
+
+    for (int cycle = 0; cycle < 2; cycle++) {
+        max31865_mock_set_rtd_open(test_model, false);
+        HOST_TEST_ESP_OK(spi_max31865_run_fault_detection(handle, cycle, &fault_status));
+        HOST_TEST_ASSERT(fault_status.reg == 0);
+        HOST_TEST_ASSERT(max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) == config_reg);
+
+        max31865_mock_set_rtd_open(test_model, true);
+        HOST_TEST_ESP_OK(spi_max31865_run_fault_detection(handle, cycle, &fault_status));
+        HOST_TEST_ASSERT(fault_status.bits.rtdin_open_fault && fault_status.bits.voltage_fault);
+        HOST_TEST_ESP_OK(spi_max31865_clear_fault_status(handle));
+        HOST_TEST_ASSERT(max31865_mock_get_register(test_model, MAX31865_MOCK_REG_FAULT_STATUS) == 0);
+    }
+    max31865_mock_set_rtd_open(test_model, false);
+
+    HOST_TEST_ESP_OK(spi_max31865_set_fault_thresholds(handle, 80.0f, 150.0f));
+    HOST_TEST_ESP_OK(spi_max31865_get_fault_thresholds(handle, &low, &high));
+    HOST_TEST_NEAR(80.0f, low, 0.02f);
+    HOST_TEST_NEAR(150.0f, high, 0.02f);
+
+    /* above the high threshold the fault bit fails the read */
+    max31865_mock_set_resistance(test_model, 160.0f);
+    HOST_TEST_ESP_ERR(ESP_ERR_INVALID_RESPONSE, spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_ASSERT(max31865_mock_get_register(test_model, MAX31865_MOCK_REG_FAULT_STATUS) & 0x80);
+    HOST_TEST_ESP_OK(spi_max31865_clear_fault_status(handle));
+    max31865_mock_set_resistance(test_model, 120.0f);
+    HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+
+    test_delete(handle, &config);
+}
+
+static void test_pipeline_callback(const spi_max31865_pipeline_sample_t *sample, void *arg) {
+    test_callbacks++;
+}
+
+/* advances the virtual time in 1 ms steps and waits for the pipeline task to read each conversion */
+static void test_pipeline_run(spi_max31865_handle_t handle, const int steps_ms) {
+    spi_max31865_pipeline_stats_t pipeline_stats;
+    max31865_mock_stats_t         stats;
+
+    for (int ms = 0; ms < steps_ms; ms++) {
+        i2c_sim_advance_time_us(1000);
+        for (int wait = 0; wait < 2000 && gpio_get_level(TEST_DRDY_IO) == 0; wait++) usleep(50);
+    }
+
+    /* DRDY rises when the result is read, wait for the pipeline task to finish the last sample */
+    for (int wait = 0; wait < 2000; wait++) {
+        spi_max31865_get_pipeline_stats(handle, &pipeline_stats);
+        max31865_mock_get_stats(test_model, &stats);
+        if (pipeline_stats.samples + pipeline_stats.errors >= stats.conversions) break;
+        usleep(50);
+    }
+}
+
+/* DRDY interrupt pipeline in automatic mode, one sample per conversion and drops on a full queue */
+static void test_pipeline(void) {
+    spi_max31865_config_t          config = SPI_MAX31865_CONFIG_DEFAULT;
+    spi_max31865_pipeline_config_t pipeline_config = SPI_MAX31865_PIPELINE_CONFIG_DEFAULT;
+    spi_max31865_pipeline_stats_t  pipeline_stats;
+    spi_max31865_pipeline_sample_t sample;
+    max31865_mock_stats_t          stats;
+    QueueHandle_t                  queue;
+    float                          temperature = 0;
+
+    config.cs_io_num  = TEST_CS_IO;
+    config.irq_io_num = TEST_DRDY_IO;
+    config.conversion = SPI_MAX31865_CONVERSION_LOOKUP_TABLE;
+    spi_max31865_handle_t handle = test_init(&config, test_resistance(0, -40.0));
+
+    HOST_TEST_ESP_OK(spi_max31865_start_pipeline(handle, &(spi_max31865_pipeline_config_t){ .queue_length = 0 }));
+    HOST_TEST_ESP_ERR(ESP_ERR_INVALID_STATE, spi_max31865_start_pipeline(handle, &(spi_max31865_pipeline_config_t){ .queue_length = 0 }));
+    HOST_TEST_ESP_OK(spi_max31865_stop_pipeline(handle));
+
+    test_callbacks = 0;
+    pipeline_config.callback = test_pipeline_callback;
+    HOST_TEST_ESP_OK(spi_max31865_start_pipeline(handle, &pipeline_config));
+    HOST_TEST_ESP_ERR(ESP_ERR_INVALID_STATE, spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_ESP_OK(spi_max31865_get_pipeline_queue(handle, &queue));
+
+    /* 1 s of automatic conversions, the temperature changes after 500 ms */
+    uint32_t received = 0;
+    int64_t  last = 0, max_jitter = 0, change_time = INT64_MAX;
+    double   max_error = 0;
+    for (int step = 0; step < 1000; step += 100) {
+        if (step == 500) {
+            change_time = i2c_sim_get_time_us();
+            max31865_mock_set_resistance(test_model, test_resistance(0, 60.0));
+        }
+        test_pipeline_run(handle, 100);
+        while (xQueueReceive(queue, &sample, 0) == pdTRUE) {
+            if (last != 0 && received > 1) {
+                const int64_t jitter = llabs((sample.timestamp - last) - TEST_AUTO_PERIOD_US);
+                if (jitter > max_jitter) max_jitter = jitter;
+            }
+            last = sample.timestamp;
+            /* the conversion in progress at the change is skipped */
+            const double error = fabs(sample.temperature - (sample.timestamp < change_time ? -40.0 : 60.0));
+            if (!sample.fault && error < 5 && error > max_error) max_error = error;
+            received++;
+        }
+    }
+
+    HOST_TEST_ESP_OK(spi_max31865_get_pipeline_stats(handle, &pipeline_stats));
+    max31865_mock_get_stats(test_model, &stats);
+    HOST_TEST_ASSERT(pipeline_stats.samples >= 55);
+    HOST_TEST_ASSERT(pipeline_stats.samples == stats.conversions);
+    HOST_TEST_ASSERT(received == pipeline_stats.samples);
+    HOST_TEST_ASSERT(test_callbacks == pipeline_stats.samples);
+    HOST_TEST_NEAR(0.0, max_error, 0.05);
+    HOST_TEST_ASSERT(max_jitter <= 1000);
+
+    /* without draining, the queue fills and the samples are dropped */
+    test_pipeline_run(handle, 500);
+    HOST_TEST_ESP_OK(spi_max31865_get_pipeline_stats(handle, &pipeline_stats));
+    HOST_TEST_ASSERT(pipeline_stats.dropped > 0);
+    HOST_TEST_ASSERT(uxQueueMessagesWaiting(queue) == TEST_PIPELINE_QUEUE);
+
+    /* stopping the pipeline restores single-shot mode */
+    HOST_TEST_ESP_OK(spi_max31865_stop_pipeline(handle));
+    HOST_TEST_ASSERT((max31865_mock_get_register(test_model, MAX31865_MOCK_REG_CONFIG) & 0xc0) == 0);
+    HOST_TEST_ESP_OK(spi_max31865_get_measurement(handle, &temperature));
+    HOST_TEST_NEAR(60.0f, temperature, 0.05f);
+
+    test_delete(handle, &config);
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    HOST_TEST_ESP_OK(gpio_install_isr_service(0));
+    test_cvd();
+    test_single(false);
+    test_single(true);
+    test_auto();
+    test_faults();
+    test_pipeline();
+    HOST_TEST_END();
+}
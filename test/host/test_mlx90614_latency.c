@@ -0,0 +1,137 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_mlx90614_latency.c
+ *
+ * MLX90614 timing test, the initialization and measurement latency of the datasheet 
+ * derived waits is checked against the conservative fixed delays, the application 
+ * start delay is kept and EEPROM writes wait the erase and write cell times
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <mlx90614.h>
+#include "host_test.h"
+
+#define TEST_AMBIENT_TEMPERATURE    (21.5f)
+#define TEST_OBJECT_TEMPERATURE     (36.6f)
+#define TEST_EMISSIVITY             (0.95f)
+#define STARTUP_TIME_US             (20000)     /* driver power-up and application start delays, datasheet power-on reset time */
+#define EEPROM_CYCLE_TIME_US        (5000)      /* datasheet erase or write cell time */
+
+typedef struct test_latency_s {
+    int64_t         init_time_us;
+    i2c_sim_stats_t init_stats;
+    int64_t         meas_time_us;
+    i2c_sim_stats_t meas_stats;
+    int64_t         write_time_us;
+    i2c_sim_stats_t write_stats;
+} test_latency_t;
+
+/* initializes the device, reads the temperatures and writes the emissivity, the virtual time and bus statistics of each are returned */
+static test_latency_t test_accesses(const bool conservative_timing) {
+    test_latency_t latency = { 0 };
+    i2c_sim_model_t *model;
+    mlx90614_config_t dev_config = I2C_MLX90614_CONFIG_DEFAULT;
+    dev_config.conservative_timing = conservative_timing;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_mlx90614_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_mlx90614_set_temperatures(model, TEST_AMBIENT_TEMPERATURE, TEST_OBJECT_TEMPERATURE) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+
+    mlx90614_handle_t dev_handle = NULL;
+    int64_t start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( mlx90614_init(bus_handle, &dev_config, &dev_handle) );
+    latency.init_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.init_stats);
+
+    /* RAM reads, the packet error codes are validated by the driver */
+    float ambient = 0, object1 = 0, object2 = 0;
+    start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( mlx90614_get_temperatures(dev_handle, &ambient, &object1, &object2) );
+    latency.meas_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.meas_stats);
+    HOST_TEST_NEAR( TEST_AMBIENT_TEMPERATURE, ambient, 0.02f );
+    HOST_TEST_NEAR( TEST_OBJECT_TEMPERATURE, object1, 0.02f );
+    HOST_TEST_NEAR( TEST_OBJECT_TEMPERATURE, object2, 0.02f );
+
+    /* EEPROM write, the model does not acknowledge the write or the read back before the previous cycle completes */
+    float emissivity = 0;
+    uint32_t eeprom_writes = 0;
+    start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( mlx90614_set_emissivity(dev_handle, TEST_EMISSIVITY) );
+    latency.write_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.write_stats);
+    HOST_TEST_ESP_OK( mlx90614_get_emissivity(dev_handle, &emissivity) );
+    HOST_TEST_NEAR( TEST_EMISSIVITY, emissivity, 0.0001f );
+    HOST_TEST_ESP_OK( i2c_sim_mlx90614_get_eeprom_writes(model, &eeprom_writes) );
+    HOST_TEST_ASSERT( eeprom_writes == 2 );
+
+    printf("%-12s init %6lld us %lu delays, temperatures %6lld us %lu delays, emissivity write %6lld us %lu delays\n",
+           conservative_timing ? "conservative" : "datasheet",
+           (long long)latency.init_time_us, (unsigned long)latency.init_stats.delays,
+           (long long)latency.meas_time_us, (unsigned long)latency.meas_stats.delays,
+           (long long)latency.write_time_us, (unsigned long)latency.write_stats.delays);
+
+    HOST_TEST_ESP_OK( mlx90614_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+    return latency;
+}
+
+static void test_latency(void) {
+    const test_latency_t conservative = test_accesses(true);
+    const test_latency_t datasheet    = test_accesses(false);
+
+    /* the command delay is skipped, the power-up and application start delays are kept */
+    HOST_TEST_ASSERT( datasheet.init_time_us < conservative.init_time_us );
+    HOST_TEST_ASSERT( datasheet.init_time_us >= STARTUP_TIME_US );
+
+    /* RAM reads need no settling time */
+    HOST_TEST_ASSERT( datasheet.meas_stats.delays == 0 );
+    HOST_TEST_ASSERT( datasheet.meas_stats.transactions == 3 );
+    HOST_TEST_ASSERT( datasheet.meas_time_us < conservative.meas_time_us );
+
+    /* the erase and the write each wait the cell time, without the conservative read and write delays */
+    HOST_TEST_ASSERT( datasheet.write_time_us >= 2 * EEPROM_CYCLE_TIME_US );
+    HOST_TEST_ASSERT( datasheet.write_time_us < conservative.write_time_us );
+    HOST_TEST_ASSERT( datasheet.write_stats.nacks == 0 );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_latency();
+    HOST_TEST_END();
+}
@@ -0,0 +1,179 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_mpu6050_pipeline.c
+ *
+ * MPU6050 interrupt-driven pipeline test, data-ready and motion interrupts are 
+ * raised on the simulator interrupt line, timestamps of the published samples 
+ * are checked against the interrupt times and the bus traffic of a motion 
+ * wake-up is checked for register helper delays
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <unistd.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <mpu6050.h>
+#include "host_test.h"
+
+#define PIPELINE_IRQ_IO_NUM         GPIO_NUM_4
+#define PIPELINE_RATE_DIVIDER       (79)        /* 8 kHz gyroscope output rate / 80, 100 Hz */
+#define PIPELINE_PERIOD_US          (10000)
+#define PIPELINE_WAIT_US            (2000000)   /* host time the test waits for the pipeline task */
+
+static int64_t  pipeline_timestamps[MPU6050_FIFO_SIZE];
+static uint32_t pipeline_sample_count;
+
+static void pipeline_callback(const mpu6050_pipeline_sample_t *samples, const uint16_t count, void *arg) {
+    for(uint16_t i = 0; i < count && pipeline_sample_count < MPU6050_FIFO_SIZE; i++) {
+        pipeline_timestamps[pipeline_sample_count++] = samples[i].timestamp;
+    }
+}
+
+static mpu6050_pipeline_stats_t pipeline_get_stats(mpu6050_handle_t dev_handle) {
+    mpu6050_pipeline_stats_t stats = { 0 };
+    HOST_TEST_ESP_OK( mpu6050_get_pipeline_stats(dev_handle, &stats) );
+    return stats;
+}
+
+/* waits on the host clock until the pipeline task published the number of samples */
+static bool pipeline_wait_samples(mpu6050_handle_t dev_handle, const uint32_t samples) {
+    for(int waited = 0; waited < PIPELINE_WAIT_US; waited += 100) {
+        if(pipeline_get_stats(dev_handle).samples >= samples) return true;
+        usleep(100);
+    }
+    return false;
+}
+
+/* raises the interrupt line after the sample period, returns the interrupt time */
+static int64_t pipeline_data_ready(void) {
+    i2c_sim_advance_time_us(PIPELINE_PERIOD_US);
+    const int64_t irq_time = i2c_sim_get_time_us();
+    HOST_TEST_ESP_OK( i2c_sim_gpio_trigger(PIPELINE_IRQ_IO_NUM) );
+    return irq_time;
+}
+
+/* published samples are a sample period apart and the newest was written at the last interrupt */
+static void pipeline_check_timestamps(const uint32_t first, const int64_t irq_time) {
+    HOST_TEST_ASSERT( pipeline_sample_count > first );
+    for(uint32_t i = first + 1; i < pipeline_sample_count; i++) {
+        HOST_TEST_ASSERT( pipeline_timestamps[i] - pipeline_timestamps[i - 1] == PIPELINE_PERIOD_US );
+    }
+    HOST_TEST_ASSERT( pipeline_timestamps[pipeline_sample_count - 1] == irq_time );
+}
+
+static void test_pipeline(void) {
+    i2c_sim_model_t *model;
+    mpu6050_config_t dev_config = I2C_MPU6050_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    mpu6050_handle_t dev_handle = NULL;
+    const float rest[3] = { 0.0f, 0.0f, 1.0f }, moved[3] = { 0.5f, 0.0f, 1.0f }, gyro[3] = { 0.0f, 0.0f, 0.0f };
+
+    dev_config.i2c_clock_speed = 400000;
+    dev_config.irq_io_num      = PIPELINE_IRQ_IO_NUM;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( gpio_install_isr_service(0) );
+    HOST_TEST_ESP_OK( mpu6050_init(bus_handle, &dev_config, &dev_handle) );
+    HOST_TEST_ESP_OK( mpu6050_set_sample_rate_divider_register(dev_handle, PIPELINE_RATE_DIVIDER) );
+
+    /* streaming, every interrupt is a data-ready interrupt and a frame in the fifo */
+    mpu6050_pipeline_config_t pipeline_config = MPU6050_PIPELINE_CONFIG_DEFAULT;
+    pipeline_config.watermark = 4;
+    pipeline_config.callback  = pipeline_callback;
+    HOST_TEST_ESP_OK( mpu6050_start_pipeline(dev_handle, &pipeline_config) );
+
+    int64_t irq_time = 0;
+    for(uint32_t batch = 1; batch <= 2; batch++) {
+        pipeline_sample_count = 0;
+        for(int i = 0; i < 4; i++) irq_time = pipeline_data_ready();
+        HOST_TEST_ASSERT( pipeline_wait_samples(dev_handle, batch * 4) );
+        HOST_TEST_ASSERT( pipeline_sample_count == 4 );
+        pipeline_check_timestamps(0, irq_time);
+    }
+    HOST_TEST_ESP_OK( mpu6050_stop_pipeline(dev_handle) );
+    HOST_TEST_ASSERT( dev_handle->fifo_enabled == false && dev_handle->fifo_buffer == NULL );
+
+    /* motion gating, the fifo stops until a motion interrupt */
+    pipeline_config.watermark             = 7;
+    pipeline_config.motion_gating_enabled = true;
+    pipeline_config.motion_hold_ms        = 60000;
+    pipeline_sample_count = 0;
+    HOST_TEST_ESP_OK( mpu6050_start_pipeline(dev_handle, &pipeline_config) );
+    HOST_TEST_ASSERT( dev_handle->fifo_enabled == false );
+    i2c_sim_advance_time_us(10 * PIPELINE_PERIOD_US);
+
+    /* the motion wake-up streams with register writes and no command delays */
+    i2c_sim_stats_t bus_stats;
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_set_motion(model, moved, gyro, 25.0f) );
+    pipeline_data_ready();
+    for(int waited = 0; waited < PIPELINE_WAIT_US; waited += 100) {
+        i2c_sim_get_stats(&bus_stats);
+        if(bus_stats.transactions >= 4) break;
+        usleep(100);
+    }
+    usleep(2000);
+    i2c_sim_get_stats(&bus_stats);
+    printf("motion wake-up: %lu transactions %llu us bus time %lu delays %llu us delay time\n", (unsigned long)bus_stats.transactions, 
+           (unsigned long long)bus_stats.bus_time_us, (unsigned long)bus_stats.delays, (unsigned long long)bus_stats.delay_time_us);
+    HOST_TEST_ASSERT( dev_handle->fifo_enabled == true );
+    HOST_TEST_ASSERT( pipeline_get_stats(dev_handle).motion_events == 1 );
+    HOST_TEST_ASSERT( bus_stats.delays == 0 );
+    HOST_TEST_ASSERT( bus_stats.transactions <= 5 );
+
+    /* motion interrupts share the pin, only the frames in the fifo are published and timestamped */
+    HOST_TEST_ESP_OK( i2c_sim_mpu6050_set_motion(model, rest, gyro, 25.0f) );
+    const uint32_t published = pipeline_get_stats(dev_handle).samples;
+    const uint32_t first = pipeline_sample_count;
+    for(int i = 0; i < 5; i++) irq_time = pipeline_data_ready();
+    HOST_TEST_ESP_OK( i2c_sim_gpio_trigger(PIPELINE_IRQ_IO_NUM) );
+    HOST_TEST_ESP_OK( i2c_sim_gpio_trigger(PIPELINE_IRQ_IO_NUM) );
+    HOST_TEST_ASSERT( pipeline_wait_samples(dev_handle, published + 5) );
+    printf("gated batch: %lu samples for 5 data-ready and 2 motion interrupts\n", (unsigned long)(pipeline_sample_count - first));
+    HOST_TEST_ASSERT( pipeline_sample_count - first == 5 || pipeline_sample_count - first == 6 );
+    pipeline_check_timestamps(first, irq_time);
+
+    HOST_TEST_ESP_OK( mpu6050_stop_pipeline(dev_handle) );
+    HOST_TEST_ASSERT( dev_handle->fifo_enabled == false && dev_handle->fifo_buffer == NULL );
+
+    HOST_TEST_ESP_OK( mpu6050_delete(dev_handle) );
+    gpio_uninstall_isr_service();
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    test_pipeline();
+
+    HOST_TEST_END();
+}
@@ -0,0 +1,412 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_onewire_rmt_transaction.c
+ *
+ * 1-wire RMT backend test against the simulator RMT loopback, a line model 
+ * answers the reset, write and read time slots as a DS18B20 and the received 
+ * symbols are decoded by the RMT backend presence, read and transaction decoders
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <rmt_sim.h>
+#include <onewire_bus.h>
+#include <onewire_crc.h>
+#include <ds18b20.h>
+#include "host_test.h"
+
+#define TEST_BUS_GPIO               (4)
+#define TEST_PULLUP_GPIO            (5)
+#define TEST_MAX_RX_BYTES           (19)    /* example application: 1 + 8 + 1 byte scratchpad read command and 9 byte scratchpad */
+#define TEST_SPLIT_MAX_RX_BYTES     (10)    /* scratchpad read does not fit, the transaction is split */
+#define TEST_SERIAL                 UINT64_C(0x0000A1B2C3D4E5)
+#define TEST_PRESENCE_WAIT_US       (30)    /* device presence pulse delay after the reset pulse */
+#define TEST_PRESENCE_US            (120)   /* device presence pulse duration */
+#define TEST_READ_ZERO_US           (30)    /* device holds the line low for a read 0 time slot */
+#define TEST_RESET_MIN_US           (480)   /* reset pulse minimum duration */
+#define TEST_WRITE_ONE_MAX_US       (15)    /* write 1 time slot maximum low duration */
+
+/**
+ * @brief DS18B20 line model slave states.
+ */
+typedef enum {
+    TEST_SLAVE_IDLE,
+    TEST_SLAVE_ROM_CMD,
+    TEST_SLAVE_MATCH_ROM,
+    TEST_SLAVE_FUNC_CMD,
+    TEST_SLAVE_WRITE,
+    TEST_SLAVE_READ
+} test_slave_state_t;
+
+/**
+ * @brief DS18B20 line model slave.
+ */
+typedef struct {
+    bool                     present;
+    onewire_device_address_t address;
+    uint8_t                  scratchpad[9];
+    test_slave_state_t       state;
+    uint8_t                  shift[3];
+    size_t                   bits;
+    bool                     matched;
+    const uint8_t           *tx_data;
+    size_t                   tx_bits;
+    uint8_t                  tx_buffer[9];
+    bool                     pullup_during_slots;
+} test_slave_t;
+
+static test_slave_t test_slave;
+
+static void test_slave_update_crc(void) {
+    test_slave.scratchpad[8] = onewire_crc8(0, test_slave.scratchpad, 8);
+}
+
+static void test_slave_read(const uint8_t *const data, const size_t size) {
+    if (size > 0) memcpy(test_slave.tx_buffer, data, size);
+    test_slave.tx_data = test_slave.tx_buffer;
+    test_slave.tx_bits = size * 8;
+    test_slave.bits    = 0;
+    test_slave.state   = TEST_SLAVE_READ;
+}
+
+/* one time slot, returns true when the slave pulls the line low */
+static bool test_slave_slot(const uint8_t bit) {
+    switch (test_slave.state) {
+    case TEST_SLAVE_ROM_CMD:
+    case TEST_SLAVE_FUNC_CMD:
+        test_slave.shift[0] |= (uint8_t)(bit << test_slave.bits++);
+        if (test_slave.bits < 8) return false;
+        test_slave.bits = 0;
+        if (test_slave.state == TEST_SLAVE_ROM_CMD) {
+            if (test_slave.shift[0] == 0xCC) {
+                test_slave.state = TEST_SLAVE_FUNC_CMD;
+            } else if (test_slave.shift[0] == 0x55) {
+                test_slave.state   = TEST_SLAVE_MATCH_ROM;
+                test_slave.matched = true;
+            } else {
+                test_slave.state = TEST_SLAVE_IDLE;
+            }
+        } else {
+            switch (test_slave.shift[0]) {
+            case 0xBE: test_slave_read(test_slave.scratchpad, sizeof(test_slave.scratchpad)); break;
+            case 0x4E: test_slave.state = TEST_SLAVE_WRITE; memset(test_slave.shift, 0, sizeof(test_slave.shift)); break;
+            case 0xB4: /* externally powered, read slots return ones */
+            case 0x44: /* conversion done, read slots return ones */
+                test_slave_read(NULL, 0);
+                break;
+            default:   test_slave.state = TEST_SLAVE_IDLE; break;
+            }
+        }
+        test_slave.shift[0] = 0;
+        return false;
+    case TEST_SLAVE_MATCH_ROM:
+        if (bit != ((test_slave.address >> test_slave.bits) & 0x01)) test_slave.matched = false;
+        if (++test_slave.bits < 64) return false;
+        test_slave.bits     = 0;
+        test_slave.shift[0] = 0;
+        test_slave.state    = test_slave.matched ? TEST_SLAVE_FUNC_CMD : TEST_SLAVE_IDLE;
+        return false;
+    case TEST_SLAVE_WRITE:
+        test_slave.shift[test_slave.bits / 8] |= (uint8_t)(bit << (test_slave.bits % 8));
+        if (++test_slave.bits < 24) return false;
+        memcpy(&test_slave.scratchpad[2], test_slave.shift, sizeof(test_slave.shift));
+        test_slave_update_crc();
+        test_slave.state = TEST_SLAVE_IDLE;
+        return false;
+    case TEST_SLAVE_READ:
+        if (test_slave.bits >= test_slave.tx_bits) return false;
+        test_slave.bits++;
+        return ((test_slave.tx_data[(test_slave.bits - 1) / 8] >> ((test_slave.bits - 1) % 8)) & 0x01) == 0;
+    default:
+        return false;
+    }
+}
+
+/* rmt line model, the master waveform is rasterized per microsecond and the slave pull downs are applied */
+static size_t test_line_model(void *const context, const rmt_sim_level_t *const master, const size_t master_count,
+                              rmt_sim_level_t *const line, const size_t line_size) {
+    size_t total_us = 0;
+    for (size_t i = 0; i < master_count; i++) total_us += master[i].duration_us;
+
+    /* the strong pull-up would short the time slots */
+    if (gpio_get_level(TEST_PULLUP_GPIO) == 1) test_slave.pullup_during_slots = true;
+
+    uint8_t *const levels = (uint8_t *)malloc(total_us + 1);
+    size_t time_us = 0;
+    for (size_t i = 0; i < master_count; i++) {
+        memset(&levels[time_us], master[i].level, master[i].duration_us);
+        time_us += master[i].duration_us;
+    }
+
+    time_us = 0;
+    for (size_t i = 0; i < master_count; i++) {
+        const size_t start = time_us;
+        const size_t duration = master[i].duration_us;
+        time_us += duration;
+        if (master[i].level) continue;
+
+        size_t pull_start = start, pull_end = start;
+        if (duration >= TEST_RESET_MIN_US) {
+            test_slave.state    = TEST_SLAVE_ROM_CMD;
+            test_slave.bits     = 0;
+            test_slave.shift[0] = 0;
+            if (test_slave.present) {
+                pull_start = time_us + TEST_PRESENCE_WAIT_US;
+                pull_end   = pull_start + TEST_PRESENCE_US;
+            }
+        } else if (test_slave_slot(duration <= TEST_WRITE_ONE_MAX_US ? 1 : 0)) {
+            pull_end = start + TEST_READ_ZERO_US;
+        }
+        for (size_t t = pull_start; t < pull_end && t < total_us; t++) levels[t] = 0;
+    }
+
+    size_t line_count = 0;
+    for (size_t t = 0; t < total_us; t++) {
+        if (line_count > 0 && line[line_count - 1].level == levels[t]) {
+            line[line_count - 1].duration_us++;
+        } else if (line_count < line_size) {
+            line[line_count].level       = levels[t];
+            line[line_count].duration_us = 1;
+            line_count++;
+        }
+    }
+    free(levels);
+
+    return line_count;
+}
+
+static void test_slave_init(void) {
+    uint8_t rom[8] = { 0x28 };
+
+    memset(&test_slave, 0, sizeof(test_slave));
+    for (size_t i = 1; i < 7; i++) rom[i] = (uint8_t)(TEST_SERIAL >> (8 * (i - 1)));
+    rom[7] = onewire_crc8(0, rom, 7);
+    memcpy(&test_slave.address, rom, sizeof(rom));
+
+    /* 21.5625 degrees, 12-bit resolution */
+    const uint8_t scratchpad[8] = { 0x59, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x08, 0x10 };
+    memcpy(test_slave.scratchpad, scratchpad, sizeof(scratchpad));
+    test_slave_update_crc();
+    test_slave.present = true;
+
+    rmt_sim_set_line_model(test_line_model, NULL);
+}
+
+static onewire_bus_handle_t test_new_bus(const uint32_t max_rx_bytes) {
+    onewire_bus_config_t     bus_config = { .bus_gpio_num = TEST_BUS_GPIO };
+    onewire_bus_rmt_config_t rmt_config = { .max_rx_bytes = max_rx_bytes };
+    onewire_bus_handle_t     bus        = NULL;
+
+    HOST_TEST_ESP_OK(onewire_new_bus_rmt(&bus_config, &rmt_config, &bus));
+    rmt_sim_reset_stats();
+
+    return bus;
+}
+
+static void test_scratchpad_command(uint8_t *const tx_buffer, const uint8_t cmd) {
+    tx_buffer[0] = 0x55;
+    memcpy(&tx_buffer[1], &test_slave.address, sizeof(test_slave.address));
+    tx_buffer[9] = cmd;
+}
+
+/* reset pulse, the presence pulse is decoded from the first two received symbols */
+static void test_reset(void) {
+    rmt_sim_stats_t stats;
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_MAX_RX_BYTES);
+
+    HOST_TEST_ESP_OK(onewire_bus_reset(bus));
+    test_slave.present = false;
+    HOST_TEST_ESP_ERR(ESP_ERR_NOT_FOUND, onewire_bus_reset(bus));
+
+    rmt_sim_get_stats(&stats);
+    HOST_TEST_ASSERT(stats.transmits == 2);
+    HOST_TEST_ASSERT(stats.receives == 2);
+    HOST_TEST_ASSERT(stats.rx_overflows == 0);
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* scratchpad read, the reset, rom match, command and 9 byte response are one rmt transmission */
+static void test_transaction(void) {
+    rmt_sim_stats_t stats;
+    uint8_t         tx_buffer[10];
+    uint8_t         rx_buffer[9];
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_MAX_RX_BYTES);
+
+    test_scratchpad_command(tx_buffer, 0xBE);
+    memset(rx_buffer, 0xA5, sizeof(rx_buffer));
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, sizeof(tx_buffer), rx_buffer, sizeof(rx_buffer)));
+    HOST_TEST_ASSERT(memcmp(rx_buffer, test_slave.scratchpad, sizeof(rx_buffer)) == 0);
+
+    rmt_sim_get_stats(&stats);
+    HOST_TEST_ASSERT(stats.transmits == 1);
+    HOST_TEST_ASSERT(stats.receives == 1);
+    HOST_TEST_ASSERT(stats.rx_overflows == 0);
+    /* reset and presence symbols, one symbol per bit slot */
+    HOST_TEST_ASSERT(stats.symbols_received == 2 + (sizeof(tx_buffer) + sizeof(rx_buffer)) * 8);
+
+    /* rom mismatch, the device does not answer and the read slots decode as ones */
+    tx_buffer[1] ^= 0x01;
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, sizeof(tx_buffer), rx_buffer, sizeof(rx_buffer)));
+    for (size_t i = 0; i < sizeof(rx_buffer); i++) HOST_TEST_ASSERT(rx_buffer[i] == 0xFF);
+
+    /* no device, the missing presence pulse fails the transaction */
+    test_slave.present = false;
+    tx_buffer[1] ^= 0x01;
+    HOST_TEST_ESP_ERR(ESP_ERR_NOT_FOUND, onewire_bus_transaction(bus, tx_buffer, sizeof(tx_buffer), rx_buffer, sizeof(rx_buffer)));
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* scratchpad read larger than max_rx_bytes, the reset, write and read are separate transmissions */
+static void test_transaction_split(void) {
+    rmt_sim_stats_t stats;
+    uint8_t         tx_buffer[10];
+    uint8_t         rx_buffer[9];
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_SPLIT_MAX_RX_BYTES);
+
+    test_scratchpad_command(tx_buffer, 0xBE);
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, sizeof(tx_buffer), rx_buffer, sizeof(rx_buffer)));
+    HOST_TEST_ASSERT(memcmp(rx_buffer, test_slave.scratchpad, sizeof(rx_buffer)) == 0);
+
+    rmt_sim_get_stats(&stats);
+    HOST_TEST_ASSERT(stats.transmits == 3);
+    HOST_TEST_ASSERT(stats.receives == 2);
+    HOST_TEST_ASSERT(stats.rx_overflows == 0);
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* scratchpad write transaction without a response and a read time slot */
+static void test_write_and_bit(void) {
+    uint8_t tx_buffer[13];
+    uint8_t bit = 0;
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_MAX_RX_BYTES);
+
+    test_scratchpad_command(tx_buffer, 0x4E);
+    tx_buffer[10] = 0x32;
+    tx_buffer[11] = 0xF6;
+    tx_buffer[12] = 0x3F;
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, sizeof(tx_buffer), NULL, 0));
+    HOST_TEST_ASSERT(test_slave.scratchpad[2] == 0x32);
+    HOST_TEST_ASSERT(test_slave.scratchpad[3] == 0xF6);
+    HOST_TEST_ASSERT(test_slave.scratchpad[4] == 0x3F);
+
+    /* power supply read, an externally powered device answers the read slot with a one */
+    test_scratchpad_command(tx_buffer, 0xB4);
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, 10, NULL, 0));
+    HOST_TEST_ESP_OK(onewire_bus_read_bit(bus, &bit));
+    HOST_TEST_ASSERT(bit == 1);
+
+    /* the scratchpad first byte holds zero bits in the read slots */
+    test_scratchpad_command(tx_buffer, 0xBE);
+    HOST_TEST_ESP_OK(onewire_bus_transaction(bus, tx_buffer, 10, NULL, 0));
+    HOST_TEST_ESP_OK(onewire_bus_read_bit(bus, &bit));
+    HOST_TEST_ASSERT(bit == (test_slave.scratchpad[0] & 0x01));
+    HOST_TEST_ESP_OK(onewire_bus_read_bit(bus, &bit));
+    HOST_TEST_ASSERT(bit == ((test_slave.scratchpad[0] >> 1) & 0x01));
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* ds18b20 driver on the rmt backend, init configures the resolution and the temperature is read back */
+static void test_ds18b20(void) {
+    ds18b20_config_t config  = DS18B20_CONFIG_DEFAULT;
+    ds18b20_handle_t handle  = NULL;
+    float            temperature = 0;
+    rmt_sim_stats_t  stats;
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_MAX_RX_BYTES);
+    onewire_device_t device = { .bus = bus, .address = test_slave.address };
+
+    config.resolution = DS18B20_RESOLUTION_12BIT;
+    HOST_TEST_ESP_OK(ds18b20_init(&device, &config, &handle));
+    HOST_TEST_ESP_OK(ds18b20_get_temperature(handle, &temperature));
+    HOST_TEST_NEAR(21.5625f, temperature, 0.001f);
+
+    rmt_sim_get_stats(&stats);
+    HOST_TEST_ASSERT(stats.rx_overflows == 0);
+
+    HOST_TEST_ESP_OK(ds18b20_delete(handle));
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+/* strong pull-up write, the tx done callback enables the gpio at the end of the last slot and disarms */
+static void test_write_pullup(void) {
+    const uint8_t tx_buffer[] = { 0xCC, 0x44 };
+    rmt_sim_stats_t stats;
+
+    test_slave_init();
+    onewire_bus_handle_t bus = test_new_bus(TEST_MAX_RX_BYTES);
+    HOST_TEST_ESP_OK(gpio_set_level(TEST_PULLUP_GPIO, 0));
+
+    HOST_TEST_ESP_OK(onewire_bus_reset(bus));
+    HOST_TEST_ESP_OK(onewire_bus_write_bytes_pullup(bus, tx_buffer, sizeof(tx_buffer), TEST_PULLUP_GPIO, 1));
+    HOST_TEST_ASSERT(gpio_get_level(TEST_PULLUP_GPIO) == 1);
+    HOST_TEST_ASSERT(test_slave.pullup_during_slots == false);
+
+    rmt_sim_get_stats(&stats);
+    HOST_TEST_ASSERT(stats.transmits == 2);
+
+    /* disarmed, a later write leaves the pull-up gpio alone */
+    HOST_TEST_ESP_OK(gpio_set_level(TEST_PULLUP_GPIO, 0));
+    HOST_TEST_ESP_OK(onewire_bus_reset(bus));
+    HOST_TEST_ESP_OK(onewire_bus_write_bytes(bus, tx_buffer, sizeof(tx_buffer)));
+    HOST_TEST_ASSERT(gpio_get_level(TEST_PULLUP_GPIO) == 0);
+
+    /* ds18b20 parasitic conversion, the pull-up is released once the conversion time is held */
+    const ds18b20_strong_pullup_config_t pullup_config = { .gpio_num = TEST_PULLUP_GPIO, .active_low = false };
+    HOST_TEST_ESP_OK(ds18b20_trigger_bus_temperature_conversion_parasitic(bus, DS18B20_RESOLUTION_12BIT, &pullup_config));
+    HOST_TEST_ASSERT(gpio_get_level(TEST_PULLUP_GPIO) == 0);
+    HOST_TEST_ASSERT(test_slave.pullup_during_slots == false);
+
+    HOST_TEST_ESP_OK(onewire_bus_del(bus));
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_reset();
+    test_transaction();
+    test_transaction_split();
+    test_write_and_bit();
+    test_ds18b20();
+    test_write_pullup();
+    rmt_sim_set_line_model(NULL, NULL);
+    HOST_TEST_END();
+}
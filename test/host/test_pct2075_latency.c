@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_pct2075_latency.c
+ *
+ * PCT2075 timing test, the initialization latency without the conservative command 
+ * delay is checked against the conservative delays, the first temperature read after 
+ * initialization carries a completed conversion and the 8-bit configuration register 
+ * keeps the configured output settings
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <pct2075.h>
+#include "host_test.h"
+
+#define TEST_TEMPERATURE        (23.625f)
+#define CONVERSION_TIME_US      (28000)     /* datasheet temperature conversion time */
+
+typedef struct test_latency_s {
+    int64_t         init_time_us;
+    i2c_sim_stats_t init_stats;
+    int64_t         meas_time_us;
+    i2c_sim_stats_t meas_stats;
+} test_latency_t;
+
+/* powers up the device with the initialization and takes the first measurement, the virtual time and bus statistics of both are returned */
+static test_latency_t test_first_measurement(const bool conservative_timing) {
+    test_latency_t latency = { 0 };
+    i2c_sim_model_t *model;
+    pct2075_config_t dev_config = PCT2075_CONFIG_DEFAULT;
+    dev_config.conservative_timing = conservative_timing;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_pct2075_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_pct2075_set_temperature(model, TEST_TEMPERATURE) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+
+    pct2075_handle_t dev_handle = NULL;
+    int64_t start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( pct2075_init(bus_handle, &dev_config, &dev_handle) );
+    latency.init_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.init_stats);
+
+    /* the first read carries the model temperature, not the 0 degrees Celsius power-on value */
+    float temperature = 0;
+    start_time = i2c_sim_get_time_us();
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( pct2075_get_temperature(dev_handle, &temperature) );
+    latency.meas_time_us = i2c_sim_get_time_us() - start_time;
+    i2c_sim_get_stats(&latency.meas_stats);
+    HOST_TEST_NEAR( TEST_TEMPERATURE, temperature, 0.001f );
+
+    printf("%-12s init %6lld us %2lu transactions %2lu delays, first measurement %6lld us %2lu transactions %2lu delays\n",
+           conservative_timing ? "conservative" : "datasheet",
+           (long long)latency.init_time_us, (unsigned long)latency.init_stats.transactions, (unsigned long)latency.init_stats.delays,
+           (long long)latency.meas_time_us, (unsigned long)latency.meas_stats.transactions, (unsigned long)latency.meas_stats.delays);
+
+    HOST_TEST_ESP_OK( pct2075_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+    return latency;
+}
+
+/* the command delay is skipped, the power-up and application start delays cover the first conversion */
+static void test_latency(void) {
+    const test_latency_t conservative = test_first_measurement(true);
+    const test_latency_t datasheet    = test_first_measurement(false);
+
+    HOST_TEST_ASSERT( datasheet.init_time_us < conservative.init_time_us );
+    HOST_TEST_ASSERT( datasheet.init_time_us >= CONVERSION_TIME_US );
+
+    /* register reads need no settling time */
+    HOST_TEST_ASSERT( datasheet.meas_stats.delays == 0 );
+    HOST_TEST_ASSERT( datasheet.meas_stats.transactions == 1 );
+}
+
+/* the output settings are written to the 8-bit configuration register and read back, set and cleared bits are mixed */
+static void test_configuration(void) {
+    i2c_sim_model_t *model;
+    pct2075_config_t dev_config = PCT2075_CONFIG_DEFAULT;
+    dev_config.operation_mode = PCT2075_OS_OP_MODE_INTERRUPT;
+    dev_config.fault_queue    = PCT2075_OS_FAULT_QUEUE_4;
+
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_pct2075_create(&model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+
+    pct2075_handle_t dev_handle = NULL;
+    HOST_TEST_ESP_OK( pct2075_init(bus_handle, &dev_config, &dev_handle) );
+
+    pct2075_os_operation_modes_t operation_mode;
+    pct2075_os_polarities_t polarity;
+    pct2075_os_fault_queues_t fault_queue;
+    HOST_TEST_ESP_OK( pct2075_get_operation_mode(dev_handle, &operation_mode) );
+    HOST_TEST_ESP_OK( pct2075_get_polarity(dev_handle, &polarity) );
+    HOST_TEST_ESP_OK( pct2075_get_fault_queue(dev_handle, &fault_queue) );
+    HOST_TEST_ASSERT( operation_mode == PCT2075_OS_OP_MODE_INTERRUPT );
+    HOST_TEST_ASSERT( polarity == PCT2075_OS_POL_ACTIVE_LOW );
+    HOST_TEST_ASSERT( fault_queue == PCT2075_OS_FAULT_QUEUE_4 );
+
+    HOST_TEST_ESP_OK( pct2075_delete(dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_latency();
+    test_configuration();
+    HOST_TEST_END();
+}
@@ -0,0 +1,258 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_pulse_oximetry_replay.c
+ *
+ * Pulse oximetry synthetic replay regression test, the red and infrared counts 
+ * of the synthetic takes of `data/ppg_replay.csv` are processed in FIFO sized 
+ * batches and the detected beats, beat-to-beat heart-rate and ratio of ratios 
+ * are checked against the values the takes were synthesized with.  The SpO2 is 
+ * checked against the configured calibration of the measured ratio, for the 
+ * default and a second calibration, the synthetic takes carry no SpO2 reference. 
+ * Batch and per-sample updates agree and batches report dropped beats
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <math.h>
+#include <esp_log.h>
+#include <pulse_oximetry.h>
+#include "host_test.h"
+
+#define REPLAY_FILE         HOST_TEST_DATA_DIR "/ppg_replay.csv"
+#define REPLAY_MAX_SAMPLES  (16000)
+#define REPLAY_MAX_BEATS    (256)
+#define REPLAY_RATE_HZ      (100.0f)
+#define REPLAY_SETTLE_S     (5.0f)      /* filters and averages settle, beats are not checked */
+#define FIFO_BATCH          (32)        /* samples per MAX30105 fifo read */
+
+typedef struct replay_sample_s {
+    int      take;
+    float    time;
+    uint32_t red;
+    uint32_t ir;
+    float    heart_rate;
+    float    ratio;
+} replay_sample_t;
+
+static replay_sample_t samples[REPLAY_MAX_SAMPLES];
+static size_t sample_count;
+
+static bool replay_load(void) {
+    char line[128];
+    FILE *file = fopen(REPLAY_FILE, "r");
+    if(file == NULL) {
+        printf("FAIL unable to open %s\n", REPLAY_FILE);
+        return false;
+    }
+    /* skip header */
+    if(fgets(line, sizeof(line), file) == NULL) {
+        fclose(file);
+        return false;
+    }
+    while(sample_count < REPLAY_MAX_SAMPLES && fgets(line, sizeof(line), file) != NULL) {
+        replay_sample_t *s = &samples[sample_count];
+        int n = sscanf(line, "%d,%f,%u,%u,%f,%f", &s->take, &s->time, &s->red, &s->ir, &s->heart_rate, &s->ratio);
+        if(n == 6) sample_count++;
+    }
+    fclose(file);
+    return sample_count > 0;
+}
+
+/* replays one take in fifo sized batches, returns the number of beats */
+static uint16_t replay_take_batch(pulse_oximetry_handle_t handle, const size_t first, const size_t count, pulse_oximetry_beat_t *beats) {
+    uint32_t red[FIFO_BATCH], ir[FIFO_BATCH];
+    uint16_t beat_count = 0;
+    for(size_t i = 0; i < count; i += FIFO_BATCH) {
+        const uint16_t batch = (count - i) < FIFO_BATCH ? (uint16_t)(count - i) : FIFO_BATCH;
+        uint16_t batch_beats = 0;
+        for(uint16_t j = 0; j < batch; j++) {
+            red[j] = samples[first + i + j].red;
+            ir[j]  = samples[first + i + j].ir;
+        }
+        HOST_TEST_ESP_OK( pulse_oximetry_update_samples(handle, red, ir, batch, &beats[beat_count], REPLAY_MAX_BEATS - beat_count, &batch_beats) );
+        beat_count += batch_beats;
+    }
+    return beat_count;
+}
+
+/* replays one take sample by sample, returns the number of beats */
+static uint16_t replay_take_single(pulse_oximetry_handle_t handle, const size_t first, const size_t count, pulse_oximetry_beat_t *beats) {
+    uint16_t beat_count = 0;
+    for(size_t i = 0; i < count && beat_count < REPLAY_MAX_BEATS; i++) {
+        bool detected = false;
+        HOST_TEST_ESP_OK( pulse_oximetry_update(handle, samples[first + i].red, samples[first + i].ir, &beats[beat_count], &detected) );
+        if(detected) beat_count++;
+    }
+    return beat_count;
+}
+
+/* SpO2 of a ratio with a calibration, clamped like the component */
+static float replay_spo2(const pulse_oximetry_config_t *const config, const float ratio) {
+    const float spo2 = config->spo2_coefficient_a * ratio * ratio + config->spo2_coefficient_b * ratio + config->spo2_coefficient_c;
+    return fminf(fmaxf(spo2, 0.0f), 100.0f);
+}
+
+static void test_take(pulse_oximetry_handle_t handle, const pulse_oximetry_config_t *const config, const size_t first, const size_t count) {
+    static pulse_oximetry_beat_t beats[REPLAY_MAX_BEATS];
+    static pulse_oximetry_beat_t single_beats[REPLAY_MAX_BEATS];
+    const int take = samples[first].take;
+    const uint32_t settle = (uint32_t)(REPLAY_SETTLE_S * REPLAY_RATE_HZ);
+    double expected_beats = 0.0, error_sum = 0.0, error_max = 0.0, ratio_sum = 0.0;
+    uint16_t checked = 0;
+
+    /* expected beats after the settle time, integral of the reference pulse rate */
+    for(size_t i = settle; i < count; i++) {
+        expected_beats += samples[first + i].heart_rate / 60.0 / REPLAY_RATE_HZ;
+    }
+
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    const uint16_t beat_count = replay_take_batch(handle, first, count, beats);
+    for(uint16_t b = 0; b < beat_count; b++) {
+        if(beats[b].sample_index < settle || beats[b].sample_index >= count) continue;
+        const double error = fabs((double)beats[b].heart_rate - samples[first + beats[b].sample_index].heart_rate);
+        error_sum += error;
+        if(error > error_max) error_max = error;
+        ratio_sum += beats[b].ratio;
+        checked++;
+        /* the beat SpO2 is the configured calibration of the measured ratio */
+        HOST_TEST_NEAR(replay_spo2(config, beats[b].ratio), beats[b].spo2, 0.01);
+    }
+
+    const replay_sample_t *last = &samples[first + count - 1];
+    const double ratio = checked ? ratio_sum / checked : 0.0;
+    const float spo2 = beat_count ? beats[beat_count - 1].spo2_average : 0.0f;
+    printf("take %d: %3u beats (expected %5.1f), heart-rate error mean %.2f max %.2f bpm, ratio %.3f (synthesized %.3f), spo2 %.2f %% (calibrated %.2f %%)\n", 
+           take, checked, expected_beats, checked ? error_sum / checked : 0.0, error_max, ratio, last->ratio, spo2, replay_spo2(config, last->ratio));
+
+    HOST_TEST_NEAR(expected_beats, checked, 1.5);
+    HOST_TEST_ASSERT(checked > 0 && error_sum / checked <= 1.0);
+    HOST_TEST_ASSERT(error_max <= 3.0);
+    /* the measured ratio of ratios is independent of the calibration */
+    HOST_TEST_NEAR(last->ratio, ratio, 0.02);
+    HOST_TEST_NEAR(replay_spo2(config, last->ratio), spo2, 0.75);
+    if(beat_count > 0) {
+        HOST_TEST_NEAR(last->heart_rate, beats[beat_count - 1].heart_rate_average, 3.0);
+    }
+
+    /* the per-sample update detects the same beats */
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    const uint16_t single_count = replay_take_single(handle, first, count, single_beats);
+    HOST_TEST_ASSERT(single_count == beat_count);
+    for(uint16_t b = 0; b < beat_count && b < single_count; b++) {
+        HOST_TEST_ASSERT(single_beats[b].sample_index == beats[b].sample_index);
+        HOST_TEST_ASSERT(single_beats[b].spo2_average == beats[b].spo2_average);
+    }
+}
+
+/* a batch with more beats than beat results processes all samples and reports the dropped beats */
+static void test_beat_overflow(pulse_oximetry_handle_t handle, const size_t count) {
+    static uint32_t red[REPLAY_MAX_SAMPLES], ir[REPLAY_MAX_SAMPLES];
+    pulse_oximetry_beat_t beats[4], next_beat, expected_beat;
+    uint16_t beat_count = 0;
+    bool detected = false;
+
+    for(size_t i = 0; i < count; i++) {
+        red[i] = samples[i].red;
+        ir[i]  = samples[i].ir;
+    }
+
+    /* reference, the samples of the batch followed by the next beat */
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_SIZE, pulse_oximetry_update_samples(handle, red, ir, (uint16_t)count, NULL, 0, &beat_count) );
+    HOST_TEST_ASSERT(beat_count == 0);
+    for(size_t i = count; i < sample_count && !detected; i++) {
+        HOST_TEST_ESP_OK( pulse_oximetry_update(handle, samples[i].red, samples[i].ir, &expected_beat, &detected) );
+    }
+    HOST_TEST_ASSERT(detected);
+
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_SIZE, pulse_oximetry_update_samples(handle, red, ir, (uint16_t)count, beats, 4, &beat_count) );
+    HOST_TEST_ASSERT(beat_count == 4);
+    detected = false;
+    for(size_t i = count; i < sample_count && !detected; i++) {
+        HOST_TEST_ESP_OK( pulse_oximetry_update(handle, samples[i].red, samples[i].ir, &next_beat, &detected) );
+    }
+    HOST_TEST_ASSERT(detected && memcmp(&next_beat, &expected_beat, sizeof(next_beat)) == 0);
+
+    /* enough beat results */
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    HOST_TEST_ESP_OK( pulse_oximetry_update_samples(handle, red, ir, 4 * (uint16_t)REPLAY_RATE_HZ, beats, 4, &beat_count) );
+    HOST_TEST_ASSERT(beat_count <= 4);
+}
+
+int main(void) {
+    /* the default quadratic calibration and a linear calibration, SpO2 = 110 - 25 * R */
+    pulse_oximetry_config_t configs[2] = { PULSE_OXIMETRY_CONFIG_DEFAULT, PULSE_OXIMETRY_CONFIG_DEFAULT };
+    pulse_oximetry_handle_t handle = NULL;
+
+    configs[1].spo2_coefficient_a = 0.0f;
+    configs[1].spo2_coefficient_b = -25.0f;
+    configs[1].spo2_coefficient_c = 110.0f;
+
+    esp_log_level_set("*", ESP_LOG_ERROR);
+
+    HOST_TEST_ASSERT(replay_load());
+    printf("replayed %zu samples\n", sample_count);
+    if(sample_count == 0) HOST_TEST_END();
+
+    for(int c = 0; c < 2; c++) {
+        configs[c].sample_rate = REPLAY_RATE_HZ;
+        HOST_TEST_ESP_OK( pulse_oximetry_init(&configs[c], &handle) );
+        if(handle == NULL) HOST_TEST_END();
+
+        /* the takes are independent, detection restarts per take */
+        size_t first = 0;
+        for(size_t i = 1; i <= sample_count; i++) {
+            if(i == sample_count || samples[i].take != samples[first].take) {
+                test_take(handle, &configs[c], first, i - first);
+                first = i;
+            }
+        }
+
+        HOST_TEST_ESP_OK( pulse_oximetry_delete(handle) );
+    }
+
+    HOST_TEST_ESP_OK( pulse_oximetry_init(&configs[0], &handle) );
+    if(handle == NULL) HOST_TEST_END();
+
+    /* the first 20 s of the first take, about 20 beats */
+    test_beat_overflow(handle, 20 * (size_t)REPLAY_RATE_HZ);
+
+    /* no finger, the infrared dc count is below the presence threshold */
+    HOST_TEST_ESP_OK( pulse_oximetry_reset(handle) );
+    for(uint32_t i = 0; i < 10 * (uint32_t)REPLAY_RATE_HZ; i++) {
+        pulse_oximetry_beat_t beat;
+        bool detected = true;
+        HOST_TEST_ESP_OK( pulse_oximetry_update(handle, 2000 + (i % 100) * 20, 2500 + (i % 100) * 25, &beat, &detected) );
+        HOST_TEST_ASSERT(!detected);
+        if(detected) break;
+    }
+
+    HOST_TEST_ESP_OK( pulse_oximetry_delete(handle) );
+
+    HOST_TEST_END();
+}
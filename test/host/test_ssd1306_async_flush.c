@@ -0,0 +1,244 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ssd1306_async_flush.c
+ *
+ * SSD1306 asynchronous double-buffered flush test, the flush task start and 
+ * stop lifecycle, back to front buffer swaps against the simulator display 
+ * RAM, the frame rate limit in virtual time, and drawing into the back buffer 
+ * while the flush task writes the front buffer
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <unistd.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <ssd1306.h>
+#include "host_test.h"
+
+#define ASYNC_PAGES             (8)
+#define ASYNC_WIDTH             (128)
+#define ASYNC_FULL_BYTES        (ASYNC_PAGES * ASYNC_WIDTH)
+#define ASYNC_FRAME_RATE        (20)
+#define ASYNC_WAIT_US           (2000000)   /* real time bound of a flush task wait */
+
+typedef struct async_fixture_s {
+    i2c_sim_model_t         *model;
+    i2c_master_bus_handle_t  bus_handle;
+    ssd1306_handle_t         dev_handle;
+} async_fixture_t;
+
+static uint8_t async_framebuffer[ASYNC_FULL_BYTES], async_ram[ASYNC_FULL_BYTES];
+
+static void async_fixture_init(async_fixture_t *const fixture) {
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &fixture->model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, fixture->model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &fixture->bus_handle) );
+    HOST_TEST_ESP_OK( ssd1306_init(fixture->bus_handle, &dev_config, &fixture->dev_handle) );
+}
+
+static void async_fixture_delete(async_fixture_t *const fixture) {
+    HOST_TEST_ESP_OK( ssd1306_delete(fixture->dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(fixture->bus_handle) );
+}
+
+/* true when the display RAM matches the expected framebuffer */
+static bool async_ram_equals(async_fixture_t *const fixture, const uint8_t *const expected) {
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_get_ram(fixture->model, async_ram, sizeof(async_ram)) );
+    return memcmp(expected, async_ram, sizeof(async_ram)) == 0;
+}
+
+/* waits for the flush task to write the expected framebuffer to the display RAM */
+static bool async_wait_ram(async_fixture_t *const fixture, const uint8_t *const expected) {
+    for(int waited = 0; waited < ASYNC_WAIT_US; waited += 100) {
+        if(async_ram_equals(fixture, expected)) return true;
+        usleep(100);
+    }
+    return false;
+}
+
+/* waits for the flush task to write a number of frames */
+static void async_wait_frames(async_fixture_t *const fixture, const uint32_t frames) {
+    ssd1306_flush_stats_t stats;
+    for(int waited = 0; waited < ASYNC_WAIT_US; waited += 100) {
+        HOST_TEST_ESP_OK( ssd1306_get_flush_stats(fixture->dev_handle, &stats) );
+        if(stats.frames >= frames) return;
+        usleep(100);
+    }
+    HOST_TEST_ASSERT( stats.frames >= frames );
+}
+
+static void test_lifecycle(void) {
+    async_fixture_t fixture;
+    ssd1306_flush_config_t flush_config = SSD1306_FLUSH_CONFIG_DEFAULT;
+    async_fixture_init(&fixture);
+
+    /* swaps need the flush task */
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_STATE, ssd1306_swap_buffers(fixture.dev_handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, ssd1306_enable_async_flush(fixture.dev_handle, &(ssd1306_flush_config_t){ .max_frame_rate = 0 }) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, ssd1306_enable_async_flush(fixture.dev_handle, NULL) );
+
+    /* start, a second start is rejected, stop is idempotent, restart */
+    for(int cycle = 0; cycle < 3; cycle++) {
+        HOST_TEST_ESP_OK( ssd1306_enable_async_flush(fixture.dev_handle, &flush_config) );
+        HOST_TEST_ESP_ERR( ESP_ERR_INVALID_STATE, ssd1306_enable_async_flush(fixture.dev_handle, &flush_config) );
+
+        HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, (uint8_t)(10 + cycle), 10, false) );
+        HOST_TEST_ESP_OK( ssd1306_swap_buffers(fixture.dev_handle) );
+        HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+        HOST_TEST_ASSERT( async_wait_ram(&fixture, async_framebuffer) );
+
+        HOST_TEST_ESP_OK( ssd1306_disable_async_flush(fixture.dev_handle) );
+        HOST_TEST_ESP_OK( ssd1306_disable_async_flush(fixture.dev_handle) );
+        HOST_TEST_ESP_ERR( ESP_ERR_INVALID_STATE, ssd1306_swap_buffers(fixture.dev_handle) );
+    }
+
+    /* stopped, display pages writes the panel synchronously again */
+    i2c_sim_stats_t stats;
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 20, 20, false) );
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( ssd1306_display_pages(fixture.dev_handle) );
+    i2c_sim_get_stats(&stats);
+    HOST_TEST_ASSERT( stats.transactions > 0 );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    HOST_TEST_ASSERT( async_ram_equals(&fixture, async_framebuffer) );
+
+    /* delete stops a running flush task and writes its pending windows */
+    HOST_TEST_ESP_OK( ssd1306_enable_async_flush(fixture.dev_handle, &flush_config) );
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 30, 30, false) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    async_fixture_delete(&fixture);
+    HOST_TEST_ASSERT( async_ram_equals(&fixture, async_framebuffer) );
+}
+
+static void test_swap(void) {
+    async_fixture_t fixture;
+    ssd1306_flush_config_t flush_config = SSD1306_FLUSH_CONFIG_DEFAULT;
+    ssd1306_flush_stats_t stats;
+    static uint8_t swapped[ASYNC_FULL_BYTES];
+    async_fixture_init(&fixture);
+
+    HOST_TEST_ESP_OK( ssd1306_invalidate_pages(fixture.dev_handle) );
+    HOST_TEST_ESP_OK( ssd1306_display_pages(fixture.dev_handle) );
+    HOST_TEST_ESP_OK( ssd1306_enable_async_flush(fixture.dev_handle, &flush_config) );
+    HOST_TEST_ESP_OK( ssd1306_reset_flush_stats(fixture.dev_handle) );
+
+    /* display pages swaps and returns without a bus transaction, the flush task writes the window */
+    HOST_TEST_ESP_OK( ssd1306_set_rectangle(fixture.dev_handle, 8, 8, 16, 16, false) );
+    HOST_TEST_ESP_OK( ssd1306_display_pages(fixture.dev_handle) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, swapped) );
+    HOST_TEST_ASSERT( async_wait_ram(&fixture, swapped) );
+    HOST_TEST_ESP_OK( ssd1306_get_flush_stats(fixture.dev_handle, &stats) );
+    HOST_TEST_ASSERT( stats.swaps == 1 && stats.frames == 1 );
+    /* only the rectangle windows, 16 columns of 3 pages */
+    HOST_TEST_ASSERT( stats.windows == 3 && stats.bytes <= 3 * (16 + 8) );
+
+    /* the back buffer is not shown until it is swapped */
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 100, 50, false) );
+    usleep(20000);
+    HOST_TEST_ASSERT( async_ram_equals(&fixture, swapped) );
+
+    /* the back buffer keeps its content after a swap, drawing stays incremental */
+    HOST_TEST_ESP_OK( ssd1306_swap_buffers(fixture.dev_handle) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    HOST_TEST_ASSERT( memcmp(async_framebuffer, swapped, sizeof(swapped)) != 0 );
+    HOST_TEST_ASSERT( async_wait_ram(&fixture, async_framebuffer) );
+
+    /* display image writes the back buffer and swaps */
+    const uint8_t image[4] = { 0xff, 0x81, 0x81, 0xff };
+    HOST_TEST_ESP_OK( ssd1306_display_image(fixture.dev_handle, 7, 60, image, sizeof(image)) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    HOST_TEST_ASSERT( memcmp(&async_framebuffer[7 * ASYNC_WIDTH + 60], image, sizeof(image)) == 0 );
+    HOST_TEST_ASSERT( async_wait_ram(&fixture, async_framebuffer) );
+
+    /* frames are limited to the maximum frame rate in virtual time */
+    HOST_TEST_ESP_OK( ssd1306_get_flush_stats(fixture.dev_handle, &stats) );
+    const uint32_t frames = stats.frames;
+    const int64_t  start_us = i2c_sim_get_time_us();
+    for(int frame = 0; frame < 10; frame++) {
+        HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, (uint8_t)(64 + frame), 40, false) );
+        HOST_TEST_ESP_OK( ssd1306_swap_buffers(fixture.dev_handle) );
+        async_wait_frames(&fixture, frames + frame + 1);
+    }
+    const int64_t elapsed_us = i2c_sim_get_time_us() - start_us;
+    printf("10 frames in %lld us virtual time at %d Hz\n", (long long)elapsed_us, ASYNC_FRAME_RATE);
+    HOST_TEST_ASSERT( elapsed_us >= 9 * 1000000LL / ASYNC_FRAME_RATE );
+
+    HOST_TEST_ESP_OK( ssd1306_disable_async_flush(fixture.dev_handle) );
+    async_fixture_delete(&fixture);
+}
+
+static void test_concurrent_drawing(void) {
+    async_fixture_t fixture;
+    ssd1306_flush_config_t flush_config = SSD1306_FLUSH_CONFIG_DEFAULT;
+    ssd1306_glyph_cache_handle_t cache = NULL;
+    ssd1306_flush_stats_t stats;
+    async_fixture_init(&fixture);
+    HOST_TEST_ESP_OK( ssd1306_get_latin_8x8_glyph_cache(&cache) );
+
+    HOST_TEST_ESP_OK( ssd1306_enable_async_flush(fixture.dev_handle, &flush_config) );
+    HOST_TEST_ESP_OK( ssd1306_reset_flush_stats(fixture.dev_handle) );
+
+    /* status fields are redrawn and swapped without waiting, the flush task writes frames meanwhile */
+    for(int update = 0; update < 500; update++) {
+        char text[8];
+        snprintf(text, sizeof(text), "%04d", update);
+        HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, 0, (uint8_t)((update % 8) * 8), text, false) );
+        snprintf(text, sizeof(text), "%04d", 9999 - update);
+        HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, 64, (uint8_t)((update % 5) * 12), text, false) );
+        HOST_TEST_ESP_OK( ssd1306_display_pages(fixture.dev_handle) );
+        /* lets the flush task take the front buffer between updates */
+        if(update % 10 == 0) usleep(100);
+    }
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    HOST_TEST_ASSERT( async_wait_ram(&fixture, async_framebuffer) );
+
+    /* drawing continues while the last frame is written, the pending windows are written on stop */
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, 32, 56, "stop", false) );
+    HOST_TEST_ESP_OK( ssd1306_disable_async_flush(fixture.dev_handle) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture.dev_handle, async_framebuffer) );
+    HOST_TEST_ASSERT( async_ram_equals(&fixture, async_framebuffer) );
+
+    HOST_TEST_ESP_OK( ssd1306_get_flush_stats(fixture.dev_handle, &stats) );
+    printf("500 swaps, %lu frames, %lu windows, %llu bytes, %.2f ms average frame\n", (unsigned long)stats.frames, 
+           (unsigned long)stats.windows, (unsigned long long)stats.bytes, (double)stats.average_frame_ms);
+    HOST_TEST_ASSERT( stats.swaps == 500 );
+    HOST_TEST_ASSERT( stats.frames >= 1 && stats.frames <= stats.swaps + 1 );
+
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(cache) );
+    async_fixture_delete(&fixture);
+}
+
+int main(void) {
+    test_lifecycle();
+    test_swap();
+    test_concurrent_drawing();
+    HOST_TEST_END();
+}
@@ -0,0 +1,147 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ssd1306_flush.c
+ *
+ * SSD1306 dirty-region flush test, typical user interface updates are drawn 
+ * into the framebuffer and flushed to the simulator display model, the bytes 
+ * and transactions on the bus are checked against the changed column windows 
+ * and the display RAM against the framebuffer
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <ssd1306.h>
+#include "host_test.h"
+
+#define FLUSH_PAGES             (8)
+#define FLUSH_WIDTH             (128)
+#define FLUSH_FULL_BYTES        (FLUSH_PAGES * FLUSH_WIDTH)
+
+typedef struct flush_fixture_s {
+    i2c_sim_model_t         *model;
+    i2c_master_bus_handle_t  bus_handle;
+    ssd1306_handle_t         dev_handle;
+} flush_fixture_t;
+
+static void flush_fixture_init(flush_fixture_t *const fixture) {
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &fixture->model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, fixture->model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &fixture->bus_handle) );
+    HOST_TEST_ESP_OK( ssd1306_init(fixture->bus_handle, &dev_config, &fixture->dev_handle) );
+}
+
+static void flush_fixture_delete(flush_fixture_t *const fixture) {
+    HOST_TEST_ESP_OK( ssd1306_delete(fixture->dev_handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(fixture->bus_handle) );
+}
+
+/* flushes the framebuffer and returns the bus statistics of the flush, the display RAM must match the framebuffer */
+static i2c_sim_stats_t flush(flush_fixture_t *const fixture, const char *const update) {
+    static uint8_t framebuffer[FLUSH_FULL_BYTES], ram[FLUSH_FULL_BYTES];
+    i2c_sim_stats_t stats;
+
+    i2c_sim_reset_stats();
+    HOST_TEST_ESP_OK( ssd1306_display_pages(fixture->dev_handle) );
+    i2c_sim_get_stats(&stats);
+
+    HOST_TEST_ESP_OK( ssd1306_get_pages(fixture->dev_handle, framebuffer) );
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_get_ram(fixture->model, ram, sizeof(ram)) );
+    const bool equal = (memcmp(framebuffer, ram, sizeof(ram)) == 0);
+    printf("%-24s %5llu bytes %3lu transactions %6llu us bus time%s\n", update, (unsigned long long)stats.bytes_written, 
+           (unsigned long)stats.transactions, (unsigned long long)stats.bus_time_us, equal ? "" : " (display RAM differs)");
+    HOST_TEST_ASSERT( equal );
+    return stats;
+}
+
+static void test_dirty_flush(void) {
+    flush_fixture_t fixture;
+    ssd1306_glyph_cache_handle_t cache = NULL;
+    flush_fixture_init(&fixture);
+    HOST_TEST_ESP_OK( ssd1306_get_latin_8x8_glyph_cache(&cache) );
+
+    /* a full refresh sends every page once, a whole page per transaction at most */
+    HOST_TEST_ESP_OK( ssd1306_invalidate_pages(fixture.dev_handle) );
+    i2c_sim_stats_t stats = flush(&fixture, "full refresh");
+    HOST_TEST_ASSERT( stats.bytes_written >= FLUSH_FULL_BYTES && stats.bytes_written <= FLUSH_FULL_BYTES + FLUSH_PAGES * 8 );
+    HOST_TEST_ASSERT( stats.transactions <= 2 * FLUSH_PAGES );
+    const uint64_t full_bytes = stats.bytes_written;
+
+    /* nothing changed, nothing is sent */
+    stats = flush(&fixture, "unchanged");
+    HOST_TEST_ASSERT( stats.bytes_written == 0 && stats.transactions == 0 );
+
+    /* one pixel is one column of one page */
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 10, 10, false) );
+    stats = flush(&fixture, "one pixel");
+    HOST_TEST_ASSERT( stats.bytes_written >= 1 && stats.bytes_written <= 1 + 8 );
+    HOST_TEST_ASSERT( stats.transactions <= 2 );
+
+    /* a 4 character numeric field on a page boundary, 32 columns of 2 pages */
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, 40, 20, "23.4", false) );
+    stats = flush(&fixture, "4 glyphs, 2 pages");
+    HOST_TEST_ASSERT( stats.bytes_written >= 2 * 32 && stats.bytes_written <= 2 * (32 + 8) );
+
+    /* one changed digit, only the columns of the glyph that differs are resent */
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, 40, 20, "23.5", false) );
+    stats = flush(&fixture, "1 changed glyph");
+    HOST_TEST_ASSERT( stats.bytes_written <= 2 * (8 + 8) );
+    HOST_TEST_ASSERT( stats.transactions <= 2 );
+
+    /* a box outline spans 3 pages and 30 columns */
+    HOST_TEST_ESP_OK( ssd1306_set_rectangle(fixture.dev_handle, 70, 36, 30, 12, false) );
+    stats = flush(&fixture, "30x12 rectangle");
+    HOST_TEST_ASSERT( stats.bytes_written >= 2 * 30 && stats.bytes_written <= 3 * (30 + 8) );
+
+    /* two separate fields on one page are flushed as their bounding column window */
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 0, 60, false) );
+    HOST_TEST_ESP_OK( ssd1306_set_pixel(fixture.dev_handle, 127, 60, false) );
+    stats = flush(&fixture, "two pixels, one page");
+    HOST_TEST_ASSERT( stats.bytes_written <= FLUSH_WIDTH + 8 );
+
+    /* a status screen update of a dozen fields is a fraction of a full refresh */
+    for(int field = 0; field < 12; field++) {
+        char text[4];
+        snprintf(text, sizeof(text), "%02d", field * 7);
+        HOST_TEST_ESP_OK( ssd1306_set_glyph_text(fixture.dev_handle, cache, (uint8_t)((field % 4) * 32), (uint8_t)((field / 4) * 16 + 8), text, false) );
+    }
+    stats = flush(&fixture, "12 fields of 2 glyphs");
+    HOST_TEST_ASSERT( stats.bytes_written < full_bytes / 2 );
+    HOST_TEST_ASSERT( stats.transactions <= FLUSH_PAGES );
+
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(cache) );
+    flush_fixture_delete(&fixture);
+}
+
+int main(void) {
+    test_dirty_flush();
+    HOST_TEST_END();
+}
@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_ssd1306_glyph.c
+ *
+ * SSD1306 glyph cache test, text blitted from the pre-rotated glyph caches at 
+ * page-aligned and unaligned y-axis positions is checked against the per-pixel 
+ * rendering of the same font
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <esp_log.h>
+#include <i2c_sim.h>
+#include <i2c_sim_models.h>
+#include <ssd1306.h>
+#include <font_latin_8x8.h>
+#include <bdf_font_nenr12_21x26.h>
+#include "host_test.h"
+
+#define GLYPH_BUFFER_SIZE   (128 * 64 / 8)
+
+static uint8_t blitted[GLYPH_BUFFER_SIZE], reference[GLYPH_BUFFER_SIZE];
+
+/* per-pixel rendering of the latin 8x8 font, the column bytes are least significant bit at the top */
+static void render_latin(ssd1306_handle_t handle, const uint8_t xpos, const uint8_t ypos, const char *text) {
+    for(int k = 0; text[k] != '\0'; k++) {
+        for(int x = 0; x < 8; x++) {
+            for(int r = 0; r < 8; r++) {
+                if((font_latin_8x8_tr[(uint8_t)text[k]][x] & (1 << r)) && ypos + r < 64) {
+                    ssd1306_set_pixel(handle, (uint8_t)(xpos + k * 8 + x), (uint8_t)(ypos + r), false);
+                }
+            }
+        }
+    }
+}
+
+/* per-pixel rendering of a BDF font through the bitmap loader */
+static void render_bdf(ssd1306_handle_t handle, const uint8_t *font, const uint8_t xpos, const uint8_t ypos, const char *text) {
+    int x = xpos;
+    for(int k = 0; text[k] != '\0'; k++) {
+        ssd1306_bdf_font_t bdf_font;
+        uint8_t bitmap[256] = { 0 };
+        HOST_TEST_ESP_OK( ssd1306_load_bitmap_font(font, (uint8_t)text[k], bitmap, &bdf_font) );
+        const int height = bdf_font.y_end - bdf_font.y_start + 1;
+        const int byte_width = bdf_font.num_data / height;
+        ssd1306_set_bitmap(handle, (uint8_t)x, (uint8_t)(ypos + bdf_font.y_start), bitmap, (uint8_t)(byte_width * 8), (uint8_t)height, false);
+        x += bdf_font.width;
+    }
+}
+
+int main(void) {
+    ssd1306_config_t dev_config = SSD1306_128x64_CONFIG_DEFAULT;
+    i2c_master_bus_config_t bus_config = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_handle = NULL;
+    i2c_sim_model_t *model = NULL;
+    ssd1306_handle_t handle = NULL;
+    ssd1306_glyph_cache_handle_t latin = NULL, bdf = NULL;
+
+    /* the bitmap font loader logs every glyph */
+    esp_log_level_set("*", ESP_LOG_WARN);
+    i2c_sim_reset();
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_create(64, &model) );
+    HOST_TEST_ESP_OK( i2c_sim_add_device(I2C_NUM_0, dev_config.i2c_address, model) );
+    HOST_TEST_ESP_OK( i2c_new_master_bus(&bus_config, &bus_handle) );
+    HOST_TEST_ESP_OK( ssd1306_init(bus_handle, &dev_config, &handle) );
+    HOST_TEST_ESP_OK( ssd1306_get_latin_8x8_glyph_cache(&latin) );
+    HOST_TEST_ESP_OK( ssd1306_create_glyph_cache(bdf_font_nenr12_21x26, 32, 126, &bdf) );
+
+    /* latin 8x8 at every y-axis position, page aligned and unaligned */
+    int mismatches = 0;
+    for(uint8_t y = 0; y < 60; y++) {
+        HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+        HOST_TEST_ESP_OK( ssd1306_set_glyph_text(handle, latin, 5, y, "Az9%", false) );
+        HOST_TEST_ESP_OK( ssd1306_get_pages(handle, blitted) );
+        HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+        render_latin(handle, 5, y, "Az9%");
+        HOST_TEST_ESP_OK( ssd1306_get_pages(handle, reference) );
+        if(memcmp(blitted, reference, sizeof(reference)) != 0) {
+            printf("latin 8x8 differs at y %u\n", y);
+            mismatches++;
+        }
+    }
+
+    /* BDF glyphs taller than a page */
+    for(uint8_t y = 0; y < 40; y += 3) {
+        HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+        HOST_TEST_ESP_OK( ssd1306_set_glyph_text(handle, bdf, 3, y, "12.5C", false) );
+        HOST_TEST_ESP_OK( ssd1306_get_pages(handle, blitted) );
+        HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+        render_bdf(handle, bdf_font_nenr12_21x26, 3, y, "12.5C");
+        HOST_TEST_ESP_OK( ssd1306_get_pages(handle, reference) );
+        if(memcmp(blitted, reference, sizeof(reference)) != 0) {
+            printf("bdf differs at y %u\n", y);
+            mismatches++;
+        }
+    }
+    HOST_TEST_ASSERT( mismatches == 0 );
+
+    /* glyph cells are opaque, overwriting a field leaves no trace of the previous text */
+    HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(handle, bdf, 0, 13, "88", false) );
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(handle, bdf, 0, 13, "11", false) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(handle, blitted) );
+    HOST_TEST_ESP_OK( ssd1306_clear_display(handle, false) );
+    HOST_TEST_ESP_OK( ssd1306_set_glyph_text(handle, bdf, 0, 13, "11", false) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(handle, reference) );
+    HOST_TEST_ASSERT( memcmp(blitted, reference, sizeof(reference)) == 0 );
+
+    /* the displayed text reaches the panel */
+    HOST_TEST_ESP_OK( ssd1306_display_glyph_text(handle, latin, 0, 3, "OK", false) );
+    HOST_TEST_ESP_OK( ssd1306_get_pages(handle, blitted) );
+    HOST_TEST_ESP_OK( i2c_sim_ssd1306_get_ram(model, reference, sizeof(reference)) );
+    HOST_TEST_ASSERT( memcmp(blitted, reference, sizeof(reference)) == 0 );
+
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(bdf) );
+    HOST_TEST_ESP_OK( ssd1306_delete_glyph_cache(latin) );
+    HOST_TEST_ESP_OK( ssd1306_delete(handle) );
+    HOST_TEST_ESP_OK( i2c_del_master_bus(bus_handle) );
+    HOST_TEST_END();
+}
@@ -0,0 +1,155 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_type_utils.c
+ *
+ * Type utilities unit test, binary strings, scalar byte conversions and the 
+ * packed register field array decoders for every width, byte order and 
+ * signedness
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <type_utils.h>
+#include "host_test.h"
+
+#define TU_FIELDS   (75)    /* not a multiple of the float decoder block size */
+
+static void test_binary_strings(void) {
+    bin8_char_buffer_t  b8;
+    bin16_char_buffer_t b16;
+    bin32_char_buffer_t b32;
+    bin64_char_buffer_t b64;
+
+    HOST_TEST_ASSERT( strcmp(uint8_to_binary(0xa5), "10100101") == 0 );
+    HOST_TEST_ASSERT( strcmp(int8_to_binary(-1), "11111111") == 0 );
+    HOST_TEST_ASSERT( strcmp(uint16_to_binary(0x8001), "1000000000000001") == 0 );
+    HOST_TEST_ASSERT( strcmp(uint8_to_binary_r(0x5a, b8), "01011010") == 0 );
+    HOST_TEST_ASSERT( uint8_to_binary_r(0x5a, b8) == b8 );
+    HOST_TEST_ASSERT( strcmp(int8_to_binary_r(-128, b8), "10000000") == 0 );
+    HOST_TEST_ASSERT( strcmp(uint16_to_binary_r(0x00ff, b16), "0000000011111111") == 0 );
+    HOST_TEST_ASSERT( strcmp(int16_to_binary_r(-2, b16), "1111111111111110") == 0 );
+    HOST_TEST_ASSERT( strcmp(uint32_to_binary_r(0x80000001u, b32), "10000000000000000000000000000001") == 0 );
+    HOST_TEST_ASSERT( strcmp(int32_to_binary_r(-1, b32), "11111111111111111111111111111111") == 0 );
+    HOST_TEST_ASSERT( strlen(uint64_to_binary_r(UINT64_C(1) << 63, b64)) == 64 );
+    HOST_TEST_ASSERT( b64[0] == '1' && b64[63] == '0' );
+    HOST_TEST_ASSERT( strcmp(int64_to_binary_r(1, b64) + 62, "01") == 0 );
+}
+
+static void test_scalar_bytes(void) {
+    uint8_t bytes[8];
+
+    uint16_to_bytes(0x1234, bytes, false);
+    HOST_TEST_ASSERT( bytes[0] == 0x12 && bytes[1] == 0x34 );
+    HOST_TEST_ASSERT( bytes_to_uint16(bytes, false) == 0x1234 );
+    HOST_TEST_ASSERT( bytes_to_uint16(bytes, true) == 0x3412 );
+    int16_to_bytes(-2, bytes, true);
+    HOST_TEST_ASSERT( bytes_to_int16(bytes, true) == -2 );
+    uint32_to_bytes(0xdeadbeefu, bytes, true);
+    HOST_TEST_ASSERT( bytes[0] == 0xef && bytes[3] == 0xde );
+    HOST_TEST_ASSERT( bytes_to_uint32(bytes, true) == 0xdeadbeefu );
+    int32_to_bytes(-123456, bytes, false);
+    HOST_TEST_ASSERT( bytes_to_int32(bytes, false) == -123456 );
+    uint64_to_bytes(UINT64_C(0x0102030405060708), bytes, false);
+    HOST_TEST_ASSERT( bytes[0] == 0x01 && bytes[7] == 0x08 );
+    HOST_TEST_ASSERT( bytes_to_uint64(bytes, false) == UINT64_C(0x0102030405060708) );
+    int64_to_bytes(INT64_C(-9876543210), bytes, true);
+    HOST_TEST_ASSERT( bytes_to_int64(bytes, true) == INT64_C(-9876543210) );
+}
+
+/* encodes a field value to its packed register bytes, 20-bit fields are left justified */
+static void encode_field(uint8_t *const bytes, const uint32_t value, const type_utils_field_widths_t width, const bool little_endian) {
+    const size_t size = type_utils_field_size(width);
+    const uint32_t word = (width == TYPE_UTILS_FIELD_WIDTH_20BIT) ? (value << 4) : value;
+    for(size_t b = 0; b < size; b++) {
+        const size_t shift = little_endian ? (8 * b) : (8 * (size - 1 - b));
+        bytes[b] = (uint8_t)(word >> shift);
+    }
+}
+
+static void test_field_arrays(void) {
+    static const type_utils_field_widths_t widths[] = {
+        TYPE_UTILS_FIELD_WIDTH_16BIT, TYPE_UTILS_FIELD_WIDTH_20BIT, TYPE_UTILS_FIELD_WIDTH_24BIT, TYPE_UTILS_FIELD_WIDTH_32BIT };
+    uint8_t  bytes[TU_FIELDS * 4];
+    uint32_t expected[TU_FIELDS], unsigned_values[TU_FIELDS];
+    int32_t  signed_values[TU_FIELDS];
+    float    float_values[TU_FIELDS];
+
+    HOST_TEST_ASSERT( type_utils_field_size(TYPE_UTILS_FIELD_WIDTH_16BIT) == 2 );
+    HOST_TEST_ASSERT( type_utils_field_size(TYPE_UTILS_FIELD_WIDTH_20BIT) == 3 );
+    HOST_TEST_ASSERT( type_utils_field_size(TYPE_UTILS_FIELD_WIDTH_32BIT) == 4 );
+
+    for(size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        const type_utils_field_widths_t width = widths[w];
+        const uint32_t mask = (width == TYPE_UTILS_FIELD_WIDTH_32BIT) ? UINT32_MAX : ((UINT32_C(1) << width) - 1);
+        const uint32_t sign = UINT32_C(1) << (width - 1);
+        const size_t   size = type_utils_field_size(width);
+
+        for(int endian = 0; endian < 2; endian++) {
+            bool unsigned_equal = true, signed_equal = true, float_equal = true, float_signed_equal = true;
+            uint32_t seed = 0x9e3779b9u * (uint32_t)(w + 1) + (uint32_t)endian;
+            for(size_t i = 0; i < TU_FIELDS; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                /* the first fields are the extremes, the rest pseudo-random */
+                expected[i] = (i == 0) ? 0 : (i == 1) ? mask : (i == 2) ? sign : (i == 3) ? (sign - 1) : (seed & mask);
+                encode_field(&bytes[i * size], expected[i], width, endian == 1);
+            }
+
+            bytes_to_uint32_array(bytes, unsigned_values, TU_FIELDS, width, endian == 1);
+            bytes_to_int32_array(bytes, signed_values, TU_FIELDS, width, endian == 1);
+            bytes_to_float_array(bytes, float_values, TU_FIELDS, width, false, endian == 1, 0.5f);
+            for(size_t i = 0; i < TU_FIELDS; i++) {
+                const int32_t extended = (expected[i] & sign) ? (int32_t)(expected[i] | ~mask) : (int32_t)expected[i];
+                if(unsigned_values[i] != expected[i]) unsigned_equal = false;
+                if(signed_values[i] != extended) signed_equal = false;
+                if(float_values[i] != (float)expected[i] * 0.5f) float_equal = false;
+            }
+            bytes_to_float_array(bytes, float_values, TU_FIELDS, width, true, endian == 1, 0.25f);
+            for(size_t i = 0; i < TU_FIELDS; i++) {
+                const int32_t extended = (expected[i] & sign) ? (int32_t)(expected[i] | ~mask) : (int32_t)expected[i];
+                if(float_values[i] != (float)extended * 0.25f) float_signed_equal = false;
+            }
+
+            if(!(unsigned_equal && signed_equal && float_equal && float_signed_equal)) {
+                printf("width %d %s endian: unsigned %d signed %d float %d signed float %d\n", (int)width, 
+                       endian ? "little" : "big", unsigned_equal, signed_equal, float_equal, float_signed_equal);
+            }
+            HOST_TEST_ASSERT( unsigned_equal && signed_equal && float_equal && float_signed_equal );
+        }
+    }
+
+    /* a zero count writes nothing */
+    float_values[0] = 42.0f;
+    bytes_to_float_array(bytes, float_values, 0, TYPE_UTILS_FIELD_WIDTH_16BIT, true, false, 1.0f);
+    HOST_TEST_ASSERT( float_values[0] == 42.0f );
+}
+
+int main(void) {
+    test_binary_strings();
+    test_scalar_bytes();
+    test_field_arrays();
+    HOST_TEST_END();
+}
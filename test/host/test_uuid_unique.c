@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_uuid_unique.c
+ *
+ * UUID uniqueness and monotonicity test, millions of variant-4 and version-7
+ * UUIDs are generated, sorted and checked for duplicates, version-7 UUIDs of
+ * a generator must be strictly increasing and carry the system time, the
+ * default generator mode is switched and read back
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <string.h>
+#include <sys/time.h>
+#include <uuid.h>
+#include "host_test.h"
+
+#define UUID_COUNT          (2000000)
+#define UUID_DEFAULT_COUNT  (200000)
+
+static uint8_t uuids[UUID_COUNT * UUID_BINARY_SIZE];
+
+static int uuid_compare(const void *a, const void *b) {
+    return memcmp(a, b, UUID_BINARY_SIZE);
+}
+
+static size_t uuid_duplicates(uint8_t *const buffer, const size_t count) {
+    size_t duplicates = 0;
+    qsort(buffer, count, UUID_BINARY_SIZE, uuid_compare);
+    for(size_t i = 1; i < count; i++) {
+        if(memcmp(&buffer[(i - 1) * UUID_BINARY_SIZE], &buffer[i * UUID_BINARY_SIZE], UUID_BINARY_SIZE) == 0) duplicates++;
+    }
+    return duplicates;
+}
+
+static uint64_t unix_time_ms(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000U + (uint64_t)(tv.tv_usec / 1000);
+}
+
+static uint64_t uuid_v7_time_ms(const uint8_t *const uuid) {
+    uint64_t ms = 0;
+    for(int i = 0; i < 6; i++) ms = (ms << 8) | uuid[i];
+    return ms;
+}
+
+static void test_variant4_unique(void) {
+    uuid_generator_t generator;
+    uuid_generator_init(&generator, UUID_MODE_VARIANT4, true);
+    uuid_generate_bulk(&generator, uuids, UUID_COUNT);
+    size_t bad_version = 0;
+    for(size_t i = 0; i < UUID_COUNT; i++) {
+        const uint8_t *uuid = &uuids[i * UUID_BINARY_SIZE];
+        if((uuid[6] & 0xf0) != 0x40 || (uuid[8] & 0xc0) != 0x80) bad_version++;
+    }
+    const size_t duplicates = uuid_duplicates(uuids, UUID_COUNT);
+    printf("variant-4: %d uuids, %zu duplicates\n", UUID_COUNT, duplicates);
+    HOST_TEST_ASSERT(bad_version == 0);
+    HOST_TEST_ASSERT(duplicates == 0);
+}
+
+static void test_version7_monotonic(void) {
+    uuid_generator_t generator;
+    uuid_generator_init(&generator, UUID_MODE_VERSION7, true);
+    const uint64_t start_ms = unix_time_ms();
+    uuid_generate_bulk(&generator, uuids, UUID_COUNT);
+    const uint64_t end_ms = unix_time_ms();
+    size_t not_increasing = 0, bad_version = 0, clock_reads = 0;
+    for(size_t i = 0; i < UUID_COUNT; i++) {
+        const uint8_t *uuid = &uuids[i * UUID_BINARY_SIZE];
+        if((uuid[6] & 0xf0) != 0x70 || (uuid[8] & 0xc0) != 0x80) bad_version++;
+        if(i > 0 && memcmp(uuid - UUID_BINARY_SIZE, uuid, UUID_BINARY_SIZE) >= 0) not_increasing++;
+        /* a timestamp step without a counter overflow is a clock read within the batch */
+        if(i > 0 && uuid_v7_time_ms(uuid) != uuid_v7_time_ms(uuid - UUID_BINARY_SIZE) &&
+           (uuid_v7_time_ms(uuid) != uuid_v7_time_ms(uuid - UUID_BINARY_SIZE) + 1 || uuid[6] != 0x70 || uuid[7] != 0)) clock_reads++;
+    }
+    /* the counter borrows milliseconds when more than 4096 uuids are generated within one */
+    const uint64_t first_ms = uuid_v7_time_ms(uuids);
+    const uint64_t last_ms = uuid_v7_time_ms(&uuids[(UUID_COUNT - 1) * UUID_BINARY_SIZE]);
+    printf("version-7: %d uuids over %llu ms, timestamps %llu ms\n", UUID_COUNT,
+           (unsigned long long)(end_ms - start_ms), (unsigned long long)(last_ms - first_ms));
+    HOST_TEST_ASSERT(bad_version == 0);
+    HOST_TEST_ASSERT(not_increasing == 0);
+    HOST_TEST_ASSERT(clock_reads == 0);
+    HOST_TEST_ASSERT(first_ms >= start_ms && first_ms <= end_ms);
+    HOST_TEST_ASSERT(last_ms >= start_ms);
+    HOST_TEST_ASSERT(last_ms <= first_ms + UUID_COUNT / 2048);
+    HOST_TEST_ASSERT(uuid_duplicates(uuids, UUID_COUNT) == 0);
+}
+
+static void uuid_from_string(const char *const string, uint8_t *const uuid) {
+    for(int j = 0, k = 0; j < UUID_BINARY_SIZE; k += 2) {
+        if(string[k] == '-') k++;
+        unsigned int byte = 0;
+        sscanf(&string[k], "%2x", &byte);
+        uuid[j++] = (uint8_t)byte;
+    }
+}
+
+static void test_default_generator(void) {
+    size_t not_increasing = 0;
+    uuid_init();
+    HOST_TEST_ASSERT(uuid_get_mode() == UUID_MODE_VARIANT4);
+    uuid_set_mode(UUID_MODE_VERSION7);
+    HOST_TEST_ASSERT(uuid_get_mode() == UUID_MODE_VERSION7);
+    for(int i = 0; i < UUID_DEFAULT_COUNT; i++) {
+        uint8_t *uuid = &uuids[i * UUID_BINARY_SIZE];
+        uuid_from_string(uuid_generate(), uuid);
+        if(i > 0 && memcmp(uuid - UUID_BINARY_SIZE, uuid, UUID_BINARY_SIZE) >= 0) not_increasing++;
+    }
+    printf("default generator: %d version-7 uuids, %zu not increasing\n", UUID_DEFAULT_COUNT, not_increasing);
+    HOST_TEST_ASSERT(not_increasing == 0);
+    uuid_set_mode(UUID_MODE_VARIANT4);
+    HOST_TEST_ASSERT(uuid_get_mode() == UUID_MODE_VARIANT4);
+    uuid_from_string(uuid_generate(), uuids);
+    HOST_TEST_ASSERT((uuids[6] & 0xf0) == 0x40);
+}
+
+int main(void) {
+    test_variant4_unique();
+    test_version7_monotonic();
+    test_default_generator();
+    HOST_TEST_END();
+}
@@ -0,0 +1,239 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_wx_derived_pipeline.c
+ *
+ * Derived weather quantities pipeline test, not available defaults of
+ * incomplete samples, humidity and pressure derivations against the weather
+ * utilities and the psychrometric equation, pressure tendency and scalar
+ * trend hooks
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <wx_derived.h>
+#include <wx_utils.h>
+#include "host_test.h"
+
+#define TEST_ALTITUDE       (350.0f)    /* station altitude, meters */
+#define TEST_INTERVAL       (60)        /* sampling interval, seconds */
+#define TEST_TREND_SIZE     (60)        /* 1-hr of samples at the sampling interval */
+
+static wx_derived_handle_t test_init(const uint16_t sampling_interval, const uint16_t trend_samples_size) {
+    const wx_derived_config_t config = {
+        .altitude           = TEST_ALTITUDE,
+        .sampling_interval  = sampling_interval,
+        .tendency_period    = PRESSURE_TENDENCY_3HR_PERIOD,
+        .trend_samples_size = trend_samples_size,
+    };
+    wx_derived_handle_t handle = NULL;
+    HOST_TEST_ESP_OK( wx_derived_init(&config, &handle) );
+    return handle;
+}
+
+static void test_not_available(void) {
+    wx_derived_handle_t handle = test_init(TEST_INTERVAL, TEST_TREND_SIZE);
+    wx_derived_data_t   data;
+
+    /* empty sample, every derived quantity is not available */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ NAN, NAN, NAN }, &data) );
+    HOST_TEST_ASSERT(isnan(data.temperature) && isnan(data.humidity) && isnan(data.pressure));
+    HOST_TEST_ASSERT(isnan(data.saturation_vapour_pressure) && isnan(data.vapour_pressure));
+    HOST_TEST_ASSERT(isnan(data.dewpoint) && isnan(data.wetbulb) && isnan(data.heat_index) && isnan(data.mixing_ratio));
+    HOST_TEST_ASSERT(isnan(data.sea_level_pressure) && isnan(data.qnh) && isnan(data.pressure_tendency_change));
+    HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.humidity_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.pressure_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+
+    /* temperature only, the saturation vapour pressure */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 20.0f, NAN, NAN }, &data) );
+    HOST_TEST_NEAR(wx_pws(293.15), data.saturation_vapour_pressure, 0.01);
+    HOST_TEST_ASSERT(isnan(data.vapour_pressure) && isnan(data.dewpoint) && isnan(data.wetbulb));
+    HOST_TEST_ASSERT(isnan(data.sea_level_pressure) && isnan(data.qnh));
+
+    /* zero humidity is not a measurement */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 20.0f, 0.0f, NAN }, &data) );
+    HOST_TEST_ASSERT(isnan(data.dewpoint) && isnan(data.mixing_ratio));
+
+    /* pressure without temperature, qnh only */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ NAN, NAN, 970.0f }, &data) );
+    HOST_TEST_ASSERT(isnan(data.sea_level_pressure));
+    HOST_TEST_ASSERT(!isnan(data.qnh));
+    HOST_TEST_ASSERT(isnan(data.dewpoint));
+
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+}
+
+static void test_humidity(void) {
+    wx_derived_handle_t handle = test_init(0, 0);
+    wx_derived_data_t   data;
+
+    for(float ta = -20.0f; ta <= 45.0f; ta += 5.0f) {
+        for(float hr = 10.0f; hr <= 100.0f; hr += 15.0f) {
+            for(float pa = 850.0f; pa <= 1050.0f; pa += 100.0f) {
+                HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ ta, hr, pa }, &data) );
+
+                const double pws = wx_pws(ta + 273.15);
+                const double e   = pws * hr / 100.0;
+                HOST_TEST_NEAR(pws, data.saturation_vapour_pressure, pws * 1.3e-4);
+                HOST_TEST_NEAR(e, data.vapour_pressure, e * 1.3e-4);
+                HOST_TEST_NEAR(wx_td(ta, hr), data.dewpoint, 0.001);
+                HOST_TEST_NEAR(wx_hi(ta, hr), data.heat_index, 0.001);
+                HOST_TEST_NEAR(wx_mr(ta, hr, pa), data.mixing_ratio, wx_mr(ta, hr, pa) * 1.3e-4);
+
+                /* the wetbulb solves the psychrometric equation between the dewpoint and air temperature */
+                const double tw = data.wetbulb;
+                HOST_TEST_ASSERT(tw >= data.dewpoint - 0.001 && tw <= ta + 0.001);
+                HOST_TEST_NEAR(e, wx_pws(tw + 273.15) - 0.000662 * pa * (ta - tw), 0.01);
+            }
+        }
+    }
+
+    /* saturated air, dewpoint and wetbulb at the air temperature */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 15.0f, 100.0f, 1013.25f }, &data) );
+    HOST_TEST_NEAR(15.0, data.dewpoint, 0.001);
+    HOST_TEST_NEAR(15.0, data.wetbulb, 0.01);
+
+    /* psychrometric chart value, 20 degrees Celsius and 50 percent at sea level, the Stull formula reads 13.7 */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 20.0f, 50.0f, 1013.25f }, &data) );
+    HOST_TEST_NEAR(13.8, data.wetbulb, 0.1);
+
+    /* without pressure the wetbulb and mixing ratio fall back to standard sea level pressure */
+    wx_derived_data_t standard;
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 25.0f, 60.0f, NAN }, &data) );
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 25.0f, 60.0f, 1013.25f }, &standard) );
+    HOST_TEST_ASSERT(data.wetbulb == standard.wetbulb);
+    HOST_TEST_ASSERT(data.mixing_ratio == standard.mixing_ratio);
+    HOST_TEST_ASSERT(isnan(data.sea_level_pressure) && isnan(data.qnh));
+
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+}
+
+static void test_pressure(void) {
+    wx_derived_handle_t handle = test_init(0, 0);
+    wx_derived_data_t   data;
+
+    for(float pa = 900.0f; pa <= 1000.0f; pa += 25.0f) {
+        for(float ta = -10.0f; ta <= 30.0f; ta += 10.0f) {
+            HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ ta, 50.0f, pa }, &data) );
+            HOST_TEST_NEAR(wx_pressure_at_sea_level(pa, TEST_ALTITUDE, ta), data.sea_level_pressure, 0.01);
+            HOST_TEST_NEAR(wx_qnh(pa, TEST_ALTITUDE, 0.0), data.qnh, 0.01);
+            HOST_TEST_ASSERT(data.sea_level_pressure > pa && data.qnh > pa);
+        }
+    }
+
+    /* a colder air column is denser, the sea level pressure reduction is larger */
+    wx_derived_data_t cold, warm;
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ -10.0f, 50.0f, 970.0f }, &cold) );
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 30.0f, 50.0f, 970.0f }, &warm) );
+    HOST_TEST_ASSERT(cold.sea_level_pressure > warm.sea_level_pressure);
+    HOST_TEST_ASSERT(cold.qnh == warm.qnh);
+
+    /* the qnh of the standard atmosphere pressure at the station altitude is the standard sea level pressure */
+    const float isa = (float)(1013.25 * pow(1.0 - 0.0065 * TEST_ALTITUDE / 288.15, 5.25588));
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 15.0f, 50.0f, isa }, &data) );
+    HOST_TEST_NEAR(1013.25, data.qnh, 0.05);
+
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+}
+
+static void test_trends(void) {
+    wx_derived_handle_t handle = test_init(TEST_INTERVAL, TEST_TREND_SIZE);
+    wx_derived_data_t   data;
+
+    /* 3 hours of 1-minute samples, rising temperature and pressure, falling humidity */
+    for(int i = 0; i < 180; i++) {
+        const wx_derived_sample_t sample = { 10.0f + 0.01f * i, 80.0f - 0.05f * i, 1000.0f + 0.02f * i };
+        HOST_TEST_ESP_OK( wx_derived_process(handle, &sample, &data) );
+
+        if(i < TEST_TREND_SIZE - 1) {
+            /* 1-hr trends and the 3-hr tendency are training for the first hour */
+            HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+            HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_TRAINING);
+            HOST_TEST_ASSERT(isnan(data.pressure_tendency_change));
+        }
+    }
+    HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_RISING);
+    HOST_TEST_ASSERT(data.humidity_trend_code == SCALAR_TREND_CODE_FALLING);
+    HOST_TEST_ASSERT(data.pressure_trend_code == SCALAR_TREND_CODE_RISING);
+    HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_RISING);
+    HOST_TEST_NEAR(179 * 0.02, data.pressure_tendency_change, 0.01);
+
+    /* a sample without pressure is not pushed onto the pressure analyzers */
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 11.8f, 71.0f, NAN }, &data) );
+    HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.pressure_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_RISING);
+    HOST_TEST_ASSERT(data.humidity_trend_code == SCALAR_TREND_CODE_FALLING);
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 11.8f, 71.0f, 1003.6f }, &data) );
+    HOST_TEST_NEAR(1003.6 - (1000.0 + 0.02 * 1), data.pressure_tendency_change, 0.01);
+
+    /* reset restarts the training of every analyzer */
+    HOST_TEST_ESP_OK( wx_derived_reset(handle) );
+    HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 12.0f, 70.0f, 1004.0f }, &data) );
+    HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_TRAINING);
+    HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.humidity_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(data.pressure_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+
+    /* disabled analyzers report unknown codes */
+    handle = test_init(0, 0);
+    for(int i = 0; i < 180; i++) {
+        HOST_TEST_ESP_OK( wx_derived_process(handle, &(wx_derived_sample_t){ 10.0f + 0.01f * i, 50.0f, 1000.0f + 0.02f * i }, &data) );
+    }
+    HOST_TEST_ASSERT(data.pressure_tendency_code == PRESSURE_TENDENCY_CODE_UNKNOWN);
+    HOST_TEST_ASSERT(isnan(data.pressure_tendency_change));
+    HOST_TEST_ASSERT(data.temperature_trend_code == SCALAR_TREND_CODE_UNKNOWN);
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+}
+
+static void test_arguments(void) {
+    const wx_derived_config_t config = { .altitude = TEST_ALTITUDE };
+    wx_derived_handle_t       handle = NULL;
+    wx_derived_data_t         data;
+
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_derived_init(NULL, &handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_derived_init(&config, NULL) );
+    /* scalar trends need more than 2 samples */
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_derived_init(&(wx_derived_config_t){ .trend_samples_size = 2 }, &handle) );
+
+    HOST_TEST_ESP_OK( wx_derived_init(&config, &handle) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_derived_process(handle, NULL, &data) );
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_derived_process(NULL, &(wx_derived_sample_t){ 20.0f, 50.0f, 1000.0f }, &data) );
+    HOST_TEST_ESP_OK( wx_derived_delete(handle) );
+}
+
+int main(void) {
+    esp_log_level_set("*", ESP_LOG_NONE);
+    test_not_available();
+    test_humidity();
+    test_pressure();
+    test_trends();
+    test_arguments();
+    HOST_TEST_END();
+}
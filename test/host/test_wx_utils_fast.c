@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_wx_utils_fast.c
+ *
+ * Weather utilities fast-path accuracy test, the single-precision functions
+ * are swept over the default temperature and humidity ranges and checked
+ * against the double-precision functions with the maximum errors documented
+ * in `wx_utils.h`
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <wx_utils.h>
+#include "host_test.h"
+
+#define WX_T_MIN        (-40.0)     /* wx_temperature_range minimum, degrees Celsius */
+#define WX_T_MAX        (125.0)     /* wx_temperature_range maximum, degrees Celsius */
+#define WX_T_STEP       (0.01)
+#define WX_HR_MIN       (1)         /* wx_humidity_range minimum, percent */
+#define WX_HR_MAX       (100)       /* wx_humidity_range maximum, percent */
+
+static void max_error(double *const error, const double value) {
+    if(value > *error) *error = value;
+}
+
+static void test_saturation_vapour_pressure(void) {
+    double v = 0, pws = 0, pwi = 0;
+    for(int k = 0; WX_T_MIN + k * WX_T_STEP <= WX_T_MAX; k++) {
+        const float tc = (float)(WX_T_MIN + k * WX_T_STEP);
+        const float tk = tc + 273.15f;
+        max_error(&v, fabs(wx_v_fast(tk) / wx_v(tk) - 1.0));
+        max_error(&pws, fabs(wx_pws_fast(tk) / wx_pws(tk) - 1.0));
+        if(tc <= 0.0f) max_error(&pwi, fabs(wx_pwi_fast(tk) / wx_pwi(tk) - 1.0));
+    }
+    printf("wx_v_fast   max relative error %.2e\n", v);
+    printf("wx_pws_fast max relative error %.2e\n", pws);
+    printf("wx_pwi_fast max relative error %.2e\n", pwi);
+    HOST_TEST_ASSERT(v < 1e-7);
+    HOST_TEST_ASSERT(pws < 1.3e-4);
+    HOST_TEST_ASSERT(pwi < 1.3e-4);
+}
+
+static void test_dewpoint_heat_index_mixing_ratio(void) {
+    double td = 0, hi = 0, mr = 0;
+    for(int k = 0; WX_T_MIN + k * WX_T_STEP * 10 <= WX_T_MAX; k++) {
+        const float tc = (float)(WX_T_MIN + k * WX_T_STEP * 10);
+        const double pws = wx_pws(tc + 273.15);
+        for(int hr = WX_HR_MIN; hr <= WX_HR_MAX; hr++) {
+            max_error(&td, fabs(wx_td_fast(tc, hr) - wx_td(tc, hr)));
+            max_error(&hi, fabs(wx_hi_fast(tc, hr) - wx_hi(tc, hr)));
+            for(int pa = 300; pa <= 1100; pa += 100) {
+                /* documented domain, vapour pressure below half the air pressure */
+                if(pws * hr / 100.0 >= 0.5 * pa) continue;
+                max_error(&mr, fabs(wx_mr_fast(tc, hr, pa) / wx_mr(tc, hr, pa) - 1.0));
+            }
+        }
+    }
+    printf("wx_td_fast  max absolute error %.2e C\n", td);
+    printf("wx_hi_fast  max absolute error %.2e C\n", hi);
+    printf("wx_mr_fast  max relative error %.2e\n", mr);
+    HOST_TEST_ASSERT(td < 0.0001);
+    HOST_TEST_ASSERT(hi < 0.001);
+    HOST_TEST_ASSERT(mr < 1.3e-4);
+}
+
+static void test_wet_bulb(void) {
+    /* Stull (2011) check value */
+    HOST_TEST_NEAR(13.7, wx_tw_fast(20.0f, 50.0f), 0.05);
+}
+
+static void test_batch(void) {
+    enum { N = 64 };
+    float ta[N], hr[N], pa[N], out[N];
+    for(int i = 0; i < N; i++) {
+        ta[i] = -20.0f + i;
+        hr[i] = 5.0f + i * 1.4f;
+        pa[i] = 950.0f + i;
+    }
+    HOST_TEST_ESP_OK( wx_td_batch(ta, hr, N, out) );
+    for(int i = 0; i < N; i++) HOST_TEST_ASSERT(out[i] == wx_td_fast(ta[i], hr[i]));
+    HOST_TEST_ESP_OK( wx_tw_batch(ta, hr, N, out) );
+    for(int i = 0; i < N; i++) HOST_TEST_ASSERT(out[i] == wx_tw_fast(ta[i], hr[i]));
+    HOST_TEST_ESP_OK( wx_hi_batch(ta, hr, N, out) );
+    for(int i = 0; i < N; i++) HOST_TEST_ASSERT(out[i] == wx_hi_fast(ta[i], hr[i]));
+    HOST_TEST_ESP_OK( wx_mr_batch(ta, hr, pa, N, out) );
+    for(int i = 0; i < N; i++) HOST_TEST_ASSERT(out[i] == wx_mr_fast(ta[i], hr[i], pa[i]));
+    HOST_TEST_ESP_ERR( ESP_ERR_INVALID_ARG, wx_td_batch(NULL, hr, N, out) );
+}
+
+int main(void) {
+    test_saturation_vapour_pressure();
+    test_dewpoint_heat_index_mixing_ratio();
+    test_wet_bulb();
+    test_batch();
+    HOST_TEST_END();
+}